@@ -8,7 +8,9 @@
 
 #include "bsp_can.h"
 #include "bsp_compiler_attributes.h"
+#include "bsp_swtimer.h"
 #include "stm32f4xx_hal.h"
+#include "stm32f4xx_hal_cortex.h"
 #include <stddef.h>
 #include <string.h>
 
@@ -28,6 +30,14 @@ FORCE_STATIC CAN_HandleTypeDef* const s_apHalHandles[BSP_CAN_MAX_INSTANCES] = {
     &hcan2  /* eBSP_CAN_INSTANCE_2 = 1 */
 };
 
+/**
+ * @brief Lookup table mapping instance enum to RX FIFO0/FIFO1 interrupt lines
+ */
+FORCE_STATIC const IRQn_Type s_aeRxIrqs[BSP_CAN_MAX_INSTANCES][2] = {
+    {CAN1_RX0_IRQn, CAN1_RX1_IRQn}, /* eBSP_CAN_INSTANCE_1 = 0 */
+    {CAN2_RX0_IRQn, CAN2_RX1_IRQn}  /* eBSP_CAN_INSTANCE_2 = 1 */
+};
+
 /* ============================================================================
  * Private Constants
  * ========================================================================== */
@@ -35,6 +45,15 @@ FORCE_STATIC CAN_HandleTypeDef* const s_apHalHandles[BSP_CAN_MAX_INSTANCES] = {
 /** Number of hardware TX mailboxes in STM32 CAN peripheral */
 #define CAN_HW_MAILBOX_COUNT (3u)
 
+/** Interrupts enabled by BspCanStart() */
+#define CAN_IT_NORMAL                                                                                                                      \
+    (CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_RX_FIFO1_MSG_PENDING | CAN_IT_TX_MAILBOX_EMPTY | CAN_IT_ERROR | CAN_IT_BUSOFF |                  \
+     CAN_IT_ERROR_PASSIVE)
+
+/** Interrupts enabled by BspCanStartMonitor() */
+#define CAN_IT_MONITOR                                                                                                                     \
+    (CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_RX_FIFO1_MSG_PENDING | CAN_IT_RX_FIFO0_OVERRUN | CAN_IT_RX_FIFO1_OVERRUN | CAN_IT_ERROR)
+
 /** Capacity per priority level (equal distribution) */
 FORCE_STATIC const uint8_t CAN_QUEUE_CAPACITY_PER_PRIORITY = (BSP_CAN_TX_QUEUE_DEPTH / BSP_CAN_PRIORITY_LEVELS);
 
@@ -49,6 +68,7 @@ typedef struct
 {
     BspCanMessage_t tMessage;   /**< CAN message */
     uint32_t        uTxId;      /**< User TX ID */
+    uint32_t        uSeq;       /**< Enqueue sequence number (CAN ID order tie-break) */
     uint8_t         byPriority; /**< Priority level */
     bool            bInUse;     /**< Entry allocated flag */
 } BspCanTxEntry_t;
@@ -73,6 +93,10 @@ typedef struct
     BspCanTxEntry_t       aEntries[BSP_CAN_TX_QUEUE_DEPTH]; /**< Shared entry pool */
     uint8_t               byPriorityBitmap;                 /**< Bitmap of non-empty queues */
     uint8_t               byTotalUsed;                      /**< Total entries in use */
+    uint8_t               aHeap[BSP_CAN_TX_QUEUE_DEPTH];    /**< Min-heap of entry indices (CAN ID order) */
+    uint8_t               byHeapCount;                      /**< Entries in heap */
+    uint32_t              uNextSeq;                         /**< Next enqueue sequence number */
+    bool                  bIdOrdered;                       /**< Schedule by CAN ID instead of priority */
 } BspCanTxQueueManager_t;
 
 /**
@@ -101,10 +125,59 @@ typedef struct
  */
 typedef struct
 {
-    volatile bool bActive; /**< Mailbox contains pending message */
-    uint32_t      uTxId;   /**< User TX ID of message in mailbox */
+    volatile bool  bActive; /**< Mailbox contains pending message */
+    uint32_t       uTxId;   /**< User TX ID of message in mailbox */
+    uint32_t       uId;     /**< CAN ID of message in mailbox */
+    BspCanIdType_e eIdType; /**< ID type of message in mailbox */
 } BspCanMailbox_t;
 
+#if BSP_CAN_MAX_RTR_RESPONDERS > 0
+/**
+ * @brief Automatic remote-frame responder entry.
+ *
+ * The payload is double-buffered: writers fill the inactive buffer and then
+ * swap byActive, so the RX ISR always reads a complete payload.
+ */
+typedef struct
+{
+    uint32_t         uId;            /**< CAN identifier to answer */
+    uint32_t         uTxId;          /**< User TX ID used for replies */
+    BspCanIdType_e   eIdType;        /**< Standard or extended ID */
+    uint8_t          byPriority;     /**< TX queue priority of replies */
+    uint8_t          aPayload[2][8]; /**< Double-buffered payload */
+    uint8_t          abyDataLen[2];  /**< Payload length per buffer */
+    volatile uint8_t byActive;       /**< Index of the current payload buffer */
+    volatile bool    bPayloadValid;  /**< A payload has been published */
+} BspCanRtrResponder_t;
+#endif
+
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+/** Rate monitor hash index size (power of 2, at least twice the table size) */
+#define CAN_RATE_HASH_BITS (6u)
+#define CAN_RATE_HASH_SIZE (1u << CAN_RATE_HASH_BITS)
+
+/**
+ * @brief Per-ID RX rate monitor entry.
+ *
+ * Period and jitter are kept in 1/16 ms (Q4) so sub-millisecond variation
+ * survives the 1 ms HAL tick.
+ */
+typedef struct
+{
+    uint32_t       uId;         /**< Monitored CAN identifier */
+    BspCanIdType_e eIdType;     /**< Standard or extended ID */
+    uint32_t       uTimeoutMs;  /**< Timeout (0 = statistics only) */
+    uint32_t       uLastTick;   /**< Tick of last arrival or registration */
+    uint32_t       uPeriodQ4;   /**< EWMA inter-arrival period, ms × 16 */
+    uint32_t       uJitterQ4;   /**< EWMA absolute deviation, ms × 16 */
+    uint32_t       uMinGap;     /**< Shortest gap (ms) */
+    uint32_t       uMaxGap;     /**< Longest gap (ms) */
+    uint32_t       uCount;      /**< Frames received */
+    uint32_t       uTimeouts;   /**< Timeout events */
+    volatile bool  bTimedOut;   /**< Timeout reported, waiting for recovery */
+} BspCanRateEntry_t;
+#endif
+
 /**
  * @brief CAN module instance structure.
  */
@@ -124,6 +197,7 @@ typedef struct
 
     /* Filters */
     BspCanFilter_t aFilters[BSP_CAN_MAX_FILTERS];
+    uint8_t        abyFilterFifo[BSP_CAN_MAX_FILTERS]; /**< FIFO resolved at start (0/1) */
     uint8_t        byFilterCount;
 
     /* Mailbox Tracking */
@@ -139,11 +213,39 @@ typedef struct
     BspCanErrorCallback_t    pErrorCallback;
     BspCanBusStateCallback_t pBusStateCallback;
 
+#if BSP_CAN_MAX_RTR_RESPONDERS > 0
+    /* Remote Frame Responders */
+    BspCanRtrResponder_t aRtrResponders[BSP_CAN_MAX_RTR_RESPONDERS];
+    uint8_t              byRtrResponderCount;
+#endif
+
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+    /* RX Rate Monitors */
+    BspCanRateEntry_t           aRateEntries[BSP_CAN_MAX_RATE_MONITORS];
+    uint8_t                     abyRateHash[CAN_RATE_HASH_SIZE]; /**< Entry index per slot, 0xFF = empty */
+    uint8_t                     byRateMonitorCount;
+    BspCanRateTimeoutCallback_t pRateTimeoutCallback;
+#endif
+
+#if BSP_CAN_ENABLE_MONITOR
+    /* Bus Monitor */
+    BspCanMonitorRecord_t* pMonRing;         /**< Caller-owned capture ring */
+    uint32_t               uMonMask;         /**< Ring depth - 1 */
+    volatile uint32_t      uMonWrite;        /**< ISR write count (free-running) */
+    volatile uint32_t      uMonRead;         /**< User read count (free-running) */
+    uint32_t               uMonWindowStart;  /**< Start tick of current rate window */
+    uint32_t               uMonWindowFrames; /**< Frames seen in current rate window */
+    uint32_t               uMonSavedBtr;     /**< BTR value before monitor start */
+    BspCanMonitorStats_t   tMonStats;        /**< Capture statistics */
+    bool                   bMonitor;         /**< Monitor capture active */
+#endif
+
 #if BSP_CAN_ENABLE_STATISTICS
     /* Statistics */
     uint32_t uTxCount;
     uint32_t uRxCount;
     uint32_t uErrorCount;
+    uint32_t uRtrReplies;
 #endif
 } BspCanModule_t;
 
@@ -154,6 +256,125 @@ typedef struct
 /** Module instance array */
 FORCE_STATIC BspCanModule_t s_aModules[BSP_CAN_MAX_INSTANCES] = {0};
 
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+/** Software timer shared by all instances for rate monitor timeout checks */
+FORCE_STATIC SWTimerModule s_tRateTimer;
+FORCE_STATIC bool          s_bRateTimerInitialized = false;
+#endif
+
+/* ============================================================================
+ * Private Helper Functions - CAN ID Ordered Queue (O(log n) min-heap)
+ * ========================================================================== */
+
+/**
+ * @brief Compute arbitration key for a message (lower key wins the bus).
+ *
+ * Mirrors the order of the arbitration field: 11-bit base ID, RTR/SRR, IDE,
+ * 18-bit ID extension, RTR. A standard frame therefore beats an extended
+ * frame with the same base ID, and a data frame beats a remote frame.
+ */
+FORCE_STATIC uint32_t sArbitrationKey(const BspCanMessage_t* pMessage)
+{
+    uint32_t uRtr = (pMessage->eFrameType == eBSP_CAN_FRAME_REMOTE) ? 1u : 0u;
+
+    if (pMessage->eIdType == eBSP_CAN_ID_STANDARD)
+    {
+        return ((pMessage->uId & 0x7FFu) << 21u) | (uRtr << 20u);
+    }
+
+    uint32_t uBase = (pMessage->uId >> 18u) & 0x7FFu;
+    uint32_t uExt  = pMessage->uId & 0x3FFFFu;
+
+    return (uBase << 21u) | (1u << 20u) | (1u << 19u) | (uExt << 1u) | uRtr;
+}
+
+/**
+ * @brief Heap ordering: arbitration key first, enqueue order for equal keys.
+ * @return true if entry A must be sent before entry B.
+ */
+FORCE_STATIC bool sHeapLess(const BspCanTxQueueManager_t* pQueue, uint8_t byA, uint8_t byB)
+{
+    uint32_t uKeyA = sArbitrationKey(&pQueue->aEntries[byA].tMessage);
+    uint32_t uKeyB = sArbitrationKey(&pQueue->aEntries[byB].tMessage);
+
+    if (uKeyA != uKeyB)
+    {
+        return uKeyA < uKeyB;
+    }
+
+    /* Wrap-safe sequence comparison keeps same-ID frames in FIFO order */
+    return (int32_t)(pQueue->aEntries[byA].uSeq - pQueue->aEntries[byB].uSeq) < 0;
+}
+
+/**
+ * @brief Move heap slot up until heap property holds.
+ */
+FORCE_STATIC void sHeapSiftUp(BspCanTxQueueManager_t* pQueue, uint8_t byPos)
+{
+    while (byPos > 0u)
+    {
+        uint8_t byParent = (uint8_t)((byPos - 1u) / 2u);
+
+        if (!sHeapLess(pQueue, pQueue->aHeap[byPos], pQueue->aHeap[byParent]))
+        {
+            break;
+        }
+
+        uint8_t byTmp           = pQueue->aHeap[byPos];
+        pQueue->aHeap[byPos]    = pQueue->aHeap[byParent];
+        pQueue->aHeap[byParent] = byTmp;
+        byPos                   = byParent;
+    }
+}
+
+/**
+ * @brief Move heap slot down until heap property holds.
+ */
+FORCE_STATIC void sHeapSiftDown(BspCanTxQueueManager_t* pQueue, uint8_t byPos)
+{
+    for (;;)
+    {
+        uint8_t byLeft     = (uint8_t)((2u * byPos) + 1u);
+        uint8_t byRight    = (uint8_t)(byLeft + 1u);
+        uint8_t bySmallest = byPos;
+
+        if ((byLeft < pQueue->byHeapCount) && sHeapLess(pQueue, pQueue->aHeap[byLeft], pQueue->aHeap[bySmallest]))
+        {
+            bySmallest = byLeft;
+        }
+
+        if ((byRight < pQueue->byHeapCount) && sHeapLess(pQueue, pQueue->aHeap[byRight], pQueue->aHeap[bySmallest]))
+        {
+            bySmallest = byRight;
+        }
+
+        if (bySmallest == byPos)
+        {
+            break;
+        }
+
+        uint8_t byTmp             = pQueue->aHeap[byPos];
+        pQueue->aHeap[byPos]      = pQueue->aHeap[bySmallest];
+        pQueue->aHeap[bySmallest] = byTmp;
+        byPos                     = bySmallest;
+    }
+}
+
+/**
+ * @brief Remove heap slot, refilling it with the last element.
+ */
+FORCE_STATIC void sHeapRemoveAt(BspCanTxQueueManager_t* pQueue, uint8_t byPos)
+{
+    pQueue->byHeapCount--;
+
+    if (byPos < pQueue->byHeapCount)
+    {
+        pQueue->aHeap[byPos] = pQueue->aHeap[pQueue->byHeapCount];
+        sHeapSiftDown(pQueue, byPos);
+        sHeapSiftUp(pQueue, byPos);
+    }
+}
+
 /* ============================================================================
  * Private Helper Functions - TX Queue Management (O(1) operations)
  * ========================================================================== */
@@ -210,6 +431,16 @@ FORCE_STATIC bool sTxQueueEnqueue(BspCanTxQueueManager_t* pQueue, uint8_t byEntr
         return false;
     }
 
+    if (pQueue->bIdOrdered)
+    {
+        /* CAN ID order: whole pool is one heap, capacity bounded by pool size */
+        pQueue->aEntries[byEntryIndex].uSeq = pQueue->uNextSeq++;
+        pQueue->aHeap[pQueue->byHeapCount]  = byEntryIndex;
+        pQueue->byHeapCount++;
+        sHeapSiftUp(pQueue, (uint8_t)(pQueue->byHeapCount - 1u));
+        return true;
+    }
+
     BspCanPriorityQueue_t* pPrioQueue = &pQueue->aQueues[byPriority];
 
     /* Check if priority queue has space */
@@ -235,6 +466,18 @@ FORCE_STATIC bool sTxQueueEnqueue(BspCanTxQueueManager_t* pQueue, uint8_t byEntr
  */
 FORCE_STATIC uint8_t sTxQueueDequeue(BspCanTxQueueManager_t* pQueue)
 {
+    if (pQueue->bIdOrdered)
+    {
+        if (pQueue->byHeapCount == 0u)
+        {
+            return 0xFFu;
+        }
+
+        uint8_t byEntryIndex = pQueue->aHeap[0];
+        sHeapRemoveAt(pQueue, 0u);
+        return byEntryIndex;
+    }
+
     /* Check if any queue has entries */
     if (pQueue->byPriorityBitmap == 0u)
     {
@@ -272,12 +515,54 @@ FORCE_STATIC void sTxQueueFreeEntry(BspCanTxQueueManager_t* pQueue, uint8_t byEn
     }
 }
 
+/**
+ * @brief Remove the entry byOffset places behind the head of a priority queue.
+ */
+FORCE_STATIC void sPrioQueueRemoveAt(BspCanTxQueueManager_t* pQueue, uint8_t byPriority, uint8_t byOffset)
+{
+    BspCanPriorityQueue_t* pPrioQueue = &pQueue->aQueues[byPriority];
+
+    /* Shift the remaining entries forward */
+    for (uint8_t j = byOffset; j < (pPrioQueue->byCount - 1u); j++)
+    {
+        uint8_t byCurrIdx                    = (pPrioQueue->byHead + j) % CAN_QUEUE_CAPACITY_PER_PRIORITY;
+        uint8_t byNextIdx                    = (pPrioQueue->byHead + j + 1u) % CAN_QUEUE_CAPACITY_PER_PRIORITY;
+        pPrioQueue->aEntryIndices[byCurrIdx] = pPrioQueue->aEntryIndices[byNextIdx];
+    }
+
+    pPrioQueue->byTail = (pPrioQueue->byTail == 0u) ? (CAN_QUEUE_CAPACITY_PER_PRIORITY - 1u) : (pPrioQueue->byTail - 1u);
+    pPrioQueue->byCount--;
+
+    /* Update bitmap if queue now empty */
+    if (pPrioQueue->byCount == 0u)
+    {
+        pQueue->byPriorityBitmap &= ~(1u << byPriority);
+    }
+}
+
 /**
  * @brief Search and remove entry from queue by TX ID (for abort).
  * @return true if found and removed, false otherwise.
  */
 FORCE_STATIC bool sTxQueueRemoveByTxId(BspCanTxQueueManager_t* pQueue, uint32_t uTxId)
 {
+    if (pQueue->bIdOrdered)
+    {
+        for (uint8_t i = 0u; i < pQueue->byHeapCount; i++)
+        {
+            uint8_t byEntryIdx = pQueue->aHeap[i];
+
+            if (pQueue->aEntries[byEntryIdx].uTxId == uTxId)
+            {
+                sHeapRemoveAt(pQueue, i);
+                sTxQueueFreeEntry(pQueue, byEntryIdx);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     /* Search all priority queues */
     for (uint8_t byPrio = 0u; byPrio < BSP_CAN_PRIORITY_LEVELS; byPrio++)
     {
@@ -291,26 +576,8 @@ FORCE_STATIC bool sTxQueueRemoveByTxId(BspCanTxQueueManager_t* pQueue, uint32_t
 
             if (pQueue->aEntries[byEntryIdx].uTxId == uTxId)
             {
-                /* Found it - remove by shifting remaining entries */
-                for (uint8_t j = i; j < (pPrioQueue->byCount - 1u); j++)
-                {
-                    uint8_t byCurrIdx                    = (pPrioQueue->byHead + j) % CAN_QUEUE_CAPACITY_PER_PRIORITY;
-                    uint8_t byNextIdx                    = (pPrioQueue->byHead + j + 1u) % CAN_QUEUE_CAPACITY_PER_PRIORITY;
-                    pPrioQueue->aEntryIndices[byCurrIdx] = pPrioQueue->aEntryIndices[byNextIdx];
-                }
-
-                pPrioQueue->byTail = (pPrioQueue->byTail == 0u) ? (CAN_QUEUE_CAPACITY_PER_PRIORITY - 1u) : (pPrioQueue->byTail - 1u);
-                pPrioQueue->byCount--;
-
-                /* Update bitmap if queue now empty */
-                if (pPrioQueue->byCount == 0u)
-                {
-                    pQueue->byPriorityBitmap &= ~(1u << byPrio);
-                }
-
-                /* Free the entry */
+                sPrioQueueRemoveAt(pQueue, byPrio, i);
                 sTxQueueFreeEntry(pQueue, byEntryIdx);
-
                 return true;
             }
 
@@ -383,24 +650,98 @@ FORCE_STATIC BspCanHandle_t sFindModuleByHalHandle(CAN_HandleTypeDef* pHalHandle
 }
 
 /**
- * @brief Submit next queued message to hardware mailbox.
+ * @brief Check whether a frame would overtake a pending frame with the same ID.
+ *
+ * With identifier priority, equal IDs are sent lowest mailbox first. HAL
+ * fills the mailbox named by TSR.CODE, so the frame keeps its order only if
+ * that mailbox is above every mailbox still holding the same ID.
  */
-FORCE_STATIC void sSubmitNextTx(BspCanModule_t* pModule)
+FORCE_STATIC bool sSameIdWouldOvertake(const BspCanModule_t* pModule, const BspCanMessage_t* pMessage)
 {
-    /* Check if any mailbox is free */
-    uint32_t uFreeLevel = HAL_CAN_GetTxMailboxesFreeLevel(pModule->pHalHandle);
-    if (uFreeLevel == 0u)
+    static const uint32_t s_auTmeBits[CAN_HW_MAILBOX_COUNT] = {CAN_TSR_TME0, CAN_TSR_TME1, CAN_TSR_TME2};
+
+    uint32_t uTsr    = pModule->pHalHandle->Instance->TSR;
+    uint32_t uTarget = (uTsr & CAN_TSR_CODE) >> CAN_TSR_CODE_Pos;
+
+    for (uint8_t i = 0u; i < CAN_HW_MAILBOX_COUNT; i++)
     {
-        return;
+        const BspCanMailbox_t* pMbx = &pModule->aMailboxes[i];
+
+        /* TME guards against mailboxes that ended without a completion callback */
+        if (pMbx->bActive && ((uTsr & s_auTmeBits[i]) == 0u) && (pMbx->uId == pMessage->uId) && (pMbx->eIdType == pMessage->eIdType) &&
+            (i > uTarget))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Dequeue the next frame that may go to a mailbox now.
+ *
+ * In same-ID FIFO order a frame whose ID is held back is skipped, not
+ * waited on: frames with other IDs keep flowing. Every queued frame of the
+ * held ID gives the same answer, so their relative order is kept.
+ * @return Entry index, or 0xFF if nothing is eligible.
+ */
+FORCE_STATIC uint8_t sTxQueueTakeNext(BspCanModule_t* pModule)
+{
+    BspCanTxQueueManager_t* pQueue = &pModule->tTxQueue;
+
+    if (pModule->tConfig.eMailboxOrder != eBSP_CAN_MBX_ORDER_SAME_ID_FIFO)
+    {
+        return sTxQueueDequeue(pQueue);
+    }
+
+    if (pQueue->bIdOrdered)
+    {
+        /* Heap order is partial: pick the smallest eligible slot */
+        uint8_t byBestPos = 0xFFu;
+        for (uint8_t i = 0u; i < pQueue->byHeapCount; i++)
+        {
+            uint8_t byEntryIdx = pQueue->aHeap[i];
+            if (!sSameIdWouldOvertake(pModule, &pQueue->aEntries[byEntryIdx].tMessage) &&
+                ((byBestPos == 0xFFu) || sHeapLess(pQueue, byEntryIdx, pQueue->aHeap[byBestPos])))
+            {
+                byBestPos = i;
+            }
+        }
+
+        if (byBestPos == 0xFFu)
+        {
+            return 0xFFu;
+        }
+
+        uint8_t byEntryIdx = pQueue->aHeap[byBestPos];
+        sHeapRemoveAt(pQueue, byBestPos);
+        return byEntryIdx;
     }
 
-    /* Dequeue highest priority message */
-    uint8_t byEntryIdx = sTxQueueDequeue(&pModule->tTxQueue);
-    if (byEntryIdx == 0xFFu)
+    for (uint8_t byPrio = 0u; byPrio < BSP_CAN_PRIORITY_LEVELS; byPrio++)
     {
-        return; /* Queue empty */
+        const BspCanPriorityQueue_t* pPrioQueue = &pQueue->aQueues[byPrio];
+
+        for (uint8_t i = 0u; i < pPrioQueue->byCount; i++)
+        {
+            uint8_t byEntryIdx = pPrioQueue->aEntryIndices[(pPrioQueue->byHead + i) % CAN_QUEUE_CAPACITY_PER_PRIORITY];
+            if (!sSameIdWouldOvertake(pModule, &pQueue->aEntries[byEntryIdx].tMessage))
+            {
+                sPrioQueueRemoveAt(pQueue, byPrio, i);
+                return byEntryIdx;
+            }
+        }
     }
 
+    return 0xFFu;
+}
+
+/**
+ * @brief Hand one dequeued entry to a HAL mailbox and release it.
+ */
+FORCE_STATIC void sSubmitEntry(BspCanModule_t* pModule, uint8_t byEntryIdx)
+{
     BspCanTxEntry_t* pEntry = &pModule->tTxQueue.aEntries[byEntryIdx];
 
     /* Prepare HAL TX header */
@@ -433,6 +774,8 @@ FORCE_STATIC void sSubmitNextTx(BspCanModule_t* pModule)
         {
             pModule->aMailboxes[byMbxIdx].bActive = true;
             pModule->aMailboxes[byMbxIdx].uTxId   = pEntry->uTxId;
+            pModule->aMailboxes[byMbxIdx].uId     = pEntry->tMessage.uId;
+            pModule->aMailboxes[byMbxIdx].eIdType = pEntry->tMessage.eIdType;
         }
 
         /* Blink TX LED */
@@ -446,6 +789,62 @@ FORCE_STATIC void sSubmitNextTx(BspCanModule_t* pModule)
     sTxQueueFreeEntry(&pModule->tTxQueue, byEntryIdx);
 }
 
+/**
+ * @brief Submit queued messages to the free hardware mailboxes.
+ */
+FORCE_STATIC void sSubmitNextTx(BspCanModule_t* pModule)
+{
+    /* Only our own submits take mailboxes while interrupts are off, so count them down locally */
+    uint32_t uFreeLevel = HAL_CAN_GetTxMailboxesFreeLevel(pModule->pHalHandle);
+
+    while ((uFreeLevel > 0u) && (pModule->tTxQueue.byTotalUsed > 0u))
+    {
+        /* Held-back same-ID frames stay queued; a mailbox completion resubmits */
+        uint8_t byEntryIdx = sTxQueueTakeNext(pModule);
+        if (byEntryIdx == 0xFFu)
+        {
+            return;
+        }
+
+        sSubmitEntry(pModule, byEntryIdx);
+        uFreeLevel--;
+    }
+}
+
+/**
+ * @brief Queue a frame and kick the TX path.
+ *
+ * Allocation, enqueue and submit share one pool between thread context and
+ * the RX/TX ISRs. Call with interrupts disabled.
+ */
+FORCE_STATIC BspCanError_e sTxQueueSubmit(BspCanModule_t* pModule, const BspCanMessage_t* pMessage, uint8_t byPriority, uint32_t uTxId)
+{
+    BspCanTxEntry_t* pEntry = sTxQueueAllocateEntry(&pModule->tTxQueue);
+    if (pEntry == NULL)
+    {
+        return eBSP_CAN_ERR_TX_QUEUE_FULL;
+    }
+
+    /* Fill entry */
+    pEntry->tMessage            = *pMessage;
+    pEntry->uTxId               = uTxId;
+    pEntry->byPriority          = byPriority;
+    pEntry->tMessage.uTimestamp = HAL_GetTick();
+
+    uint8_t byEntryIdx = (uint8_t)(pEntry - pModule->tTxQueue.aEntries);
+
+    if (!sTxQueueEnqueue(&pModule->tTxQueue, byEntryIdx, byPriority))
+    {
+        sTxQueueFreeEntry(&pModule->tTxQueue, byEntryIdx);
+        return eBSP_CAN_ERR_TX_QUEUE_FULL;
+    }
+
+    /* Try to submit immediately */
+    sSubmitNextTx(pModule);
+
+    return eBSP_CAN_ERR_NONE;
+}
+
 /**
  * @brief Parse HAL RX header into BSP message structure.
  */
@@ -470,82 +869,1013 @@ FORCE_STATIC void sParseRxMessage(const CAN_RxHeaderTypeDef* pRxHeader, const ui
 }
 
 /* ============================================================================
- * Private Helper Functions - Validation
+ * Private Helper Functions - Bit Timing
  * ========================================================================== */
 
+/** Quanta per bit searched by the bit timing calculator */
+#define CAN_BIT_TQ_MIN (8u)
+#define CAN_BIT_TQ_MAX (25u)
+
+/** LEC value never set by hardware, used by autobaud as "nothing seen yet" */
+#define CAN_LEC_UNSET (7u)
+
 /**
- * @brief Validate handle.
- * @return Pointer to module or NULL if invalid.
+ * @brief Encode bit timing into BTR register fields (without mode bits).
  */
-FORCE_STATIC BspCanModule_t* sValidateHandle(BspCanHandle_t handle)
+FORCE_STATIC uint32_t sBitTimingToBtr(const BspCanBitTiming_t* pTiming)
 {
-    if ((handle < 0) || ((uint8_t)handle >= BSP_CAN_MAX_INSTANCES))
-    {
-        return NULL;
-    }
+    return ((uint32_t)(pTiming->wPrescaler - 1u) & CAN_BTR_BRP) | (((uint32_t)(pTiming->byBs1 - 1u) << CAN_BTR_TS1_Pos) & CAN_BTR_TS1) |
+           (((uint32_t)(pTiming->byBs2 - 1u) << CAN_BTR_TS2_Pos) & CAN_BTR_TS2) |
+           (((uint32_t)(pTiming->bySjw - 1u) << CAN_BTR_SJW_Pos) & CAN_BTR_SJW);
+}
 
-    if (!s_aModules[handle].bAllocated)
+/**
+ * @brief Program a bitrate from the current APB1 clock, keeping the silent/loopback bits.
+ */
+FORCE_STATIC BspCanError_e sApplyBitrate(BspCanModule_t* pModule, uint32_t uBitrate, uint16_t wSamplePoint)
+{
+    BspCanBitTiming_t tTiming = {0};
+    BspCanError_e     eError  = BspCanCalcBitTiming(HAL_RCC_GetPCLK1Freq(), uBitrate, wSamplePoint, &tTiming);
+    if (eError != eBSP_CAN_ERR_NONE)
     {
-        return NULL;
+        return eError;
     }
 
-    return &s_aModules[handle];
+    CAN_TypeDef* pCan = pModule->pHalHandle->Instance;
+    pCan->BTR         = (pCan->BTR & (CAN_BTR_SILM | CAN_BTR_LBKM)) | sBitTimingToBtr(&tTiming);
+
+    return eBSP_CAN_ERR_NONE;
 }
 
+#if BSP_CAN_MAX_RTR_RESPONDERS > 0
 /* ============================================================================
- * Public API Implementation
+ * Private Helper Functions - Remote Frame Responders
  * ========================================================================== */
 
-BspCanHandle_t BspCanAllocate(const BspCanConfig_t* pConfig, LiveLed_t* pTxLed, LiveLed_t* pRxLed)
+/**
+ * @brief Find RTR responder by ID.
+ * @return Responder index, or 0xFF if not registered.
+ */
+FORCE_STATIC uint8_t sRtrFindResponder(const BspCanModule_t* pModule, uint32_t uId, BspCanIdType_e eIdType)
 {
-    if (pConfig == NULL)
+    for (uint8_t i = 0u; i < pModule->byRtrResponderCount; i++)
     {
-        return BSP_CAN_INVALID_HANDLE;
+        if ((pModule->aRtrResponders[i].uId == uId) && (pModule->aRtrResponders[i].eIdType == eIdType))
+        {
+            return i;
+        }
     }
+    return 0xFFu;
+}
 
-    if (pConfig->eInstance >= eBSP_CAN_INSTANCE_COUNT)
+/**
+ * @brief Answer a received remote frame from the responder table (ISR context).
+ *
+ * Enqueues the current payload of a matching responder as a data frame and
+ * kicks the TX path. Does nothing if no responder matches or no payload has
+ * been published yet.
+ */
+FORCE_STATIC void sRtrHandleRemoteFrame(BspCanModule_t* pModule, const CAN_RxHeaderTypeDef* pRxHeader)
+{
+    BspCanIdType_e eIdType = (pRxHeader->IDE == CAN_ID_STD) ? eBSP_CAN_ID_STANDARD : eBSP_CAN_ID_EXTENDED;
+    uint32_t       uId     = (eIdType == eBSP_CAN_ID_STANDARD) ? pRxHeader->StdId : pRxHeader->ExtId;
+
+    /* Critical section: the TX pool is shared with thread context and the other ISRs */
+    __disable_irq();
+
+    uint8_t byIdx = sRtrFindResponder(pModule, uId, eIdType);
+    if ((byIdx != 0xFFu) && pModule->aRtrResponders[byIdx].bPayloadValid)
     {
-        return BSP_CAN_INVALID_HANDLE;
-    }
+        const BspCanRtrResponder_t* pResponder = &pModule->aRtrResponders[byIdx];
+        uint8_t                     byActive   = pResponder->byActive;
+        BspCanMessage_t             tReply     = {.uId        = uId,
+                                                  .eIdType    = eIdType,
+                                                  .eFrameType = eBSP_CAN_FRAME_DATA,
+                                                  .byDataLen  = pResponder->abyDataLen[byActive]};
+        memcpy(tReply.aData, pResponder->aPayload[byActive], 8u);
 
-    /* Find free module slot */
+        if (sTxQueueSubmit(pModule, &tReply, pResponder->byPriority, pResponder->uTxId) == eBSP_CAN_ERR_NONE)
+        {
+#if BSP_CAN_ENABLE_STATISTICS
+            pModule->uRtrReplies++;
+#endif
+        }
+    }
+
+    __enable_irq();
+}
+#endif
+
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+/* ============================================================================
+ * Private Helper Functions - RX Rate Monitors
+ * ========================================================================== */
+
+/** Gaps are clamped so that gap × 16 fits a signed 32-bit delta */
+#define CAN_RATE_MAX_GAP_MS (0x07FFFFFFu)
+
+/**
+ * @brief Hash a CAN ID into the rate monitor index (Fibonacci hashing).
+ */
+FORCE_STATIC uint8_t sRateHash(uint32_t uId, BspCanIdType_e eIdType)
+{
+    return (uint8_t)(((uId ^ ((uint32_t)eIdType << 31u)) * 2654435761u) >> (32u - CAN_RATE_HASH_BITS));
+}
+
+/**
+ * @brief Find rate monitor entry by ID (linear probing).
+ * @return Entry index or 0xFF if not monitored.
+ */
+FORCE_STATIC uint8_t sRateFind(const BspCanModule_t* pModule, uint32_t uId, BspCanIdType_e eIdType)
+{
+    uint8_t bySlot = sRateHash(uId, eIdType);
+
+    for (uint8_t i = 0u; i < CAN_RATE_HASH_SIZE; i++)
+    {
+        uint8_t byIdx = pModule->abyRateHash[bySlot];
+        if (byIdx == 0xFFu)
+        {
+            break;
+        }
+
+        const BspCanRateEntry_t* pEntry = &pModule->aRateEntries[byIdx];
+        if ((pEntry->uId == uId) && (pEntry->eIdType == eIdType))
+        {
+            return byIdx;
+        }
+
+        bySlot = (uint8_t)((bySlot + 1u) & (CAN_RATE_HASH_SIZE - 1u));
+    }
+
+    return 0xFFu;
+}
+
+/**
+ * @brief Rebuild the hash index from the entry table (call with interrupts disabled).
+ */
+FORCE_STATIC void sRateRebuildHash(BspCanModule_t* pModule)
+{
+    memset(pModule->abyRateHash, 0xFF, sizeof(pModule->abyRateHash));
+
+    for (uint8_t byIdx = 0u; byIdx < pModule->byRateMonitorCount; byIdx++)
+    {
+        const BspCanRateEntry_t* pEntry = &pModule->aRateEntries[byIdx];
+        uint8_t                  bySlot = sRateHash(pEntry->uId, pEntry->eIdType);
+
+        while (pModule->abyRateHash[bySlot] != 0xFFu)
+        {
+            bySlot = (uint8_t)((bySlot + 1u) & (CAN_RATE_HASH_SIZE - 1u));
+        }
+        pModule->abyRateHash[bySlot] = byIdx;
+    }
+}
+
+/**
+ * @brief Update the rate monitor entry of a received frame (RX ISR, O(1)).
+ *
+ * The FIFO0 and FIFO1 interrupts may preempt each other, so the entry is
+ * updated with interrupts disabled; the recovery callback runs afterwards.
+ */
+FORCE_STATIC void sRateUpdate(BspCanHandle_t handle, BspCanModule_t* pModule, const CAN_RxHeaderTypeDef* pRxHeader)
+{
+    BspCanIdType_e eIdType = (pRxHeader->IDE == CAN_ID_STD) ? eBSP_CAN_ID_STANDARD : eBSP_CAN_ID_EXTENDED;
+    uint32_t       uId     = (pRxHeader->IDE == CAN_ID_STD) ? pRxHeader->StdId : pRxHeader->ExtId;
+
+    __disable_irq();
+
+    uint8_t byIdx = sRateFind(pModule, uId, eIdType);
+    if (byIdx == 0xFFu)
+    {
+        __enable_irq();
+        return;
+    }
+
+    BspCanRateEntry_t* pEntry = &pModule->aRateEntries[byIdx];
+    uint32_t           uNow   = HAL_GetTick();
+
+    if (pEntry->uCount > 0u)
+    {
+        uint32_t uGap = uNow - pEntry->uLastTick;
+        uGap          = (uGap < CAN_RATE_MAX_GAP_MS) ? uGap : CAN_RATE_MAX_GAP_MS;
+
+        if (uGap < pEntry->uMinGap)
+        {
+            pEntry->uMinGap = uGap;
+        }
+        if (uGap > pEntry->uMaxGap)
+        {
+            pEntry->uMaxGap = uGap;
+        }
+
+        if (pEntry->uCount == 1u)
+        {
+            /* First gap seeds the average */
+            pEntry->uPeriodQ4 = uGap << 4u;
+        }
+        else
+        {
+            int32_t  iDelta = (int32_t)(uGap << 4u) - (int32_t)pEntry->uPeriodQ4;
+            uint32_t uDev   = (iDelta < 0) ? (uint32_t)(-iDelta) : (uint32_t)iDelta;
+
+            pEntry->uPeriodQ4 = (uint32_t)((int32_t)pEntry->uPeriodQ4 + (iDelta / 8));
+            pEntry->uJitterQ4 = (uint32_t)((int32_t)pEntry->uJitterQ4 + (((int32_t)uDev - (int32_t)pEntry->uJitterQ4) / 16));
+        }
+    }
+
+    pEntry->uLastTick = uNow;
+    pEntry->uCount++;
+
+    bool bRecovered   = pEntry->bTimedOut;
+    pEntry->bTimedOut = false;
+
+    __enable_irq();
+
+    if (bRecovered && (pModule->pRateTimeoutCallback != NULL))
+    {
+        pModule->pRateTimeoutCallback(handle, uId, eIdType, false);
+    }
+}
+
+/**
+ * @brief Shared software timer callback: report silent IDs on all instances.
+ */
+FORCE_STATIC void sRateCheckTimeouts(void)
+{
+    for (uint8_t byModule = 0u; byModule < BSP_CAN_MAX_INSTANCES; byModule++)
+    {
+        BspCanModule_t* pModule = &s_aModules[byModule];
+        if (!pModule->bAllocated || (pModule->byRateMonitorCount == 0u))
+        {
+            continue;
+        }
+
+        for (uint8_t byIdx = 0u; byIdx < pModule->byRateMonitorCount; byIdx++)
+        {
+            BspCanRateEntry_t* pEntry = &pModule->aRateEntries[byIdx];
+
+            /* Sample tick inside the critical section so an RX update cannot land in between */
+            __disable_irq();
+            uint32_t uSilent  = HAL_GetTick() - pEntry->uLastTick;
+            bool     bExpired = (pEntry->uTimeoutMs != 0u) && !pEntry->bTimedOut && (uSilent >= pEntry->uTimeoutMs);
+            if (bExpired)
+            {
+                pEntry->bTimedOut = true;
+                pEntry->uTimeouts++;
+            }
+            uint32_t       uId     = pEntry->uId;
+            BspCanIdType_e eIdType = pEntry->eIdType;
+            __enable_irq();
+
+            if (bExpired && (pModule->pRateTimeoutCallback != NULL))
+            {
+                pModule->pRateTimeoutCallback((BspCanHandle_t)byModule, uId, eIdType, true);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Convert ms × 16 to µs, saturating above UINT32_MAX (periods over about 71 minutes).
+ */
+FORCE_STATIC uint32_t sRateQ4ToUs(uint32_t uQ4)
+{
+    uint64_t uUs = ((uint64_t)uQ4 * 1000u) >> 4u;
+    return (uUs > UINT32_MAX) ? UINT32_MAX : (uint32_t)uUs;
+}
+
+/**
+ * @brief Copy a rate monitor entry into the public snapshot structure.
+ *
+ * Call with interrupts disabled: the RX ISR updates the entry and
+ * BspCanRemoveRateMonitor() moves entries around.
+ */
+FORCE_STATIC void sRateFillStats(const BspCanRateEntry_t* pEntry, BspCanRateStats_t* pStats)
+{
+    pStats->uId         = pEntry->uId;
+    pStats->eIdType     = pEntry->eIdType;
+    pStats->uTimeoutMs  = pEntry->uTimeoutMs;
+    pStats->uCount      = pEntry->uCount;
+    pStats->uLastRxTick = pEntry->uLastTick;
+    pStats->uPeriodUs   = sRateQ4ToUs(pEntry->uPeriodQ4);
+    pStats->uJitterUs   = sRateQ4ToUs(pEntry->uJitterQ4);
+    pStats->uMinGapMs   = (pEntry->uCount > 1u) ? pEntry->uMinGap : 0u;
+    pStats->uMaxGapMs   = pEntry->uMaxGap;
+    pStats->uTimeouts   = pEntry->uTimeouts;
+    pStats->bTimedOut   = pEntry->bTimedOut;
+}
+#endif
+
+/* ============================================================================
+ * Private Helper Functions - Accept-All Filter Banks
+ * ========================================================================== */
+
+/**
+ * @brief Configure one accept-all filter bank (monitor capture, autobaud).
+ *
+ * Bit 5 of FilterIdHigh is the base-ID LSB (STID[0]), so banks with id 0 and
+ * 0x0020 under mask 0x0020 partition all traffic between the two FIFOs.
+ */
+FORCE_STATIC HAL_StatusTypeDef sAcceptAllConfigFilter(CAN_HandleTypeDef* pHal, uint32_t uBank, uint32_t uIdHigh, uint32_t uFifo)
+{
+    CAN_FilterTypeDef sFilterConfig = {0};
+
+    sFilterConfig.FilterIdHigh         = uIdHigh;
+    sFilterConfig.FilterMaskIdHigh     = 0x0020u;
+    sFilterConfig.FilterScale          = CAN_FILTERSCALE_32BIT;
+    sFilterConfig.FilterMode           = CAN_FILTERMODE_IDMASK;
+    sFilterConfig.FilterFIFOAssignment = uFifo;
+    sFilterConfig.FilterBank           = uBank;
+    sFilterConfig.FilterActivation     = CAN_FILTER_ENABLE;
+
+    return HAL_CAN_ConfigFilter(pHal, &sFilterConfig);
+}
+
+/**
+ * @brief Deactivate the two accept-all banks.
+ *
+ * A later BspCanStart() only programs the banks of its own filters, so
+ * leaving them active would keep accepting all traffic.
+ */
+FORCE_STATIC void sAcceptAllReleaseFilters(CAN_HandleTypeDef* pHal)
+{
+    for (uint32_t uBank = 0u; uBank < 2u; uBank++)
+    {
+        CAN_FilterTypeDef sFilterConfig = {0};
+
+        sFilterConfig.FilterScale      = CAN_FILTERSCALE_32BIT;
+        sFilterConfig.FilterMode       = CAN_FILTERMODE_IDMASK;
+        sFilterConfig.FilterBank       = uBank;
+        sFilterConfig.FilterActivation = CAN_FILTER_DISABLE;
+
+        (void)HAL_CAN_ConfigFilter(pHal, &sFilterConfig);
+    }
+}
+
+#if BSP_CAN_ENABLE_MONITOR
+/* ============================================================================
+ * Private Helper Functions - Bus Monitor
+ * ========================================================================== */
+
+/** Length of the capture rate window in ms */
+#define CAN_MONITOR_RATE_WINDOW_MS (1000u)
+
+/**
+ * @brief Close the rate window if it has elapsed.
+ *
+ * Called for every captured frame and from BspCanGetMonitorStats(), so an
+ * idle bus reports 0 instead of the last busy window. Windows stay aligned to
+ * the capture start; call with interrupts disabled.
+ */
+FORCE_STATIC void sMonitorRollWindow(BspCanModule_t* pModule, uint32_t uNow)
+{
+    uint32_t uElapsed = uNow - pModule->uMonWindowStart;
+
+    if (uElapsed >= CAN_MONITOR_RATE_WINDOW_MS)
+    {
+        /* More than one window gone: the last complete one saw no frames */
+        pModule->tMonStats.uFramesPerSecond = (uElapsed < (2u * CAN_MONITOR_RATE_WINDOW_MS)) ? pModule->uMonWindowFrames : 0u;
+        pModule->uMonWindowFrames           = 0u;
+        pModule->uMonWindowStart            = uNow - (uElapsed % CAN_MONITOR_RATE_WINDOW_MS);
+    }
+}
+
+/**
+ * @brief Capture one frame from a hardware FIFO into the monitor ring.
+ *
+ * The payload is read by HAL straight into the ring slot; the write index is
+ * published after a barrier so the consumer never sees a partial record.
+ * Call with interrupts disabled: the FIFO0 and FIFO1 interrupts both write
+ * the ring and the monitor statistics and may preempt each other.
+ */
+FORCE_STATIC void sMonitorCapture(BspCanModule_t* pModule, CAN_HandleTypeDef* hcan, uint32_t uFifo)
+{
+    CAN_RxHeaderTypeDef tRxHeader = {0};
+    uint32_t            uNow      = HAL_GetTick();
+    uint32_t            uWrite    = pModule->uMonWrite;
+    uint32_t            uUsed     = uWrite - pModule->uMonRead;
+
+    /* Rate accounting covers every frame seen on the bus, dropped or not */
+    sMonitorRollWindow(pModule, uNow);
+    pModule->uMonWindowFrames++;
+
+    if (uUsed > pModule->uMonMask)
+    {
+        /* Ring full: still release the hardware FIFO slot */
+        uint8_t aDiscard[8];
+        (void)HAL_CAN_GetRxMessage(hcan, uFifo, &tRxHeader, aDiscard);
+        pModule->tMonStats.uDropped++;
+        return;
+    }
+
+    BspCanMonitorRecord_t* pRecord = &pModule->pMonRing[uWrite & pModule->uMonMask];
+
+    if (HAL_CAN_GetRxMessage(hcan, uFifo, &tRxHeader, pRecord->aData) != HAL_OK)
+    {
+        return;
+    }
+
+    uint8_t byFlags = (uFifo == CAN_RX_FIFO1) ? BSP_CAN_MON_FLAG_FIFO1 : 0u;
+    if (tRxHeader.IDE == CAN_ID_STD)
+    {
+        pRecord->uId = tRxHeader.StdId;
+    }
+    else
+    {
+        pRecord->uId = tRxHeader.ExtId;
+        byFlags |= BSP_CAN_MON_FLAG_EXT;
+    }
+    if (tRxHeader.RTR == CAN_RTR_REMOTE)
+    {
+        byFlags |= BSP_CAN_MON_FLAG_RTR;
+    }
+
+    pRecord->uTimestamp = uNow;
+    pRecord->byDlc      = (uint8_t)tRxHeader.DLC;
+    pRecord->byFlags    = byFlags;
+
+    /* Publish record */
+    __DMB();
+    pModule->uMonWrite = uWrite + 1u;
+
+    pModule->tMonStats.uCaptured++;
+    if ((uUsed + 1u) > pModule->tMonStats.uHighWater)
+    {
+        pModule->tMonStats.uHighWater = uUsed + 1u;
+    }
+}
+#endif
+
+/* ============================================================================
+ * Private Helper Functions - Validation
+ * ========================================================================== */
+
+/**
+ * @brief Validate handle.
+ * @return Pointer to module or NULL if invalid.
+ */
+FORCE_STATIC BspCanModule_t* sValidateHandle(BspCanHandle_t handle)
+{
+    if ((handle < 0) || ((uint8_t)handle >= BSP_CAN_MAX_INSTANCES))
+    {
+        return NULL;
+    }
+
+    if (!s_aModules[handle].bAllocated)
+    {
+        return NULL;
+    }
+
+    return &s_aModules[handle];
+}
+
+/* ============================================================================
+ * Private Functions - RX FIFO Load Balancing
+ * ========================================================================== */
+
+/**
+ * @brief Expected frame rate of a filter (frames/s).
+ *
+ * Uses the declared rate, otherwise the summed measured rate of every rate
+ * monitor the filter accepts, otherwise 1 so that unknown filters still alternate.
+ */
+FORCE_STATIC uint32_t sFilterRate(const BspCanModule_t* pModule, const BspCanFilter_t* pFilter)
+{
+    if (pFilter->wExpectedRate != 0u)
+    {
+        return pFilter->wExpectedRate;
+    }
+
+    uint32_t uRate = 0u;
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+    for (uint8_t i = 0u; i < pModule->byRateMonitorCount; i++)
+    {
+        const BspCanRateEntry_t* pEntry = &pModule->aRateEntries[i];
+
+        if ((pEntry->uCount >= 2u) && (pEntry->eIdType == pFilter->eIdType) &&
+            (((pEntry->uId ^ pFilter->uFilterId) & pFilter->uFilterMask) == 0u))
+        {
+            /* uPeriodQ4 is ms × 16; a zero period means several frames per tick */
+            uRate += 16000u / ((pEntry->uPeriodQ4 != 0u) ? pEntry->uPeriodQ4 : 1u);
+        }
+    }
+#else
+    (void)pModule;
+#endif
+
+    return (uRate != 0u) ? uRate : 1u;
+}
+
+/**
+ * @brief Resolve every filter to FIFO0 or FIFO1.
+ *
+ * Fixed and critical filters are placed first; the remaining BSP_CAN_FIFO_AUTO
+ * filters go heaviest first to the less loaded FIFO (ties to FIFO1, keeping
+ * the critical FIFO light).
+ *
+ * @return true if any filter used BSP_CAN_FIFO_AUTO.
+ */
+FORCE_STATIC bool sBalanceFifos(BspCanModule_t* pModule)
+{
+    uint32_t auLoad[2] = {0u, 0u};
+    uint32_t auRate[BSP_CAN_MAX_FILTERS]   = {0u};
+    uint8_t  abyOrder[BSP_CAN_MAX_FILTERS] = {0u};
+    uint8_t  byOrderCount = 0u;
+    bool     bAuto        = false;
+
+    for (uint8_t i = 0u; i < pModule->byFilterCount; i++)
+    {
+        const BspCanFilter_t* pFilter = &pModule->aFilters[i];
+
+        if (pFilter->byFifoAssignment != BSP_CAN_FIFO_AUTO)
+        {
+            pModule->abyFilterFifo[i] = (pFilter->byFifoAssignment == 0u) ? 0u : 1u;
+            continue;
+        }
+
+        bAuto     = true;
+        auRate[i] = sFilterRate(pModule, pFilter);
+
+        if (pFilter->bCritical)
+        {
+            pModule->abyFilterFifo[i] = 0u;
+            auLoad[0] += auRate[i];
+            continue;
+        }
+
+        /* Insertion sort, highest rate first */
+        uint8_t j = byOrderCount;
+        while ((j > 0u) && (auRate[abyOrder[j - 1u]] < auRate[i]))
+        {
+            abyOrder[j] = abyOrder[j - 1u];
+            j--;
+        }
+        abyOrder[j] = i;
+        byOrderCount++;
+    }
+
+    if (!bAuto)
+    {
+        return false;
+    }
+
+    /* Fixed filters load their FIFO too (rate only needed when balancing) */
+    for (uint8_t i = 0u; i < pModule->byFilterCount; i++)
+    {
+        if (pModule->aFilters[i].byFifoAssignment != BSP_CAN_FIFO_AUTO)
+        {
+            auLoad[pModule->abyFilterFifo[i]] += sFilterRate(pModule, &pModule->aFilters[i]);
+        }
+    }
+
+    for (uint8_t k = 0u; k < byOrderCount; k++)
+    {
+        uint8_t byIdx  = abyOrder[k];
+        uint8_t byFifo = (auLoad[1] <= auLoad[0]) ? 1u : 0u;
+
+        pModule->abyFilterFifo[byIdx] = byFifo;
+        auLoad[byFifo] += auRate[byIdx];
+    }
+
+    return true;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ========================================================================== */
+
+BspCanHandle_t BspCanAllocate(const BspCanConfig_t* pConfig, LiveLed_t* pTxLed, LiveLed_t* pRxLed)
+{
+    if (pConfig == NULL)
+    {
+        return BSP_CAN_INVALID_HANDLE;
+    }
+
+    if (pConfig->eInstance >= eBSP_CAN_INSTANCE_COUNT)
+    {
+        return BSP_CAN_INVALID_HANDLE;
+    }
+
+    /* Find free module slot */
     BspCanHandle_t handle = BSP_CAN_INVALID_HANDLE;
     for (uint8_t i = 0u; i < BSP_CAN_MAX_INSTANCES; i++)
     {
-        if (!s_aModules[i].bAllocated)
+        if (!s_aModules[i].bAllocated)
+        {
+            handle = (BspCanHandle_t)i;
+            break;
+        }
+    }
+
+    if (handle == BSP_CAN_INVALID_HANDLE)
+    {
+        return BSP_CAN_INVALID_HANDLE;
+    }
+
+    BspCanModule_t* pModule = &s_aModules[handle];
+
+    /* Initialize module */
+    memset(pModule, 0, sizeof(BspCanModule_t));
+    pModule->tConfig = *pConfig;
+
+    /* Lookup HAL handle from instance enum */
+    pModule->pHalHandle = s_apHalHandles[pConfig->eInstance];
+
+    pModule->bAllocated = true;
+    pModule->bStarted   = false;
+    pModule->pTxLed     = pTxLed;
+    pModule->pRxLed     = pRxLed;
+
+    /* Initialize queues and buffers */
+    sTxQueueInit(&pModule->tTxQueue);
+    sRxBufferInit(&pModule->tRxBuffer);
+    pModule->tTxQueue.bIdOrdered = (pConfig->eTxOrder == eBSP_CAN_TX_ORDER_CAN_ID);
+
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+    memset(pModule->abyRateHash, 0xFF, sizeof(pModule->abyRateHash));
+#endif
+
+    return handle;
+}
+
+BspCanError_e BspCanFree(BspCanHandle_t handle)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    /* Stop if started */
+    if (pModule->bStarted)
+    {
+        (void)BspCanStop(handle);
+    }
+
+    /* Clear module */
+    memset(pModule, 0, sizeof(BspCanModule_t));
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanAddFilter(BspCanHandle_t handle, const BspCanFilter_t* pFilter)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    if (pFilter == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->bStarted)
+    {
+        return eBSP_CAN_ERR_ALREADY_STARTED;
+    }
+
+    if (pModule->byFilterCount >= BSP_CAN_MAX_FILTERS)
+    {
+        return eBSP_CAN_ERR_FILTER_FULL;
+    }
+
+    /* Store filter configuration (will be activated in BspCanStart) */
+    pModule->aFilters[pModule->byFilterCount] = *pFilter;
+    pModule->byFilterCount++;
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanStart(BspCanHandle_t handle)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    if (pModule->bStarted)
+    {
+        return eBSP_CAN_ERR_ALREADY_STARTED;
+    }
+
+    CAN_HandleTypeDef* pHal = pModule->pHalHandle;
+
+    /* Mailbox send order (MCR is writable in initialization mode, before HAL_CAN_Start) */
+    if (pModule->tConfig.eMailboxOrder == eBSP_CAN_MBX_ORDER_FIFO)
+    {
+        pHal->Instance->MCR |= CAN_MCR_TXFP;
+    }
+    else if (pModule->tConfig.eMailboxOrder == eBSP_CAN_MBX_ORDER_SAME_ID_FIFO)
+    {
+        pHal->Instance->MCR &= ~CAN_MCR_TXFP;
+    }
+
+    /* Balance BSP_CAN_FIFO_AUTO filters; critical IDs in FIFO0 are serviced first */
+    if (sBalanceFifos(pModule))
+    {
+        HAL_NVIC_SetPriority(s_aeRxIrqs[pModule->tConfig.eInstance][0], BSP_CAN_RX0_IRQ_PRIORITY, 0u);
+        HAL_NVIC_SetPriority(s_aeRxIrqs[pModule->tConfig.eInstance][1], BSP_CAN_RX1_IRQ_PRIORITY, 0u);
+    }
+
+    /* Configure filters atomically */
+    for (uint8_t i = 0u; i < pModule->byFilterCount; i++)
+    {
+        CAN_FilterTypeDef sFilterConfig = {0};
+
+        if (pModule->aFilters[i].eIdType == eBSP_CAN_ID_STANDARD)
+        {
+            sFilterConfig.FilterIdHigh     = (pModule->aFilters[i].uFilterId << 5u);
+            sFilterConfig.FilterMaskIdHigh = (pModule->aFilters[i].uFilterMask << 5u);
+            sFilterConfig.FilterIdLow      = 0u;
+            sFilterConfig.FilterMaskIdLow  = 0u;
+            sFilterConfig.FilterScale      = CAN_FILTERSCALE_32BIT;
+        }
+        else
+        {
+            sFilterConfig.FilterIdHigh     = (uint16_t)(pModule->aFilters[i].uFilterId >> 13u);
+            sFilterConfig.FilterIdLow      = (uint16_t)((pModule->aFilters[i].uFilterId << 3u) | 0x04u);
+            sFilterConfig.FilterMaskIdHigh = (uint16_t)(pModule->aFilters[i].uFilterMask >> 13u);
+            sFilterConfig.FilterMaskIdLow  = (uint16_t)((pModule->aFilters[i].uFilterMask << 3u) | 0x04u);
+            sFilterConfig.FilterScale      = CAN_FILTERSCALE_32BIT;
+        }
+
+        sFilterConfig.FilterMode           = CAN_FILTERMODE_IDMASK;
+        sFilterConfig.FilterFIFOAssignment = (pModule->abyFilterFifo[i] == 0u) ? CAN_FILTER_FIFO0 : CAN_FILTER_FIFO1;
+        sFilterConfig.FilterBank           = i;
+        sFilterConfig.FilterActivation     = CAN_FILTER_ENABLE;
+
+        if (HAL_CAN_ConfigFilter(pHal, &sFilterConfig) != HAL_OK)
+        {
+            return eBSP_CAN_ERR_HAL_ERROR;
+        }
+    }
+
+    /* Start CAN */
+    if (HAL_CAN_Start(pHal) != HAL_OK)
+    {
+        return eBSP_CAN_ERR_HAL_ERROR;
+    }
+
+    /* Activate RX interrupts */
+    if (HAL_CAN_ActivateNotification(pHal, CAN_IT_NORMAL) != HAL_OK)
+    {
+        HAL_CAN_Stop(pHal);
+        return eBSP_CAN_ERR_HAL_ERROR;
+    }
+
+    pModule->bStarted = true;
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanGetFilterFifo(BspCanHandle_t handle, uint8_t byFilterIndex, uint8_t* pbyFifo)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    if ((pbyFifo == NULL) || (byFilterIndex >= pModule->byFilterCount))
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
+
+    if (!pModule->bStarted)
+    {
+        return eBSP_CAN_ERR_NOT_STARTED;
+    }
+
+    *pbyFifo = pModule->abyFilterFifo[byFilterIndex];
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanStop(BspCanHandle_t handle)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    if (!pModule->bStarted)
+    {
+        return eBSP_CAN_ERR_NOT_STARTED;
+    }
+
+    /* Deactivate every notification either start path enabled */
+    (void)HAL_CAN_DeactivateNotification(pModule->pHalHandle, CAN_IT_NORMAL | CAN_IT_MONITOR);
+
+    /* Stop CAN peripheral */
+    (void)HAL_CAN_Stop(pModule->pHalHandle);
+
+#if BSP_CAN_ENABLE_MONITOR
+    if (pModule->bMonitor)
+    {
+        /* Back in initialization mode: restore the original silent bit and drop the accept-all banks */
+        pModule->pHalHandle->Instance->BTR = pModule->uMonSavedBtr;
+        pModule->bMonitor                  = false;
+        sAcceptAllReleaseFilters(pModule->pHalHandle);
+    }
+#endif
+
+    pModule->bStarted = false;
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanCalcBitTiming(uint32_t uClockHz, uint32_t uBitrate, uint16_t wSamplePoint, BspCanBitTiming_t* pTiming)
+{
+    if ((pTiming == NULL) || (uBitrate == 0u) || (wSamplePoint > 1000u))
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
+
+    if (wSamplePoint == 0u)
+    {
+        wSamplePoint = BSP_CAN_DEFAULT_SAMPLE_POINT;
+    }
+
+    uint32_t uBestError = UINT32_MAX;
+
+    for (uint32_t uTq = CAN_BIT_TQ_MAX; uTq >= CAN_BIT_TQ_MIN; uTq--)
+    {
+        uint32_t uQuantaRate = uBitrate * uTq;
+        if ((uQuantaRate / uTq != uBitrate) || ((uClockHz % uQuantaRate) != 0u))
+        {
+            continue; /* Overflow or no exact prescaler */
+        }
+
+        uint32_t uPrescaler = uClockHz / uQuantaRate;
+        if ((uPrescaler == 0u) || (uPrescaler > 1024u))
+        {
+            continue;
+        }
+
+        /* Sample point = (1 + BS1) / TQ, rounded to the nearest quantum, BS1 in 1..16, BS2 in 1..8 */
+        uint32_t uBs1 = (uTq * wSamplePoint + 500u) / 1000u;
+        uBs1          = (uBs1 > 1u) ? (uBs1 - 1u) : 1u;
+        uBs1          = (uBs1 < 16u) ? uBs1 : 16u;
+        uBs1          = (uBs1 < (uTq - 2u)) ? uBs1 : (uTq - 2u);
+        uBs1          = ((uTq - 1u - uBs1) <= 8u) ? uBs1 : (uTq - 9u);
+        uint32_t uBs2 = uTq - 1u - uBs1;
+
+        uint32_t uSamplePoint = ((1u + uBs1) * 1000u) / uTq;
+        uint32_t uError       = (uSamplePoint > wSamplePoint) ? (uSamplePoint - wSamplePoint) : (wSamplePoint - uSamplePoint);
+
+        /* Strictly better only: on ties keep the solution with more quanta */
+        if (uError < uBestError)
+        {
+            uBestError            = uError;
+            pTiming->wPrescaler   = (uint16_t)uPrescaler;
+            pTiming->byBs1        = (uint8_t)uBs1;
+            pTiming->byBs2        = (uint8_t)uBs2;
+            pTiming->bySjw        = (uint8_t)((uBs2 < 4u) ? uBs2 : 4u);
+            pTiming->wSamplePoint = (uint16_t)uSamplePoint;
+        }
+    }
+
+    return (uBestError == UINT32_MAX) ? eBSP_CAN_ERR_INVALID_PARAM : eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanSetBitrate(BspCanHandle_t handle, uint32_t uBitrate, uint16_t wSamplePoint)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    /* BTR is only writable in initialization mode (before HAL_CAN_Start / after HAL_CAN_Stop) */
+    if (pModule->bStarted)
+    {
+        return eBSP_CAN_ERR_ALREADY_STARTED;
+    }
+
+    return sApplyBitrate(pModule, uBitrate, wSamplePoint);
+}
+
+BspCanError_e BspCanAutoBaud(BspCanHandle_t handle, const uint32_t* pBitrates, uint8_t byCount, uint32_t uListenMs, uint32_t* pDetected)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    if ((pBitrates == NULL) || (byCount == 0u) || (pDetected == NULL))
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->bStarted)
+    {
+        return eBSP_CAN_ERR_ALREADY_STARTED;
+    }
+
+    CAN_HandleTypeDef* pHal      = pModule->pHalHandle;
+    CAN_TypeDef*       pCan      = pHal->Instance;
+    uint32_t           uSavedBtr = pCan->BTR;
+    BspCanError_e      eResult   = eBSP_CAN_ERR_TIMEOUT;
+
+    /* Accept all traffic, so a frame received without error shows up in a FIFO */
+    if ((sAcceptAllConfigFilter(pHal, 0u, 0x0000u, CAN_FILTER_FIFO0) != HAL_OK) ||
+        (sAcceptAllConfigFilter(pHal, 1u, 0x0020u, CAN_FILTER_FIFO1) != HAL_OK))
+    {
+        sAcceptAllReleaseFilters(pHal);
+        return eBSP_CAN_ERR_HAL_ERROR;
+    }
+
+    for (uint8_t i = 0u; (i < byCount) && (eResult == eBSP_CAN_ERR_TIMEOUT); i++)
+    {
+        if (sApplyBitrate(pModule, pBitrates[i], 0u) != eBSP_CAN_ERR_NONE)
         {
-            handle = (BspCanHandle_t)i;
+            continue; /* Not reachable from this APB1 clock */
+        }
+
+        /* Listen only: never ACK or send error frames on a bus at the wrong rate */
+        pCan->BTR |= CAN_BTR_SILM;
+        pCan->ESR = (pCan->ESR & ~CAN_ESR_LEC) | (CAN_LEC_UNSET << CAN_ESR_LEC_Pos);
+
+        if (HAL_CAN_Start(pHal) != HAL_OK)
+        {
+            eResult = eBSP_CAN_ERR_HAL_ERROR;
             break;
         }
+
+        /* LEC 1-6 rejects the candidate at once; LEC 0 alone is no proof (it also
+           reads 0 on a silent bus), only a frame delivered to a FIFO accepts it */
+        uint32_t uLec      = CAN_LEC_UNSET;
+        bool     bReceived = false;
+        uint32_t uStart    = HAL_GetTick();
+        while (!bReceived && ((uLec == CAN_LEC_UNSET) || (uLec == 0u)) && ((HAL_GetTick() - uStart) < uListenMs))
+        {
+            uLec      = (pCan->ESR & CAN_ESR_LEC) >> CAN_ESR_LEC_Pos;
+            bReceived = ((pCan->RF0R & CAN_RF0R_FMP0) != 0u) || ((pCan->RF1R & CAN_RF1R_FMP1) != 0u);
+        }
+
+        /* Drop the captured frames (3 per FIFO at most) so they never reach the application */
+        for (uint8_t j = 0u; j < 3u; j++)
+        {
+            if ((pCan->RF0R & CAN_RF0R_FMP0) != 0u)
+            {
+                pCan->RF0R = CAN_RF0R_RFOM0;
+            }
+            if ((pCan->RF1R & CAN_RF1R_FMP1) != 0u)
+            {
+                pCan->RF1R = CAN_RF1R_RFOM1;
+            }
+        }
+
+        (void)HAL_CAN_Stop(pHal);
+
+        if (bReceived)
+        {
+            pCan->BTR  = (pCan->BTR & ~CAN_BTR_SILM) | (uSavedBtr & CAN_BTR_SILM);
+            *pDetected = pBitrates[i];
+            eResult    = eBSP_CAN_ERR_NONE;
+        }
     }
 
-    if (handle == BSP_CAN_INVALID_HANDLE)
+    if (eResult != eBSP_CAN_ERR_NONE)
     {
-        return BSP_CAN_INVALID_HANDLE;
+        pCan->BTR = uSavedBtr;
     }
+    sAcceptAllReleaseFilters(pHal);
 
-    BspCanModule_t* pModule = &s_aModules[handle];
+    return eResult;
+}
 
-    /* Initialize module */
-    memset(pModule, 0, sizeof(BspCanModule_t));
-    pModule->tConfig = *pConfig;
+BspCanError_e BspCanTransmit(BspCanHandle_t handle, const BspCanMessage_t* pMessage, uint8_t byPriority, uint32_t uTxId)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
 
-    /* Lookup HAL handle from instance enum */
-    pModule->pHalHandle = s_apHalHandles[pConfig->eInstance];
+    if (pMessage == NULL || byPriority >= BSP_CAN_PRIORITY_LEVELS)
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
 
-    pModule->bAllocated = true;
-    pModule->bStarted   = false;
-    pModule->pTxLed     = pTxLed;
-    pModule->pRxLed     = pRxLed;
+    if (!pModule->bStarted)
+    {
+        return eBSP_CAN_ERR_NOT_STARTED;
+    }
 
-    /* Initialize queues and buffers */
-    sTxQueueInit(&pModule->tTxQueue);
-    sRxBufferInit(&pModule->tRxBuffer);
+    /* Critical section: the RX ISR allocates from the same pool for RTR replies */
+    __disable_irq();
+    BspCanError_e eError = sTxQueueSubmit(pModule, pMessage, byPriority, uTxId);
+    __enable_irq();
 
-    return handle;
+    return eError;
 }
 
-BspCanError_e BspCanFree(BspCanHandle_t handle)
+BspCanError_e BspCanAbortTransmit(BspCanHandle_t handle, uint32_t uTxId)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -553,19 +1883,36 @@ BspCanError_e BspCanFree(BspCanHandle_t handle)
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    /* Stop if started */
-    if (pModule->bStarted)
+    /* Critical section for queue manipulation */
+    __disable_irq();
+    bool bFound = sTxQueueRemoveByTxId(&pModule->tTxQueue, uTxId);
+    __enable_irq();
+
+    return bFound ? eBSP_CAN_ERR_NONE : eBSP_CAN_ERR_INVALID_PARAM;
+}
+
+BspCanError_e BspCanGetTxQueueInfo(BspCanHandle_t handle, uint8_t* pUsed, uint8_t* pFree)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
     {
-        (void)BspCanStop(handle);
+        return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    /* Clear module */
-    memset(pModule, 0, sizeof(BspCanModule_t));
+    if (pUsed != NULL)
+    {
+        *pUsed = pModule->tTxQueue.byTotalUsed;
+    }
+
+    if (pFree != NULL)
+    {
+        *pFree = BSP_CAN_TX_QUEUE_DEPTH - pModule->tTxQueue.byTotalUsed;
+    }
 
     return eBSP_CAN_ERR_NONE;
 }
 
-BspCanError_e BspCanAddFilter(BspCanHandle_t handle, const BspCanFilter_t* pFilter)
+BspCanError_e BspCanRegisterRxCallback(BspCanHandle_t handle, BspCanRxCallback_t pCallback)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -573,29 +1920,41 @@ BspCanError_e BspCanAddFilter(BspCanHandle_t handle, const BspCanFilter_t* pFilt
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    if (pFilter == NULL)
+    pModule->pRxCallback = pCallback;
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanGetRxBufferInfo(BspCanHandle_t handle, uint8_t* pUsed, uint32_t* pOverruns)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
     {
-        return eBSP_CAN_ERR_INVALID_PARAM;
+        return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    if (pModule->bStarted)
+    if (pUsed != NULL)
     {
-        return eBSP_CAN_ERR_ALREADY_STARTED;
+        *pUsed = sRxBufferGetUsed(&pModule->tRxBuffer);
     }
 
-    if (pModule->byFilterCount >= BSP_CAN_MAX_FILTERS)
+#if BSP_CAN_ENABLE_STATISTICS
+    if (pOverruns != NULL)
     {
-        return eBSP_CAN_ERR_FILTER_FULL;
+        *pOverruns = pModule->tRxBuffer.uOverrunCount;
     }
-
-    /* Store filter configuration (will be activated in BspCanStart) */
-    pModule->aFilters[pModule->byFilterCount] = *pFilter;
-    pModule->byFilterCount++;
+#else
+    if (pOverruns != NULL)
+    {
+        *pOverruns = 0u;
+    }
+#endif
 
     return eBSP_CAN_ERR_NONE;
 }
 
-BspCanError_e BspCanStart(BspCanHandle_t handle)
+#if BSP_CAN_MAX_RTR_RESPONDERS > 0
+BspCanError_e BspCanRegisterRtrResponder(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, uint8_t byPriority, uint32_t uTxId)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -603,66 +1962,133 @@ BspCanError_e BspCanStart(BspCanHandle_t handle)
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    if (pModule->bStarted)
+    if (byPriority >= BSP_CAN_PRIORITY_LEVELS)
     {
-        return eBSP_CAN_ERR_ALREADY_STARTED;
+        return eBSP_CAN_ERR_INVALID_PARAM;
     }
 
-    CAN_HandleTypeDef* pHal = pModule->pHalHandle;
+    BspCanError_e eError = eBSP_CAN_ERR_NONE;
 
-    /* Configure filters atomically */
-    for (uint8_t i = 0u; i < pModule->byFilterCount; i++)
+    /* Critical section: the RX ISR walks the table */
+    __disable_irq();
+    uint8_t byIdx = sRtrFindResponder(pModule, uId, eIdType);
+    if (byIdx != 0xFFu)
     {
-        CAN_FilterTypeDef sFilterConfig = {0};
+        pModule->aRtrResponders[byIdx].byPriority = byPriority;
+        pModule->aRtrResponders[byIdx].uTxId      = uTxId;
+    }
+    else if (pModule->byRtrResponderCount >= BSP_CAN_MAX_RTR_RESPONDERS)
+    {
+        eError = eBSP_CAN_ERR_NO_RESOURCE;
+    }
+    else
+    {
+        BspCanRtrResponder_t* pResponder = &pModule->aRtrResponders[pModule->byRtrResponderCount];
+        memset(pResponder, 0, sizeof(BspCanRtrResponder_t));
+        pResponder->uId        = uId;
+        pResponder->eIdType    = eIdType;
+        pResponder->byPriority = byPriority;
+        pResponder->uTxId      = uTxId;
+        pModule->byRtrResponderCount++;
+    }
+    __enable_irq();
 
-        if (pModule->aFilters[i].eIdType == eBSP_CAN_ID_STANDARD)
-        {
-            sFilterConfig.FilterIdHigh     = (pModule->aFilters[i].uFilterId << 5u);
-            sFilterConfig.FilterMaskIdHigh = (pModule->aFilters[i].uFilterMask << 5u);
-            sFilterConfig.FilterIdLow      = 0u;
-            sFilterConfig.FilterMaskIdLow  = 0u;
-            sFilterConfig.FilterScale      = CAN_FILTERSCALE_32BIT;
-        }
-        else
-        {
-            sFilterConfig.FilterIdHigh     = (uint16_t)(pModule->aFilters[i].uFilterId >> 13u);
-            sFilterConfig.FilterIdLow      = (uint16_t)((pModule->aFilters[i].uFilterId << 3u) | 0x04u);
-            sFilterConfig.FilterMaskIdHigh = (uint16_t)(pModule->aFilters[i].uFilterMask >> 13u);
-            sFilterConfig.FilterMaskIdLow  = (uint16_t)((pModule->aFilters[i].uFilterMask << 3u) | 0x04u);
-            sFilterConfig.FilterScale      = CAN_FILTERSCALE_32BIT;
-        }
+    return eError;
+}
 
-        sFilterConfig.FilterMode           = CAN_FILTERMODE_IDMASK;
-        sFilterConfig.FilterFIFOAssignment = (pModule->aFilters[i].byFifoAssignment == 0u) ? CAN_FILTER_FIFO0 : CAN_FILTER_FIFO1;
-        sFilterConfig.FilterBank           = i;
-        sFilterConfig.FilterActivation     = CAN_FILTER_ENABLE;
+BspCanError_e BspCanUpdateRtrPayload(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, const uint8_t* pData, uint8_t byDataLen)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
 
-        if (HAL_CAN_ConfigFilter(pHal, &sFilterConfig) != HAL_OK)
-        {
-            return eBSP_CAN_ERR_HAL_ERROR;
-        }
+    if ((byDataLen > BSP_CAN_MAX_DATA_LEN) || ((pData == NULL) && (byDataLen > 0u)))
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
     }
 
-    /* Start CAN */
-    if (HAL_CAN_Start(pHal) != HAL_OK)
+    /* Critical section: callers in other ISRs and Remove reorder the table; 8 bytes at most */
+    __disable_irq();
+
+    uint8_t byIdx = sRtrFindResponder(pModule, uId, eIdType);
+    if (byIdx == 0xFFu)
     {
-        return eBSP_CAN_ERR_HAL_ERROR;
+        __enable_irq();
+        return eBSP_CAN_ERR_INVALID_PARAM;
     }
 
-    /* Activate RX interrupts */
-    if (HAL_CAN_ActivateNotification(pHal, CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_RX_FIFO1_MSG_PENDING | CAN_IT_TX_MAILBOX_EMPTY |
-                                               CAN_IT_ERROR | CAN_IT_BUSOFF | CAN_IT_ERROR_PASSIVE) != HAL_OK)
+    BspCanRtrResponder_t* pResponder = &pModule->aRtrResponders[byIdx];
+
+    /* Fill the inactive buffer, then publish it with a single index swap */
+    uint8_t byInactive = (uint8_t)(pResponder->byActive ^ 1u);
+    memset(pResponder->aPayload[byInactive], 0, 8u);
+    if (byDataLen > 0u)
     {
-        HAL_CAN_Stop(pHal);
-        return eBSP_CAN_ERR_HAL_ERROR;
+        memcpy(pResponder->aPayload[byInactive], pData, byDataLen);
+    }
+    pResponder->abyDataLen[byInactive] = byDataLen;
+    pResponder->byActive               = byInactive;
+    pResponder->bPayloadValid          = true;
+
+    __enable_irq();
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanRemoveRtrResponder(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    bool bFound = false;
+
+    /* Critical section: swap last entry into the freed slot */
+    __disable_irq();
+    uint8_t byIdx = sRtrFindResponder(pModule, uId, eIdType);
+    if (byIdx != 0xFFu)
+    {
+        pModule->byRtrResponderCount--;
+        pModule->aRtrResponders[byIdx] = pModule->aRtrResponders[pModule->byRtrResponderCount];
+        bFound                         = true;
+    }
+    __enable_irq();
+
+    return bFound ? eBSP_CAN_ERR_NONE : eBSP_CAN_ERR_INVALID_PARAM;
+}
+#endif
+
+BspCanError_e BspCanRegisterTxCallback(BspCanHandle_t handle, BspCanTxCallback_t pCallback)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
+
+    pModule->pTxCallback = pCallback;
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanRegisterErrorCallback(BspCanHandle_t handle, BspCanErrorCallback_t pCallback)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    pModule->bStarted = true;
+    pModule->pErrorCallback = pCallback;
 
     return eBSP_CAN_ERR_NONE;
 }
 
-BspCanError_e BspCanStop(BspCanHandle_t handle)
+BspCanError_e BspCanRegisterBusStateCallback(BspCanHandle_t handle, BspCanBusStateCallback_t pCallback)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -670,90 +2096,81 @@ BspCanError_e BspCanStop(BspCanHandle_t handle)
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    if (!pModule->bStarted)
-    {
-        return eBSP_CAN_ERR_NOT_STARTED;
-    }
-
-    /* Deactivate notifications */
-    (void)HAL_CAN_DeactivateNotification(pModule->pHalHandle, CAN_IT_RX_FIFO0_MSG_PENDING);
-
-    /* Stop CAN peripheral */
-    (void)HAL_CAN_Stop(pModule->pHalHandle);
-
-    pModule->bStarted = false;
+    pModule->pBusStateCallback = pCallback;
 
     return eBSP_CAN_ERR_NONE;
 }
 
-BspCanError_e BspCanTransmit(BspCanHandle_t handle, const BspCanMessage_t* pMessage, uint8_t byPriority, uint32_t uTxId)
+BspCanError_e BspCanGetBusState(BspCanHandle_t handle, BspCanBusState_e* pState)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
-    if (pModule == NULL)
+    if (pModule == NULL || pState == NULL)
     {
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    if (pMessage == NULL || byPriority >= BSP_CAN_PRIORITY_LEVELS)
+    uint32_t uEsr = pModule->pHalHandle->Instance->ESR;
+
+    if ((uEsr & CAN_ESR_BOFF) != 0u)
     {
-        return eBSP_CAN_ERR_INVALID_PARAM;
+        *pState = eBSP_CAN_STATE_BUS_OFF;
     }
-
-    if (!pModule->bStarted)
+    else if ((uEsr & CAN_ESR_EPVF) != 0u)
     {
-        return eBSP_CAN_ERR_NOT_STARTED;
+        *pState = eBSP_CAN_STATE_ERROR_PASSIVE;
     }
-
-    /* Allocate entry */
-    BspCanTxEntry_t* pEntry = sTxQueueAllocateEntry(&pModule->tTxQueue);
-    if (pEntry == NULL)
+    else
     {
-        return eBSP_CAN_ERR_TX_QUEUE_FULL;
+        *pState = eBSP_CAN_STATE_ERROR_ACTIVE;
     }
 
-    /* Fill entry */
-    pEntry->tMessage            = *pMessage;
-    pEntry->uTxId               = uTxId;
-    pEntry->byPriority          = byPriority;
-    pEntry->tMessage.uTimestamp = HAL_GetTick();
+    return eBSP_CAN_ERR_NONE;
+}
 
-    /* Get entry index */
-    uint8_t byEntryIdx = (uint8_t)(pEntry - pModule->tTxQueue.aEntries);
+BspCanError_e BspCanGetErrorCounters(BspCanHandle_t handle, uint8_t* pTxErrors, uint8_t* pRxErrors)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_HANDLE;
+    }
 
-    /* Enqueue with critical section */
-    __disable_irq();
-    bool bSuccess = sTxQueueEnqueue(&pModule->tTxQueue, byEntryIdx, byPriority);
-    __enable_irq();
+    uint32_t uEsr = pModule->pHalHandle->Instance->ESR;
 
-    if (!bSuccess)
+    if (pTxErrors != NULL)
     {
-        sTxQueueFreeEntry(&pModule->tTxQueue, byEntryIdx);
-        return eBSP_CAN_ERR_TX_QUEUE_FULL;
+        *pTxErrors = (uint8_t)((uEsr & CAN_ESR_TEC) >> 16u);
     }
 
-    /* Try to submit immediately */
-    sSubmitNextTx(pModule);
+    if (pRxErrors != NULL)
+    {
+        *pRxErrors = (uint8_t)((uEsr & CAN_ESR_REC) >> 24u);
+    }
 
     return eBSP_CAN_ERR_NONE;
 }
 
-BspCanError_e BspCanAbortTransmit(BspCanHandle_t handle, uint32_t uTxId)
+#if BSP_CAN_ENABLE_STATISTICS
+BspCanError_e BspCanGetStatistics(BspCanHandle_t handle, BspCanStatistics_t* pStats)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
-    if (pModule == NULL)
+    if (pModule == NULL || pStats == NULL)
     {
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    /* Critical section for queue manipulation */
-    __disable_irq();
-    bool bFound = sTxQueueRemoveByTxId(&pModule->tTxQueue, uTxId);
-    __enable_irq();
+    pStats->uTxCount      = pModule->uTxCount;
+    pStats->uRxCount      = pModule->uRxCount;
+    pStats->uErrorCount   = pModule->uErrorCount;
+    pStats->uOverrunCount = pModule->tRxBuffer.uOverrunCount;
+    pStats->uRtrReplies   = pModule->uRtrReplies;
 
-    return bFound ? eBSP_CAN_ERR_NONE : eBSP_CAN_ERR_INVALID_PARAM;
+    return eBSP_CAN_ERR_NONE;
 }
+#endif
 
-BspCanError_e BspCanGetTxQueueInfo(BspCanHandle_t handle, uint8_t* pUsed, uint8_t* pFree)
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+BspCanError_e BspCanAddRateMonitor(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, uint32_t uTimeoutMs)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -761,20 +2178,65 @@ BspCanError_e BspCanGetTxQueueInfo(BspCanHandle_t handle, uint8_t* pUsed, uint8_
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    if (pUsed != NULL)
+    if (eIdType > eBSP_CAN_ID_EXTENDED)
     {
-        *pUsed = pModule->tTxQueue.byTotalUsed;
+        return eBSP_CAN_ERR_INVALID_PARAM;
     }
 
-    if (pFree != NULL)
+    /* Lazily set up the shared timeout timer on first use */
+    if (!s_bRateTimerInitialized)
     {
-        *pFree = BSP_CAN_TX_QUEUE_DEPTH - pModule->tTxQueue.byTotalUsed;
+        s_tRateTimer.interval          = BSP_CAN_RATE_CHECK_PERIOD_MS;
+        s_tRateTimer.pCallbackFunction = &sRateCheckTimeouts;
+        s_tRateTimer.periodic          = true;
+        s_tRateTimer.active            = false;
+
+        if (!SWTimerInit(&s_tRateTimer))
+        {
+            return eBSP_CAN_ERR_NO_RESOURCE;
+        }
+        s_bRateTimerInitialized = true;
     }
 
-    return eBSP_CAN_ERR_NONE;
+    BspCanError_e eError = eBSP_CAN_ERR_NONE;
+    uint32_t      uNow   = HAL_GetTick();
+
+    __disable_irq();
+    uint8_t byIdx = sRateFind(pModule, uId, eIdType);
+    if (byIdx != 0xFFu)
+    {
+        /* Known ID: update timeout and restart the silence window */
+        pModule->aRateEntries[byIdx].uTimeoutMs = uTimeoutMs;
+        pModule->aRateEntries[byIdx].uLastTick  = uNow;
+        pModule->aRateEntries[byIdx].bTimedOut  = false;
+    }
+    else if (pModule->byRateMonitorCount >= BSP_CAN_MAX_RATE_MONITORS)
+    {
+        eError = eBSP_CAN_ERR_NO_RESOURCE;
+    }
+    else
+    {
+        BspCanRateEntry_t* pEntry = &pModule->aRateEntries[pModule->byRateMonitorCount];
+        memset(pEntry, 0, sizeof(BspCanRateEntry_t));
+        pEntry->uId        = uId;
+        pEntry->eIdType    = eIdType;
+        pEntry->uTimeoutMs = uTimeoutMs;
+        pEntry->uLastTick  = uNow;
+        pEntry->uMinGap    = UINT32_MAX;
+        pModule->byRateMonitorCount++;
+        sRateRebuildHash(pModule);
+    }
+    __enable_irq();
+
+    if ((eError == eBSP_CAN_ERR_NONE) && (uTimeoutMs != 0u) && !SWTimerIsActive(&s_tRateTimer))
+    {
+        (void)SWTimerStart(&s_tRateTimer);
+    }
+
+    return eError;
 }
 
-BspCanError_e BspCanRegisterRxCallback(BspCanHandle_t handle, BspCanRxCallback_t pCallback)
+BspCanError_e BspCanRemoveRateMonitor(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -782,12 +2244,27 @@ BspCanError_e BspCanRegisterRxCallback(BspCanHandle_t handle, BspCanRxCallback_t
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    pModule->pRxCallback = pCallback;
+    BspCanError_e eError = eBSP_CAN_ERR_NONE;
 
-    return eBSP_CAN_ERR_NONE;
+    __disable_irq();
+    uint8_t byIdx = sRateFind(pModule, uId, eIdType);
+    if (byIdx == 0xFFu)
+    {
+        eError = eBSP_CAN_ERR_INVALID_PARAM;
+    }
+    else
+    {
+        /* Keep the table dense: move the last entry into the hole */
+        pModule->byRateMonitorCount--;
+        pModule->aRateEntries[byIdx] = pModule->aRateEntries[pModule->byRateMonitorCount];
+        sRateRebuildHash(pModule);
+    }
+    __enable_irq();
+
+    return eError;
 }
 
-BspCanError_e BspCanGetRxBufferInfo(BspCanHandle_t handle, uint8_t* pUsed, uint32_t* pOverruns)
+BspCanError_e BspCanGetRateStats(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, BspCanRateStats_t* pStats)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -795,27 +2272,30 @@ BspCanError_e BspCanGetRxBufferInfo(BspCanHandle_t handle, uint8_t* pUsed, uint3
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    if (pUsed != NULL)
+    if (pStats == NULL)
     {
-        *pUsed = sRxBufferGetUsed(&pModule->tRxBuffer);
+        return eBSP_CAN_ERR_INVALID_PARAM;
     }
 
-#if BSP_CAN_ENABLE_STATISTICS
-    if (pOverruns != NULL)
+    BspCanError_e eError = eBSP_CAN_ERR_NONE;
+
+    /* Same critical section as BspCanRemoveRateMonitor(): the hash and entries may be rebuilt */
+    __disable_irq();
+    uint8_t byIdx = sRateFind(pModule, uId, eIdType);
+    if (byIdx == 0xFFu)
     {
-        *pOverruns = pModule->tRxBuffer.uOverrunCount;
+        eError = eBSP_CAN_ERR_INVALID_PARAM;
     }
-#else
-    if (pOverruns != NULL)
+    else
     {
-        *pOverruns = 0u;
+        sRateFillStats(&pModule->aRateEntries[byIdx], pStats);
     }
-#endif
+    __enable_irq();
 
-    return eBSP_CAN_ERR_NONE;
+    return eError;
 }
 
-BspCanError_e BspCanRegisterTxCallback(BspCanHandle_t handle, BspCanTxCallback_t pCallback)
+BspCanError_e BspCanGetRateStatsByIndex(BspCanHandle_t handle, uint8_t byIndex, BspCanRateStats_t* pStats)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -823,25 +2303,28 @@ BspCanError_e BspCanRegisterTxCallback(BspCanHandle_t handle, BspCanTxCallback_t
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    pModule->pTxCallback = pCallback;
+    if (pStats == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
 
-    return eBSP_CAN_ERR_NONE;
-}
+    BspCanError_e eError = eBSP_CAN_ERR_NONE;
 
-BspCanError_e BspCanRegisterErrorCallback(BspCanHandle_t handle, BspCanErrorCallback_t pCallback)
-{
-    BspCanModule_t* pModule = sValidateHandle(handle);
-    if (pModule == NULL)
+    __disable_irq();
+    if (byIndex >= pModule->byRateMonitorCount)
     {
-        return eBSP_CAN_ERR_INVALID_HANDLE;
+        eError = eBSP_CAN_ERR_INVALID_PARAM;
     }
+    else
+    {
+        sRateFillStats(&pModule->aRateEntries[byIndex], pStats);
+    }
+    __enable_irq();
 
-    pModule->pErrorCallback = pCallback;
-
-    return eBSP_CAN_ERR_NONE;
+    return eError;
 }
 
-BspCanError_e BspCanRegisterBusStateCallback(BspCanHandle_t handle, BspCanBusStateCallback_t pCallback)
+BspCanError_e BspCanRegisterRateTimeoutCallback(BspCanHandle_t handle, BspCanRateTimeoutCallback_t pCallback)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -849,38 +2332,66 @@ BspCanError_e BspCanRegisterBusStateCallback(BspCanHandle_t handle, BspCanBusSta
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    pModule->pBusStateCallback = pCallback;
+    pModule->pRateTimeoutCallback = pCallback;
 
     return eBSP_CAN_ERR_NONE;
 }
+#endif
 
-BspCanError_e BspCanGetBusState(BspCanHandle_t handle, BspCanBusState_e* pState)
+#if BSP_CAN_ENABLE_MONITOR
+BspCanError_e BspCanStartMonitor(BspCanHandle_t handle, BspCanMonitorRecord_t* pRing, uint32_t uRingDepth)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
-    if (pModule == NULL || pState == NULL)
+    if (pModule == NULL)
     {
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    uint32_t uEsr = pModule->pHalHandle->Instance->ESR;
+    if ((pRing == NULL) || (uRingDepth == 0u) || ((uRingDepth & (uRingDepth - 1u)) != 0u))
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
 
-    if ((uEsr & CAN_ESR_BOFF) != 0u)
+    if (pModule->bStarted)
     {
-        *pState = eBSP_CAN_STATE_BUS_OFF;
+        return eBSP_CAN_ERR_ALREADY_STARTED;
     }
-    else if ((uEsr & CAN_ESR_EPVF) != 0u)
+
+    CAN_HandleTypeDef* pHal = pModule->pHalHandle;
+
+    pModule->pMonRing         = pRing;
+    pModule->uMonMask         = uRingDepth - 1u;
+    pModule->uMonWrite        = 0u;
+    pModule->uMonRead         = 0u;
+    pModule->uMonWindowStart  = HAL_GetTick();
+    pModule->uMonWindowFrames = 0u;
+    memset(&pModule->tMonStats, 0, sizeof(pModule->tMonStats));
+
+    /* HAL keeps the controller in initialization mode until HAL_CAN_Start(), so BTR is writable here */
+    pModule->uMonSavedBtr = pHal->Instance->BTR;
+    pHal->Instance->BTR   = pModule->uMonSavedBtr | CAN_BTR_SILM;
+
+    if ((sAcceptAllConfigFilter(pHal, 0u, 0x0000u, CAN_FILTER_FIFO0) != HAL_OK) ||
+        (sAcceptAllConfigFilter(pHal, 1u, 0x0020u, CAN_FILTER_FIFO1) != HAL_OK) || (HAL_CAN_Start(pHal) != HAL_OK))
     {
-        *pState = eBSP_CAN_STATE_ERROR_PASSIVE;
+        pHal->Instance->BTR = pModule->uMonSavedBtr;
+        return eBSP_CAN_ERR_HAL_ERROR;
     }
-    else
+
+    if (HAL_CAN_ActivateNotification(pHal, CAN_IT_MONITOR) != HAL_OK)
     {
-        *pState = eBSP_CAN_STATE_ERROR_ACTIVE;
+        HAL_CAN_Stop(pHal);
+        pHal->Instance->BTR = pModule->uMonSavedBtr;
+        return eBSP_CAN_ERR_HAL_ERROR;
     }
 
+    pModule->bMonitor = true;
+    pModule->bStarted = true;
+
     return eBSP_CAN_ERR_NONE;
 }
 
-BspCanError_e BspCanGetErrorCounters(BspCanHandle_t handle, uint8_t* pTxErrors, uint8_t* pRxErrors)
+BspCanError_e BspCanMonitorGetBlock(BspCanHandle_t handle, const BspCanMonitorRecord_t** ppBlock, uint32_t* pCount)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
     if (pModule == NULL)
@@ -888,34 +2399,61 @@ BspCanError_e BspCanGetErrorCounters(BspCanHandle_t handle, uint8_t* pTxErrors,
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    uint32_t uEsr = pModule->pHalHandle->Instance->ESR;
+    if ((ppBlock == NULL) || (pCount == NULL) || (pModule->pMonRing == NULL))
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
 
-    if (pTxErrors != NULL)
+    uint32_t uRead      = pModule->uMonRead;
+    uint32_t uAvailable = pModule->uMonWrite - uRead;
+    uint32_t uIndex     = uRead & pModule->uMonMask;
+    uint32_t uToEnd     = (pModule->uMonMask + 1u) - uIndex;
+
+    *pCount  = (uAvailable < uToEnd) ? uAvailable : uToEnd;
+    *ppBlock = (*pCount > 0u) ? &pModule->pMonRing[uIndex] : NULL;
+
+    return eBSP_CAN_ERR_NONE;
+}
+
+BspCanError_e BspCanMonitorReleaseBlock(BspCanHandle_t handle, uint32_t uCount)
+{
+    BspCanModule_t* pModule = sValidateHandle(handle);
+    if (pModule == NULL)
     {
-        *pTxErrors = (uint8_t)((uEsr & CAN_ESR_TEC) >> 16u);
+        return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    if (pRxErrors != NULL)
+    if ((pModule->pMonRing == NULL) || (uCount > (pModule->uMonWrite - pModule->uMonRead)))
     {
-        *pRxErrors = (uint8_t)((uEsr & CAN_ESR_REC) >> 24u);
+        return eBSP_CAN_ERR_INVALID_PARAM;
     }
 
+    /* Single writer of the read index: no critical section needed */
+    pModule->uMonRead += uCount;
+
     return eBSP_CAN_ERR_NONE;
 }
 
-#if BSP_CAN_ENABLE_STATISTICS
-BspCanError_e BspCanGetStatistics(BspCanHandle_t handle, BspCanStatistics_t* pStats)
+BspCanError_e BspCanGetMonitorStats(BspCanHandle_t handle, BspCanMonitorStats_t* pStats)
 {
     BspCanModule_t* pModule = sValidateHandle(handle);
-    if (pModule == NULL || pStats == NULL)
+    if (pModule == NULL)
     {
         return eBSP_CAN_ERR_INVALID_HANDLE;
     }
 
-    pStats->uTxCount      = pModule->uTxCount;
-    pStats->uRxCount      = pModule->uRxCount;
-    pStats->uErrorCount   = pModule->uErrorCount;
-    pStats->uOverrunCount = pModule->tRxBuffer.uOverrunCount;
+    if (pStats == NULL)
+    {
+        return eBSP_CAN_ERR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    if (pModule->bMonitor)
+    {
+        sMonitorRollWindow(pModule, HAL_GetTick());
+    }
+    *pStats = pModule->tMonStats;
+    __enable_irq();
 
     return eBSP_CAN_ERR_NONE;
 }
@@ -938,6 +2476,16 @@ void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan)
 
     BspCanModule_t* pModule = &s_aModules[handle];
 
+#if BSP_CAN_ENABLE_MONITOR
+    if (pModule->bMonitor)
+    {
+        __disable_irq();
+        sMonitorCapture(pModule, hcan, CAN_RX_FIFO0);
+        __enable_irq();
+        return;
+    }
+#endif
+
     /* Read message from hardware FIFO */
     CAN_RxHeaderTypeDef tRxHeader  = {0};
     uint8_t             aRxData[8] = {0};
@@ -954,7 +2502,25 @@ void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan)
     }
 
 #if BSP_CAN_ENABLE_STATISTICS
+    /* The other FIFO interrupt may preempt this one */
+    __disable_irq();
     pModule->uRxCount++;
+    __enable_irq();
+#endif
+
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+    if (pModule->byRateMonitorCount > 0u)
+    {
+        sRateUpdate(handle, pModule, &tRxHeader);
+    }
+#endif
+
+#if BSP_CAN_MAX_RTR_RESPONDERS > 0
+    /* Answer remote frames directly from the responder table */
+    if ((tRxHeader.RTR == CAN_RTR_REMOTE) && (pModule->byRtrResponderCount > 0u))
+    {
+        sRtrHandleRemoteFrame(pModule, &tRxHeader);
+    }
 #endif
 
     /* Invoke callback directly from ISR */
@@ -980,6 +2546,16 @@ void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef* hcan)
 
     BspCanModule_t* pModule = &s_aModules[handle];
 
+#if BSP_CAN_ENABLE_MONITOR
+    if (pModule->bMonitor)
+    {
+        __disable_irq();
+        sMonitorCapture(pModule, hcan, CAN_RX_FIFO1);
+        __enable_irq();
+        return;
+    }
+#endif
+
     CAN_RxHeaderTypeDef tRxHeader  = {0};
     uint8_t             aRxData[8] = {0};
 
@@ -994,7 +2570,25 @@ void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef* hcan)
     }
 
 #if BSP_CAN_ENABLE_STATISTICS
+    /* The other FIFO interrupt may preempt this one */
+    __disable_irq();
     pModule->uRxCount++;
+    __enable_irq();
+#endif
+
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+    if (pModule->byRateMonitorCount > 0u)
+    {
+        sRateUpdate(handle, pModule, &tRxHeader);
+    }
+#endif
+
+#if BSP_CAN_MAX_RTR_RESPONDERS > 0
+    /* Answer remote frames directly from the responder table */
+    if ((tRxHeader.RTR == CAN_RTR_REMOTE) && (pModule->byRtrResponderCount > 0u))
+    {
+        sRtrHandleRemoteFrame(pModule, &tRxHeader);
+    }
 #endif
 
     if (pModule->pRxCallback != NULL)
@@ -1031,8 +2625,10 @@ void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef* hcan)
         pModule->pTxCallback(handle, uTxId);
     }
 
-    /* Submit next queued message */
+    /* Submit next queued message; RX ISRs also submit */
+    __disable_irq();
     sSubmitNextTx(pModule);
+    __enable_irq();
 }
 
 /**
@@ -1060,7 +2656,9 @@ void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef* hcan)
         pModule->pTxCallback(handle, uTxId);
     }
 
+    __disable_irq();
     sSubmitNextTx(pModule);
+    __enable_irq();
 }
 
 /**
@@ -1088,7 +2686,9 @@ void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef* hcan)
         pModule->pTxCallback(handle, uTxId);
     }
 
+    __disable_irq();
     sSubmitNextTx(pModule);
+    __enable_irq();
 }
 
 /**
@@ -1108,7 +2708,16 @@ void HAL_CAN_ErrorCallback(CAN_HandleTypeDef* hcan)
     pModule->uErrorCount++;
 #endif
 
+    /* HAL ORs every new error into the handle: clear it so each callback only sees its own errors */
     uint32_t uErrorCode = HAL_CAN_GetError(hcan);
+    (void)HAL_CAN_ResetError(hcan);
+
+#if BSP_CAN_ENABLE_MONITOR
+    if (pModule->bMonitor && ((uErrorCode & (HAL_CAN_ERROR_RX_FOV0 | HAL_CAN_ERROR_RX_FOV1)) != 0u))
+    {
+        pModule->tMonStats.uHwOverruns++;
+    }
+#endif
 
     /* Determine error type */
     BspCanError_e eError = eBSP_CAN_ERR_HAL_ERROR;
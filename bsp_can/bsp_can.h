@@ -75,6 +75,25 @@ typedef enum
     eBSP_CAN_ID_EXTENDED = 1u  /**< 29-bit extended ID */
 } BspCanIdType_e;
 
+/**
+ * @brief TX queue scheduling discipline.
+ */
+typedef enum
+{
+    eBSP_CAN_TX_ORDER_PRIORITY = 0u, /**< byPriority first, then FIFO (default) */
+    eBSP_CAN_TX_ORDER_CAN_ID   = 1u  /**< Bus arbitration order (lowest ID first), FIFO for equal IDs */
+} BspCanTxOrder_e;
+
+/**
+ * @brief Order in which the three hardware mailboxes are sent.
+ */
+typedef enum
+{
+    eBSP_CAN_MBX_ORDER_ID           = 0u, /**< Hardware identifier priority, MCR.TXFP left as initialized (default) */
+    eBSP_CAN_MBX_ORDER_FIFO         = 1u, /**< Hardware FIFO priority (TXFP): strict submission order */
+    eBSP_CAN_MBX_ORDER_SAME_ID_FIFO = 2u  /**< Identifier priority, but same-ID frames never overtake each other */
+} BspCanMailboxOrder_e;
+
 /**
  * @brief CAN error codes.
  */
@@ -91,7 +110,8 @@ typedef enum
     eBSP_CAN_ERR_HAL_ERROR,       /**< STM32 HAL error occurred */
     eBSP_CAN_ERR_BUS_OFF,         /**< CAN bus in bus-off state */
     eBSP_CAN_ERR_BUS_PASSIVE,     /**< CAN bus in error passive state */
-    eBSP_CAN_ERR_RX_OVERRUN       /**< RX buffer overrun occurred */
+    eBSP_CAN_ERR_RX_OVERRUN,      /**< RX buffer overrun occurred */
+    eBSP_CAN_ERR_TIMEOUT          /**< No valid bus traffic detected in time */
 } BspCanError_e;
 
 /**
@@ -117,18 +137,27 @@ typedef struct
     uint32_t          uTimestamp; /**< Message timestamp (HAL_GetTick) */
 } BspCanMessage_t;
 
+/** Filter FIFO assignment: let BspCanStart() balance the filter across FIFO0/FIFO1 */
+#define BSP_CAN_FIFO_AUTO (0xFFu)
+
 /**
  * @brief CAN filter configuration.
  *
  * Uses ID/mask mode for flexible filtering. Set mask bits to 1 for
  * ID bits that must match, 0 for don't care.
+ *
+ * With byFifoAssignment = BSP_CAN_FIFO_AUTO the FIFO is chosen in
+ * BspCanStart() from wExpectedRate, or from the rate monitors the filter
+ * accepts when wExpectedRate is 0 (calibration run).
  */
 typedef struct
 {
     uint32_t       uFilterId;        /**< Filter ID value */
     uint32_t       uFilterMask;      /**< Filter mask (1=must match, 0=don't care) */
     BspCanIdType_e eIdType;          /**< Standard or extended ID filter */
-    uint8_t        byFifoAssignment; /**< 0=FIFO0, 1=FIFO1 */
+    uint8_t        byFifoAssignment; /**< 0=FIFO0, 1=FIFO1, BSP_CAN_FIFO_AUTO=balanced */
+    uint16_t       wExpectedRate;    /**< Expected frames/s for balancing (0 = measured) */
+    bool           bCritical;        /**< AUTO only: pin to FIFO0 (BSP_CAN_RX0_IRQ_PRIORITY) */
 } BspCanFilter_t;
 
 /**
@@ -136,12 +165,29 @@ typedef struct
  */
 typedef struct
 {
-    BspCanInstance_e eInstance;       /**< CAN peripheral instance */
-    bool             bLoopback;       /**< Enable loopback mode (testing) */
-    bool             bSilent;         /**< Enable silent mode (monitoring) */
-    bool             bAutoRetransmit; /**< Auto-retransmit on error */
+    BspCanInstance_e     eInstance;       /**< CAN peripheral instance */
+    bool                 bLoopback;       /**< Enable loopback mode (testing) */
+    bool                 bSilent;         /**< Enable silent mode (monitoring) */
+    bool                 bAutoRetransmit; /**< Auto-retransmit on error */
+    BspCanTxOrder_e      eTxOrder;        /**< TX queue discipline (default: priority) */
+    BspCanMailboxOrder_e eMailboxOrder;   /**< Mailbox send order (default: identifier priority) */
 } BspCanConfig_t;
 
+/**
+ * @brief CAN bit timing parameters (values as programmed, not register encodings).
+ *
+ * One bit is (1 + byBs1 + byBs2) time quanta of wPrescaler clock cycles each;
+ * the sample point sits at the end of BS1.
+ */
+typedef struct
+{
+    uint16_t wPrescaler;   /**< Baud rate prescaler (1-1024) */
+    uint8_t  byBs1;        /**< Time segment 1 in quanta (1-16) */
+    uint8_t  byBs2;        /**< Time segment 2 in quanta (1-8) */
+    uint8_t  bySjw;        /**< Resynchronization jump width in quanta (1-4) */
+    uint16_t wSamplePoint; /**< Achieved sample point in permille */
+} BspCanBitTiming_t;
+
 #if BSP_CAN_ENABLE_STATISTICS
 /**
  * @brief CAN statistics structure.
@@ -152,9 +198,63 @@ typedef struct
     uint32_t uRxCount;      /**< Total messages received */
     uint32_t uErrorCount;   /**< Total error events */
     uint32_t uOverrunCount; /**< RX buffer overruns */
+    uint32_t uRtrReplies;   /**< Remote frames answered by the RTR responder table */
 } BspCanStatistics_t;
 #endif
 
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+/**
+ * @brief Per-ID RX rate monitor snapshot.
+ */
+typedef struct
+{
+    uint32_t       uId;         /**< Monitored CAN identifier */
+    BspCanIdType_e eIdType;     /**< Standard or extended ID */
+    uint32_t       uTimeoutMs;  /**< Configured timeout (0 = statistics only) */
+    uint32_t       uCount;      /**< Frames received */
+    uint32_t       uLastRxTick; /**< HAL_GetTick of the last frame (registration time if none) */
+    uint32_t       uPeriodUs;   /**< EWMA inter-arrival period (alpha 1/8) */
+    uint32_t       uJitterUs;   /**< EWMA of the absolute period deviation (alpha 1/16) */
+    uint32_t       uMinGapMs;   /**< Shortest inter-arrival gap (0 until two frames seen) */
+    uint32_t       uMaxGapMs;   /**< Longest inter-arrival gap */
+    uint32_t       uTimeouts;   /**< Timeout events */
+    bool           bTimedOut;   /**< Currently timed out */
+} BspCanRateStats_t;
+#endif
+
+#if BSP_CAN_ENABLE_MONITOR
+/** Monitor record flag: frame has a 29-bit extended ID */
+#define BSP_CAN_MON_FLAG_EXT (0x01u)
+/** Monitor record flag: frame is a remote frame (RTR) */
+#define BSP_CAN_MON_FLAG_RTR (0x02u)
+/** Monitor record flag: frame was received through FIFO1 */
+#define BSP_CAN_MON_FLAG_FIFO1 (0x04u)
+
+/**
+ * @brief Compact bus-monitor capture record (20 bytes).
+ */
+typedef struct
+{
+    uint32_t uTimestamp; /**< Capture time (HAL_GetTick) */
+    uint32_t uId;        /**< CAN identifier (11 or 29 bit) */
+    uint8_t  byDlc;      /**< Data length code (0-8) */
+    uint8_t  byFlags;    /**< BSP_CAN_MON_FLAG_* bits */
+    uint8_t  aData[8];   /**< Payload data */
+} BspCanMonitorRecord_t;
+
+/**
+ * @brief Bus-monitor capture statistics.
+ */
+typedef struct
+{
+    uint32_t uCaptured;        /**< Frames written to the capture ring */
+    uint32_t uDropped;         /**< Frames discarded because the ring was full */
+    uint32_t uHwOverruns;      /**< Hardware FIFO overruns (frames lost before the ISR) */
+    uint32_t uFramesPerSecond; /**< Bus frame rate over the last complete 1 s window */
+    uint32_t uHighWater;       /**< Maximum ring occupancy observed */
+} BspCanMonitorStats_t;
+#endif
+
 /* ============================================================================
  * Callback Type Definitions
  * ========================================================================== */
@@ -209,6 +309,24 @@ typedef void (*BspCanErrorCallback_t)(BspCanHandle_t handle, BspCanError_e eErro
  */
 typedef void (*BspCanBusStateCallback_t)(BspCanHandle_t handle, BspCanBusState_e eState);
 
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+/**
+ * @brief Rate monitor timeout callback.
+ *
+ * Called once when a monitored ID has been silent for its timeout
+ * (bTimedOut = true) and once when it is received again (bTimedOut = false).
+ *
+ * @warning Timeouts are reported from the SysTick software timer, recoveries
+ *          from the RX ISR. Keep execution time <5µs.
+ *
+ * @param handle     CAN module handle
+ * @param uId        CAN identifier
+ * @param eIdType    Standard or extended ID
+ * @param bTimedOut  true on timeout, false on recovery
+ */
+typedef void (*BspCanRateTimeoutCallback_t)(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, bool bTimedOut);
+#endif
+
 /* ============================================================================
  * Initialization and Configuration API
  * ========================================================================== */
@@ -261,11 +379,29 @@ BspCanError_e BspCanAddFilter(BspCanHandle_t handle, const BspCanFilter_t* pFilt
  * Activates all configured filters, enables CAN peripheral and interrupts,
  * and begins operation.
  *
+ * If any filter uses BSP_CAN_FIFO_AUTO, the filters are first balanced across
+ * both RX FIFOs (heaviest first, each to the less loaded FIFO; critical
+ * filters to FIFO0) and the FIFO interrupts get BSP_CAN_RX0_IRQ_PRIORITY and
+ * BSP_CAN_RX1_IRQ_PRIORITY. The RX paths update their shared state with
+ * interrupts disabled, so FIFO0 may preempt FIFO1.
+ *
  * @param handle     CAN module handle
  * @return           Error code
  */
 BspCanError_e BspCanStart(BspCanHandle_t handle);
 
+/**
+ * @brief Get the FIFO a filter was assigned to by the last BspCanStart().
+ *
+ * Resolves BSP_CAN_FIFO_AUTO filters to the FIFO chosen by load balancing.
+ *
+ * @param handle        CAN module handle
+ * @param byFilterIndex Filter index (order of BspCanAddFilter() calls)
+ * @param pbyFifo       Output: 0=FIFO0, 1=FIFO1
+ * @return              Error code
+ */
+BspCanError_e BspCanGetFilterFifo(BspCanHandle_t handle, uint8_t byFilterIndex, uint8_t* pbyFifo);
+
 /**
  * @brief Stop CAN communication.
  *
@@ -276,6 +412,60 @@ BspCanError_e BspCanStart(BspCanHandle_t handle);
  */
 BspCanError_e BspCanStop(BspCanHandle_t handle);
 
+/* ============================================================================
+ * Bit Timing API
+ * ========================================================================== */
+
+/**
+ * @brief Calculate bit timing for a target bitrate and sample point.
+ *
+ * Searches 8 to 25 quanta per bit for an exact prescaler and picks the
+ * solution whose sample point is closest to the target (more quanta on ties).
+ *
+ * @param uClockHz      CAN kernel clock (APB1) in Hz
+ * @param uBitrate      Target bitrate in bit/s
+ * @param wSamplePoint  Target sample point in permille (0 = BSP_CAN_DEFAULT_SAMPLE_POINT)
+ * @param pTiming       Pointer to store the result
+ * @return              Error code (eBSP_CAN_ERR_INVALID_PARAM if the bitrate cannot be reached exactly)
+ */
+BspCanError_e BspCanCalcBitTiming(uint32_t uClockHz, uint32_t uBitrate, uint16_t wSamplePoint, BspCanBitTiming_t* pTiming);
+
+/**
+ * @brief Reprogram the bitrate of a stopped CAN instance.
+ *
+ * Derives the bit timing from the current APB1 clock and writes it to the
+ * BTR register, keeping the silent and loopback bits. The CubeMX init values
+ * are overridden until the next HAL_CAN_Init().
+ *
+ * @param handle        CAN module handle
+ * @param uBitrate      Bitrate in bit/s (e.g. 125000, 250000, 500000, 1000000)
+ * @param wSamplePoint  Sample point in permille (0 = BSP_CAN_DEFAULT_SAMPLE_POINT)
+ * @return              Error code (eBSP_CAN_ERR_ALREADY_STARTED if running)
+ */
+BspCanError_e BspCanSetBitrate(BspCanHandle_t handle, uint32_t uBitrate, uint16_t wSamplePoint);
+
+/**
+ * @brief Detect the bus bitrate by listening in silent mode.
+ *
+ * Tries each candidate in order: the controller is started in silent mode
+ * with two accept-all filter banks and watched for up to uListenMs. A frame
+ * received without error into an RX FIFO selects the candidate; a protocol
+ * error (LEC) or silence moves on to the next one. The captured frames are
+ * discarded and the filter banks deactivated again. On success the instance
+ * is left stopped and programmed with the detected bitrate.
+ *
+ * @param handle      CAN module handle
+ * @param pBitrates   Candidate bitrates in bit/s (fastest first is recommended)
+ * @param byCount     Number of candidates
+ * @param uListenMs   Listen window per candidate in ms
+ * @param pDetected   Pointer to store the detected bitrate
+ * @return            Error code (eBSP_CAN_ERR_TIMEOUT if no candidate matched)
+ *
+ * @warning Blocking: takes up to byCount × uListenMs. Never transmits, so it
+ *          is safe on a live bus.
+ */
+BspCanError_e BspCanAutoBaud(BspCanHandle_t handle, const uint32_t* pBitrates, uint8_t byCount, uint32_t uListenMs, uint32_t* pDetected);
+
 /* ============================================================================
  * Transmit API
  * ========================================================================== */
@@ -283,11 +473,16 @@ BspCanError_e BspCanStop(BspCanHandle_t handle);
 /**
  * @brief Transmit CAN message with priority.
  *
- * Queues message for transmission. Messages are sent in priority order:
+ * Queues message for transmission. With eBSP_CAN_TX_ORDER_PRIORITY (default)
+ * messages are sent in priority order:
  * - Primary: byPriority parameter (0 = highest priority in queue)
  * - Secondary: FIFO order within same priority level
  * - Final: CAN bus arbitration by CAN ID (lower ID wins)
  *
+ * With eBSP_CAN_TX_ORDER_CAN_ID the queue is a bounded min-heap keyed on the
+ * arbitration field, so the frame that would win arbitration is always
+ * submitted first (O(log n)). byPriority is validated but not used for ordering.
+ *
  * @param handle     CAN module handle
  * @param pMessage   Pointer to message to transmit
  * @param byPriority Priority level (0 to BSP_CAN_PRIORITY_LEVELS-1, 0=highest)
@@ -350,6 +545,185 @@ BspCanError_e BspCanRegisterRxCallback(BspCanHandle_t handle, BspCanRxCallback_t
  */
 BspCanError_e BspCanGetRxBufferInfo(BspCanHandle_t handle, uint8_t* pUsed, uint32_t* pOverruns);
 
+#if BSP_CAN_MAX_RTR_RESPONDERS > 0
+/* ============================================================================
+ * Remote Frame Responder API
+ * ========================================================================== */
+
+/**
+ * @brief Register an automatic remote-frame (RTR) responder.
+ *
+ * When a remote frame with matching ID and ID type is received, the RX ISR
+ * enqueues a data frame carrying the responder's current payload directly
+ * into the TX queue, without a round trip through the RX callback.
+ * Registering an already known ID updates its priority and TX ID.
+ *
+ * @param handle     CAN module handle
+ * @param uId        CAN identifier to answer
+ * @param eIdType    Standard or extended ID
+ * @param byPriority TX queue priority of the reply (0 to BSP_CAN_PRIORITY_LEVELS-1)
+ * @param uTxId      User TX ID reported in the TX completion callback for replies
+ * @return           Error code
+ *
+ * @note No reply is sent until a payload has been published with BspCanUpdateRtrPayload().
+ * @note Matched remote frames are still delivered to the RX callback.
+ * @note Returns eBSP_CAN_ERR_NO_RESOURCE if BSP_CAN_MAX_RTR_RESPONDERS is exceeded.
+ */
+BspCanError_e BspCanRegisterRtrResponder(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, uint8_t byPriority, uint32_t uTxId);
+
+/**
+ * @brief Publish a new payload for an RTR responder.
+ *
+ * The payload is double-buffered: data is copied into the inactive buffer
+ * and then made current with a single index swap, so the RX ISR always
+ * replies with a complete, consistent payload. The copy and swap run with
+ * interrupts disabled (at most 8 bytes), so it may be called from thread or
+ * interrupt context.
+ *
+ * @param handle     CAN module handle
+ * @param uId        CAN identifier of a registered responder
+ * @param eIdType    Standard or extended ID
+ * @param pData      Pointer to payload (may be NULL if byDataLen is 0)
+ * @param byDataLen  Payload length (0-8 bytes)
+ * @return           Error code (eBSP_CAN_ERR_INVALID_PARAM if responder not found)
+ */
+BspCanError_e BspCanUpdateRtrPayload(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, const uint8_t* pData, uint8_t byDataLen);
+
+/**
+ * @brief Remove an RTR responder.
+ *
+ * @param handle     CAN module handle
+ * @param uId        CAN identifier of a registered responder
+ * @param eIdType    Standard or extended ID
+ * @return           Error code (eBSP_CAN_ERR_INVALID_PARAM if responder not found)
+ */
+BspCanError_e BspCanRemoveRtrResponder(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType);
+#endif
+
+#if BSP_CAN_MAX_RATE_MONITORS > 0
+/* ============================================================================
+ * RX Rate Monitor API
+ * ========================================================================== */
+
+/**
+ * @brief Monitor the arrival rate of a CAN ID.
+ *
+ * The RX ISR updates the entry in O(1) through a hash index: last arrival,
+ * EWMA period and jitter, and min/max gap. If uTimeoutMs is non-zero, one
+ * shared software timer (BSP_CAN_RATE_CHECK_PERIOD_MS) reports IDs that
+ * stay silent for uTimeoutMs, counted from registration for IDs never seen.
+ * Adding a known ID updates its timeout and restarts its silence window.
+ *
+ * @param handle      CAN module handle
+ * @param uId         CAN identifier to monitor
+ * @param eIdType     Standard or extended ID
+ * @param uTimeoutMs  Silence that triggers the timeout callback (0 = statistics only)
+ * @return            Error code (eBSP_CAN_ERR_NO_RESOURCE if BSP_CAN_MAX_RATE_MONITORS is exceeded)
+ *
+ * @note A typical heartbeat timeout is 3× its nominal period.
+ */
+BspCanError_e BspCanAddRateMonitor(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, uint32_t uTimeoutMs);
+
+/**
+ * @brief Stop monitoring a CAN ID.
+ *
+ * @param handle     CAN module handle
+ * @param uId        Monitored CAN identifier
+ * @param eIdType    Standard or extended ID
+ * @return           Error code (eBSP_CAN_ERR_INVALID_PARAM if not monitored)
+ */
+BspCanError_e BspCanRemoveRateMonitor(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType);
+
+/**
+ * @brief Get rate statistics for a monitored CAN ID.
+ *
+ * @param handle     CAN module handle
+ * @param uId        Monitored CAN identifier
+ * @param eIdType    Standard or extended ID
+ * @param pStats     Pointer to store the snapshot
+ * @return           Error code (eBSP_CAN_ERR_INVALID_PARAM if not monitored)
+ */
+BspCanError_e BspCanGetRateStats(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, BspCanRateStats_t* pStats);
+
+/**
+ * @brief Get rate statistics by table index (bus overview).
+ *
+ * Iterate byIndex from 0 until eBSP_CAN_ERR_INVALID_PARAM is returned.
+ *
+ * @param handle     CAN module handle
+ * @param byIndex    Table index
+ * @param pStats     Pointer to store the snapshot
+ * @return           Error code
+ */
+BspCanError_e BspCanGetRateStatsByIndex(BspCanHandle_t handle, uint8_t byIndex, BspCanRateStats_t* pStats);
+
+/**
+ * @brief Register rate monitor timeout callback.
+ *
+ * @param handle     CAN module handle
+ * @param pCallback  Callback function (NULL to unregister)
+ * @return           Error code
+ */
+BspCanError_e BspCanRegisterRateTimeoutCallback(BspCanHandle_t handle, BspCanRateTimeoutCallback_t pCallback);
+#endif
+
+#if BSP_CAN_ENABLE_MONITOR
+/* ============================================================================
+ * Bus Monitor API
+ * ========================================================================== */
+
+/**
+ * @brief Start silent bus-monitor capture (used instead of BspCanStart()).
+ *
+ * Puts the controller in silent mode, programs two accept-all filter banks
+ * that split traffic between FIFO0 and FIFO1 on the base-ID LSB, and starts
+ * the peripheral. Each received frame is written by the RX ISR straight into
+ * the caller's ring as a compact record; the RX callback, RTR responders and
+ * the RX LED are bypassed. Filters added with BspCanAddFilter() are ignored.
+ *
+ * @param handle      CAN module handle
+ * @param pRing       Caller-owned capture ring (must stay valid until drained)
+ * @param uRingDepth  Number of records in pRing (power of 2)
+ * @return            Error code
+ *
+ * @note Call BspCanStop() to end capture; the silent bit is restored and
+ *       records left in the ring can still be drained.
+ */
+BspCanError_e BspCanStartMonitor(BspCanHandle_t handle, BspCanMonitorRecord_t* pRing, uint32_t uRingDepth);
+
+/**
+ * @brief Get the oldest contiguous block of captured records (zero-copy).
+ *
+ * Returns a pointer into the capture ring and the number of records that can
+ * be read from it without wrapping. Call BspCanMonitorReleaseBlock() once the
+ * records have been consumed. Two calls drain a wrapped ring completely.
+ *
+ * @param handle   CAN module handle
+ * @param ppBlock  Pointer to store the block start (NULL if *pCount is 0)
+ * @param pCount   Pointer to store the number of records in the block
+ * @return         Error code
+ */
+BspCanError_e BspCanMonitorGetBlock(BspCanHandle_t handle, const BspCanMonitorRecord_t** ppBlock, uint32_t* pCount);
+
+/**
+ * @brief Return consumed records to the capture ring.
+ *
+ * @param handle   CAN module handle
+ * @param uCount   Number of records consumed (at most the available count)
+ * @return         Error code (eBSP_CAN_ERR_INVALID_PARAM if uCount exceeds the available count)
+ */
+BspCanError_e BspCanMonitorReleaseBlock(BspCanHandle_t handle, uint32_t uCount);
+
+/**
+ * @brief Get bus-monitor capture statistics.
+ *
+ * @param handle   CAN module handle
+ * @param pStats   Pointer to store statistics
+ * @return         Error code
+ */
+BspCanError_e BspCanGetMonitorStats(BspCanHandle_t handle, BspCanMonitorStats_t* pStats);
+#endif
+
 /* ============================================================================
  * Callback Registration and Error Handling API
  * ========================================================================== */
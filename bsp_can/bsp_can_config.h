@@ -60,6 +60,27 @@ extern "C"
     #define BSP_CAN_MAX_FILTERS (14u)
 #endif
 
+/**
+ * @brief Default sample point used by BspCanSetBitrate() and BspCanAutoBaud(), in permille.
+ * 875 (87.5%) is the CiA 301 recommendation for bitrates up to 800 kbit/s.
+ */
+#ifndef BSP_CAN_DEFAULT_SAMPLE_POINT
+    #define BSP_CAN_DEFAULT_SAMPLE_POINT (875u)
+#endif
+
+/**
+ * @brief NVIC preemption priorities of the RX FIFO0/FIFO1 interrupts.
+ * Applied by BspCanStart() only when a filter uses BSP_CAN_FIFO_AUTO.
+ * FIFO0 carries the critical IDs, so it must be more urgent (numerically lower).
+ */
+#ifndef BSP_CAN_RX0_IRQ_PRIORITY
+    #define BSP_CAN_RX0_IRQ_PRIORITY (5u)
+#endif
+
+#ifndef BSP_CAN_RX1_IRQ_PRIORITY
+    #define BSP_CAN_RX1_IRQ_PRIORITY (6u)
+#endif
+
 /* --- Feature Configuration --- */
 
 /**
@@ -72,6 +93,42 @@ extern "C"
     #define BSP_CAN_ENABLE_STATISTICS (1u)
 #endif
 
+/**
+ * @brief Maximum number of automatic remote-frame (RTR) responders per instance.
+ * Set to 0 to compile the responder table out entirely.
+ * Each entry holds a double-buffered 8-byte payload (~28 bytes).
+ * Memory impact: BSP_CAN_MAX_RTR_RESPONDERS × 28 bytes per instance.
+ */
+#ifndef BSP_CAN_MAX_RTR_RESPONDERS
+    #define BSP_CAN_MAX_RTR_RESPONDERS (8u)
+#endif
+
+/**
+ * @brief Maximum number of per-ID RX rate/timeout monitors per instance.
+ * Set to 0 to compile the rate monitor out entirely.
+ * Each entry is ~44 bytes plus a 64-byte hash index per instance.
+ */
+#ifndef BSP_CAN_MAX_RATE_MONITORS
+    #define BSP_CAN_MAX_RATE_MONITORS (8u)
+#endif
+
+/**
+ * @brief Period of the shared software timer that checks rate monitor timeouts (ms).
+ * Timeouts are detected with up to this much delay.
+ */
+#ifndef BSP_CAN_RATE_CHECK_PERIOD_MS
+    #define BSP_CAN_RATE_CHECK_PERIOD_MS (10u)
+#endif
+
+/**
+ * @brief Enable silent bus-monitor capture (BspCanStartMonitor() API).
+ * Set to 1 to enable, 0 to disable.
+ * The capture ring is supplied by the caller; the module itself adds ~40 bytes per instance.
+ */
+#ifndef BSP_CAN_ENABLE_MONITOR
+    #define BSP_CAN_ENABLE_MONITOR (1u)
+#endif
+
 /* --- Validation --- */
 
 #if (BSP_CAN_PRIORITY_LEVELS != 2) && (BSP_CAN_PRIORITY_LEVELS != 4) && (BSP_CAN_PRIORITY_LEVELS != 8)
@@ -86,6 +143,26 @@ extern "C"
     #error "BSP_CAN_RX_BUFFER_DEPTH must be between 4 and 128"
 #endif
 
+#if (BSP_CAN_DEFAULT_SAMPLE_POINT < 500) || (BSP_CAN_DEFAULT_SAMPLE_POINT > 950)
+    #error "BSP_CAN_DEFAULT_SAMPLE_POINT must be between 500 and 950 permille"
+#endif
+
+#if (BSP_CAN_RX0_IRQ_PRIORITY >= BSP_CAN_RX1_IRQ_PRIORITY) || (BSP_CAN_RX1_IRQ_PRIORITY > 15)
+    #error "BSP_CAN_RX0_IRQ_PRIORITY must be lower (more urgent) than BSP_CAN_RX1_IRQ_PRIORITY, both <= 15"
+#endif
+
+#if (BSP_CAN_MAX_RTR_RESPONDERS > 32)
+    #error "BSP_CAN_MAX_RTR_RESPONDERS must be <= 32"
+#endif
+
+#if (BSP_CAN_MAX_RATE_MONITORS > 32)
+    #error "BSP_CAN_MAX_RATE_MONITORS must be <= 32"
+#endif
+
+#if (BSP_CAN_RATE_CHECK_PERIOD_MS < 1)
+    #error "BSP_CAN_RATE_CHECK_PERIOD_MS must be >= 1"
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,471 @@
+/**
+ * @file bsp_canxfer.c
+ * @brief CAN block-transfer service implementation
+ *
+ * Byte offset N of the image lives in buffer (N / BLOCK) & 1 at N % BLOCK.
+ * The window limit is always at most two blocks past the programmed offset,
+ * so the RX ISR never writes into the block BspCanXferProcess() is programming.
+ */
+
+#include "bsp_canxfer.h"
+#include "bsp_compiler_attributes.h"
+#include "stm32f4xx_hal.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================================================
+ * Private Constants
+ * ========================================================================== */
+
+/** Largest offset that fits the 24-bit reply fields */
+#define CANXFER_MAX_OFFSET (0x00FFFFFFu)
+
+/* ============================================================================
+ * Private Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Transfer session.
+ *
+ * uReceived and the sequence state are owned by the RX ISR; uProgrammed,
+ * uLimit and the CRC are owned by BspCanXferProcess(). The ISR never
+ * transmits: it parks its reply in the pending slot for BspCanXferProcess().
+ */
+typedef struct
+{
+    BspCanXferConfig_t         tConfig;
+    bool                       bAllocated;
+    volatile BspCanXferState_e eState;
+    uint32_t                   uImageSize;   /**< Image size from START */
+    volatile uint32_t          uReceived;    /**< In-order bytes received */
+    volatile uint32_t          uLimit;       /**< Window limit sent to the sender */
+    uint32_t                   uProgrammed;  /**< Bytes programmed */
+    uint32_t                   uCrc;         /**< Running CRC-32 of programmed bytes */
+    volatile uint32_t          uExpectedCrc; /**< CRC from END */
+    volatile bool              bEndReceived; /**< END seen, verify when all bytes are programmed */
+    bool                       bNakSent;     /**< NAK sent, suppress more until the gap is filled */
+    volatile bool              bReplyDue;    /**< Reply from the RX ISR, sent by BspCanXferProcess() */
+    BspCanXferReply_e          ePendingStatus;
+    uint32_t                   uPendingOffset;
+    uint32_t                   uPendingLimit;
+    uint8_t                    byExpectedSeq;
+    uint32_t                   uFrames;
+    uint32_t                   uNaks;
+    uint8_t                    aabyBuffer[2][BSP_CANXFER_BLOCK_SIZE];
+} BspCanXferSession_t;
+
+/* ============================================================================
+ * Private Global Variables
+ * ========================================================================== */
+
+/** Session array */
+FORCE_STATIC BspCanXferSession_t s_aXferSessions[BSP_CANXFER_MAX_INSTANCES] = {0};
+
+/** CRC-32 (reflected 0xEDB88320) nibble table */
+FORCE_STATIC const uint32_t s_auCrc32Nibble[16] = {0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u,
+                                                   0x4DB26158u, 0x5005713Cu, 0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+                                                   0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu};
+
+/* ============================================================================
+ * Private Functions
+ * ========================================================================== */
+
+/**
+ * @brief Validate handle and return session pointer.
+ */
+FORCE_STATIC BspCanXferSession_t* sXferValidateHandle(BspCanXferHandle_t handle)
+{
+    if ((handle < 0) || (handle >= (BspCanXferHandle_t)BSP_CANXFER_MAX_INSTANCES))
+    {
+        return NULL;
+    }
+
+    if (!s_aXferSessions[handle].bAllocated)
+    {
+        return NULL;
+    }
+
+    return &s_aXferSessions[handle];
+}
+
+/**
+ * @brief Read a little-endian 32-bit value from a frame payload.
+ */
+FORCE_STATIC uint32_t sXferReadLe32(const uint8_t* pData)
+{
+    return (uint32_t)pData[0] | ((uint32_t)pData[1] << 8u) | ((uint32_t)pData[2] << 16u) | ((uint32_t)pData[3] << 24u);
+}
+
+/**
+ * @brief Queue a reply frame: status, 24-bit received offset, 24-bit window limit.
+ */
+FORCE_STATIC void sXferReply(const BspCanXferSession_t* pSession, BspCanXferReply_e eStatus, uint32_t uOffset, uint32_t uLimit)
+{
+    BspCanMessage_t tReply = {0};
+
+    tReply.uId        = pSession->tConfig.uReplyId;
+    tReply.eIdType    = pSession->tConfig.eIdType;
+    tReply.eFrameType = eBSP_CAN_FRAME_DATA;
+    tReply.byDataLen  = 8u;
+    tReply.aData[0]   = (uint8_t)eStatus;
+    tReply.aData[1]   = (uint8_t)uOffset;
+    tReply.aData[2]   = (uint8_t)(uOffset >> 8u);
+    tReply.aData[3]   = (uint8_t)(uOffset >> 16u);
+    tReply.aData[4]   = (uint8_t)uLimit;
+    tReply.aData[5]   = (uint8_t)(uLimit >> 8u);
+    tReply.aData[6]   = (uint8_t)(uLimit >> 16u);
+
+    /* A full TX queue drops the reply; the sender recovers by timeout */
+    (void)BspCanTransmit(pSession->tConfig.hCan, &tReply, pSession->tConfig.byReplyPrio, 0u);
+}
+
+/**
+ * @brief Park a reply from the RX ISR; BspCanXferProcess() sends it.
+ *
+ * BspCanTransmit() is not reentrant, so the ISR must not call it while the
+ * main loop may be inside it. A newer reply replaces one not yet sent.
+ */
+FORCE_STATIC void sXferDeferReply(BspCanXferSession_t* pSession, BspCanXferReply_e eStatus, uint32_t uOffset, uint32_t uLimit)
+{
+    pSession->ePendingStatus = eStatus;
+    pSession->uPendingOffset = uOffset;
+    pSession->uPendingLimit  = uLimit;
+    pSession->bReplyDue      = true;
+}
+
+/**
+ * @brief Enter the failed state and report the reason.
+ */
+FORCE_STATIC void sXferFail(BspCanXferSession_t* pSession, BspCanXferReply_e eStatus)
+{
+    pSession->eState = eBSP_CANXFER_STATE_FAILED;
+    sXferReply(pSession, eStatus, pSession->uReceived, pSession->uLimit);
+}
+
+/**
+ * @brief Window limit for a given programmed offset (two blocks ahead, capped at the image end).
+ */
+FORCE_STATIC uint32_t sXferWindowLimit(const BspCanXferSession_t* pSession, uint32_t uProgrammed)
+{
+    uint32_t uLimit = uProgrammed + (2u * BSP_CANXFER_BLOCK_SIZE);
+    return (uLimit < pSession->uImageSize) ? uLimit : pSession->uImageSize;
+}
+
+/**
+ * @brief Handle a control frame (START / END / ABORT).
+ */
+FORCE_STATIC void sXferHandleControl(BspCanXferSession_t* pSession, const BspCanMessage_t* pMessage)
+{
+    uint8_t byCmd = (pMessage->byDataLen > 0u) ? pMessage->aData[0] : 0u;
+
+    if (byCmd == BSP_CANXFER_CMD_START)
+    {
+        if ((pSession->eState == eBSP_CANXFER_STATE_ERASING) || (pSession->eState == eBSP_CANXFER_STATE_RECEIVING))
+        {
+            sXferDeferReply(pSession, eBSP_CANXFER_REPLY_ERR_STATE, pSession->uReceived, pSession->uLimit);
+            return;
+        }
+
+        uint32_t uSize = (pMessage->byDataLen >= 5u) ? sXferReadLe32(&pMessage->aData[1]) : 0u;
+        if ((uSize == 0u) || (uSize > pSession->tConfig.uFlashSize))
+        {
+            sXferDeferReply(pSession, eBSP_CANXFER_REPLY_ERR_SIZE, 0u, 0u);
+            return;
+        }
+
+        pSession->uImageSize    = uSize;
+        pSession->uReceived     = 0u;
+        pSession->uLimit        = 0u;
+        pSession->uProgrammed   = 0u;
+        pSession->uCrc          = 0u;
+        pSession->uExpectedCrc  = 0u;
+        pSession->bEndReceived  = false;
+        pSession->bNakSent      = false;
+        pSession->byExpectedSeq = 0u;
+        pSession->uFrames       = 0u;
+        pSession->uNaks         = 0u;
+        pSession->eState        = eBSP_CANXFER_STATE_ERASING;
+    }
+    else if (byCmd == BSP_CANXFER_CMD_END)
+    {
+        if ((pSession->eState != eBSP_CANXFER_STATE_RECEIVING) || (pMessage->byDataLen < 5u))
+        {
+            sXferDeferReply(pSession, eBSP_CANXFER_REPLY_ERR_STATE, pSession->uReceived, pSession->uLimit);
+            return;
+        }
+
+        /* Verified by BspCanXferProcess() once the last block is programmed */
+        pSession->uExpectedCrc = sXferReadLe32(&pMessage->aData[1]);
+        pSession->bEndReceived = true;
+    }
+    else if (byCmd == BSP_CANXFER_CMD_ABORT)
+    {
+        pSession->eState = eBSP_CANXFER_STATE_IDLE;
+    }
+    else
+    {
+        sXferDeferReply(pSession, eBSP_CANXFER_REPLY_ERR_STATE, pSession->uReceived, pSession->uLimit);
+    }
+}
+
+/**
+ * @brief Handle a data frame: sequence byte + up to 7 payload bytes.
+ */
+FORCE_STATIC void sXferHandleData(BspCanXferSession_t* pSession, const BspCanMessage_t* pMessage)
+{
+    if ((pSession->eState != eBSP_CANXFER_STATE_RECEIVING) || (pMessage->byDataLen < 2u))
+    {
+        return;
+    }
+
+    uint32_t uOffset = pSession->uReceived;
+    uint32_t uLength = (uint32_t)pMessage->byDataLen - 1u;
+
+    /* Every frame but the last one is full, so the sequence number follows the offset */
+    bool bInOrder = (pMessage->aData[0] == pSession->byExpectedSeq) &&
+                    ((uLength == BSP_CANXFER_FRAME_PAYLOAD) || ((uOffset + uLength) == pSession->uImageSize));
+
+    if (!bInOrder || ((uOffset + uLength) > pSession->uLimit))
+    {
+        /* Go-back-N: one NAK per gap, later frames are dropped until the resend arrives */
+        pSession->uNaks++;
+        if (!pSession->bNakSent)
+        {
+            pSession->bNakSent = true;
+            sXferDeferReply(pSession, eBSP_CANXFER_REPLY_NAK, uOffset, pSession->uLimit);
+        }
+        return;
+    }
+
+    for (uint32_t i = 0u; i < uLength; i++)
+    {
+        uint32_t uPos = uOffset + i;
+
+        pSession->aabyBuffer[(uPos / BSP_CANXFER_BLOCK_SIZE) & 1u][uPos % BSP_CANXFER_BLOCK_SIZE] = pMessage->aData[1u + i];
+    }
+
+    pSession->bNakSent = false;
+    pSession->byExpectedSeq++;
+    pSession->uFrames++;
+    pSession->uReceived = uOffset + uLength;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ========================================================================== */
+
+BspCanXferHandle_t BspCanXferAllocate(const BspCanXferConfig_t* pConfig)
+{
+    if ((pConfig == NULL) || (pConfig->tFlashOps.pfnErase == NULL) || (pConfig->tFlashOps.pfnProgram == NULL))
+    {
+        return BSP_CANXFER_INVALID_HANDLE;
+    }
+
+    if ((pConfig->uFlashSize == 0u) || (pConfig->uFlashSize > CANXFER_MAX_OFFSET))
+    {
+        return BSP_CANXFER_INVALID_HANDLE;
+    }
+
+    for (uint8_t i = 0u; i < BSP_CANXFER_MAX_INSTANCES; i++)
+    {
+        if (!s_aXferSessions[i].bAllocated)
+        {
+            BspCanXferSession_t* pSession = &s_aXferSessions[i];
+
+            memset(pSession, 0, sizeof(BspCanXferSession_t));
+            pSession->tConfig    = *pConfig;
+            pSession->eState     = eBSP_CANXFER_STATE_IDLE;
+            pSession->bAllocated = true;
+
+            return (BspCanXferHandle_t)i;
+        }
+    }
+
+    return BSP_CANXFER_INVALID_HANDLE;
+}
+
+BspCanXferError_e BspCanXferFree(BspCanXferHandle_t handle)
+{
+    BspCanXferSession_t* pSession = sXferValidateHandle(handle);
+    if (pSession == NULL)
+    {
+        return eBSP_CANXFER_ERR_INVALID_HANDLE;
+    }
+
+    if ((pSession->eState == eBSP_CANXFER_STATE_ERASING) || (pSession->eState == eBSP_CANXFER_STATE_RECEIVING))
+    {
+        return eBSP_CANXFER_ERR_BUSY;
+    }
+
+    memset(pSession, 0, sizeof(BspCanXferSession_t));
+
+    return eBSP_CANXFER_ERR_NONE;
+}
+
+bool BspCanXferOnRx(BspCanXferHandle_t handle, const BspCanMessage_t* pMessage)
+{
+    BspCanXferSession_t* pSession = sXferValidateHandle(handle);
+    if ((pSession == NULL) || (pMessage == NULL) || (pMessage->eIdType != pSession->tConfig.eIdType) ||
+        (pMessage->eFrameType != eBSP_CAN_FRAME_DATA))
+    {
+        return false;
+    }
+
+    if (pMessage->uId == pSession->tConfig.uDataId)
+    {
+        sXferHandleData(pSession, pMessage);
+        return true;
+    }
+
+    if (pMessage->uId == pSession->tConfig.uCtrlId)
+    {
+        sXferHandleControl(pSession, pMessage);
+        return true;
+    }
+
+    return false;
+}
+
+BspCanXferError_e BspCanXferProcess(BspCanXferHandle_t handle)
+{
+    BspCanXferSession_t* pSession = sXferValidateHandle(handle);
+    if (pSession == NULL)
+    {
+        return eBSP_CANXFER_ERR_INVALID_HANDLE;
+    }
+
+    /* Send the reply parked by the RX ISR first, ahead of any flash work */
+    if (pSession->bReplyDue)
+    {
+        __disable_irq();
+        BspCanXferReply_e eStatus = pSession->ePendingStatus;
+        uint32_t          uOffset = pSession->uPendingOffset;
+        uint32_t          uLimit  = pSession->uPendingLimit;
+        pSession->bReplyDue       = false;
+        __enable_irq();
+
+        sXferReply(pSession, eStatus, uOffset, uLimit);
+    }
+
+    if (pSession->eState == eBSP_CANXFER_STATE_ERASING)
+    {
+        if (!pSession->tConfig.tFlashOps.pfnErase(pSession->tConfig.uFlashAddress, pSession->uImageSize))
+        {
+            sXferFail(pSession, eBSP_CANXFER_REPLY_ERR_FLASH);
+            return eBSP_CANXFER_ERR_NONE;
+        }
+
+        /* Open the window; from here on the RX ISR fills both buffers */
+        __disable_irq();
+        if (pSession->eState == eBSP_CANXFER_STATE_ERASING)
+        {
+            pSession->uLimit = sXferWindowLimit(pSession, 0u);
+            pSession->eState = eBSP_CANXFER_STATE_RECEIVING;
+        }
+        __enable_irq();
+
+        if (pSession->eState == eBSP_CANXFER_STATE_RECEIVING)
+        {
+            sXferReply(pSession, eBSP_CANXFER_REPLY_ACK, 0u, pSession->uLimit);
+        }
+        return eBSP_CANXFER_ERR_NONE;
+    }
+
+    if (pSession->eState != eBSP_CANXFER_STATE_RECEIVING)
+    {
+        return eBSP_CANXFER_ERR_NONE;
+    }
+
+    /* Program the oldest block once it is complete (the last block may be short) */
+    uint32_t uBlockLen = pSession->uImageSize - pSession->uProgrammed;
+    if (uBlockLen > BSP_CANXFER_BLOCK_SIZE)
+    {
+        uBlockLen = BSP_CANXFER_BLOCK_SIZE;
+    }
+
+    if ((uBlockLen > 0u) && ((pSession->uReceived - pSession->uProgrammed) >= uBlockLen))
+    {
+        const uint8_t* pBlock = pSession->aabyBuffer[(pSession->uProgrammed / BSP_CANXFER_BLOCK_SIZE) & 1u];
+
+        if (!pSession->tConfig.tFlashOps.pfnProgram(pSession->tConfig.uFlashAddress + pSession->uProgrammed, pBlock, uBlockLen))
+        {
+            sXferFail(pSession, eBSP_CANXFER_REPLY_ERR_FLASH);
+            return eBSP_CANXFER_ERR_NONE;
+        }
+
+        /* Computed outside the lock, stored only if the session survived programming */
+        uint32_t uCrc = BspCanXferCrc32(pSession->uCrc, pBlock, uBlockLen);
+
+        /* An ABORT/START may have arrived while programming: the new session keeps its own CRC */
+        __disable_irq();
+        bool bStillReceiving = (pSession->eState == eBSP_CANXFER_STATE_RECEIVING);
+        if (bStillReceiving)
+        {
+            pSession->uCrc = uCrc;
+            pSession->uProgrammed += uBlockLen;
+            pSession->uLimit = sXferWindowLimit(pSession, pSession->uProgrammed);
+        }
+        __enable_irq();
+
+        if (!bStillReceiving)
+        {
+            return eBSP_CANXFER_ERR_NONE;
+        }
+
+        /* Windowed acknowledgement: one per programmed block */
+        sXferReply(pSession, eBSP_CANXFER_REPLY_ACK, pSession->uReceived, pSession->uLimit);
+    }
+
+    if ((pSession->uProgrammed == pSession->uImageSize) && pSession->bEndReceived)
+    {
+        if (pSession->uCrc == pSession->uExpectedCrc)
+        {
+            pSession->eState = eBSP_CANXFER_STATE_DONE;
+            sXferReply(pSession, eBSP_CANXFER_REPLY_DONE, pSession->uReceived, pSession->uLimit);
+        }
+        else
+        {
+            sXferFail(pSession, eBSP_CANXFER_REPLY_ERR_CRC);
+        }
+    }
+
+    return eBSP_CANXFER_ERR_NONE;
+}
+
+BspCanXferError_e BspCanXferGetStatus(BspCanXferHandle_t handle, BspCanXferStatus_t* pStatus)
+{
+    BspCanXferSession_t* pSession = sXferValidateHandle(handle);
+    if (pSession == NULL)
+    {
+        return eBSP_CANXFER_ERR_INVALID_HANDLE;
+    }
+
+    if (pStatus == NULL)
+    {
+        return eBSP_CANXFER_ERR_INVALID_PARAM;
+    }
+
+    pStatus->eState      = pSession->eState;
+    pStatus->uImageSize  = pSession->uImageSize;
+    pStatus->uReceived   = pSession->uReceived;
+    pStatus->uProgrammed = pSession->uProgrammed;
+    pStatus->uCrc        = pSession->uCrc;
+    pStatus->uFrames     = pSession->uFrames;
+    pStatus->uNaks       = pSession->uNaks;
+
+    return eBSP_CANXFER_ERR_NONE;
+}
+
+uint32_t BspCanXferCrc32(uint32_t uCrc, const uint8_t* pData, uint32_t uLength)
+{
+    uCrc = ~uCrc;
+
+    for (uint32_t i = 0u; i < uLength; i++)
+    {
+        uCrc ^= pData[i];
+        uCrc = (uCrc >> 4u) ^ s_auCrc32Nibble[uCrc & 0x0Fu];
+        uCrc = (uCrc >> 4u) ^ s_auCrc32Nibble[uCrc & 0x0Fu];
+    }
+
+    return ~uCrc;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file bsp_canxfer.h
+ * @brief CAN block-transfer service for firmware updates
+ *
+ * Streams a firmware image over CAN into internal flash:
+ * - Data frames carry a sequence byte and 7 payload bytes, sent back-to-back
+ * - One acknowledgement per flash block opens a window of two blocks
+ * - Double buffer: one block is programmed while the next one is received
+ * - Running CRC-32 over the programmed image, checked against the sender's CRC
+ *
+ * The RX side runs in the CAN RX callback (BspCanXferOnRx()); erase and
+ * programming run in the main loop (BspCanXferProcess()).
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "bsp_can.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/**
+ * @brief Maximum number of transfer sessions (one per CAN bus is typical).
+ * Each session holds two BSP_CANXFER_BLOCK_SIZE buffers.
+ */
+#ifndef BSP_CANXFER_MAX_INSTANCES
+    #define BSP_CANXFER_MAX_INSTANCES (1u)
+#endif
+
+/**
+ * @brief Flash block size in bytes (one programming step, one acknowledgement).
+ * The sender may be up to two blocks ahead of flash, so the window
+ * (2 × block / 7 frames) must stay below the 256-entry sequence space.
+ * Memory impact: 2 × BSP_CANXFER_BLOCK_SIZE bytes per session.
+ */
+#ifndef BSP_CANXFER_BLOCK_SIZE
+    #define BSP_CANXFER_BLOCK_SIZE (512u)
+#endif
+
+#if (BSP_CANXFER_BLOCK_SIZE < 64u) || (BSP_CANXFER_BLOCK_SIZE > 888u) || ((BSP_CANXFER_BLOCK_SIZE % 8u) != 0u)
+    #error "BSP_CANXFER_BLOCK_SIZE must be a multiple of 8 between 64 and 888"
+#endif
+
+/* ============================================================================
+ * Protocol
+ * ========================================================================== */
+
+/** Payload bytes per data frame (byte 0 is the sequence number) */
+#define BSP_CANXFER_FRAME_PAYLOAD (7u)
+
+/** Control command: start a transfer, bytes 1-4 = image size (little endian) */
+#define BSP_CANXFER_CMD_START (0x01u)
+/** Control command: end of image, bytes 1-4 = CRC-32 of the image (little endian) */
+#define BSP_CANXFER_CMD_END (0x02u)
+/** Control command: abort the current transfer */
+#define BSP_CANXFER_CMD_ABORT (0x03u)
+
+/**
+ * @brief Reply status (byte 0 of every reply frame).
+ *
+ * Reply layout: byte 0 status, bytes 1-3 in-order bytes received,
+ * bytes 4-6 window limit (the sender may send data below this offset).
+ */
+typedef enum
+{
+    eBSP_CANXFER_REPLY_ACK       = 0x00u, /**< Ready / window update */
+    eBSP_CANXFER_REPLY_NAK       = 0x01u, /**< Sequence gap: resend from offset */
+    eBSP_CANXFER_REPLY_DONE      = 0x02u, /**< Image programmed, CRC matched */
+    eBSP_CANXFER_REPLY_ERR_CRC   = 0x80u, /**< CRC mismatch */
+    eBSP_CANXFER_REPLY_ERR_SIZE  = 0x81u, /**< Image size invalid or exceeded */
+    eBSP_CANXFER_REPLY_ERR_FLASH = 0x82u, /**< Erase or program failed */
+    eBSP_CANXFER_REPLY_ERR_STATE = 0x83u  /**< Command not valid in current state */
+} BspCanXferReply_e;
+
+/* ============================================================================
+ * Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Transfer session handle. Valid handles are >= 0.
+ */
+typedef int8_t BspCanXferHandle_t;
+
+/** Invalid handle constant */
+static const BspCanXferHandle_t BSP_CANXFER_INVALID_HANDLE = -1;
+
+/**
+ * @brief Transfer error codes.
+ */
+typedef enum
+{
+    eBSP_CANXFER_ERR_NONE = 0u,      /**< Success */
+    eBSP_CANXFER_ERR_INVALID_HANDLE, /**< Invalid or unallocated handle */
+    eBSP_CANXFER_ERR_INVALID_PARAM,  /**< Invalid parameter */
+    eBSP_CANXFER_ERR_BUSY            /**< Transfer in progress */
+} BspCanXferError_e;
+
+/**
+ * @brief Transfer session state.
+ */
+typedef enum
+{
+    eBSP_CANXFER_STATE_IDLE = 0u, /**< Waiting for START */
+    eBSP_CANXFER_STATE_ERASING,   /**< START accepted, erase pending in BspCanXferProcess() */
+    eBSP_CANXFER_STATE_RECEIVING, /**< Streaming data into flash */
+    eBSP_CANXFER_STATE_DONE,      /**< Image programmed and verified */
+    eBSP_CANXFER_STATE_FAILED     /**< Transfer failed (see last reply) */
+} BspCanXferState_e;
+
+/**
+ * @brief Flash access supplied by the application.
+ *
+ * Both functions are called from BspCanXferProcess() only. pfnProgram gets
+ * whole blocks at block-aligned offsets; only the last block may be shorter
+ * (pad it to the flash programming width).
+ */
+typedef struct
+{
+    bool (*pfnErase)(uint32_t uAddress, uint32_t uLength);                        /**< Erase the image area */
+    bool (*pfnProgram)(uint32_t uAddress, const uint8_t* pData, uint32_t uLength); /**< Program one block */
+} BspCanXferFlashOps_t;
+
+/**
+ * @brief Transfer session configuration.
+ */
+typedef struct
+{
+    BspCanHandle_t       hCan;          /**< Started bsp_can handle used for replies */
+    uint32_t             uCtrlId;       /**< Control frames (sender -> node) */
+    uint32_t             uDataId;       /**< Data frames (sender -> node) */
+    uint32_t             uReplyId;      /**< Reply frames (node -> sender) */
+    BspCanIdType_e       eIdType;       /**< ID type of all three IDs */
+    uint8_t              byReplyPrio;   /**< bsp_can TX priority of replies */
+    uint32_t             uFlashAddress; /**< Destination of the image */
+    uint32_t             uFlashSize;    /**< Maximum image size (<= 16 MiB) */
+    BspCanXferFlashOps_t tFlashOps;     /**< Flash erase/program functions */
+} BspCanXferConfig_t;
+
+/**
+ * @brief Transfer progress and statistics.
+ */
+typedef struct
+{
+    BspCanXferState_e eState;      /**< Session state */
+    uint32_t          uImageSize;  /**< Image size from START */
+    uint32_t          uReceived;   /**< In-order bytes received */
+    uint32_t          uProgrammed; /**< Bytes programmed into flash */
+    uint32_t          uCrc;        /**< Running CRC-32 of the programmed bytes */
+    uint32_t          uFrames;     /**< Data frames accepted */
+    uint32_t          uNaks;       /**< Out-of-sequence or out-of-window frames */
+} BspCanXferStatus_t;
+
+/* ============================================================================
+ * Public API
+ * ========================================================================== */
+
+/**
+ * @brief Allocate a transfer session.
+ *
+ * @param pConfig    Session configuration (copied)
+ * @return           Session handle, BSP_CANXFER_INVALID_HANDLE on error
+ */
+BspCanXferHandle_t BspCanXferAllocate(const BspCanXferConfig_t* pConfig);
+
+/**
+ * @brief Free a transfer session.
+ *
+ * @param handle     Session handle
+ * @return           Error code
+ */
+BspCanXferError_e BspCanXferFree(BspCanXferHandle_t handle);
+
+/**
+ * @brief Feed a received CAN frame to the session.
+ *
+ * Call from the bsp_can RX callback. Data frames are copied into the
+ * double buffer; gaps and window violations are answered with a NAK.
+ * Nothing is transmitted here: NAK and error replies are sent by the next
+ * BspCanXferProcess() call.
+ *
+ * @param handle     Session handle
+ * @param pMessage   Received frame
+ * @return           true if the frame belongs to the session (consumed)
+ */
+bool BspCanXferOnRx(BspCanXferHandle_t handle, const BspCanMessage_t* pMessage);
+
+/**
+ * @brief Run erase, block programming and final verification.
+ *
+ * Call from the main loop. Sends any reply left by BspCanXferOnRx(), then
+ * programs at most one block per call and sends the window update for it,
+ * so the other buffer keeps receiving meanwhile. All replies leave from here.
+ *
+ * @param handle     Session handle
+ * @return           Error code
+ */
+BspCanXferError_e BspCanXferProcess(BspCanXferHandle_t handle);
+
+/**
+ * @brief Get transfer progress.
+ *
+ * @param handle     Session handle
+ * @param pStatus    Output: status snapshot
+ * @return           Error code
+ */
+BspCanXferError_e BspCanXferGetStatus(BspCanXferHandle_t handle, BspCanXferStatus_t* pStatus);
+
+/**
+ * @brief Calculate CRC-32 (IEEE 802.3, as used by zlib) incrementally.
+ *
+ * Start with uCrc = 0; pass the previous result to continue.
+ *
+ * @param uCrc       CRC of the preceding data (0 for none)
+ * @param pData      Data
+ * @param uLength    Data length
+ * @return           CRC including pData
+ */
+uint32_t BspCanXferCrc32(uint32_t uCrc, const uint8_t* pData, uint32_t uLength);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,87 @@
+/*
+ * bsp_xfer.h
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "stm32f4xx_hal.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* --- Type Definitions --- */
+
+/**
+ * Completion token of an asynchronous transfer.
+ * Owned by the caller and passed with the transfer; the driver arms it when the
+ * transfer is accepted and completes it from the interrupt that ends the transfer.
+ * The token must remain valid until it is done.
+ */
+typedef struct
+{
+    volatile bool    bDone;  /**< Transfer ended, successfully or not */
+    volatile int32_t iError; /**< Driver error code (0 = success), valid once bDone is set */
+} BspXferToken_t;
+
+/* --- Public Functions --- */
+
+/**
+ * Checks whether the transfer of a token has ended.
+ *
+ * @param pToken The completion token
+ * @return true once the driver has completed the token
+ */
+static inline bool BspXferIsDone(const BspXferToken_t* pToken)
+{
+    return pToken->bDone;
+}
+
+/**
+ * Gets the result of a completed transfer.
+ *
+ * @param pToken The completion token
+ * @return Driver error code (BspSpiError_e, BspI2cError_e), 0 on success
+ */
+static inline int32_t BspXferGetError(const BspXferToken_t* pToken)
+{
+    return pToken->iError;
+}
+
+/**
+ * Arms a token for a transfer that has been accepted (driver side).
+ *
+ * @param pToken The completion token, may be NULL
+ */
+static inline void BspXferArm(BspXferToken_t* pToken)
+{
+    if (pToken != NULL)
+    {
+        pToken->iError = 0;
+        pToken->bDone  = false;
+    }
+}
+
+/**
+ * Completes a token (driver side). The error code is written before the done flag,
+ * with a barrier between them so a reader that sees bDone also sees iError.
+ *
+ * @param pToken The completion token, may be NULL
+ * @param iError Driver error code, 0 on success
+ */
+static inline void BspXferComplete(BspXferToken_t* pToken, int32_t iError)
+{
+    if (pToken != NULL)
+    {
+        pToken->iError = iError;
+        __DMB();
+        pToken->bDone = true;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
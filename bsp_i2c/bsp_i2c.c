@@ -37,6 +37,18 @@ typedef struct
     BspI2cMemTxCpltCb_t pMemTxCpltCb; /**< Memory transmit completion callback */
     BspI2cMemRxCpltCb_t pMemRxCpltCb; /**< Memory receive completion callback */
     BspI2cErrorCb_t     pErrorCb;     /**< Error callback */
+
+    /* Transfer in flight, from its configuration */
+    BspI2cXferCb_t  pXferCb;      /**< Per-transfer callback, NULL to use the registered ones */
+    void*           pXferContext; /**< Context passed to pXferCb */
+    BspXferToken_t* pXferToken;   /**< Completion token, or NULL */
+
+    /* Transaction queue, ordered by priority from the head; the head is in flight while bQueueActive */
+    BspI2cXfer_t       aQueue[BSP_I2C_QUEUE_DEPTH]; /**< Ring buffer of pending transactions */
+    uint8_t            byQueueHead;                 /**< Index of the oldest entry */
+    uint8_t            byQueueCount;                /**< Number of pending entries */
+    bool               bQueueActive;                /**< Head entry is on the bus */
+    BspI2cQueueStats_t tQueueStats;                 /**< Queue counters */
 } BspI2cModule_t;
 
 /* --- Private Variables --- */
@@ -44,6 +56,9 @@ typedef struct
 /** Array of I2C module instances */
 FORCE_STATIC BspI2cModule_t s_i2cModules[BSP_I2C_MAX_INSTANCES] = {0};
 
+/** Allocated module of each instance, NULL if free (routes HAL callbacks without a search) */
+FORCE_STATIC BspI2cModule_t* s_i2cModuleOfInstance[eBSP_I2C_INSTANCE_COUNT] = {0};
+
 /* --- External HAL Handles --- */
 
 extern I2C_HandleTypeDef hi2c1;
@@ -79,14 +94,117 @@ FORCE_STATIC uint8_t sBspI2cFindModuleIndex(BspI2cHandle_t handle);
  */
 FORCE_STATIC BspI2cModule_t* sBspI2cValidateHandle(BspI2cHandle_t handle);
 
+/**
+ * Gets the I2C instance of a HAL handle (inverse of sBspI2cGetHalHandle()).
+ *
+ * @param pHalHandle Pointer to the HAL I2C handle
+ * @return The instance, or eBSP_I2C_INSTANCE_COUNT for an unknown handle
+ */
+FORCE_STATIC BspI2cInstance_e sBspI2cGetInstance(const I2C_HandleTypeDef* pHalHandle);
+
 /**
  * Finds a module by HAL handle (used in HAL callbacks).
+ * No module scan: the handle is compared against the six HAL handles to get its instance,
+ * which indexes the module allocated for it.
  *
  * @param pHalHandle Pointer to the HAL I2C handle
  * @return Pointer to the module, or NULL if not found
  */
 FORCE_STATIC BspI2cModule_t* sBspI2cFindModuleByHalHandle(I2C_HandleTypeDef* pHalHandle);
 
+/**
+ * Records the per-transfer callback, context and token before an interrupt mode start.
+ *
+ * @param pModule The I2C module
+ * @param pCallback Per-transfer callback, or NULL
+ * @param pContext Context passed to the callback
+ * @param pToken Completion token, or NULL
+ * @return false if a transfer is in flight (its callback and token are kept)
+ */
+FORCE_STATIC bool sBspI2cArm(BspI2cModule_t* pModule, BspI2cXferCb_t pCallback, void* pContext, BspXferToken_t* pToken);
+
+/**
+ * Maps the HAL status of an interrupt mode start; a transfer that did not start is disarmed.
+ *
+ * @param pModule The I2C module
+ * @param halStatus Status returned by the HAL start function
+ * @return Error code indicating success or failure
+ */
+FORCE_STATIC BspI2cError_e sBspI2cStarted(BspI2cModule_t* pModule, HAL_StatusTypeDef halStatus);
+
+/**
+ * Completes the transfer in flight: token, then the per-transfer or the registered callback.
+ *
+ * @param pModule The I2C module
+ * @param pDoneCb Registered completion callback of the transfer type
+ */
+FORCE_STATIC void sBspI2cOnDone(BspI2cModule_t* pModule, BspI2cTxCpltCb_t pDoneCb);
+
+/**
+ * Fails the transfer in flight: token, then the per-transfer or the registered error callback.
+ *
+ * @param pModule The I2C module
+ */
+FORCE_STATIC void sBspI2cOnError(BspI2cModule_t* pModule);
+
+/**
+ * Empties the transaction queue and clears its counters.
+ *
+ * @param pModule The I2C module
+ */
+FORCE_STATIC void sBspI2cQueueReset(BspI2cModule_t* pModule);
+
+/**
+ * Inserts a transaction behind all pending ones of equal or higher priority and starts the bus if idle.
+ *
+ * @param pModule The I2C module
+ * @param pXfer Validated transaction descriptor
+ * @return Error code; eBSP_I2C_ERR_BUSY if the queue is full
+ */
+FORCE_STATIC BspI2cError_e sBspI2cQueuePush(BspI2cModule_t* pModule, const BspI2cXfer_t* pXfer);
+
+/**
+ * Removes the head entry of the queue.
+ *
+ * @param pModule The I2C module
+ * @return Copy of the removed entry
+ */
+FORCE_STATIC BspI2cXfer_t sBspI2cQueuePop(BspI2cModule_t* pModule);
+
+/**
+ * Starts the HAL interrupt mode transfer of a transaction.
+ *
+ * @param pHalHandle Pointer to the HAL I2C handle
+ * @param pXfer Transaction descriptor
+ * @return HAL status of the start
+ */
+FORCE_STATIC HAL_StatusTypeDef sBspI2cQueueStart(I2C_HandleTypeDef* pHalHandle, const BspI2cXfer_t* pXfer);
+
+/**
+ * Claims the queue head for starting by setting bQueueActive if the bus is idle.
+ * Call with interrupts disabled, so the caller and a completion interrupt never both start it.
+ *
+ * @param pModule The I2C module
+ * @return true if the caller now owns the start of the queue head
+ */
+FORCE_STATIC bool sBspI2cQueueClaim(BspI2cModule_t* pModule);
+
+/**
+ * Starts the head of the queue if the bus is idle; failed starts are completed and the next entry tried.
+ * Call with interrupts enabled: only the claim runs under the lock, HAL starts and callbacks run outside it.
+ *
+ * @param pModule The I2C module
+ */
+FORCE_STATIC void sBspI2cQueueStartNext(BspI2cModule_t* pModule);
+
+/**
+ * Completes the queued transaction in flight and starts the next one before its callback runs.
+ *
+ * @param pModule The I2C module
+ * @param eError Result of the transaction
+ */
+FORCE_STATIC void sBspI2cQueueOnDone(BspI2cModule_t* pModule, BspI2cError_e eError);
+
 /* --- Private Helper Functions --- */
 
 FORCE_STATIC I2C_HandleTypeDef* sBspI2cGetHalHandle(BspI2cInstance_e eInstance)
@@ -146,22 +264,299 @@ FORCE_STATIC BspI2cModule_t* sBspI2cValidateHandle(BspI2cHandle_t handle)
     return &s_i2cModules[index];
 }
 
+FORCE_STATIC BspI2cInstance_e sBspI2cGetInstance(const I2C_HandleTypeDef* pHalHandle)
+{
+    BspI2cInstance_e eInstance = eBSP_I2C_INSTANCE_COUNT;
+
+    if (pHalHandle == &hi2c1)
+    {
+        eInstance = eBSP_I2C_INSTANCE_1;
+    }
+    else if (pHalHandle == &hi2c2)
+    {
+        eInstance = eBSP_I2C_INSTANCE_2;
+    }
+    else if (pHalHandle == &hi2c3)
+    {
+        eInstance = eBSP_I2C_INSTANCE_3;
+    }
+    else if (pHalHandle == &hi2c4)
+    {
+        eInstance = eBSP_I2C_INSTANCE_4;
+    }
+    else if (pHalHandle == &hi2c5)
+    {
+        eInstance = eBSP_I2C_INSTANCE_5;
+    }
+    else if (pHalHandle == &hi2c6)
+    {
+        eInstance = eBSP_I2C_INSTANCE_6;
+    }
+
+    return eInstance;
+}
+
 FORCE_STATIC BspI2cModule_t* sBspI2cFindModuleByHalHandle(I2C_HandleTypeDef* pHalHandle)
 {
-    if (pHalHandle == NULL)
+    BspI2cInstance_e eInstance = sBspI2cGetInstance(pHalHandle);
+
+    return (eInstance < eBSP_I2C_INSTANCE_COUNT) ? s_i2cModuleOfInstance[eInstance] : NULL;
+}
+
+FORCE_STATIC bool sBspI2cArm(BspI2cModule_t* pModule, BspI2cXferCb_t pCallback, void* pContext, BspXferToken_t* pToken)
+{
+    /* HAL refuses to start unless ready; check first so a running transfer keeps its completion */
+    if ((pModule->byQueueCount > 0u) || (pModule->pHalHandle->State != HAL_I2C_STATE_READY))
     {
-        return NULL;
+        return false;
     }
 
-    for (uint8_t i = 0u; i < BSP_I2C_MAX_INSTANCES; i++)
+    /* Before the start: the completion interrupt may come before HAL returns */
+    pModule->pXferCb      = pCallback;
+    pModule->pXferContext = pContext;
+    pModule->pXferToken   = pToken;
+    BspXferArm(pToken);
+
+    return true;
+}
+
+FORCE_STATIC BspI2cError_e sBspI2cStarted(BspI2cModule_t* pModule, HAL_StatusTypeDef halStatus)
+{
+    if (halStatus == HAL_OK)
+    {
+        return eBSP_I2C_ERR_NONE;
+    }
+
+    pModule->pXferCb      = NULL;
+    pModule->pXferContext = NULL;
+    pModule->pXferToken   = NULL;
+
+    return (halStatus == HAL_BUSY) ? eBSP_I2C_ERR_BUSY : eBSP_I2C_ERR_TRANSFER;
+}
+
+FORCE_STATIC void sBspI2cOnDone(BspI2cModule_t* pModule, BspI2cTxCpltCb_t pDoneCb)
+{
+    if (pModule->bQueueActive)
+    {
+        sBspI2cQueueOnDone(pModule, eBSP_I2C_ERR_NONE);
+        return;
+    }
+
+    BspI2cHandle_t handle   = (BspI2cHandle_t)(pModule - s_i2cModules);
+    BspI2cXferCb_t pXferCb  = pModule->pXferCb;
+    void*          pContext = pModule->pXferContext;
+
+    BspXferComplete(pModule->pXferToken, (int32_t)eBSP_I2C_ERR_NONE);
+    pModule->pXferCb      = NULL;
+    pModule->pXferContext = NULL;
+    pModule->pXferToken   = NULL;
+
+    /* Transactions queued behind the direct transfer */
+    sBspI2cQueueStartNext(pModule);
+
+    if (pXferCb != NULL)
+    {
+        pXferCb(handle, eBSP_I2C_ERR_NONE, pContext);
+    }
+    else if (pDoneCb != NULL)
+    {
+        pDoneCb(handle);
+    }
+}
+
+FORCE_STATIC void sBspI2cOnError(BspI2cModule_t* pModule)
+{
+    if (pModule->bQueueActive)
+    {
+        sBspI2cQueueOnDone(pModule, eBSP_I2C_ERR_TRANSFER);
+        return;
+    }
+
+    BspI2cHandle_t handle   = (BspI2cHandle_t)(pModule - s_i2cModules);
+    BspI2cXferCb_t pXferCb  = pModule->pXferCb;
+    void*          pContext = pModule->pXferContext;
+
+    BspXferComplete(pModule->pXferToken, (int32_t)eBSP_I2C_ERR_TRANSFER);
+    pModule->pXferCb      = NULL;
+    pModule->pXferContext = NULL;
+    pModule->pXferToken   = NULL;
+
+    sBspI2cQueueStartNext(pModule);
+
+    if (pXferCb != NULL)
+    {
+        pXferCb(handle, eBSP_I2C_ERR_TRANSFER, pContext);
+    }
+    else if (pModule->pErrorCb != NULL)
+    {
+        pModule->pErrorCb(handle, eBSP_I2C_ERR_TRANSFER);
+    }
+}
+
+FORCE_STATIC void sBspI2cQueueReset(BspI2cModule_t* pModule)
+{
+    pModule->byQueueHead  = 0u;
+    pModule->byQueueCount = 0u;
+    pModule->bQueueActive = false;
+    pModule->tQueueStats  = (BspI2cQueueStats_t){0};
+}
+
+FORCE_STATIC BspI2cError_e sBspI2cQueuePush(BspI2cModule_t* pModule, const BspI2cXfer_t* pXfer)
+{
+    __disable_irq();
+
+    if (pModule->byQueueCount >= BSP_I2C_QUEUE_DEPTH)
+    {
+        pModule->tQueueStats.uRejected++;
+        __enable_irq();
+        return eBSP_I2C_ERR_BUSY;
+    }
+
+    /* Shift lower priorities back; the entry in flight keeps the head */
+    uint8_t byPos   = pModule->byQueueCount;
+    uint8_t byFirst = pModule->bQueueActive ? 1u : 0u;
+
+    while ((byPos > byFirst) &&
+           (pModule->aQueue[(pModule->byQueueHead + byPos - 1u) % BSP_I2C_QUEUE_DEPTH].ePriority < pXfer->ePriority))
+    {
+        pModule->aQueue[(pModule->byQueueHead + byPos) % BSP_I2C_QUEUE_DEPTH] =
+            pModule->aQueue[(pModule->byQueueHead + byPos - 1u) % BSP_I2C_QUEUE_DEPTH];
+        byPos--;
+    }
+
+    pModule->aQueue[(pModule->byQueueHead + byPos) % BSP_I2C_QUEUE_DEPTH] = *pXfer;
+    pModule->byQueueCount++;
+    BspXferArm(pXfer->pToken);
+
+    if (pModule->byQueueCount > pModule->tQueueStats.byHighWater)
+    {
+        pModule->tQueueStats.byHighWater = pModule->byQueueCount;
+    }
+
+    __enable_irq();
+
+    /* The HAL start waits for the BUSY flag and may fail: keep it out of the critical section */
+    sBspI2cQueueStartNext(pModule);
+
+    return eBSP_I2C_ERR_NONE;
+}
+
+FORCE_STATIC BspI2cXfer_t sBspI2cQueuePop(BspI2cModule_t* pModule)
+{
+    BspI2cXfer_t tEntry = pModule->aQueue[pModule->byQueueHead];
+
+    pModule->byQueueHead  = (uint8_t)((pModule->byQueueHead + 1u) % BSP_I2C_QUEUE_DEPTH);
+    pModule->byQueueCount = (uint8_t)(pModule->byQueueCount - 1u);
+
+    return tEntry;
+}
+
+FORCE_STATIC HAL_StatusTypeDef sBspI2cQueueStart(I2C_HandleTypeDef* pHalHandle, const BspI2cXfer_t* pXfer)
+{
+    HAL_StatusTypeDef halStatus = HAL_ERROR;
+
+    switch (pXfer->eType)
+    {
+        case eBSP_I2C_XFER_WRITE:
+            halStatus = HAL_I2C_Master_Transmit_IT(pHalHandle, pXfer->devAddr, pXfer->pData, pXfer->length);
+            break;
+        case eBSP_I2C_XFER_READ:
+            halStatus = HAL_I2C_Master_Receive_IT(pHalHandle, pXfer->devAddr, pXfer->pData, pXfer->length);
+            break;
+        case eBSP_I2C_XFER_MEM_WRITE:
+            halStatus = HAL_I2C_Mem_Write_IT(pHalHandle, pXfer->devAddr, pXfer->memAddr, (uint16_t)pXfer->memAddrSize, pXfer->pData,
+                                             pXfer->length);
+            break;
+        case eBSP_I2C_XFER_MEM_READ:
+            halStatus = HAL_I2C_Mem_Read_IT(pHalHandle, pXfer->devAddr, pXfer->memAddr, (uint16_t)pXfer->memAddrSize, pXfer->pData,
+                                            pXfer->length);
+            break;
+        default:
+            break;
+    }
+
+    return halStatus;
+}
+
+FORCE_STATIC bool sBspI2cQueueClaim(BspI2cModule_t* pModule)
+{
+    /* A direct transfer in flight resumes the queue from its completion */
+    if ((pModule->byQueueCount == 0u) || pModule->bQueueActive || (pModule->pHalHandle->State != HAL_I2C_STATE_READY))
     {
-        if (s_i2cModules[i].bAllocated && (s_i2cModules[i].pHalHandle == pHalHandle))
+        return false;
+    }
+
+    /* Claim the bus before starting: the completion interrupt may come before HAL returns */
+    pModule->bQueueActive = true;
+    return true;
+}
+
+FORCE_STATIC void sBspI2cQueueStartNext(BspI2cModule_t* pModule)
+{
+    BspI2cHandle_t handle = (BspI2cHandle_t)(pModule - s_i2cModules);
+
+    for (;;)
+    {
+        __disable_irq();
+        bool bClaimed = sBspI2cQueueClaim(pModule);
+        __enable_irq();
+
+        if (!bClaimed)
+        {
+            return;
+        }
+
+        /* The claimed head keeps its slot: pushes only insert behind it */
+        HAL_StatusTypeDef halStatus = sBspI2cQueueStart(pModule->pHalHandle, &pModule->aQueue[pModule->byQueueHead]);
+
+        if (halStatus == HAL_OK)
+        {
+            return;
+        }
+
+        /* Ready but not started (e.g. bus held low): fail the entry rather than stall the queue */
+        __disable_irq();
+        BspI2cXfer_t tFailed = sBspI2cQueuePop(pModule);
+        pModule->tQueueStats.uErrors++;
+        pModule->bQueueActive = false;
+        __enable_irq();
+
+        BspI2cError_e eError = (halStatus == HAL_BUSY) ? eBSP_I2C_ERR_BUSY : eBSP_I2C_ERR_TRANSFER;
+
+        BspXferComplete(tFailed.pToken, (int32_t)eError);
+
+        if (tFailed.pCallback != NULL)
         {
-            return &s_i2cModules[i];
+            tFailed.pCallback(handle, eError, tFailed.pContext);
         }
     }
+}
+
+FORCE_STATIC void sBspI2cQueueOnDone(BspI2cModule_t* pModule, BspI2cError_e eError)
+{
+    BspI2cHandle_t handle = (BspI2cHandle_t)(pModule - s_i2cModules);
+    BspI2cXfer_t   tDone  = sBspI2cQueuePop(pModule);
+
+    pModule->bQueueActive = false;
+
+    if (eError == eBSP_I2C_ERR_NONE)
+    {
+        pModule->tQueueStats.uCompleted++;
+    }
+    else
+    {
+        pModule->tQueueStats.uErrors++;
+    }
 
-    return NULL;
+    /* Keep the bus busy: next transaction goes out before the callback runs */
+    sBspI2cQueueStartNext(pModule);
+
+    BspXferComplete(tDone.pToken, (int32_t)eError);
+
+    if (tDone.pCallback != NULL)
+    {
+        tDone.pCallback(handle, eError, tDone.pContext);
+    }
 }
 
 /* --- Public Functions --- */
@@ -182,12 +577,9 @@ BspI2cHandle_t BspI2cAllocate(BspI2cInstance_e eInstance, BspI2cMode_e eMode, ui
     }
 
     /* Check if this instance is already allocated */
-    for (uint8_t i = 0u; i < BSP_I2C_MAX_INSTANCES; i++)
+    if (s_i2cModuleOfInstance[eInstance] != NULL)
     {
-        if (s_i2cModules[i].bAllocated && (s_i2cModules[i].eInstance == eInstance))
-        {
-            return BSP_I2C_INVALID_HANDLE;
-        }
+        return BSP_I2C_INVALID_HANDLE;
     }
 
     /* Find a free slot */
@@ -206,6 +598,12 @@ BspI2cHandle_t BspI2cAllocate(BspI2cInstance_e eInstance, BspI2cMode_e eMode, ui
             s_i2cModules[i].pMemTxCpltCb = NULL;
             s_i2cModules[i].pMemRxCpltCb = NULL;
             s_i2cModules[i].pErrorCb     = NULL;
+            s_i2cModules[i].pXferCb      = NULL;
+            s_i2cModules[i].pXferContext = NULL;
+            s_i2cModules[i].pXferToken   = NULL;
+            sBspI2cQueueReset(&s_i2cModules[i]);
+
+            s_i2cModuleOfInstance[eInstance] = &s_i2cModules[i];
 
             return (BspI2cHandle_t)i;
         }
@@ -224,6 +622,8 @@ BspI2cError_e BspI2cFree(BspI2cHandle_t handle)
     }
 
     /* Clear the module */
+    s_i2cModuleOfInstance[pModule->eInstance] = NULL;
+
     pModule->bAllocated   = false;
     pModule->eInstance    = eBSP_I2C_INSTANCE_1;
     pModule->pHalHandle   = NULL;
@@ -232,6 +632,10 @@ BspI2cError_e BspI2cFree(BspI2cHandle_t handle)
     pModule->pMemTxCpltCb = NULL;
     pModule->pMemRxCpltCb = NULL;
     pModule->pErrorCb     = NULL;
+    pModule->pXferCb      = NULL;
+    pModule->pXferContext = NULL;
+    pModule->pXferToken   = NULL;
+    sBspI2cQueueReset(pModule);
 
     return eBSP_I2C_ERR_NONE;
 }
@@ -460,18 +864,14 @@ BspI2cError_e BspI2cTransmitIT(BspI2cHandle_t handle, const BspI2cTransferConfig
         return eBSP_I2C_ERR_INVALID_PARAM;
     }
 
-    HAL_StatusTypeDef halStatus = HAL_I2C_Master_Transmit_IT(pModule->pHalHandle, pConfig->devAddr, pConfig->pData, pConfig->length);
-
-    if (halStatus == HAL_BUSY)
+    if (!sBspI2cArm(pModule, pConfig->pCallback, pConfig->pContext, pConfig->pToken))
     {
         return eBSP_I2C_ERR_BUSY;
     }
-    else if (halStatus != HAL_OK)
-    {
-        return eBSP_I2C_ERR_TRANSFER;
-    }
 
-    return eBSP_I2C_ERR_NONE;
+    HAL_StatusTypeDef halStatus = HAL_I2C_Master_Transmit_IT(pModule->pHalHandle, pConfig->devAddr, pConfig->pData, pConfig->length);
+
+    return sBspI2cStarted(pModule, halStatus);
 }
 
 BspI2cError_e BspI2cReceiveIT(BspI2cHandle_t handle, const BspI2cTransferConfig_t* pConfig)
@@ -493,18 +893,14 @@ BspI2cError_e BspI2cReceiveIT(BspI2cHandle_t handle, const BspI2cTransferConfig_
         return eBSP_I2C_ERR_INVALID_PARAM;
     }
 
-    HAL_StatusTypeDef halStatus = HAL_I2C_Master_Receive_IT(pModule->pHalHandle, pConfig->devAddr, pConfig->pData, pConfig->length);
-
-    if (halStatus == HAL_BUSY)
+    if (!sBspI2cArm(pModule, pConfig->pCallback, pConfig->pContext, pConfig->pToken))
     {
         return eBSP_I2C_ERR_BUSY;
     }
-    else if (halStatus != HAL_OK)
-    {
-        return eBSP_I2C_ERR_TRANSFER;
-    }
 
-    return eBSP_I2C_ERR_NONE;
+    HAL_StatusTypeDef halStatus = HAL_I2C_Master_Receive_IT(pModule->pHalHandle, pConfig->devAddr, pConfig->pData, pConfig->length);
+
+    return sBspI2cStarted(pModule, halStatus);
 }
 
 BspI2cError_e BspI2cMemReadIT(BspI2cHandle_t handle, const BspI2cMemConfig_t* pConfig)
@@ -526,19 +922,15 @@ BspI2cError_e BspI2cMemReadIT(BspI2cHandle_t handle, const BspI2cMemConfig_t* pC
         return eBSP_I2C_ERR_INVALID_PARAM;
     }
 
-    HAL_StatusTypeDef halStatus = HAL_I2C_Mem_Read_IT(pModule->pHalHandle, pConfig->devAddr, pConfig->memAddr,
-                                                      (uint16_t)pConfig->memAddrSize, pConfig->pData, pConfig->length);
-
-    if (halStatus == HAL_BUSY)
+    if (!sBspI2cArm(pModule, pConfig->pCallback, pConfig->pContext, pConfig->pToken))
     {
         return eBSP_I2C_ERR_BUSY;
     }
-    else if (halStatus != HAL_OK)
-    {
-        return eBSP_I2C_ERR_TRANSFER;
-    }
 
-    return eBSP_I2C_ERR_NONE;
+    HAL_StatusTypeDef halStatus = HAL_I2C_Mem_Read_IT(pModule->pHalHandle, pConfig->devAddr, pConfig->memAddr,
+                                                      (uint16_t)pConfig->memAddrSize, pConfig->pData, pConfig->length);
+
+    return sBspI2cStarted(pModule, halStatus);
 }
 
 BspI2cError_e BspI2cMemWriteIT(BspI2cHandle_t handle, const BspI2cMemConfig_t* pConfig)
@@ -560,18 +952,82 @@ BspI2cError_e BspI2cMemWriteIT(BspI2cHandle_t handle, const BspI2cMemConfig_t* p
         return eBSP_I2C_ERR_INVALID_PARAM;
     }
 
+    if (!sBspI2cArm(pModule, pConfig->pCallback, pConfig->pContext, pConfig->pToken))
+    {
+        return eBSP_I2C_ERR_BUSY;
+    }
+
     HAL_StatusTypeDef halStatus = HAL_I2C_Mem_Write_IT(pModule->pHalHandle, pConfig->devAddr, pConfig->memAddr,
                                                        (uint16_t)pConfig->memAddrSize, pConfig->pData, pConfig->length);
 
-    if (halStatus == HAL_BUSY)
+    return sBspI2cStarted(pModule, halStatus);
+}
+
+/* --- Interrupt Mode Transaction Queue --- */
+
+BspI2cError_e BspI2cQueueTransfer(BspI2cHandle_t handle, const BspI2cXfer_t* pXfer)
+{
+    BspI2cModule_t* pModule = sBspI2cValidateHandle(handle);
+
+    if (pModule == NULL)
     {
-        return eBSP_I2C_ERR_BUSY;
+        return eBSP_I2C_ERR_INVALID_HANDLE;
     }
-    else if (halStatus != HAL_OK)
+
+    if ((pXfer == NULL) || (pXfer->pData == NULL) || (pXfer->length == 0u))
     {
-        return eBSP_I2C_ERR_TRANSFER;
+        return eBSP_I2C_ERR_INVALID_PARAM;
+    }
+
+    if ((pXfer->eType >= eBSP_I2C_XFER_TYPE_COUNT) || (pXfer->ePriority >= eBSP_I2C_PRIORITY_COUNT))
+    {
+        return eBSP_I2C_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_I2C_MODE_INTERRUPT)
+    {
+        return eBSP_I2C_ERR_INVALID_PARAM;
+    }
+
+    return sBspI2cQueuePush(pModule, pXfer);
+}
+
+BspI2cError_e BspI2cGetQueueStats(BspI2cHandle_t handle, BspI2cQueueStats_t* pStats)
+{
+    BspI2cModule_t* pModule = sBspI2cValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_I2C_ERR_INVALID_HANDLE;
+    }
+
+    if (pStats == NULL)
+    {
+        return eBSP_I2C_ERR_INVALID_PARAM;
     }
 
+    __disable_irq();
+    *pStats           = pModule->tQueueStats;
+    pStats->byPending = pModule->byQueueCount;
+    __enable_irq();
+
+    return eBSP_I2C_ERR_NONE;
+}
+
+BspI2cError_e BspI2cResetQueueStats(BspI2cHandle_t handle)
+{
+    BspI2cModule_t* pModule = sBspI2cValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_I2C_ERR_INVALID_HANDLE;
+    }
+
+    __disable_irq();
+    pModule->tQueueStats             = (BspI2cQueueStats_t){0};
+    pModule->tQueueStats.byHighWater = pModule->byQueueCount;
+    __enable_irq();
+
     return eBSP_I2C_ERR_NONE;
 }
 
@@ -582,10 +1038,9 @@ void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef* hi2c)
 {
     BspI2cModule_t* pModule = sBspI2cFindModuleByHalHandle(hi2c);
 
-    if ((pModule != NULL) && (pModule->pTxCpltCb != NULL))
+    if (pModule != NULL)
     {
-        BspI2cHandle_t handle = (BspI2cHandle_t)(pModule - s_i2cModules);
-        pModule->pTxCpltCb(handle);
+        sBspI2cOnDone(pModule, pModule->pTxCpltCb);
     }
 }
 
@@ -594,10 +1049,9 @@ void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef* hi2c)
 {
     BspI2cModule_t* pModule = sBspI2cFindModuleByHalHandle(hi2c);
 
-    if ((pModule != NULL) && (pModule->pRxCpltCb != NULL))
+    if (pModule != NULL)
     {
-        BspI2cHandle_t handle = (BspI2cHandle_t)(pModule - s_i2cModules);
-        pModule->pRxCpltCb(handle);
+        sBspI2cOnDone(pModule, pModule->pRxCpltCb);
     }
 }
 
@@ -606,10 +1060,9 @@ void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c)
 {
     BspI2cModule_t* pModule = sBspI2cFindModuleByHalHandle(hi2c);
 
-    if ((pModule != NULL) && (pModule->pMemTxCpltCb != NULL))
+    if (pModule != NULL)
     {
-        BspI2cHandle_t handle = (BspI2cHandle_t)(pModule - s_i2cModules);
-        pModule->pMemTxCpltCb(handle);
+        sBspI2cOnDone(pModule, pModule->pMemTxCpltCb);
     }
 }
 
@@ -618,10 +1071,9 @@ void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c)
 {
     BspI2cModule_t* pModule = sBspI2cFindModuleByHalHandle(hi2c);
 
-    if ((pModule != NULL) && (pModule->pMemRxCpltCb != NULL))
+    if (pModule != NULL)
     {
-        BspI2cHandle_t handle = (BspI2cHandle_t)(pModule - s_i2cModules);
-        pModule->pMemRxCpltCb(handle);
+        sBspI2cOnDone(pModule, pModule->pMemRxCpltCb);
     }
 }
 
@@ -630,9 +1082,8 @@ void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c)
 {
     BspI2cModule_t* pModule = sBspI2cFindModuleByHalHandle(hi2c);
 
-    if ((pModule != NULL) && (pModule->pErrorCb != NULL))
+    if (pModule != NULL)
     {
-        BspI2cHandle_t handle = (BspI2cHandle_t)(pModule - s_i2cModules);
-        pModule->pErrorCb(handle, eBSP_I2C_ERR_TRANSFER);
+        sBspI2cOnError(pModule);
     }
 }
@@ -8,9 +8,24 @@ extern "C"
 {
 #endif
 
+#include "bsp_xfer.h"
 #include <stdbool.h>
 #include <stdint.h>
 
+/* --- Configuration --- */
+
+/**
+ * Depth of the per-instance interrupt mode transaction queue.
+ * Memory impact: BSP_I2C_QUEUE_DEPTH x 36 bytes per I2C instance.
+ */
+#ifndef BSP_I2C_QUEUE_DEPTH
+    #define BSP_I2C_QUEUE_DEPTH (8u)
+#endif
+
+#if (BSP_I2C_QUEUE_DEPTH < 1u) || (BSP_I2C_QUEUE_DEPTH > 255u)
+    #error "BSP_I2C_QUEUE_DEPTH must be between 1 and 255"
+#endif
+
 /* --- Type Definitions --- */
 
 /**
@@ -69,9 +84,20 @@ typedef enum
     eBSP_I2C_MEM_ADDR_SIZE_16BIT = 2u  /**< 16-bit memory address */
 } BspI2cMemAddrSize_e;
 
+/**
+ * Callback type for the completion of one interrupt mode transfer.
+ * Set per call in the transfer configuration; replaces the registered callbacks for that transfer.
+ *
+ * @param handle The I2C handle that completed the transfer
+ * @param eError eBSP_I2C_ERR_NONE on success, eBSP_I2C_ERR_TRANSFER on failure
+ * @param pContext Context pointer from the transfer configuration
+ */
+typedef void (*BspI2cXferCb_t)(BspI2cHandle_t handle, BspI2cError_e eError, void* pContext);
+
 /**
  * I2C transfer configuration structure.
  * Used for basic I2C transmit and receive operations.
+ * pCallback, pContext and pToken apply to interrupt mode calls and are ignored in blocking mode.
  *
  * Example usage:
  * @code
@@ -84,14 +110,18 @@ typedef enum
  */
 typedef struct
 {
-    uint8_t  devAddr; /**< I2C device address */
-    uint8_t* pData;   /**< Pointer to data buffer */
-    uint16_t length;  /**< Number of bytes to transfer */
+    uint8_t         devAddr;   /**< I2C device address */
+    uint8_t*        pData;     /**< Pointer to data buffer */
+    uint16_t        length;    /**< Number of bytes to transfer */
+    BspI2cXferCb_t  pCallback; /**< Completion callback for this transfer, NULL to use the registered callbacks */
+    void*           pContext;  /**< Passed to pCallback */
+    BspXferToken_t* pToken;    /**< Completion token (caller-owned), may be NULL */
 } BspI2cTransferConfig_t;
 
 /**
  * I2C memory transfer configuration structure.
  * Used for I2C memory read and write operations.
+ * pCallback, pContext and pToken apply to interrupt mode calls and are ignored in blocking mode.
  *
  * Example usage:
  * @code
@@ -111,8 +141,68 @@ typedef struct
     BspI2cMemAddrSize_e memAddrSize; /**< Size of the memory address */
     uint8_t*            pData;       /**< Pointer to data buffer */
     uint16_t            length;      /**< Number of bytes to transfer */
+    BspI2cXferCb_t      pCallback;   /**< Completion callback for this transfer, NULL to use the registered callbacks */
+    void*               pContext;    /**< Passed to pCallback */
+    BspXferToken_t*     pToken;      /**< Completion token (caller-owned), may be NULL */
 } BspI2cMemConfig_t;
 
+/**
+ * Queued transaction type.
+ */
+typedef enum
+{
+    eBSP_I2C_XFER_WRITE = 0u, /**< Master transmit */
+    eBSP_I2C_XFER_READ,       /**< Master receive */
+    eBSP_I2C_XFER_MEM_WRITE,  /**< Memory write (register address, then data) */
+    eBSP_I2C_XFER_MEM_READ,   /**< Memory read (register address, repeated start, data) */
+    eBSP_I2C_XFER_TYPE_COUNT
+} BspI2cXferType_e;
+
+/**
+ * Queued transaction priority.
+ * Higher priorities start first; equal priorities start in queue order.
+ */
+typedef enum
+{
+    eBSP_I2C_PRIORITY_LOW = 0u, /**< Background transfers (e.g. EEPROM logging) */
+    eBSP_I2C_PRIORITY_NORMAL,   /**< Periodic sensor reads */
+    eBSP_I2C_PRIORITY_HIGH,     /**< Latency-critical transfers */
+    eBSP_I2C_PRIORITY_COUNT
+} BspI2cPriority_e;
+
+/**
+ * Queued transaction descriptor.
+ * The descriptor is copied when queued; the data buffer must remain valid until the callback.
+ * memAddr and memAddrSize are used by memory transfers only.
+ * pToken, if set, is armed when the transaction is queued and completed with the
+ * result before the callback runs, so it can be polled with BspXferIsDone().
+ */
+typedef struct
+{
+    BspI2cXferType_e    eType;       /**< Transaction type */
+    BspI2cPriority_e    ePriority;   /**< Start priority */
+    uint8_t             devAddr;     /**< I2C device address */
+    uint16_t            memAddr;     /**< Memory address within the I2C device */
+    BspI2cMemAddrSize_e memAddrSize; /**< Size of the memory address */
+    uint8_t*            pData;       /**< Pointer to data buffer */
+    uint16_t            length;      /**< Number of bytes to transfer (> 0) */
+    BspI2cXferCb_t      pCallback;   /**< Completion callback, may be NULL */
+    void*               pContext;    /**< Passed to pCallback */
+    BspXferToken_t*     pToken;      /**< Completion token (caller-owned), may be NULL */
+} BspI2cXfer_t;
+
+/**
+ * Transaction queue statistics.
+ */
+typedef struct
+{
+    uint8_t  byPending;   /**< Transactions queued, including the one in flight */
+    uint8_t  byHighWater; /**< Maximum of byPending since allocation or last reset */
+    uint32_t uCompleted;  /**< Queued transactions completed successfully */
+    uint32_t uErrors;     /**< Queued transactions failed to start or ended with an error */
+    uint32_t uRejected;   /**< Transactions rejected because the queue was full */
+} BspI2cQueueStats_t;
+
 /**
  * Callback type for I2C transmit completion.
  * Called when an interrupt mode transmit operation completes successfully.
@@ -259,46 +349,90 @@ BspI2cError_e BspI2cMemWrite(BspI2cHandle_t handle, const BspI2cMemConfig_t* pCo
 
 /* --- Interrupt Mode Functions --- */
 
+/*
+ * Completion of an interrupt mode transfer goes to pCallback of its configuration
+ * with pContext, or to the registered callback of the transfer type if pCallback
+ * is NULL. pToken is armed when the transfer is started and completed before the
+ * callback runs; it is meaningful only if the call returned eBSP_I2C_ERR_NONE.
+ * The configuration itself is copied and need not stay valid, the data buffer must.
+ */
+
 /**
  * Transmits data using interrupt mode.
- * Completion is signaled via the registered transmit callback.
+ * Completion is signaled via pConfig->pCallback or the registered transmit callback.
  *
  * @param handle The I2C handle
- * @param pConfig Pointer to the transfer configuration (must remain valid until callback)
+ * @param pConfig Pointer to the transfer configuration (data buffer must remain valid until completion)
  * @return Error code indicating success or failure
  */
 BspI2cError_e BspI2cTransmitIT(BspI2cHandle_t handle, const BspI2cTransferConfig_t* pConfig);
 
 /**
  * Receives data using interrupt mode.
- * Completion is signaled via the registered receive callback.
+ * Completion is signaled via pConfig->pCallback or the registered receive callback.
  *
  * @param handle The I2C handle
- * @param pConfig Pointer to the transfer configuration (must remain valid until callback)
+ * @param pConfig Pointer to the transfer configuration (data buffer must remain valid until completion)
  * @return Error code indicating success or failure
  */
 BspI2cError_e BspI2cReceiveIT(BspI2cHandle_t handle, const BspI2cTransferConfig_t* pConfig);
 
 /**
  * Reads data from an I2C memory device using interrupt mode.
- * Completion is signaled via the registered memory receive callback.
+ * Completion is signaled via pConfig->pCallback or the registered memory receive callback.
  *
  * @param handle The I2C handle
- * @param pConfig Pointer to the memory transfer configuration (must remain valid until callback)
+ * @param pConfig Pointer to the memory transfer configuration (data buffer must remain valid until completion)
  * @return Error code indicating success or failure
  */
 BspI2cError_e BspI2cMemReadIT(BspI2cHandle_t handle, const BspI2cMemConfig_t* pConfig);
 
 /**
  * Writes data to an I2C memory device using interrupt mode.
- * Completion is signaled via the registered memory transmit callback.
+ * Completion is signaled via pConfig->pCallback or the registered memory transmit callback.
  *
  * @param handle The I2C handle
- * @param pConfig Pointer to the memory transfer configuration (must remain valid until callback)
+ * @param pConfig Pointer to the memory transfer configuration (data buffer must remain valid until completion)
  * @return Error code indicating success or failure
  */
 BspI2cError_e BspI2cMemWriteIT(BspI2cHandle_t handle, const BspI2cMemConfig_t* pConfig);
 
+/* --- Interrupt Mode Transaction Queue --- */
+
+/**
+ * Queues a transaction on the bus.
+ * Starts immediately if the bus is idle; otherwise the transaction is started
+ * from the completion or error interrupt of the previous one, so transactions
+ * to several devices run back to back without polling. Pending transactions
+ * start by priority, then in queue order; the one in flight is never preempted.
+ * While queued transactions are pending, the direct interrupt mode functions
+ * return eBSP_I2C_ERR_BUSY.
+ * Start failures are reported through the descriptor callback.
+ * May be called from thread context or from a completion callback.
+ *
+ * @param handle The I2C handle (interrupt mode)
+ * @param pXfer Transaction descriptor (copied)
+ * @return Error code; eBSP_I2C_ERR_BUSY if the queue is full
+ */
+BspI2cError_e BspI2cQueueTransfer(BspI2cHandle_t handle, const BspI2cXfer_t* pXfer);
+
+/**
+ * Gets transaction queue depth, high-water mark and counters.
+ *
+ * @param handle The I2C handle
+ * @param pStats Output: queue statistics
+ * @return Error code indicating success or failure
+ */
+BspI2cError_e BspI2cGetQueueStats(BspI2cHandle_t handle, BspI2cQueueStats_t* pStats);
+
+/**
+ * Resets the queue counters; the high-water mark restarts at the current depth.
+ *
+ * @param handle The I2C handle
+ * @return Error code indicating success or failure
+ */
+BspI2cError_e BspI2cResetQueueStats(BspI2cHandle_t handle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,1457 @@
+/**
+ * @file bsp_sdspi.c
+ * @brief SD card block driver implementation (SPI mode)
+ *
+ * Every bus access is a bsp_spi device transfer chained from the previous
+ * completion callback. A command goes out as one full-duplex frame that also
+ * clocks the whole response window (NCR), so each command costs a single
+ * transfer. Chip select is held (bHoldCs) from the command to the last byte
+ * the card sends; only a programming card may be deselected:
+ *
+ *   read:  CMD17/18 -> token polls -> data DMA -> token polls -> ... -> CMD12 or CRC
+ *   write: CMD24/25 -> token + data + CRC + data response -> busy polls -> ... -> stop token
+ *
+ * Bytes that follow a response inside the same frame or poll are parsed, not
+ * thrown away: a data token and the first data bytes may arrive with R1.
+ * The device is added with bDeselectClock because the card keeps driving MISO
+ * until it sees a clock with chip select high.
+ */
+
+#include "bsp_sdspi.h"
+#include "bsp_compiler_attributes.h"
+#include "bsp_swtimer.h"
+#include "stm32f4xx_hal.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================================================
+ * Private Constants
+ * ========================================================================== */
+
+#define SDSPI_CMD_GO_IDLE      (0u)  /**< Reset, enter SPI mode */
+#define SDSPI_CMD_SEND_IF_COND (8u)  /**< Voltage check (version 2.0+) */
+#define SDSPI_CMD_SEND_CSD     (9u)  /**< Card specific data */
+#define SDSPI_CMD_STOP         (12u) /**< End a multi-block read */
+#define SDSPI_CMD_SET_BLOCKLEN (16u) /**< Block length (SDSC) */
+#define SDSPI_CMD_READ_SINGLE  (17u) /**< Read one block */
+#define SDSPI_CMD_READ_MULTI   (18u) /**< Read blocks until CMD12 */
+#define SDSPI_CMD_WRITE_SINGLE (24u) /**< Write one block */
+#define SDSPI_CMD_WRITE_MULTI  (25u) /**< Write blocks until the stop token */
+#define SDSPI_CMD_APP          (55u) /**< Next command is application specific */
+#define SDSPI_CMD_READ_OCR     (58u) /**< Operating conditions register */
+#define SDSPI_ACMD_OP_COND     (41u) /**< Start initialisation */
+
+#define SDSPI_R1_IDLE    (0x01u) /**< R1: in idle state */
+#define SDSPI_R1_ILLEGAL (0x04u) /**< R1: illegal command */
+
+#define SDSPI_TOKEN_START       (0xFEu) /**< Read blocks and single-block write */
+#define SDSPI_TOKEN_START_MULTI (0xFCu) /**< Multi-block write */
+#define SDSPI_TOKEN_STOP        (0xFDu) /**< End of a multi-block write */
+#define SDSPI_DATA_RESP_MASK    (0x1Fu)
+#define SDSPI_DATA_ACCEPTED     (0x05u)
+
+#define SDSPI_IF_COND_ARG (0x1AAu)      /**< 2.7-3.6 V, check pattern 0xAA */
+#define SDSPI_OCR_HCS     (0x40000000u) /**< Host supports high capacity */
+#define SDSPI_OCR_READY   (0x80u)       /**< OCR byte 0: power-up done */
+#define SDSPI_OCR_CCS     (0x40u)       /**< OCR byte 0: high capacity card */
+
+#define SDSPI_CMD_LEN         (6u)                     /**< Command, argument and CRC */
+#define SDSPI_R1_WINDOW       (9u)                     /**< R1 follows after 0..8 bytes (NCR) */
+#define SDSPI_R1_FRAME        (SDSPI_CMD_LEN + SDSPI_R1_WINDOW)
+#define SDSPI_R7_FRAME        (SDSPI_R1_FRAME + 4u)    /**< R1 and a 32-bit payload (R3, R7) */
+#define SDSPI_PEEK_LEN        (4u)                     /**< Bytes read after a response to see the busy flag */
+#define SDSPI_POLL_LEN        (16u)                    /**< Bytes per token or busy poll */
+#define SDSPI_WRITE_TAIL      (2u + 1u + SDSPI_PEEK_LEN) /**< CRC, data response, busy peek */
+#define SDSPI_FRAME_LEN       (32u)
+#define SDSPI_CRC_LEN         (2u)
+#define SDSPI_CSD_LEN         (16u)
+#define SDSPI_GO_IDLE_TRIES   (8u)
+#define SDSPI_POWER_UP_CLOCKS (10u) /**< Bytes clocked with the card deselected (at least 74 clocks) */
+
+/** Byte index in abyWin meaning "no response" */
+#define SDSPI_NO_R1 (SDSPI_FRAME_LEN)
+
+/* ============================================================================
+ * Private Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Operation in progress.
+ */
+typedef enum
+{
+    eSDSPI_OP_IDLE = 0u,
+    eSDSPI_OP_INIT,
+    eSDSPI_OP_READ,
+    eSDSPI_OP_WRITE
+} BspSdSpiOp_e;
+
+/**
+ * @brief Card instance.
+ *
+ * The operation fields are set by the API call that starts an operation and
+ * owned by the interrupt callbacks until it completes.
+ */
+typedef struct
+{
+    BspSdSpiConfig_t      tConfig;
+    bool                  bAllocated;
+    bool                  bReady; /**< Initialised, tInfo valid */
+    BspSpiDeviceHandle_t  hDevice;
+    BspSpiPrescaler_e     eClock; /**< Prescaler the device was added with */
+    SWTimerModule         tTimer; /**< One-shot ACMD41 and busy poll timer */
+    BspSdSpiInfo_t        tInfo;
+    volatile BspSdSpiOp_e eOp;
+    BspSdSpiCb_t          pCb;
+    void*                 pContext;
+    BspSdSpiError_e       eResult;    /**< First error of the operation, reported once the card is released */
+    uint8_t*              pRxData;    /**< Current read block */
+    const uint8_t*        pTxData;    /**< Next write block */
+    uint32_t              uCount;     /**< Blocks left */
+    uint32_t              uBlockLen;  /**< Bytes per read block (CSD: 16) */
+    uint32_t              uBlockPos;  /**< Bytes of the current read block received */
+    uint32_t              uFrameLen;  /**< Length of the frame in abyCmd */
+    uint32_t              uStepTick;  /**< HAL tick when the current wait started */
+    uint32_t              uSpinLeft;  /**< Busy burst bytes left before the timer takes over */
+    uint8_t               bySkip;     /**< CRC bytes still owed by the card */
+    uint8_t               byTries;    /**< CMD0 attempts */
+    bool                  bToken;     /**< Data token of the current read block seen */
+    bool                  bMulti;     /**< CMD18/CMD25: needs CMD12 or the stop token */
+    bool                  bHeld;      /**< Last transfer kept chip select asserted */
+    bool                  bBusy;      /**< Waiting for the card to finish programming */
+    bool                  bStopSent;  /**< Stop token sent */
+    uint8_t               abyCmd[SDSPI_FRAME_LEN];
+    uint8_t               abyWin[SDSPI_FRAME_LEN]; /**< Bytes received with the frame or poll */
+    uint8_t               abyToken[2];             /**< Gap byte and start token of a write block */
+    uint8_t               abyCsd[SDSPI_CSD_LEN];
+    BspSpiSegment_t       atSeg[3];
+    BspSdSpiStats_t       tStats;
+} BspSdSpi_t;
+
+/* ============================================================================
+ * Private Global Variables
+ * ========================================================================== */
+
+/** Card instance array */
+FORCE_STATIC BspSdSpi_t s_aSdSpi[BSP_SDSPI_MAX_INSTANCES] = {0};
+
+/** Transmit bytes for the write tail: MOSI high while the card answers */
+FORCE_STATIC const uint8_t s_abyOnes[SDSPI_WRITE_TAIL] = {0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+
+/** Stop token, stuff byte, busy peek */
+FORCE_STATIC const uint8_t s_abyStop[2u + SDSPI_PEEK_LEN] = {SDSPI_TOKEN_STOP, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+
+/* ============================================================================
+ * Private Function Prototypes
+ * ========================================================================== */
+
+FORCE_STATIC void sSdSpiTimerCallback0(void);
+#if (BSP_SDSPI_MAX_INSTANCES > 1u)
+FORCE_STATIC void sSdSpiTimerCallback1(void);
+#endif
+
+/**
+ * @brief Poll timer callbacks, one per instance.
+ */
+FORCE_STATIC SWTimerCallbackFunction const s_apfnTimerCallbacks[BSP_SDSPI_MAX_INSTANCES] = {
+    sSdSpiTimerCallback0,
+#if (BSP_SDSPI_MAX_INSTANCES > 1u)
+    sSdSpiTimerCallback1,
+#endif
+};
+
+FORCE_STATIC void sSdSpiEnd(BspSdSpi_t* pSd, BspSdSpiError_e eError);
+FORCE_STATIC void sSdSpiBusyPoll(BspSdSpi_t* pSd);
+
+/* ============================================================================
+ * Private Functions
+ * ========================================================================== */
+
+/**
+ * @brief Validate handle and return instance pointer.
+ */
+FORCE_STATIC BspSdSpi_t* sSdSpiValidateHandle(BspSdSpiHandle_t handle)
+{
+    if ((handle < 0) || (handle >= (BspSdSpiHandle_t)BSP_SDSPI_MAX_INSTANCES))
+    {
+        return NULL;
+    }
+
+    if (!s_aSdSpi[handle].bAllocated)
+    {
+        return NULL;
+    }
+
+    return &s_aSdSpi[handle];
+}
+
+/**
+ * @brief Check that a block transfer may start: idle, initialised, blocks on the card.
+ */
+FORCE_STATIC BspSdSpiError_e sSdSpiCheckRequest(const BspSdSpi_t* pSd, uint32_t uBlock, const void* pData, uint32_t uCount)
+{
+    if ((pData == NULL) || (uCount == 0u))
+    {
+        return eBSP_SDSPI_ERR_INVALID_PARAM;
+    }
+
+    if (pSd->eOp != eSDSPI_OP_IDLE)
+    {
+        return eBSP_SDSPI_ERR_BUSY;
+    }
+
+    if (!pSd->bReady)
+    {
+        return eBSP_SDSPI_ERR_NO_CARD;
+    }
+
+    if ((uBlock >= pSd->tInfo.uBlocks) || (uCount > (pSd->tInfo.uBlocks - uBlock)))
+    {
+        return eBSP_SDSPI_ERR_INVALID_PARAM;
+    }
+
+    return eBSP_SDSPI_ERR_NONE;
+}
+
+/**
+ * @brief End the operation and report the result.
+ */
+FORCE_STATIC void sSdSpiFinish(BspSdSpi_t* pSd, BspSdSpiError_e eError)
+{
+    BspSdSpiCb_t pCb      = pSd->pCb;
+    void*        pContext = pSd->pContext;
+
+    pSd->eOp   = eSDSPI_OP_IDLE;
+    pSd->bBusy = false;
+
+    if (pCb != NULL)
+    {
+        pCb((BspSdSpiHandle_t)(pSd - s_aSdSpi), eError, pContext);
+    }
+}
+
+/**
+ * @brief (Re-)add the bus device with a prescaler. Removing the device also
+ * releases a chip select it holds.
+ */
+FORCE_STATIC bool sSdSpiSetClock(BspSdSpi_t* pSd, BspSpiPrescaler_e ePrescaler)
+{
+    BspSpiDeviceConfig_t tDevice = {0};
+    tDevice.hBus                 = pSd->tConfig.hBus;
+    tDevice.uCsPin               = pSd->tConfig.uCsPin;
+    tDevice.eClockMode           = eBSP_SPI_CLOCK_MODE_0;
+    tDevice.ePrescaler           = ePrescaler;
+    tDevice.bDeselectClock       = true;
+
+    if ((pSd->hDevice >= 0) && (BspSpiDeviceRemove(pSd->hDevice) != eBSP_SPI_ERR_NONE))
+    {
+        return false;
+    }
+
+    pSd->hDevice = BspSpiDeviceAdd(&tDevice);
+    pSd->eClock  = ePrescaler;
+    pSd->bHeld   = false;
+
+    return pSd->hDevice >= 0;
+}
+
+/**
+ * @brief Bus queue full in the middle of an operation: release the card and
+ * end with eBSP_SDSPI_ERR_BUSY.
+ */
+FORCE_STATIC void sSdSpiAbort(BspSdSpi_t* pSd)
+{
+    (void)sSdSpiSetClock(pSd, pSd->eClock);
+    sSdSpiFinish(pSd, eBSP_SDSPI_ERR_BUSY);
+}
+
+/**
+ * @brief A transfer failed: bsp_spi has released chip select.
+ */
+FORCE_STATIC void sSdSpiSpiError(BspSdSpi_t* pSd)
+{
+    pSd->bHeld = false;
+    sSdSpiFinish(pSd, eBSP_SDSPI_ERR_SPI);
+}
+
+/**
+ * @brief Queue a transfer to the card. Without transmit data the card sees ones (MOSI high).
+ */
+FORCE_STATIC bool sSdSpiQueue(BspSdSpi_t* pSd, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength, bool bHold,
+                              BspSpiXferCb_t pCallback)
+{
+    BspSpiXfer_t tXfer = {0};
+
+    tXfer.pTxData      = pTxData;
+    tXfer.pRxData      = pRxData;
+    tXfer.uLength      = uLength;
+    tXfer.bFill        = (pTxData == NULL);
+    tXfer.uFillPattern = 0xFFu;
+    tXfer.bHoldCs      = bHold;
+    tXfer.pCallback    = pCallback;
+    tXfer.pContext     = pSd;
+
+    if (BspSpiDeviceQueueTransfer(pSd->hDevice, &tXfer) != eBSP_SPI_ERR_NONE)
+    {
+        return false;
+    }
+
+    pSd->bHeld = bHold;
+    return true;
+}
+
+/**
+ * @brief Write a command at uOffset of abyCmd. The rest of the frame is ones.
+ */
+FORCE_STATIC void sSdSpiSetCmd(BspSdSpi_t* pSd, uint32_t uOffset, uint8_t byCmd, uint32_t uArg)
+{
+    uint8_t* pCmd = &pSd->abyCmd[uOffset];
+
+    pCmd[0] = (uint8_t)(0x40u | byCmd);
+    pCmd[1] = (uint8_t)(uArg >> 24u);
+    pCmd[2] = (uint8_t)(uArg >> 16u);
+    pCmd[3] = (uint8_t)(uArg >> 8u);
+    pCmd[4] = (uint8_t)uArg;
+
+    /* The CRC is only checked for CMD0 and CMD8 in SPI mode */
+    if (byCmd == SDSPI_CMD_GO_IDLE)
+    {
+        pCmd[5] = 0x95u;
+    }
+    else if (byCmd == SDSPI_CMD_SEND_IF_COND)
+    {
+        pCmd[5] = 0x87u;
+    }
+    else
+    {
+        pCmd[5] = 0x01u;
+    }
+
+    pSd->tStats.uCommands++;
+}
+
+/**
+ * @brief Queue a single command frame with its response window.
+ */
+FORCE_STATIC bool sSdSpiCommand(BspSdSpi_t* pSd, uint8_t byCmd, uint32_t uArg, uint32_t uFrameLen, bool bHold, BspSpiXferCb_t pCallback)
+{
+    (void)memset(pSd->abyCmd, 0xFF, sizeof(pSd->abyCmd));
+    sSdSpiSetCmd(pSd, 0u, byCmd, uArg);
+    pSd->uFrameLen = uFrameLen;
+
+    return sSdSpiQueue(pSd, pSd->abyCmd, pSd->abyWin, uFrameLen, bHold, pCallback);
+}
+
+/**
+ * @brief Find R1 (first byte with bit 7 clear) in the response window starting at uFrom.
+ *
+ * @return Index in abyWin, SDSPI_NO_R1 if the card did not answer
+ */
+FORCE_STATIC uint32_t sSdSpiFindR1(const BspSdSpi_t* pSd, uint32_t uFrom)
+{
+    for (uint32_t i = uFrom; (i < (uFrom + SDSPI_R1_WINDOW)) && (i < pSd->uFrameLen); i++)
+    {
+        if ((pSd->abyWin[i] & 0x80u) == 0u)
+        {
+            return i;
+        }
+    }
+
+    return SDSPI_NO_R1;
+}
+
+/**
+ * @brief Card capacity in 512-byte blocks from the CSD (version 1 or 2), 0 if unknown.
+ */
+FORCE_STATIC uint32_t sSdSpiCsdBlocks(const uint8_t* pCsd)
+{
+    if ((pCsd[0] >> 6u) == 1u)
+    {
+        uint32_t uSize = (((uint32_t)pCsd[7] & 0x3Fu) << 16u) | ((uint32_t)pCsd[8] << 8u) | pCsd[9];
+        return (uSize + 1u) * 1024u;
+    }
+
+    if ((pCsd[0] >> 6u) == 0u)
+    {
+        uint32_t uReadBlLen = pCsd[5] & 0x0Fu;
+        uint32_t uSize      = (((uint32_t)pCsd[6] & 0x03u) << 10u) | ((uint32_t)pCsd[7] << 2u) | ((uint32_t)pCsd[8] >> 6u);
+        uint32_t uMult      = (((uint32_t)pCsd[9] & 0x03u) << 1u) | ((uint32_t)pCsd[10] >> 7u);
+
+        if ((uReadBlLen >= 9u) && (uReadBlLen <= 11u))
+        {
+            return (uSize + 1u) << (uMult + 2u + uReadBlLen - 9u);
+        }
+    }
+
+    return 0u;
+}
+
+/* --- Reads --------------------------------------------------------------- */
+
+/**
+ * @brief A read block is complete: the card sends its CRC next.
+ */
+FORCE_STATIC void sSdSpiBlockDone(BspSdSpi_t* pSd)
+{
+    pSd->pRxData += pSd->uBlockLen;
+    pSd->uBlockPos = 0u;
+    pSd->bToken    = false;
+    pSd->bySkip    = SDSPI_CRC_LEN;
+    pSd->uStepTick = HAL_GetTick();
+    pSd->uCount--;
+
+    if (pSd->eOp == eSDSPI_OP_READ)
+    {
+        pSd->tStats.uReadBlocks++;
+    }
+}
+
+/**
+ * @brief Consume received read bytes: CRC of the previous block, gap, data token and data.
+ *
+ * @return eBSP_SDSPI_ERR_CARD on a data error token
+ */
+FORCE_STATIC BspSdSpiError_e sSdSpiParse(BspSdSpi_t* pSd, const uint8_t* pBytes, uint32_t uLength)
+{
+    for (uint32_t i = 0u; (i < uLength) && (pSd->uCount > 0u); i++)
+    {
+        if (pSd->bySkip > 0u)
+        {
+            pSd->bySkip--;
+        }
+        else if (pSd->bToken)
+        {
+            pSd->pRxData[pSd->uBlockPos++] = pBytes[i];
+
+            if (pSd->uBlockPos == pSd->uBlockLen)
+            {
+                sSdSpiBlockDone(pSd);
+            }
+        }
+        else if (pBytes[i] == SDSPI_TOKEN_START)
+        {
+            pSd->bToken = true;
+        }
+        else if (pBytes[i] != 0xFFu)
+        {
+            return eBSP_SDSPI_ERR_CARD;
+        }
+        else
+        {
+            /* Card still preparing the block (NAC) */
+        }
+    }
+
+    return eBSP_SDSPI_ERR_NONE;
+}
+
+FORCE_STATIC void sSdSpiOnStopRead(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+FORCE_STATIC void sSdSpiOnReadPoll(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+FORCE_STATIC void sSdSpiOnReadData(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+
+/**
+ * @brief End a read: CMD12 for CMD18, otherwise release after the last CRC.
+ */
+FORCE_STATIC void sSdSpiStopRead(BspSdSpi_t* pSd, BspSdSpiError_e eError)
+{
+    if (!pSd->bMulti)
+    {
+        sSdSpiEnd(pSd, eError);
+        return;
+    }
+
+    if (pSd->eResult == eBSP_SDSPI_ERR_NONE)
+    {
+        pSd->eResult = eError;
+    }
+
+    /* Clock out the CRC still owed, then CMD12; R1 comes after one stuff byte */
+    (void)memset(pSd->abyCmd, 0xFF, sizeof(pSd->abyCmd));
+    sSdSpiSetCmd(pSd, pSd->bySkip, SDSPI_CMD_STOP, 0u);
+    pSd->uFrameLen = pSd->bySkip + SDSPI_CMD_LEN + 1u + SDSPI_R1_WINDOW + SDSPI_PEEK_LEN;
+    pSd->bySkip    = 0u;
+    pSd->bMulti    = false;
+
+    if (!sSdSpiQueue(pSd, pSd->abyCmd, pSd->abyWin, pSd->uFrameLen, false, sSdSpiOnStopRead))
+    {
+        sSdSpiAbort(pSd);
+    }
+}
+
+/**
+ * @brief Next read transfer: rest of the block by DMA, another token poll, or the end.
+ */
+FORCE_STATIC void sSdSpiContinueRead(BspSdSpi_t* pSd, BspSdSpiError_e eError)
+{
+    bool bQueued;
+
+    if ((eError != eBSP_SDSPI_ERR_NONE) || (pSd->uCount == 0u))
+    {
+        sSdSpiStopRead(pSd, eError);
+        return;
+    }
+
+    if (pSd->bToken)
+    {
+        bQueued = sSdSpiQueue(pSd, NULL, &pSd->pRxData[pSd->uBlockPos], pSd->uBlockLen - pSd->uBlockPos, true, sSdSpiOnReadData);
+    }
+    else if ((HAL_GetTick() - pSd->uStepTick) >= BSP_SDSPI_READ_TIMEOUT_MS)
+    {
+        sSdSpiStopRead(pSd, eBSP_SDSPI_ERR_TIMEOUT);
+        return;
+    }
+    else
+    {
+        pSd->tStats.uTokenPolls++;
+        bQueued = sSdSpiQueue(pSd, NULL, pSd->abyWin, SDSPI_POLL_LEN, true, sSdSpiOnReadPoll);
+    }
+
+    if (!bQueued)
+    {
+        sSdSpiAbort(pSd);
+    }
+}
+
+/**
+ * @brief CMD17/CMD18/CMD9 frame completion: check R1, parse what followed it.
+ */
+FORCE_STATIC void sSdSpiOnReadCmd(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    uint32_t uR1 = sSdSpiFindR1(pSd, SDSPI_CMD_LEN);
+
+    /* A rejected command starts no transfer: no CMD12 needed */
+    if ((uR1 == SDSPI_NO_R1) || (pSd->abyWin[uR1] != 0u))
+    {
+        pSd->bMulti = false;
+        sSdSpiEnd(pSd, (uR1 == SDSPI_NO_R1) ? eBSP_SDSPI_ERR_TIMEOUT : eBSP_SDSPI_ERR_CARD);
+        return;
+    }
+
+    sSdSpiContinueRead(pSd, sSdSpiParse(pSd, &pSd->abyWin[uR1 + 1u], pSd->uFrameLen - uR1 - 1u));
+}
+
+/**
+ * @brief Token poll completion.
+ */
+FORCE_STATIC void sSdSpiOnReadPoll(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    sSdSpiContinueRead(pSd, sSdSpiParse(pSd, pSd->abyWin, SDSPI_POLL_LEN));
+}
+
+/**
+ * @brief Block data DMA completion.
+ */
+FORCE_STATIC void sSdSpiOnReadData(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    sSdSpiBlockDone(pSd);
+    sSdSpiContinueRead(pSd, eBSP_SDSPI_ERR_NONE);
+}
+
+/**
+ * @brief Start a read command; data lands in pDest in blocks of uBlockLen bytes.
+ */
+FORCE_STATIC bool sSdSpiStartRead(BspSdSpi_t* pSd, uint8_t byCmd, uint32_t uArg, uint8_t* pDest, uint32_t uBlockLen, uint32_t uCount)
+{
+    pSd->pRxData   = pDest;
+    pSd->uBlockLen = uBlockLen;
+    pSd->uBlockPos = 0u;
+    pSd->uCount    = uCount;
+    pSd->bToken    = false;
+    pSd->bySkip    = 0u;
+    pSd->bMulti    = (byCmd == SDSPI_CMD_READ_MULTI);
+    pSd->uStepTick = HAL_GetTick();
+
+    return sSdSpiCommand(pSd, byCmd, uArg, SDSPI_R1_FRAME, true, sSdSpiOnReadCmd);
+}
+
+/* --- Writes and busy wait ------------------------------------------------ */
+
+FORCE_STATIC void sSdSpiOnWriteBlock(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+FORCE_STATIC void sSdSpiOnStopToken(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+FORCE_STATIC void sSdSpiOnBusy(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+
+/**
+ * @brief Queue one write block: gap byte and start token, data, CRC, data response and busy peek.
+ */
+FORCE_STATIC bool sSdSpiWriteBlock(BspSdSpi_t* pSd)
+{
+    BspSpiXfer_t tXfer = {0};
+
+    pSd->abyToken[0] = 0xFFu;
+    pSd->abyToken[1] = pSd->bMulti ? SDSPI_TOKEN_START_MULTI : SDSPI_TOKEN_START;
+    pSd->atSeg[0]    = (BspSpiSegment_t){pSd->abyToken, NULL, sizeof(pSd->abyToken)};
+    pSd->atSeg[1]    = (BspSpiSegment_t){pSd->pTxData, NULL, BSP_SDSPI_BLOCK_SIZE};
+    pSd->atSeg[2]    = (BspSpiSegment_t){s_abyOnes, pSd->abyWin, SDSPI_WRITE_TAIL};
+
+    tXfer.pSegments = pSd->atSeg;
+    tXfer.uSegments = 3u;
+    tXfer.bHoldCs   = true;
+    tXfer.pCallback = sSdSpiOnWriteBlock;
+    tXfer.pContext  = pSd;
+
+    if (BspSpiDeviceQueueTransfer(pSd->hDevice, &tXfer) != eBSP_SPI_ERR_NONE)
+    {
+        return false;
+    }
+
+    pSd->bHeld = true;
+    return true;
+}
+
+/**
+ * @brief CMD24/CMD25 frame completion: check R1, send the first block.
+ */
+FORCE_STATIC void sSdSpiOnWriteCmd(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    uint32_t uR1 = sSdSpiFindR1(pSd, SDSPI_CMD_LEN);
+
+    if ((uR1 == SDSPI_NO_R1) || (pSd->abyWin[uR1] != 0u))
+    {
+        sSdSpiEnd(pSd, (uR1 == SDSPI_NO_R1) ? eBSP_SDSPI_ERR_TIMEOUT : eBSP_SDSPI_ERR_CARD);
+        return;
+    }
+
+    if (!sSdSpiWriteBlock(pSd))
+    {
+        sSdSpiAbort(pSd);
+    }
+}
+
+/**
+ * @brief Card ready again: next block, stop token or the end of the operation.
+ */
+FORCE_STATIC void sSdSpiAfterBusy(BspSdSpi_t* pSd)
+{
+    bool bQueued;
+
+    if ((pSd->eOp != eSDSPI_OP_WRITE) || pSd->bStopSent || ((pSd->uCount == 0u) && !pSd->bMulti))
+    {
+        sSdSpiEnd(pSd, eBSP_SDSPI_ERR_NONE);
+        return;
+    }
+
+    if ((pSd->uCount > 0u) && (pSd->eResult == eBSP_SDSPI_ERR_NONE))
+    {
+        bQueued = sSdSpiWriteBlock(pSd);
+    }
+    else
+    {
+        /* All blocks sent, or one rejected: the stop token ends CMD25 either way */
+        pSd->bStopSent = true;
+        bQueued        = sSdSpiQueue(pSd, s_abyStop, pSd->abyWin, sizeof(s_abyStop), true, sSdSpiOnStopToken);
+    }
+
+    if (!bQueued)
+    {
+        sSdSpiAbort(pSd);
+    }
+}
+
+/**
+ * @brief The card signals busy (MISO low) after the last byte received.
+ */
+FORCE_STATIC void sSdSpiBusyStart(BspSdSpi_t* pSd)
+{
+    pSd->bBusy     = true;
+    pSd->uStepTick = HAL_GetTick();
+    pSd->uSpinLeft = BSP_SDSPI_BUSY_BURST;
+    sSdSpiBusyPoll(pSd);
+}
+
+/**
+ * @brief Wait for the card: poll back-to-back while the burst lasts, then
+ * deselect the card (allowed while it programs) and poll from the timer.
+ */
+FORCE_STATIC void sSdSpiBusyPoll(BspSdSpi_t* pSd)
+{
+    if ((HAL_GetTick() - pSd->uStepTick) >= BSP_SDSPI_WRITE_TIMEOUT_MS)
+    {
+        pSd->bBusy = false;
+        sSdSpiEnd(pSd, eBSP_SDSPI_ERR_TIMEOUT);
+        return;
+    }
+
+    if (pSd->uSpinLeft >= SDSPI_POLL_LEN)
+    {
+        pSd->uSpinLeft -= SDSPI_POLL_LEN;
+        pSd->tStats.uBusyPolls++;
+
+        if (!sSdSpiQueue(pSd, NULL, pSd->abyWin, SDSPI_POLL_LEN, pSd->bHeld, sSdSpiOnBusy))
+        {
+            sSdSpiAbort(pSd);
+        }
+        return;
+    }
+
+    /* Releases chip select if held; bBusy hands over to the timer */
+    sSdSpiEnd(pSd, eBSP_SDSPI_ERR_NONE);
+}
+
+/**
+ * @brief Write block completion: check the data response, then wait while busy.
+ */
+FORCE_STATIC void sSdSpiOnWriteBlock(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    if ((pSd->abyWin[SDSPI_CRC_LEN] & SDSPI_DATA_RESP_MASK) == SDSPI_DATA_ACCEPTED)
+    {
+        pSd->pTxData += BSP_SDSPI_BLOCK_SIZE;
+        pSd->uCount--;
+        pSd->tStats.uWriteBlocks++;
+    }
+    else
+    {
+        pSd->eResult = eBSP_SDSPI_ERR_CARD;
+        pSd->uCount  = 0u;
+    }
+
+    if (pSd->abyWin[SDSPI_WRITE_TAIL - 1u] != 0xFFu)
+    {
+        sSdSpiBusyStart(pSd);
+    }
+    else
+    {
+        sSdSpiAfterBusy(pSd);
+    }
+}
+
+/**
+ * @brief Stop token completion: the card goes busy once more.
+ */
+FORCE_STATIC void sSdSpiOnStopToken(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    if (pSd->abyWin[sizeof(s_abyStop) - 1u] != 0xFFu)
+    {
+        sSdSpiBusyStart(pSd);
+    }
+    else
+    {
+        sSdSpiAfterBusy(pSd);
+    }
+}
+
+/**
+ * @brief CMD12 completion: check R1 and the busy flag that may follow it.
+ */
+FORCE_STATIC void sSdSpiOnStopRead(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    uint32_t uR1 = sSdSpiFindR1(pSd, pSd->uFrameLen - SDSPI_R1_WINDOW - SDSPI_PEEK_LEN);
+
+    if ((uR1 == SDSPI_NO_R1) || (pSd->abyWin[uR1] != 0u))
+    {
+        sSdSpiEnd(pSd, (uR1 == SDSPI_NO_R1) ? eBSP_SDSPI_ERR_TIMEOUT : eBSP_SDSPI_ERR_CARD);
+    }
+    else if (pSd->abyWin[pSd->uFrameLen - 1u] != 0xFFu)
+    {
+        sSdSpiBusyStart(pSd);
+    }
+    else
+    {
+        sSdSpiEnd(pSd, eBSP_SDSPI_ERR_NONE);
+    }
+}
+
+/**
+ * @brief Busy poll completion.
+ */
+FORCE_STATIC void sSdSpiOnBusy(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    if (pSd->abyWin[SDSPI_POLL_LEN - 1u] != 0xFFu)
+    {
+        sSdSpiBusyPoll(pSd);
+        return;
+    }
+
+    pSd->bBusy = false;
+    sSdSpiAfterBusy(pSd);
+}
+
+/* --- Initialisation ------------------------------------------------------ */
+
+FORCE_STATIC void sSdSpiOnGoIdle(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+FORCE_STATIC void sSdSpiOnIfCond(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+FORCE_STATIC void sSdSpiOnOpCond(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+FORCE_STATIC void sSdSpiOnOcr(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+FORCE_STATIC void sSdSpiOnBlockLen(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+
+/**
+ * @brief Queue CMD55 and ACMD41 in one frame; CMD55's full response window
+ * lies between them.
+ */
+FORCE_STATIC bool sSdSpiSendOpCond(BspSdSpi_t* pSd)
+{
+    uint32_t uArg = (pSd->tInfo.eType == eBSP_SDSPI_CARD_SDSC_V1) ? 0u : SDSPI_OCR_HCS;
+
+    (void)memset(pSd->abyCmd, 0xFF, sizeof(pSd->abyCmd));
+    sSdSpiSetCmd(pSd, 0u, SDSPI_CMD_APP, 0u);
+    sSdSpiSetCmd(pSd, SDSPI_R1_FRAME, SDSPI_ACMD_OP_COND, uArg);
+    pSd->uFrameLen = 2u * SDSPI_R1_FRAME;
+
+    return sSdSpiQueue(pSd, pSd->abyCmd, pSd->abyWin, pSd->uFrameLen, false, sSdSpiOnOpCond);
+}
+
+/**
+ * @brief Read the CSD for the capacity; completes through the read steps.
+ */
+FORCE_STATIC void sSdSpiReadCsd(BspSdSpi_t* pSd)
+{
+    if (!sSdSpiStartRead(pSd, SDSPI_CMD_SEND_CSD, 0u, pSd->abyCsd, SDSPI_CSD_LEN, 1u))
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_BUSY);
+    }
+}
+
+/**
+ * @brief Send an initialisation command, or finish with eBSP_SDSPI_ERR_BUSY.
+ */
+FORCE_STATIC void sSdSpiInitCommand(BspSdSpi_t* pSd, uint8_t byCmd, uint32_t uArg, uint32_t uFrameLen, BspSpiXferCb_t pCallback)
+{
+    if (!sSdSpiCommand(pSd, byCmd, uArg, uFrameLen, false, pCallback))
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_BUSY);
+    }
+}
+
+/**
+ * @brief Power-up clocks done: CMD0.
+ */
+FORCE_STATIC void sSdSpiOnPowerUp(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    sSdSpiInitCommand(pSd, SDSPI_CMD_GO_IDLE, 0u, SDSPI_R1_FRAME, sSdSpiOnGoIdle);
+}
+
+/**
+ * @brief CMD0 completion: the card must be idle; retried a few times.
+ */
+FORCE_STATIC void sSdSpiOnGoIdle(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    uint32_t uR1 = sSdSpiFindR1(pSd, SDSPI_CMD_LEN);
+
+    if ((uR1 != SDSPI_NO_R1) && (pSd->abyWin[uR1] == SDSPI_R1_IDLE))
+    {
+        sSdSpiInitCommand(pSd, SDSPI_CMD_SEND_IF_COND, SDSPI_IF_COND_ARG, SDSPI_R7_FRAME, sSdSpiOnIfCond);
+    }
+    else if (++pSd->byTries < SDSPI_GO_IDLE_TRIES)
+    {
+        /* A card interrupted in a transfer may need more than one reset */
+        sSdSpiInitCommand(pSd, SDSPI_CMD_GO_IDLE, 0u, SDSPI_R1_FRAME, sSdSpiOnGoIdle);
+    }
+    else
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_NO_CARD);
+    }
+}
+
+/**
+ * @brief CMD8 completion: version 1 cards reject it, version 2 cards echo the pattern.
+ */
+FORCE_STATIC void sSdSpiOnIfCond(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    uint32_t uR1 = sSdSpiFindR1(pSd, SDSPI_CMD_LEN);
+
+    if (uR1 == SDSPI_NO_R1)
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_NO_CARD);
+        return;
+    }
+
+    if ((pSd->abyWin[uR1] & SDSPI_R1_ILLEGAL) != 0u)
+    {
+        pSd->tInfo.eType = eBSP_SDSPI_CARD_SDSC_V1;
+    }
+    else if ((pSd->abyWin[uR1] == SDSPI_R1_IDLE) && ((pSd->abyWin[uR1 + 3u] & 0x0Fu) == 0x01u) && (pSd->abyWin[uR1 + 4u] == 0xAAu))
+    {
+        pSd->tInfo.eType = eBSP_SDSPI_CARD_SDSC_V2;
+    }
+    else
+    {
+        /* Voltage range not accepted or a garbled echo */
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_NO_CARD);
+        return;
+    }
+
+    pSd->uStepTick = HAL_GetTick();
+
+    if (!sSdSpiSendOpCond(pSd))
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_BUSY);
+    }
+}
+
+/**
+ * @brief ACMD41 completion: repeat from the timer until the card leaves idle.
+ */
+FORCE_STATIC void sSdSpiOnOpCond(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    uint32_t uR1 = sSdSpiFindR1(pSd, SDSPI_R1_FRAME + SDSPI_CMD_LEN);
+
+    if ((uR1 == SDSPI_NO_R1) || ((pSd->abyWin[uR1] & (uint8_t)~SDSPI_R1_IDLE) != 0u))
+    {
+        /* MMC and other cards without ACMD41 are not supported */
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_NO_CARD);
+    }
+    else if (pSd->abyWin[uR1] == SDSPI_R1_IDLE)
+    {
+        if ((HAL_GetTick() - pSd->uStepTick) >= BSP_SDSPI_INIT_TIMEOUT_MS)
+        {
+            sSdSpiFinish(pSd, eBSP_SDSPI_ERR_TIMEOUT);
+        }
+        else
+        {
+            pSd->tStats.uTimerWaits++;
+            (void)SWTimerStart(&pSd->tTimer);
+        }
+    }
+    else if (pSd->tInfo.eType == eBSP_SDSPI_CARD_SDSC_V1)
+    {
+        sSdSpiInitCommand(pSd, SDSPI_CMD_SET_BLOCKLEN, BSP_SDSPI_BLOCK_SIZE, SDSPI_R1_FRAME, sSdSpiOnBlockLen);
+    }
+    else
+    {
+        sSdSpiInitCommand(pSd, SDSPI_CMD_READ_OCR, 0u, SDSPI_R7_FRAME, sSdSpiOnOcr);
+    }
+}
+
+/**
+ * @brief CMD58 completion: CCS tells block (SDHC) from byte addressing.
+ */
+FORCE_STATIC void sSdSpiOnOcr(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    uint32_t uR1 = sSdSpiFindR1(pSd, SDSPI_CMD_LEN);
+
+    if ((uR1 == SDSPI_NO_R1) || (pSd->abyWin[uR1] != 0u) || ((pSd->abyWin[uR1 + 1u] & SDSPI_OCR_READY) == 0u))
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_NO_CARD);
+    }
+    else if ((pSd->abyWin[uR1 + 1u] & SDSPI_OCR_CCS) != 0u)
+    {
+        pSd->tInfo.eType = eBSP_SDSPI_CARD_SDHC;
+        sSdSpiReadCsd(pSd);
+    }
+    else
+    {
+        sSdSpiInitCommand(pSd, SDSPI_CMD_SET_BLOCKLEN, BSP_SDSPI_BLOCK_SIZE, SDSPI_R1_FRAME, sSdSpiOnBlockLen);
+    }
+}
+
+/**
+ * @brief CMD16 completion (standard capacity cards).
+ */
+FORCE_STATIC void sSdSpiOnBlockLen(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    uint32_t uR1 = sSdSpiFindR1(pSd, SDSPI_CMD_LEN);
+
+    if ((uR1 == SDSPI_NO_R1) || (pSd->abyWin[uR1] != 0u))
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_NO_CARD);
+        return;
+    }
+
+    sSdSpiReadCsd(pSd);
+}
+
+/**
+ * @brief CSD read: take the capacity and switch to the data clock.
+ */
+FORCE_STATIC void sSdSpiInitDone(BspSdSpi_t* pSd)
+{
+    pSd->tInfo.uBlocks = sSdSpiCsdBlocks(pSd->abyCsd);
+
+    if (pSd->tInfo.uBlocks == 0u)
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_NO_CARD);
+        return;
+    }
+
+    if (!sSdSpiSetClock(pSd, pSd->tConfig.ePrescaler))
+    {
+        sSdSpiFinish(pSd, eBSP_SDSPI_ERR_BUSY);
+        return;
+    }
+
+    pSd->bReady = true;
+    sSdSpiFinish(pSd, eBSP_SDSPI_ERR_NONE);
+}
+
+/* --- Transaction end ----------------------------------------------------- */
+
+/**
+ * @brief Chip select is released: start the timer wait, complete the
+ * initialisation or report the result.
+ */
+FORCE_STATIC void sSdSpiReleased(BspSdSpi_t* pSd)
+{
+    if (pSd->bBusy)
+    {
+        pSd->tStats.uTimerWaits++;
+        (void)SWTimerStart(&pSd->tTimer);
+    }
+    else if ((pSd->eOp == eSDSPI_OP_INIT) && (pSd->eResult == eBSP_SDSPI_ERR_NONE))
+    {
+        sSdSpiInitDone(pSd);
+    }
+    else
+    {
+        sSdSpiFinish(pSd, pSd->eResult);
+    }
+}
+
+/**
+ * @brief Release transfer completion.
+ */
+FORCE_STATIC void sSdSpiOnRelease(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSdSpi_t* pSd = (BspSdSpi_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSdSpiSpiError(pSd);
+        return;
+    }
+
+    sSdSpiReleased(pSd);
+}
+
+/**
+ * @brief Record the result and release chip select: the CRC still owed by
+ * the card (at least one byte) is clocked by a transfer without bHoldCs.
+ */
+FORCE_STATIC void sSdSpiEnd(BspSdSpi_t* pSd, BspSdSpiError_e eError)
+{
+    if (pSd->eResult == eBSP_SDSPI_ERR_NONE)
+    {
+        pSd->eResult = eError;
+    }
+
+    if (!pSd->bHeld)
+    {
+        sSdSpiReleased(pSd);
+        return;
+    }
+
+    uint32_t uLength = (pSd->bySkip > 0u) ? pSd->bySkip : 1u;
+    pSd->bySkip      = 0u;
+
+    if (!sSdSpiQueue(pSd, NULL, NULL, uLength, false, sSdSpiOnRelease))
+    {
+        sSdSpiAbort(pSd);
+    }
+}
+
+/**
+ * @brief Poll timer expiry (SysTick): ACMD41 again or another busy poll.
+ */
+FORCE_STATIC void sSdSpiOnTimer(BspSdSpi_t* pSd)
+{
+    bool bQueued = true;
+
+    if (pSd->eOp == eSDSPI_OP_INIT)
+    {
+        bQueued = sSdSpiSendOpCond(pSd);
+    }
+    else if (pSd->bBusy)
+    {
+        pSd->tStats.uBusyPolls++;
+        bQueued = sSdSpiQueue(pSd, NULL, pSd->abyWin, SDSPI_POLL_LEN, false, sSdSpiOnBusy);
+    }
+    else
+    {
+        /* Nothing waits for the timer */
+    }
+
+    /* Queue full: try again on the next tick */
+    if (!bQueued)
+    {
+        (void)SWTimerStart(&pSd->tTimer);
+    }
+}
+
+FORCE_STATIC void sSdSpiTimerCallback0(void)
+{
+    sSdSpiOnTimer(&s_aSdSpi[0]);
+}
+
+#if (BSP_SDSPI_MAX_INSTANCES > 1u)
+FORCE_STATIC void sSdSpiTimerCallback1(void)
+{
+    sSdSpiOnTimer(&s_aSdSpi[1]);
+}
+#endif
+
+/**
+ * @brief Common start of an operation.
+ */
+FORCE_STATIC void sSdSpiBegin(BspSdSpi_t* pSd, BspSdSpiOp_e eOp, BspSdSpiCb_t pCb, void* pContext)
+{
+    pSd->pCb       = pCb;
+    pSd->pContext  = pContext;
+    pSd->eResult   = eBSP_SDSPI_ERR_NONE;
+    pSd->bBusy     = false;
+    pSd->bStopSent = false;
+    pSd->eOp       = eOp;
+}
+
+/* ============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+BspSdSpiHandle_t BspSdSpiAllocate(const BspSdSpiConfig_t* pConfig)
+{
+    if ((pConfig == NULL) || (pConfig->eInitPrescaler >= eBSP_SPI_PRESCALER_COUNT) || (pConfig->ePrescaler >= eBSP_SPI_PRESCALER_COUNT))
+    {
+        return BSP_SDSPI_INVALID_HANDLE;
+    }
+
+    for (uint8_t i = 0u; i < BSP_SDSPI_MAX_INSTANCES; i++)
+    {
+        BspSdSpi_t* pSd = &s_aSdSpi[i];
+
+        if (pSd->bAllocated)
+        {
+            continue;
+        }
+
+        (void)memset(pSd, 0, sizeof(*pSd));
+        pSd->tConfig = *pConfig;
+        pSd->hDevice = -1;
+
+        if (!sSdSpiSetClock(pSd, pConfig->eInitPrescaler))
+        {
+            return BSP_SDSPI_INVALID_HANDLE;
+        }
+
+        pSd->tTimer.interval          = BSP_SDSPI_POLL_MS;
+        pSd->tTimer.pCallbackFunction = s_apfnTimerCallbacks[i];
+        pSd->tTimer.periodic          = false;
+
+        if (!SWTimerInit(&pSd->tTimer))
+        {
+            (void)BspSpiDeviceRemove(pSd->hDevice);
+            return BSP_SDSPI_INVALID_HANDLE;
+        }
+
+        pSd->bAllocated = true;
+        return (BspSdSpiHandle_t)i;
+    }
+
+    return BSP_SDSPI_INVALID_HANDLE;
+}
+
+BspSdSpiError_e BspSdSpiFree(BspSdSpiHandle_t handle)
+{
+    BspSdSpi_t* pSd = sSdSpiValidateHandle(handle);
+
+    if (pSd == NULL)
+    {
+        return eBSP_SDSPI_ERR_INVALID_HANDLE;
+    }
+
+    if ((pSd->eOp != eSDSPI_OP_IDLE) || (BspSpiDeviceRemove(pSd->hDevice) != eBSP_SPI_ERR_NONE))
+    {
+        return eBSP_SDSPI_ERR_BUSY;
+    }
+
+    /* The timer stays registered with bsp_swtimer and is reused on the next allocation */
+    SWTimerStop(&pSd->tTimer);
+    pSd->bAllocated = false;
+
+    return eBSP_SDSPI_ERR_NONE;
+}
+
+BspSdSpiError_e BspSdSpiInit(BspSdSpiHandle_t handle, BspSdSpiCb_t pCb, void* pContext)
+{
+    BspSdSpi_t* pSd = sSdSpiValidateHandle(handle);
+
+    if (pSd == NULL)
+    {
+        return eBSP_SDSPI_ERR_INVALID_HANDLE;
+    }
+
+    if (pSd->eOp != eSDSPI_OP_IDLE)
+    {
+        return eBSP_SDSPI_ERR_BUSY;
+    }
+
+    /* Back to the identification clock after a previous initialisation */
+    if ((pSd->eClock != pSd->tConfig.eInitPrescaler) && !sSdSpiSetClock(pSd, pSd->tConfig.eInitPrescaler))
+    {
+        return eBSP_SDSPI_ERR_BUSY;
+    }
+
+    BspSpiXfer_t tClocks = {0};
+    tClocks.uLength      = SDSPI_POWER_UP_CLOCKS;
+    tClocks.bFill        = true;
+    tClocks.uFillPattern = 0xFFu;
+    tClocks.pCallback    = sSdSpiOnPowerUp;
+    tClocks.pContext     = pSd;
+
+    pSd->bReady  = false;
+    pSd->byTries = 0u;
+    sSdSpiBegin(pSd, eSDSPI_OP_INIT, pCb, pContext);
+
+    /* One byte to the device applies its slow clock; the power-up clocks run with chip select high */
+    if (!sSdSpiQueue(pSd, NULL, NULL, 1u, false, NULL) || (BspSpiQueueTransfer(pSd->tConfig.hBus, &tClocks) != eBSP_SPI_ERR_NONE))
+    {
+        pSd->eOp = eSDSPI_OP_IDLE;
+        return eBSP_SDSPI_ERR_BUSY;
+    }
+
+    return eBSP_SDSPI_ERR_NONE;
+}
+
+BspSdSpiError_e BspSdSpiGetInfo(BspSdSpiHandle_t handle, BspSdSpiInfo_t* pInfo)
+{
+    const BspSdSpi_t* pSd = sSdSpiValidateHandle(handle);
+
+    if (pSd == NULL)
+    {
+        return eBSP_SDSPI_ERR_INVALID_HANDLE;
+    }
+
+    if (pInfo == NULL)
+    {
+        return eBSP_SDSPI_ERR_INVALID_PARAM;
+    }
+
+    if (!pSd->bReady)
+    {
+        return eBSP_SDSPI_ERR_NO_CARD;
+    }
+
+    *pInfo = pSd->tInfo;
+    return eBSP_SDSPI_ERR_NONE;
+}
+
+BspSdSpiError_e BspSdSpiRead(BspSdSpiHandle_t handle, uint32_t uBlock, uint8_t* pData, uint32_t uCount, BspSdSpiCb_t pCb,
+                             void* pContext)
+{
+    BspSdSpi_t* pSd = sSdSpiValidateHandle(handle);
+
+    if (pSd == NULL)
+    {
+        return eBSP_SDSPI_ERR_INVALID_HANDLE;
+    }
+
+    BspSdSpiError_e eResult = sSdSpiCheckRequest(pSd, uBlock, pData, uCount);
+
+    if (eResult != eBSP_SDSPI_ERR_NONE)
+    {
+        return eResult;
+    }
+
+    uint32_t uArg = (pSd->tInfo.eType == eBSP_SDSPI_CARD_SDHC) ? uBlock : (uBlock * BSP_SDSPI_BLOCK_SIZE);
+    uint8_t  byCmd = (uCount > 1u) ? SDSPI_CMD_READ_MULTI : SDSPI_CMD_READ_SINGLE;
+
+    sSdSpiBegin(pSd, eSDSPI_OP_READ, pCb, pContext);
+
+    if (!sSdSpiStartRead(pSd, byCmd, uArg, pData, BSP_SDSPI_BLOCK_SIZE, uCount))
+    {
+        pSd->eOp = eSDSPI_OP_IDLE;
+        return eBSP_SDSPI_ERR_BUSY;
+    }
+
+    return eBSP_SDSPI_ERR_NONE;
+}
+
+BspSdSpiError_e BspSdSpiWrite(BspSdSpiHandle_t handle, uint32_t uBlock, const uint8_t* pData, uint32_t uCount, BspSdSpiCb_t pCb,
+                              void* pContext)
+{
+    BspSdSpi_t* pSd = sSdSpiValidateHandle(handle);
+
+    if (pSd == NULL)
+    {
+        return eBSP_SDSPI_ERR_INVALID_HANDLE;
+    }
+
+    BspSdSpiError_e eResult = sSdSpiCheckRequest(pSd, uBlock, pData, uCount);
+
+    if (eResult != eBSP_SDSPI_ERR_NONE)
+    {
+        return eResult;
+    }
+
+    uint32_t uArg = (pSd->tInfo.eType == eBSP_SDSPI_CARD_SDHC) ? uBlock : (uBlock * BSP_SDSPI_BLOCK_SIZE);
+    uint8_t  byCmd = (uCount > 1u) ? SDSPI_CMD_WRITE_MULTI : SDSPI_CMD_WRITE_SINGLE;
+
+    sSdSpiBegin(pSd, eSDSPI_OP_WRITE, pCb, pContext);
+    pSd->pTxData = pData;
+    pSd->uCount  = uCount;
+    pSd->bMulti  = (uCount > 1u);
+
+    if (!sSdSpiCommand(pSd, byCmd, uArg, SDSPI_R1_FRAME, true, sSdSpiOnWriteCmd))
+    {
+        pSd->eOp = eSDSPI_OP_IDLE;
+        return eBSP_SDSPI_ERR_BUSY;
+    }
+
+    return eBSP_SDSPI_ERR_NONE;
+}
+
+bool BspSdSpiIsBusy(BspSdSpiHandle_t handle)
+{
+    const BspSdSpi_t* pSd = sSdSpiValidateHandle(handle);
+
+    return (pSd != NULL) && (pSd->eOp != eSDSPI_OP_IDLE);
+}
+
+BspSdSpiError_e BspSdSpiGetStats(BspSdSpiHandle_t handle, BspSdSpiStats_t* pStats)
+{
+    const BspSdSpi_t* pSd = sSdSpiValidateHandle(handle);
+
+    if (pSd == NULL)
+    {
+        return eBSP_SDSPI_ERR_INVALID_HANDLE;
+    }
+
+    if (pStats == NULL)
+    {
+        return eBSP_SDSPI_ERR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    *pStats = pSd->tStats;
+    __enable_irq();
+
+    return eBSP_SDSPI_ERR_NONE;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file bsp_sdspi.h
+ * @brief SD card block driver in SPI mode on a shared bsp_spi bus
+ *
+ * - Card initialisation at the identification clock: power-up clocks, CMD0,
+ *   CMD8, ACMD41, CMD58, CMD16 and CMD9 for the capacity, then the data clock
+ * - SDSC (v1 and v2) and SDHC/SDXC cards, 512-byte blocks
+ * - Multi-block reads (CMD18) and writes (CMD25) with the data blocks moved by
+ *   DMA straight from and into the caller's buffer; single blocks use CMD17
+ *   and CMD24
+ * - Data tokens and the programming busy flag are polled asynchronously:
+ *   short bursts from the completion interrupt, then a software timer
+ * - Block device interface (sector, buffer, count) that maps directly onto
+ *   the FatFs disk_read/disk_write/disk_ioctl functions
+ *
+ * All operations complete through a callback, called from interrupt context
+ * (SPI DMA completion or SysTick). One operation per card at a time.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "bsp_spi.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/**
+ * @brief Maximum number of cards.
+ * Each card uses one software timer and one bsp_spi device.
+ */
+#ifndef BSP_SDSPI_MAX_INSTANCES
+    #define BSP_SDSPI_MAX_INSTANCES (1u)
+#endif
+
+#if (BSP_SDSPI_MAX_INSTANCES < 1u) || (BSP_SDSPI_MAX_INSTANCES > 2u)
+    #error "BSP_SDSPI_MAX_INSTANCES must be 1 or 2"
+#endif
+
+/** @brief Poll interval in milliseconds once the busy burst is used up, and between ACMD41 retries */
+#ifndef BSP_SDSPI_POLL_MS
+    #define BSP_SDSPI_POLL_MS (1u)
+#endif
+
+/**
+ * @brief Bytes clocked back-to-back while the card programs a block, before
+ * the driver deselects the card and polls from the timer.
+ * About 0.8 ms at 21 MHz; covers the usual multi-block busy time so that
+ * writes stream without waiting for a timer tick.
+ */
+#ifndef BSP_SDSPI_BUSY_BURST
+    #define BSP_SDSPI_BUSY_BURST (2048u)
+#endif
+
+/** @brief Initialisation time limit in milliseconds (ACMD41 may take up to 1 s) */
+#ifndef BSP_SDSPI_INIT_TIMEOUT_MS
+    #define BSP_SDSPI_INIT_TIMEOUT_MS (1000u)
+#endif
+
+/** @brief Data token time limit for reads in milliseconds (specified maximum 100 ms) */
+#ifndef BSP_SDSPI_READ_TIMEOUT_MS
+    #define BSP_SDSPI_READ_TIMEOUT_MS (100u)
+#endif
+
+/** @brief Busy time limit per write block in milliseconds (specified maximum 250 ms for SDHC) */
+#ifndef BSP_SDSPI_WRITE_TIMEOUT_MS
+    #define BSP_SDSPI_WRITE_TIMEOUT_MS (500u)
+#endif
+
+#if (BSP_SDSPI_BUSY_BURST > 65535u)
+    #error "BSP_SDSPI_BUSY_BURST must be at most 65535"
+#endif
+
+/** Block size in bytes (fixed for SDHC, set with CMD16 for SDSC) */
+#define BSP_SDSPI_BLOCK_SIZE (512u)
+
+/* ============================================================================
+ * Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Card handle. Valid handles are >= 0.
+ */
+typedef int8_t BspSdSpiHandle_t;
+
+/** Invalid handle constant */
+static const BspSdSpiHandle_t BSP_SDSPI_INVALID_HANDLE = -1;
+
+/**
+ * @brief Card error codes.
+ */
+typedef enum
+{
+    eBSP_SDSPI_ERR_NONE = 0u,      /**< Success */
+    eBSP_SDSPI_ERR_INVALID_HANDLE, /**< Invalid or unallocated handle */
+    eBSP_SDSPI_ERR_INVALID_PARAM,  /**< Invalid parameter or blocks outside the card */
+    eBSP_SDSPI_ERR_BUSY,           /**< Operation in progress or bus queue full */
+    eBSP_SDSPI_ERR_NO_CARD,        /**< No usable card (initialisation failed or not run) */
+    eBSP_SDSPI_ERR_SPI,            /**< SPI transfer failed */
+    eBSP_SDSPI_ERR_TIMEOUT,        /**< Card did not answer or stayed busy too long */
+    eBSP_SDSPI_ERR_CARD            /**< Card reported an error: R1 flags, data error token or rejected block */
+} BspSdSpiError_e;
+
+/**
+ * @brief Card generation, from CMD8 and the OCR.
+ */
+typedef enum
+{
+    eBSP_SDSPI_CARD_SDSC_V1 = 0u, /**< Version 1.x standard capacity, byte addressing */
+    eBSP_SDSPI_CARD_SDSC_V2,      /**< Version 2.0+ standard capacity, byte addressing */
+    eBSP_SDSPI_CARD_SDHC          /**< High or extended capacity, block addressing */
+} BspSdSpiCardType_e;
+
+/**
+ * @brief Operation completion callback (interrupt context).
+ *
+ * @param handle     Card handle
+ * @param eError     Result of the operation
+ * @param pContext   Context passed with the operation
+ */
+typedef void (*BspSdSpiCb_t)(BspSdSpiHandle_t handle, BspSdSpiError_e eError, void* pContext);
+
+/**
+ * @brief Card configuration.
+ */
+typedef struct
+{
+    BspSpiHandle_t    hBus;           /**< bsp_spi bus handle (DMA mode) */
+    uint32_t          uCsPin;         /**< Chip-select pin for BspGpioWritePin(), active low */
+    BspSpiPrescaler_e eInitPrescaler; /**< Bus clock prescaler during initialisation, at most 400 kHz */
+    BspSpiPrescaler_e ePrescaler;     /**< Bus clock prescaler for data transfer, at most 25 MHz */
+} BspSdSpiConfig_t;
+
+/**
+ * @brief Initialised card.
+ */
+typedef struct
+{
+    BspSdSpiCardType_e eType;   /**< Card generation */
+    uint32_t           uBlocks; /**< Capacity in BSP_SDSPI_BLOCK_SIZE blocks */
+} BspSdSpiInfo_t;
+
+/**
+ * @brief Card statistics.
+ */
+typedef struct
+{
+    uint32_t uCommands;    /**< Commands sent (CMD55 counted separately) */
+    uint32_t uReadBlocks;  /**< Data blocks read */
+    uint32_t uWriteBlocks; /**< Data blocks written and accepted */
+    uint32_t uTokenPolls;  /**< Poll bursts while waiting for a read data token */
+    uint32_t uBusyPolls;   /**< Poll bursts while the card was busy programming */
+    uint32_t uTimerWaits;  /**< Busy or ACMD41 waits handed to the poll timer */
+} BspSdSpiStats_t;
+
+/* ============================================================================
+ * Public API
+ * ========================================================================== */
+
+/**
+ * @brief Allocate a card on a shared bus.
+ *
+ * Adds a bsp_spi device at the identification clock and releases its chip
+ * select. The card is usable after BspSdSpiInit().
+ *
+ * @param pConfig    Card configuration (copied)
+ * @return           Card handle, BSP_SDSPI_INVALID_HANDLE on error
+ */
+BspSdSpiHandle_t BspSdSpiAllocate(const BspSdSpiConfig_t* pConfig);
+
+/**
+ * @brief Free a card.
+ *
+ * @param handle     Card handle
+ * @return           Error code; eBSP_SDSPI_ERR_BUSY while an operation is in progress
+ */
+BspSdSpiError_e BspSdSpiFree(BspSdSpiHandle_t handle);
+
+/**
+ * @brief Initialise the card (after power-up or insertion).
+ *
+ * Runs the SPI mode initialisation at the identification clock and reads the
+ * capacity, then switches to the data clock. Takes up to
+ * BSP_SDSPI_INIT_TIMEOUT_MS, mostly waiting for ACMD41 from the poll timer.
+ *
+ * @param handle     Card handle
+ * @param pCb        Completion callback, may be NULL
+ * @param pContext   Passed to the callback
+ * @return           Error code of the request; the card result comes with the callback
+ */
+BspSdSpiError_e BspSdSpiInit(BspSdSpiHandle_t handle, BspSdSpiCb_t pCb, void* pContext);
+
+/**
+ * @brief Get the card type and capacity.
+ *
+ * @param handle     Card handle
+ * @param pInfo      Output: card information
+ * @return           Error code; eBSP_SDSPI_ERR_NO_CARD before a successful BspSdSpiInit()
+ */
+BspSdSpiError_e BspSdSpiGetInfo(BspSdSpiHandle_t handle, BspSdSpiInfo_t* pInfo);
+
+/**
+ * @brief Read blocks.
+ *
+ * One block is read with CMD17, more with CMD18 and CMD12. The data moves by
+ * DMA straight into pData. Chip select stays asserted for the whole command,
+ * so other devices on the bus wait until it completes.
+ *
+ * @param handle     Card handle
+ * @param uBlock     First block
+ * @param pData      Destination, uCount × BSP_SDSPI_BLOCK_SIZE bytes, valid until the callback
+ * @param uCount     Number of blocks (> 0)
+ * @param pCb        Completion callback, may be NULL
+ * @param pContext   Passed to the callback
+ * @return           Error code of the request
+ */
+BspSdSpiError_e BspSdSpiRead(BspSdSpiHandle_t handle, uint32_t uBlock, uint8_t* pData, uint32_t uCount, BspSdSpiCb_t pCb,
+                             void* pContext);
+
+/**
+ * @brief Write blocks.
+ *
+ * One block is written with CMD24, more with CMD25 and the stop token. The
+ * callback runs when the card has finished programming the last block.
+ * While the card programs, it may be deselected and other devices use the bus.
+ *
+ * @param handle     Card handle
+ * @param uBlock     First block
+ * @param pData      Source, uCount × BSP_SDSPI_BLOCK_SIZE bytes, valid until the callback
+ * @param uCount     Number of blocks (> 0)
+ * @param pCb        Completion callback, may be NULL
+ * @param pContext   Passed to the callback
+ * @return           Error code of the request
+ */
+BspSdSpiError_e BspSdSpiWrite(BspSdSpiHandle_t handle, uint32_t uBlock, const uint8_t* pData, uint32_t uCount, BspSdSpiCb_t pCb,
+                              void* pContext);
+
+/**
+ * @brief Check whether an operation is in progress.
+ *
+ * @param handle     Card handle
+ * @return           true while busy (false for invalid handles)
+ */
+bool BspSdSpiIsBusy(BspSdSpiHandle_t handle);
+
+/**
+ * @brief Get card statistics.
+ *
+ * @param handle     Card handle
+ * @param pStats     Output: statistics snapshot
+ * @return           Error code
+ */
+BspSdSpiError_e BspSdSpiGetStats(BspSdSpiHandle_t handle, BspSdSpiStats_t* pStats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -3,7 +3,10 @@
  */
 
 #include "bsp_spi.h"
+#include "bsp_gpio.h"
 #include "stm32f4xx_hal.h"
+#include "stm32f4xx_ll_spi.h"
+#include <string.h>
 
 /* --- Constants --- */
 
@@ -16,25 +19,134 @@
 /** Invalid handle value */
 #define BSP_SPI_INVALID_HANDLE (-1)
 
+/** Most frames HAL and the DMA stream accept at once (16-bit counters) */
+#define BSP_SPI_MAX_CHUNK (0xFFFFu)
+
+/** Status polls per byte before the polled path gives up (covers the slowest prescaler) */
+#define BSP_SPI_FAST_PATH_SPIN_LIMIT (0x10000u)
+
+/** CR1 bits of the frame format (frame size and hardware CRC) */
+#define BSP_SPI_FORMAT_CR1_MASK (SPI_CR1_DFF | SPI_CR1_CRCEN)
+
+/** CR1 bits switched per device (clock polarity, phase, baud rate and frame format) */
+#define BSP_SPI_DEVICE_CR1_MASK (SPI_CR1_CPOL | SPI_CR1_CPHA | SPI_CR1_BR | BSP_SPI_FORMAT_CR1_MASK)
+
 /* --- Private Types --- */
 
+/**
+ * Transaction queue entry.
+ */
+typedef struct
+{
+    BspSpiXfer_t         tXfer;      /**< Transfer descriptor */
+    BspSpiDeviceHandle_t hDevice;    /**< Target device, or -1 for a bus transfer (CS by caller) */
+    uint32_t             uRequestUs; /**< Time of the queue call, with statistics enabled */
+    uint32_t             uBytes;     /**< Transfer length in bytes, with statistics enabled */
+} BspSpiQueueEntry_t;
+
+/**
+ * Device on a shared bus.
+ */
+typedef struct
+{
+    bool           bAllocated;     /**< Allocation status flag */
+    BspSpiHandle_t hBus;           /**< Bus handle */
+    uint8_t        byQueued;       /**< Transfers of this device in the bus queue */
+    uint32_t       uCsPin;         /**< Chip-select pin (active low) */
+    uint32_t       uCr1Bits;       /**< CPOL/CPHA/BR/DFF/CRCEN bits for CR1 */
+    uint16_t       uCrcPoly;       /**< CRC polynomial, used with SPI_CR1_CRCEN */
+    bool           bDeselectClock; /**< Clock one frame after releasing chip select */
+} BspSpiDevice_t;
+
+/**
+ * Message queued by a slave-mode bus.
+ */
+typedef struct
+{
+    uint32_t uOffset; /**< Start in the receive ring */
+    uint32_t uLength; /**< Length in bytes */
+    uint32_t uStamp;  /**< Receive byte count at the start, for overwrite detection */
+} BspSpiSlaveSpan_t;
+
+/**
+ * Slave mode state (one bus at a time: the chip-select EXTI callback has no context).
+ */
+typedef struct
+{
+    struct BspSpiModule_s* pModule;     /**< Bus in slave mode, NULL if none */
+    BspSpiSlaveConfig_t    tConfig;     /**< Slave configuration */
+    SPI_InitTypeDef        tMasterInit; /**< HAL configuration restored by BspSpiSlaveStop() */
+
+    uint32_t         uFrameStart; /**< Ring offset where the frame in progress started (RX and TX run in lockstep) */
+    uint32_t         uRxCount;    /**< Bytes received since start (wrapping) */
+    volatile uint8_t byDmaEvents; /**< DMA half/full-ring events since the last frame end */
+    uint32_t         uTxQueued;   /**< Transmit bytes ahead of uFrameStart, 0 if nothing is queued */
+
+    BspSpiSlaveSpan_t aMsg[BSP_SPI_SLAVE_MSG_DEPTH]; /**< Message queue (ring) */
+    uint8_t           byMsgHead;                     /**< Index of the oldest message */
+    uint8_t           byMsgCount;                    /**< Number of queued messages */
+    uint32_t          uMsgRemoved;                   /**< Messages removed from the head (released or overwritten) */
+    uint32_t          uMsgHeld;                      /**< uMsgRemoved when the head was handed out */
+    bool              bMsgHeld;                      /**< Head handed out by BspSpiSlaveGetMessage() */
+
+    BspSpiSlaveStats_t tStats; /**< Slave counters */
+} BspSpiSlave_t;
+
 /**
  * SPI module structure.
  * Contains the state and configuration for each allocated SPI instance.
  */
-typedef struct
+typedef struct BspSpiModule_s
 {
     BspSpiInstance_e   eInstance;  /**< SPI peripheral instance */
     SPI_HandleTypeDef* pHalHandle; /**< Pointer to HAL SPI handle */
     BspSpiMode_e       eMode;      /**< Operation mode (blocking or DMA) */
     uint32_t           uTimeoutMs; /**< Timeout for blocking mode operations */
     bool               bAllocated; /**< Allocation status flag */
+    uint8_t            byFastMax;  /**< Longest transfer using the polled path, 0 = off */
 
     /* Callbacks for DMA mode */
     BspSpiTxCpltCb_t   pTxCpltCb;   /**< Transmit completion callback */
     BspSpiRxCpltCb_t   pRxCpltCb;   /**< Receive completion callback */
     BspSpiTxRxCpltCb_t pTxRxCpltCb; /**< Transmit-receive completion callback */
     BspSpiErrorCb_t    pErrorCb;    /**< Error callback */
+
+    /* DMA transaction queue */
+    BspSpiQueueEntry_t   aQueue[BSP_SPI_QUEUE_DEPTH]; /**< Pending transfers (ring), head is in flight when bQueueActive */
+    uint8_t              byQueueHead;                 /**< Index of the oldest pending transfer */
+    uint8_t              byQueueCount;                /**< Number of pending transfers */
+    volatile bool        bQueueActive;                /**< Queue head transfer is in flight */
+    BspSpiQueueStats_t   tQueueStats;                 /**< Queue counters (byPending unused) */
+    BspSpiDeviceHandle_t hHeldDevice;                 /**< Device keeping chip select asserted (bHoldCs), or -1 */
+    bool                 bDeselectClock;              /**< Deselect clock frame in flight, queue head not started */
+
+    /* Chunked and segmented transfer in flight (re-armed from the completion interrupt) */
+    const uint8_t*         pChunkTx;        /**< Transmit data of the next chunk, or NULL */
+    uint8_t*               pChunkRx;        /**< Receive buffer of the next chunk, or NULL */
+    uint32_t               uChunkRemaining; /**< Bytes of the current segment left after the chunk in flight */
+    const BspSpiSegment_t* pSegNext;        /**< Next segment to start */
+    uint32_t               uSegRemaining;   /**< Segments left after the current one */
+    bool                   bVectorDirect;   /**< Direct transfer in flight came from BspSpiTransferV() */
+    bool                   bChunkFill;      /**< pChunkTx is uFillWord: not advanced, TX stream memory increment off */
+    uint16_t               uFillWord;       /**< Single-word source of a constant-fill transfer */
+
+    /* Streaming reception */
+    uint8_t*            pStreamBuffer; /**< Circular buffer, NULL when not streaming */
+    uint32_t            uStreamHalf;   /**< Half buffer length in bytes */
+    BspSpiStreamCb_t    pStreamCb;     /**< Half-buffer callback */
+    volatile bool       bStreamHeld;   /**< Last delivered half not yet released */
+    BspSpiStreamStats_t tStreamStats;  /**< Stream counters */
+
+    /* Slave mode */
+    bool bSlave; /**< Bus runs in slave mode (state in s_spiSlave) */
+
+    /* Transfer statistics */
+    bool          bStats;         /**< Counting enabled */
+    volatile bool bStatTiming;    /**< A counted transfer is in flight */
+    uint32_t      uStatRequestUs; /**< Request time of the transfer in flight */
+    uint32_t      uStatStartUs;   /**< Start time of the transfer in flight */
+    uint32_t      uStatBytes;     /**< Length of the transfer in flight */
+    BspSpiStats_t tStats;         /**< Transfer counters */
 } BspSpiModule_t;
 
 /* --- Private Variables --- */
@@ -42,6 +154,18 @@ typedef struct
 /** Array of SPI module instances */
 static BspSpiModule_t s_spiModules[BSP_SPI_MAX_INSTANCES] = {0};
 
+/** Array of devices on shared buses */
+static BspSpiDevice_t s_spiDevices[BSP_SPI_MAX_DEVICES] = {0};
+
+/** Slave mode state */
+static BspSpiSlave_t s_spiSlave = {0};
+
+/** Allocated module of each instance, NULL if free (routes HAL callbacks without a search) */
+static BspSpiModule_t* s_spiModuleOfInstance[eBSP_SPI_INSTANCE_COUNT] = {0};
+
+/** Timebase of the busy time and latency counters, NULL if not set */
+static BspSpiTimebase_t s_pfnSpiMicros = NULL;
+
 /* --- External HAL Handles --- */
 
 extern SPI_HandleTypeDef hspi1;
@@ -77,14 +201,492 @@ static uint8_t sBspSpiFindModuleIndex(BspSpiHandle_t handle);
  */
 static BspSpiModule_t* sBspSpiValidateHandle(BspSpiHandle_t handle);
 
+/**
+ * Gets the SPI instance of a HAL handle (inverse of sBspSpiGetHalHandle()).
+ *
+ * @param pHalHandle Pointer to the HAL SPI handle
+ * @return The instance, or eBSP_SPI_INSTANCE_COUNT for an unknown handle
+ */
+static BspSpiInstance_e sBspSpiGetInstance(const SPI_HandleTypeDef* pHalHandle);
+
 /**
  * Finds a module by HAL handle (used in HAL callbacks).
+ * No module scan: the handle is compared against the six HAL handles to get its instance,
+ * which indexes the module allocated for it.
  *
  * @param pHalHandle Pointer to the HAL SPI handle
  * @return Pointer to the module, or NULL if not found
  */
 static BspSpiModule_t* sBspSpiFindModuleByHalHandle(SPI_HandleTypeDef* pHalHandle);
 
+/**
+ * Starts a DMA transfer; the direction follows from which buffers are set.
+ *
+ * @param pModule The SPI module
+ * @param pTxData Data to transmit, or NULL
+ * @param pRxData Receive buffer, or NULL
+ * @param uLength Length in bytes (at most BSP_SPI_MAX_CHUNK frames)
+ * @return HAL status of the start
+ */
+static HAL_StatusTypeDef sBspSpiStartDma(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength);
+
+/**
+ * Starts a transfer of any length: the first chunk is started here, the
+ * following ones from the completion interrupt.
+ *
+ * @param pModule The SPI module
+ * @param pTxData Data to transmit, or NULL
+ * @param pRxData Receive buffer, or NULL
+ * @param uLength Length in bytes
+ * @return HAL status of the first chunk start
+ */
+static HAL_StatusTypeDef sBspSpiStartChunked(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength);
+
+/**
+ * Starts a segment list: the first chunk of the first segment is started here,
+ * the rest from the completion interrupt.
+ *
+ * @param pModule The SPI module
+ * @param pSegments Segment list (validated)
+ * @param uCount Number of segments
+ * @return HAL status of the first chunk start
+ */
+static HAL_StatusTypeDef sBspSpiStartSegments(BspSpiModule_t* pModule, const BspSpiSegment_t* pSegments, uint32_t uCount);
+
+/**
+ * Starts a chunked transfer that sends the same frame throughout.
+ * The TX DMA stream reads the pattern from a single word with memory increment
+ * disabled; it is re-enabled by sBspSpiEndFill() when the transfer ends.
+ *
+ * @param pModule Pointer to the SPI module
+ * @param uPattern Frame to send (low byte with 8-bit frames)
+ * @param pRxData Receive buffer, or NULL to leave the received frames unread
+ * @param uLength Total length in bytes
+ * @return HAL status of the first chunk, HAL_BUSY while HAL is not ready
+ */
+static HAL_StatusTypeDef sBspSpiStartFill(BspSpiModule_t* pModule, uint16_t uPattern, uint8_t* pRxData, uint32_t uLength);
+
+/**
+ * Ends a constant-fill transfer: restores memory increment on the TX DMA stream.
+ * Does nothing when no fill transfer is active.
+ *
+ * @param pModule Pointer to the SPI module
+ */
+static void sBspSpiEndFill(BspSpiModule_t* pModule);
+
+/**
+ * Enables or disables memory increment on the TX DMA stream of a HAL handle.
+ * The stream must be disabled; handles without a TX DMA stream are left alone.
+ *
+ * @param pHal HAL SPI handle
+ * @param bIncrement true to step through the source buffer
+ */
+static void sBspSpiSetTxMemInc(const SPI_HandleTypeDef* pHal, bool bIncrement);
+
+/**
+ * Switches the RX and TX DMA streams of a HAL handle between circular and normal mode.
+ * Streaming and slave mode run circular; every other transfer needs normal mode,
+ * or HAL never closes it and the handle stays busy. The streams must be disabled.
+ *
+ * @param pHal HAL SPI handle
+ * @param bCircular true for circular mode
+ */
+static void sBspSpiSetDmaCircular(const SPI_HandleTypeDef* pHal, bool bCircular);
+
+/**
+ * Validates and starts a direct constant-fill transfer (BspSpiTransmitFillDMA/BspSpiReceiveFillDMA).
+ *
+ * @param handle The SPI handle
+ * @param uPattern Frame to send
+ * @param pRxData Receive buffer, or NULL for transmit only
+ * @param uLength Length in bytes
+ * @return Error code indicating success or failure
+ */
+static BspSpiError_e sBspSpiFillDirect(BspSpiHandle_t handle, uint16_t uPattern, uint8_t* pRxData, uint32_t uLength);
+
+/**
+ * Checks whether the transfer in flight has further chunks or segments.
+ *
+ * @param pModule The SPI module
+ * @return true if more DMA starts are needed before the transfer completes
+ */
+static bool sBspSpiHasNextPiece(const BspSpiModule_t* pModule);
+
+/**
+ * Starts the next chunk of the transfer in flight, moving on to the next
+ * segment when the current one is done.
+ *
+ * @param pModule The SPI module
+ * @return HAL status of the chunk start
+ */
+static HAL_StatusTypeDef sBspSpiStartNextPiece(BspSpiModule_t* pModule);
+
+/**
+ * Drops the remaining chunks and segments of the transfer in flight.
+ *
+ * @param pModule The SPI module
+ */
+static void sBspSpiAbortPieces(BspSpiModule_t* pModule);
+
+/**
+ * Starts the next chunk of the transfer in flight.
+ *
+ * @param pModule The SPI module
+ * @return HAL status of the chunk start
+ */
+static HAL_StatusTypeDef sBspSpiStartChunk(BspSpiModule_t* pModule);
+
+/**
+ * Gets the bytes per frame of the bus' current frame format.
+ *
+ * @param pModule The SPI module
+ * @return 1 for 8-bit frames, 2 for 16-bit frames
+ */
+static uint32_t sBspSpiFrameBytes(const BspSpiModule_t* pModule);
+
+/**
+ * Checks that buffers and length are whole, aligned frames.
+ *
+ * @param uFrameBytes Bytes per frame (1 or 2)
+ * @param pTxData Data to transmit, or NULL
+ * @param pRxData Receive buffer, or NULL
+ * @param uLength Length in bytes
+ * @return true if the length is a multiple of the frame size and both buffers are aligned to it
+ */
+static bool sBspSpiFitsFrame(uint32_t uFrameBytes, const uint8_t* pTxData, const uint8_t* pRxData, uint32_t uLength);
+
+/**
+ * Converts a frame format to CR1 bits.
+ *
+ * @param eDataSize Frame size (validated)
+ * @param uCrcPolynomial CRC polynomial, 0 for no CRC
+ * @return DFF and CRCEN bits
+ */
+static uint32_t sBspSpiFormatBits(BspSpiDataSize_e eDataSize, uint16_t uCrcPolynomial);
+
+/**
+ * Writes CR1 bits (and the CRC polynomial) with the peripheral disabled and
+ * brings the HAL configuration and the DMA transfer width in line.
+ *
+ * @param pModule The SPI module
+ * @param uMask CR1 bits to replace
+ * @param uCr1Bits New values of the bits in uMask
+ * @param uCrcPoly CRC polynomial, written when uCr1Bits has SPI_CR1_CRCEN
+ */
+static void sBspSpiApplyCr1(BspSpiModule_t* pModule, uint32_t uMask, uint32_t uCr1Bits, uint16_t uCrcPoly);
+
+/**
+ * Sets the peripheral and memory width of the TX and RX DMA streams to the
+ * HAL frame size (streams must be disabled).
+ *
+ * @param pHal The HAL SPI handle
+ */
+static void sBspSpiSyncDmaWidth(const SPI_HandleTypeDef* pHal);
+
+/**
+ * Maps the HAL error code of a failed transfer to a BSP error code.
+ *
+ * @param pHal The HAL SPI handle
+ * @return eBSP_SPI_ERR_CRC for a CRC mismatch, otherwise eBSP_SPI_ERR_TRANSFER
+ */
+static BspSpiError_e sBspSpiHalError(const SPI_HandleTypeDef* pHal);
+
+/**
+ * Checks whether a transfer can take the polled short-transfer path.
+ *
+ * @param pModule The SPI module
+ * @param uLength Length in bytes
+ * @return true if the path is enabled for this length, the frames are 8-bit without CRC and HAL is idle
+ */
+static bool sBspSpiFastPathApplies(const BspSpiModule_t* pModule, uint32_t uLength);
+
+/**
+ * Runs a short full-duplex transfer by polling the data and status registers.
+ *
+ * @param pModule The SPI module
+ * @param pTxData Data to transmit, or NULL to send 0xFF
+ * @param pRxData Receive buffer, or NULL to discard
+ * @param uLength Length in bytes
+ * @return eBSP_SPI_ERR_TIMEOUT if a flag never came, otherwise eBSP_SPI_ERR_NONE
+ */
+static BspSpiError_e sBspSpiPolled(const BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength);
+
+/**
+ * Runs a direct DMA-mode transfer on the polled path and reports its completion.
+ *
+ * @param pModule The SPI module
+ * @param pTxData Data to transmit, or NULL
+ * @param pRxData Receive buffer, or NULL
+ * @param uLength Length in bytes
+ * @param pDoneCb Registered completion callback of the transfer type
+ * @return Error code of the polled transfer
+ */
+static BspSpiError_e sBspSpiPolledDma(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength,
+                                      BspSpiTxCpltCb_t pDoneCb);
+
+/**
+ * Runs a blocking transfer of any length, on the polled path if it applies.
+ *
+ * @param pModule The SPI module
+ * @param pTxData Data to transmit, or NULL
+ * @param pRxData Receive buffer, or NULL
+ * @param uLength Length in bytes
+ * @return Error code of the first failing chunk, or eBSP_SPI_ERR_NONE
+ */
+static BspSpiError_e sBspSpiBlocking(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength);
+
+/**
+ * Runs the HAL blocking calls of a transfer in chunks HAL accepts.
+ *
+ * @param pModule The SPI module
+ * @param pTxData Data to transmit, or NULL
+ * @param pRxData Receive buffer, or NULL
+ * @param uLength Length in bytes, a whole number of frames
+ * @return Error code of the first failing chunk, or eBSP_SPI_ERR_NONE
+ */
+static BspSpiError_e sBspSpiBlockingChunks(const BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength);
+
+/**
+ * Common DMA completion handling: stream halves, next chunk, queue chaining
+ * or the registered direct-mode callback.
+ *
+ * @param pModule The SPI module
+ * @param pDirectCb Registered callback for the completed direct transfer type
+ */
+static void sBspSpiOnDmaDone(BspSpiModule_t* pModule, BspSpiTxCpltCb_t pDirectCb);
+
+/**
+ * Common DMA error handling: ends streams and chunked transfers, completes
+ * the queued transfer with an error or calls the registered error callback.
+ *
+ * @param pModule The SPI module
+ * @param eError Error to report
+ */
+static void sBspSpiOnDmaError(BspSpiModule_t* pModule, BspSpiError_e eError);
+
+/**
+ * Empties the transaction queue and clears its statistics.
+ *
+ * @param pModule The SPI module
+ */
+static void sBspSpiQueueReset(BspSpiModule_t* pModule);
+
+/**
+ * Validates a device handle and returns the device pointer.
+ *
+ * @param hDevice The device handle to validate
+ * @return Pointer to the device, or NULL if invalid
+ */
+static BspSpiDevice_t* sBspSpiValidateDevice(BspSpiDeviceHandle_t hDevice);
+
+/**
+ * Validates a transfer descriptor for the transaction queue.
+ *
+ * @param pXfer The transfer descriptor
+ * @param uFrameBytes Bytes per frame of the target format
+ * @return true if the descriptor can be queued
+ */
+static bool sBspSpiValidateXfer(const BspSpiXfer_t* pXfer, uint32_t uFrameBytes);
+
+/**
+ * Validates a segment list.
+ *
+ * @param pSegments Segment list
+ * @param uCount Number of segments
+ * @param uFrameBytes Bytes per frame of the target format
+ * @return true if every segment has a buffer and a non-zero length of whole frames
+ */
+static bool sBspSpiValidateSegments(const BspSpiSegment_t* pSegments, uint32_t uCount, uint32_t uFrameBytes);
+
+/**
+ * Appends a transfer to the queue and starts it if the bus is idle.
+ *
+ * @param pModule The SPI module (DMA mode)
+ * @param pXfer The transfer descriptor
+ * @param hDevice Target device, or -1 for a bus transfer
+ * @return Error code; eBSP_SPI_ERR_BUSY if the queue is full
+ */
+static BspSpiError_e sBspSpiQueuePush(BspSpiModule_t* pModule, const BspSpiXfer_t* pXfer, BspSpiDeviceHandle_t hDevice);
+
+/**
+ * Removes the queue head and releases its device chip select, or keeps it
+ * asserted and reserves the bus for the device when the transfer holds it.
+ *
+ * @param pModule The SPI module
+ * @return The removed entry
+ */
+static BspSpiQueueEntry_t sBspSpiQueuePop(BspSpiModule_t* pModule);
+
+/**
+ * Releases the chip select of the device holding the bus, if any.
+ *
+ * @param pModule The SPI module
+ */
+static void sBspSpiReleaseHold(BspSpiModule_t* pModule);
+
+/**
+ * Moves the oldest queued transfer of the holding device to the queue head.
+ * Transfers of other devices keep their order behind it.
+ *
+ * @param pModule The SPI module (bus held)
+ * @return true if the holding device has a transfer queued
+ */
+static bool sBspSpiQueueHeldFirst(BspSpiModule_t* pModule);
+
+/**
+ * Clocks one frame of ones with every chip select released, for devices that
+ * drive MISO until the next clock. The queue continues from the completion
+ * interrupt.
+ *
+ * @param pModule The SPI module
+ */
+static void sBspSpiDeselectClock(BspSpiModule_t* pModule);
+
+/**
+ * Checks whether queued transfers, a held device, streams or an unfinished
+ * chunked/segmented transfer own the bus.
+ *
+ * @param pModule The SPI module
+ * @return true if a direct transfer must wait
+ */
+static bool sBspSpiBusClaimed(const BspSpiModule_t* pModule);
+
+/**
+ * Applies the device clock mode, prescaler and frame format if they differ
+ * from the current bus settings, then asserts the device chip select.
+ *
+ * @param pModule The SPI module
+ * @param pDevice The device
+ */
+static void sBspSpiDeviceSelect(BspSpiModule_t* pModule, const BspSpiDevice_t* pDevice);
+
+/**
+ * Delivers a filled stream half to the consumer and tracks overruns.
+ *
+ * @param pModule The streaming SPI module
+ * @param pHalf The half that has just been filled
+ */
+static void sBspSpiStreamEvent(BspSpiModule_t* pModule, const uint8_t* pHalf);
+
+/**
+ * Checks whether circular DMA (stream or slave mode) owns the bus.
+ *
+ * @param pModule The SPI module
+ * @return true while streaming or in slave mode
+ */
+static bool sBspSpiIsCircular(const BspSpiModule_t* pModule);
+
+/**
+ * Validates a handle of the bus in slave mode.
+ *
+ * @param handle The SPI handle
+ * @param pError Output: error code if the handle is not in slave mode
+ * @return Pointer to the module, or NULL
+ */
+static BspSpiModule_t* sBspSpiSlaveValidate(BspSpiHandle_t handle, BspSpiError_e* pError);
+
+/**
+ * Chip-select rising edge (EXTI): ends the frame, queues the message and
+ * accounts for the transmitted bytes.
+ */
+static void sBspSpiSlaveOnCsRise(void);
+
+/**
+ * Removes the oldest queued message.
+ */
+static void sBspSpiSlaveDropOldest(void);
+
+/**
+ * Refills the transmit bytes consumed by a frame and tracks underruns.
+ *
+ * @param uStart Ring offset of the frame
+ * @param uLength Frame length in bytes
+ */
+static void sBspSpiSlaveTxConsume(uint32_t uStart, uint32_t uLength);
+
+/**
+ * Claims the queue head for starting: sets bQueueActive if the head may go
+ * out now. Call with interrupts disabled, so the caller and a completion
+ * interrupt never both start it.
+ *
+ * @param pModule The SPI module
+ * @return true if the caller now owns the start of the queue head
+ */
+static bool sBspSpiQueueClaim(BspSpiModule_t* pModule);
+
+/**
+ * Starts pending queued transfers until one is in flight or the queue is empty.
+ * Transfers that fail to start are completed with eBSP_SPI_ERR_TRANSFER.
+ * Call with interrupts enabled: only the claim runs under the lock, HAL
+ * starts and callbacks run outside it.
+ *
+ * @param pModule The SPI module
+ */
+static void sBspSpiQueueStartNext(BspSpiModule_t* pModule);
+
+/**
+ * Completes the in-flight queued transfer, starts the next one and then
+ * invokes the completed transfer's callback (ISR context).
+ *
+ * @param pModule The SPI module
+ * @param eError Transfer result
+ */
+static void sBspSpiQueueOnDone(BspSpiModule_t* pModule, BspSpiError_e eError);
+
+/**
+ * Checks the bus and starts a direct DMA-mode transfer, on the polled path if it applies.
+ *
+ * @param pModule The SPI module
+ * @param pTxData Data to transmit, or NULL
+ * @param pRxData Receive buffer, or NULL
+ * @param uLength Length in bytes
+ * @param pDoneCb Registered completion callback of the transfer type (polled path)
+ * @return Error code; eBSP_SPI_ERR_BUSY if the bus is in use
+ */
+static BspSpiError_e sBspSpiStartDirect(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength,
+                                        BspSpiTxCpltCb_t pDoneCb);
+
+/**
+ * Reads the statistics timebase.
+ *
+ * @return Microseconds, or 0 without a timebase
+ */
+static uint32_t sBspSpiStatsNow(void);
+
+/**
+ * Total length of a segment list.
+ *
+ * @param pSegments Segment list
+ * @param uCount Number of segments
+ * @return Length in bytes
+ */
+static uint32_t sBspSpiSegmentBytes(const BspSpiSegment_t* pSegments, uint32_t uCount);
+
+/**
+ * Marks a transfer as in flight for the statistics, requested and started now.
+ * Call before starting the DMA, the completion interrupt may come before HAL returns.
+ *
+ * @param pModule The SPI module
+ * @param uBytes Transfer length in bytes
+ * @return true if marked; false if counting is off or a direct transfer is still marked (the start will fail with HAL_BUSY)
+ */
+static bool sBspSpiStatsBegin(BspSpiModule_t* pModule, uint32_t uBytes);
+
+/**
+ * Counts the end of the transfer marked by sBspSpiStatsBegin(); no effect if none is marked.
+ *
+ * @param pModule The SPI module
+ * @param eError Result; eBSP_SPI_ERR_BUSY drops the mark without counting (transfer not started)
+ */
+static void sBspSpiStatsEnd(BspSpiModule_t* pModule, BspSpiError_e eError);
+
+/**
+ * Counts a transfer refused with eBSP_SPI_ERR_BUSY.
+ *
+ * @param pModule The SPI module
+ */
+static void sBspSpiStatsReject(BspSpiModule_t* pModule);
+
 /* --- Private Helper Functions --- */
 
 static SPI_HandleTypeDef* sBspSpiGetHalHandle(BspSpiInstance_e eInstance)
@@ -144,74 +746,1614 @@ static BspSpiModule_t* sBspSpiValidateHandle(BspSpiHandle_t handle)
     return &s_spiModules[index];
 }
 
-static BspSpiModule_t* sBspSpiFindModuleByHalHandle(SPI_HandleTypeDef* pHalHandle)
+static BspSpiInstance_e sBspSpiGetInstance(const SPI_HandleTypeDef* pHalHandle)
 {
-    if (pHalHandle == NULL)
+    BspSpiInstance_e eInstance = eBSP_SPI_INSTANCE_COUNT;
+
+    if (pHalHandle == &hspi1)
     {
-        return NULL;
+        eInstance = eBSP_SPI_INSTANCE_1;
     }
-
-    for (uint8_t i = 0u; i < BSP_SPI_MAX_INSTANCES; i++)
+    else if (pHalHandle == &hspi2)
     {
-        if (s_spiModules[i].bAllocated && (s_spiModules[i].pHalHandle == pHalHandle))
-        {
-            return &s_spiModules[i];
-        }
+        eInstance = eBSP_SPI_INSTANCE_2;
     }
-
-    return NULL;
-}
-
-/* --- Public Functions --- */
-
-BspSpiHandle_t BspSpiAllocate(BspSpiInstance_e eInstance, BspSpiMode_e eMode, uint32_t uTimeoutMs)
+    else if (pHalHandle == &hspi3)
+    {
+        eInstance = eBSP_SPI_INSTANCE_3;
+    }
+    else if (pHalHandle == &hspi4)
+    {
+        eInstance = eBSP_SPI_INSTANCE_4;
+    }
+    else if (pHalHandle == &hspi5)
+    {
+        eInstance = eBSP_SPI_INSTANCE_5;
+    }
+    else if (pHalHandle == &hspi6)
+    {
+        eInstance = eBSP_SPI_INSTANCE_6;
+    }
+
+    return eInstance;
+}
+
+static BspSpiModule_t* sBspSpiFindModuleByHalHandle(SPI_HandleTypeDef* pHalHandle)
 {
-    /* Validate parameters */
-    if (eInstance >= eBSP_SPI_INSTANCE_COUNT)
+    BspSpiInstance_e eInstance = sBspSpiGetInstance(pHalHandle);
+
+    return (eInstance < eBSP_SPI_INSTANCE_COUNT) ? s_spiModuleOfInstance[eInstance] : NULL;
+}
+
+static HAL_StatusTypeDef sBspSpiStartDma(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+{
+    /* HAL counts frames */
+    uint16_t uFrames = (uint16_t)(uLength / sBspSpiFrameBytes(pModule));
+
+    if (pRxData == NULL)
     {
-        return BSP_SPI_INVALID_HANDLE;
+        return HAL_SPI_Transmit_DMA(pModule->pHalHandle, (uint8_t*)pTxData, uFrames);
+    }
+    if (pTxData == NULL)
+    {
+        return HAL_SPI_Receive_DMA(pModule->pHalHandle, pRxData, uFrames);
     }
+    return HAL_SPI_TransmitReceive_DMA(pModule->pHalHandle, (uint8_t*)pTxData, pRxData, uFrames);
+}
 
-    /* Get HAL handle for this instance */
-    SPI_HandleTypeDef* pHalHandle = sBspSpiGetHalHandle(eInstance);
-    if (pHalHandle == NULL)
+static HAL_StatusTypeDef sBspSpiStartChunked(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+{
+    pModule->pChunkTx        = pTxData;
+    pModule->pChunkRx        = pRxData;
+    pModule->uChunkRemaining = uLength;
+    pModule->uSegRemaining   = 0u;
+
+    return sBspSpiStartChunk(pModule);
+}
+
+static HAL_StatusTypeDef sBspSpiStartSegments(BspSpiModule_t* pModule, const BspSpiSegment_t* pSegments, uint32_t uCount)
+{
+    pModule->pSegNext        = pSegments;
+    pModule->uSegRemaining   = uCount;
+    pModule->uChunkRemaining = 0u;
+
+    return sBspSpiStartNextPiece(pModule);
+}
+
+static HAL_StatusTypeDef sBspSpiStartFill(BspSpiModule_t* pModule, uint16_t uPattern, uint8_t* pRxData, uint32_t uLength)
+{
+    /* The stream configuration is locked while a transfer is running */
+    if (pModule->pHalHandle->State != HAL_SPI_STATE_READY)
     {
-        return BSP_SPI_INVALID_HANDLE;
+        return HAL_BUSY;
     }
 
-    /* Check if this instance is already allocated */
-    for (uint8_t i = 0u; i < BSP_SPI_MAX_INSTANCES; i++)
+    pModule->uFillWord  = uPattern;
+    pModule->bChunkFill = true;
+    sBspSpiSetTxMemInc(pModule->pHalHandle, false);
+
+    HAL_StatusTypeDef halStatus = sBspSpiStartChunked(pModule, (const uint8_t*)&pModule->uFillWord, pRxData, uLength);
+
+    if (halStatus != HAL_OK)
+    {
+        sBspSpiEndFill(pModule);
+    }
+
+    return halStatus;
+}
+
+static void sBspSpiEndFill(BspSpiModule_t* pModule)
+{
+    if (pModule->bChunkFill)
     {
-        if (s_spiModules[i].bAllocated && (s_spiModules[i].eInstance == eInstance))
+        pModule->bChunkFill = false;
+        sBspSpiSetTxMemInc(pModule->pHalHandle, true);
+    }
+}
+
+static void sBspSpiSetTxMemInc(const SPI_HandleTypeDef* pHal, bool bIncrement)
+{
+    if ((pHal->hdmatx != NULL) && (pHal->hdmatx->Instance != NULL))
+    {
+        DMA_Stream_TypeDef* pStream = (DMA_Stream_TypeDef*)pHal->hdmatx->Instance;
+        pStream->CR                 = bIncrement ? (pStream->CR | DMA_SxCR_MINC) : (pStream->CR & ~DMA_SxCR_MINC);
+    }
+}
+
+static void sBspSpiSetDmaCircular(const SPI_HandleTypeDef* pHal, bool bCircular)
+{
+    DMA_HandleTypeDef* apDma[2] = {pHal->hdmatx, pHal->hdmarx};
+
+    for (uint8_t i = 0u; i < 2u; i++)
+    {
+        if ((apDma[i] != NULL) && (apDma[i]->Instance != NULL))
         {
-            return BSP_SPI_INVALID_HANDLE;
+            DMA_Stream_TypeDef* pStream = (DMA_Stream_TypeDef*)apDma[i]->Instance;
+            pStream->CR                 = bCircular ? (pStream->CR | DMA_SxCR_CIRC) : (pStream->CR & ~DMA_SxCR_CIRC);
         }
     }
+}
 
-    /* Find a free slot */
-    for (uint8_t i = 0u; i < BSP_SPI_MAX_INSTANCES; i++)
+static BspSpiError_e sBspSpiFillDirect(BspSpiHandle_t handle, uint16_t uPattern, uint8_t* pRxData, uint32_t uLength)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
     {
-        if (!s_spiModules[i].bAllocated)
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if ((uLength == 0u) || !sBspSpiFitsFrame(sBspSpiFrameBytes(pModule), NULL, pRxData, uLength))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_SPI_MODE_DMA)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    /* Queued transfers, streams and unfinished chunked/segmented transfers own the bus */
+    if (sBspSpiBusClaimed(pModule))
+    {
+        sBspSpiStatsReject(pModule);
+        return eBSP_SPI_ERR_BUSY;
+    }
+
+    bool              bTimed    = sBspSpiStatsBegin(pModule, uLength);
+    HAL_StatusTypeDef halStatus = sBspSpiStartFill(pModule, uPattern, pRxData, uLength);
+
+    if ((halStatus != HAL_OK) && bTimed)
+    {
+        sBspSpiStatsEnd(pModule, (halStatus == HAL_BUSY) ? eBSP_SPI_ERR_BUSY : eBSP_SPI_ERR_TRANSFER);
+    }
+
+    if (halStatus == HAL_BUSY)
+    {
+        sBspSpiStatsReject(pModule);
+        return eBSP_SPI_ERR_BUSY;
+    }
+    else if (halStatus != HAL_OK)
+    {
+        return eBSP_SPI_ERR_TRANSFER;
+    }
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+static bool sBspSpiHasNextPiece(const BspSpiModule_t* pModule)
+{
+    return (pModule->uChunkRemaining > 0u) || (pModule->uSegRemaining > 0u);
+}
+
+static HAL_StatusTypeDef sBspSpiStartNextPiece(BspSpiModule_t* pModule)
+{
+    if (pModule->uChunkRemaining == 0u)
+    {
+        const BspSpiSegment_t* pSeg = pModule->pSegNext;
+
+        pModule->pSegNext++;
+        pModule->uSegRemaining--;
+        pModule->pChunkTx        = pSeg->pTxData;
+        pModule->pChunkRx        = pSeg->pRxData;
+        pModule->uChunkRemaining = pSeg->uLength;
+    }
+
+    return sBspSpiStartChunk(pModule);
+}
+
+static void sBspSpiAbortPieces(BspSpiModule_t* pModule)
+{
+    pModule->uChunkRemaining = 0u;
+    pModule->uSegRemaining   = 0u;
+}
+
+static HAL_StatusTypeDef sBspSpiStartChunk(BspSpiModule_t* pModule)
+{
+    uint32_t       uMax    = BSP_SPI_MAX_CHUNK * sBspSpiFrameBytes(pModule);
+    uint32_t       uChunk  = (pModule->uChunkRemaining > uMax) ? uMax : pModule->uChunkRemaining;
+    const uint8_t* pTxData = pModule->pChunkTx;
+    uint8_t*       pRxData = pModule->pChunkRx;
+
+    /* Advance before starting: the chunk may complete before HAL returns */
+    pModule->uChunkRemaining -= uChunk;
+    pModule->pChunkTx = ((pTxData != NULL) && !pModule->bChunkFill) ? &pTxData[uChunk] : pTxData;
+    pModule->pChunkRx = (pRxData != NULL) ? &pRxData[uChunk] : NULL;
+
+    HAL_StatusTypeDef halStatus = sBspSpiStartDma(pModule, pTxData, pRxData, uChunk);
+
+    if (halStatus != HAL_OK)
+    {
+        sBspSpiAbortPieces(pModule);
+    }
+
+    return halStatus;
+}
+
+static uint32_t sBspSpiFrameBytes(const BspSpiModule_t* pModule)
+{
+    return (pModule->pHalHandle->Init.DataSize == SPI_DATASIZE_16BIT) ? 2u : 1u;
+}
+
+static bool sBspSpiFitsFrame(uint32_t uFrameBytes, const uint8_t* pTxData, const uint8_t* pRxData, uint32_t uLength)
+{
+    uint32_t uMisaligned = uLength | (uint32_t)(uintptr_t)pTxData | (uint32_t)(uintptr_t)pRxData;
+
+    return (uMisaligned & (uFrameBytes - 1u)) == 0u;
+}
+
+static uint32_t sBspSpiFormatBits(BspSpiDataSize_e eDataSize, uint16_t uCrcPolynomial)
+{
+    uint32_t uCr1Bits = (eDataSize == eBSP_SPI_DATA_SIZE_16BIT) ? SPI_CR1_DFF : 0u;
+
+    if (uCrcPolynomial != 0u)
+    {
+        uCr1Bits |= SPI_CR1_CRCEN;
+    }
+
+    return uCr1Bits;
+}
+
+static void sBspSpiApplyCr1(BspSpiModule_t* pModule, uint32_t uMask, uint32_t uCr1Bits, uint16_t uCrcPoly)
+{
+    SPI_HandleTypeDef* pHal      = pModule->pHalHandle;
+    SPI_TypeDef*       pSpi      = pHal->Instance;
+    uint32_t           uDataSize = pHal->Init.DataSize;
+
+    /* CPOL/CPHA/BR/DFF/CRCEN may only change with the peripheral disabled; HAL re-enables it on the next start */
+    pSpi->CR1 &= ~SPI_CR1_SPE;
+    pSpi->CR1 = (pSpi->CR1 & ~uMask) | uCr1Bits;
+
+    if ((uCr1Bits & SPI_CR1_CRCEN) != 0u)
+    {
+        pSpi->CRCPR              = uCrcPoly;
+        pHal->Init.CRCPolynomial = uCrcPoly;
+    }
+
+    /* HAL resets and reads back the CRC and sizes blocking transfers from its configuration */
+    pHal->Init.CLKPolarity       = pSpi->CR1 & SPI_CR1_CPOL;
+    pHal->Init.CLKPhase          = pSpi->CR1 & SPI_CR1_CPHA;
+    pHal->Init.BaudRatePrescaler = pSpi->CR1 & SPI_CR1_BR;
+    pHal->Init.DataSize          = ((pSpi->CR1 & SPI_CR1_DFF) != 0u) ? SPI_DATASIZE_16BIT : SPI_DATASIZE_8BIT;
+    pHal->Init.CRCCalculation    = ((pSpi->CR1 & SPI_CR1_CRCEN) != 0u) ? SPI_CRCCALCULATION_ENABLE : SPI_CRCCALCULATION_DISABLE;
+
+    if (pHal->Init.DataSize != uDataSize)
+    {
+        sBspSpiSyncDmaWidth(pHal);
+    }
+}
+
+static void sBspSpiSyncDmaWidth(const SPI_HandleTypeDef* pHal)
+{
+    DMA_HandleTypeDef* apDma[2] = {pHal->hdmatx, pHal->hdmarx};
+    uint32_t           uWidth   = (pHal->Init.DataSize == SPI_DATASIZE_16BIT) ? (DMA_SxCR_PSIZE_0 | DMA_SxCR_MSIZE_0) : 0u;
+
+    for (uint8_t i = 0u; i < 2u; i++)
+    {
+        if ((apDma[i] != NULL) && (apDma[i]->Instance != NULL))
         {
-            /* Initialize the module */
-            s_spiModules[i].eInstance   = eInstance;
-            s_spiModules[i].pHalHandle  = pHalHandle;
-            s_spiModules[i].eMode       = eMode;
-            s_spiModules[i].uTimeoutMs  = (uTimeoutMs == 0u) ? BSP_SPI_DEFAULT_TIMEOUT_MS : uTimeoutMs;
-            s_spiModules[i].bAllocated  = true;
-            s_spiModules[i].pTxCpltCb   = NULL;
-            s_spiModules[i].pRxCpltCb   = NULL;
-            s_spiModules[i].pTxRxCpltCb = NULL;
-            s_spiModules[i].pErrorCb    = NULL;
+            DMA_Stream_TypeDef* pStream = (DMA_Stream_TypeDef*)apDma[i]->Instance;
+            pStream->CR                 = (pStream->CR & ~(DMA_SxCR_PSIZE | DMA_SxCR_MSIZE)) | uWidth;
+        }
+    }
+}
+
+static BspSpiError_e sBspSpiHalError(const SPI_HandleTypeDef* pHal)
+{
+    return ((pHal->ErrorCode & HAL_SPI_ERROR_CRC) != 0u) ? eBSP_SPI_ERR_CRC : eBSP_SPI_ERR_TRANSFER;
+}
+
+static bool sBspSpiFastPathApplies(const BspSpiModule_t* pModule, uint32_t uLength)
+{
+    const SPI_InitTypeDef* pInit = &pModule->pHalHandle->Init;
+
+    /* The polled loop moves bytes and knows nothing of the CRC phase */
+    return (uLength <= pModule->byFastMax) && (uLength > 0u) && (pModule->pHalHandle->State == HAL_SPI_STATE_READY) &&
+           (pInit->DataSize == SPI_DATASIZE_8BIT) && (pInit->CRCCalculation != SPI_CRCCALCULATION_ENABLE);
+}
+
+static BspSpiError_e sBspSpiPolled(const BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+{
+    SPI_TypeDef* pSpi = pModule->pHalHandle->Instance;
+    uint32_t     uSpin;
+
+    /* HAL leaves SPE set after its first transfer; enable it if no transfer ran yet */
+    if (LL_SPI_IsEnabled(pSpi) == 0u)
+    {
+        LL_SPI_Enable(pSpi);
+    }
+
+    /* One byte in flight: once RXNE is set the transmit buffer is empty again */
+    for (uint32_t i = 0u; i < uLength; i++)
+    {
+        LL_SPI_TransmitData8(pSpi, (pTxData != NULL) ? pTxData[i] : 0xFFu);
+
+        uSpin = BSP_SPI_FAST_PATH_SPIN_LIMIT;
+        while (LL_SPI_IsActiveFlag_RXNE(pSpi) == 0u)
+        {
+            if (--uSpin == 0u)
+            {
+                return eBSP_SPI_ERR_TIMEOUT;
+            }
+        }
+
+        /* Always read DR, a transmit-only transfer must not leave an overrun behind */
+        uint8_t byRx = LL_SPI_ReceiveData8(pSpi);
+        if (pRxData != NULL)
+        {
+            pRxData[i] = byRx;
+        }
+    }
+
+    /* Last clock edge done before the caller releases CS */
+    uSpin = BSP_SPI_FAST_PATH_SPIN_LIMIT;
+    while (LL_SPI_IsActiveFlag_BSY(pSpi) != 0u)
+    {
+        if (--uSpin == 0u)
+        {
+            return eBSP_SPI_ERR_TIMEOUT;
+        }
+    }
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+static BspSpiError_e sBspSpiPolledDma(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength,
+                                      BspSpiTxCpltCb_t pDoneCb)
+{
+    (void)sBspSpiStatsBegin(pModule, uLength);
+    BspSpiError_e eError = sBspSpiPolled(pModule, pTxData, pRxData, uLength);
+    sBspSpiStatsEnd(pModule, eError);
+
+    if ((eError == eBSP_SPI_ERR_NONE) && (pDoneCb != NULL))
+    {
+        BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
+        pDoneCb(handle);
+    }
+
+    return eError;
+}
+
+static BspSpiError_e sBspSpiBlocking(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+{
+    BspSpiError_e eError;
+
+    if (!sBspSpiFitsFrame(sBspSpiFrameBytes(pModule), pTxData, pRxData, uLength))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    (void)sBspSpiStatsBegin(pModule, uLength);
+
+    if (sBspSpiFastPathApplies(pModule, uLength))
+    {
+        eError = sBspSpiPolled(pModule, pTxData, pRxData, uLength);
+    }
+    else
+    {
+        eError = sBspSpiBlockingChunks(pModule, pTxData, pRxData, uLength);
+    }
+
+    sBspSpiStatsEnd(pModule, eError);
+    return eError;
+}
+
+static BspSpiError_e sBspSpiBlockingChunks(const BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+{
+    uint32_t uOffset     = 0u;
+    uint32_t uFrameBytes = sBspSpiFrameBytes(pModule);
+    uint32_t uMax        = BSP_SPI_MAX_CHUNK * uFrameBytes;
+
+    do
+    {
+        uint32_t          uChunk  = ((uLength - uOffset) > uMax) ? uMax : (uLength - uOffset);
+        uint16_t          uFrames = (uint16_t)(uChunk / uFrameBytes);
+        HAL_StatusTypeDef halStatus;
+
+        if (pRxData == NULL)
+        {
+            halStatus = HAL_SPI_Transmit(pModule->pHalHandle, (uint8_t*)&pTxData[uOffset], uFrames, pModule->uTimeoutMs);
+        }
+        else if (pTxData == NULL)
+        {
+            halStatus = HAL_SPI_Receive(pModule->pHalHandle, &pRxData[uOffset], uFrames, pModule->uTimeoutMs);
+        }
+        else
+        {
+            halStatus =
+                HAL_SPI_TransmitReceive(pModule->pHalHandle, (uint8_t*)&pTxData[uOffset], &pRxData[uOffset], uFrames, pModule->uTimeoutMs);
+        }
+
+        if (halStatus == HAL_TIMEOUT)
+        {
+            return eBSP_SPI_ERR_TIMEOUT;
+        }
+        else if (halStatus != HAL_OK)
+        {
+            return sBspSpiHalError(pModule->pHalHandle);
+        }
+
+        uOffset += uChunk;
+    } while (uOffset < uLength);
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+static void sBspSpiOnDmaDone(BspSpiModule_t* pModule, BspSpiTxCpltCb_t pDirectCb)
+{
+    if (pModule->bSlave)
+    {
+        s_spiSlave.byDmaEvents = (s_spiSlave.byDmaEvents < UINT8_MAX) ? (uint8_t)(s_spiSlave.byDmaEvents + 1u) : UINT8_MAX;
+        return;
+    }
+
+    if (pModule->pStreamBuffer != NULL)
+    {
+        sBspSpiStreamEvent(pModule, &pModule->pStreamBuffer[pModule->uStreamHalf]);
+        return;
+    }
+
+    /* Long request or segment list: re-arm with the next piece, one callback at the very end */
+    if (sBspSpiHasNextPiece(pModule))
+    {
+        if (sBspSpiStartNextPiece(pModule) != HAL_OK)
+        {
+            sBspSpiOnDmaError(pModule, eBSP_SPI_ERR_TRANSFER);
+        }
+        return;
+    }
+
+    sBspSpiEndFill(pModule);
+
+    if (pModule->bDeselectClock)
+    {
+        pModule->bDeselectClock = false;
+        pModule->bQueueActive   = false;
+        sBspSpiQueueStartNext(pModule);
+        return;
+    }
+
+    if (pModule->bQueueActive)
+    {
+        sBspSpiQueueOnDone(pModule, eBSP_SPI_ERR_NONE);
+        return;
+    }
+
+    sBspSpiStatsEnd(pModule, eBSP_SPI_ERR_NONE);
+
+    /* A segment list mixes directions: it always completes as full-duplex */
+    if (pModule->bVectorDirect)
+    {
+        pModule->bVectorDirect = false;
+        pDirectCb              = pModule->pTxRxCpltCb;
+    }
+
+    if (pDirectCb != NULL)
+    {
+        BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
+        pDirectCb(handle);
+    }
+
+    /* Queued transfers waiting for this direct transfer */
+    sBspSpiQueueStartNext(pModule);
+}
+
+static void sBspSpiOnDmaError(BspSpiModule_t* pModule, BspSpiError_e eError)
+{
+    /* Slave mode keeps the bus until BspSpiSlaveStop(), which restores the master configuration */
+    if (pModule->bSlave)
+    {
+        if (pModule->pErrorCb != NULL)
+        {
+            pModule->pErrorCb((BspSpiHandle_t)(pModule - s_spiModules), eError);
+        }
+        return;
+    }
+
+    /* HAL stops the DMA on error: streams, chunked and segmented transfers end here */
+    if (pModule->pStreamBuffer != NULL)
+    {
+        pModule->pStreamBuffer = NULL;
+        sBspSpiSetDmaCircular(pModule->pHalHandle, false);
+    }
+    pModule->bVectorDirect = false;
+    sBspSpiAbortPieces(pModule);
+    sBspSpiEndFill(pModule);
+
+    /* Nobody waits for the deselect clock: carry on with the queue */
+    if (pModule->bDeselectClock)
+    {
+        pModule->bDeselectClock = false;
+        pModule->bQueueActive   = false;
+        sBspSpiQueueStartNext(pModule);
+        return;
+    }
+
+    if (pModule->bQueueActive)
+    {
+        sBspSpiQueueOnDone(pModule, eError);
+        return;
+    }
+
+    sBspSpiStatsEnd(pModule, eError);
+
+    if (pModule->pErrorCb != NULL)
+    {
+        BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
+        pModule->pErrorCb(handle, eError);
+    }
+
+    /* Queued transfers waiting for this direct transfer */
+    sBspSpiQueueStartNext(pModule);
+}
+
+static void sBspSpiQueueReset(BspSpiModule_t* pModule)
+{
+    pModule->byQueueHead  = 0u;
+    pModule->byQueueCount = 0u;
+    pModule->bQueueActive   = false;
+    pModule->tQueueStats    = (BspSpiQueueStats_t){0};
+    pModule->hHeldDevice    = BSP_SPI_INVALID_HANDLE;
+    pModule->bDeselectClock = false;
+
+    for (uint8_t i = 0u; i < BSP_SPI_MAX_DEVICES; i++)
+    {
+        if (s_spiDevices[i].hBus == (BspSpiHandle_t)(pModule - s_spiModules))
+        {
+            s_spiDevices[i].byQueued = 0u;
+        }
+    }
+}
+
+static BspSpiDevice_t* sBspSpiValidateDevice(BspSpiDeviceHandle_t hDevice)
+{
+    if ((hDevice < 0) || (hDevice >= (int8_t)BSP_SPI_MAX_DEVICES))
+    {
+        return NULL;
+    }
+
+    if (!s_spiDevices[hDevice].bAllocated)
+    {
+        return NULL;
+    }
+
+    return &s_spiDevices[hDevice];
+}
+
+static bool sBspSpiValidateXfer(const BspSpiXfer_t* pXfer, uint32_t uFrameBytes)
+{
+    if (pXfer == NULL)
+    {
+        return false;
+    }
+
+    if (pXfer->pSegments != NULL)
+    {
+        return !pXfer->bFill && sBspSpiValidateSegments(pXfer->pSegments, pXfer->uSegments, uFrameBytes);
+    }
+
+    /* A fill transfer sends the pattern in place of pTxData and may leave the received frames unread */
+    if (pXfer->bFill ? (pXfer->pTxData != NULL) : ((pXfer->pTxData == NULL) && (pXfer->pRxData == NULL)))
+    {
+        return false;
+    }
+
+    return (pXfer->uLength > 0u) && sBspSpiFitsFrame(uFrameBytes, pXfer->pTxData, pXfer->pRxData, pXfer->uLength);
+}
+
+static bool sBspSpiValidateSegments(const BspSpiSegment_t* pSegments, uint32_t uCount, uint32_t uFrameBytes)
+{
+    if ((pSegments == NULL) || (uCount == 0u))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0u; i < uCount; i++)
+    {
+        if (((pSegments[i].pTxData == NULL) && (pSegments[i].pRxData == NULL)) || (pSegments[i].uLength == 0u) ||
+            !sBspSpiFitsFrame(uFrameBytes, pSegments[i].pTxData, pSegments[i].pRxData, pSegments[i].uLength))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static BspSpiError_e sBspSpiQueuePush(BspSpiModule_t* pModule, const BspSpiXfer_t* pXfer, BspSpiDeviceHandle_t hDevice)
+{
+    uint32_t uRequestUs = 0u;
+    uint32_t uBytes     = 0u;
+
+    if (pModule->bStats)
+    {
+        uRequestUs = sBspSpiStatsNow();
+        uBytes     = (pXfer->pSegments != NULL) ? sBspSpiSegmentBytes(pXfer->pSegments, pXfer->uSegments) : pXfer->uLength;
+    }
+
+    __disable_irq();
+
+    if (pModule->byQueueCount >= BSP_SPI_QUEUE_DEPTH)
+    {
+        pModule->tQueueStats.uRejected++;
+        sBspSpiStatsReject(pModule);
+        __enable_irq();
+        return eBSP_SPI_ERR_BUSY;
+    }
+
+    BspSpiQueueEntry_t* pEntry = &pModule->aQueue[(pModule->byQueueHead + pModule->byQueueCount) % BSP_SPI_QUEUE_DEPTH];
+    pEntry->tXfer              = *pXfer;
+    pEntry->hDevice            = hDevice;
+    pEntry->uRequestUs         = uRequestUs;
+    pEntry->uBytes             = uBytes;
+    pModule->byQueueCount++;
+    BspXferArm(pXfer->pToken);
+
+    if (hDevice >= 0)
+    {
+        s_spiDevices[hDevice].byQueued++;
+    }
+
+    if (pModule->byQueueCount > pModule->tQueueStats.byHighWater)
+    {
+        pModule->tQueueStats.byHighWater = pModule->byQueueCount;
+    }
+
+    __enable_irq();
+
+    /* HAL starts and failure callbacks run with interrupts enabled */
+    sBspSpiQueueStartNext(pModule);
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+static BspSpiQueueEntry_t sBspSpiQueuePop(BspSpiModule_t* pModule)
+{
+    BspSpiQueueEntry_t tEntry = pModule->aQueue[pModule->byQueueHead];
+
+    pModule->byQueueHead  = (uint8_t)((pModule->byQueueHead + 1u) % BSP_SPI_QUEUE_DEPTH);
+    pModule->byQueueCount = (uint8_t)(pModule->byQueueCount - 1u);
+
+    if (tEntry.hDevice >= 0)
+    {
+        if (tEntry.tXfer.bHoldCs)
+        {
+            pModule->hHeldDevice = tEntry.hDevice;
+        }
+        else
+        {
+            BspGpioWritePin(s_spiDevices[tEntry.hDevice].uCsPin, true);
+            pModule->hHeldDevice = BSP_SPI_INVALID_HANDLE;
+        }
+        s_spiDevices[tEntry.hDevice].byQueued--;
+    }
+
+    return tEntry;
+}
+
+static void sBspSpiReleaseHold(BspSpiModule_t* pModule)
+{
+    if (pModule->hHeldDevice >= 0)
+    {
+        BspGpioWritePin(s_spiDevices[pModule->hHeldDevice].uCsPin, true);
+        pModule->hHeldDevice = BSP_SPI_INVALID_HANDLE;
+    }
+}
+
+static bool sBspSpiQueueHeldFirst(BspSpiModule_t* pModule)
+{
+    for (uint8_t i = 0u; i < pModule->byQueueCount; i++)
+    {
+        uint8_t byIndex = (uint8_t)((pModule->byQueueHead + i) % BSP_SPI_QUEUE_DEPTH);
+
+        if (pModule->aQueue[byIndex].hDevice != pModule->hHeldDevice)
+        {
+            continue;
+        }
+
+        BspSpiQueueEntry_t tHeld = pModule->aQueue[byIndex];
+
+        while (byIndex != pModule->byQueueHead)
+        {
+            uint8_t byPrev           = (uint8_t)((byIndex + BSP_SPI_QUEUE_DEPTH - 1u) % BSP_SPI_QUEUE_DEPTH);
+            pModule->aQueue[byIndex] = pModule->aQueue[byPrev];
+            byIndex                  = byPrev;
+        }
+
+        pModule->aQueue[byIndex] = tHeld;
+        return true;
+    }
+
+    return false;
+}
+
+static void sBspSpiDeselectClock(BspSpiModule_t* pModule)
+{
+    pModule->bQueueActive   = true;
+    pModule->bDeselectClock = true;
+
+    if (sBspSpiStartFill(pModule, 0xFFFFu, NULL, sBspSpiFrameBytes(pModule)) != HAL_OK)
+    {
+        pModule->bDeselectClock = false;
+        pModule->bQueueActive   = false;
+        sBspSpiQueueStartNext(pModule);
+    }
+}
+
+static bool sBspSpiBusClaimed(const BspSpiModule_t* pModule)
+{
+    return pModule->bQueueActive || (pModule->byQueueCount > 0u) || (pModule->hHeldDevice >= 0) || sBspSpiIsCircular(pModule) ||
+           sBspSpiHasNextPiece(pModule);
+}
+
+static void sBspSpiDeviceSelect(BspSpiModule_t* pModule, const BspSpiDevice_t* pDevice)
+{
+    SPI_TypeDef* pSpi     = pModule->pHalHandle->Instance;
+    bool         bCrcPoly = ((pDevice->uCr1Bits & SPI_CR1_CRCEN) != 0u) && (pSpi->CRCPR != pDevice->uCrcPoly);
+
+    if (((pSpi->CR1 & BSP_SPI_DEVICE_CR1_MASK) != pDevice->uCr1Bits) || bCrcPoly)
+    {
+        sBspSpiApplyCr1(pModule, BSP_SPI_DEVICE_CR1_MASK, pDevice->uCr1Bits, pDevice->uCrcPoly);
+        pModule->tQueueStats.uReconfigs++;
+    }
+
+    BspGpioWritePin(pDevice->uCsPin, false);
+}
+
+static void sBspSpiStreamEvent(BspSpiModule_t* pModule, const uint8_t* pHalf)
+{
+    BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
+
+    /* The DMA has wrapped into the half delivered last time */
+    if (pModule->bStreamHeld)
+    {
+        pModule->tStreamStats.uOverruns++;
+    }
+
+    pModule->tStreamStats.uBlocks++;
+    pModule->bStreamHeld = !pModule->pStreamCb(handle, pHalf, pModule->uStreamHalf);
+}
+
+static bool sBspSpiIsCircular(const BspSpiModule_t* pModule)
+{
+    return (pModule->pStreamBuffer != NULL) || pModule->bSlave;
+}
+
+static BspSpiModule_t* sBspSpiSlaveValidate(BspSpiHandle_t handle, BspSpiError_e* pError)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        *pError = eBSP_SPI_ERR_INVALID_HANDLE;
+        return NULL;
+    }
+
+    if (!pModule->bSlave)
+    {
+        *pError = eBSP_SPI_ERR_INVALID_PARAM;
+        return NULL;
+    }
+
+    return pModule;
+}
+
+static void sBspSpiSlaveDropOldest(void)
+{
+    s_spiSlave.byMsgHead  = (uint8_t)((s_spiSlave.byMsgHead + 1u) % BSP_SPI_SLAVE_MSG_DEPTH);
+    s_spiSlave.byMsgCount = (uint8_t)(s_spiSlave.byMsgCount - 1u);
+    s_spiSlave.uMsgRemoved++;
+}
+
+static void sBspSpiSlaveTxConsume(uint32_t uStart, uint32_t uLength)
+{
+    uint32_t uRing  = s_spiSlave.tConfig.uRingLength;
+    uint32_t uFirst = ((uRing - uStart) < uLength) ? (uRing - uStart) : uLength;
+
+    /* Sent bytes become fill again, so a later underrun never repeats an old response */
+    memset(&s_spiSlave.tConfig.pTxRing[uStart], BSP_SPI_SLAVE_FILL, uFirst);
+    memset(s_spiSlave.tConfig.pTxRing, BSP_SPI_SLAVE_FILL, uLength - uFirst);
+
+    if (s_spiSlave.uTxQueued == 0u)
+    {
+        return;
+    }
+
+    if (uLength > s_spiSlave.uTxQueued)
+    {
+        s_spiSlave.tStats.uUnderruns++;
+        s_spiSlave.uTxQueued = 0u;
+    }
+    else
+    {
+        s_spiSlave.uTxQueued -= uLength;
+    }
+}
+
+static void sBspSpiSlaveOnCsRise(void)
+{
+    BspSpiModule_t* pModule = s_spiSlave.pModule;
+
+    if (pModule == NULL)
+    {
+        return;
+    }
+
+    uint32_t uRing   = s_spiSlave.tConfig.uRingLength;
+    uint32_t uPos    = (uRing - __HAL_DMA_GET_COUNTER(pModule->pHalHandle->hdmarx)) % uRing;
+    uint32_t uStart  = s_spiSlave.uFrameStart;
+    uint32_t uLength = ((uPos + uRing) - uStart) % uRing;
+    uint8_t  byLaps  = s_spiSlave.byDmaEvents;
+
+    s_spiSlave.byDmaEvents = 0u;
+
+    /* Chip-select glitch without clocks */
+    if ((uLength == 0u) && (byLaps == 0u))
+    {
+        return;
+    }
+
+    /* A frame of exactly the ring length ends where it started, after one full lap */
+    if (uLength == 0u)
+    {
+        uLength = uRing;
+    }
+
+    s_spiSlave.uFrameStart = uPos;
+    s_spiSlave.uRxCount += uLength;
+    s_spiSlave.tStats.uMessages++;
+    s_spiSlave.tStats.uRxBytes += uLength;
+    sBspSpiSlaveTxConsume(uStart, uLength);
+
+    /* More half-ring events than the length accounts for: the frame was longer than the ring and overwrote itself */
+    if (byLaps > ((uLength / (uRing / 2u)) + 1u))
+    {
+        s_spiSlave.tStats.uOverruns += (uint32_t)s_spiSlave.byMsgCount + 1u;
+
+        while (s_spiSlave.byMsgCount > 0u)
+        {
+            sBspSpiSlaveDropOldest();
+        }
+        return;
+    }
+
+    /* Older messages the DMA has written over */
+    while ((s_spiSlave.byMsgCount > 0u) && ((s_spiSlave.uRxCount - s_spiSlave.aMsg[s_spiSlave.byMsgHead].uStamp) > uRing))
+    {
+        sBspSpiSlaveDropOldest();
+        s_spiSlave.tStats.uOverruns++;
+    }
+
+    if (s_spiSlave.byMsgCount >= BSP_SPI_SLAVE_MSG_DEPTH)
+    {
+        s_spiSlave.tStats.uOverruns++;
+        return;
+    }
+
+    uint8_t byTail = (uint8_t)((s_spiSlave.byMsgHead + s_spiSlave.byMsgCount) % BSP_SPI_SLAVE_MSG_DEPTH);
+
+    s_spiSlave.aMsg[byTail] = (BspSpiSlaveSpan_t){uStart, uLength, s_spiSlave.uRxCount - uLength};
+    s_spiSlave.byMsgCount++;
+
+    if (s_spiSlave.tConfig.pOnMessage != NULL)
+    {
+        s_spiSlave.tConfig.pOnMessage((BspSpiHandle_t)(pModule - s_spiModules));
+    }
+}
+
+static bool sBspSpiQueueClaim(BspSpiModule_t* pModule)
+{
+    /* A running stream, slave mode or chunked/segmented direct transfer owns the bus */
+    if (sBspSpiIsCircular(pModule) || sBspSpiHasNextPiece(pModule))
+    {
+        return false;
+    }
+
+    if ((pModule->byQueueCount == 0u) || pModule->bQueueActive)
+    {
+        return false;
+    }
+
+    /* A device holding chip select keeps the bus until its transaction ends */
+    if ((pModule->hHeldDevice >= 0) && !sBspSpiQueueHeldFirst(pModule))
+    {
+        return false;
+    }
+
+    /* A direct transfer owns the bus: its completion callback restarts the queue.
+     * Checked before the device's CR1 and chip select are touched. */
+    if (pModule->pHalHandle->State != HAL_SPI_STATE_READY)
+    {
+        return false;
+    }
+
+    /* Claim the bus before starting: a short transfer may complete before HAL returns */
+    pModule->bQueueActive = true;
+    return true;
+}
+
+static void sBspSpiQueueStartNext(BspSpiModule_t* pModule)
+{
+    BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
+
+    for (;;)
+    {
+        __disable_irq();
+        bool bClaimed = sBspSpiQueueClaim(pModule);
+        __enable_irq();
+
+        if (!bClaimed)
+        {
+            return;
+        }
+
+        /* The head stays put while claimed; pushes only append behind it */
+        BspSpiQueueEntry_t* pEntry = &pModule->aQueue[pModule->byQueueHead];
+        BspSpiXfer_t*       pXfer  = &pEntry->tXfer;
+
+        if (pEntry->hDevice >= 0)
+        {
+            sBspSpiDeviceSelect(pModule, &s_spiDevices[pEntry->hDevice]);
+        }
+
+        HAL_StatusTypeDef halStatus;
+        bool              bTimed = sBspSpiStatsBegin(pModule, pEntry->uBytes);
+
+        /* Latency counts from the queue call */
+        if (bTimed)
+        {
+            pModule->uStatRequestUs = pEntry->uRequestUs;
+        }
+
+        if (pXfer->pSegments != NULL)
+        {
+            halStatus = sBspSpiStartSegments(pModule, pXfer->pSegments, pXfer->uSegments);
+        }
+        else if (pXfer->bFill)
+        {
+            halStatus = sBspSpiStartFill(pModule, pXfer->uFillPattern, pXfer->pRxData, pXfer->uLength);
+        }
+        else
+        {
+            halStatus = sBspSpiStartChunked(pModule, pXfer->pTxData, pXfer->pRxData, pXfer->uLength);
+        }
+
+        if (halStatus == HAL_OK)
+        {
+            return;
+        }
+
+        if (bTimed)
+        {
+            sBspSpiStatsEnd(pModule, (halStatus == HAL_BUSY) ? eBSP_SPI_ERR_BUSY : eBSP_SPI_ERR_TRANSFER);
+        }
+
+        if (halStatus == HAL_BUSY)
+        {
+            /* HAL locked by another context: resumed from the next completion callback */
+            if ((pEntry->hDevice >= 0) && (pEntry->hDevice != pModule->hHeldDevice))
+            {
+                BspGpioWritePin(s_spiDevices[pEntry->hDevice].uCsPin, true);
+            }
+            pModule->bQueueActive = false;
+            return;
+        }
+
+        __disable_irq();
+        BspSpiQueueEntry_t tFailed = sBspSpiQueuePop(pModule);
+        sBspSpiReleaseHold(pModule);
+        pModule->tQueueStats.uErrors++;
+        pModule->bQueueActive = false;
+        __enable_irq();
+
+        BspXferComplete(tFailed.tXfer.pToken, (int32_t)eBSP_SPI_ERR_TRANSFER);
+
+        if (tFailed.tXfer.pCallback != NULL)
+        {
+            tFailed.tXfer.pCallback(handle, eBSP_SPI_ERR_TRANSFER, tFailed.tXfer.pContext);
+        }
+    }
+}
+
+static void sBspSpiQueueOnDone(BspSpiModule_t* pModule, BspSpiError_e eError)
+{
+    BspSpiHandle_t     handle = (BspSpiHandle_t)(pModule - s_spiModules);
+    BspSpiQueueEntry_t tDone  = sBspSpiQueuePop(pModule);
+
+    pModule->bQueueActive = false;
+    sBspSpiStatsEnd(pModule, eError);
+
+    if (eError == eBSP_SPI_ERR_NONE)
+    {
+        pModule->tQueueStats.uCompleted++;
+    }
+    else
+    {
+        pModule->tQueueStats.uErrors++;
+        sBspSpiReleaseHold(pModule);
+    }
+
+    /* Keep the bus busy: next transfer goes out before the callback runs */
+    if ((tDone.hDevice >= 0) && (pModule->hHeldDevice < 0) && s_spiDevices[tDone.hDevice].bDeselectClock)
+    {
+        sBspSpiDeselectClock(pModule);
+    }
+    else
+    {
+        sBspSpiQueueStartNext(pModule);
+    }
+
+    BspXferComplete(tDone.tXfer.pToken, (int32_t)eError);
+
+    if (tDone.tXfer.pCallback != NULL)
+    {
+        tDone.tXfer.pCallback(handle, eError, tDone.tXfer.pContext);
+    }
+}
+
+static BspSpiError_e sBspSpiStartDirect(BspSpiModule_t* pModule, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength,
+                                        BspSpiTxCpltCb_t pDoneCb)
+{
+    /* Queued transfers, streams and unfinished chunked/segmented transfers own the bus */
+    if (sBspSpiBusClaimed(pModule))
+    {
+        sBspSpiStatsReject(pModule);
+        return eBSP_SPI_ERR_BUSY;
+    }
+
+    if (sBspSpiFastPathApplies(pModule, uLength))
+    {
+        return sBspSpiPolledDma(pModule, pTxData, pRxData, uLength, pDoneCb);
+    }
+
+    bool              bTimed    = sBspSpiStatsBegin(pModule, uLength);
+    HAL_StatusTypeDef halStatus = sBspSpiStartChunked(pModule, pTxData, pRxData, uLength);
+
+    if ((halStatus != HAL_OK) && bTimed)
+    {
+        sBspSpiStatsEnd(pModule, (halStatus == HAL_BUSY) ? eBSP_SPI_ERR_BUSY : eBSP_SPI_ERR_TRANSFER);
+    }
+
+    if (halStatus == HAL_BUSY)
+    {
+        sBspSpiStatsReject(pModule);
+        return eBSP_SPI_ERR_BUSY;
+    }
+    else if (halStatus != HAL_OK)
+    {
+        return eBSP_SPI_ERR_TRANSFER;
+    }
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+static uint32_t sBspSpiStatsNow(void)
+{
+    return (s_pfnSpiMicros != NULL) ? s_pfnSpiMicros() : 0u;
+}
+
+static uint32_t sBspSpiSegmentBytes(const BspSpiSegment_t* pSegments, uint32_t uCount)
+{
+    uint32_t uBytes = 0u;
+
+    for (uint32_t i = 0u; i < uCount; i++)
+    {
+        uBytes += pSegments[i].uLength;
+    }
+
+    return uBytes;
+}
+
+static bool sBspSpiStatsBegin(BspSpiModule_t* pModule, uint32_t uBytes)
+{
+    if (!pModule->bStats || pModule->bStatTiming)
+    {
+        return false;
+    }
+
+    pModule->uStatStartUs   = sBspSpiStatsNow();
+    pModule->uStatRequestUs = pModule->uStatStartUs;
+    pModule->uStatBytes     = uBytes;
+    pModule->bStatTiming    = true;
+    return true;
+}
+
+static void sBspSpiStatsEnd(BspSpiModule_t* pModule, BspSpiError_e eError)
+{
+    if (!pModule->bStatTiming)
+    {
+        return;
+    }
+
+    pModule->bStatTiming = false;
+
+    if (eError == eBSP_SPI_ERR_BUSY)
+    {
+        return;
+    }
+
+    BspSpiStats_t* pStats = &pModule->tStats;
+
+    if (eError == eBSP_SPI_ERR_NONE)
+    {
+        pStats->uTransfers++;
+        pStats->uBytes += pModule->uStatBytes;
+    }
+    else
+    {
+        pStats->uErrors++;
+    }
+
+    if (s_pfnSpiMicros == NULL)
+    {
+        return;
+    }
+
+    uint32_t uNowUs     = s_pfnSpiMicros();
+    uint32_t uLatencyUs = uNowUs - pModule->uStatRequestUs;
+    uint32_t uBucket    = 0u;
+
+    pStats->uBusyUs += uNowUs - pModule->uStatStartUs;
+
+    if (uLatencyUs > pStats->uLatencyMaxUs)
+    {
+        pStats->uLatencyMaxUs = uLatencyUs;
+    }
+
+    /* Bucket n >= 1 holds [2^(n+3), 2^(n+4)) us: one count-leading-zeros instruction */
+    if (uLatencyUs >= 16u)
+    {
+        uBucket = 28u - (uint32_t)__builtin_clz(uLatencyUs);
+        uBucket = (uBucket < BSP_SPI_LATENCY_BUCKETS) ? uBucket : (BSP_SPI_LATENCY_BUCKETS - 1u);
+    }
+
+    pStats->auLatency[uBucket]++;
+}
+
+static void sBspSpiStatsReject(BspSpiModule_t* pModule)
+{
+    if (pModule->bStats)
+    {
+        pModule->tStats.uBusyRejections++;
+    }
+}
+
+/* --- Public Functions --- */
+
+BspSpiHandle_t BspSpiAllocate(BspSpiInstance_e eInstance, BspSpiMode_e eMode, uint32_t uTimeoutMs)
+{
+    /* Validate parameters */
+    if (eInstance >= eBSP_SPI_INSTANCE_COUNT)
+    {
+        return BSP_SPI_INVALID_HANDLE;
+    }
+
+    /* Get HAL handle for this instance */
+    SPI_HandleTypeDef* pHalHandle = sBspSpiGetHalHandle(eInstance);
+    if (pHalHandle == NULL)
+    {
+        return BSP_SPI_INVALID_HANDLE;
+    }
+
+    /* Check if this instance is already allocated */
+    if (s_spiModuleOfInstance[eInstance] != NULL)
+    {
+        return BSP_SPI_INVALID_HANDLE;
+    }
+
+    /* Find a free slot */
+    for (uint8_t i = 0u; i < BSP_SPI_MAX_INSTANCES; i++)
+    {
+        if (!s_spiModules[i].bAllocated)
+        {
+            /* Initialize the module */
+            s_spiModules[i].eInstance   = eInstance;
+            s_spiModules[i].pHalHandle  = pHalHandle;
+            s_spiModules[i].eMode       = eMode;
+            s_spiModules[i].uTimeoutMs  = (uTimeoutMs == 0u) ? BSP_SPI_DEFAULT_TIMEOUT_MS : uTimeoutMs;
+            s_spiModules[i].bAllocated  = true;
+            s_spiModules[i].byFastMax   = 0u;
+            s_spiModules[i].pTxCpltCb   = NULL;
+            s_spiModules[i].pRxCpltCb   = NULL;
+            s_spiModules[i].pTxRxCpltCb = NULL;
+            s_spiModules[i].pErrorCb    = NULL;
+            sBspSpiQueueReset(&s_spiModules[i]);
+            s_spiModules[i].pStreamBuffer = NULL;
+            s_spiModules[i].bSlave        = false;
+            s_spiModules[i].bVectorDirect = false;
+            s_spiModules[i].bChunkFill    = false;
+            s_spiModules[i].bStats        = false;
+            s_spiModules[i].bStatTiming   = false;
+            sBspSpiAbortPieces(&s_spiModules[i]);
+            s_spiModuleOfInstance[eInstance] = &s_spiModules[i];
+
+            return (BspSpiHandle_t)i;
+        }
+    }
+
+    return BSP_SPI_INVALID_HANDLE;
+}
+
+BspSpiError_e BspSpiFree(BspSpiHandle_t handle)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    /* Queued transfers are dropped first, so that stopping a stream does not start them */
+    sBspSpiQueueReset(pModule);
+
+    /* A running stream or slave session would keep the DMA writing into the caller's buffers */
+    if (pModule->pStreamBuffer != NULL)
+    {
+        (void)BspSpiStopStream(handle);
+    }
+    if (pModule->bSlave)
+    {
+        (void)BspSpiSlaveStop(handle);
+    }
+
+    /* Clear the module */
+    s_spiModuleOfInstance[pModule->eInstance] = NULL;
+
+    pModule->bAllocated  = false;
+    pModule->eInstance   = eBSP_SPI_INSTANCE_1;
+    pModule->pHalHandle  = NULL;
+    pModule->pTxCpltCb   = NULL;
+    pModule->pRxCpltCb   = NULL;
+    pModule->pTxRxCpltCb = NULL;
+    pModule->pErrorCb    = NULL;
+    pModule->pStreamBuffer = NULL;
+    pModule->bVectorDirect = false;
+    pModule->bChunkFill    = false;
+    pModule->bStats        = false;
+    pModule->bStatTiming   = false;
+    sBspSpiAbortPieces(pModule);
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+BspSpiError_e BspSpiRegisterTxCallback(BspSpiHandle_t handle, BspSpiTxCpltCb_t pCb)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    pModule->pTxCpltCb = pCb;
+    return eBSP_SPI_ERR_NONE;
+}
+
+BspSpiError_e BspSpiRegisterRxCallback(BspSpiHandle_t handle, BspSpiRxCpltCb_t pCb)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    pModule->pRxCpltCb = pCb;
+    return eBSP_SPI_ERR_NONE;
+}
+
+BspSpiError_e BspSpiRegisterTxRxCallback(BspSpiHandle_t handle, BspSpiTxRxCpltCb_t pCb)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    pModule->pTxRxCpltCb = pCb;
+    return eBSP_SPI_ERR_NONE;
+}
+
+BspSpiError_e BspSpiRegisterErrorCallback(BspSpiHandle_t handle, BspSpiErrorCb_t pCb)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    pModule->pErrorCb = pCb;
+    return eBSP_SPI_ERR_NONE;
+}
+
+/* --- Blocking Mode Functions --- */
+
+BspSpiError_e BspSpiTransmit(BspSpiHandle_t handle, const uint8_t* pTxData, uint32_t uLength)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if (pTxData == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_SPI_MODE_BLOCKING)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiBlocking(pModule, pTxData, NULL, uLength);
+}
+
+BspSpiError_e BspSpiReceive(BspSpiHandle_t handle, uint8_t* pRxData, uint32_t uLength)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if (pRxData == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_SPI_MODE_BLOCKING)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiBlocking(pModule, NULL, pRxData, uLength);
+}
+
+BspSpiError_e BspSpiTransmitReceive(BspSpiHandle_t handle, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if ((pTxData == NULL) || (pRxData == NULL))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_SPI_MODE_BLOCKING)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiBlocking(pModule, pTxData, pRxData, uLength);
+}
+
+/* --- DMA Mode Functions --- */
+
+BspSpiError_e BspSpiTransmitDMA(BspSpiHandle_t handle, const uint8_t* pTxData, uint32_t uLength)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if ((pTxData == NULL) || !sBspSpiFitsFrame(sBspSpiFrameBytes(pModule), pTxData, NULL, uLength))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_SPI_MODE_DMA)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiStartDirect(pModule, pTxData, NULL, uLength, pModule->pTxCpltCb);
+}
+
+BspSpiError_e BspSpiReceiveDMA(BspSpiHandle_t handle, uint8_t* pRxData, uint32_t uLength)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if ((pRxData == NULL) || !sBspSpiFitsFrame(sBspSpiFrameBytes(pModule), NULL, pRxData, uLength))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_SPI_MODE_DMA)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiStartDirect(pModule, NULL, pRxData, uLength, pModule->pRxCpltCb);
+}
+
+BspSpiError_e BspSpiTransmitReceiveDMA(BspSpiHandle_t handle, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if ((pTxData == NULL) || (pRxData == NULL) || !sBspSpiFitsFrame(sBspSpiFrameBytes(pModule), pTxData, pRxData, uLength))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_SPI_MODE_DMA)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiStartDirect(pModule, pTxData, pRxData, uLength, pModule->pTxRxCpltCb);
+}
+
+BspSpiError_e BspSpiTransferV(BspSpiHandle_t handle, const BspSpiSegment_t* pSegments, uint32_t uCount)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if (!sBspSpiValidateSegments(pSegments, uCount, sBspSpiFrameBytes(pModule)))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (pModule->eMode != eBSP_SPI_MODE_DMA)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    /* Queued transfers, streams and unfinished chunked/segmented transfers own the bus */
+    if (sBspSpiBusClaimed(pModule))
+    {
+        sBspSpiStatsReject(pModule);
+        return eBSP_SPI_ERR_BUSY;
+    }
+
+    /* Set before starting: a short segment may complete before HAL returns */
+    pModule->bVectorDirect      = true;
+    bool              bTimed    = sBspSpiStatsBegin(pModule, sBspSpiSegmentBytes(pSegments, uCount));
+    HAL_StatusTypeDef halStatus = sBspSpiStartSegments(pModule, pSegments, uCount);
+
+    if (halStatus != HAL_OK)
+    {
+        pModule->bVectorDirect = false;
+    }
+
+    if ((halStatus != HAL_OK) && bTimed)
+    {
+        sBspSpiStatsEnd(pModule, (halStatus == HAL_BUSY) ? eBSP_SPI_ERR_BUSY : eBSP_SPI_ERR_TRANSFER);
+    }
+
+    if (halStatus == HAL_BUSY)
+    {
+        sBspSpiStatsReject(pModule);
+        return eBSP_SPI_ERR_BUSY;
+    }
+    else if (halStatus != HAL_OK)
+    {
+        return eBSP_SPI_ERR_TRANSFER;
+    }
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+BspSpiError_e BspSpiTransmitFillDMA(BspSpiHandle_t handle, uint16_t uPattern, uint32_t uLength)
+{
+    return sBspSpiFillDirect(handle, uPattern, NULL, uLength);
+}
+
+BspSpiError_e BspSpiReceiveFillDMA(BspSpiHandle_t handle, uint16_t uPattern, uint8_t* pRxData, uint32_t uLength)
+{
+    if ((pRxData == NULL) && (sBspSpiValidateHandle(handle) != NULL))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiFillDirect(handle, uPattern, pRxData, uLength);
+}
+
+/* --- Short Transfer Fast Path --- */
+
+BspSpiError_e BspSpiSetFastPath(BspSpiHandle_t handle, uint32_t uMaxLength)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if (uMaxLength > BSP_SPI_FAST_PATH_MAX)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    /* The polled loop clocks one byte out for every byte in */
+    if ((uMaxLength > 0u) &&
+        ((pModule->pHalHandle->Init.Direction != SPI_DIRECTION_2LINES) || (pModule->pHalHandle->Init.DataSize != SPI_DATASIZE_8BIT)))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    pModule->byFastMax = (uint8_t)uMaxLength;
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+/* --- Frame Format --- */
+
+BspSpiError_e BspSpiSetFrameFormat(BspSpiHandle_t handle, BspSpiDataSize_e eDataSize, uint16_t uCrcPolynomial)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    /* HAL and the peripheral only take odd CRC polynomials */
+    if ((eDataSize >= eBSP_SPI_DATA_SIZE_COUNT) || ((uCrcPolynomial != 0u) && ((uCrcPolynomial & 1u) == 0u)))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    if (sBspSpiBusClaimed(pModule) || (pModule->pHalHandle->State != HAL_SPI_STATE_READY))
+    {
+        return eBSP_SPI_ERR_BUSY;
+    }
+
+    sBspSpiApplyCr1(pModule, BSP_SPI_FORMAT_CR1_MASK, sBspSpiFormatBits(eDataSize, uCrcPolynomial), uCrcPolynomial);
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+/* --- DMA Transaction Queue --- */
 
-            return (BspSpiHandle_t)i;
-        }
+BspSpiError_e BspSpiQueueTransfer(BspSpiHandle_t handle, const BspSpiXfer_t* pXfer)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    return BSP_SPI_INVALID_HANDLE;
+    if (!sBspSpiValidateXfer(pXfer, sBspSpiFrameBytes(pModule)))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    /* Only device transfers have a chip select to hold */
+    if ((pModule->eMode != eBSP_SPI_MODE_DMA) || pXfer->bHoldCs)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiQueuePush(pModule, pXfer, BSP_SPI_INVALID_HANDLE);
 }
 
-BspSpiError_e BspSpiFree(BspSpiHandle_t handle)
+BspSpiError_e BspSpiGetQueueStats(BspSpiHandle_t handle, BspSpiQueueStats_t* pStats)
 {
     BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
@@ -220,19 +2362,20 @@ BspSpiError_e BspSpiFree(BspSpiHandle_t handle)
         return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    /* Clear the module */
-    pModule->bAllocated  = false;
-    pModule->eInstance   = eBSP_SPI_INSTANCE_1;
-    pModule->pHalHandle  = NULL;
-    pModule->pTxCpltCb   = NULL;
-    pModule->pRxCpltCb   = NULL;
-    pModule->pTxRxCpltCb = NULL;
-    pModule->pErrorCb    = NULL;
+    if (pStats == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    *pStats           = pModule->tQueueStats;
+    pStats->byPending = pModule->byQueueCount;
+    __enable_irq();
 
     return eBSP_SPI_ERR_NONE;
 }
 
-BspSpiError_e BspSpiRegisterTxCallback(BspSpiHandle_t handle, BspSpiTxCpltCb_t pCb)
+BspSpiError_e BspSpiResetQueueStats(BspSpiHandle_t handle)
 {
     BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
@@ -241,11 +2384,22 @@ BspSpiError_e BspSpiRegisterTxCallback(BspSpiHandle_t handle, BspSpiTxCpltCb_t p
         return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    pModule->pTxCpltCb = pCb;
+    __disable_irq();
+    pModule->tQueueStats             = (BspSpiQueueStats_t){0};
+    pModule->tQueueStats.byHighWater = pModule->byQueueCount;
+    __enable_irq();
+
     return eBSP_SPI_ERR_NONE;
 }
 
-BspSpiError_e BspSpiRegisterRxCallback(BspSpiHandle_t handle, BspSpiRxCpltCb_t pCb)
+/* --- Transfer Statistics --- */
+
+void BspSpiSetTimebase(BspSpiTimebase_t pfnMicros)
+{
+    s_pfnSpiMicros = pfnMicros;
+}
+
+BspSpiError_e BspSpiEnableStats(BspSpiHandle_t handle, bool bEnable)
 {
     BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
@@ -254,11 +2408,19 @@ BspSpiError_e BspSpiRegisterRxCallback(BspSpiHandle_t handle, BspSpiRxCpltCb_t p
         return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    pModule->pRxCpltCb = pCb;
+    __disable_irq();
+    if (bEnable && !pModule->bStats)
+    {
+        pModule->tStats = (BspSpiStats_t){0};
+    }
+    pModule->bStats      = bEnable;
+    pModule->bStatTiming = false;
+    __enable_irq();
+
     return eBSP_SPI_ERR_NONE;
 }
 
-BspSpiError_e BspSpiRegisterTxRxCallback(BspSpiHandle_t handle, BspSpiTxRxCpltCb_t pCb)
+BspSpiError_e BspSpiGetStats(BspSpiHandle_t handle, BspSpiStats_t* pStats)
 {
     BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
@@ -267,11 +2429,19 @@ BspSpiError_e BspSpiRegisterTxRxCallback(BspSpiHandle_t handle, BspSpiTxRxCpltCb
         return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    pModule->pTxRxCpltCb = pCb;
+    if (pStats == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    *pStats = pModule->tStats;
+    __enable_irq();
+
     return eBSP_SPI_ERR_NONE;
 }
 
-BspSpiError_e BspSpiRegisterErrorCallback(BspSpiHandle_t handle, BspSpiErrorCb_t pCb)
+BspSpiError_e BspSpiResetStats(BspSpiHandle_t handle)
 {
     BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
@@ -280,13 +2450,16 @@ BspSpiError_e BspSpiRegisterErrorCallback(BspSpiHandle_t handle, BspSpiErrorCb_t
         return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    pModule->pErrorCb = pCb;
+    __disable_irq();
+    pModule->tStats = (BspSpiStats_t){0};
+    __enable_irq();
+
     return eBSP_SPI_ERR_NONE;
 }
 
-/* --- Blocking Mode Functions --- */
+/* --- Streaming Reception --- */
 
-BspSpiError_e BspSpiTransmit(BspSpiHandle_t handle, const uint8_t* pTxData, uint32_t uLength)
+BspSpiError_e BspSpiStartStream(BspSpiHandle_t handle, uint8_t* pBuffer, uint32_t uLength, BspSpiStreamCb_t pCb)
 {
     BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
@@ -295,31 +2468,47 @@ BspSpiError_e BspSpiTransmit(BspSpiHandle_t handle, const uint8_t* pTxData, uint
         return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    if (pTxData == NULL)
+    uint32_t uFrameBytes = sBspSpiFrameBytes(pModule);
+
+    /* Each half holds whole frames */
+    if ((pBuffer == NULL) || (pCb == NULL) || (uLength < 2u) || ((uLength / uFrameBytes) > (UINT16_MAX - 1u)) ||
+        ((uLength % (2u * uFrameBytes)) != 0u) || !sBspSpiFitsFrame(uFrameBytes, NULL, pBuffer, uLength))
     {
         return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
-    if (pModule->eMode != eBSP_SPI_MODE_BLOCKING)
+    if (pModule->eMode != eBSP_SPI_MODE_DMA)
     {
         return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
-    HAL_StatusTypeDef halStatus = HAL_SPI_Transmit(pModule->pHalHandle, (uint8_t*)pTxData, (uint16_t)uLength, pModule->uTimeoutMs);
-
-    if (halStatus == HAL_TIMEOUT)
+    if (pModule->bQueueActive || (pModule->byQueueCount > 0u) || (pModule->hHeldDevice >= 0) || sBspSpiIsCircular(pModule))
     {
-        return eBSP_SPI_ERR_TIMEOUT;
+        return eBSP_SPI_ERR_BUSY;
     }
-    else if (halStatus != HAL_OK)
+
+    pModule->uStreamHalf  = uLength / 2u;
+    pModule->pStreamCb    = pCb;
+    pModule->bStreamHeld  = false;
+    pModule->tStreamStats = (BspSpiStreamStats_t){0};
+
+    /* Set before starting: the first half may complete before HAL returns */
+    pModule->pStreamBuffer = pBuffer;
+    sBspSpiSetDmaCircular(pModule->pHalHandle, true);
+
+    HAL_StatusTypeDef halStatus = HAL_SPI_Receive_DMA(pModule->pHalHandle, pBuffer, (uint16_t)(uLength / uFrameBytes));
+
+    if (halStatus != HAL_OK)
     {
-        return eBSP_SPI_ERR_TRANSFER;
+        pModule->pStreamBuffer = NULL;
+        sBspSpiSetDmaCircular(pModule->pHalHandle, false);
+        return (halStatus == HAL_BUSY) ? eBSP_SPI_ERR_BUSY : eBSP_SPI_ERR_TRANSFER;
     }
 
     return eBSP_SPI_ERR_NONE;
 }
 
-BspSpiError_e BspSpiReceive(BspSpiHandle_t handle, uint8_t* pRxData, uint32_t uLength)
+BspSpiError_e BspSpiStopStream(BspSpiHandle_t handle)
 {
     BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
@@ -328,31 +2517,63 @@ BspSpiError_e BspSpiReceive(BspSpiHandle_t handle, uint8_t* pRxData, uint32_t uL
         return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    if (pRxData == NULL)
+    if (pModule->pStreamBuffer == NULL)
     {
         return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
-    if (pModule->eMode != eBSP_SPI_MODE_BLOCKING)
+    HAL_StatusTypeDef halStatus = HAL_SPI_DMAStop(pModule->pHalHandle);
+
+    /* Back to normal mode for the one-shot transfers that follow */
+    sBspSpiSetDmaCircular(pModule->pHalHandle, false);
+
+    __disable_irq();
+    pModule->pStreamBuffer = NULL;
+    pModule->bStreamHeld   = false;
+    __enable_irq();
+
+    sBspSpiQueueStartNext(pModule);
+
+    return (halStatus == HAL_OK) ? eBSP_SPI_ERR_NONE : eBSP_SPI_ERR_TRANSFER;
+}
+
+BspSpiError_e BspSpiStreamRelease(BspSpiHandle_t handle)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+
+    if (pModule == NULL)
     {
-        return eBSP_SPI_ERR_INVALID_PARAM;
+        return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    HAL_StatusTypeDef halStatus = HAL_SPI_Receive(pModule->pHalHandle, pRxData, (uint16_t)uLength, pModule->uTimeoutMs);
+    pModule->bStreamHeld = false;
+    return eBSP_SPI_ERR_NONE;
+}
+
+BspSpiError_e BspSpiGetStreamStats(BspSpiHandle_t handle, BspSpiStreamStats_t* pStats)
+{
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
-    if (halStatus == HAL_TIMEOUT)
+    if (pModule == NULL)
     {
-        return eBSP_SPI_ERR_TIMEOUT;
+        return eBSP_SPI_ERR_INVALID_HANDLE;
     }
-    else if (halStatus != HAL_OK)
+
+    if (pStats == NULL)
     {
-        return eBSP_SPI_ERR_TRANSFER;
+        return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
+    __disable_irq();
+    *pStats = pModule->tStreamStats;
+    __enable_irq();
+
     return eBSP_SPI_ERR_NONE;
 }
 
-BspSpiError_e BspSpiTransmitReceive(BspSpiHandle_t handle, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+/* --- Slave Mode --- */
+
+BspSpiError_e BspSpiSlaveStart(BspSpiHandle_t handle, const BspSpiSlaveConfig_t* pConfig)
 {
     BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
 
@@ -361,132 +2582,361 @@ BspSpiError_e BspSpiTransmitReceive(BspSpiHandle_t handle, const uint8_t* pTxDat
         return eBSP_SPI_ERR_INVALID_HANDLE;
     }
 
-    if ((pTxData == NULL) || (pRxData == NULL))
+    if ((pConfig == NULL) || (pConfig->pRxRing == NULL) || (pConfig->pTxRing == NULL) || (pConfig->uRingLength < 2u) ||
+        (pConfig->uRingLength > UINT16_MAX) || (pConfig->eClockMode >= eBSP_SPI_CLOCK_MODE_COUNT))
     {
         return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
-    if (pModule->eMode != eBSP_SPI_MODE_BLOCKING)
+    if (pModule->eMode != eBSP_SPI_MODE_DMA)
     {
         return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
-    HAL_StatusTypeDef halStatus =
-        HAL_SPI_TransmitReceive(pModule->pHalHandle, (uint8_t*)pTxData, pRxData, (uint16_t)uLength, pModule->uTimeoutMs);
+    if (sBspSpiBusClaimed(pModule))
+    {
+        return eBSP_SPI_ERR_BUSY;
+    }
 
-    if (halStatus == HAL_TIMEOUT)
+    if (s_spiSlave.pModule != NULL)
     {
-        return eBSP_SPI_ERR_TIMEOUT;
+        return eBSP_SPI_ERR_NO_RESOURCE;
     }
-    else if (halStatus != HAL_OK)
+
+    SPI_HandleTypeDef* pHal = pModule->pHalHandle;
+
+    s_spiSlave             = (BspSpiSlave_t){0};
+    s_spiSlave.tConfig     = *pConfig;
+    s_spiSlave.tMasterInit = pHal->Init;
+
+    pHal->Init.Mode        = SPI_MODE_SLAVE;
+    pHal->Init.NSS         = SPI_NSS_HARD_INPUT;
+    pHal->Init.CLKPolarity = 0u;
+    pHal->Init.CLKPhase    = 0u;
+
+    if ((pConfig->eClockMode == eBSP_SPI_CLOCK_MODE_2) || (pConfig->eClockMode == eBSP_SPI_CLOCK_MODE_3))
+    {
+        pHal->Init.CLKPolarity = SPI_CR1_CPOL;
+    }
+    if ((pConfig->eClockMode == eBSP_SPI_CLOCK_MODE_1) || (pConfig->eClockMode == eBSP_SPI_CLOCK_MODE_3))
+    {
+        pHal->Init.CLKPhase = SPI_CR1_CPHA;
+    }
+
+    /* The rings are byte-wide */
+    pHal->Init.DataSize       = SPI_DATASIZE_8BIT;
+    pHal->Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+
+    if (HAL_SPI_Init(pHal) != HAL_OK)
     {
+        pHal->Init = s_spiSlave.tMasterInit;
+        (void)HAL_SPI_Init(pHal);
         return eBSP_SPI_ERR_TRANSFER;
     }
 
+    sBspSpiSyncDmaWidth(pHal);
+    sBspSpiSetDmaCircular(pHal, true);
+
+    memset(pConfig->pTxRing, BSP_SPI_SLAVE_FILL, pConfig->uRingLength);
+
+    /* Set before starting: the host may end a frame as soon as the DMA runs */
+    pModule->bSlave    = true;
+    s_spiSlave.pModule = pModule;
+    BspGpioSetIRQHandler(pConfig->uCsPin, sBspSpiSlaveOnCsRise);
+    BspGpioEnableIRQ(pConfig->uCsPin);
+
+    HAL_StatusTypeDef halStatus = HAL_SPI_TransmitReceive_DMA(pHal, pConfig->pTxRing, pConfig->pRxRing, (uint16_t)pConfig->uRingLength);
+
+    if (halStatus != HAL_OK)
+    {
+        BspGpioSetIRQHandler(pConfig->uCsPin, NULL);
+        pModule->bSlave    = false;
+        s_spiSlave.pModule = NULL;
+        pHal->Init         = s_spiSlave.tMasterInit;
+        (void)HAL_SPI_Init(pHal);
+        sBspSpiSyncDmaWidth(pHal);
+        sBspSpiSetDmaCircular(pHal, false);
+        return (halStatus == HAL_BUSY) ? eBSP_SPI_ERR_BUSY : eBSP_SPI_ERR_TRANSFER;
+    }
+
     return eBSP_SPI_ERR_NONE;
 }
 
-/* --- DMA Mode Functions --- */
-
-BspSpiError_e BspSpiTransmitDMA(BspSpiHandle_t handle, const uint8_t* pTxData, uint32_t uLength)
+BspSpiError_e BspSpiSlaveStop(BspSpiHandle_t handle)
 {
-    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+    BspSpiError_e   eError  = eBSP_SPI_ERR_NONE;
+    BspSpiModule_t* pModule = sBspSpiSlaveValidate(handle, &eError);
 
     if (pModule == NULL)
     {
-        return eBSP_SPI_ERR_INVALID_HANDLE;
+        return eError;
     }
 
-    if (pTxData == NULL)
+    HAL_StatusTypeDef halStatus = HAL_SPI_DMAStop(pModule->pHalHandle);
+
+    BspGpioSetIRQHandler(s_spiSlave.tConfig.uCsPin, NULL);
+    pModule->pHalHandle->Init = s_spiSlave.tMasterInit;
+
+    if (HAL_SPI_Init(pModule->pHalHandle) != HAL_OK)
     {
-        return eBSP_SPI_ERR_INVALID_PARAM;
+        halStatus = HAL_ERROR;
     }
+    sBspSpiSyncDmaWidth(pModule->pHalHandle);
+    sBspSpiSetDmaCircular(pModule->pHalHandle, false);
 
-    if (pModule->eMode != eBSP_SPI_MODE_DMA)
+    __disable_irq();
+    pModule->bSlave    = false;
+    s_spiSlave.pModule = NULL;
+    __enable_irq();
+
+    sBspSpiQueueStartNext(pModule);
+
+    return (halStatus == HAL_OK) ? eBSP_SPI_ERR_NONE : eBSP_SPI_ERR_TRANSFER;
+}
+
+BspSpiError_e BspSpiSlaveGetMessage(BspSpiHandle_t handle, BspSpiSlaveMsg_t* pMsg)
+{
+    BspSpiError_e eError = eBSP_SPI_ERR_NONE;
+
+    if (sBspSpiSlaveValidate(handle, &eError) == NULL)
+    {
+        return eError;
+    }
+
+    if (pMsg == NULL)
     {
         return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
-    HAL_StatusTypeDef halStatus = HAL_SPI_Transmit_DMA(pModule->pHalHandle, (uint8_t*)pTxData, (uint16_t)uLength);
+    __disable_irq();
 
-    if (halStatus == HAL_BUSY)
+    if (s_spiSlave.byMsgCount == 0u)
     {
-        return eBSP_SPI_ERR_BUSY;
+        __enable_irq();
+        return eBSP_SPI_ERR_NO_DATA;
     }
-    else if (halStatus != HAL_OK)
+
+    BspSpiSlaveSpan_t tSpan = s_spiSlave.aMsg[s_spiSlave.byMsgHead];
+    s_spiSlave.uMsgHeld     = s_spiSlave.uMsgRemoved;
+    s_spiSlave.bMsgHeld     = true;
+
+    __enable_irq();
+
+    uint32_t uFirst = s_spiSlave.tConfig.uRingLength - tSpan.uOffset;
+
+    if (uFirst > tSpan.uLength)
     {
-        return eBSP_SPI_ERR_TRANSFER;
+        uFirst = tSpan.uLength;
     }
 
+    pMsg->pData       = &s_spiSlave.tConfig.pRxRing[tSpan.uOffset];
+    pMsg->uLength     = uFirst;
+    pMsg->pWrapData   = (tSpan.uLength > uFirst) ? s_spiSlave.tConfig.pRxRing : NULL;
+    pMsg->uWrapLength = tSpan.uLength - uFirst;
+
     return eBSP_SPI_ERR_NONE;
 }
 
-BspSpiError_e BspSpiReceiveDMA(BspSpiHandle_t handle, uint8_t* pRxData, uint32_t uLength)
+BspSpiError_e BspSpiSlaveReleaseMessage(BspSpiHandle_t handle)
 {
-    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+    BspSpiError_e eError = eBSP_SPI_ERR_NONE;
 
-    if (pModule == NULL)
+    if (sBspSpiSlaveValidate(handle, &eError) == NULL)
     {
-        return eBSP_SPI_ERR_INVALID_HANDLE;
+        return eError;
     }
 
-    if (pRxData == NULL)
+    __disable_irq();
+
+    if (!s_spiSlave.bMsgHeld)
     {
+        __enable_irq();
         return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
-    if (pModule->eMode != eBSP_SPI_MODE_DMA)
+    /* Overwritten messages were already removed from the head */
+    if (s_spiSlave.uMsgHeld == s_spiSlave.uMsgRemoved)
     {
-        return eBSP_SPI_ERR_INVALID_PARAM;
+        sBspSpiSlaveDropOldest();
     }
 
-    HAL_StatusTypeDef halStatus = HAL_SPI_Receive_DMA(pModule->pHalHandle, pRxData, (uint16_t)uLength);
+    s_spiSlave.bMsgHeld = false;
+    __enable_irq();
 
-    if (halStatus == HAL_BUSY)
+    return eBSP_SPI_ERR_NONE;
+}
+
+BspSpiError_e BspSpiSlaveWrite(BspSpiHandle_t handle, const uint8_t* pData, uint32_t uLength)
+{
+    BspSpiError_e eError = eBSP_SPI_ERR_NONE;
+
+    if (sBspSpiSlaveValidate(handle, &eError) == NULL)
     {
-        return eBSP_SPI_ERR_BUSY;
+        return eError;
     }
-    else if (halStatus != HAL_OK)
+
+    if ((pData == NULL) || (uLength == 0u))
     {
-        return eBSP_SPI_ERR_TRANSFER;
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    uint32_t uRing = s_spiSlave.tConfig.uRingLength;
+
+    /* Copied with the chip-select interrupt masked so a frame end never refills half-written data */
+    __disable_irq();
+
+    /* With nothing queued the first byte of the next frame is already in the data register */
+    uint32_t uQueued = (s_spiSlave.uTxQueued == 0u) ? 1u : s_spiSlave.uTxQueued;
+
+    if ((uQueued + uLength) > uRing)
+    {
+        __enable_irq();
+        return eBSP_SPI_ERR_NO_RESOURCE;
     }
 
+    uint32_t uOffset = (s_spiSlave.uFrameStart + uQueued) % uRing;
+    uint32_t uFirst  = ((uRing - uOffset) < uLength) ? (uRing - uOffset) : uLength;
+
+    memcpy(&s_spiSlave.tConfig.pTxRing[uOffset], pData, uFirst);
+    memcpy(s_spiSlave.tConfig.pTxRing, &pData[uFirst], uLength - uFirst);
+    s_spiSlave.uTxQueued = uQueued + uLength;
+
+    __enable_irq();
+
     return eBSP_SPI_ERR_NONE;
 }
 
-BspSpiError_e BspSpiTransmitReceiveDMA(BspSpiHandle_t handle, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength)
+BspSpiError_e BspSpiSlaveGetStats(BspSpiHandle_t handle, BspSpiSlaveStats_t* pStats)
 {
-    BspSpiModule_t* pModule = sBspSpiValidateHandle(handle);
+    BspSpiError_e eError = eBSP_SPI_ERR_NONE;
 
-    if (pModule == NULL)
+    if (sBspSpiSlaveValidate(handle, &eError) == NULL)
     {
-        return eBSP_SPI_ERR_INVALID_HANDLE;
+        return eError;
     }
 
-    if ((pTxData == NULL) || (pRxData == NULL))
+    if (pStats == NULL)
     {
         return eBSP_SPI_ERR_INVALID_PARAM;
     }
 
-    if (pModule->eMode != eBSP_SPI_MODE_DMA)
+    __disable_irq();
+    *pStats = s_spiSlave.tStats;
+    __enable_irq();
+
+    return eBSP_SPI_ERR_NONE;
+}
+
+/* --- Shared Bus Devices --- */
+
+BspSpiDeviceHandle_t BspSpiDeviceAdd(const BspSpiDeviceConfig_t* pConfig)
+{
+    if (pConfig == NULL)
     {
-        return eBSP_SPI_ERR_INVALID_PARAM;
+        return BSP_SPI_INVALID_HANDLE;
     }
 
-    HAL_StatusTypeDef halStatus = HAL_SPI_TransmitReceive_DMA(pModule->pHalHandle, (uint8_t*)pTxData, pRxData, (uint16_t)uLength);
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(pConfig->hBus);
 
-    if (halStatus == HAL_BUSY)
+    if ((pModule == NULL) || (pModule->eMode != eBSP_SPI_MODE_DMA))
+    {
+        return BSP_SPI_INVALID_HANDLE;
+    }
+
+    /* HAL and the peripheral only take odd CRC polynomials */
+    if ((pConfig->eClockMode >= eBSP_SPI_CLOCK_MODE_COUNT) || (pConfig->ePrescaler >= eBSP_SPI_PRESCALER_COUNT) ||
+        (pConfig->eDataSize >= eBSP_SPI_DATA_SIZE_COUNT) || ((pConfig->uCrcPolynomial != 0u) && ((pConfig->uCrcPolynomial & 1u) == 0u)))
+    {
+        return BSP_SPI_INVALID_HANDLE;
+    }
+
+    for (uint8_t i = 0u; i < BSP_SPI_MAX_DEVICES; i++)
+    {
+        if (!s_spiDevices[i].bAllocated)
+        {
+            uint32_t uCr1Bits = (((uint32_t)pConfig->ePrescaler << SPI_CR1_BR_Pos) & SPI_CR1_BR) |
+                                sBspSpiFormatBits(pConfig->eDataSize, pConfig->uCrcPolynomial);
+
+            if ((pConfig->eClockMode == eBSP_SPI_CLOCK_MODE_2) || (pConfig->eClockMode == eBSP_SPI_CLOCK_MODE_3))
+            {
+                uCr1Bits |= SPI_CR1_CPOL;
+            }
+            if ((pConfig->eClockMode == eBSP_SPI_CLOCK_MODE_1) || (pConfig->eClockMode == eBSP_SPI_CLOCK_MODE_3))
+            {
+                uCr1Bits |= SPI_CR1_CPHA;
+            }
+
+            s_spiDevices[i].hBus           = pConfig->hBus;
+            s_spiDevices[i].uCsPin         = pConfig->uCsPin;
+            s_spiDevices[i].uCr1Bits       = uCr1Bits;
+            s_spiDevices[i].uCrcPoly       = pConfig->uCrcPolynomial;
+            s_spiDevices[i].bDeselectClock = pConfig->bDeselectClock;
+            s_spiDevices[i].byQueued       = 0u;
+            s_spiDevices[i].bAllocated     = true;
+
+            BspGpioWritePin(pConfig->uCsPin, true);
+
+            return (BspSpiDeviceHandle_t)i;
+        }
+    }
+
+    return BSP_SPI_INVALID_HANDLE;
+}
+
+BspSpiError_e BspSpiDeviceRemove(BspSpiDeviceHandle_t hDevice)
+{
+    BspSpiDevice_t* pDevice = sBspSpiValidateDevice(hDevice);
+
+    if (pDevice == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if (pDevice->byQueued > 0u)
     {
         return eBSP_SPI_ERR_BUSY;
     }
-    else if (halStatus != HAL_OK)
+
+    /* Removing the device that holds the bus ends its transaction */
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(pDevice->hBus);
+
+    if ((pModule != NULL) && (pModule->hHeldDevice == hDevice))
     {
-        return eBSP_SPI_ERR_TRANSFER;
+        __disable_irq();
+        sBspSpiReleaseHold(pModule);
+        __enable_irq();
+
+        sBspSpiQueueStartNext(pModule);
     }
 
+    pDevice->bAllocated = false;
     return eBSP_SPI_ERR_NONE;
 }
 
+BspSpiError_e BspSpiDeviceQueueTransfer(BspSpiDeviceHandle_t hDevice, const BspSpiXfer_t* pXfer)
+{
+    BspSpiDevice_t* pDevice = sBspSpiValidateDevice(hDevice);
+
+    if (pDevice == NULL)
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    BspSpiModule_t* pModule = sBspSpiValidateHandle(pDevice->hBus);
+
+    if ((pModule == NULL) || (pModule->eMode != eBSP_SPI_MODE_DMA))
+    {
+        return eBSP_SPI_ERR_INVALID_HANDLE;
+    }
+
+    if (!sBspSpiValidateXfer(pXfer, ((pDevice->uCr1Bits & SPI_CR1_DFF) != 0u) ? 2u : 1u))
+    {
+        return eBSP_SPI_ERR_INVALID_PARAM;
+    }
+
+    return sBspSpiQueuePush(pModule, pXfer, hDevice);
+}
+
 /* --- HAL Callback Functions --- */
 
 // lint -e818
@@ -494,10 +2944,9 @@ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
 {
     BspSpiModule_t* pModule = sBspSpiFindModuleByHalHandle(hspi);
 
-    if ((pModule != NULL) && (pModule->pTxCpltCb != NULL))
+    if (pModule != NULL)
     {
-        BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
-        pModule->pTxCpltCb(handle);
+        sBspSpiOnDmaDone(pModule, pModule->pTxCpltCb);
     }
 }
 
@@ -506,10 +2955,9 @@ void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi)
 {
     BspSpiModule_t* pModule = sBspSpiFindModuleByHalHandle(hspi);
 
-    if ((pModule != NULL) && (pModule->pRxCpltCb != NULL))
+    if (pModule != NULL)
     {
-        BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
-        pModule->pRxCpltCb(handle);
+        sBspSpiOnDmaDone(pModule, pModule->pRxCpltCb);
     }
 }
 
@@ -518,10 +2966,9 @@ void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
 {
     BspSpiModule_t* pModule = sBspSpiFindModuleByHalHandle(hspi);
 
-    if ((pModule != NULL) && (pModule->pTxRxCpltCb != NULL))
+    if (pModule != NULL)
     {
-        BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
-        pModule->pTxRxCpltCb(handle);
+        sBspSpiOnDmaDone(pModule, pModule->pTxRxCpltCb);
     }
 }
 
@@ -530,9 +2977,34 @@ void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
 {
     BspSpiModule_t* pModule = sBspSpiFindModuleByHalHandle(hspi);
 
-    if ((pModule != NULL) && (pModule->pErrorCb != NULL))
+    if (pModule != NULL)
     {
-        BspSpiHandle_t handle = (BspSpiHandle_t)(pModule - s_spiModules);
-        pModule->pErrorCb(handle, eBSP_SPI_ERR_TRANSFER);
+        sBspSpiOnDmaError(pModule, sBspSpiHalError(hspi));
+    }
+}
+
+// lint -e818
+void HAL_SPI_RxHalfCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    BspSpiModule_t* pModule = sBspSpiFindModuleByHalHandle(hspi);
+
+    if ((pModule != NULL) && (pModule->pStreamBuffer != NULL))
+    {
+        sBspSpiStreamEvent(pModule, pModule->pStreamBuffer);
+    }
+}
+
+// lint -e818
+void HAL_SPI_TxRxHalfCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    BspSpiModule_t* pModule = sBspSpiFindModuleByHalHandle(hspi);
+
+    if ((pModule != NULL) && pModule->bSlave)
+    {
+        sBspSpiOnDmaDone(pModule, NULL);
+    }
+    else if ((pModule != NULL) && (pModule->pStreamBuffer != NULL))
+    {
+        sBspSpiStreamEvent(pModule, pModule->pStreamBuffer);
     }
 }
@@ -8,9 +8,62 @@ extern "C"
 {
 #endif
 
+#include "bsp_xfer.h"
 #include <stdbool.h>
 #include <stdint.h>
 
+/* --- Configuration --- */
+
+/**
+ * Depth of the per-instance DMA transaction queue.
+ * Memory impact: BSP_SPI_QUEUE_DEPTH x 48 bytes per SPI instance.
+ */
+#ifndef BSP_SPI_QUEUE_DEPTH
+    #define BSP_SPI_QUEUE_DEPTH (8u)
+#endif
+
+#if (BSP_SPI_QUEUE_DEPTH < 1u) || (BSP_SPI_QUEUE_DEPTH > 255u)
+    #error "BSP_SPI_QUEUE_DEPTH must be between 1 and 255"
+#endif
+
+/**
+ * Maximum number of devices on all shared buses.
+ * Memory impact: BSP_SPI_MAX_DEVICES x 16 bytes.
+ */
+#ifndef BSP_SPI_MAX_DEVICES
+    #define BSP_SPI_MAX_DEVICES (8u)
+#endif
+
+/**
+ * Longest transfer that may use the polled short-transfer path (see BspSpiSetFastPath()).
+ */
+#ifndef BSP_SPI_FAST_PATH_MAX
+    #define BSP_SPI_FAST_PATH_MAX (4u)
+#endif
+
+#if (BSP_SPI_FAST_PATH_MAX < 1u) || (BSP_SPI_FAST_PATH_MAX > 16u)
+    #error "BSP_SPI_FAST_PATH_MAX must be between 1 and 16"
+#endif
+
+/**
+ * Messages a slave-mode bus holds until released (see BspSpiSlaveGetMessage()).
+ * Memory impact: BSP_SPI_SLAVE_MSG_DEPTH x 12 bytes.
+ */
+#ifndef BSP_SPI_SLAVE_MSG_DEPTH
+    #define BSP_SPI_SLAVE_MSG_DEPTH (8u)
+#endif
+
+#if (BSP_SPI_SLAVE_MSG_DEPTH < 1u) || (BSP_SPI_SLAVE_MSG_DEPTH > 255u)
+    #error "BSP_SPI_SLAVE_MSG_DEPTH must be between 1 and 255"
+#endif
+
+/**
+ * Byte a slave clocks out when the host reads more than was queued for transmit.
+ */
+#ifndef BSP_SPI_SLAVE_FILL
+    #define BSP_SPI_SLAVE_FILL (0xFFu)
+#endif
+
 /* --- Type Definitions --- */
 
 /**
@@ -19,6 +72,12 @@ extern "C"
  */
 typedef int8_t BspSpiHandle_t;
 
+/**
+ * SPI device handle type (device on a shared bus).
+ * Valid handles are >= 0, -1 indicates an invalid handle or error.
+ */
+typedef int8_t BspSpiDeviceHandle_t;
+
 /**
  * SPI peripheral instance enumeration.
  * Identifies which hardware SPI peripheral to use.
@@ -44,6 +103,46 @@ typedef enum
     eBSP_SPI_MODE_DMA            /**< DMA mode with callbacks */
 } BspSpiMode_e;
 
+/**
+ * SPI clock mode enumeration (clock polarity and phase).
+ */
+typedef enum
+{
+    eBSP_SPI_CLOCK_MODE_0 = 0u, /**< CPOL 0, CPHA 0: idle low, sample on rising edge */
+    eBSP_SPI_CLOCK_MODE_1,      /**< CPOL 0, CPHA 1: idle low, sample on falling edge */
+    eBSP_SPI_CLOCK_MODE_2,      /**< CPOL 1, CPHA 0: idle high, sample on falling edge */
+    eBSP_SPI_CLOCK_MODE_3,      /**< CPOL 1, CPHA 1: idle high, sample on rising edge */
+    eBSP_SPI_CLOCK_MODE_COUNT
+} BspSpiClockMode_e;
+
+/**
+ * SPI baud rate prescaler enumeration (divider of the peripheral bus clock).
+ */
+typedef enum
+{
+    eBSP_SPI_PRESCALER_2 = 0u, /**< fPCLK / 2 */
+    eBSP_SPI_PRESCALER_4,      /**< fPCLK / 4 */
+    eBSP_SPI_PRESCALER_8,      /**< fPCLK / 8 */
+    eBSP_SPI_PRESCALER_16,     /**< fPCLK / 16 */
+    eBSP_SPI_PRESCALER_32,     /**< fPCLK / 32 */
+    eBSP_SPI_PRESCALER_64,     /**< fPCLK / 64 */
+    eBSP_SPI_PRESCALER_128,    /**< fPCLK / 128 */
+    eBSP_SPI_PRESCALER_256,    /**< fPCLK / 256 */
+    eBSP_SPI_PRESCALER_COUNT
+} BspSpiPrescaler_e;
+
+/**
+ * SPI frame size enumeration.
+ * With 16-bit frames each DMA request moves a halfword: buffers hold native
+ * uint16_t values (halfword aligned), lengths stay in bytes and must be even.
+ */
+typedef enum
+{
+    eBSP_SPI_DATA_SIZE_8BIT = 0u, /**< 8-bit frames */
+    eBSP_SPI_DATA_SIZE_16BIT,     /**< 16-bit frames, MSB first */
+    eBSP_SPI_DATA_SIZE_COUNT
+} BspSpiDataSize_e;
+
 /**
  * SPI error enumeration.
  * Error codes returned by SPI operations.
@@ -56,7 +155,9 @@ typedef enum
     eBSP_SPI_ERR_BUSY,           /**< SPI peripheral is busy */
     eBSP_SPI_ERR_TIMEOUT,        /**< Operation timed out */
     eBSP_SPI_ERR_TRANSFER,       /**< Transfer error */
-    eBSP_SPI_ERR_NO_RESOURCE     /**< No available SPI module slots */
+    eBSP_SPI_ERR_NO_RESOURCE,    /**< No available SPI module slots */
+    eBSP_SPI_ERR_NO_DATA,        /**< No received message available */
+    eBSP_SPI_ERR_CRC             /**< Received CRC did not match (hardware CRC mode) */
 } BspSpiError_e;
 
 /**
@@ -85,13 +186,187 @@ typedef void (*BspSpiTxRxCpltCb_t)(BspSpiHandle_t handle);
 
 /**
  * Callback type for SPI error notification.
- * Called when an error occurs during a DMA operation.
+ * Called when an error occurs during a DMA operation: eBSP_SPI_ERR_CRC when
+ * the hardware CRC check failed, eBSP_SPI_ERR_TRANSFER otherwise.
  *
  * @param handle The SPI handle that encountered an error
  * @param error The error code
  */
 typedef void (*BspSpiErrorCb_t)(BspSpiHandle_t handle, BspSpiError_e error);
 
+/**
+ * Callback type for queued transfer completion.
+ * Called from the DMA completion interrupt after the next queued transfer
+ * has been started, so the bus does not wait for the callback.
+ *
+ * @param handle The SPI handle that completed the transfer
+ * @param eError eBSP_SPI_ERR_NONE on success, eBSP_SPI_ERR_CRC on a CRC mismatch, eBSP_SPI_ERR_TRANSFER on other failures
+ * @param pContext Context pointer from the transfer descriptor
+ */
+typedef void (*BspSpiXferCb_t)(BspSpiHandle_t handle, BspSpiError_e eError, void* pContext);
+
+/**
+ * Transfer segment (scatter-gather element).
+ * Segments of one transfer run back-to-back without releasing chip select.
+ */
+typedef struct
+{
+    const uint8_t* pTxData; /**< Data to transmit, NULL for receive only */
+    uint8_t*       pRxData; /**< Receive buffer, NULL for transmit only */
+    uint32_t       uLength; /**< Length in bytes (> 0, chunked above 65535 frames) */
+} BspSpiSegment_t;
+
+/**
+ * Queued transfer descriptor.
+ * The descriptor is copied when queued; the buffers and the segment list must
+ * remain valid until the callback.
+ * With bFill set, uFillPattern is sent for every frame in place of pTxData
+ * (which must be NULL); pRxData receives the reply or is NULL to discard it.
+ * With bHoldCs set, a device transfer leaves chip select asserted and the bus
+ * reserved for the device: only its own transfers start until one without
+ * bHoldCs (or an error) ends the transaction.
+ * pToken, if set, is armed when the transfer is queued and completed with the
+ * result before the callback runs, so it can be polled with BspXferIsDone().
+ */
+typedef struct
+{
+    const uint8_t*         pTxData;      /**< Data to transmit, NULL for receive only */
+    uint8_t*               pRxData;      /**< Receive buffer, NULL for transmit only */
+    uint32_t               uLength;      /**< Length in bytes (> 0, chunked above 65535 frames) */
+    BspSpiXferCb_t         pCallback;    /**< Completion callback, may be NULL */
+    void*                  pContext;     /**< Passed to the callback */
+    BspXferToken_t*        pToken;       /**< Completion token (caller-owned), may be NULL */
+    const BspSpiSegment_t* pSegments;    /**< Segment list replacing the three fields above, or NULL */
+    uint32_t               uSegments;    /**< Number of segments in pSegments */
+    bool                   bFill;        /**< Send uFillPattern instead of pTxData (not with pSegments) */
+    bool                   bHoldCs;      /**< Keep chip select asserted after this transfer (device transfers only) */
+    uint16_t               uFillPattern; /**< Frame sent throughout a fill transfer (low byte with 8-bit frames) */
+} BspSpiXfer_t;
+
+/**
+ * Transaction queue statistics.
+ */
+typedef struct
+{
+    uint8_t  byPending;   /**< Transfers queued, including the one in flight */
+    uint8_t  byHighWater; /**< Maximum of byPending since allocation or last reset */
+    uint32_t uCompleted;  /**< Queued transfers completed successfully */
+    uint32_t uErrors;     /**< Queued transfers failed to start or ended with a DMA error */
+    uint32_t uRejected;   /**< Transfers rejected because the queue was full */
+    uint32_t uReconfigs;  /**< Clock mode/prescaler/frame format switches between devices */
+} BspSpiQueueStats_t;
+
+/** Number of buckets in the transfer latency histogram */
+#define BSP_SPI_LATENCY_BUCKETS (12u)
+
+/**
+ * Transfer statistics of an SPI instance.
+ * Counts blocking, direct DMA and queued transfers; streams and slave mode have their own counters.
+ * Latency runs from the API call to completion, so it includes the wait in the queue.
+ */
+typedef struct
+{
+    uint32_t uTransfers;                         /**< Transfers completed successfully */
+    uint32_t uBytes;                             /**< Bytes moved by those transfers */
+    uint32_t uBusyRejections;                    /**< Transfers refused with eBSP_SPI_ERR_BUSY (bus claimed or queue full) */
+    uint32_t uErrors;                            /**< Transfers failed to start or ended with an error */
+    uint32_t uBusyUs;                            /**< Time the bus spent on counted transfers, in microseconds */
+    uint32_t uLatencyMaxUs;                      /**< Longest request-to-completion time */
+    uint32_t auLatency[BSP_SPI_LATENCY_BUCKETS]; /**< Latency histogram: [0] < 16 us, [n] 2^(n+3) to 2^(n+4) us, last >= 16 ms */
+} BspSpiStats_t;
+
+/**
+ * Microsecond timebase for the transfer statistics.
+ *
+ * @return Free-running microsecond count wrapping at 2^32, e.g. a 32-bit timer (TIM2/TIM5) counting at 1 MHz
+ */
+typedef uint32_t (*BspSpiTimebase_t)(void);
+
+/**
+ * Callback type for streaming reception.
+ * Called from the DMA half-transfer and transfer-complete interrupts with the
+ * half of the circular buffer that has just been filled.
+ *
+ * @param handle The streaming SPI handle
+ * @param pData Filled half of the stream buffer
+ * @param uLength Length of the half in bytes
+ * @return true if the data has been consumed, false to keep it until BspSpiStreamRelease()
+ */
+typedef bool (*BspSpiStreamCb_t)(BspSpiHandle_t handle, const uint8_t* pData, uint32_t uLength);
+
+/**
+ * Streaming reception statistics.
+ */
+typedef struct
+{
+    uint32_t uBlocks;   /**< Half buffers delivered */
+    uint32_t uOverruns; /**< Half buffers overwritten while still held by the consumer */
+} BspSpiStreamStats_t;
+
+/**
+ * Callback type for slave-mode message notification.
+ * Called from the chip-select EXTI interrupt when the host has ended a frame
+ * and the message has been added to the receive queue.
+ *
+ * @param handle The slave-mode SPI handle
+ */
+typedef void (*BspSpiSlaveMsgCb_t)(BspSpiHandle_t handle);
+
+/**
+ * Slave mode configuration.
+ * Both rings are used by circular full-duplex DMA and must remain valid until
+ * BspSpiSlaveStop(). The driver runs the RX and TX DMA streams in circular mode
+ * until the stop; the MSP configures them in DMA_NORMAL mode, TX stream in
+ * direct mode (FIFO off).
+ */
+typedef struct
+{
+    uint8_t*           pRxRing;     /**< Receive ring, messages are read in place */
+    uint8_t*           pTxRing;     /**< Transmit ring, filled by BspSpiSlaveWrite() */
+    uint32_t           uRingLength; /**< Length of each ring in bytes (2-65535) */
+    uint32_t           uCsPin;      /**< Pin for bsp_gpio whose EXTI fires on the rising edge of the host's chip select */
+    BspSpiClockMode_e  eClockMode;  /**< Clock polarity and phase used by the host */
+    BspSpiSlaveMsgCb_t pOnMessage;  /**< Message notification, may be NULL */
+} BspSpiSlaveConfig_t;
+
+/**
+ * Received message, a view into the receive ring.
+ * A message that wraps around the end of the ring comes in two parts.
+ */
+typedef struct
+{
+    const uint8_t* pData;       /**< First part */
+    uint32_t       uLength;     /**< Length of the first part */
+    const uint8_t* pWrapData;   /**< Second part at the start of the ring, NULL if the message does not wrap */
+    uint32_t       uWrapLength; /**< Length of the second part */
+} BspSpiSlaveMsg_t;
+
+/**
+ * Slave mode statistics.
+ */
+typedef struct
+{
+    uint32_t uMessages;  /**< Frames ended by the host (chip select released after at least one byte) */
+    uint32_t uRxBytes;   /**< Bytes received in those frames */
+    uint32_t uOverruns;  /**< Messages lost: overwritten in the ring before release, or message queue full */
+    uint32_t uUnderruns; /**< Frames in which the host read past the data queued for transmit */
+} BspSpiSlaveStats_t;
+
+/**
+ * Device configuration for a shared bus.
+ * A zero-initialised frame format is 8-bit without CRC.
+ */
+typedef struct
+{
+    BspSpiHandle_t    hBus;           /**< Bus handle (DMA mode) */
+    uint32_t          uCsPin;         /**< Chip-select pin for BspGpioWritePin(), active low */
+    BspSpiClockMode_e eClockMode;     /**< Clock polarity and phase */
+    BspSpiPrescaler_e ePrescaler;     /**< Baud rate prescaler */
+    BspSpiDataSize_e  eDataSize;      /**< Frame size */
+    uint16_t          uCrcPolynomial; /**< Hardware CRC polynomial (odd, CRC width = frame size), 0 = no CRC */
+    bool              bDeselectClock; /**< Clock one frame of ones after releasing chip select (SD cards free MISO then) */
+} BspSpiDeviceConfig_t;
+
 /* --- Public Functions --- */
 
 /**
@@ -106,6 +381,8 @@ BspSpiHandle_t BspSpiAllocate(BspSpiInstance_e eInstance, BspSpiMode_e eMode, ui
 
 /**
  * Frees a previously allocated SPI module instance.
+ * A running stream or slave session is stopped first; queued transfers are dropped
+ * without callbacks.
  *
  * @param handle The SPI handle to free
  * @return Error code indicating success or failure
@@ -150,6 +427,11 @@ BspSpiError_e BspSpiRegisterErrorCallback(BspSpiHandle_t handle, BspSpiErrorCb_t
 
 /* --- Blocking Mode Functions --- */
 
+/*
+ * Transfers longer than 65535 frames (the HAL/DMA counter limit) are split into
+ * chunks; in blocking mode the timeout applies to each chunk.
+ */
+
 /**
  * Transmits data in blocking mode.
  * Note: Caller is responsible for chip select (CS) control.
@@ -186,6 +468,11 @@ BspSpiError_e BspSpiTransmitReceive(BspSpiHandle_t handle, const uint8_t* pTxDat
 
 /* --- DMA Mode Functions --- */
 
+/*
+ * Transfers longer than 65535 frames are split into chunks that are re-armed
+ * from the completion interrupt; the callback is called once at the end.
+ */
+
 /**
  * Transmits data using DMA.
  * Completion is signaled via the registered transmit callback.
@@ -223,6 +510,308 @@ BspSpiError_e BspSpiReceiveDMA(BspSpiHandle_t handle, uint8_t* pRxData, uint32_t
  */
 BspSpiError_e BspSpiTransmitReceiveDMA(BspSpiHandle_t handle, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength);
 
+/**
+ * Transfers a list of segments using DMA, e.g. a command header followed by a
+ * payload buffer, without copying them into one buffer.
+ * Each segment may be transmit-only, receive-only or full-duplex; the next
+ * segment is started from the completion interrupt, so chip select stays
+ * asserted. Completion is signaled once via the registered transmit-receive callback.
+ * Note: Caller is responsible for chip select (CS) control.
+ *
+ * @param handle The SPI handle
+ * @param pSegments Segment list (list and buffers must remain valid until callback)
+ * @param uCount Number of segments (>= 1)
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiTransferV(BspSpiHandle_t handle, const BspSpiSegment_t* pSegments, uint32_t uCount);
+
+/*
+ * Constant-fill transfers send the same frame for the whole length, e.g. the
+ * 0xFF clocks of an SD card or flash read phase, or a display clear, without a
+ * source buffer: the TX DMA stream reads the pattern from a single word with
+ * memory increment disabled, and restores memory increment when the transfer
+ * ends. The TX stream must be configured with memory increment (CubeMX default).
+ */
+
+/**
+ * Transmits the same frame uLength bytes long using DMA; received frames are discarded.
+ * Completion is signaled via the registered transmit callback.
+ * Note: Caller is responsible for chip select (CS) control.
+ *
+ * @param handle The SPI handle
+ * @param uPattern Frame to send (low byte with 8-bit frames)
+ * @param uLength Length in bytes (> 0, even with 16-bit frames)
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiTransmitFillDMA(BspSpiHandle_t handle, uint16_t uPattern, uint32_t uLength);
+
+/**
+ * Receives data using DMA while transmitting the same frame throughout (dummy TX).
+ * Completion is signaled via the registered transmit-receive callback.
+ * Note: Caller is responsible for chip select (CS) control.
+ *
+ * @param handle The SPI handle
+ * @param uPattern Frame to send, typically 0xFF (low byte with 8-bit frames)
+ * @param pRxData Pointer to the buffer to store received data (must remain valid until callback)
+ * @param uLength Length in bytes (> 0, even with 16-bit frames)
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiReceiveFillDMA(BspSpiHandle_t handle, uint16_t uPattern, uint8_t* pRxData, uint32_t uLength);
+
+/* --- Short Transfer Fast Path --- */
+
+/**
+ * Enables the polled register-level path for short transfers.
+ * Blocking and direct DMA transfers of 1 to uMaxLength bytes then bypass HAL and
+ * poll the data and status registers; on DMA handles the completion callback is
+ * called before the function returns. Queued and device transfers are not affected.
+ * Requires a full-duplex (2-line) 8-bit configuration; disabled after allocation.
+ *
+ * @param handle The SPI handle
+ * @param uMaxLength Longest transfer using the polled path (0 disables, max BSP_SPI_FAST_PATH_MAX)
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiSetFastPath(BspSpiHandle_t handle, uint32_t uMaxLength);
+
+/* --- Frame Format --- */
+
+/**
+ * Sets the frame size and hardware CRC of the bus.
+ * Applies to blocking, direct DMA, streaming and bus queue transfers; device
+ * transfers switch to their own format and the bus keeps the last one used.
+ * With CRC, the peripheral appends the CRC after the data and checks the CRC
+ * received after it; each DMA piece (segment or 65535-frame chunk) carries its
+ * own CRC. A mismatch is reported as eBSP_SPI_ERR_CRC. Also switches the
+ * transfer width of the TX and RX DMA streams. The polled fast path only runs
+ * with 8-bit frames without CRC.
+ *
+ * @param handle The SPI handle
+ * @param eDataSize Frame size
+ * @param uCrcPolynomial CRC polynomial (odd, CRC width = frame size), 0 disables CRC
+ * @return Error code; eBSP_SPI_ERR_BUSY while a transfer is in flight or queued
+ */
+BspSpiError_e BspSpiSetFrameFormat(BspSpiHandle_t handle, BspSpiDataSize_e eDataSize, uint16_t uCrcPolynomial);
+
+/* --- DMA Transaction Queue --- */
+
+/**
+ * Queues a DMA transfer.
+ * Starts immediately if the bus is idle; otherwise the transfer is started from
+ * the completion interrupt of the previous one. Transmit-only, receive-only or
+ * full-duplex is selected by which buffers are set. While queued transfers are
+ * pending or a device holds chip select, the direct DMA functions return
+ * eBSP_SPI_ERR_BUSY. bHoldCs is not allowed on bus transfers.
+ * Start failures are reported through the descriptor callback.
+ * May be called from thread context or from a queue completion callback.
+ * Note: Caller is responsible for chip select (CS) control, e.g. from the callbacks.
+ *
+ * @param handle The SPI handle (DMA mode)
+ * @param pXfer Transfer descriptor (copied)
+ * @return Error code; eBSP_SPI_ERR_BUSY if the queue is full
+ */
+BspSpiError_e BspSpiQueueTransfer(BspSpiHandle_t handle, const BspSpiXfer_t* pXfer);
+
+/**
+ * Gets transaction queue depth, high-water mark and counters.
+ *
+ * @param handle The SPI handle
+ * @param pStats Output: queue statistics
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiGetQueueStats(BspSpiHandle_t handle, BspSpiQueueStats_t* pStats);
+
+/**
+ * Resets the queue counters; the high-water mark restarts at the current depth.
+ *
+ * @param handle The SPI handle
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiResetQueueStats(BspSpiHandle_t handle);
+
+/* --- Transfer Statistics --- */
+
+/**
+ * Sets the timebase of the busy time and latency counters (all instances).
+ * Without a timebase only transfers, bytes, rejections and errors are counted.
+ *
+ * @param pfnMicros Microsecond timebase, or NULL
+ */
+void BspSpiSetTimebase(BspSpiTimebase_t pfnMicros);
+
+/**
+ * Enables or disables the transfer statistics of an instance (disabled after allocation).
+ * Enabling clears the counters. A disabled instance pays one flag test per transfer.
+ *
+ * @param handle The SPI handle
+ * @param bEnable true to count transfers
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiEnableStats(BspSpiHandle_t handle, bool bEnable);
+
+/**
+ * Gets a consistent snapshot of the transfer statistics.
+ *
+ * @param handle The SPI handle
+ * @param pStats Output: transfer statistics
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiGetStats(BspSpiHandle_t handle, BspSpiStats_t* pStats);
+
+/**
+ * Clears the transfer statistics; a transfer in flight is still counted when it completes.
+ *
+ * @param handle The SPI handle
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiResetStats(BspSpiHandle_t handle);
+
+/* --- Streaming Reception --- */
+
+/**
+ * Starts gapless reception into a circular buffer.
+ * The DMA runs in circular mode over pBuffer and never stops: each half is
+ * delivered to pCb as soon as it is full while the other half is being filled,
+ * so there is no per-block setup and no gap on the bus.
+ * The driver switches the DMA streams to circular mode for the stream and back
+ * to normal mode when it stops, so the MSP keeps them in DMA_NORMAL mode.
+ * Note: Caller is responsible for chip select (CS) control.
+ *
+ * @param handle The SPI handle (DMA mode, idle)
+ * @param pBuffer Circular buffer (must remain valid until BspSpiStopStream())
+ * @param uLength Buffer length in bytes (2-65534 frames, each half a whole number of frames)
+ * @param pCb Half-buffer callback
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiStartStream(BspSpiHandle_t handle, uint8_t* pBuffer, uint32_t uLength, BspSpiStreamCb_t pCb);
+
+/**
+ * Stops streaming reception and resumes queued transfers.
+ *
+ * @param handle The SPI handle
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiStopStream(BspSpiHandle_t handle);
+
+/**
+ * Releases the half buffer kept by a callback that returned false.
+ * If the DMA wraps into a half that is still held, an overrun is counted.
+ *
+ * @param handle The SPI handle
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiStreamRelease(BspSpiHandle_t handle);
+
+/**
+ * Gets streaming reception statistics.
+ *
+ * @param handle The SPI handle
+ * @param pStats Output: stream statistics
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiGetStreamStats(BspSpiHandle_t handle, BspSpiStreamStats_t* pStats);
+
+/* --- Slave Mode --- */
+
+/**
+ * Switches the bus to slave mode and starts circular full-duplex DMA.
+ * The host's clock and chip select (hardware NSS) drive the transfer; no
+ * CPU work is done per byte. Each rising edge of chip select ends a message:
+ * the bytes received since the previous edge are queued in place in the
+ * receive ring, and the same number of bytes is taken from the transmit ring.
+ * Only one bus can be in slave mode at a time. Slave mode uses 8-bit frames
+ * without CRC; BspSpiSlaveStop() restores the previous frame format.
+ *
+ * @param handle The SPI handle (DMA mode, idle)
+ * @param pConfig Slave configuration (copied)
+ * @return Error code; eBSP_SPI_ERR_NO_RESOURCE if another bus is in slave mode
+ */
+BspSpiError_e BspSpiSlaveStart(BspSpiHandle_t handle, const BspSpiSlaveConfig_t* pConfig);
+
+/**
+ * Stops slave mode, restores the master configuration and resumes queued transfers.
+ * Messages not yet released are discarded.
+ *
+ * @param handle The SPI handle
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiSlaveStop(BspSpiHandle_t handle);
+
+/**
+ * Gets the oldest received message without copying it.
+ * The message stays in the ring until BspSpiSlaveReleaseMessage(); it is
+ * overwritten (and counted as an overrun) if the host sends more than the
+ * free ring space before then.
+ *
+ * @param handle The SPI handle
+ * @param pMsg Output: message view
+ * @return Error code; eBSP_SPI_ERR_NO_DATA if no message is queued
+ */
+BspSpiError_e BspSpiSlaveGetMessage(BspSpiHandle_t handle, BspSpiSlaveMsg_t* pMsg);
+
+/**
+ * Releases the message returned by the last BspSpiSlaveGetMessage() call.
+ *
+ * @param handle The SPI handle
+ * @return Error code; eBSP_SPI_ERR_INVALID_PARAM if no message is held
+ */
+BspSpiError_e BspSpiSlaveReleaseMessage(BspSpiHandle_t handle);
+
+/**
+ * Queues data for the host to read in the following frames.
+ * The first byte of the next frame is already loaded into the data register
+ * at the end of a frame, so data queued while the transmit ring is empty
+ * starts at the second byte of the next frame (the first is BSP_SPI_SLAVE_FILL).
+ *
+ * @param handle The SPI handle
+ * @param pData Data to transmit (copied into the transmit ring)
+ * @param uLength Length in bytes
+ * @return Error code; eBSP_SPI_ERR_NO_RESOURCE if the transmit ring has no room
+ */
+BspSpiError_e BspSpiSlaveWrite(BspSpiHandle_t handle, const uint8_t* pData, uint32_t uLength);
+
+/**
+ * Gets slave mode statistics.
+ *
+ * @param handle The SPI handle
+ * @param pStats Output: slave statistics
+ * @return Error code indicating success or failure
+ */
+BspSpiError_e BspSpiSlaveGetStats(BspSpiHandle_t handle, BspSpiSlaveStats_t* pStats);
+
+/* --- Shared Bus Devices --- */
+
+/**
+ * Adds a device to a shared bus and releases its chip select.
+ *
+ * @param pConfig Device configuration (copied)
+ * @return Device handle (>= 0), or -1 on error
+ */
+BspSpiDeviceHandle_t BspSpiDeviceAdd(const BspSpiDeviceConfig_t* pConfig);
+
+/**
+ * Removes a device from its bus.
+ *
+ * A device holding chip select (bHoldCs) is released and the bus resumes.
+ *
+ * @param hDevice The device handle
+ * @return Error code; eBSP_SPI_ERR_BUSY while the device has queued transfers
+ */
+BspSpiError_e BspSpiDeviceRemove(BspSpiDeviceHandle_t hDevice);
+
+/**
+ * Queues a DMA transfer to a device on the bus transaction queue.
+ * When the transfer reaches the head of the queue, clock mode, prescaler and
+ * frame format are switched if they differ from the previous transfer, chip select is
+ * asserted and DMA is started; chip select is released in the completion
+ * interrupt before the next transfer is started. Back-to-back transfers to
+ * different devices therefore need no CPU involvement between them.
+ *
+ * @param hDevice The device handle
+ * @param pXfer Transfer descriptor (copied)
+ * @return Error code; eBSP_SPI_ERR_BUSY if the queue is full
+ */
+BspSpiError_e BspSpiDeviceQueueTransfer(BspSpiDeviceHandle_t hDevice, const BspSpiXfer_t* pXfer);
+
 #ifdef __cplusplus
 }
 #endif
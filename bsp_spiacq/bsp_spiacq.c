@@ -0,0 +1,438 @@
+/**
+ * @file bsp_spiacq.c
+ * @brief Periodic SPI sensor acquisition engine implementation
+ *
+ * Triple buffer per channel: three slots, owned by the writer (back), the
+ * reader (front) and neither (middle). The writer fills the back slot in the
+ * DMA completion interrupt and swaps it with the middle slot, marking it
+ * fresh; the reader swaps the middle slot into the front only if it is
+ * fresh. Both swaps are a single atomic exchange, so neither side ever waits
+ * and the reader's slot is never written.
+ */
+
+#include "bsp_spiacq.h"
+#include "bsp_compiler_attributes.h"
+#include "bsp_swtimer.h"
+#include "stm32f4xx_hal.h"
+#include <stdatomic.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * Private Constants
+ * ========================================================================== */
+
+/** Middle slot flag: published by the writer, not yet taken by the reader */
+#define SPIACQ_FRESH (0x80u)
+/** Slot index mask */
+#define SPIACQ_SLOT_MASK (0x03u)
+
+/* ============================================================================
+ * Private Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Triple buffer slot.
+ */
+typedef struct
+{
+    uint32_t uTimestampUs;
+    uint32_t uSequence; /**< 0 = never written */
+    uint8_t  abyData[BSP_SPIACQ_MAX_RESULT];
+} BspSpiAcqSlot_t;
+
+/**
+ * @brief Acquisition channel.
+ *
+ * Scheduling fields are owned by the SysTick interrupt, the back slot by the
+ * DMA completion interrupt and the front slot by the reader.
+ */
+typedef struct
+{
+    BspSpiAcqConfig_t    tConfig;
+    bool                 bAllocated;
+    volatile bool        bRunning;
+    volatile bool        bInFlight;
+    bool                 bJitterValid; /**< Previous sample was on schedule, the next interval counts */
+    uint32_t             uNextTick;    /**< SysTick of the next deadline */
+    uint32_t             uQueuedUs;    /**< Timestamp when the read was queued */
+    uint32_t             uLastUs;      /**< Completion time of the previous sample */
+    uint32_t             uSequence;
+    BspSpiSegment_t      atSeg[2];
+    uint8_t              byBack;   /**< Writer slot */
+    uint8_t              byFront;  /**< Reader slot */
+    atomic_uint_least8_t byMiddle; /**< Spare slot | SPIACQ_FRESH */
+    BspSpiAcqStats_t     tStats;
+    BspSpiAcqSlot_t      atSlot[3];
+} BspSpiAcqChannel_t;
+
+/* ============================================================================
+ * Private Global Variables
+ * ========================================================================== */
+
+/** Channel array */
+FORCE_STATIC BspSpiAcqChannel_t s_aAcqChannels[BSP_SPIACQ_MAX_CHANNELS] = {0};
+
+/** Scheduler timer, periodic at the SysTick rate */
+FORCE_STATIC SWTimerModule s_tAcqTimer = {0};
+
+/** Scheduler timer registered with bsp_swtimer */
+FORCE_STATIC bool s_bAcqTimerRegistered = false;
+
+/** Timestamp source, NULL for HAL_GetTick() */
+FORCE_STATIC BspSpiAcqTimebase_t s_pfnAcqMicros = NULL;
+
+/* ============================================================================
+ * Private Functions
+ * ========================================================================== */
+
+/**
+ * @brief Validate handle and return channel pointer.
+ */
+FORCE_STATIC BspSpiAcqChannel_t* sAcqValidateHandle(BspSpiAcqHandle_t handle)
+{
+    if ((handle < 0) || (handle >= (BspSpiAcqHandle_t)BSP_SPIACQ_MAX_CHANNELS))
+    {
+        return NULL;
+    }
+
+    if (!s_aAcqChannels[handle].bAllocated)
+    {
+        return NULL;
+    }
+
+    return &s_aAcqChannels[handle];
+}
+
+/**
+ * @brief Current timestamp in microseconds.
+ */
+FORCE_STATIC uint32_t sAcqNowUs(void)
+{
+    return (s_pfnAcqMicros != NULL) ? s_pfnAcqMicros() : (HAL_GetTick() * 1000u);
+}
+
+/**
+ * @brief Read completion (DMA interrupt): timestamp, statistics, publish.
+ */
+FORCE_STATIC void sAcqOnRead(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSpiAcqChannel_t* pChannel = (BspSpiAcqChannel_t*)pContext;
+
+    (void)hBus;
+    pChannel->bInFlight = false;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        pChannel->tStats.uErrors++;
+        pChannel->bJitterValid = false;
+        return;
+    }
+
+    uint32_t         uNowUs   = sAcqNowUs();
+    BspSpiAcqSlot_t* pSlot    = &pChannel->atSlot[pChannel->byBack];
+    uint32_t         uLatency = uNowUs - pChannel->uQueuedUs;
+
+    if (uLatency > pChannel->tStats.uLatencyMaxUs)
+    {
+        pChannel->tStats.uLatencyMaxUs = uLatency;
+    }
+
+    if (pChannel->bJitterValid)
+    {
+        uint32_t uInterval = uNowUs - pChannel->uLastUs;
+        uint32_t uPeriod   = (uint32_t)pChannel->tConfig.uPeriodMs * 1000u;
+        uint32_t uJitter   = (uInterval > uPeriod) ? (uInterval - uPeriod) : (uPeriod - uInterval);
+
+        if (uJitter > pChannel->tStats.uJitterMaxUs)
+        {
+            pChannel->tStats.uJitterMaxUs = uJitter;
+        }
+    }
+
+    pChannel->uLastUs      = uNowUs;
+    pChannel->bJitterValid = true;
+
+    pSlot->uTimestampUs = uNowUs;
+    pSlot->uSequence    = ++pChannel->uSequence;
+
+    /* Publish: the filled slot becomes the middle, the old middle the next back */
+    pChannel->byBack = (uint8_t)(atomic_exchange(&pChannel->byMiddle, (uint_least8_t)(pChannel->byBack | SPIACQ_FRESH)) & SPIACQ_SLOT_MASK);
+    pChannel->tStats.uSamples++;
+
+    if (pChannel->tConfig.pOnSample != NULL)
+    {
+        pChannel->tConfig.pOnSample((BspSpiAcqHandle_t)(pChannel - s_aAcqChannels));
+    }
+}
+
+/**
+ * @brief Queue one read into the back slot.
+ *
+ * @return false if the bus queue rejected the read
+ */
+FORCE_STATIC bool sAcqQueueRead(BspSpiAcqChannel_t* pChannel)
+{
+    BspSpiXfer_t tXfer = {0};
+
+    pChannel->atSeg[0] = (BspSpiSegment_t){pChannel->tConfig.abyCommand, NULL, pChannel->tConfig.byCommandLength};
+    pChannel->atSeg[1] = (BspSpiSegment_t){NULL, pChannel->atSlot[pChannel->byBack].abyData, pChannel->tConfig.byResultLength};
+
+    tXfer.pCallback = sAcqOnRead;
+    tXfer.pContext  = pChannel;
+    tXfer.pSegments = pChannel->atSeg;
+    tXfer.uSegments = 2u;
+
+    pChannel->bInFlight = true;
+    pChannel->uQueuedUs = sAcqNowUs();
+
+    if (BspSpiDeviceQueueTransfer(pChannel->tConfig.hDevice, &tXfer) != eBSP_SPI_ERR_NONE)
+    {
+        pChannel->bInFlight = false;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Scheduler tick (SysTick): queue the reads that are due.
+ */
+FORCE_STATIC void sAcqOnTick(void)
+{
+    uint32_t uNow = HAL_GetTick();
+
+    for (uint8_t i = 0u; i < BSP_SPIACQ_MAX_CHANNELS; i++)
+    {
+        BspSpiAcqChannel_t* pChannel = &s_aAcqChannels[i];
+
+        if (!pChannel->bAllocated || !pChannel->bRunning || ((int32_t)(uNow - pChannel->uNextTick) < 0))
+        {
+            continue;
+        }
+
+        pChannel->uNextTick += pChannel->tConfig.uPeriodMs;
+
+        /* Ticks lost (interrupts masked): skip the deadlines that have passed */
+        while ((int32_t)(uNow - pChannel->uNextTick) >= 0)
+        {
+            pChannel->uNextTick += pChannel->tConfig.uPeriodMs;
+            pChannel->tStats.uMissed++;
+            pChannel->bJitterValid = false;
+        }
+
+        if (pChannel->bInFlight || !sAcqQueueRead(pChannel))
+        {
+            pChannel->tStats.uMissed++;
+            pChannel->bJitterValid = false;
+        }
+    }
+}
+
+/* ============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+void BspSpiAcqSetTimebase(BspSpiAcqTimebase_t pfnMicros)
+{
+    s_pfnAcqMicros = pfnMicros;
+}
+
+BspSpiAcqHandle_t BspSpiAcqAdd(const BspSpiAcqConfig_t* pConfig)
+{
+    if (pConfig == NULL)
+    {
+        return BSP_SPIACQ_INVALID_HANDLE;
+    }
+
+    if ((pConfig->hDevice < 0) || (pConfig->byCommandLength == 0u) || (pConfig->byCommandLength > BSP_SPIACQ_MAX_COMMAND) ||
+        (pConfig->byResultLength == 0u) || (pConfig->byResultLength > BSP_SPIACQ_MAX_RESULT) || (pConfig->uPeriodMs == 0u))
+    {
+        return BSP_SPIACQ_INVALID_HANDLE;
+    }
+
+    for (uint8_t i = 0u; i < BSP_SPIACQ_MAX_CHANNELS; i++)
+    {
+        BspSpiAcqChannel_t* pChannel = &s_aAcqChannels[i];
+
+        if (pChannel->bAllocated)
+        {
+            continue;
+        }
+
+        pChannel->tConfig      = *pConfig;
+        pChannel->bRunning     = false;
+        pChannel->bInFlight    = false;
+        pChannel->bJitterValid = false;
+        pChannel->uSequence    = 0u;
+        pChannel->tStats       = (BspSpiAcqStats_t){0};
+        pChannel->byFront      = 0u;
+        pChannel->byBack       = 2u;
+        atomic_store(&pChannel->byMiddle, 1u);
+
+        for (uint8_t s = 0u; s < 3u; s++)
+        {
+            pChannel->atSlot[s].uSequence = 0u;
+        }
+
+        pChannel->bAllocated = true;
+        return (BspSpiAcqHandle_t)i;
+    }
+
+    return BSP_SPIACQ_INVALID_HANDLE;
+}
+
+BspSpiAcqError_e BspSpiAcqRemove(BspSpiAcqHandle_t handle)
+{
+    BspSpiAcqChannel_t* pChannel = sAcqValidateHandle(handle);
+
+    if (pChannel == NULL)
+    {
+        return eBSP_SPIACQ_ERR_INVALID_HANDLE;
+    }
+
+    if (pChannel->bRunning || pChannel->bInFlight)
+    {
+        return eBSP_SPIACQ_ERR_BUSY;
+    }
+
+    pChannel->bAllocated = false;
+    return eBSP_SPIACQ_ERR_NONE;
+}
+
+BspSpiAcqError_e BspSpiAcqStart(BspSpiAcqHandle_t handle)
+{
+    BspSpiAcqChannel_t* pChannel = sAcqValidateHandle(handle);
+
+    if (pChannel == NULL)
+    {
+        return eBSP_SPIACQ_ERR_INVALID_HANDLE;
+    }
+
+    if (!s_bAcqTimerRegistered)
+    {
+        s_tAcqTimer.interval          = 1u;
+        s_tAcqTimer.pCallbackFunction = sAcqOnTick;
+        s_tAcqTimer.periodic          = true;
+
+        if (!SWTimerInit(&s_tAcqTimer))
+        {
+            return eBSP_SPIACQ_ERR_NO_RESOURCE;
+        }
+        s_bAcqTimerRegistered = true;
+    }
+
+    __disable_irq();
+    pChannel->uNextTick    = HAL_GetTick() + 1u;
+    pChannel->bJitterValid = false;
+    pChannel->bRunning     = true;
+    __enable_irq();
+
+    if (!SWTimerIsActive(&s_tAcqTimer))
+    {
+        (void)SWTimerStart(&s_tAcqTimer);
+    }
+
+    return eBSP_SPIACQ_ERR_NONE;
+}
+
+BspSpiAcqError_e BspSpiAcqStop(BspSpiAcqHandle_t handle)
+{
+    BspSpiAcqChannel_t* pChannel = sAcqValidateHandle(handle);
+
+    if (pChannel == NULL)
+    {
+        return eBSP_SPIACQ_ERR_INVALID_HANDLE;
+    }
+
+    pChannel->bRunning = false;
+
+    /* Keep SysTick free of the scheduler while nothing is running */
+    bool bAnyRunning = false;
+    for (uint8_t i = 0u; i < BSP_SPIACQ_MAX_CHANNELS; i++)
+    {
+        bAnyRunning = bAnyRunning || (s_aAcqChannels[i].bAllocated && s_aAcqChannels[i].bRunning);
+    }
+
+    if (!bAnyRunning)
+    {
+        SWTimerStop(&s_tAcqTimer);
+    }
+
+    return eBSP_SPIACQ_ERR_NONE;
+}
+
+BspSpiAcqError_e BspSpiAcqGetLatest(BspSpiAcqHandle_t handle, BspSpiAcqSample_t* pSample)
+{
+    BspSpiAcqChannel_t* pChannel = sAcqValidateHandle(handle);
+
+    if (pChannel == NULL)
+    {
+        return eBSP_SPIACQ_ERR_INVALID_HANDLE;
+    }
+
+    if (pSample == NULL)
+    {
+        return eBSP_SPIACQ_ERR_INVALID_PARAM;
+    }
+
+    bool bFresh = (atomic_load(&pChannel->byMiddle) & SPIACQ_FRESH) != 0u;
+
+    /* Only the writer sets the flag, so a fresh middle slot stays available for this exchange */
+    if (bFresh)
+    {
+        pChannel->byFront = (uint8_t)(atomic_exchange(&pChannel->byMiddle, pChannel->byFront) & SPIACQ_SLOT_MASK);
+    }
+
+    const BspSpiAcqSlot_t* pSlot = &pChannel->atSlot[pChannel->byFront];
+
+    if (pSlot->uSequence == 0u)
+    {
+        return eBSP_SPIACQ_ERR_NO_DATA;
+    }
+
+    pSample->pData        = pSlot->abyData;
+    pSample->uLength      = pChannel->tConfig.byResultLength;
+    pSample->uTimestampUs = pSlot->uTimestampUs;
+    pSample->uSequence    = pSlot->uSequence;
+    pSample->bFresh       = bFresh;
+
+    return eBSP_SPIACQ_ERR_NONE;
+}
+
+BspSpiAcqError_e BspSpiAcqGetStats(BspSpiAcqHandle_t handle, BspSpiAcqStats_t* pStats)
+{
+    const BspSpiAcqChannel_t* pChannel = sAcqValidateHandle(handle);
+
+    if (pChannel == NULL)
+    {
+        return eBSP_SPIACQ_ERR_INVALID_HANDLE;
+    }
+
+    if (pStats == NULL)
+    {
+        return eBSP_SPIACQ_ERR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    *pStats = pChannel->tStats;
+    __enable_irq();
+
+    return eBSP_SPIACQ_ERR_NONE;
+}
+
+BspSpiAcqError_e BspSpiAcqResetStats(BspSpiAcqHandle_t handle)
+{
+    BspSpiAcqChannel_t* pChannel = sAcqValidateHandle(handle);
+
+    if (pChannel == NULL)
+    {
+        return eBSP_SPIACQ_ERR_INVALID_HANDLE;
+    }
+
+    __disable_irq();
+    pChannel->tStats       = (BspSpiAcqStats_t){0};
+    pChannel->bJitterValid = false;
+    __enable_irq();
+
+    return eBSP_SPIACQ_ERR_NONE;
+}
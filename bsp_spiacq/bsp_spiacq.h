@@ -0,0 +1,211 @@
+/**
+ * @file bsp_spiacq.h
+ * @brief Periodic SPI sensor acquisition engine
+ *
+ * - Channels: a bsp_spi device, a read command, a result length and a period
+ * - One SysTick-driven scheduler queues due reads on the bsp_spi device queue
+ * - Results are published through a lock-free triple buffer per channel:
+ *   the reader always gets the latest complete sample, never blocks and never
+ *   sees a sample that is being written
+ * - Per-channel statistics: interval jitter, latency and missed deadlines
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "bsp_spi.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/** @brief Maximum number of acquisition channels */
+#ifndef BSP_SPIACQ_MAX_CHANNELS
+    #define BSP_SPIACQ_MAX_CHANNELS (4u)
+#endif
+
+/**
+ * @brief Maximum result length in bytes.
+ * Memory impact: 3 × (BSP_SPIACQ_MAX_RESULT + 8) bytes per channel.
+ */
+#ifndef BSP_SPIACQ_MAX_RESULT
+    #define BSP_SPIACQ_MAX_RESULT (32u)
+#endif
+
+/** @brief Maximum read command length in bytes (register address, opcode) */
+#ifndef BSP_SPIACQ_MAX_COMMAND
+    #define BSP_SPIACQ_MAX_COMMAND (4u)
+#endif
+
+#if (BSP_SPIACQ_MAX_CHANNELS < 1u) || (BSP_SPIACQ_MAX_CHANNELS > 16u)
+    #error "BSP_SPIACQ_MAX_CHANNELS must be between 1 and 16"
+#endif
+
+#if (BSP_SPIACQ_MAX_RESULT < 1u) || (BSP_SPIACQ_MAX_RESULT > 255u) || (BSP_SPIACQ_MAX_COMMAND < 1u) || (BSP_SPIACQ_MAX_COMMAND > 255u)
+    #error "BSP_SPIACQ_MAX_RESULT and BSP_SPIACQ_MAX_COMMAND must be between 1 and 255"
+#endif
+
+/* ============================================================================
+ * Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Channel handle. Valid handles are >= 0.
+ */
+typedef int8_t BspSpiAcqHandle_t;
+
+/** Invalid handle constant */
+static const BspSpiAcqHandle_t BSP_SPIACQ_INVALID_HANDLE = -1;
+
+/**
+ * @brief Acquisition error codes.
+ */
+typedef enum
+{
+    eBSP_SPIACQ_ERR_NONE = 0u,      /**< Success */
+    eBSP_SPIACQ_ERR_INVALID_HANDLE, /**< Invalid or unallocated handle */
+    eBSP_SPIACQ_ERR_INVALID_PARAM,  /**< Invalid parameter */
+    eBSP_SPIACQ_ERR_BUSY,           /**< Read in flight */
+    eBSP_SPIACQ_ERR_NO_RESOURCE,    /**< No free channel or software timer */
+    eBSP_SPIACQ_ERR_NO_DATA         /**< No sample acquired yet */
+} BspSpiAcqError_e;
+
+/**
+ * @brief Sample notification (interrupt context, after the sample is published).
+ *
+ * @param handle     Channel handle
+ */
+typedef void (*BspSpiAcqSampleCb_t)(BspSpiAcqHandle_t handle);
+
+/**
+ * @brief Microsecond timestamp source.
+ * Free-running, wrapping at 2^32 (e.g. a 1 MHz timer or DWT->CYCCNT / MHz).
+ */
+typedef uint32_t (*BspSpiAcqTimebase_t)(void);
+
+/**
+ * @brief Channel configuration.
+ *
+ * A read is the command followed by uResultLength clocked bytes in one chip
+ * select; the bytes received after the command are the result.
+ */
+typedef struct
+{
+    BspSpiDeviceHandle_t hDevice;                            /**< bsp_spi device (chip select, clock mode) */
+    uint8_t              abyCommand[BSP_SPIACQ_MAX_COMMAND]; /**< Read command */
+    uint8_t              byCommandLength;                    /**< 1..BSP_SPIACQ_MAX_COMMAND */
+    uint8_t              byResultLength;                     /**< 1..BSP_SPIACQ_MAX_RESULT */
+    uint16_t             uPeriodMs;                          /**< Sample period in SysTick milliseconds (> 0) */
+    BspSpiAcqSampleCb_t  pOnSample;                          /**< Optional notification, may be NULL */
+} BspSpiAcqConfig_t;
+
+/**
+ * @brief Latest sample.
+ * pData points into the channel's reader buffer and stays valid and unchanged
+ * until the next BspSpiAcqGetLatest() call on the same channel.
+ */
+typedef struct
+{
+    const uint8_t* pData;        /**< Result bytes */
+    uint32_t       uLength;      /**< Result length */
+    uint32_t       uTimestampUs; /**< Completion time */
+    uint32_t       uSequence;    /**< Sample number, starting at 1 */
+    bool           bFresh;       /**< New since the previous call */
+} BspSpiAcqSample_t;
+
+/**
+ * @brief Channel statistics.
+ */
+typedef struct
+{
+    uint32_t uSamples;      /**< Samples published */
+    uint32_t uMissed;       /**< Deadlines skipped: previous read still in flight or bus queue full */
+    uint32_t uErrors;       /**< Reads ended with a transfer error */
+    uint32_t uJitterMaxUs;  /**< Largest deviation of a sample interval from the period */
+    uint32_t uLatencyMaxUs; /**< Largest time from scheduling to completion */
+} BspSpiAcqStats_t;
+
+/* ============================================================================
+ * Public API
+ * ========================================================================== */
+
+/**
+ * @brief Set the timestamp source for all channels.
+ *
+ * Without a timebase, timestamps are HAL_GetTick() × 1000 and jitter is
+ * resolved to one millisecond only.
+ *
+ * @param pfnMicros  Microsecond counter, NULL for HAL_GetTick()
+ */
+void BspSpiAcqSetTimebase(BspSpiAcqTimebase_t pfnMicros);
+
+/**
+ * @brief Add an acquisition channel (stopped).
+ *
+ * @param pConfig    Channel configuration (copied)
+ * @return           Channel handle, BSP_SPIACQ_INVALID_HANDLE on error
+ */
+BspSpiAcqHandle_t BspSpiAcqAdd(const BspSpiAcqConfig_t* pConfig);
+
+/**
+ * @brief Remove a stopped channel.
+ *
+ * @param handle     Channel handle
+ * @return           Error code; eBSP_SPIACQ_ERR_BUSY while running or a read is in flight
+ */
+BspSpiAcqError_e BspSpiAcqRemove(BspSpiAcqHandle_t handle);
+
+/**
+ * @brief Start periodic acquisition. The first read is scheduled on the next tick.
+ *
+ * @param handle     Channel handle
+ * @return           Error code; eBSP_SPIACQ_ERR_NO_RESOURCE if the scheduler timer cannot be registered
+ */
+BspSpiAcqError_e BspSpiAcqStart(BspSpiAcqHandle_t handle);
+
+/**
+ * @brief Stop periodic acquisition. A read in flight still completes and is published.
+ *
+ * @param handle     Channel handle
+ * @return           Error code
+ */
+BspSpiAcqError_e BspSpiAcqStop(BspSpiAcqHandle_t handle);
+
+/**
+ * @brief Get the latest sample without blocking.
+ *
+ * Single reader per channel (not reentrant). Never waits for the writer:
+ * if no newer sample is ready, the previous one is returned with bFresh false.
+ *
+ * @param handle     Channel handle
+ * @param pSample    Output: latest sample
+ * @return           Error code; eBSP_SPIACQ_ERR_NO_DATA before the first sample
+ */
+BspSpiAcqError_e BspSpiAcqGetLatest(BspSpiAcqHandle_t handle, BspSpiAcqSample_t* pSample);
+
+/**
+ * @brief Get channel statistics.
+ *
+ * @param handle     Channel handle
+ * @param pStats     Output: statistics snapshot
+ * @return           Error code
+ */
+BspSpiAcqError_e BspSpiAcqGetStats(BspSpiAcqHandle_t handle, BspSpiAcqStats_t* pStats);
+
+/**
+ * @brief Reset channel statistics.
+ *
+ * @param handle     Channel handle
+ * @return           Error code
+ */
+BspSpiAcqError_e BspSpiAcqResetStats(BspSpiAcqHandle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
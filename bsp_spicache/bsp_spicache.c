@@ -0,0 +1,879 @@
+/**
+ * @file bsp_spicache.c
+ * @brief Software cache for external SPI PSRAM and FRAM implementation
+ *
+ * Line fills and write-backs are bsp_spi device transfers. Their completion
+ * callbacks only update the line state; the API functions queue the transfers
+ * and spin on that state. Because the bus queue is FIFO, the write-back of a
+ * dirty victim is queued ahead of the fill that reuses its buffer:
+ *
+ *   miss: [WREN] + write-back(victim) -> fill(line) -> [prefetch fill(line + 1)]
+ *                                       ^ wait here
+ */
+
+#include "bsp_spicache.h"
+#include "bsp_compiler_attributes.h"
+#include "stm32f4xx_hal.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================================================
+ * Private Constants
+ * ========================================================================== */
+
+#define SPICACHE_CMD_WREN       (0x06u) /**< FRAM write enable */
+#define SPICACHE_CMD_WRITE      (0x02u) /**< Write, PSRAM and FRAM */
+#define SPICACHE_CMD_READ       (0x03u) /**< FRAM read */
+#define SPICACHE_CMD_FAST_READ  (0x0Bu) /**< PSRAM fast read, one dummy byte */
+
+#define SPICACHE_LINE_MIN       (16u)
+#define SPICACHE_LINE_MAX       (1024u)
+#define SPICACHE_SIZE_MAX       (0x1000000u) /**< 3-byte addressing */
+#define SPICACHE_FRAM_SHORT_MAX (0x10000u)   /**< FRAM up to this size takes 2 address bytes */
+
+/* ============================================================================
+ * Private Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Line state.
+ */
+typedef enum
+{
+    eSPICACHE_LINE_INVALID = 0u,
+    eSPICACHE_LINE_VALID,
+    eSPICACHE_LINE_FILLING, /**< Fill queued or in flight */
+    eSPICACHE_LINE_FAILED   /**< Fill ended with an error, contents undefined */
+} BspSpiCacheLineState_e;
+
+/**
+ * @brief Line tag and the transfer state of its fill and write-back.
+ *
+ * eState and bWriting are set by the API before a transfer is queued and
+ * cleared by its completion callback. Fill and write-back have separate
+ * headers because a write-back may still be queued when the line is refilled.
+ */
+typedef struct
+{
+    uint32_t                        uAddress; /**< Memory address of the line */
+    uint32_t                        uLastUse; /**< LRU stamp */
+    volatile BspSpiCacheLineState_e eState;
+    volatile bool                   bWriting;     /**< Write-back queued or in flight */
+    volatile bool                   bWriteFailed; /**< Write-back or its write enable failed */
+    bool                            bDirty;
+    bool                            bRef;        /**< Clock reference bit */
+    bool                            bPrefetched; /**< Filled ahead and not accessed yet */
+    uint8_t                         abyFillCmd[5];
+    uint8_t                         abyWriteCmd[4];
+    BspSpiSegment_t                 atFillSeg[2];
+    BspSpiSegment_t                 atWriteSeg[2];
+} BspSpiCacheLine_t;
+
+/**
+ * @brief Cache instance.
+ */
+typedef struct
+{
+    BspSpiCacheConfig_t  tConfig;
+    bool                 bAllocated;
+    BspSpiDeviceHandle_t hDevice;
+    uint8_t              byAddrBytes;  /**< Address bytes after the command */
+    uint8_t              byLineShift;  /**< log2(uLineSize) */
+    uint16_t             uHand;        /**< Clock hand */
+    uint16_t             uLastHit;     /**< Line of the last access, checked first */
+    uint32_t             uClock;       /**< LRU time, one tick per line access */
+    uint32_t             uLastAddress; /**< Line address of the last access, for sequence detection */
+    BspSpiCacheStats_t   tStats;
+    BspSpiCacheLine_t    atLine[BSP_SPICACHE_MAX_LINES];
+} BspSpiCache_t;
+
+/* ============================================================================
+ * Private Global Variables
+ * ========================================================================== */
+
+/** Cache instance array */
+FORCE_STATIC BspSpiCache_t s_aSpiCache[BSP_SPICACHE_MAX_INSTANCES] = {0};
+
+/** FRAM write enable command, shared by all instances */
+FORCE_STATIC const uint8_t s_byWren = SPICACHE_CMD_WREN;
+
+/* ============================================================================
+ * Private Functions
+ * ========================================================================== */
+
+/**
+ * @brief Validate handle and return instance pointer.
+ */
+FORCE_STATIC BspSpiCache_t* sSpiCacheValidateHandle(BspSpiCacheHandle_t handle)
+{
+    if ((handle < 0) || (handle >= (BspSpiCacheHandle_t)BSP_SPICACHE_MAX_INSTANCES))
+    {
+        return NULL;
+    }
+
+    if (!s_aSpiCache[handle].bAllocated)
+    {
+        return NULL;
+    }
+
+    return &s_aSpiCache[handle];
+}
+
+/**
+ * @brief Check a configuration: geometry, memory size and enumerations.
+ */
+FORCE_STATIC bool sSpiCacheCheckConfig(const BspSpiCacheConfig_t* pConfig)
+{
+    uint32_t uLineSize = pConfig->uLineSize;
+
+    if ((pConfig->pLines == NULL) || (uLineSize < SPICACHE_LINE_MIN) || (uLineSize > SPICACHE_LINE_MAX) ||
+        ((uLineSize & (uLineSize - 1u)) != 0u))
+    {
+        return false;
+    }
+
+    if ((pConfig->uLineCount == 0u) || (pConfig->uLineCount > BSP_SPICACHE_MAX_LINES))
+    {
+        return false;
+    }
+
+    if ((pConfig->uSize < uLineSize) || (pConfig->uSize > SPICACHE_SIZE_MAX) || ((pConfig->uSize & (uLineSize - 1u)) != 0u))
+    {
+        return false;
+    }
+
+    return (pConfig->eMemory <= eBSP_SPICACHE_MEM_FRAM) && (pConfig->ePolicy <= eBSP_SPICACHE_POLICY_CLOCK) &&
+           (pConfig->ePrescaler < eBSP_SPI_PRESCALER_COUNT);
+}
+
+/**
+ * @brief Data of a line.
+ */
+FORCE_STATIC uint8_t* sSpiCacheData(const BspSpiCache_t* pCache, const BspSpiCacheLine_t* pLine)
+{
+    return &pCache->tConfig.pLines[(uint32_t)(pLine - pCache->atLine) << pCache->byLineShift];
+}
+
+/**
+ * @brief Write a command byte and the address into a header, return the header length.
+ */
+FORCE_STATIC uint32_t sSpiCacheSetCmd(const BspSpiCache_t* pCache, uint8_t* pHeader, uint8_t byCmd, uint32_t uAddress)
+{
+    uint32_t uLength = 1u;
+
+    pHeader[0] = byCmd;
+    if (pCache->byAddrBytes == 3u)
+    {
+        pHeader[uLength++] = (uint8_t)(uAddress >> 16u);
+    }
+    pHeader[uLength++] = (uint8_t)(uAddress >> 8u);
+    pHeader[uLength++] = (uint8_t)uAddress;
+
+    return uLength;
+}
+
+/**
+ * @brief Fill completion (interrupt context).
+ */
+FORCE_STATIC void sSpiCacheOnFill(BspSpiHandle_t handle, BspSpiError_e eError, void* pContext)
+{
+    BspSpiCacheLine_t* pLine = (BspSpiCacheLine_t*)pContext;
+
+    (void)handle;
+    pLine->eState = (eError == eBSP_SPI_ERR_NONE) ? eSPICACHE_LINE_VALID : eSPICACHE_LINE_FAILED;
+}
+
+/**
+ * @brief FRAM write enable completion (interrupt context).
+ */
+FORCE_STATIC void sSpiCacheOnWren(BspSpiHandle_t handle, BspSpiError_e eError, void* pContext)
+{
+    BspSpiCacheLine_t* pLine = (BspSpiCacheLine_t*)pContext;
+
+    (void)handle;
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        pLine->bWriteFailed = true;
+    }
+}
+
+/**
+ * @brief Write-back completion (interrupt context).
+ */
+FORCE_STATIC void sSpiCacheOnWrite(BspSpiHandle_t handle, BspSpiError_e eError, void* pContext)
+{
+    BspSpiCacheLine_t* pLine = (BspSpiCacheLine_t*)pContext;
+
+    (void)handle;
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        pLine->bWriteFailed = true;
+    }
+    pLine->bWriting = false;
+}
+
+/**
+ * @brief Queue the write-back of a dirty line.
+ *
+ * The line is clean from here on; a failure is reported through bWriteFailed.
+ */
+FORCE_STATIC BspSpiCacheError_e sSpiCacheWriteBack(BspSpiCache_t* pCache, BspSpiCacheLine_t* pLine)
+{
+    BspSpiXfer_t tXfer   = {0};
+    uint32_t     uHeader = sSpiCacheSetCmd(pCache, pLine->abyWriteCmd, SPICACHE_CMD_WRITE, pLine->uAddress);
+    uint32_t     uBytes  = uHeader + pCache->tConfig.uLineSize;
+
+    if (pCache->tConfig.eMemory == eBSP_SPICACHE_MEM_FRAM)
+    {
+        tXfer.pTxData   = &s_byWren;
+        tXfer.uLength   = 1u;
+        tXfer.pCallback = sSpiCacheOnWren;
+        tXfer.pContext  = pLine;
+
+        if (BspSpiDeviceQueueTransfer(pCache->hDevice, &tXfer) != eBSP_SPI_ERR_NONE)
+        {
+            return eBSP_SPICACHE_ERR_BUSY;
+        }
+        uBytes++;
+    }
+
+    pLine->atWriteSeg[0].pTxData = pLine->abyWriteCmd;
+    pLine->atWriteSeg[0].pRxData = NULL;
+    pLine->atWriteSeg[0].uLength = uHeader;
+    pLine->atWriteSeg[1].pTxData = sSpiCacheData(pCache, pLine);
+    pLine->atWriteSeg[1].pRxData = NULL;
+    pLine->atWriteSeg[1].uLength = pCache->tConfig.uLineSize;
+
+    tXfer           = (BspSpiXfer_t){0};
+    tXfer.pSegments = pLine->atWriteSeg;
+    tXfer.uSegments = 2u;
+    tXfer.pCallback = sSpiCacheOnWrite;
+    tXfer.pContext  = pLine;
+
+    /* Set before queuing: the completion may run before the call returns */
+    pLine->bWriting = true;
+
+    if (BspSpiDeviceQueueTransfer(pCache->hDevice, &tXfer) != eBSP_SPI_ERR_NONE)
+    {
+        /* A lone write enable is harmless */
+        pLine->bWriting = false;
+        return eBSP_SPICACHE_ERR_BUSY;
+    }
+
+    pLine->bDirty = false;
+    pCache->tStats.uWriteBacks++;
+    pCache->tStats.uBusBytes += uBytes;
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+/**
+ * @brief Queue the fill of a line.
+ */
+FORCE_STATIC BspSpiCacheError_e sSpiCacheFill(BspSpiCache_t* pCache, BspSpiCacheLine_t* pLine)
+{
+    BspSpiXfer_t tXfer = {0};
+    uint32_t     uHeader;
+
+    if (pCache->tConfig.eMemory == eBSP_SPICACHE_MEM_PSRAM)
+    {
+        uHeader                    = sSpiCacheSetCmd(pCache, pLine->abyFillCmd, SPICACHE_CMD_FAST_READ, pLine->uAddress);
+        pLine->abyFillCmd[uHeader] = 0xFFu;
+        uHeader++;
+    }
+    else
+    {
+        uHeader = sSpiCacheSetCmd(pCache, pLine->abyFillCmd, SPICACHE_CMD_READ, pLine->uAddress);
+    }
+
+    pLine->atFillSeg[0].pTxData = pLine->abyFillCmd;
+    pLine->atFillSeg[0].pRxData = NULL;
+    pLine->atFillSeg[0].uLength = uHeader;
+    pLine->atFillSeg[1].pTxData = NULL;
+    pLine->atFillSeg[1].pRxData = sSpiCacheData(pCache, pLine);
+    pLine->atFillSeg[1].uLength = pCache->tConfig.uLineSize;
+
+    tXfer.pSegments = pLine->atFillSeg;
+    tXfer.uSegments = 2u;
+    tXfer.pCallback = sSpiCacheOnFill;
+    tXfer.pContext  = pLine;
+
+    pLine->eState = eSPICACHE_LINE_FILLING;
+
+    if (BspSpiDeviceQueueTransfer(pCache->hDevice, &tXfer) != eBSP_SPI_ERR_NONE)
+    {
+        pLine->eState = eSPICACHE_LINE_INVALID;
+        return eBSP_SPICACHE_ERR_BUSY;
+    }
+
+    pCache->tStats.uBusBytes += uHeader + pCache->tConfig.uLineSize;
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+/**
+ * @brief Wait until a line has no fill or write-back in flight.
+ *
+ * @return eBSP_SPICACHE_ERR_SPI if a write-back of the line failed (reported once)
+ */
+FORCE_STATIC BspSpiCacheError_e sSpiCacheWaitLine(BspSpiCacheLine_t* pLine)
+{
+    if ((pLine->eState == eSPICACHE_LINE_FILLING) || pLine->bWriting)
+    {
+        uint32_t uStart = HAL_GetTick();
+
+        while ((pLine->eState == eSPICACHE_LINE_FILLING) || pLine->bWriting)
+        {
+            if ((HAL_GetTick() - uStart) > BSP_SPICACHE_TIMEOUT_MS)
+            {
+                return eBSP_SPICACHE_ERR_TIMEOUT;
+            }
+        }
+    }
+
+    if (pLine->bWriteFailed)
+    {
+        pLine->bWriteFailed = false;
+        return eBSP_SPICACHE_ERR_SPI;
+    }
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+/**
+ * @brief Wait for all lines, return the first error.
+ */
+FORCE_STATIC BspSpiCacheError_e sSpiCacheWaitAll(BspSpiCache_t* pCache)
+{
+    BspSpiCacheError_e eResult = eBSP_SPICACHE_ERR_NONE;
+
+    for (uint16_t i = 0u; i < pCache->tConfig.uLineCount; i++)
+    {
+        BspSpiCacheError_e eError = sSpiCacheWaitLine(&pCache->atLine[i]);
+
+        if (eResult == eBSP_SPICACHE_ERR_NONE)
+        {
+            eResult = eError;
+        }
+    }
+
+    return eResult;
+}
+
+/**
+ * @brief Find the line holding an address, checking the last accessed line first.
+ */
+FORCE_STATIC BspSpiCacheLine_t* sSpiCacheLookup(BspSpiCache_t* pCache, uint32_t uAddress)
+{
+    BspSpiCacheLine_t* pLine = &pCache->atLine[pCache->uLastHit];
+
+    if ((pLine->eState != eSPICACHE_LINE_INVALID) && (pLine->uAddress == uAddress))
+    {
+        return pLine;
+    }
+
+    for (uint16_t i = 0u; i < pCache->tConfig.uLineCount; i++)
+    {
+        pLine = &pCache->atLine[i];
+
+        if ((pLine->eState != eSPICACHE_LINE_INVALID) && (pLine->uAddress == uAddress))
+        {
+            return pLine;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Choose the line to replace. Lines being filled and pExclude are skipped.
+ *
+ * Empty and failed lines are taken first. LRU takes the oldest stamp; clock
+ * clears reference bits until it finds a line without one.
+ */
+FORCE_STATIC BspSpiCacheLine_t* sSpiCacheVictim(BspSpiCache_t* pCache, const BspSpiCacheLine_t* pExclude)
+{
+    uint16_t           uCount  = pCache->tConfig.uLineCount;
+    BspSpiCacheLine_t* pVictim = NULL;
+
+    for (uint16_t i = 0u; i < uCount; i++)
+    {
+        BspSpiCacheLine_t* pLine = &pCache->atLine[i];
+
+        if ((pLine == pExclude) || (pLine->eState == eSPICACHE_LINE_FILLING))
+        {
+            continue;
+        }
+
+        if (pLine->eState != eSPICACHE_LINE_VALID)
+        {
+            return pLine;
+        }
+
+        if ((pVictim == NULL) || ((int32_t)(pLine->uLastUse - pVictim->uLastUse) < 0))
+        {
+            pVictim = pLine;
+        }
+    }
+
+    if ((pVictim == NULL) || (pCache->tConfig.ePolicy == eBSP_SPICACHE_POLICY_LRU))
+    {
+        return pVictim;
+    }
+
+    /* Two sweeps at most: the first may only clear reference bits */
+    for (uint32_t uStep = 0u; uStep < (2u * uCount); uStep++)
+    {
+        BspSpiCacheLine_t* pLine = &pCache->atLine[pCache->uHand];
+
+        pCache->uHand = (uint16_t)((pCache->uHand + 1u) % uCount);
+
+        if ((pLine == pExclude) || (pLine->eState == eSPICACHE_LINE_FILLING))
+        {
+            continue;
+        }
+
+        if (!pLine->bRef)
+        {
+            return pLine;
+        }
+        pLine->bRef = false;
+    }
+
+    return pVictim;
+}
+
+/**
+ * @brief Take a line for a new address: write back its old contents if dirty.
+ */
+FORCE_STATIC BspSpiCacheError_e sSpiCacheClaim(BspSpiCache_t* pCache, BspSpiCacheLine_t* pLine, uint32_t uAddress)
+{
+    if (pLine->bDirty && (pLine->eState == eSPICACHE_LINE_VALID))
+    {
+        BspSpiCacheError_e eError = sSpiCacheWriteBack(pCache, pLine);
+
+        if (eError != eBSP_SPICACHE_ERR_NONE)
+        {
+            return eError;
+        }
+    }
+
+    pLine->uAddress    = uAddress;
+    pLine->uLastUse    = pCache->uClock;
+    pLine->bDirty      = false;
+    pLine->bRef        = false;
+    pLine->bPrefetched = false;
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+/**
+ * @brief Fill the line after pCurrent in the background, if it is not cached.
+ *
+ * Skipped quietly when no line can be replaced or the bus queue is full.
+ */
+FORCE_STATIC void sSpiCachePrefetch(BspSpiCache_t* pCache, const BspSpiCacheLine_t* pCurrent)
+{
+    uint32_t           uNext = pCurrent->uAddress + pCache->tConfig.uLineSize;
+    BspSpiCacheLine_t* pLine;
+
+    if ((uNext >= pCache->tConfig.uSize) || (sSpiCacheLookup(pCache, uNext) != NULL))
+    {
+        return;
+    }
+
+    pLine = sSpiCacheVictim(pCache, pCurrent);
+    if ((pLine == NULL) || (sSpiCacheClaim(pCache, pLine, uNext) != eBSP_SPICACHE_ERR_NONE))
+    {
+        return;
+    }
+
+    if (sSpiCacheFill(pCache, pLine) == eBSP_SPICACHE_ERR_NONE)
+    {
+        pLine->bPrefetched = true;
+        pCache->tStats.uPrefetches++;
+    }
+}
+
+/**
+ * @brief Get the line for an access, filling it on a miss.
+ *
+ * @param pCache     Cache instance
+ * @param uAddress   Line address
+ * @param bWrite     Write access: the line is also waited on for write-backs
+ * @param bWhole     Write access covering the whole line: no fill on a miss
+ * @param ppLine     Output: the line, valid
+ */
+FORCE_STATIC BspSpiCacheError_e sSpiCacheAccess(BspSpiCache_t* pCache, uint32_t uAddress, bool bWrite, bool bWhole,
+                                                BspSpiCacheLine_t** ppLine)
+{
+    BspSpiCacheLine_t* pLine       = sSpiCacheLookup(pCache, uAddress);
+    bool               bSequential = (uAddress == (pCache->uLastAddress + pCache->tConfig.uLineSize));
+    BspSpiCacheError_e eError      = eBSP_SPICACHE_ERR_NONE;
+
+    pCache->uClock++;
+
+    if (pLine != NULL)
+    {
+        /* A prefetch may still be on the bus */
+        eError = sSpiCacheWaitLine(pLine);
+        if (eError == eBSP_SPICACHE_ERR_TIMEOUT)
+        {
+            return eError;
+        }
+    }
+
+    if ((pLine != NULL) && (pLine->eState == eSPICACHE_LINE_VALID))
+    {
+        if (pLine->bPrefetched)
+        {
+            pLine->bPrefetched = false;
+            pCache->tStats.uPrefetchHits++;
+        }
+        if (bWrite)
+        {
+            pCache->tStats.uWriteHits++;
+        }
+        else
+        {
+            pCache->tStats.uReadHits++;
+        }
+    }
+    else
+    {
+        if (pLine == NULL)
+        {
+            pLine = sSpiCacheVictim(pCache, NULL);
+            if (pLine == NULL)
+            {
+                return eBSP_SPICACHE_ERR_BUSY;
+            }
+        }
+
+        if (bWrite)
+        {
+            pCache->tStats.uWriteMisses++;
+        }
+        else
+        {
+            pCache->tStats.uReadMisses++;
+        }
+
+        eError = sSpiCacheClaim(pCache, pLine, uAddress);
+        if (eError != eBSP_SPICACHE_ERR_NONE)
+        {
+            return eError;
+        }
+
+        if (bWhole)
+        {
+            pLine->eState = eSPICACHE_LINE_VALID;
+        }
+        else
+        {
+            eError = sSpiCacheFill(pCache, pLine);
+            if (eError != eBSP_SPICACHE_ERR_NONE)
+            {
+                return eError;
+            }
+        }
+    }
+
+    pLine->uLastUse      = pCache->uClock;
+    pLine->bRef          = true;
+    pCache->uLastHit     = (uint16_t)(pLine - pCache->atLine);
+    pCache->uLastAddress = uAddress;
+
+    if (bSequential && pCache->tConfig.bPrefetch)
+    {
+        sSpiCachePrefetch(pCache, pLine);
+    }
+
+    /* The fill of this line is ahead of the prefetch on the bus; a write waits
+     * for a write-back of the victim's old contents from the same buffer */
+    if ((pLine->eState == eSPICACHE_LINE_FILLING) || (bWrite && pLine->bWriting))
+    {
+        BspSpiCacheError_e eWait = sSpiCacheWaitLine(pLine);
+
+        if (eError == eBSP_SPICACHE_ERR_NONE)
+        {
+            eError = eWait;
+        }
+    }
+
+    if (pLine->eState != eSPICACHE_LINE_VALID)
+    {
+        return (eError != eBSP_SPICACHE_ERR_NONE) ? eError : eBSP_SPICACHE_ERR_SPI;
+    }
+
+    *ppLine = pLine;
+    return eError;
+}
+
+/**
+ * @brief Check an access range.
+ */
+FORCE_STATIC bool sSpiCacheCheckRange(const BspSpiCache_t* pCache, uint32_t uAddress, const void* pData, uint32_t uLength)
+{
+    return (pData != NULL) && (uLength != 0u) && (uAddress < pCache->tConfig.uSize) && (uLength <= (pCache->tConfig.uSize - uAddress));
+}
+
+/* ============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+BspSpiCacheHandle_t BspSpiCacheAllocate(const BspSpiCacheConfig_t* pConfig)
+{
+    if ((pConfig == NULL) || !sSpiCacheCheckConfig(pConfig))
+    {
+        return BSP_SPICACHE_INVALID_HANDLE;
+    }
+
+    for (uint8_t i = 0u; i < BSP_SPICACHE_MAX_INSTANCES; i++)
+    {
+        BspSpiCache_t* pCache = &s_aSpiCache[i];
+
+        if (pCache->bAllocated)
+        {
+            continue;
+        }
+
+        BspSpiDeviceConfig_t tDevice = {0};
+        tDevice.hBus                 = pConfig->hBus;
+        tDevice.uCsPin               = pConfig->uCsPin;
+        tDevice.eClockMode           = pConfig->eClockMode;
+        tDevice.ePrescaler           = pConfig->ePrescaler;
+
+        BspSpiDeviceHandle_t hDevice = BspSpiDeviceAdd(&tDevice);
+
+        if (hDevice < 0)
+        {
+            return BSP_SPICACHE_INVALID_HANDLE;
+        }
+
+        (void)memset(pCache, 0, sizeof(*pCache));
+        pCache->tConfig      = *pConfig;
+        pCache->hDevice      = hDevice;
+        pCache->byAddrBytes  = ((pConfig->eMemory == eBSP_SPICACHE_MEM_FRAM) && (pConfig->uSize <= SPICACHE_FRAM_SHORT_MAX)) ? 2u : 3u;
+        pCache->uLastAddress = SPICACHE_SIZE_MAX;
+
+        while ((1u << pCache->byLineShift) < pConfig->uLineSize)
+        {
+            pCache->byLineShift++;
+        }
+
+        pCache->bAllocated = true;
+        return (BspSpiCacheHandle_t)i;
+    }
+
+    return BSP_SPICACHE_INVALID_HANDLE;
+}
+
+BspSpiCacheError_e BspSpiCacheFree(BspSpiCacheHandle_t handle)
+{
+    BspSpiCache_t*     pCache = sSpiCacheValidateHandle(handle);
+    BspSpiCacheError_e eError;
+
+    if (pCache == NULL)
+    {
+        return eBSP_SPICACHE_ERR_INVALID_HANDLE;
+    }
+
+    eError = BspSpiCacheFlush(handle);
+    if (eError != eBSP_SPICACHE_ERR_NONE)
+    {
+        return eError;
+    }
+
+    if (BspSpiDeviceRemove(pCache->hDevice) != eBSP_SPI_ERR_NONE)
+    {
+        return eBSP_SPICACHE_ERR_BUSY;
+    }
+
+    pCache->bAllocated = false;
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+BspSpiCacheError_e BspSpiCacheRead(BspSpiCacheHandle_t handle, uint32_t uAddress, void* pData, uint32_t uLength)
+{
+    BspSpiCache_t* pCache = sSpiCacheValidateHandle(handle);
+    uint8_t*       pDst   = (uint8_t*)pData;
+
+    if (pCache == NULL)
+    {
+        return eBSP_SPICACHE_ERR_INVALID_HANDLE;
+    }
+
+    if (!sSpiCacheCheckRange(pCache, uAddress, pData, uLength))
+    {
+        return eBSP_SPICACHE_ERR_INVALID_PARAM;
+    }
+
+    while (uLength > 0u)
+    {
+        uint32_t           uOffset = uAddress & (pCache->tConfig.uLineSize - 1u);
+        uint32_t           uChunk  = pCache->tConfig.uLineSize - uOffset;
+        BspSpiCacheLine_t* pLine   = NULL;
+        BspSpiCacheError_e eError  = sSpiCacheAccess(pCache, uAddress - uOffset, false, false, &pLine);
+
+        if (eError != eBSP_SPICACHE_ERR_NONE)
+        {
+            return eError;
+        }
+
+        if (uChunk > uLength)
+        {
+            uChunk = uLength;
+        }
+
+        (void)memcpy(pDst, &sSpiCacheData(pCache, pLine)[uOffset], uChunk);
+        pDst += uChunk;
+        uAddress += uChunk;
+        uLength -= uChunk;
+    }
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+BspSpiCacheError_e BspSpiCacheWrite(BspSpiCacheHandle_t handle, uint32_t uAddress, const void* pData, uint32_t uLength)
+{
+    BspSpiCache_t* pCache = sSpiCacheValidateHandle(handle);
+    const uint8_t* pSrc   = (const uint8_t*)pData;
+
+    if (pCache == NULL)
+    {
+        return eBSP_SPICACHE_ERR_INVALID_HANDLE;
+    }
+
+    if (!sSpiCacheCheckRange(pCache, uAddress, pData, uLength))
+    {
+        return eBSP_SPICACHE_ERR_INVALID_PARAM;
+    }
+
+    while (uLength > 0u)
+    {
+        uint32_t           uOffset = uAddress & (pCache->tConfig.uLineSize - 1u);
+        uint32_t           uChunk  = pCache->tConfig.uLineSize - uOffset;
+        BspSpiCacheLine_t* pLine   = NULL;
+        BspSpiCacheError_e eError;
+
+        if (uChunk > uLength)
+        {
+            uChunk = uLength;
+        }
+
+        eError = sSpiCacheAccess(pCache, uAddress - uOffset, true, (uChunk == pCache->tConfig.uLineSize), &pLine);
+        if (eError != eBSP_SPICACHE_ERR_NONE)
+        {
+            return eError;
+        }
+
+        (void)memcpy(&sSpiCacheData(pCache, pLine)[uOffset], pSrc, uChunk);
+        pLine->bDirty = true;
+        pSrc += uChunk;
+        uAddress += uChunk;
+        uLength -= uChunk;
+    }
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+BspSpiCacheError_e BspSpiCacheFlush(BspSpiCacheHandle_t handle)
+{
+    BspSpiCache_t*     pCache  = sSpiCacheValidateHandle(handle);
+    BspSpiCacheError_e eResult = eBSP_SPICACHE_ERR_NONE;
+
+    if (pCache == NULL)
+    {
+        return eBSP_SPICACHE_ERR_INVALID_HANDLE;
+    }
+
+    for (uint16_t i = 0u; i < pCache->tConfig.uLineCount; i++)
+    {
+        BspSpiCacheLine_t* pLine = &pCache->atLine[i];
+
+        if (!pLine->bDirty || (pLine->eState != eSPICACHE_LINE_VALID))
+        {
+            continue;
+        }
+
+        if (sSpiCacheWriteBack(pCache, pLine) != eBSP_SPICACHE_ERR_NONE)
+        {
+            /* Queue full: let the write-backs queued so far drain, then retry once */
+            eResult = sSpiCacheWaitAll(pCache);
+            if ((eResult != eBSP_SPICACHE_ERR_NONE) && (eResult != eBSP_SPICACHE_ERR_SPI))
+            {
+                return eResult;
+            }
+            if (sSpiCacheWriteBack(pCache, pLine) != eBSP_SPICACHE_ERR_NONE)
+            {
+                return eBSP_SPICACHE_ERR_BUSY;
+            }
+        }
+    }
+
+    BspSpiCacheError_e eError = sSpiCacheWaitAll(pCache);
+
+    return (eResult != eBSP_SPICACHE_ERR_NONE) ? eResult : eError;
+}
+
+BspSpiCacheError_e BspSpiCacheInvalidate(BspSpiCacheHandle_t handle)
+{
+    BspSpiCache_t*     pCache = sSpiCacheValidateHandle(handle);
+    BspSpiCacheError_e eError;
+
+    if (pCache == NULL)
+    {
+        return eBSP_SPICACHE_ERR_INVALID_HANDLE;
+    }
+
+    eError = sSpiCacheWaitAll(pCache);
+    if (eError == eBSP_SPICACHE_ERR_TIMEOUT)
+    {
+        return eError;
+    }
+
+    for (uint16_t i = 0u; i < pCache->tConfig.uLineCount; i++)
+    {
+        pCache->atLine[i].eState      = eSPICACHE_LINE_INVALID;
+        pCache->atLine[i].bDirty      = false;
+        pCache->atLine[i].bPrefetched = false;
+    }
+    pCache->uLastAddress = SPICACHE_SIZE_MAX;
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+BspSpiCacheError_e BspSpiCacheGetStats(BspSpiCacheHandle_t handle, BspSpiCacheStats_t* pStats)
+{
+    const BspSpiCache_t* pCache = sSpiCacheValidateHandle(handle);
+
+    if (pCache == NULL)
+    {
+        return eBSP_SPICACHE_ERR_INVALID_HANDLE;
+    }
+
+    if (pStats == NULL)
+    {
+        return eBSP_SPICACHE_ERR_INVALID_PARAM;
+    }
+
+    *pStats = pCache->tStats;
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
+
+BspSpiCacheError_e BspSpiCacheResetStats(BspSpiCacheHandle_t handle)
+{
+    BspSpiCache_t* pCache = sSpiCacheValidateHandle(handle);
+
+    if (pCache == NULL)
+    {
+        return eBSP_SPICACHE_ERR_INVALID_HANDLE;
+    }
+
+    (void)memset(&pCache->tStats, 0, sizeof(pCache->tStats));
+
+    return eBSP_SPICACHE_ERR_NONE;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file bsp_spicache.h
+ * @brief Software cache for external SPI PSRAM and FRAM on a shared bsp_spi bus
+ *
+ * - Fully associative cache of aligned lines in caller-provided RAM,
+ *   line size (16 to 1024 bytes) and count set per instance
+ * - LRU or clock (second chance) replacement
+ * - Write-back with dirty tracking; a write that covers a whole line does not
+ *   read it first
+ * - Prefetch of the next line on sequential access, filled by DMA in the
+ *   background while the current line is used
+ * - Hit, miss, prefetch and write-back statistics
+ *
+ * Reads and writes are synchronous: a hit is a memcpy, a miss queues the line
+ * fill on the bus and waits for its completion interrupt. Call them from
+ * thread context, not from interrupts.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "bsp_spi.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/**
+ * @brief Maximum number of cached memories.
+ * Each memory uses one bsp_spi device.
+ */
+#ifndef BSP_SPICACHE_MAX_INSTANCES
+    #define BSP_SPICACHE_MAX_INSTANCES (1u)
+#endif
+
+#if (BSP_SPICACHE_MAX_INSTANCES < 1u) || (BSP_SPICACHE_MAX_INSTANCES > 4u)
+    #error "BSP_SPICACHE_MAX_INSTANCES must be between 1 and 4"
+#endif
+
+/**
+ * @brief Maximum number of cache lines per instance.
+ * Each line costs about 80 bytes of tag and transfer state besides its data.
+ */
+#ifndef BSP_SPICACHE_MAX_LINES
+    #define BSP_SPICACHE_MAX_LINES (32u)
+#endif
+
+#if (BSP_SPICACHE_MAX_LINES < 1u) || (BSP_SPICACHE_MAX_LINES > 256u)
+    #error "BSP_SPICACHE_MAX_LINES must be between 1 and 256"
+#endif
+
+/** @brief Time limit in milliseconds for a line fill or write-back */
+#ifndef BSP_SPICACHE_TIMEOUT_MS
+    #define BSP_SPICACHE_TIMEOUT_MS (10u)
+#endif
+
+/* ============================================================================
+ * Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Cache handle. Valid handles are >= 0.
+ */
+typedef int8_t BspSpiCacheHandle_t;
+
+/** Invalid handle constant */
+static const BspSpiCacheHandle_t BSP_SPICACHE_INVALID_HANDLE = -1;
+
+/**
+ * @brief Cache error codes.
+ */
+typedef enum
+{
+    eBSP_SPICACHE_ERR_NONE = 0u,      /**< Success */
+    eBSP_SPICACHE_ERR_INVALID_HANDLE, /**< Invalid or unallocated handle */
+    eBSP_SPICACHE_ERR_INVALID_PARAM,  /**< Invalid parameter or range outside the memory */
+    eBSP_SPICACHE_ERR_BUSY,           /**< Bus queue full or all lines being filled */
+    eBSP_SPICACHE_ERR_SPI,            /**< Line fill or write-back transfer failed */
+    eBSP_SPICACHE_ERR_TIMEOUT         /**< Transfer did not complete within BSP_SPICACHE_TIMEOUT_MS */
+} BspSpiCacheError_e;
+
+/**
+ * @brief Memory command set.
+ */
+typedef enum
+{
+    eBSP_SPICACHE_MEM_PSRAM = 0u, /**< Fast read 0x0B with 8 wait clocks, write 0x02, 3-byte address */
+    eBSP_SPICACHE_MEM_FRAM        /**< Read 0x03, write enable 0x06 then write 0x02; 2-byte address up to 64 KiB */
+} BspSpiCacheMem_e;
+
+/**
+ * @brief Line replacement policy.
+ */
+typedef enum
+{
+    eBSP_SPICACHE_POLICY_LRU = 0u, /**< Evict the least recently used line */
+    eBSP_SPICACHE_POLICY_CLOCK     /**< Second chance: skip lines used since the hand last passed */
+} BspSpiCachePolicy_e;
+
+/**
+ * @brief Cache configuration.
+ */
+typedef struct
+{
+    BspSpiHandle_t      hBus;       /**< bsp_spi bus handle (DMA mode) */
+    uint32_t            uCsPin;     /**< Chip-select pin for BspGpioWritePin(), active low */
+    BspSpiClockMode_e   eClockMode; /**< Clock polarity and phase */
+    BspSpiPrescaler_e   ePrescaler; /**< Baud rate prescaler */
+    BspSpiCacheMem_e    eMemory;    /**< Command set */
+    uint32_t            uSize;      /**< Memory size in bytes (multiple of uLineSize, at most 16 MiB) */
+    uint8_t*            pLines;     /**< Line storage, uLineSize × uLineCount bytes, DMA-accessible */
+    uint16_t            uLineSize;  /**< Line size in bytes, power of two from 16 to 1024 */
+    uint16_t            uLineCount; /**< Number of lines, 1 to BSP_SPICACHE_MAX_LINES */
+    BspSpiCachePolicy_e ePolicy;    /**< Replacement policy */
+    bool                bPrefetch;  /**< Fetch the next line when lines are accessed in ascending order */
+} BspSpiCacheConfig_t;
+
+/**
+ * @brief Cache statistics.
+ * Hits and misses count line accesses: an access spanning two lines counts twice.
+ */
+typedef struct
+{
+    uint32_t uReadHits;     /**< Read line accesses served from the cache */
+    uint32_t uReadMisses;   /**< Read line accesses that filled a line */
+    uint32_t uWriteHits;    /**< Write line accesses to a cached line */
+    uint32_t uWriteMisses;  /**< Write line accesses that allocated a line */
+    uint32_t uPrefetches;   /**< Lines filled ahead of use */
+    uint32_t uPrefetchHits; /**< Prefetched lines that were used before eviction */
+    uint32_t uWriteBacks;   /**< Dirty lines written to the memory */
+    uint32_t uBusBytes;     /**< Bytes clocked on the bus, commands included */
+} BspSpiCacheStats_t;
+
+/* ============================================================================
+ * Public API
+ * ========================================================================== */
+
+/**
+ * @brief Allocate a cache for a memory on a shared bus.
+ *
+ * Adds a bsp_spi device and releases its chip select. All lines start empty.
+ *
+ * @param pConfig    Cache configuration (copied; pLines must stay valid)
+ * @return           Cache handle, BSP_SPICACHE_INVALID_HANDLE on error
+ */
+BspSpiCacheHandle_t BspSpiCacheAllocate(const BspSpiCacheConfig_t* pConfig);
+
+/**
+ * @brief Write back dirty lines and free the cache.
+ *
+ * @param handle     Cache handle
+ * @return           Error code; the cache stays allocated if the write-back fails
+ */
+BspSpiCacheError_e BspSpiCacheFree(BspSpiCacheHandle_t handle);
+
+/**
+ * @brief Read through the cache.
+ *
+ * Missing lines are filled, evicting lines by the replacement policy (dirty
+ * lines are written back first).
+ *
+ * @param handle     Cache handle
+ * @param uAddress   Memory address
+ * @param pData      Destination
+ * @param uLength    Number of bytes (> 0)
+ * @return           Error code
+ */
+BspSpiCacheError_e BspSpiCacheRead(BspSpiCacheHandle_t handle, uint32_t uAddress, void* pData, uint32_t uLength);
+
+/**
+ * @brief Write through the cache (write-back).
+ *
+ * The data stays in the cache until the line is evicted or flushed.
+ *
+ * @param handle     Cache handle
+ * @param uAddress   Memory address
+ * @param pData      Source
+ * @param uLength    Number of bytes (> 0)
+ * @return           Error code
+ */
+BspSpiCacheError_e BspSpiCacheWrite(BspSpiCacheHandle_t handle, uint32_t uAddress, const void* pData, uint32_t uLength);
+
+/**
+ * @brief Write all dirty lines to the memory and wait for completion.
+ *
+ * @param handle     Cache handle
+ * @return           Error code
+ */
+BspSpiCacheError_e BspSpiCacheFlush(BspSpiCacheHandle_t handle);
+
+/**
+ * @brief Discard all lines without writing them back.
+ *
+ * For memory changed behind the cache. Waits for transfers in flight.
+ *
+ * @param handle     Cache handle
+ * @return           Error code
+ */
+BspSpiCacheError_e BspSpiCacheInvalidate(BspSpiCacheHandle_t handle);
+
+/**
+ * @brief Get cache statistics.
+ *
+ * @param handle     Cache handle
+ * @param pStats     Output: statistics snapshot
+ * @return           Error code
+ */
+BspSpiCacheError_e BspSpiCacheGetStats(BspSpiCacheHandle_t handle, BspSpiCacheStats_t* pStats);
+
+/**
+ * @brief Clear cache statistics.
+ *
+ * @param handle     Cache handle
+ * @return           Error code
+ */
+BspSpiCacheError_e BspSpiCacheResetStats(BspSpiCacheHandle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,749 @@
+/**
+ * @file bsp_spiflash.c
+ * @brief JEDEC SPI NOR flash driver implementation
+ *
+ * Every bus access is a bsp_spi device transfer; the driver never waits on the
+ * CPU. Program and erase steps run as a chain of completion callbacks:
+ *
+ *   WREN + command (queued together) -> timer -> RDSR -> WIP set: timer again
+ *                                                     -> WIP clear: next step or done
+ */
+
+#include "bsp_spiflash.h"
+#include "bsp_compiler_attributes.h"
+#include "bsp_swtimer.h"
+#include "stm32f4xx_hal.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================================================
+ * Private Constants
+ * ========================================================================== */
+
+#define SPIFLASH_CMD_WREN         (0x06u) /**< Write enable */
+#define SPIFLASH_CMD_RDSR         (0x05u) /**< Read status register 1 */
+#define SPIFLASH_CMD_RDID         (0x9Fu) /**< Read JEDEC ID */
+#define SPIFLASH_CMD_FAST_READ    (0x0Bu) /**< Fast read, one dummy byte */
+#define SPIFLASH_CMD_PAGE_PROG    (0x02u) /**< Page program */
+#define SPIFLASH_CMD_SECTOR_ERASE (0x20u) /**< 4 KiB sector erase */
+#define SPIFLASH_CMD_BLOCK_ERASE  (0xD8u) /**< 64 KiB block erase */
+
+/** Status register: write in progress */
+#define SPIFLASH_SR_WIP (0x01u)
+
+/** Capacity codes accepted by the probe (64 KiB .. 16 MiB, 3-byte addressing) */
+#define SPIFLASH_CAPACITY_MIN (0x10u)
+#define SPIFLASH_CAPACITY_MAX (0x18u)
+
+/* ============================================================================
+ * Private Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Operation in progress.
+ */
+typedef enum
+{
+    eSPIFLASH_OP_IDLE = 0u,
+    eSPIFLASH_OP_PROBE,
+    eSPIFLASH_OP_READ,
+    eSPIFLASH_OP_READ_AHEAD, /**< Filling the cache, then copying to the caller */
+    eSPIFLASH_OP_PROGRAM,
+    eSPIFLASH_OP_ERASE
+} BspSpiFlashOp_e;
+
+/**
+ * @brief Flash chip instance.
+ *
+ * The operation fields are set by the API call that starts an operation and
+ * owned by the interrupt callbacks until it completes.
+ */
+typedef struct
+{
+    BspSpiFlashConfig_t      tConfig;
+    bool                     bAllocated;
+    bool                     bProbed;
+    BspSpiDeviceHandle_t     hDevice;
+    SWTimerModule            tTimer; /**< One-shot busy-flag poll timer */
+    BspSpiFlashInfo_t        tInfo;
+    volatile BspSpiFlashOp_e eOp;
+    BspSpiFlashCb_t          pCb;
+    void*                    pContext;
+    uint32_t                 uAddress;    /**< Next program/erase address */
+    const uint8_t*           pTxData;     /**< Next program source */
+    uint8_t*                 pRxData;     /**< Read-ahead: caller buffer */
+    uint32_t                 uRemaining;  /**< Bytes left to program/erase, read-ahead: caller length */
+    uint32_t                 uStep;       /**< Length of the step on the bus */
+    uint32_t                 uStepTick;   /**< HAL tick when the step was issued */
+    uint32_t                 uStepLimit;  /**< Busy time limit of the step in ms */
+    BspSpiError_e            eWrenError;  /**< Result of the write enable preceding the step */
+    uint32_t                 uCacheAddr;  /**< Flash address of abyCache[0] */
+    uint32_t                 uCacheLen;   /**< Valid cache bytes, 0 = empty */
+    uint8_t                  abyCmd[5];   /**< Command and address of the step */
+    uint8_t                  abyId[4];    /**< RDID response */
+    uint8_t                  abyStatus[2];
+    BspSpiSegment_t          atSeg[2];
+    BspSpiFlashStats_t       tStats;
+    uint8_t                  abyCache[BSP_SPIFLASH_READ_AHEAD_SIZE];
+} BspSpiFlash_t;
+
+/* ============================================================================
+ * Private Global Variables
+ * ========================================================================== */
+
+/** Flash instance array */
+FORCE_STATIC BspSpiFlash_t s_aSpiFlash[BSP_SPIFLASH_MAX_INSTANCES] = {0};
+
+/** Write enable command, shared by all instances */
+FORCE_STATIC const uint8_t s_byWren = SPIFLASH_CMD_WREN;
+
+/** Status register read command with one clock byte */
+FORCE_STATIC const uint8_t s_abyRdsr[2] = {SPIFLASH_CMD_RDSR, 0xFFu};
+
+/** JEDEC ID command with three clock bytes */
+FORCE_STATIC const uint8_t s_abyRdid[4] = {SPIFLASH_CMD_RDID, 0xFFu, 0xFFu, 0xFFu};
+
+/* ============================================================================
+ * Private Function Prototypes
+ * ========================================================================== */
+
+FORCE_STATIC void sSpiFlashTimerCallback0(void);
+#if (BSP_SPIFLASH_MAX_INSTANCES > 1u)
+FORCE_STATIC void sSpiFlashTimerCallback1(void);
+#endif
+
+/**
+ * @brief Poll timer callbacks, one per instance.
+ */
+FORCE_STATIC SWTimerCallbackFunction const s_apfnTimerCallbacks[BSP_SPIFLASH_MAX_INSTANCES] = {
+    sSpiFlashTimerCallback0,
+#if (BSP_SPIFLASH_MAX_INSTANCES > 1u)
+    sSpiFlashTimerCallback1,
+#endif
+};
+
+FORCE_STATIC bool sSpiFlashStartStep(BspSpiFlash_t* pFlash);
+
+/* ============================================================================
+ * Private Functions
+ * ========================================================================== */
+
+/**
+ * @brief Validate handle and return instance pointer.
+ */
+FORCE_STATIC BspSpiFlash_t* sSpiFlashValidateHandle(BspSpiFlashHandle_t handle)
+{
+    if ((handle < 0) || (handle >= (BspSpiFlashHandle_t)BSP_SPIFLASH_MAX_INSTANCES))
+    {
+        return NULL;
+    }
+
+    if (!s_aSpiFlash[handle].bAllocated)
+    {
+        return NULL;
+    }
+
+    return &s_aSpiFlash[handle];
+}
+
+/**
+ * @brief Check that an operation may start: idle, probed, area inside the chip.
+ */
+FORCE_STATIC BspSpiFlashError_e sSpiFlashCheckRequest(const BspSpiFlash_t* pFlash, uint32_t uAddress, uint32_t uLength)
+{
+    if (pFlash->eOp != eSPIFLASH_OP_IDLE)
+    {
+        return eBSP_SPIFLASH_ERR_BUSY;
+    }
+
+    if (!pFlash->bProbed)
+    {
+        return eBSP_SPIFLASH_ERR_UNKNOWN_CHIP;
+    }
+
+    if ((uLength == 0u) || (uAddress >= pFlash->tInfo.uSize) || (uLength > (pFlash->tInfo.uSize - uAddress)))
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_PARAM;
+    }
+
+    return eBSP_SPIFLASH_ERR_NONE;
+}
+
+/**
+ * @brief End the operation and report the result.
+ */
+FORCE_STATIC void sSpiFlashFinish(BspSpiFlash_t* pFlash, BspSpiFlashError_e eError)
+{
+    BspSpiFlashCb_t pCb      = pFlash->pCb;
+    void*           pContext = pFlash->pContext;
+
+    pFlash->eOp = eSPIFLASH_OP_IDLE;
+
+    if (pCb != NULL)
+    {
+        pCb((BspSpiFlashHandle_t)(pFlash - s_aSpiFlash), eError, pContext);
+    }
+}
+
+/**
+ * @brief Write a command byte followed by a 24-bit address into abyCmd.
+ */
+FORCE_STATIC void sSpiFlashSetCmd(BspSpiFlash_t* pFlash, uint8_t byCmd, uint32_t uAddress)
+{
+    pFlash->abyCmd[0] = byCmd;
+    pFlash->abyCmd[1] = (uint8_t)(uAddress >> 16u);
+    pFlash->abyCmd[2] = (uint8_t)(uAddress >> 8u);
+    pFlash->abyCmd[3] = (uint8_t)uAddress;
+    pFlash->abyCmd[4] = 0u;
+}
+
+/**
+ * @brief Queue a transfer to the chip with this module's completion callback.
+ */
+FORCE_STATIC BspSpiError_e sSpiFlashQueue(BspSpiFlash_t* pFlash, const uint8_t* pTxData, uint8_t* pRxData, uint32_t uLength,
+                                          BspSpiXferCb_t pCallback)
+{
+    BspSpiXfer_t tXfer = {0};
+
+    tXfer.pTxData   = pTxData;
+    tXfer.pRxData   = pRxData;
+    tXfer.uLength   = uLength;
+    tXfer.pCallback = pCallback;
+    tXfer.pContext  = pFlash;
+
+    return BspSpiDeviceQueueTransfer(pFlash->hDevice, &tXfer);
+}
+
+/**
+ * @brief Queue a fast read: command segment, then the data segment.
+ */
+FORCE_STATIC BspSpiError_e sSpiFlashQueueRead(BspSpiFlash_t* pFlash, uint32_t uAddress, uint8_t* pDest, uint32_t uLength,
+                                              BspSpiXferCb_t pCallback)
+{
+    BspSpiXfer_t tXfer = {0};
+
+    sSpiFlashSetCmd(pFlash, SPIFLASH_CMD_FAST_READ, uAddress);
+    pFlash->atSeg[0] = (BspSpiSegment_t){pFlash->abyCmd, NULL, 5u};
+    pFlash->atSeg[1] = (BspSpiSegment_t){NULL, pDest, uLength};
+
+    tXfer.pCallback = pCallback;
+    tXfer.pContext  = pFlash;
+    tXfer.pSegments = pFlash->atSeg;
+    tXfer.uSegments = 2u;
+
+    pFlash->tStats.uReads++;
+    return BspSpiDeviceQueueTransfer(pFlash->hDevice, &tXfer);
+}
+
+/**
+ * @brief RDID completion: decode manufacturer, type and capacity.
+ */
+FORCE_STATIC void sSpiFlashOnId(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSpiFlash_t* pFlash = (BspSpiFlash_t*)pContext;
+    uint8_t        byMfr  = pFlash->abyId[1];
+    uint8_t        byCap  = pFlash->abyId[3];
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_SPI);
+        return;
+    }
+
+    /* No chip answers 0x00 or 0xFF (MISO held low or floating high) */
+    if ((byMfr == 0x00u) || (byMfr == 0xFFu) || (byCap < SPIFLASH_CAPACITY_MIN) || (byCap > SPIFLASH_CAPACITY_MAX))
+    {
+        sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_UNKNOWN_CHIP);
+        return;
+    }
+
+    pFlash->tInfo.uJedecId = ((uint32_t)byMfr << 16u) | ((uint32_t)pFlash->abyId[2] << 8u) | byCap;
+    pFlash->tInfo.uSize    = 1uL << byCap;
+    pFlash->bProbed        = true;
+    sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_NONE);
+}
+
+/**
+ * @brief Fast read completion. A read-ahead fill is copied to the caller.
+ */
+FORCE_STATIC void sSpiFlashOnRead(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSpiFlash_t* pFlash = (BspSpiFlash_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_SPI);
+        return;
+    }
+
+    if (pFlash->eOp == eSPIFLASH_OP_READ_AHEAD)
+    {
+        pFlash->uCacheAddr = pFlash->uAddress;
+        pFlash->uCacheLen  = pFlash->uStep;
+        (void)memcpy(pFlash->pRxData, pFlash->abyCache, pFlash->uRemaining);
+    }
+
+    sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_NONE);
+}
+
+/**
+ * @brief Write enable completion: only the result is kept for the step.
+ */
+FORCE_STATIC void sSpiFlashOnWren(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSpiFlash_t* pFlash = (BspSpiFlash_t*)pContext;
+
+    (void)hBus;
+    pFlash->eWrenError = eError;
+}
+
+/**
+ * @brief Program/erase command completion: advance and start polling.
+ */
+FORCE_STATIC void sSpiFlashOnCommand(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSpiFlash_t* pFlash = (BspSpiFlash_t*)pContext;
+
+    (void)hBus;
+
+    if ((eError != eBSP_SPI_ERR_NONE) || (pFlash->eWrenError != eBSP_SPI_ERR_NONE))
+    {
+        sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_SPI);
+        return;
+    }
+
+    pFlash->uAddress += pFlash->uStep;
+    pFlash->uRemaining -= pFlash->uStep;
+
+    if (pFlash->eOp == eSPIFLASH_OP_PROGRAM)
+    {
+        pFlash->pTxData += pFlash->uStep;
+    }
+
+    /* The chip is busy now; tPP is typically below one poll interval */
+    pFlash->uStepTick = HAL_GetTick();
+    (void)SWTimerStart(&pFlash->tTimer);
+}
+
+/**
+ * @brief Status register completion: wait more, start the next step or finish.
+ */
+FORCE_STATIC void sSpiFlashOnStatus(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSpiFlash_t* pFlash = (BspSpiFlash_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_SPI);
+        return;
+    }
+
+    pFlash->tStats.uPolls++;
+
+    if ((pFlash->abyStatus[1] & SPIFLASH_SR_WIP) != 0u)
+    {
+        if ((HAL_GetTick() - pFlash->uStepTick) >= pFlash->uStepLimit)
+        {
+            sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_TIMEOUT);
+        }
+        else
+        {
+            (void)SWTimerStart(&pFlash->tTimer);
+        }
+        return;
+    }
+
+    if (pFlash->uRemaining == 0u)
+    {
+        sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_NONE);
+    }
+    else if (!sSpiFlashStartStep(pFlash))
+    {
+        sSpiFlashFinish(pFlash, eBSP_SPIFLASH_ERR_BUSY);
+    }
+}
+
+/**
+ * @brief Poll timer expiry (SysTick): read the status register.
+ */
+FORCE_STATIC void sSpiFlashOnTimer(BspSpiFlash_t* pFlash)
+{
+    if ((pFlash->eOp != eSPIFLASH_OP_PROGRAM) && (pFlash->eOp != eSPIFLASH_OP_ERASE))
+    {
+        return;
+    }
+
+    /* Queue full: try again on the next tick */
+    if (sSpiFlashQueue(pFlash, s_abyRdsr, pFlash->abyStatus, sizeof(s_abyRdsr), sSpiFlashOnStatus) == eBSP_SPI_ERR_BUSY)
+    {
+        (void)SWTimerStart(&pFlash->tTimer);
+    }
+}
+
+/**
+ * @brief Issue the next page program or erase: WREN and the command back-to-back.
+ *
+ * The command segment list is [command + address, page data] for programs
+ * and [command + address] for erases.
+ *
+ * @return false if the bus queue rejected the step
+ */
+FORCE_STATIC bool sSpiFlashStartStep(BspSpiFlash_t* pFlash)
+{
+    BspSpiXfer_t tXfer = {0};
+    uint8_t      byCmd;
+
+    if (pFlash->eOp == eSPIFLASH_OP_PROGRAM)
+    {
+        /* Never cross a page boundary: the chip would wrap inside the page */
+        uint32_t uPageLeft = BSP_SPIFLASH_PAGE_SIZE - (pFlash->uAddress % BSP_SPIFLASH_PAGE_SIZE);
+
+        byCmd              = SPIFLASH_CMD_PAGE_PROG;
+        pFlash->uStep      = (pFlash->uRemaining < uPageLeft) ? pFlash->uRemaining : uPageLeft;
+        pFlash->uStepLimit = BSP_SPIFLASH_PROGRAM_TIMEOUT_MS;
+        pFlash->atSeg[1]   = (BspSpiSegment_t){pFlash->pTxData, NULL, pFlash->uStep};
+        tXfer.uSegments    = 2u;
+        pFlash->tStats.uPages++;
+    }
+    else
+    {
+        bool bBlock = ((pFlash->uAddress % BSP_SPIFLASH_BLOCK_SIZE) == 0u) && (pFlash->uRemaining >= BSP_SPIFLASH_BLOCK_SIZE);
+
+        byCmd              = bBlock ? SPIFLASH_CMD_BLOCK_ERASE : SPIFLASH_CMD_SECTOR_ERASE;
+        pFlash->uStep      = bBlock ? BSP_SPIFLASH_BLOCK_SIZE : BSP_SPIFLASH_SECTOR_SIZE;
+        pFlash->uStepLimit = BSP_SPIFLASH_ERASE_TIMEOUT_MS;
+        tXfer.uSegments    = 1u;
+        pFlash->tStats.uErases++;
+    }
+
+    sSpiFlashSetCmd(pFlash, byCmd, pFlash->uAddress);
+    pFlash->atSeg[0]   = (BspSpiSegment_t){pFlash->abyCmd, NULL, 4u};
+    pFlash->eWrenError = eBSP_SPI_ERR_NONE;
+
+    tXfer.pCallback = sSpiFlashOnCommand;
+    tXfer.pContext  = pFlash;
+    tXfer.pSegments = pFlash->atSeg;
+
+    if (sSpiFlashQueue(pFlash, &s_byWren, NULL, 1u, sSpiFlashOnWren) != eBSP_SPI_ERR_NONE)
+    {
+        return false;
+    }
+
+    /* A failure here leaves only a harmless write enable on the bus */
+    return BspSpiDeviceQueueTransfer(pFlash->hDevice, &tXfer) == eBSP_SPI_ERR_NONE;
+}
+
+/**
+ * @brief Common start of a program or erase operation.
+ */
+FORCE_STATIC BspSpiFlashError_e sSpiFlashStartModify(BspSpiFlash_t* pFlash, BspSpiFlashOp_e eOp, uint32_t uAddress, const uint8_t* pData,
+                                                     uint32_t uLength, BspSpiFlashCb_t pCb, void* pContext)
+{
+    /* The cached copy may no longer match the array */
+    pFlash->uCacheLen  = 0u;
+    pFlash->pCb        = pCb;
+    pFlash->pContext   = pContext;
+    pFlash->eOp        = eOp;
+    pFlash->uAddress   = uAddress;
+    pFlash->pTxData    = pData;
+    pFlash->uRemaining = uLength;
+
+    if (!sSpiFlashStartStep(pFlash))
+    {
+        pFlash->eOp = eSPIFLASH_OP_IDLE;
+        return eBSP_SPIFLASH_ERR_BUSY;
+    }
+
+    return eBSP_SPIFLASH_ERR_NONE;
+}
+
+FORCE_STATIC void sSpiFlashTimerCallback0(void)
+{
+    sSpiFlashOnTimer(&s_aSpiFlash[0]);
+}
+
+#if (BSP_SPIFLASH_MAX_INSTANCES > 1u)
+FORCE_STATIC void sSpiFlashTimerCallback1(void)
+{
+    sSpiFlashOnTimer(&s_aSpiFlash[1]);
+}
+#endif
+
+/* ============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+BspSpiFlashHandle_t BspSpiFlashAllocate(const BspSpiFlashConfig_t* pConfig)
+{
+    if (pConfig == NULL)
+    {
+        return BSP_SPIFLASH_INVALID_HANDLE;
+    }
+
+    for (uint8_t i = 0u; i < BSP_SPIFLASH_MAX_INSTANCES; i++)
+    {
+        BspSpiFlash_t* pFlash = &s_aSpiFlash[i];
+
+        if (pFlash->bAllocated)
+        {
+            continue;
+        }
+
+        BspSpiDeviceConfig_t tDevice = {0};
+        tDevice.hBus                 = pConfig->hBus;
+        tDevice.uCsPin               = pConfig->uCsPin;
+        tDevice.eClockMode           = eBSP_SPI_CLOCK_MODE_0;
+        tDevice.ePrescaler           = pConfig->ePrescaler;
+
+        BspSpiDeviceHandle_t hDevice = BspSpiDeviceAdd(&tDevice);
+
+        if (hDevice < 0)
+        {
+            return BSP_SPIFLASH_INVALID_HANDLE;
+        }
+
+        (void)memset(pFlash, 0, sizeof(*pFlash));
+        pFlash->tConfig                  = *pConfig;
+        pFlash->hDevice                  = hDevice;
+        pFlash->tTimer.interval          = BSP_SPIFLASH_POLL_MS;
+        pFlash->tTimer.pCallbackFunction = s_apfnTimerCallbacks[i];
+        pFlash->tTimer.periodic          = false;
+
+        if (!SWTimerInit(&pFlash->tTimer))
+        {
+            (void)BspSpiDeviceRemove(hDevice);
+            return BSP_SPIFLASH_INVALID_HANDLE;
+        }
+
+        pFlash->bAllocated = true;
+        return (BspSpiFlashHandle_t)i;
+    }
+
+    return BSP_SPIFLASH_INVALID_HANDLE;
+}
+
+BspSpiFlashError_e BspSpiFlashFree(BspSpiFlashHandle_t handle)
+{
+    BspSpiFlash_t* pFlash = sSpiFlashValidateHandle(handle);
+
+    if (pFlash == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_HANDLE;
+    }
+
+    if ((pFlash->eOp != eSPIFLASH_OP_IDLE) || (BspSpiDeviceRemove(pFlash->hDevice) != eBSP_SPI_ERR_NONE))
+    {
+        return eBSP_SPIFLASH_ERR_BUSY;
+    }
+
+    /* The timer stays registered with bsp_swtimer and is reused on the next allocation */
+    SWTimerStop(&pFlash->tTimer);
+    pFlash->bAllocated = false;
+
+    return eBSP_SPIFLASH_ERR_NONE;
+}
+
+BspSpiFlashError_e BspSpiFlashProbe(BspSpiFlashHandle_t handle, BspSpiFlashCb_t pCb, void* pContext)
+{
+    BspSpiFlash_t* pFlash = sSpiFlashValidateHandle(handle);
+
+    if (pFlash == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_HANDLE;
+    }
+
+    if (pFlash->eOp != eSPIFLASH_OP_IDLE)
+    {
+        return eBSP_SPIFLASH_ERR_BUSY;
+    }
+
+    pFlash->bProbed   = false;
+    pFlash->uCacheLen = 0u;
+    pFlash->pCb       = pCb;
+    pFlash->pContext  = pContext;
+    pFlash->eOp       = eSPIFLASH_OP_PROBE;
+
+    if (sSpiFlashQueue(pFlash, s_abyRdid, pFlash->abyId, sizeof(s_abyRdid), sSpiFlashOnId) != eBSP_SPI_ERR_NONE)
+    {
+        pFlash->eOp = eSPIFLASH_OP_IDLE;
+        return eBSP_SPIFLASH_ERR_BUSY;
+    }
+
+    return eBSP_SPIFLASH_ERR_NONE;
+}
+
+BspSpiFlashError_e BspSpiFlashGetInfo(BspSpiFlashHandle_t handle, BspSpiFlashInfo_t* pInfo)
+{
+    const BspSpiFlash_t* pFlash = sSpiFlashValidateHandle(handle);
+
+    if (pFlash == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_HANDLE;
+    }
+
+    if (pInfo == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_PARAM;
+    }
+
+    if (!pFlash->bProbed)
+    {
+        return eBSP_SPIFLASH_ERR_UNKNOWN_CHIP;
+    }
+
+    *pInfo = pFlash->tInfo;
+    return eBSP_SPIFLASH_ERR_NONE;
+}
+
+BspSpiFlashError_e BspSpiFlashRead(BspSpiFlashHandle_t handle, uint32_t uAddress, uint8_t* pData, uint32_t uLength, BspSpiFlashCb_t pCb,
+                                   void* pContext)
+{
+    BspSpiFlash_t* pFlash = sSpiFlashValidateHandle(handle);
+
+    if (pFlash == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_HANDLE;
+    }
+
+    if (pData == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_PARAM;
+    }
+
+    BspSpiFlashError_e eResult = sSpiFlashCheckRequest(pFlash, uAddress, uLength);
+
+    if (eResult != eBSP_SPIFLASH_ERR_NONE)
+    {
+        return eResult;
+    }
+
+    bool bCached = pFlash->tConfig.bReadAhead && (uLength <= BSP_SPIFLASH_READ_AHEAD_SIZE);
+
+    if (bCached && (pFlash->uCacheLen > 0u) && (uAddress >= pFlash->uCacheAddr) &&
+        ((uAddress - pFlash->uCacheAddr) + uLength <= pFlash->uCacheLen))
+    {
+        (void)memcpy(pData, &pFlash->abyCache[uAddress - pFlash->uCacheAddr], uLength);
+        pFlash->tStats.uCacheHits++;
+
+        if (pCb != NULL)
+        {
+            pCb(handle, eBSP_SPIFLASH_ERR_NONE, pContext);
+        }
+        return eBSP_SPIFLASH_ERR_NONE;
+    }
+
+    pFlash->pCb      = pCb;
+    pFlash->pContext = pContext;
+
+    BspSpiError_e eSpi;
+
+    if (bCached)
+    {
+        /* Miss: fill the whole cache from here, clamped to the end of the chip */
+        uint32_t uFill = pFlash->tInfo.uSize - uAddress;
+
+        pFlash->eOp        = eSPIFLASH_OP_READ_AHEAD;
+        pFlash->uCacheLen  = 0u;
+        pFlash->uAddress   = uAddress;
+        pFlash->pRxData    = pData;
+        pFlash->uRemaining = uLength;
+        pFlash->uStep      = (uFill < BSP_SPIFLASH_READ_AHEAD_SIZE) ? uFill : BSP_SPIFLASH_READ_AHEAD_SIZE;
+        eSpi               = sSpiFlashQueueRead(pFlash, uAddress, pFlash->abyCache, pFlash->uStep, sSpiFlashOnRead);
+    }
+    else
+    {
+        pFlash->eOp = eSPIFLASH_OP_READ;
+        eSpi        = sSpiFlashQueueRead(pFlash, uAddress, pData, uLength, sSpiFlashOnRead);
+    }
+
+    if (eSpi != eBSP_SPI_ERR_NONE)
+    {
+        pFlash->eOp = eSPIFLASH_OP_IDLE;
+        return eBSP_SPIFLASH_ERR_BUSY;
+    }
+
+    return eBSP_SPIFLASH_ERR_NONE;
+}
+
+BspSpiFlashError_e BspSpiFlashWrite(BspSpiFlashHandle_t handle, uint32_t uAddress, const uint8_t* pData, uint32_t uLength,
+                                    BspSpiFlashCb_t pCb, void* pContext)
+{
+    BspSpiFlash_t* pFlash = sSpiFlashValidateHandle(handle);
+
+    if (pFlash == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_HANDLE;
+    }
+
+    if (pData == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_PARAM;
+    }
+
+    BspSpiFlashError_e eResult = sSpiFlashCheckRequest(pFlash, uAddress, uLength);
+
+    if (eResult != eBSP_SPIFLASH_ERR_NONE)
+    {
+        return eResult;
+    }
+
+    return sSpiFlashStartModify(pFlash, eSPIFLASH_OP_PROGRAM, uAddress, pData, uLength, pCb, pContext);
+}
+
+BspSpiFlashError_e BspSpiFlashErase(BspSpiFlashHandle_t handle, uint32_t uAddress, uint32_t uLength, BspSpiFlashCb_t pCb, void* pContext)
+{
+    BspSpiFlash_t* pFlash = sSpiFlashValidateHandle(handle);
+
+    if (pFlash == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_HANDLE;
+    }
+
+    if (((uAddress % BSP_SPIFLASH_SECTOR_SIZE) != 0u) || ((uLength % BSP_SPIFLASH_SECTOR_SIZE) != 0u))
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_PARAM;
+    }
+
+    BspSpiFlashError_e eResult = sSpiFlashCheckRequest(pFlash, uAddress, uLength);
+
+    if (eResult != eBSP_SPIFLASH_ERR_NONE)
+    {
+        return eResult;
+    }
+
+    return sSpiFlashStartModify(pFlash, eSPIFLASH_OP_ERASE, uAddress, NULL, uLength, pCb, pContext);
+}
+
+bool BspSpiFlashIsBusy(BspSpiFlashHandle_t handle)
+{
+    const BspSpiFlash_t* pFlash = sSpiFlashValidateHandle(handle);
+
+    return (pFlash != NULL) && (pFlash->eOp != eSPIFLASH_OP_IDLE);
+}
+
+BspSpiFlashError_e BspSpiFlashGetStats(BspSpiFlashHandle_t handle, BspSpiFlashStats_t* pStats)
+{
+    const BspSpiFlash_t* pFlash = sSpiFlashValidateHandle(handle);
+
+    if (pFlash == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_HANDLE;
+    }
+
+    if (pStats == NULL)
+    {
+        return eBSP_SPIFLASH_ERR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    *pStats = pFlash->tStats;
+    __enable_irq();
+
+    return eBSP_SPIFLASH_ERR_NONE;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file bsp_spiflash.h
+ * @brief JEDEC SPI NOR flash driver on a shared bsp_spi bus
+ *
+ * - Chip identification by JEDEC ID (RDID), 3-byte addressing up to 16 MiB
+ * - Fast read (0x0B) by DMA, optional read-ahead cache for sequential reads
+ * - Asynchronous page program and sector/block erase: write enable and the
+ *   command are queued back-to-back on the bus, the busy flag is polled from
+ *   a software timer instead of spinning
+ * - Writes are split at page boundaries
+ *
+ * All operations complete through a callback, called from interrupt context
+ * (SPI DMA completion or SysTick). One operation per chip at a time.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "bsp_spi.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/**
+ * @brief Maximum number of flash chips.
+ * Each chip uses one software timer and one bsp_spi device.
+ */
+#ifndef BSP_SPIFLASH_MAX_INSTANCES
+    #define BSP_SPIFLASH_MAX_INSTANCES (1u)
+#endif
+
+#if (BSP_SPIFLASH_MAX_INSTANCES < 1u) || (BSP_SPIFLASH_MAX_INSTANCES > 2u)
+    #error "BSP_SPIFLASH_MAX_INSTANCES must be 1 or 2"
+#endif
+
+/**
+ * @brief Read-ahead cache size in bytes per chip (used when enabled in the config).
+ * Reads shorter than this fill the whole cache from the requested address.
+ */
+#ifndef BSP_SPIFLASH_READ_AHEAD_SIZE
+    #define BSP_SPIFLASH_READ_AHEAD_SIZE (256u)
+#endif
+
+/** @brief Busy-flag poll interval in milliseconds */
+#ifndef BSP_SPIFLASH_POLL_MS
+    #define BSP_SPIFLASH_POLL_MS (1u)
+#endif
+
+/** @brief Page program time limit in milliseconds (datasheet maximum is typically 3 ms) */
+#ifndef BSP_SPIFLASH_PROGRAM_TIMEOUT_MS
+    #define BSP_SPIFLASH_PROGRAM_TIMEOUT_MS (10u)
+#endif
+
+/** @brief Sector/block erase time limit in milliseconds (64 KiB block maximum is typically 2 s) */
+#ifndef BSP_SPIFLASH_ERASE_TIMEOUT_MS
+    #define BSP_SPIFLASH_ERASE_TIMEOUT_MS (3000u)
+#endif
+
+/* ============================================================================
+ * Geometry
+ * ========================================================================== */
+
+/** Program page size in bytes */
+#define BSP_SPIFLASH_PAGE_SIZE (256u)
+/** Smallest erase unit (sector) in bytes */
+#define BSP_SPIFLASH_SECTOR_SIZE (4096u)
+/** Large erase unit (block) in bytes, used when address and length allow */
+#define BSP_SPIFLASH_BLOCK_SIZE (65536u)
+
+/* ============================================================================
+ * Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Flash handle. Valid handles are >= 0.
+ */
+typedef int8_t BspSpiFlashHandle_t;
+
+/** Invalid handle constant */
+static const BspSpiFlashHandle_t BSP_SPIFLASH_INVALID_HANDLE = -1;
+
+/**
+ * @brief Flash error codes.
+ */
+typedef enum
+{
+    eBSP_SPIFLASH_ERR_NONE = 0u,      /**< Success */
+    eBSP_SPIFLASH_ERR_INVALID_HANDLE, /**< Invalid or unallocated handle */
+    eBSP_SPIFLASH_ERR_INVALID_PARAM,  /**< Invalid parameter, range or alignment */
+    eBSP_SPIFLASH_ERR_BUSY,           /**< Operation in progress or bus queue full */
+    eBSP_SPIFLASH_ERR_UNKNOWN_CHIP,   /**< No chip identified (probe failed or not run) */
+    eBSP_SPIFLASH_ERR_SPI,            /**< SPI transfer failed */
+    eBSP_SPIFLASH_ERR_TIMEOUT         /**< Busy flag did not clear in time */
+} BspSpiFlashError_e;
+
+/**
+ * @brief Operation completion callback (interrupt context).
+ *
+ * @param handle     Flash handle
+ * @param eError     Result of the operation
+ * @param pContext   Context passed with the operation
+ */
+typedef void (*BspSpiFlashCb_t)(BspSpiFlashHandle_t handle, BspSpiFlashError_e eError, void* pContext);
+
+/**
+ * @brief Flash configuration.
+ */
+typedef struct
+{
+    BspSpiHandle_t    hBus;       /**< bsp_spi bus handle (DMA mode) */
+    uint32_t          uCsPin;     /**< Chip-select pin for BspGpioWritePin(), active low */
+    BspSpiPrescaler_e ePrescaler; /**< Bus clock prescaler for this chip */
+    bool              bReadAhead; /**< Serve short sequential reads from a BSP_SPIFLASH_READ_AHEAD_SIZE cache */
+} BspSpiFlashConfig_t;
+
+/**
+ * @brief Identified chip.
+ */
+typedef struct
+{
+    uint32_t uJedecId; /**< Manufacturer, memory type, capacity code (24 bits) */
+    uint32_t uSize;    /**< Capacity in bytes */
+} BspSpiFlashInfo_t;
+
+/**
+ * @brief Flash statistics.
+ */
+typedef struct
+{
+    uint32_t uPages;     /**< Page program commands issued */
+    uint32_t uErases;    /**< Sector and block erase commands issued */
+    uint32_t uPolls;     /**< Status register reads while waiting for the busy flag */
+    uint32_t uReads;     /**< Fast read commands issued */
+    uint32_t uCacheHits; /**< Reads served from the read-ahead cache */
+} BspSpiFlashStats_t;
+
+/* ============================================================================
+ * Public API
+ * ========================================================================== */
+
+/**
+ * @brief Allocate a flash chip on a shared bus.
+ *
+ * Adds a bsp_spi device (clock mode 0) and releases its chip select.
+ * Call BspSpiFlashProbe() before any other operation.
+ *
+ * @param pConfig    Flash configuration (copied)
+ * @return           Flash handle, BSP_SPIFLASH_INVALID_HANDLE on error
+ */
+BspSpiFlashHandle_t BspSpiFlashAllocate(const BspSpiFlashConfig_t* pConfig);
+
+/**
+ * @brief Free a flash chip.
+ *
+ * @param handle     Flash handle
+ * @return           Error code; eBSP_SPIFLASH_ERR_BUSY while an operation runs
+ */
+BspSpiFlashError_e BspSpiFlashFree(BspSpiFlashHandle_t handle);
+
+/**
+ * @brief Read the JEDEC ID and identify the chip.
+ *
+ * The capacity code is the base-2 logarithm of the size (JEDEC convention);
+ * chips up to 16 MiB (3-byte addressing) are accepted.
+ *
+ * @param handle     Flash handle
+ * @param pCb        Completion callback (eBSP_SPIFLASH_ERR_UNKNOWN_CHIP if not recognised)
+ * @param pContext   Passed to the callback
+ * @return           Error code of the request
+ */
+BspSpiFlashError_e BspSpiFlashProbe(BspSpiFlashHandle_t handle, BspSpiFlashCb_t pCb, void* pContext);
+
+/**
+ * @brief Get the identified chip.
+ *
+ * @param handle     Flash handle
+ * @param pInfo      Output: chip information
+ * @return           Error code; eBSP_SPIFLASH_ERR_UNKNOWN_CHIP before a successful probe
+ */
+BspSpiFlashError_e BspSpiFlashGetInfo(BspSpiFlashHandle_t handle, BspSpiFlashInfo_t* pInfo);
+
+/**
+ * @brief Read data with fast read by DMA.
+ *
+ * With read-ahead enabled, a read that lies completely in the cache is copied
+ * and completed before this function returns.
+ *
+ * @param handle     Flash handle
+ * @param uAddress   Flash address
+ * @param pData      Destination (must remain valid until the callback)
+ * @param uLength    Length in bytes (> 0)
+ * @param pCb        Completion callback
+ * @param pContext   Passed to the callback
+ * @return           Error code of the request
+ */
+BspSpiFlashError_e BspSpiFlashRead(BspSpiFlashHandle_t handle, uint32_t uAddress, uint8_t* pData, uint32_t uLength, BspSpiFlashCb_t pCb,
+                                   void* pContext);
+
+/**
+ * @brief Program data, split at page boundaries.
+ *
+ * The area must be erased; bits can only be programmed from 1 to 0.
+ *
+ * @param handle     Flash handle
+ * @param uAddress   Flash address
+ * @param pData      Source (must remain valid until the callback)
+ * @param uLength    Length in bytes (> 0)
+ * @param pCb        Completion callback
+ * @param pContext   Passed to the callback
+ * @return           Error code of the request
+ */
+BspSpiFlashError_e BspSpiFlashWrite(BspSpiFlashHandle_t handle, uint32_t uAddress, const uint8_t* pData, uint32_t uLength,
+                                    BspSpiFlashCb_t pCb, void* pContext);
+
+/**
+ * @brief Erase a sector-aligned area.
+ *
+ * Uses 64 KiB block erase where the area covers an aligned block and 4 KiB
+ * sector erase elsewhere.
+ *
+ * @param handle     Flash handle
+ * @param uAddress   Flash address (multiple of BSP_SPIFLASH_SECTOR_SIZE)
+ * @param uLength    Length in bytes (multiple of BSP_SPIFLASH_SECTOR_SIZE, > 0)
+ * @param pCb        Completion callback
+ * @param pContext   Passed to the callback
+ * @return           Error code of the request
+ */
+BspSpiFlashError_e BspSpiFlashErase(BspSpiFlashHandle_t handle, uint32_t uAddress, uint32_t uLength, BspSpiFlashCb_t pCb, void* pContext);
+
+/**
+ * @brief Check whether an operation is in progress.
+ *
+ * @param handle     Flash handle
+ * @return           true while an operation runs (false for invalid handles)
+ */
+bool BspSpiFlashIsBusy(BspSpiFlashHandle_t handle);
+
+/**
+ * @brief Get flash statistics.
+ *
+ * @param handle     Flash handle
+ * @param pStats     Output: statistics snapshot
+ * @return           Error code
+ */
+BspSpiFlashError_e BspSpiFlashGetStats(BspSpiFlashHandle_t handle, BspSpiFlashStats_t* pStats);
+
+#ifdef __cplusplus
+}
+#endif
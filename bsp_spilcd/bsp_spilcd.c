@@ -0,0 +1,662 @@
+/**
+ * @file bsp_spilcd.c
+ * @brief SPI display framebuffer driver implementation
+ *
+ * A frame is a chain of bsp_spi device transfers, one in flight at a time so
+ * that the D/C pin can be switched between them. Per window:
+ *
+ *   CASET -> x0,x1 -> RASET -> y0,y1 -> RAMWR -> pixel burst(s) -> next window or done
+ *
+ * Full-width windows are contiguous in the framebuffer and go out as one
+ * transfer (chunked by bsp_spi above 65535 bytes); narrower windows send up to
+ * BSP_SPILCD_ROWS_PER_BURST rows per transfer as a segment list. The
+ * controller continues the memory write across chip-select cycles while D/C
+ * stays high.
+ */
+
+#include "bsp_spilcd.h"
+#include "bsp_compiler_attributes.h"
+#include "bsp_gpio.h"
+#include "stm32f4xx_hal.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================================================
+ * Private Constants
+ * ========================================================================== */
+
+#define SPILCD_CMD_CASET (0x2Au) /**< Column address set */
+#define SPILCD_CMD_RASET (0x2Bu) /**< Row address set */
+#define SPILCD_CMD_RAMWR (0x2Cu) /**< Memory write */
+
+/** Bytes per RGB565 pixel */
+#define SPILCD_BYTES_PER_PIXEL (2u)
+
+/* ============================================================================
+ * Private Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Operation in progress.
+ */
+typedef enum
+{
+    eSPILCD_OP_IDLE = 0u,
+    eSPILCD_OP_COMMAND,
+    eSPILCD_OP_FRAME
+} BspSpiLcdOp_e;
+
+/**
+ * @brief Next transfer of the operation.
+ */
+typedef enum
+{
+    eSPILCD_STEP_CMD = 0u,   /**< Command byte of BspSpiLcdCommand() */
+    eSPILCD_STEP_CMD_PARAMS, /**< Its parameters */
+    eSPILCD_STEP_CASET,
+    eSPILCD_STEP_CASET_PARAMS,
+    eSPILCD_STEP_RASET,
+    eSPILCD_STEP_RASET_PARAMS,
+    eSPILCD_STEP_RAMWR,
+    eSPILCD_STEP_PIXELS
+} BspSpiLcdStep_e;
+
+/**
+ * @brief Display instance.
+ *
+ * The send fields are set by the API call that starts an operation and owned
+ * by the completion callbacks until it ends.
+ */
+typedef struct
+{
+    BspSpiLcdConfig_t      tConfig;
+    bool                   bAllocated;
+    BspSpiDeviceHandle_t   hDevice;
+    volatile BspSpiLcdOp_e eOp;
+    BspSpiLcdCb_t          pCb;
+    void*                  pContext;
+    uint8_t                byDraw;                           /**< Index of the draw buffer */
+    uint8_t                byDirty;                          /**< Dirty rectangles of the draw buffer */
+    uint8_t                bySend;                           /**< Windows of the frame on the bus */
+    uint8_t                byWindow;                         /**< Window being sent */
+    BspSpiLcdStep_e        eStep;
+    uint16_t               uRow;                             /**< Next row of the window's pixel data */
+    const uint16_t*        pSendFrame;                       /**< Framebuffer on the bus */
+    const uint8_t*         pParams;                          /**< Command parameters */
+    uint32_t               uParamLength;
+    uint8_t                byCmd;
+    uint8_t                abyParams[4];                     /**< Address set parameters */
+    BspSpiLcdRect_t        atDirty[BSP_SPILCD_MAX_RECTS];
+    BspSpiLcdRect_t        atSend[BSP_SPILCD_MAX_RECTS];
+    BspSpiSegment_t        atSeg[BSP_SPILCD_ROWS_PER_BURST]; /**< One row each */
+    BspSpiLcdStats_t       tStats;
+} BspSpiLcd_t;
+
+/* ============================================================================
+ * Private Global Variables
+ * ========================================================================== */
+
+/** Display instance array */
+FORCE_STATIC BspSpiLcd_t s_aSpiLcd[BSP_SPILCD_MAX_INSTANCES] = {0};
+
+/* ============================================================================
+ * Private Function Prototypes
+ * ========================================================================== */
+
+FORCE_STATIC void sSpiLcdOnXfer(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext);
+
+/* ============================================================================
+ * Private Functions
+ * ========================================================================== */
+
+/**
+ * @brief Validate handle and return instance pointer.
+ */
+FORCE_STATIC BspSpiLcd_t* sSpiLcdValidateHandle(BspSpiLcdHandle_t handle)
+{
+    if ((handle < 0) || (handle >= (BspSpiLcdHandle_t)BSP_SPILCD_MAX_INSTANCES))
+    {
+        return NULL;
+    }
+
+    if (!s_aSpiLcd[handle].bAllocated)
+    {
+        return NULL;
+    }
+
+    return &s_aSpiLcd[handle];
+}
+
+FORCE_STATIC uint32_t sSpiLcdArea(const BspSpiLcdRect_t* pRect)
+{
+    return (uint32_t)pRect->uWidth * pRect->uHeight;
+}
+
+/**
+ * @brief Bounding box of two rectangles.
+ */
+FORCE_STATIC BspSpiLcdRect_t sSpiLcdUnion(const BspSpiLcdRect_t* pA, const BspSpiLcdRect_t* pB)
+{
+    uint32_t uX0 = (pA->uX < pB->uX) ? pA->uX : pB->uX;
+    uint32_t uY0 = (pA->uY < pB->uY) ? pA->uY : pB->uY;
+    uint32_t uAx = (uint32_t)pA->uX + pA->uWidth;
+    uint32_t uBx = (uint32_t)pB->uX + pB->uWidth;
+    uint32_t uAy = (uint32_t)pA->uY + pA->uHeight;
+    uint32_t uBy = (uint32_t)pB->uY + pB->uHeight;
+    uint32_t uX1 = (uAx > uBx) ? uAx : uBx;
+    uint32_t uY1 = (uAy > uBy) ? uAy : uBy;
+
+    return (BspSpiLcdRect_t){(uint16_t)uX0, (uint16_t)uY0, (uint16_t)(uX1 - uX0), (uint16_t)(uY1 - uY0)};
+}
+
+/**
+ * @brief Extra pixels sent when two rectangles are replaced by their bounding box.
+ *
+ * Overlapping pixels would be sent twice as separate windows, so the overlap
+ * counts in favour of merging.
+ */
+FORCE_STATIC int32_t sSpiLcdMergeCost(const BspSpiLcdRect_t* pA, const BspSpiLcdRect_t* pB)
+{
+    BspSpiLcdRect_t tUnion   = sSpiLcdUnion(pA, pB);
+    int32_t         iOverlap = 0;
+    int32_t         iX0      = (pA->uX > pB->uX) ? pA->uX : pB->uX;
+    int32_t         iY0      = (pA->uY > pB->uY) ? pA->uY : pB->uY;
+    int32_t         iX1      = ((pA->uX + pA->uWidth) < (pB->uX + pB->uWidth)) ? (pA->uX + pA->uWidth) : (pB->uX + pB->uWidth);
+    int32_t         iY1      = ((pA->uY + pA->uHeight) < (pB->uY + pB->uHeight)) ? (pA->uY + pA->uHeight) : (pB->uY + pB->uHeight);
+
+    if ((iX1 > iX0) && (iY1 > iY0))
+    {
+        iOverlap = (iX1 - iX0) * (iY1 - iY0);
+    }
+
+    return (int32_t)sSpiLcdArea(&tUnion) - (int32_t)sSpiLcdArea(pA) - (int32_t)sSpiLcdArea(pB) + iOverlap;
+}
+
+/**
+ * @brief Remove a dirty rectangle (order is not kept).
+ */
+FORCE_STATIC void sSpiLcdRemoveDirty(BspSpiLcd_t* pLcd, uint8_t byIndex)
+{
+    pLcd->byDirty--;
+    pLcd->atDirty[byIndex] = pLcd->atDirty[pLcd->byDirty];
+}
+
+/**
+ * @brief Add a dirty rectangle, merging until no cheap merge is left.
+ *
+ * A full list forces the cheapest merge; the merged rectangle is then added
+ * like a new one, so it may absorb further rectangles.
+ */
+FORCE_STATIC void sSpiLcdAddDirty(BspSpiLcd_t* pLcd, BspSpiLcdRect_t tRect)
+{
+    bool bMerged = true;
+
+    while (bMerged)
+    {
+        uint8_t byBest    = 0u;
+        int32_t iBestCost = INT32_MAX;
+
+        bMerged = false;
+
+        for (uint8_t i = 0u; i < pLcd->byDirty; i++)
+        {
+            int32_t iCost = sSpiLcdMergeCost(&tRect, &pLcd->atDirty[i]);
+
+            if (iCost < iBestCost)
+            {
+                iBestCost = iCost;
+                byBest    = i;
+            }
+        }
+
+        if ((pLcd->byDirty > 0u) && ((iBestCost <= (int32_t)BSP_SPILCD_MERGE_SLACK) || (pLcd->byDirty >= BSP_SPILCD_MAX_RECTS)))
+        {
+            tRect = sSpiLcdUnion(&tRect, &pLcd->atDirty[byBest]);
+            sSpiLcdRemoveDirty(pLcd, byBest);
+            bMerged = true;
+        }
+    }
+
+    pLcd->atDirty[pLcd->byDirty] = tRect;
+    pLcd->byDirty++;
+}
+
+/**
+ * @brief End the operation and report the result.
+ */
+FORCE_STATIC void sSpiLcdFinish(BspSpiLcd_t* pLcd, BspSpiLcdError_e eError)
+{
+    BspSpiLcdCb_t pCb      = pLcd->pCb;
+    void*         pContext = pLcd->pContext;
+
+    if ((eError == eBSP_SPILCD_ERR_NONE) && (pLcd->eOp == eSPILCD_OP_FRAME))
+    {
+        pLcd->tStats.uFrames++;
+    }
+
+    pLcd->eOp = eSPILCD_OP_IDLE;
+
+    if (pCb != NULL)
+    {
+        pCb((BspSpiLcdHandle_t)(pLcd - s_aSpiLcd), eError, pContext);
+    }
+}
+
+/**
+ * @brief Queue a command or parameter transfer with the D/C level set.
+ */
+FORCE_STATIC BspSpiError_e sSpiLcdQueue(BspSpiLcd_t* pLcd, bool bData, const uint8_t* pTxData, uint32_t uLength)
+{
+    BspSpiXfer_t tXfer = {0};
+
+    tXfer.pTxData   = pTxData;
+    tXfer.uLength   = uLength;
+    tXfer.pCallback = sSpiLcdOnXfer;
+    tXfer.pContext  = pLcd;
+
+    /* Safe to switch: the previous transfer to this display has completed */
+    BspGpioWritePin(pLcd->tConfig.uDcPin, bData);
+    pLcd->tStats.uCommandBytes += uLength;
+
+    return BspSpiDeviceQueueTransfer(pLcd->hDevice, &tXfer);
+}
+
+/**
+ * @brief Write a big-endian start/end address pair for CASET/RASET.
+ */
+FORCE_STATIC void sSpiLcdSetRange(BspSpiLcd_t* pLcd, uint16_t uStart, uint16_t uLength)
+{
+    uint16_t uEnd = (uint16_t)(uStart + uLength - 1u);
+
+    pLcd->abyParams[0] = (uint8_t)(uStart >> 8u);
+    pLcd->abyParams[1] = (uint8_t)uStart;
+    pLcd->abyParams[2] = (uint8_t)(uEnd >> 8u);
+    pLcd->abyParams[3] = (uint8_t)uEnd;
+}
+
+/**
+ * @brief Queue the next pixel burst of the current window.
+ */
+FORCE_STATIC BspSpiError_e sSpiLcdQueuePixels(BspSpiLcd_t* pLcd)
+{
+    const BspSpiLcdRect_t* pRect     = &pLcd->atSend[pLcd->byWindow];
+    uint32_t               uWidth    = pLcd->tConfig.uWidth;
+    uint32_t               uRows     = (uint32_t)pRect->uY + pRect->uHeight - pLcd->uRow;
+    uint32_t               uRowBytes = (uint32_t)pRect->uWidth * SPILCD_BYTES_PER_PIXEL;
+    BspSpiXfer_t           tXfer     = {0};
+
+    tXfer.pCallback = sSpiLcdOnXfer;
+    tXfer.pContext  = pLcd;
+
+    if (pRect->uWidth == uWidth)
+    {
+        /* Full-width rows are contiguous */
+        tXfer.pTxData = (const uint8_t*)&pLcd->pSendFrame[(uint32_t)pLcd->uRow * uWidth];
+        tXfer.uLength = uRows * uRowBytes;
+    }
+    else
+    {
+        if (uRows > BSP_SPILCD_ROWS_PER_BURST)
+        {
+            uRows = BSP_SPILCD_ROWS_PER_BURST;
+        }
+
+        for (uint32_t i = 0u; i < uRows; i++)
+        {
+            const uint16_t* pRow = &pLcd->pSendFrame[((pLcd->uRow + i) * uWidth) + pRect->uX];
+            pLcd->atSeg[i]       = (BspSpiSegment_t){(const uint8_t*)pRow, NULL, uRowBytes};
+        }
+
+        tXfer.pSegments = pLcd->atSeg;
+        tXfer.uSegments = uRows;
+    }
+
+    pLcd->uRow = (uint16_t)(pLcd->uRow + uRows);
+    pLcd->tStats.uPixelBytes += uRows * uRowBytes;
+
+    BspGpioWritePin(pLcd->tConfig.uDcPin, true);
+    return BspSpiDeviceQueueTransfer(pLcd->hDevice, &tXfer);
+}
+
+/**
+ * @brief Queue the transfer for the current step.
+ */
+FORCE_STATIC BspSpiError_e sSpiLcdIssue(BspSpiLcd_t* pLcd)
+{
+    const BspSpiLcdRect_t* pRect = &pLcd->atSend[pLcd->byWindow];
+
+    switch (pLcd->eStep)
+    {
+        case eSPILCD_STEP_CMD:
+            return sSpiLcdQueue(pLcd, false, &pLcd->byCmd, 1u);
+
+        case eSPILCD_STEP_CMD_PARAMS:
+            return sSpiLcdQueue(pLcd, true, pLcd->pParams, pLcd->uParamLength);
+
+        case eSPILCD_STEP_CASET:
+            pLcd->byCmd = SPILCD_CMD_CASET;
+            pLcd->uRow  = pRect->uY;
+            pLcd->tStats.uWindows++;
+            return sSpiLcdQueue(pLcd, false, &pLcd->byCmd, 1u);
+
+        case eSPILCD_STEP_CASET_PARAMS:
+            sSpiLcdSetRange(pLcd, pRect->uX, pRect->uWidth);
+            return sSpiLcdQueue(pLcd, true, pLcd->abyParams, sizeof(pLcd->abyParams));
+
+        case eSPILCD_STEP_RASET:
+            pLcd->byCmd = SPILCD_CMD_RASET;
+            return sSpiLcdQueue(pLcd, false, &pLcd->byCmd, 1u);
+
+        case eSPILCD_STEP_RASET_PARAMS:
+            sSpiLcdSetRange(pLcd, pRect->uY, pRect->uHeight);
+            return sSpiLcdQueue(pLcd, true, pLcd->abyParams, sizeof(pLcd->abyParams));
+
+        case eSPILCD_STEP_RAMWR:
+            pLcd->byCmd = SPILCD_CMD_RAMWR;
+            return sSpiLcdQueue(pLcd, false, &pLcd->byCmd, 1u);
+
+        default:
+            return sSpiLcdQueuePixels(pLcd);
+    }
+}
+
+/**
+ * @brief Transfer completion: advance to the next step, window or finish.
+ */
+FORCE_STATIC void sSpiLcdOnXfer(BspSpiHandle_t hBus, BspSpiError_e eError, void* pContext)
+{
+    BspSpiLcd_t* pLcd = (BspSpiLcd_t*)pContext;
+
+    (void)hBus;
+
+    if (eError != eBSP_SPI_ERR_NONE)
+    {
+        sSpiLcdFinish(pLcd, eBSP_SPILCD_ERR_SPI);
+        return;
+    }
+
+    if (pLcd->eStep == eSPILCD_STEP_CMD)
+    {
+        if (pLcd->uParamLength == 0u)
+        {
+            sSpiLcdFinish(pLcd, eBSP_SPILCD_ERR_NONE);
+            return;
+        }
+        pLcd->eStep = eSPILCD_STEP_CMD_PARAMS;
+    }
+    else if (pLcd->eStep == eSPILCD_STEP_CMD_PARAMS)
+    {
+        sSpiLcdFinish(pLcd, eBSP_SPILCD_ERR_NONE);
+        return;
+    }
+    else if (pLcd->eStep != eSPILCD_STEP_PIXELS)
+    {
+        pLcd->eStep++;
+    }
+    else if (pLcd->uRow >= (pLcd->atSend[pLcd->byWindow].uY + pLcd->atSend[pLcd->byWindow].uHeight))
+    {
+        pLcd->byWindow++;
+        if (pLcd->byWindow >= pLcd->bySend)
+        {
+            sSpiLcdFinish(pLcd, eBSP_SPILCD_ERR_NONE);
+            return;
+        }
+        pLcd->eStep = eSPILCD_STEP_CASET;
+    }
+
+    if (sSpiLcdIssue(pLcd) != eBSP_SPI_ERR_NONE)
+    {
+        sSpiLcdFinish(pLcd, eBSP_SPILCD_ERR_BUSY);
+    }
+}
+
+/**
+ * @brief Copy the sent windows into the new draw buffer (double buffering).
+ */
+FORCE_STATIC void sSpiLcdSyncBuffers(BspSpiLcd_t* pLcd, uint16_t* pDest)
+{
+    uint32_t uWidth = pLcd->tConfig.uWidth;
+
+    for (uint8_t i = 0u; i < pLcd->bySend; i++)
+    {
+        const BspSpiLcdRect_t* pRect     = &pLcd->atSend[i];
+        uint32_t               uRowBytes = (uint32_t)pRect->uWidth * SPILCD_BYTES_PER_PIXEL;
+
+        for (uint32_t uRow = pRect->uY; uRow < ((uint32_t)pRect->uY + pRect->uHeight); uRow++)
+        {
+            uint32_t uOffset = (uRow * uWidth) + pRect->uX;
+            (void)memcpy(&pDest[uOffset], &pLcd->pSendFrame[uOffset], uRowBytes);
+        }
+
+        pLcd->tStats.uCopiedBytes += uRowBytes * pRect->uHeight;
+    }
+}
+
+/* ============================================================================
+ * Public Functions
+ * ========================================================================== */
+
+BspSpiLcdHandle_t BspSpiLcdAllocate(const BspSpiLcdConfig_t* pConfig)
+{
+    if ((pConfig == NULL) || (pConfig->apFrame[0] == NULL) || (pConfig->apFrame[0] == pConfig->apFrame[1]) || (pConfig->uWidth == 0u) ||
+        (pConfig->uHeight == 0u))
+    {
+        return BSP_SPILCD_INVALID_HANDLE;
+    }
+
+    for (uint8_t i = 0u; i < BSP_SPILCD_MAX_INSTANCES; i++)
+    {
+        BspSpiLcd_t* pLcd = &s_aSpiLcd[i];
+
+        if (pLcd->bAllocated)
+        {
+            continue;
+        }
+
+        BspSpiDeviceConfig_t tDevice = {0};
+        tDevice.hBus                 = pConfig->hBus;
+        tDevice.uCsPin               = pConfig->uCsPin;
+        tDevice.eClockMode           = pConfig->eClockMode;
+        tDevice.ePrescaler           = pConfig->ePrescaler;
+
+        BspSpiDeviceHandle_t hDevice = BspSpiDeviceAdd(&tDevice);
+
+        if (hDevice < 0)
+        {
+            return BSP_SPILCD_INVALID_HANDLE;
+        }
+
+        (void)memset(pLcd, 0, sizeof(*pLcd));
+        pLcd->tConfig    = *pConfig;
+        pLcd->hDevice    = hDevice;
+        pLcd->bAllocated = true;
+        BspGpioWritePin(pConfig->uDcPin, true);
+
+        return (BspSpiLcdHandle_t)i;
+    }
+
+    return BSP_SPILCD_INVALID_HANDLE;
+}
+
+BspSpiLcdError_e BspSpiLcdFree(BspSpiLcdHandle_t handle)
+{
+    BspSpiLcd_t* pLcd = sSpiLcdValidateHandle(handle);
+
+    if (pLcd == NULL)
+    {
+        return eBSP_SPILCD_ERR_INVALID_HANDLE;
+    }
+
+    if ((pLcd->eOp != eSPILCD_OP_IDLE) || (BspSpiDeviceRemove(pLcd->hDevice) != eBSP_SPI_ERR_NONE))
+    {
+        return eBSP_SPILCD_ERR_BUSY;
+    }
+
+    pLcd->bAllocated = false;
+
+    return eBSP_SPILCD_ERR_NONE;
+}
+
+BspSpiLcdError_e BspSpiLcdCommand(BspSpiLcdHandle_t handle, uint8_t byCmd, const uint8_t* pParams, uint32_t uLength, BspSpiLcdCb_t pCb,
+                                  void* pContext)
+{
+    BspSpiLcd_t* pLcd = sSpiLcdValidateHandle(handle);
+
+    if (pLcd == NULL)
+    {
+        return eBSP_SPILCD_ERR_INVALID_HANDLE;
+    }
+
+    if ((uLength > 0u) && (pParams == NULL))
+    {
+        return eBSP_SPILCD_ERR_INVALID_PARAM;
+    }
+
+    if (pLcd->eOp != eSPILCD_OP_IDLE)
+    {
+        return eBSP_SPILCD_ERR_BUSY;
+    }
+
+    pLcd->pCb          = pCb;
+    pLcd->pContext     = pContext;
+    pLcd->byCmd        = byCmd;
+    pLcd->pParams      = pParams;
+    pLcd->uParamLength = uLength;
+    pLcd->eStep        = eSPILCD_STEP_CMD;
+    pLcd->eOp          = eSPILCD_OP_COMMAND;
+
+    if (sSpiLcdIssue(pLcd) != eBSP_SPI_ERR_NONE)
+    {
+        pLcd->eOp = eSPILCD_OP_IDLE;
+        return eBSP_SPILCD_ERR_BUSY;
+    }
+
+    return eBSP_SPILCD_ERR_NONE;
+}
+
+uint16_t* BspSpiLcdGetDrawBuffer(BspSpiLcdHandle_t handle)
+{
+    BspSpiLcd_t* pLcd = sSpiLcdValidateHandle(handle);
+
+    return (pLcd != NULL) ? pLcd->tConfig.apFrame[pLcd->byDraw] : NULL;
+}
+
+BspSpiLcdError_e BspSpiLcdInvalidate(BspSpiLcdHandle_t handle, const BspSpiLcdRect_t* pRect)
+{
+    BspSpiLcd_t* pLcd = sSpiLcdValidateHandle(handle);
+
+    if (pLcd == NULL)
+    {
+        return eBSP_SPILCD_ERR_INVALID_HANDLE;
+    }
+
+    if ((pRect == NULL) || (pRect->uWidth == 0u) || (pRect->uHeight == 0u) || (pRect->uX >= pLcd->tConfig.uWidth) ||
+        (pRect->uY >= pLcd->tConfig.uHeight))
+    {
+        return eBSP_SPILCD_ERR_INVALID_PARAM;
+    }
+
+    BspSpiLcdRect_t tRect = *pRect;
+
+    if (tRect.uWidth > (pLcd->tConfig.uWidth - tRect.uX))
+    {
+        tRect.uWidth = (uint16_t)(pLcd->tConfig.uWidth - tRect.uX);
+    }
+
+    if (tRect.uHeight > (pLcd->tConfig.uHeight - tRect.uY))
+    {
+        tRect.uHeight = (uint16_t)(pLcd->tConfig.uHeight - tRect.uY);
+    }
+
+    sSpiLcdAddDirty(pLcd, tRect);
+
+    return eBSP_SPILCD_ERR_NONE;
+}
+
+BspSpiLcdError_e BspSpiLcdPresent(BspSpiLcdHandle_t handle, BspSpiLcdCb_t pCb, void* pContext)
+{
+    BspSpiLcd_t* pLcd = sSpiLcdValidateHandle(handle);
+
+    if (pLcd == NULL)
+    {
+        return eBSP_SPILCD_ERR_INVALID_HANDLE;
+    }
+
+    if (pLcd->eOp != eSPILCD_OP_IDLE)
+    {
+        return eBSP_SPILCD_ERR_BUSY;
+    }
+
+    if (pLcd->byDirty == 0u)
+    {
+        if (pCb != NULL)
+        {
+            pCb(handle, eBSP_SPILCD_ERR_NONE, pContext);
+        }
+        return eBSP_SPILCD_ERR_NONE;
+    }
+
+    uint8_t   byFront = pLcd->byDraw;
+    uint16_t* pBack   = pLcd->tConfig.apFrame[byFront ^ 1u];
+    uint8_t   byDirty = pLcd->byDirty;
+
+    (void)memcpy(pLcd->atSend, pLcd->atDirty, (uint32_t)byDirty * sizeof(BspSpiLcdRect_t));
+    pLcd->pCb        = pCb;
+    pLcd->pContext   = pContext;
+    pLcd->pSendFrame = pLcd->tConfig.apFrame[byFront];
+    pLcd->bySend     = byDirty;
+    pLcd->byWindow   = 0u;
+    pLcd->eStep      = eSPILCD_STEP_CASET;
+    pLcd->byDirty    = 0u;
+    pLcd->eOp        = eSPILCD_OP_FRAME;
+
+    /* Switch before the first transfer: the frame may complete before this function returns */
+    if (pBack != NULL)
+    {
+        pLcd->byDraw = byFront ^ 1u;
+    }
+
+    if (sSpiLcdIssue(pLcd) != eBSP_SPI_ERR_NONE)
+    {
+        pLcd->eOp     = eSPILCD_OP_IDLE;
+        pLcd->byDraw  = byFront;
+        pLcd->byDirty = byDirty;
+        return eBSP_SPILCD_ERR_BUSY;
+    }
+
+    /* Runs while the DMA reads the same buffer: both only read the front buffer */
+    if (pBack != NULL)
+    {
+        sSpiLcdSyncBuffers(pLcd, pBack);
+    }
+
+    return eBSP_SPILCD_ERR_NONE;
+}
+
+bool BspSpiLcdIsBusy(BspSpiLcdHandle_t handle)
+{
+    const BspSpiLcd_t* pLcd = sSpiLcdValidateHandle(handle);
+
+    return (pLcd != NULL) && (pLcd->eOp != eSPILCD_OP_IDLE);
+}
+
+BspSpiLcdError_e BspSpiLcdGetStats(BspSpiLcdHandle_t handle, BspSpiLcdStats_t* pStats)
+{
+    const BspSpiLcd_t* pLcd = sSpiLcdValidateHandle(handle);
+
+    if (pLcd == NULL)
+    {
+        return eBSP_SPILCD_ERR_INVALID_HANDLE;
+    }
+
+    if (pStats == NULL)
+    {
+        return eBSP_SPILCD_ERR_INVALID_PARAM;
+    }
+
+    __disable_irq();
+    *pStats = pLcd->tStats;
+    __enable_irq();
+
+    return eBSP_SPILCD_ERR_NONE;
+}
@@ -0,0 +1,257 @@
+/**
+ * @file bsp_spilcd.h
+ * @brief SPI display framebuffer driver with dirty-rectangle updates
+ *
+ * - RGB565 framebuffer in RAM, single or double buffered
+ * - Changed areas are marked as dirty rectangles; overlapping and nearby
+ *   rectangles are merged so that the bus carries few extra pixels
+ * - Present sends only the dirty windows: column address set, row address
+ *   set, memory write and a DMA burst per window, each step chained from the
+ *   previous completion interrupt on the bsp_spi device queue
+ * - Double buffering: the frame on the bus is never drawn into; its dirty
+ *   areas are copied into the other buffer so both stay complete
+ *
+ * Works with MIPI DCS controllers (ILI9341, ST7789, ILI9163 and similar) in
+ * 16 bit/pixel mode with a data/command (D/C) pin.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "bsp_spi.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ============================================================================
+ * Configuration
+ * ========================================================================== */
+
+/** @brief Maximum number of displays */
+#ifndef BSP_SPILCD_MAX_INSTANCES
+    #define BSP_SPILCD_MAX_INSTANCES (1u)
+#endif
+
+/**
+ * @brief Dirty rectangles tracked per frame.
+ * When the list is full, the pair that costs the fewest extra pixels is merged.
+ * Memory impact: 2 × 8 bytes per rectangle and display.
+ */
+#ifndef BSP_SPILCD_MAX_RECTS
+    #define BSP_SPILCD_MAX_RECTS (8u)
+#endif
+
+/**
+ * @brief Extra pixels a merge may add to the bus traffic.
+ * Two rectangles are merged when their bounding box sends at most this many
+ * pixels more than the two rectangles separately. The default is about the
+ * bus and interrupt time of the five commands that start a window.
+ */
+#ifndef BSP_SPILCD_MERGE_SLACK
+    #define BSP_SPILCD_MERGE_SLACK (64u)
+#endif
+
+/**
+ * @brief Rows per pixel burst for windows narrower than the display.
+ * Each row is one scatter-gather segment; full-width windows are contiguous
+ * and go out as a single transfer.
+ * Memory impact: 12 bytes per row and display.
+ */
+#ifndef BSP_SPILCD_ROWS_PER_BURST
+    #define BSP_SPILCD_ROWS_PER_BURST (16u)
+#endif
+
+#if (BSP_SPILCD_MAX_INSTANCES < 1u) || (BSP_SPILCD_MAX_INSTANCES > 4u)
+    #error "BSP_SPILCD_MAX_INSTANCES must be between 1 and 4"
+#endif
+
+#if (BSP_SPILCD_MAX_RECTS < 1u) || (BSP_SPILCD_MAX_RECTS > 32u)
+    #error "BSP_SPILCD_MAX_RECTS must be between 1 and 32"
+#endif
+
+#if (BSP_SPILCD_ROWS_PER_BURST < 1u) || (BSP_SPILCD_ROWS_PER_BURST > 255u)
+    #error "BSP_SPILCD_ROWS_PER_BURST must be between 1 and 255"
+#endif
+
+/**
+ * @brief RGB565 pixel in bus byte order (high byte first) for the framebuffer.
+ * Components are 8 bit; the lower bits are dropped.
+ */
+#define BSP_SPILCD_RGB565(r, g, b)                                                                                                     \
+    ((uint16_t)((((uint32_t)(g) & 0x1Cu) << 11u) | (((uint32_t)(b) & 0xF8u) << 5u) | ((uint32_t)(r) & 0xF8u) | (((uint32_t)(g) & 0xE0u) >> 5u)))
+
+/* ============================================================================
+ * Type Definitions
+ * ========================================================================== */
+
+/**
+ * @brief Display handle. Valid handles are >= 0.
+ */
+typedef int8_t BspSpiLcdHandle_t;
+
+/** Invalid handle constant */
+static const BspSpiLcdHandle_t BSP_SPILCD_INVALID_HANDLE = -1;
+
+/**
+ * @brief Display error codes.
+ */
+typedef enum
+{
+    eBSP_SPILCD_ERR_NONE = 0u,      /**< Success */
+    eBSP_SPILCD_ERR_INVALID_HANDLE, /**< Invalid or unallocated handle */
+    eBSP_SPILCD_ERR_INVALID_PARAM,  /**< Invalid parameter or rectangle outside the display */
+    eBSP_SPILCD_ERR_BUSY,           /**< Frame or command in progress, or bus queue full */
+    eBSP_SPILCD_ERR_SPI             /**< SPI transfer failed */
+} BspSpiLcdError_e;
+
+/**
+ * @brief Completion callback (interrupt context, or the caller's context when
+ * there is nothing to send).
+ *
+ * @param handle     Display handle
+ * @param eError     Result of the frame or command
+ * @param pContext   Context passed with the request
+ */
+typedef void (*BspSpiLcdCb_t)(BspSpiLcdHandle_t handle, BspSpiLcdError_e eError, void* pContext);
+
+/**
+ * @brief Display configuration.
+ *
+ * Framebuffers hold uWidth × uHeight pixels, row by row, each pixel in bus
+ * byte order (see BSP_SPILCD_RGB565). Both must stay valid until the display
+ * is freed.
+ */
+typedef struct
+{
+    BspSpiHandle_t    hBus;       /**< bsp_spi bus handle (DMA mode) */
+    uint32_t          uCsPin;     /**< Chip-select pin for BspGpioWritePin(), active low */
+    uint32_t          uDcPin;     /**< Data/command pin for BspGpioWritePin(), low for commands */
+    BspSpiClockMode_e eClockMode; /**< Clock polarity and phase of the controller */
+    BspSpiPrescaler_e ePrescaler; /**< Bus clock prescaler for this display */
+    uint16_t          uWidth;     /**< Columns in the current memory access orientation */
+    uint16_t          uHeight;    /**< Rows in the current memory access orientation */
+    uint16_t*         apFrame[2]; /**< Framebuffers; apFrame[1] NULL for single buffering */
+} BspSpiLcdConfig_t;
+
+/**
+ * @brief Rectangle in pixels.
+ */
+typedef struct
+{
+    uint16_t uX;      /**< First column */
+    uint16_t uY;      /**< First row */
+    uint16_t uWidth;  /**< Columns (> 0) */
+    uint16_t uHeight; /**< Rows (> 0) */
+} BspSpiLcdRect_t;
+
+/**
+ * @brief Display statistics.
+ */
+typedef struct
+{
+    uint32_t uFrames;       /**< Frames sent completely */
+    uint32_t uWindows;      /**< Windows (merged dirty rectangles) started */
+    uint32_t uPixelBytes;   /**< Pixel bytes sent */
+    uint32_t uCommandBytes; /**< Command and parameter bytes sent */
+    uint32_t uCopiedBytes;  /**< Bytes copied to keep the double buffers in step */
+} BspSpiLcdStats_t;
+
+/* ============================================================================
+ * Public API
+ * ========================================================================== */
+
+/**
+ * @brief Allocate a display on a shared bus.
+ *
+ * Adds a bsp_spi device and releases its chip select. The controller
+ * initialisation sequence is sent by the application with BspSpiLcdCommand().
+ *
+ * @param pConfig    Display configuration (copied)
+ * @return           Display handle, BSP_SPILCD_INVALID_HANDLE on error
+ */
+BspSpiLcdHandle_t BspSpiLcdAllocate(const BspSpiLcdConfig_t* pConfig);
+
+/**
+ * @brief Free a display.
+ *
+ * @param handle     Display handle
+ * @return           Error code; eBSP_SPILCD_ERR_BUSY while a frame or command is in progress
+ */
+BspSpiLcdError_e BspSpiLcdFree(BspSpiLcdHandle_t handle);
+
+/**
+ * @brief Send a controller command with optional parameters.
+ *
+ * @param handle     Display handle
+ * @param byCmd      Command byte (sent with D/C low)
+ * @param pParams    Parameter bytes (sent with D/C high), must remain valid until the callback
+ * @param uLength    Number of parameter bytes, may be 0
+ * @param pCb        Completion callback, may be NULL
+ * @param pContext   Passed to the callback
+ * @return           Error code of the request
+ */
+BspSpiLcdError_e BspSpiLcdCommand(BspSpiLcdHandle_t handle, uint8_t byCmd, const uint8_t* pParams, uint32_t uLength, BspSpiLcdCb_t pCb,
+                                  void* pContext);
+
+/**
+ * @brief Get the framebuffer to draw the next frame into.
+ *
+ * With double buffering this changes on every BspSpiLcdPresent() and always
+ * holds the complete current image.
+ *
+ * @param handle     Display handle
+ * @return           Framebuffer, NULL for invalid handles
+ */
+uint16_t* BspSpiLcdGetDrawBuffer(BspSpiLcdHandle_t handle);
+
+/**
+ * @brief Mark an area of the draw buffer as changed.
+ *
+ * The rectangle is clipped to the display and merged with overlapping or
+ * nearby dirty rectangles.
+ *
+ * @param handle     Display handle
+ * @param pRect      Changed area
+ * @return           Error code; eBSP_SPILCD_ERR_INVALID_PARAM for empty rectangles or rectangles outside the display
+ */
+BspSpiLcdError_e BspSpiLcdInvalidate(BspSpiLcdHandle_t handle, const BspSpiLcdRect_t* pRect);
+
+/**
+ * @brief Send the dirty areas of the draw buffer to the display.
+ *
+ * Starts the first window and returns; the rest of the frame is chained from
+ * the completion interrupts. With double buffering the draw buffer switches
+ * to the other framebuffer, which is brought up to date before returning.
+ * With single buffering the draw buffer must not be changed until the callback.
+ * Without dirty areas the callback is called before returning.
+ *
+ * @param handle     Display handle
+ * @param pCb        Frame completion callback, may be NULL
+ * @param pContext   Passed to the callback
+ * @return           Error code; eBSP_SPILCD_ERR_BUSY while the previous frame is on the bus
+ */
+BspSpiLcdError_e BspSpiLcdPresent(BspSpiLcdHandle_t handle, BspSpiLcdCb_t pCb, void* pContext);
+
+/**
+ * @brief Check whether a frame or command is in progress.
+ *
+ * @param handle     Display handle
+ * @return           true while busy (false for invalid handles)
+ */
+bool BspSpiLcdIsBusy(BspSpiLcdHandle_t handle);
+
+/**
+ * @brief Get display statistics.
+ *
+ * @param handle     Display handle
+ * @param pStats     Output: statistics snapshot
+ * @return           Error code
+ */
+BspSpiLcdError_e BspSpiLcdGetStats(BspSpiLcdHandle_t handle, BspSpiLcdStats_t* pStats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -28,9 +28,17 @@ install(FILES
     COMPONENT library
 )
 
+# bsp_canxfer headers
+install(FILES
+    ${CMAKE_CURRENT_SOURCE_DIR}/bsp_canxfer/bsp_canxfer.h
+    DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/bsp/canxfer
+    COMPONENT library
+)
+
 # bsp_common headers
 install(FILES
     ${CMAKE_CURRENT_SOURCE_DIR}/bsp_common/bsp_compiler_attributes.h
+    ${CMAKE_CURRENT_SOURCE_DIR}/bsp_common/bsp_xfer.h
     DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/bsp/common
     COMPONENT library
 )
@@ -77,6 +85,41 @@ install(FILES
     COMPONENT library
 )
 
+# bsp_spiacq headers
+install(FILES
+    ${CMAKE_CURRENT_SOURCE_DIR}/bsp_spiacq/bsp_spiacq.h
+    DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/bsp/spiacq
+    COMPONENT library
+)
+
+# bsp_spiflash headers
+install(FILES
+    ${CMAKE_CURRENT_SOURCE_DIR}/bsp_spiflash/bsp_spiflash.h
+    DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/bsp/spiflash
+    COMPONENT library
+)
+
+# bsp_sdspi headers
+install(FILES
+    ${CMAKE_CURRENT_SOURCE_DIR}/bsp_sdspi/bsp_sdspi.h
+    DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/bsp/sdspi
+    COMPONENT library
+)
+
+# bsp_spicache headers
+install(FILES
+    ${CMAKE_CURRENT_SOURCE_DIR}/bsp_spicache/bsp_spicache.h
+    DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/bsp/spicache
+    COMPONENT library
+)
+
+# bsp_spilcd headers
+install(FILES
+    ${CMAKE_CURRENT_SOURCE_DIR}/bsp_spilcd/bsp_spilcd.h
+    DESTINATION ${CMAKE_INSTALL_INCLUDEDIR}/bsp/spilcd
+    COMPONENT library
+)
+
 # bsp_swtimer headers
 install(FILES
     ${CMAKE_CURRENT_SOURCE_DIR}/bsp_swtimer/bsp_swtimer.h
@@ -4,7 +4,9 @@
  */
 
 #include "Mockstm32f4xx_hal_can.h"
+#include "Mockstm32f4xx_hal_cortex.h"
 #include "Mockstm32f4xx_hal_gpio.h"
+#include "Mockstm32f4xx_hal_rcc.h"
 #include "bsp_can.h"
 #include "bsp_led.h"
 #include "gpio_struct.h"
@@ -15,11 +17,13 @@
  * Test Stubs and Mocks
  * ========================================================================== */
 
+/* Fake tick source: advances 1 ms per call, tests may move it forward */
+static uint32_t s_uFakeTick = 0;
+
 /* Stub for HAL_GetTick - required by production code */
 uint32_t HAL_GetTick(void)
 {
-    static uint32_t tick = 0;
-    return tick++;
+    return s_uFakeTick++;
 }
 
 /* Stub CAN handles - required by production code */
@@ -44,6 +48,9 @@ extern void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef* hcan);
 extern void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef* hcan);
 extern void HAL_CAN_ErrorCallback(CAN_HandleTypeDef* hcan);
 
+/* SysTick hook of bsp_swtimer, drives the shared software timers */
+extern void HAL_SYSTICK_Callback(void);
+
 /* ============================================================================
  * Test Helper Functions
  * ========================================================================== */
@@ -449,7 +456,11 @@ void test_BspCanStop_Success(void)
     HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
     BspCanStart(hCan);
 
-    HAL_CAN_DeactivateNotification_ExpectAndReturn(&hcan1, CAN_IT_RX_FIFO0_MSG_PENDING, HAL_OK);
+    HAL_CAN_DeactivateNotification_ExpectAndReturn(&hcan1,
+                                                   CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_RX_FIFO1_MSG_PENDING | CAN_IT_TX_MAILBOX_EMPTY |
+                                                       CAN_IT_ERROR | CAN_IT_BUSOFF | CAN_IT_ERROR_PASSIVE | CAN_IT_RX_FIFO0_OVERRUN |
+                                                       CAN_IT_RX_FIFO1_OVERRUN,
+                                                   HAL_OK);
     HAL_CAN_Stop_ExpectAndReturn(&hcan1, HAL_OK);
 
     BspCanError_e eError = BspCanStop(hCan);
@@ -1378,6 +1389,7 @@ void test_HAL_CAN_ErrorCallback_BusOff_WithCallbacks(void)
     BspCanRegisterBusStateCallback(hCan, sTestBusStateCallback);
 
     HAL_CAN_GetError_ExpectAndReturn(&hcan1, HAL_CAN_ERROR_BOF);
+    HAL_CAN_ResetError_ExpectAndReturn(&hcan1, HAL_OK);
 
     HAL_CAN_ErrorCallback(&hcan1);
 
@@ -1393,6 +1405,7 @@ void test_HAL_CAN_ErrorCallback_BusOff_NoCallbacks(void)
     (void)BspCanAllocate(&tConfig, NULL, NULL);
 
     HAL_CAN_GetError_ExpectAndReturn(&hcan1, HAL_CAN_ERROR_BOF);
+    HAL_CAN_ResetError_ExpectAndReturn(&hcan1, HAL_OK);
 
     HAL_CAN_ErrorCallback(&hcan1);
 
@@ -1408,6 +1421,7 @@ void test_HAL_CAN_ErrorCallback_ErrorPassive_WithCallbacks(void)
     BspCanRegisterBusStateCallback(hCan, sTestBusStateCallback);
 
     HAL_CAN_GetError_ExpectAndReturn(&hcan1, HAL_CAN_ERROR_EPV);
+    HAL_CAN_ResetError_ExpectAndReturn(&hcan1, HAL_OK);
 
     HAL_CAN_ErrorCallback(&hcan1);
 
@@ -1423,6 +1437,7 @@ void test_HAL_CAN_ErrorCallback_ErrorPassive_NoCallbacks(void)
     (void)BspCanAllocate(&tConfig, NULL, NULL);
 
     HAL_CAN_GetError_ExpectAndReturn(&hcan1, HAL_CAN_ERROR_EPV);
+    HAL_CAN_ResetError_ExpectAndReturn(&hcan1, HAL_OK);
 
     HAL_CAN_ErrorCallback(&hcan1);
 
@@ -1437,6 +1452,7 @@ void test_HAL_CAN_ErrorCallback_GenericError_WithCallback(void)
     BspCanRegisterErrorCallback(hCan, sTestErrorCallback);
 
     HAL_CAN_GetError_ExpectAndReturn(&hcan1, HAL_CAN_ERROR_NONE);
+    HAL_CAN_ResetError_ExpectAndReturn(&hcan1, HAL_OK);
 
     HAL_CAN_ErrorCallback(&hcan1);
 
@@ -1450,6 +1466,7 @@ void test_HAL_CAN_ErrorCallback_GenericError_NoCallback(void)
     (void)BspCanAllocate(&tConfig, NULL, NULL);
 
     HAL_CAN_GetError_ExpectAndReturn(&hcan1, HAL_CAN_ERROR_NONE);
+    HAL_CAN_ResetError_ExpectAndReturn(&hcan1, HAL_OK);
 
     HAL_CAN_ErrorCallback(&hcan1);
 
@@ -1512,6 +1529,7 @@ void test_HAL_CAN_ErrorCallback_Instance2(void)
     BspCanRegisterErrorCallback(hCan, sTestErrorCallback);
 
     HAL_CAN_GetError_ExpectAndReturn(&hcan2, HAL_CAN_ERROR_BOF);
+    HAL_CAN_ResetError_ExpectAndReturn(&hcan2, HAL_OK);
 
     HAL_CAN_ErrorCallback(&hcan2);
 
@@ -1861,3 +1879,1626 @@ void test_BspCanAbortTransmit_FromHighestPriority(void)
     BspCanError_e eError = BspCanAbortTransmit(hCan, 0x6001);
     TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, eError);
 }
+
+/* ============================================================================
+ * Test Cases - Remote Frame Responders
+ * ========================================================================== */
+
+/* RX header returned by the GetRxMessage stub */
+static CAN_RxHeaderTypeDef s_tStubRxHeader;
+
+/* Last header and payload passed to HAL_CAN_AddTxMessage */
+static CAN_TxHeaderTypeDef s_tLastTxHeader;
+static uint8_t             s_aLastTxData[8];
+static int                 s_iAddTxCount;
+
+static HAL_StatusTypeDef sStubGetRxMessage(CAN_HandleTypeDef* hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef* pHeader, uint8_t aData[],
+                                           int cmock_num_calls)
+{
+    (void)hcan;
+    (void)RxFifo;
+    (void)aData;
+    (void)cmock_num_calls;
+    *pHeader = s_tStubRxHeader;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef sStubAddTxMessage(CAN_HandleTypeDef* hcan, CAN_TxHeaderTypeDef* pHeader, uint8_t aData[], uint32_t* pTxMailbox,
+                                           int cmock_num_calls)
+{
+    (void)hcan;
+    (void)cmock_num_calls;
+    s_tLastTxHeader = *pHeader;
+    memcpy(s_aLastTxData, aData, sizeof(s_aLastTxData));
+    *pTxMailbox = CAN_TX_MAILBOX0;
+    s_iAddTxCount++;
+    return HAL_OK;
+}
+
+/**
+ * @brief Allocate and start CAN1 with the RTR test stubs installed.
+ */
+static BspCanHandle_t sStartWithRtrStubs(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    BspCanStart(hCan);
+
+    memset(&s_tStubRxHeader, 0, sizeof(s_tStubRxHeader));
+    memset(&s_tLastTxHeader, 0, sizeof(s_tLastTxHeader));
+    memset(s_aLastTxData, 0, sizeof(s_aLastTxData));
+    s_iAddTxCount = 0;
+
+    HAL_CAN_GetRxMessage_StubWithCallback(sStubGetRxMessage);
+    HAL_CAN_AddTxMessage_StubWithCallback(sStubAddTxMessage);
+
+    return hCan;
+}
+
+void test_BspCanRegisterRtrResponder_InvalidHandle_ReturnsError(void)
+{
+    BspCanError_e eError = BspCanRegisterRtrResponder(0, 0x100, eBSP_CAN_ID_STANDARD, 0, 0x1);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_HANDLE, eError);
+}
+
+void test_BspCanRegisterRtrResponder_InvalidPriority_ReturnsError(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    BspCanError_e eError = BspCanRegisterRtrResponder(hCan, 0x100, eBSP_CAN_ID_STANDARD, BSP_CAN_PRIORITY_LEVELS, 0x1);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, eError);
+}
+
+void test_BspCanRegisterRtrResponder_TableFull_ReturnsNoResource(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    for (uint32_t i = 0; i < BSP_CAN_MAX_RTR_RESPONDERS; i++)
+    {
+        TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanRegisterRtrResponder(hCan, 0x100 + i, eBSP_CAN_ID_STANDARD, 0, i));
+    }
+
+    /* Re-registering a known ID only updates it */
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanRegisterRtrResponder(hCan, 0x100, eBSP_CAN_ID_STANDARD, 3, 0x77));
+
+    BspCanError_e eError = BspCanRegisterRtrResponder(hCan, 0x200, eBSP_CAN_ID_STANDARD, 0, 0x1);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NO_RESOURCE, eError);
+}
+
+void test_BspCanUpdateRtrPayload_InvalidParams_ReturnsError(void)
+{
+    BspCanConfig_t tConfig  = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan     = BspCanAllocate(&tConfig, NULL, NULL);
+    uint8_t        aData[9] = {0};
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_HANDLE, BspCanUpdateRtrPayload(1, 0x100, eBSP_CAN_ID_STANDARD, aData, 1));
+
+    /* Unknown responder */
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanUpdateRtrPayload(hCan, 0x100, eBSP_CAN_ID_STANDARD, aData, 1));
+
+    BspCanRegisterRtrResponder(hCan, 0x100, eBSP_CAN_ID_STANDARD, 0, 0x1);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanUpdateRtrPayload(hCan, 0x100, eBSP_CAN_ID_STANDARD, aData, 9));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanUpdateRtrPayload(hCan, 0x100, eBSP_CAN_ID_STANDARD, NULL, 1));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanUpdateRtrPayload(hCan, 0x100, eBSP_CAN_ID_STANDARD, NULL, 0));
+}
+
+/**
+ * @brief Matching remote frame is answered from the ISR with the current payload.
+ */
+void test_HAL_CAN_RxFifo0MsgPendingCallback_RtrResponder_RepliesWithPayload(void)
+{
+    BspCanHandle_t hCan     = sStartWithRtrStubs();
+    uint8_t        aData[4] = {0xDE, 0xAD, 0xBE, 0xEF};
+
+    BspCanRegisterRxCallback(hCan, sTestRxCallback);
+    BspCanRegisterTxCallback(hCan, sTestTxCallback);
+    BspCanRegisterRtrResponder(hCan, 0x321, eBSP_CAN_ID_STANDARD, 2, 0xCAFE);
+    BspCanUpdateRtrPayload(hCan, 0x321, eBSP_CAN_ID_STANDARD, aData, sizeof(aData));
+
+    s_tStubRxHeader.StdId = 0x321;
+    s_tStubRxHeader.IDE   = CAN_ID_STD;
+    s_tStubRxHeader.RTR   = CAN_RTR_REMOTE;
+    s_tStubRxHeader.DLC   = 4;
+
+    HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 3);
+
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    TEST_ASSERT_EQUAL(1, s_iAddTxCount);
+    TEST_ASSERT_EQUAL_HEX32(0x321, s_tLastTxHeader.StdId);
+    TEST_ASSERT_EQUAL(CAN_ID_STD, s_tLastTxHeader.IDE);
+    TEST_ASSERT_EQUAL(CAN_RTR_DATA, s_tLastTxHeader.RTR);
+    TEST_ASSERT_EQUAL(4, s_tLastTxHeader.DLC);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(aData, s_aLastTxData, sizeof(aData));
+
+    /* Remote frame is still reported to the application */
+    TEST_ASSERT_TRUE(s_bRxCallbackInvoked);
+    TEST_ASSERT_EQUAL(eBSP_CAN_FRAME_REMOTE, s_tLastRxMessage.eFrameType);
+
+    /* Completion reports the responder's TX ID */
+    HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 3);
+    HAL_CAN_TxMailbox0CompleteCallback(&hcan1);
+    TEST_ASSERT_EQUAL_HEX32(0xCAFE, s_uLastTxId);
+
+    BspCanStatistics_t tStats = {0};
+    BspCanGetStatistics(hCan, &tStats);
+    TEST_ASSERT_EQUAL(1, tStats.uRtrReplies);
+}
+
+/**
+ * @brief Latest published payload buffer is used for the reply.
+ */
+void test_HAL_CAN_RxFifo1MsgPendingCallback_RtrResponder_ExtendedId_UsesLatestPayload(void)
+{
+    BspCanHandle_t hCan      = sStartWithRtrStubs();
+    uint8_t        aFirst[2] = {0x11, 0x22};
+    uint8_t        aLast[8]  = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    BspCanRegisterRtrResponder(hCan, 0x18FF0001, eBSP_CAN_ID_EXTENDED, 0, 0x1);
+    BspCanUpdateRtrPayload(hCan, 0x18FF0001, eBSP_CAN_ID_EXTENDED, aFirst, sizeof(aFirst));
+    BspCanUpdateRtrPayload(hCan, 0x18FF0001, eBSP_CAN_ID_EXTENDED, aLast, sizeof(aLast));
+
+    s_tStubRxHeader.ExtId = 0x18FF0001;
+    s_tStubRxHeader.IDE   = CAN_ID_EXT;
+    s_tStubRxHeader.RTR   = CAN_RTR_REMOTE;
+
+    HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 1);
+
+    HAL_CAN_RxFifo1MsgPendingCallback(&hcan1);
+
+    TEST_ASSERT_EQUAL(1, s_iAddTxCount);
+    TEST_ASSERT_EQUAL_HEX32(0x18FF0001, s_tLastTxHeader.ExtId);
+    TEST_ASSERT_EQUAL(CAN_ID_EXT, s_tLastTxHeader.IDE);
+    TEST_ASSERT_EQUAL(8, s_tLastTxHeader.DLC);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(aLast, s_aLastTxData, sizeof(aLast));
+}
+
+/**
+ * @brief Responder without a published payload does not reply.
+ */
+void test_HAL_CAN_RxFifo0MsgPendingCallback_RtrResponder_NoPayload_NoReply(void)
+{
+    BspCanHandle_t hCan = sStartWithRtrStubs();
+
+    BspCanRegisterRtrResponder(hCan, 0x321, eBSP_CAN_ID_STANDARD, 0, 0x1);
+
+    s_tStubRxHeader.StdId = 0x321;
+    s_tStubRxHeader.IDE   = CAN_ID_STD;
+    s_tStubRxHeader.RTR   = CAN_RTR_REMOTE;
+
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    TEST_ASSERT_EQUAL(0, s_iAddTxCount);
+}
+
+/**
+ * @brief Unmatched IDs, ID type mismatches and data frames are not answered.
+ */
+void test_HAL_CAN_RxFifo0MsgPendingCallback_RtrResponder_NoMatch_NoReply(void)
+{
+    BspCanHandle_t hCan     = sStartWithRtrStubs();
+    uint8_t        aData[1] = {0x55};
+
+    BspCanRegisterRtrResponder(hCan, 0x321, eBSP_CAN_ID_STANDARD, 0, 0x1);
+    BspCanUpdateRtrPayload(hCan, 0x321, eBSP_CAN_ID_STANDARD, aData, sizeof(aData));
+
+    /* Different ID */
+    s_tStubRxHeader.StdId = 0x322;
+    s_tStubRxHeader.IDE   = CAN_ID_STD;
+    s_tStubRxHeader.RTR   = CAN_RTR_REMOTE;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    /* Same numeric ID but extended */
+    s_tStubRxHeader.ExtId = 0x321;
+    s_tStubRxHeader.IDE   = CAN_ID_EXT;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    /* Data frame with the responder ID */
+    s_tStubRxHeader.StdId = 0x321;
+    s_tStubRxHeader.IDE   = CAN_ID_STD;
+    s_tStubRxHeader.RTR   = CAN_RTR_DATA;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    TEST_ASSERT_EQUAL(0, s_iAddTxCount);
+}
+
+/**
+ * @brief Removed responder no longer answers; other entries keep working.
+ */
+void test_BspCanRemoveRtrResponder_StopsReplies(void)
+{
+    BspCanHandle_t hCan     = sStartWithRtrStubs();
+    uint8_t        aData[1] = {0x55};
+
+    BspCanRegisterRtrResponder(hCan, 0x100, eBSP_CAN_ID_STANDARD, 0, 0x1);
+    BspCanRegisterRtrResponder(hCan, 0x200, eBSP_CAN_ID_STANDARD, 0, 0x2);
+    BspCanUpdateRtrPayload(hCan, 0x100, eBSP_CAN_ID_STANDARD, aData, sizeof(aData));
+    BspCanUpdateRtrPayload(hCan, 0x200, eBSP_CAN_ID_STANDARD, aData, sizeof(aData));
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanRemoveRtrResponder(hCan, 0x100, eBSP_CAN_ID_STANDARD));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanRemoveRtrResponder(hCan, 0x100, eBSP_CAN_ID_STANDARD));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_HANDLE, BspCanRemoveRtrResponder(1, 0x100, eBSP_CAN_ID_STANDARD));
+
+    s_tStubRxHeader.StdId = 0x100;
+    s_tStubRxHeader.IDE   = CAN_ID_STD;
+    s_tStubRxHeader.RTR   = CAN_RTR_REMOTE;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+    TEST_ASSERT_EQUAL(0, s_iAddTxCount);
+
+    s_tStubRxHeader.StdId = 0x200;
+    HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 1);
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+    TEST_ASSERT_EQUAL(1, s_iAddTxCount);
+    TEST_ASSERT_EQUAL_HEX32(0x200, s_tLastTxHeader.StdId);
+}
+
+/**
+ * @brief Reply is dropped when the TX queue is full.
+ */
+void test_HAL_CAN_RxFifo0MsgPendingCallback_RtrResponder_QueueFull_NoReply(void)
+{
+    BspCanHandle_t  hCan     = sStartWithRtrStubs();
+    uint8_t         aData[1] = {0x55};
+    BspCanMessage_t tMsg     = {.uId = 0x123, .eIdType = eBSP_CAN_ID_STANDARD, .eFrameType = eBSP_CAN_FRAME_DATA, .byDataLen = 1};
+
+    BspCanRegisterRtrResponder(hCan, 0x321, eBSP_CAN_ID_STANDARD, 0, 0x1);
+    BspCanUpdateRtrPayload(hCan, 0x321, eBSP_CAN_ID_STANDARD, aData, sizeof(aData));
+
+    /* Fill priority 0 with no free mailboxes */
+    for (uint32_t i = 0; i < (BSP_CAN_TX_QUEUE_DEPTH / BSP_CAN_PRIORITY_LEVELS); i++)
+    {
+        HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 0);
+        TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanTransmit(hCan, &tMsg, 0, i));
+    }
+
+    s_tStubRxHeader.StdId = 0x321;
+    s_tStubRxHeader.IDE   = CAN_ID_STD;
+    s_tStubRxHeader.RTR   = CAN_RTR_REMOTE;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    BspCanStatistics_t tStats = {0};
+    BspCanGetStatistics(hCan, &tStats);
+    TEST_ASSERT_EQUAL(0, tStats.uRtrReplies);
+    TEST_ASSERT_EQUAL(0, s_iAddTxCount);
+}
+
+/* ============================================================================
+ * Test Cases - CAN ID Ordered TX Queue
+ * ========================================================================== */
+
+/* IDs passed to HAL_CAN_AddTxMessage, in submission order */
+static uint32_t s_auSubmittedIds[16];
+static uint32_t s_auSubmittedRtr[16];
+static int      s_iSubmittedCount;
+
+static HAL_StatusTypeDef sStubRecordTxOrder(CAN_HandleTypeDef* hcan, CAN_TxHeaderTypeDef* pHeader, uint8_t aData[], uint32_t* pTxMailbox,
+                                            int cmock_num_calls)
+{
+    (void)hcan;
+    (void)aData;
+    (void)cmock_num_calls;
+    if (s_iSubmittedCount < 16)
+    {
+        s_auSubmittedIds[s_iSubmittedCount] = (pHeader->IDE == CAN_ID_STD) ? pHeader->StdId : pHeader->ExtId;
+        s_auSubmittedRtr[s_iSubmittedCount] = pHeader->RTR;
+        s_iSubmittedCount++;
+    }
+    *pTxMailbox = CAN_TX_MAILBOX0;
+    return HAL_OK;
+}
+
+/**
+ * @brief Start CAN1 in CAN ID order mode and install the order recorder.
+ */
+static BspCanHandle_t sStartIdOrdered(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bAutoRetransmit = true, .eTxOrder = eBSP_CAN_TX_ORDER_CAN_ID};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    BspCanStart(hCan);
+
+    s_iSubmittedCount = 0;
+    HAL_CAN_AddTxMessage_StubWithCallback(sStubRecordTxOrder);
+
+    return hCan;
+}
+
+/**
+ * @brief Queue a message while all mailboxes are busy.
+ */
+static void sQueueBlocked(BspCanHandle_t hCan, uint32_t uId, BspCanIdType_e eIdType, BspCanFrameType_e eFrameType, uint8_t byPriority,
+                          uint32_t uTxId)
+{
+    BspCanMessage_t tMsg = {.uId = uId, .eIdType = eIdType, .eFrameType = eFrameType, .byDataLen = 0};
+
+    HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 0);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanTransmit(hCan, &tMsg, byPriority, uTxId));
+}
+
+/**
+ * @brief Drain the queue one mailbox-complete event at a time.
+ */
+static void sDrainQueue(int iCount)
+{
+    for (int i = 0; i < iCount; i++)
+    {
+        HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 1);
+        HAL_CAN_TxMailbox0CompleteCallback(&hcan1);
+    }
+}
+
+/**
+ * @brief Lowest ID is sent first regardless of byPriority.
+ */
+void test_BspCanTransmit_IdOrdered_LowestIdFirst(void)
+{
+    BspCanHandle_t hCan = sStartIdOrdered();
+
+    sQueueBlocked(hCan, 0x500, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 0, 1);
+    sQueueBlocked(hCan, 0x100, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 7, 2);
+    sQueueBlocked(hCan, 0x300, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 3, 3);
+    sQueueBlocked(hCan, 0x001, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 5, 4);
+    sQueueBlocked(hCan, 0x7FF, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 0, 5);
+
+    sDrainQueue(5);
+
+    uint32_t auExpected[5] = {0x001, 0x100, 0x300, 0x500, 0x7FF};
+    TEST_ASSERT_EQUAL(5, s_iSubmittedCount);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(auExpected, s_auSubmittedIds, 5);
+}
+
+/**
+ * @brief Arbitration tie-breaks: standard before extended, data before remote.
+ */
+void test_BspCanTransmit_IdOrdered_ArbitrationFieldOrder(void)
+{
+    BspCanHandle_t hCan = sStartIdOrdered();
+
+    /* Extended frame whose base ID equals standard ID 0x123 */
+    sQueueBlocked(hCan, (0x123u << 18) | 0x1u, eBSP_CAN_ID_EXTENDED, eBSP_CAN_FRAME_DATA, 0, 1);
+    sQueueBlocked(hCan, 0x123, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_REMOTE, 0, 2);
+    sQueueBlocked(hCan, 0x123, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 0, 3);
+    sQueueBlocked(hCan, (0x122u << 18) | 0x3FFFFu, eBSP_CAN_ID_EXTENDED, eBSP_CAN_FRAME_DATA, 0, 4);
+
+    sDrainQueue(4);
+
+    TEST_ASSERT_EQUAL(4, s_iSubmittedCount);
+    TEST_ASSERT_EQUAL_HEX32((0x122u << 18) | 0x3FFFFu, s_auSubmittedIds[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x123, s_auSubmittedIds[1]);
+    TEST_ASSERT_EQUAL(CAN_RTR_DATA, s_auSubmittedRtr[1]);
+    TEST_ASSERT_EQUAL_HEX32(0x123, s_auSubmittedIds[2]);
+    TEST_ASSERT_EQUAL(CAN_RTR_REMOTE, s_auSubmittedRtr[2]);
+    TEST_ASSERT_EQUAL_HEX32((0x123u << 18) | 0x1u, s_auSubmittedIds[3]);
+}
+
+/**
+ * @brief Frames with the same ID keep their enqueue order.
+ */
+void test_BspCanTransmit_IdOrdered_SameIdFifo(void)
+{
+    BspCanHandle_t hCan = sStartIdOrdered();
+    BspCanRegisterTxCallback(hCan, sTestTxCallback);
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        sQueueBlocked(hCan, 0x200, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, (uint8_t)(7 - i), 0x100 + i);
+    }
+
+    /* Each completion reports the frame submitted by the previous one */
+    sDrainQueue(1);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        sDrainQueue(1);
+        TEST_ASSERT_EQUAL_HEX32(0x100 + i, s_uLastTxId);
+    }
+
+    TEST_ASSERT_EQUAL(6, s_iSubmittedCount);
+}
+
+/**
+ * @brief Abort removes an entry from the middle of the heap.
+ */
+void test_BspCanAbortTransmit_IdOrdered_RemovesFromHeap(void)
+{
+    BspCanHandle_t hCan = sStartIdOrdered();
+
+    sQueueBlocked(hCan, 0x400, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 0, 1);
+    sQueueBlocked(hCan, 0x200, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 0, 2);
+    sQueueBlocked(hCan, 0x300, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 0, 3);
+    sQueueBlocked(hCan, 0x100, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 0, 4);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanAbortTransmit(hCan, 2));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanAbortTransmit(hCan, 2));
+
+    uint8_t byUsed = 0;
+    BspCanGetTxQueueInfo(hCan, &byUsed, NULL);
+    TEST_ASSERT_EQUAL(3, byUsed);
+
+    sDrainQueue(3);
+
+    uint32_t auExpected[3] = {0x100, 0x300, 0x400};
+    TEST_ASSERT_EQUAL(3, s_iSubmittedCount);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(auExpected, s_auSubmittedIds, 3);
+}
+
+/**
+ * @brief In CAN ID mode the whole pool is usable from a single priority.
+ */
+void test_BspCanTransmit_IdOrdered_UsesWholePool(void)
+{
+    BspCanHandle_t hCan = sStartIdOrdered();
+
+    for (uint32_t i = 0; i < BSP_CAN_TX_QUEUE_DEPTH; i++)
+    {
+        sQueueBlocked(hCan, 0x700 - i, eBSP_CAN_ID_STANDARD, eBSP_CAN_FRAME_DATA, 0, i);
+    }
+
+    BspCanMessage_t tMsg = {.uId = 0x1, .eIdType = eBSP_CAN_ID_STANDARD, .eFrameType = eBSP_CAN_FRAME_DATA, .byDataLen = 0};
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_TX_QUEUE_FULL, BspCanTransmit(hCan, &tMsg, 0, 0xFFFF));
+
+    sDrainQueue(1);
+    TEST_ASSERT_EQUAL_HEX32(0x700 - (BSP_CAN_TX_QUEUE_DEPTH - 1u), s_auSubmittedIds[0]);
+}
+
+/* ============================================================================
+ * Test Cases - Bus Monitor
+ * ========================================================================== */
+
+/* Filters passed to HAL_CAN_ConfigFilter since BspCanStartMonitor */
+static CAN_FilterTypeDef s_atMonFilters[8];
+static int               s_iMonFilterCount;
+
+/* Payload copied out by the monitor GetRxMessage stub */
+static uint8_t s_aMonStubData[8];
+
+static HAL_StatusTypeDef sStubConfigFilter(CAN_HandleTypeDef* hcan, CAN_FilterTypeDef* pFilter, int cmock_num_calls)
+{
+    (void)hcan;
+    (void)cmock_num_calls;
+    if (s_iMonFilterCount < 8)
+    {
+        s_atMonFilters[s_iMonFilterCount] = *pFilter;
+    }
+    s_iMonFilterCount++;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef sStubMonitorGetRxMessage(CAN_HandleTypeDef* hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef* pHeader, uint8_t aData[],
+                                                  int cmock_num_calls)
+{
+    (void)hcan;
+    (void)RxFifo;
+    (void)cmock_num_calls;
+    *pHeader = s_tStubRxHeader;
+    memcpy(aData, s_aMonStubData, sizeof(s_aMonStubData));
+    return HAL_OK;
+}
+
+/**
+ * @brief Allocate CAN1 and start monitor capture into the given ring.
+ */
+static BspCanHandle_t sStartMonitor(BspCanMonitorRecord_t* pRing, uint32_t uDepth)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    s_iMonFilterCount = 0;
+    memset(&s_tStubRxHeader, 0, sizeof(s_tStubRxHeader));
+    memset(s_aMonStubData, 0, sizeof(s_aMonStubData));
+
+    HAL_CAN_ConfigFilter_StubWithCallback(sStubConfigFilter);
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_ExpectAndReturn(&hcan1,
+                                                 CAN_IT_RX_FIFO0_MSG_PENDING | CAN_IT_RX_FIFO1_MSG_PENDING | CAN_IT_RX_FIFO0_OVERRUN |
+                                                     CAN_IT_RX_FIFO1_OVERRUN | CAN_IT_ERROR,
+                                                 HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanStartMonitor(hCan, pRing, uDepth));
+
+    HAL_CAN_GetRxMessage_StubWithCallback(sStubMonitorGetRxMessage);
+
+    return hCan;
+}
+
+void test_BspCanStartMonitor_InvalidParams_ReturnsError(void)
+{
+    BspCanMonitorRecord_t aRing[8];
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_HANDLE, BspCanStartMonitor(0, aRing, 8));
+
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanStartMonitor(hCan, NULL, 8));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanStartMonitor(hCan, aRing, 0));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanStartMonitor(hCan, aRing, 6));
+    TEST_ASSERT_EQUAL_HEX32(0u, s_tCan1Instance.BTR);
+}
+
+void test_BspCanStartMonitor_SilentModeAndSplitFilters(void)
+{
+    BspCanMonitorRecord_t aRing[8];
+
+    s_tCan1Instance.BTR = 0x001C0003u;
+    BspCanHandle_t hCan = sStartMonitor(aRing, 8);
+
+    TEST_ASSERT_EQUAL_HEX32(0x001C0003u | CAN_BTR_SILM, s_tCan1Instance.BTR);
+    TEST_ASSERT_EQUAL(2, s_iMonFilterCount);
+    TEST_ASSERT_EQUAL(0u, s_atMonFilters[0].FilterBank);
+    TEST_ASSERT_EQUAL(CAN_FILTER_FIFO0, s_atMonFilters[0].FilterFIFOAssignment);
+    TEST_ASSERT_EQUAL_HEX32(0x0000u, s_atMonFilters[0].FilterIdHigh);
+    TEST_ASSERT_EQUAL_HEX32(0x0020u, s_atMonFilters[0].FilterMaskIdHigh);
+    TEST_ASSERT_EQUAL(1u, s_atMonFilters[1].FilterBank);
+    TEST_ASSERT_EQUAL(CAN_FILTER_FIFO1, s_atMonFilters[1].FilterFIFOAssignment);
+    TEST_ASSERT_EQUAL_HEX32(0x0020u, s_atMonFilters[1].FilterIdHigh);
+    TEST_ASSERT_EQUAL_HEX32(0x0020u, s_atMonFilters[1].FilterMaskIdHigh);
+
+    /* Already running */
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_ALREADY_STARTED, BspCanStartMonitor(hCan, aRing, 8));
+
+    /* Stop restores the original bit timing register */
+    HAL_CAN_DeactivateNotification_IgnoreAndReturn(HAL_OK);
+    HAL_CAN_Stop_ExpectAndReturn(&hcan1, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanStop(hCan));
+    TEST_ASSERT_EQUAL_HEX32(0x001C0003u, s_tCan1Instance.BTR);
+}
+
+void test_HAL_CAN_RxFifoMsgPendingCallback_Monitor_WritesRecords(void)
+{
+    BspCanMonitorRecord_t aRing[8];
+    BspCanHandle_t        hCan = sStartMonitor(aRing, 8);
+
+    BspCanRegisterRxCallback(hCan, sTestRxCallback);
+
+    s_tStubRxHeader.StdId = 0x123;
+    s_tStubRxHeader.IDE   = CAN_ID_STD;
+    s_tStubRxHeader.RTR   = CAN_RTR_DATA;
+    s_tStubRxHeader.DLC   = 3;
+    s_aMonStubData[0]     = 0xAA;
+    s_aMonStubData[1]     = 0xBB;
+    s_aMonStubData[2]     = 0xCC;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    s_tStubRxHeader.ExtId = 0x1ABCDEF;
+    s_tStubRxHeader.IDE   = CAN_ID_EXT;
+    s_tStubRxHeader.RTR   = CAN_RTR_REMOTE;
+    s_tStubRxHeader.DLC   = 0;
+    HAL_CAN_RxFifo1MsgPendingCallback(&hcan1);
+
+    /* Monitor capture bypasses the RX callback */
+    TEST_ASSERT_FALSE(s_bRxCallbackInvoked);
+
+    const BspCanMonitorRecord_t* pBlock = NULL;
+    uint32_t                     uCount = 0;
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanMonitorGetBlock(hCan, &pBlock, &uCount));
+    TEST_ASSERT_EQUAL_UINT32(2u, uCount);
+    TEST_ASSERT_EQUAL_PTR(&aRing[0], pBlock);
+
+    TEST_ASSERT_EQUAL_HEX32(0x123u, pBlock[0].uId);
+    TEST_ASSERT_EQUAL_UINT8(3u, pBlock[0].byDlc);
+    TEST_ASSERT_EQUAL_HEX8(0u, pBlock[0].byFlags);
+    TEST_ASSERT_EQUAL_HEX8(0xCC, pBlock[0].aData[2]);
+
+    TEST_ASSERT_EQUAL_HEX32(0x1ABCDEFu, pBlock[1].uId);
+    TEST_ASSERT_EQUAL_HEX8(BSP_CAN_MON_FLAG_EXT | BSP_CAN_MON_FLAG_RTR | BSP_CAN_MON_FLAG_FIFO1, pBlock[1].byFlags);
+    TEST_ASSERT_TRUE(pBlock[1].uTimestamp > pBlock[0].uTimestamp);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanMonitorReleaseBlock(hCan, uCount));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanMonitorGetBlock(hCan, &pBlock, &uCount));
+    TEST_ASSERT_EQUAL_UINT32(0u, uCount);
+    TEST_ASSERT_NULL(pBlock);
+}
+
+void test_BspCanMonitorGetBlock_Wrapped_ReturnsTwoBlocks(void)
+{
+    BspCanMonitorRecord_t aRing[4];
+    BspCanHandle_t        hCan = sStartMonitor(aRing, 4);
+
+    const BspCanMonitorRecord_t* pBlock = NULL;
+    uint32_t                     uCount = 0;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        s_tStubRxHeader.StdId = i;
+        HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+    }
+    BspCanMonitorGetBlock(hCan, &pBlock, &uCount);
+    BspCanMonitorReleaseBlock(hCan, uCount);
+
+    /* Next three records occupy slots 3, 0, 1 */
+    for (uint32_t i = 3; i < 6; i++)
+    {
+        s_tStubRxHeader.StdId = i;
+        HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+    }
+
+    BspCanMonitorGetBlock(hCan, &pBlock, &uCount);
+    TEST_ASSERT_EQUAL_UINT32(1u, uCount);
+    TEST_ASSERT_EQUAL_PTR(&aRing[3], pBlock);
+    TEST_ASSERT_EQUAL_UINT32(3u, pBlock[0].uId);
+    BspCanMonitorReleaseBlock(hCan, uCount);
+
+    BspCanMonitorGetBlock(hCan, &pBlock, &uCount);
+    TEST_ASSERT_EQUAL_UINT32(2u, uCount);
+    TEST_ASSERT_EQUAL_PTR(&aRing[0], pBlock);
+    TEST_ASSERT_EQUAL_UINT32(4u, pBlock[0].uId);
+    TEST_ASSERT_EQUAL_UINT32(5u, pBlock[1].uId);
+}
+
+void test_BspCanMonitorReleaseBlock_InvalidParams_ReturnsError(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    const BspCanMonitorRecord_t* pBlock = NULL;
+    uint32_t                     uCount = 0;
+
+    /* Monitor never started */
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanMonitorGetBlock(hCan, &pBlock, &uCount));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanMonitorReleaseBlock(hCan, 0));
+    BspCanFree(hCan);
+
+    BspCanMonitorRecord_t aRing[4];
+    hCan = sStartMonitor(aRing, 4);
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanMonitorGetBlock(hCan, NULL, &uCount));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanMonitorReleaseBlock(hCan, 2));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanMonitorReleaseBlock(hCan, 1));
+}
+
+void test_HAL_CAN_RxFifoMsgPendingCallback_Monitor_RingFull_CountsDrops(void)
+{
+    BspCanMonitorRecord_t aRing[4];
+    BspCanHandle_t        hCan = sStartMonitor(aRing, 4);
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        s_tStubRxHeader.StdId = i;
+        HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+    }
+
+    BspCanMonitorStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanGetMonitorStats(hCan, &tStats));
+    TEST_ASSERT_EQUAL_UINT32(4u, tStats.uCaptured);
+    TEST_ASSERT_EQUAL_UINT32(6u, tStats.uDropped);
+    TEST_ASSERT_EQUAL_UINT32(4u, tStats.uHighWater);
+
+    /* Oldest frames are kept; the hardware FIFO was drained for every frame */
+    TEST_ASSERT_EQUAL_UINT32(0u, aRing[0].uId);
+    TEST_ASSERT_EQUAL_UINT32(3u, aRing[3].uId);
+}
+
+void test_HAL_CAN_RxFifoMsgPendingCallback_Monitor_ReportsFrameRate(void)
+{
+    BspCanMonitorRecord_t aRing[4];
+    BspCanHandle_t        hCan = sStartMonitor(aRing, 4);
+
+    /* The HAL_GetTick stub advances 1 ms per call, i.e. one frame per ms */
+    for (uint32_t i = 0; i < 1500; i++)
+    {
+        HAL_CAN_RxFifo1MsgPendingCallback(&hcan1);
+    }
+
+    BspCanMonitorStats_t tStats;
+    BspCanGetMonitorStats(hCan, &tStats);
+    TEST_ASSERT_UINT32_WITHIN(2u, 1000u, tStats.uFramesPerSecond);
+    TEST_ASSERT_EQUAL_UINT32(1500u, tStats.uCaptured + tStats.uDropped);
+}
+
+void test_BspCanGetMonitorStats_IdleBus_ReportsZeroRate(void)
+{
+    BspCanMonitorRecord_t aRing[4];
+    BspCanHandle_t        hCan = sStartMonitor(aRing, 4);
+    BspCanMonitorStats_t  tStats;
+
+    for (uint32_t i = 0; i < 1500; i++)
+    {
+        HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+    }
+
+    /* Bus goes quiet in the second window: it still closes with its own count */
+    s_uFakeTick += 600u;
+    BspCanGetMonitorStats(hCan, &tStats);
+    TEST_ASSERT_UINT32_WITHIN(2u, 500u, tStats.uFramesPerSecond);
+
+    /* A whole silent window later no frame has arrived to close it */
+    s_uFakeTick += 1000u;
+    BspCanGetMonitorStats(hCan, &tStats);
+    TEST_ASSERT_EQUAL_UINT32(0u, tStats.uFramesPerSecond);
+}
+
+/* HAL error code of hcan1: HAL ORs new errors in until HAL_CAN_ResetError() */
+static uint32_t s_uHalErrorCode;
+
+static uint32_t sStubGetError(CAN_HandleTypeDef* hcan, int cmock_num_calls)
+{
+    (void)hcan;
+    (void)cmock_num_calls;
+    return s_uHalErrorCode;
+}
+
+static HAL_StatusTypeDef sStubResetError(CAN_HandleTypeDef* hcan, int cmock_num_calls)
+{
+    (void)hcan;
+    (void)cmock_num_calls;
+    s_uHalErrorCode = HAL_CAN_ERROR_NONE;
+    return HAL_OK;
+}
+
+void test_HAL_CAN_ErrorCallback_Monitor_CountsHardwareOverruns(void)
+{
+    BspCanMonitorRecord_t aRing[4];
+    BspCanHandle_t        hCan = sStartMonitor(aRing, 4);
+
+    s_uHalErrorCode = HAL_CAN_ERROR_NONE;
+    HAL_CAN_GetError_StubWithCallback(sStubGetError);
+    HAL_CAN_ResetError_StubWithCallback(sStubResetError);
+
+    s_uHalErrorCode |= HAL_CAN_ERROR_RX_FOV0;
+    HAL_CAN_ErrorCallback(&hcan1);
+    s_uHalErrorCode |= HAL_CAN_ERROR_RX_FOV1 | HAL_CAN_ERROR_STF;
+    HAL_CAN_ErrorCallback(&hcan1);
+
+    /* Stuff errors alone must not count the overruns reported earlier again */
+    s_uHalErrorCode |= HAL_CAN_ERROR_STF;
+    HAL_CAN_ErrorCallback(&hcan1);
+    s_uHalErrorCode |= HAL_CAN_ERROR_STF;
+    HAL_CAN_ErrorCallback(&hcan1);
+
+    BspCanMonitorStats_t tStats;
+    BspCanGetMonitorStats(hCan, &tStats);
+    TEST_ASSERT_EQUAL_UINT32(2u, tStats.uHwOverruns);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanGetMonitorStats(hCan, NULL));
+}
+
+void test_BspCanStop_Monitor_ResumesNormalRxPath(void)
+{
+    BspCanMonitorRecord_t aRing[4];
+    BspCanHandle_t        hCan = sStartMonitor(aRing, 4);
+
+    HAL_CAN_DeactivateNotification_IgnoreAndReturn(HAL_OK);
+    HAL_CAN_Stop_ExpectAndReturn(&hcan1, HAL_OK);
+    BspCanStop(hCan);
+
+    /* Both accept-all banks are deactivated */
+    TEST_ASSERT_EQUAL(4, s_iMonFilterCount);
+    TEST_ASSERT_EQUAL(0u, s_atMonFilters[2].FilterBank);
+    TEST_ASSERT_EQUAL(CAN_FILTER_DISABLE, s_atMonFilters[2].FilterActivation);
+    TEST_ASSERT_EQUAL(1u, s_atMonFilters[3].FilterBank);
+    TEST_ASSERT_EQUAL(CAN_FILTER_DISABLE, s_atMonFilters[3].FilterActivation);
+
+    BspCanRegisterRxCallback(hCan, sTestRxCallback);
+    s_tStubRxHeader.StdId = 0x321;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    TEST_ASSERT_TRUE(s_bRxCallbackInvoked);
+    TEST_ASSERT_EQUAL_HEX32(0x321u, s_tLastRxMessage.uId);
+
+    BspCanMonitorStats_t tStats;
+    BspCanGetMonitorStats(hCan, &tStats);
+    TEST_ASSERT_EQUAL_UINT32(0u, tStats.uCaptured);
+}
+
+void test_BspCanStart_AfterMonitor_OnlyOwnFiltersAccept(void)
+{
+    BspCanMonitorRecord_t aRing[4];
+    BspCanHandle_t        hCan = sStartMonitor(aRing, 4);
+
+    HAL_CAN_DeactivateNotification_IgnoreAndReturn(HAL_OK);
+    HAL_CAN_Stop_ExpectAndReturn(&hcan1, HAL_OK);
+    BspCanStop(hCan);
+
+    /* Normal start with a single filter programs bank 0 only */
+    BspCanFilter_t tFilter = {.uFilterId = 0x100, .uFilterMask = 0x7F0, .eIdType = eBSP_CAN_ID_STANDARD, .byFifoAssignment = 0};
+    BspCanAddFilter(hCan, &tFilter);
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanStart(hCan));
+
+    /* Monitor banks 0 and 1, their release, then the application filter in bank 0 */
+    TEST_ASSERT_EQUAL(5, s_iMonFilterCount);
+    TEST_ASSERT_EQUAL(0u, s_atMonFilters[4].FilterBank);
+    TEST_ASSERT_EQUAL(CAN_FILTER_ENABLE, s_atMonFilters[4].FilterActivation);
+    TEST_ASSERT_EQUAL_HEX32(0x100u << 5u, s_atMonFilters[4].FilterIdHigh);
+
+    /* Bank 1 was last written as inactive: it no longer accepts all traffic */
+    TEST_ASSERT_EQUAL(1u, s_atMonFilters[3].FilterBank);
+    TEST_ASSERT_EQUAL(CAN_FILTER_DISABLE, s_atMonFilters[3].FilterActivation);
+}
+
+/* ============================================================================
+ * Test Cases - Bit Timing and Autobaud
+ * ========================================================================== */
+
+#define TEST_CAN_APB1_HZ (42000000u)
+
+/* Bitrate of the simulated bus seen by the HAL_CAN_Start stub (0 = silent bus) */
+static uint32_t s_uSimBusBitrate;
+static int      s_iStartCount;
+
+/* Silent bus on which LEC reads 0 after the start, as if nothing had been written to it */
+static bool s_bSimLecCleared;
+
+/**
+ * @brief HAL_CAN_Start stub: decode BTR and report the LEC and FIFO state a real controller would latch.
+ */
+static HAL_StatusTypeDef sStubStartSimulatedBus(CAN_HandleTypeDef* hcan, int cmock_num_calls)
+{
+    (void)cmock_num_calls;
+    s_iStartCount++;
+
+    uint32_t uBtr     = hcan->Instance->BTR;
+    uint32_t uQuanta  = 1u + (((uBtr & CAN_BTR_TS1) >> CAN_BTR_TS1_Pos) + 1u) + (((uBtr & CAN_BTR_TS2) >> CAN_BTR_TS2_Pos) + 1u);
+    uint32_t uBitrate = TEST_CAN_APB1_HZ / (((uBtr & CAN_BTR_BRP) + 1u) * uQuanta);
+
+    TEST_ASSERT_TRUE((uBtr & CAN_BTR_SILM) != 0u);
+
+    if (s_uSimBusBitrate != 0u)
+    {
+        bool     bMatch      = (uBitrate == s_uSimBusBitrate);
+        uint32_t uLec        = bMatch ? 0u : 1u; /* 0 = no error, 1 = stuff error */
+        hcan->Instance->ESR  = (hcan->Instance->ESR & ~CAN_ESR_LEC) | (uLec << CAN_ESR_LEC_Pos);
+        hcan->Instance->RF1R = bMatch ? 2u : 0u; /* Two frames passed the accept-all filter */
+    }
+    else if (s_bSimLecCleared)
+    {
+        hcan->Instance->ESR &= ~CAN_ESR_LEC;
+    }
+    return HAL_OK;
+}
+
+static void sSetupAutoBaud(uint32_t uBusBitrate)
+{
+    s_uSimBusBitrate     = uBusBitrate;
+    s_bSimLecCleared     = false;
+    s_iStartCount        = 0;
+    s_iMonFilterCount    = 0;
+    s_tCan1Instance.RF0R = 0u;
+    s_tCan1Instance.RF1R = 0u;
+    HAL_RCC_GetPCLK1Freq_IgnoreAndReturn(TEST_CAN_APB1_HZ);
+    HAL_CAN_ConfigFilter_StubWithCallback(sStubConfigFilter);
+    HAL_CAN_Start_StubWithCallback(sStubStartSimulatedBus);
+    HAL_CAN_Stop_IgnoreAndReturn(HAL_OK);
+}
+
+void test_BspCanCalcBitTiming_500k_DefaultSamplePoint(void)
+{
+    BspCanBitTiming_t tTiming = {0};
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 500000u, 0u, &tTiming));
+
+    /* 14 quanta: 1 + 11 + 2, sample point 12/14 */
+    TEST_ASSERT_EQUAL_UINT16(6u, tTiming.wPrescaler);
+    TEST_ASSERT_EQUAL_UINT8(11u, tTiming.byBs1);
+    TEST_ASSERT_EQUAL_UINT8(2u, tTiming.byBs2);
+    TEST_ASSERT_EQUAL_UINT8(2u, tTiming.bySjw);
+    TEST_ASSERT_EQUAL_UINT16(857u, tTiming.wSamplePoint);
+}
+
+void test_BspCanCalcBitTiming_125k_ExactSamplePoint_PrefersMoreQuanta(void)
+{
+    BspCanBitTiming_t tTiming = {0};
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 125000u, 875u, &tTiming));
+
+    /* Both 16 and 8 quanta hit 87.5% exactly: 16 quanta wins */
+    TEST_ASSERT_EQUAL_UINT16(21u, tTiming.wPrescaler);
+    TEST_ASSERT_EQUAL_UINT8(13u, tTiming.byBs1);
+    TEST_ASSERT_EQUAL_UINT8(2u, tTiming.byBs2);
+    TEST_ASSERT_EQUAL_UINT16(875u, tTiming.wSamplePoint);
+}
+
+void test_BspCanCalcBitTiming_CustomSamplePoint(void)
+{
+    BspCanBitTiming_t tTiming = {0};
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 500000u, 750u, &tTiming));
+
+    TEST_ASSERT_EQUAL_UINT16(7u, tTiming.wPrescaler);
+    TEST_ASSERT_EQUAL_UINT8(8u, tTiming.byBs1);
+    TEST_ASSERT_EQUAL_UINT8(3u, tTiming.byBs2);
+    TEST_ASSERT_EQUAL_UINT8(3u, tTiming.bySjw);
+    TEST_ASSERT_EQUAL_UINT16(750u, tTiming.wSamplePoint);
+}
+
+void test_BspCanCalcBitTiming_InvalidParams_ReturnsError(void)
+{
+    BspCanBitTiming_t tTiming = {0};
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 500000u, 0u, NULL));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 0u, 0u, &tTiming));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 500000u, 1001u, &tTiming));
+
+    /* No exact prescaler for 333.333 kbit/s from 42 MHz with 8-25 quanta */
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 333333u, 0u, &tTiming));
+
+    /* Prescaler would exceed 1024 */
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 1000u, 0u, &tTiming));
+}
+
+void test_BspCanSetBitrate_WritesBtrAndKeepsModeBits(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    s_tCan1Instance.BTR = CAN_BTR_SILM | 0x001C0003u;
+    HAL_RCC_GetPCLK1Freq_ExpectAndReturn(TEST_CAN_APB1_HZ);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanSetBitrate(hCan, 500000u, 0u));
+
+    uint32_t uExpected = CAN_BTR_SILM | (6u - 1u) | ((11u - 1u) << CAN_BTR_TS1_Pos) | ((2u - 1u) << CAN_BTR_TS2_Pos) | ((2u - 1u) << CAN_BTR_SJW_Pos);
+    TEST_ASSERT_EQUAL_HEX32(uExpected, s_tCan1Instance.BTR);
+}
+
+void test_BspCanSetBitrate_InvalidStates_ReturnError(void)
+{
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_HANDLE, BspCanSetBitrate(0, 500000u, 0u));
+
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    /* Unreachable bitrate leaves BTR untouched */
+    s_tCan1Instance.BTR = 0x001C0003u;
+    HAL_RCC_GetPCLK1Freq_ExpectAndReturn(TEST_CAN_APB1_HZ);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanSetBitrate(hCan, 333333u, 0u));
+    TEST_ASSERT_EQUAL_HEX32(0x001C0003u, s_tCan1Instance.BTR);
+
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    BspCanStart(hCan);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_ALREADY_STARTED, BspCanSetBitrate(hCan, 500000u, 0u));
+}
+
+void test_BspCanAutoBaud_DetectsBusBitrate(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    const uint32_t aCandidates[] = {1000000u, 500000u, 250000u, 125000u};
+    uint32_t       uDetected     = 0u;
+
+    sSetupAutoBaud(250000u);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanAutoBaud(hCan, aCandidates, 4u, 10u, &uDetected));
+    TEST_ASSERT_EQUAL_UINT32(250000u, uDetected);
+    TEST_ASSERT_EQUAL(3, s_iStartCount);
+
+    /* Left stopped, programmed for 250 kbit/s, silent mode removed again */
+    BspCanBitTiming_t tTiming = {0};
+    BspCanCalcBitTiming(TEST_CAN_APB1_HZ, 250000u, 0u, &tTiming);
+    TEST_ASSERT_EQUAL_HEX32(0u, s_tCan1Instance.BTR & CAN_BTR_SILM);
+    TEST_ASSERT_EQUAL_UINT32(tTiming.wPrescaler - 1u, s_tCan1Instance.BTR & CAN_BTR_BRP);
+
+    /* Captured frames released, accept-all banks opened then deactivated */
+    TEST_ASSERT_EQUAL_HEX32(0u, s_tCan1Instance.RF1R & CAN_RF1R_FMP1);
+    TEST_ASSERT_EQUAL(4, s_iMonFilterCount);
+    TEST_ASSERT_EQUAL(CAN_FILTER_ENABLE, s_atMonFilters[1].FilterActivation);
+    TEST_ASSERT_EQUAL(CAN_FILTER_DISABLE, s_atMonFilters[2].FilterActivation);
+    TEST_ASSERT_EQUAL(CAN_FILTER_DISABLE, s_atMonFilters[3].FilterActivation);
+}
+
+void test_BspCanAutoBaud_SilentBus_ReturnsTimeoutAndRestoresBtr(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    const uint32_t aCandidates[] = {500000u, 333333u, 125000u};
+    uint32_t       uDetected     = 0u;
+
+    s_tCan1Instance.BTR = 0x001C0003u;
+    sSetupAutoBaud(0u);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_TIMEOUT, BspCanAutoBaud(hCan, aCandidates, 3u, 10u, &uDetected));
+    TEST_ASSERT_EQUAL_UINT32(0u, uDetected);
+    TEST_ASSERT_EQUAL_HEX32(0x001C0003u, s_tCan1Instance.BTR);
+
+    /* Unreachable 333.333 kbit/s candidate is skipped without starting the controller */
+    TEST_ASSERT_EQUAL(2, s_iStartCount);
+}
+
+void test_BspCanAutoBaud_SilentBus_LecZero_ReturnsTimeout(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    const uint32_t aCandidates[] = {500000u, 250000u};
+    uint32_t       uDetected     = 0u;
+
+    sSetupAutoBaud(0u);
+    s_bSimLecCleared = true;
+
+    /* No frame reached a FIFO: a clean LEC is not a detected bitrate */
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_TIMEOUT, BspCanAutoBaud(hCan, aCandidates, 2u, 10u, &uDetected));
+    TEST_ASSERT_EQUAL_UINT32(0u, uDetected);
+    TEST_ASSERT_EQUAL(2, s_iStartCount);
+    TEST_ASSERT_EQUAL(CAN_FILTER_DISABLE, s_atMonFilters[s_iMonFilterCount - 1].FilterActivation);
+}
+
+void test_BspCanAutoBaud_InvalidParams_ReturnsError(void)
+{
+    const uint32_t aCandidates[] = {500000u};
+    uint32_t       uDetected     = 0u;
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_HANDLE, BspCanAutoBaud(0, aCandidates, 1u, 10u, &uDetected));
+
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanAutoBaud(hCan, NULL, 1u, 10u, &uDetected));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanAutoBaud(hCan, aCandidates, 0u, 10u, &uDetected));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanAutoBaud(hCan, aCandidates, 1u, 10u, NULL));
+
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    BspCanStart(hCan);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_ALREADY_STARTED, BspCanAutoBaud(hCan, aCandidates, 1u, 10u, &uDetected));
+}
+
+/* ============================================================================
+ * Test Cases - RX Rate Monitor
+ * ========================================================================== */
+
+/* Rate timeout callback tracker */
+static int            s_iRateTimeoutCount;
+static int            s_iRateRecoveryCount;
+static uint32_t       s_uRateLastId;
+static BspCanIdType_e s_eRateLastIdType;
+
+static void sTestRateTimeoutCallback(BspCanHandle_t handle, uint32_t uId, BspCanIdType_e eIdType, bool bTimedOut)
+{
+    (void)handle;
+    s_uRateLastId     = uId;
+    s_eRateLastIdType = eIdType;
+    if (bTimedOut)
+    {
+        s_iRateTimeoutCount++;
+    }
+    else
+    {
+        s_iRateRecoveryCount++;
+    }
+}
+
+/**
+ * @brief Allocate CAN1 with the RX stub installed and the rate callback registered.
+ */
+static BspCanHandle_t sSetupRateMonitor(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bLoopback = false, .bSilent = false, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    s_iRateTimeoutCount  = 0;
+    s_iRateRecoveryCount = 0;
+    s_uRateLastId        = 0u;
+    memset(&s_tStubRxHeader, 0, sizeof(s_tStubRxHeader));
+    HAL_CAN_GetRxMessage_StubWithCallback(sStubGetRxMessage);
+    BspCanRegisterRateTimeoutCallback(hCan, sTestRateTimeoutCallback);
+
+    return hCan;
+}
+
+/**
+ * @brief Deliver a standard-ID data frame through FIFO0 at the given tick.
+ */
+static void sReceiveStdAt(uint32_t uId, uint32_t uTick)
+{
+    s_uFakeTick           = uTick;
+    s_tStubRxHeader.StdId = uId;
+    s_tStubRxHeader.IDE   = CAN_ID_STD;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+}
+
+void test_BspCanAddRateMonitor_InvalidParams_ReturnsError(void)
+{
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_HANDLE, BspCanAddRateMonitor(0, 0x100, eBSP_CAN_ID_STANDARD, 30));
+
+    BspCanHandle_t hCan = sSetupRateMonitor();
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanAddRateMonitor(hCan, 0x100, (BspCanIdType_e)2, 30));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanRemoveRateMonitor(hCan, 0x100, eBSP_CAN_ID_STANDARD));
+
+    BspCanRateStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanGetRateStats(hCan, 0x100, eBSP_CAN_ID_STANDARD, &tStats));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanGetRateStatsByIndex(hCan, 0, &tStats));
+}
+
+void test_BspCanAddRateMonitor_TableFull_ReturnsNoResource(void)
+{
+    BspCanHandle_t hCan = sSetupRateMonitor();
+
+    for (uint32_t i = 0; i < BSP_CAN_MAX_RATE_MONITORS; i++)
+    {
+        TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanAddRateMonitor(hCan, 0x100 + i, eBSP_CAN_ID_STANDARD, 0));
+    }
+
+    /* Re-adding a known ID only updates it */
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanAddRateMonitor(hCan, 0x100, eBSP_CAN_ID_STANDARD, 50));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NO_RESOURCE, BspCanAddRateMonitor(hCan, 0x200, eBSP_CAN_ID_STANDARD, 0));
+
+    BspCanRateStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanGetRateStats(hCan, 0x100, eBSP_CAN_ID_STANDARD, &tStats));
+    TEST_ASSERT_EQUAL_UINT32(50u, tStats.uTimeoutMs);
+}
+
+void test_HAL_CAN_RxFifo0MsgPendingCallback_RateMonitor_TracksPeriodAndJitter(void)
+{
+    BspCanHandle_t hCan  = sSetupRateMonitor();
+    uint32_t       uBase = s_uFakeTick + 1000u;
+
+    BspCanAddRateMonitor(hCan, 0x123, eBSP_CAN_ID_STANDARD, 0);
+
+    sReceiveStdAt(0x123, uBase);
+    sReceiveStdAt(0x123, uBase + 10u);
+    sReceiveStdAt(0x123, uBase + 20u);
+    sReceiveStdAt(0x123, uBase + 31u);
+
+    /* Unmonitored ID and extended frame with the same numeric ID are ignored */
+    sReceiveStdAt(0x124, uBase + 32u);
+    s_tStubRxHeader.ExtId = 0x123;
+    s_tStubRxHeader.IDE   = CAN_ID_EXT;
+    HAL_CAN_RxFifo0MsgPendingCallback(&hcan1);
+
+    BspCanRateStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanGetRateStats(hCan, 0x123, eBSP_CAN_ID_STANDARD, &tStats));
+    TEST_ASSERT_EQUAL_UINT32(4u, tStats.uCount);
+    TEST_ASSERT_EQUAL_UINT32(uBase + 31u, tStats.uLastRxTick);
+    TEST_ASSERT_EQUAL_UINT32(10u, tStats.uMinGapMs);
+    TEST_ASSERT_EQUAL_UINT32(11u, tStats.uMaxGapMs);
+
+    /* Seed 10 ms, then 10 ms (no change), then 11 ms: +1/8 ms period, +1/16 ms jitter */
+    TEST_ASSERT_EQUAL_UINT32(10125u, tStats.uPeriodUs);
+    TEST_ASSERT_EQUAL_UINT32(62u, tStats.uJitterUs);
+    TEST_ASSERT_FALSE(tStats.bTimedOut);
+}
+
+void test_BspCanGetRateStats_LongPeriod_DoesNotOverflow(void)
+{
+    BspCanHandle_t hCan  = sSetupRateMonitor();
+    uint32_t       uBase = s_uFakeTick + 1000u;
+
+    BspCanAddRateMonitor(hCan, 0x123, eBSP_CAN_ID_STANDARD, 0);
+
+    /* 300 s between frames: 4.8 M in ms × 16, beyond 32 bits once scaled to µs */
+    sReceiveStdAt(0x123, uBase);
+    sReceiveStdAt(0x123, uBase + 300000u);
+
+    BspCanRateStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanGetRateStatsByIndex(hCan, 0, &tStats));
+    TEST_ASSERT_EQUAL_UINT32(300000000u, tStats.uPeriodUs);
+    TEST_ASSERT_EQUAL_UINT32(300000u, tStats.uMaxGapMs);
+}
+
+void test_BspCanRateMonitor_Timeout_FiresOnceAndRecovers(void)
+{
+    BspCanHandle_t hCan  = sSetupRateMonitor();
+    uint32_t       uBase = s_uFakeTick + 1000u;
+
+    s_uFakeTick = uBase;
+    BspCanAddRateMonitor(hCan, 0x700, eBSP_CAN_ID_STANDARD, 30);
+    sReceiveStdAt(0x700, uBase + 10u);
+
+    /* 20 ms of silence: not yet */
+    s_uFakeTick = uBase + 30u;
+    HAL_SYSTICK_Callback();
+    TEST_ASSERT_EQUAL(0, s_iRateTimeoutCount);
+
+    /* 50 ms of silence: one timeout, not repeated */
+    s_uFakeTick = uBase + 60u;
+    HAL_SYSTICK_Callback();
+    s_uFakeTick = uBase + 100u;
+    HAL_SYSTICK_Callback();
+    TEST_ASSERT_EQUAL(1, s_iRateTimeoutCount);
+    TEST_ASSERT_EQUAL_HEX32(0x700u, s_uRateLastId);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ID_STANDARD, s_eRateLastIdType);
+
+    BspCanRateStats_t tStats;
+    BspCanGetRateStats(hCan, 0x700, eBSP_CAN_ID_STANDARD, &tStats);
+    TEST_ASSERT_TRUE(tStats.bTimedOut);
+    TEST_ASSERT_EQUAL_UINT32(1u, tStats.uTimeouts);
+
+    /* Frame arrives again: recovery reported from the RX ISR */
+    sReceiveStdAt(0x700, uBase + 120u);
+    TEST_ASSERT_EQUAL(1, s_iRateRecoveryCount);
+    BspCanGetRateStats(hCan, 0x700, eBSP_CAN_ID_STANDARD, &tStats);
+    TEST_ASSERT_FALSE(tStats.bTimedOut);
+    TEST_ASSERT_EQUAL_UINT32(110u, tStats.uMaxGapMs);
+}
+
+void test_BspCanRateMonitor_NeverReceived_TimesOutFromRegistration(void)
+{
+    BspCanHandle_t hCan  = sSetupRateMonitor();
+    uint32_t       uBase = s_uFakeTick + 1000u;
+
+    s_uFakeTick = uBase;
+    BspCanAddRateMonitor(hCan, 0x1ABCDEF, eBSP_CAN_ID_EXTENDED, 100);
+    BspCanAddRateMonitor(hCan, 0x300, eBSP_CAN_ID_STANDARD, 0); /* Statistics only */
+
+    s_uFakeTick = uBase + 150u;
+    HAL_SYSTICK_Callback();
+
+    TEST_ASSERT_EQUAL(1, s_iRateTimeoutCount);
+    TEST_ASSERT_EQUAL_HEX32(0x1ABCDEFu, s_uRateLastId);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ID_EXTENDED, s_eRateLastIdType);
+}
+
+void test_BspCanRemoveRateMonitor_KeepsOtherEntriesReachable(void)
+{
+    BspCanHandle_t hCan = sSetupRateMonitor();
+
+    BspCanAddRateMonitor(hCan, 0x100, eBSP_CAN_ID_STANDARD, 0);
+    BspCanAddRateMonitor(hCan, 0x200, eBSP_CAN_ID_STANDARD, 0);
+    BspCanAddRateMonitor(hCan, 0x300, eBSP_CAN_ID_STANDARD, 0);
+
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanRemoveRateMonitor(hCan, 0x100, eBSP_CAN_ID_STANDARD));
+
+    sReceiveStdAt(0x300, s_uFakeTick + 5u);
+
+    BspCanRateStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanGetRateStats(hCan, 0x100, eBSP_CAN_ID_STANDARD, &tStats));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanGetRateStats(hCan, 0x300, eBSP_CAN_ID_STANDARD, &tStats));
+    TEST_ASSERT_EQUAL_UINT32(1u, tStats.uCount);
+
+    /* Overview iteration covers the two remaining IDs */
+    uint32_t uIdSum = 0u;
+    uint8_t  byIdx  = 0u;
+    while (BspCanGetRateStatsByIndex(hCan, byIdx, &tStats) == eBSP_CAN_ERR_NONE)
+    {
+        uIdSum += tStats.uId;
+        byIdx++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(2u, byIdx);
+    TEST_ASSERT_EQUAL_UINT32(0x500u, uIdSum);
+}
+
+/* ============================================================================
+ * Test Cases - Mailbox Send Order
+ * ========================================================================== */
+
+/**
+ * @brief HAL_CAN_AddTxMessage stub: record the ID and report the mailbox named by TSR.CODE.
+ */
+static HAL_StatusTypeDef sStubAddTxFromCode(CAN_HandleTypeDef* hcan, CAN_TxHeaderTypeDef* pHeader, uint8_t aData[], uint32_t* pTxMailbox,
+                                            int cmock_num_calls)
+{
+    static const uint32_t s_auMailboxes[3] = {CAN_TX_MAILBOX0, CAN_TX_MAILBOX1, CAN_TX_MAILBOX2};
+
+    (void)aData;
+    (void)cmock_num_calls;
+    if (s_iSubmittedCount < 16)
+    {
+        s_auSubmittedIds[s_iSubmittedCount] = (pHeader->IDE == CAN_ID_STD) ? pHeader->StdId : pHeader->ExtId;
+        s_iSubmittedCount++;
+    }
+    *pTxMailbox = s_auMailboxes[(hcan->Instance->TSR & CAN_TSR_CODE) >> CAN_TSR_CODE_Pos];
+    return HAL_OK;
+}
+
+/**
+ * @brief Start CAN1 with the given mailbox order.
+ */
+static BspCanHandle_t sStartMailboxOrder(BspCanMailboxOrder_e eOrder)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bAutoRetransmit = true, .eMailboxOrder = eOrder};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    BspCanStart(hCan);
+
+    s_iSubmittedCount = 0;
+    HAL_CAN_AddTxMessage_StubWithCallback(sStubAddTxFromCode);
+
+    return hCan;
+}
+
+/**
+ * @brief Transmit a standard data frame; the next free mailbox is byCode.
+ */
+static void sTransmitToMailbox(BspCanHandle_t hCan, uint32_t uId, uint32_t byCode, uint32_t uTxId)
+{
+    BspCanMessage_t tMsg = {.uId = uId, .eIdType = eBSP_CAN_ID_STANDARD, .eFrameType = eBSP_CAN_FRAME_DATA, .byDataLen = 0};
+
+    s_tCan1Instance.TSR = (s_tCan1Instance.TSR & ~CAN_TSR_CODE) | (byCode << CAN_TSR_CODE_Pos);
+    HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 1);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanTransmit(hCan, &tMsg, 0, uTxId));
+}
+
+void test_BspCanStart_MailboxOrder_ProgramsTxfp(void)
+{
+    HAL_CAN_DeactivateNotification_IgnoreAndReturn(HAL_OK);
+    HAL_CAN_Stop_IgnoreAndReturn(HAL_OK);
+
+    /* Default leaves the CubeMX setting alone */
+    s_tCan1Instance.MCR = CAN_MCR_TXFP;
+    BspCanHandle_t hCan = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_ID);
+    TEST_ASSERT_EQUAL_HEX32(CAN_MCR_TXFP, s_tCan1Instance.MCR);
+    BspCanFree(hCan);
+
+    s_tCan1Instance.MCR = 0u;
+    hCan                = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_FIFO);
+    TEST_ASSERT_EQUAL_HEX32(CAN_MCR_TXFP, s_tCan1Instance.MCR);
+    BspCanFree(hCan);
+
+    /* Same-ID ordering relies on identifier priority */
+    s_tCan1Instance.MCR = CAN_MCR_TXFP;
+    hCan                = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_SAME_ID_FIFO);
+    TEST_ASSERT_EQUAL_HEX32(0u, s_tCan1Instance.MCR);
+}
+
+void test_BspCanTransmit_SameIdFifo_AscendingMailboxesSubmitBackToBack(void)
+{
+    BspCanHandle_t hCan = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_SAME_ID_FIFO);
+
+    /* Segments 1-3 of the same ID land in mailboxes 0, 1, 2: hardware keeps their order */
+    sTransmitToMailbox(hCan, 0x600, 0, 1);
+    sTransmitToMailbox(hCan, 0x600, 1, 2);
+    sTransmitToMailbox(hCan, 0x600, 2, 3);
+
+    TEST_ASSERT_EQUAL(3, s_iSubmittedCount);
+}
+
+void test_BspCanTransmit_SameIdFifo_HoldsFrameThatWouldOvertake(void)
+{
+    BspCanHandle_t hCan = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_SAME_ID_FIFO);
+
+    /* Segment 1 sits in mailbox 1; mailbox 0 is free, so segment 2 would win arbitration first */
+    sTransmitToMailbox(hCan, 0x600, 1, 1);
+    sTransmitToMailbox(hCan, 0x600, 0, 2);
+
+    TEST_ASSERT_EQUAL(1, s_iSubmittedCount);
+    uint8_t byUsed = 0, byFree = 0;
+    BspCanGetTxQueueInfo(hCan, &byUsed, &byFree);
+    TEST_ASSERT_EQUAL_UINT8(1u, byUsed);
+
+    /* Segment 1 done: segment 2 goes out */
+    HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 2);
+    HAL_CAN_TxMailbox1CompleteCallback(&hcan1);
+
+    TEST_ASSERT_EQUAL(2, s_iSubmittedCount);
+    TEST_ASSERT_EQUAL_HEX32(0x600u, s_auSubmittedIds[1]);
+}
+
+void test_BspCanTransmit_SameIdFifo_HeldFrameDoesNotBlockOtherIds(void)
+{
+    BspCanHandle_t hCan = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_SAME_ID_FIFO);
+
+    /* Segment 1 in mailbox 1, segment 2 held at the queue head */
+    sTransmitToMailbox(hCan, 0x600, 1, 1);
+    sTransmitToMailbox(hCan, 0x600, 0, 2);
+
+    /* A different ID queued behind it still takes the free mailbox */
+    sTransmitToMailbox(hCan, 0x601, 0, 3);
+
+    TEST_ASSERT_EQUAL(2, s_iSubmittedCount);
+    TEST_ASSERT_EQUAL_HEX32(0x601u, s_auSubmittedIds[1]);
+    uint8_t byUsed = 0, byFree = 0;
+    BspCanGetTxQueueInfo(hCan, &byUsed, &byFree);
+    TEST_ASSERT_EQUAL_UINT8(1u, byUsed);
+
+    /* Segment 1 done: segment 2 follows into the freed mailbox */
+    s_tCan1Instance.TSR = (s_tCan1Instance.TSR & ~CAN_TSR_CODE) | (1u << CAN_TSR_CODE_Pos);
+    HAL_CAN_GetTxMailboxesFreeLevel_ExpectAndReturn(&hcan1, 2);
+    HAL_CAN_TxMailbox1CompleteCallback(&hcan1);
+
+    TEST_ASSERT_EQUAL(3, s_iSubmittedCount);
+    TEST_ASSERT_EQUAL_HEX32(0x600u, s_auSubmittedIds[2]);
+}
+
+void test_BspCanTransmit_SameIdFifo_IdOrderedQueueSkipsHeldId(void)
+{
+    BspCanConfig_t tConfig = {.eInstance       = eBSP_CAN_INSTANCE_1,
+                              .bAutoRetransmit = true,
+                              .eMailboxOrder   = eBSP_CAN_MBX_ORDER_SAME_ID_FIFO,
+                              .eTxOrder        = eBSP_CAN_TX_ORDER_CAN_ID};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    BspCanStart(hCan);
+    s_iSubmittedCount = 0;
+    HAL_CAN_AddTxMessage_StubWithCallback(sStubAddTxFromCode);
+
+    /* 0x100 wins the heap but its earlier frame sits above the free mailbox */
+    sTransmitToMailbox(hCan, 0x100, 1, 1);
+    sTransmitToMailbox(hCan, 0x100, 0, 2);
+    sTransmitToMailbox(hCan, 0x300, 0, 3);
+
+    TEST_ASSERT_EQUAL(2, s_iSubmittedCount);
+    TEST_ASSERT_EQUAL_HEX32(0x300u, s_auSubmittedIds[1]);
+}
+
+void test_BspCanTransmit_SameIdFifo_OtherIdsUseAnyMailbox(void)
+{
+    BspCanHandle_t hCan = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_SAME_ID_FIFO);
+
+    sTransmitToMailbox(hCan, 0x600, 2, 1);
+    sTransmitToMailbox(hCan, 0x601, 0, 2);
+    sTransmitToMailbox(hCan, 0x602, 1, 3);
+
+    TEST_ASSERT_EQUAL(3, s_iSubmittedCount);
+}
+
+void test_BspCanTransmit_SameIdFifo_IgnoresMailboxReportedEmpty(void)
+{
+    BspCanHandle_t hCan = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_SAME_ID_FIFO);
+
+    sTransmitToMailbox(hCan, 0x600, 2, 1);
+
+    /* Mailbox 2 ended without a completion callback (e.g. no auto-retransmit): TME2 set */
+    s_tCan1Instance.TSR = CAN_TSR_TME2;
+    sTransmitToMailbox(hCan, 0x600, 0, 2);
+
+    TEST_ASSERT_EQUAL(2, s_iSubmittedCount);
+}
+
+void test_BspCanTransmit_DefaultMailboxOrder_NoSameIdHold(void)
+{
+    BspCanHandle_t hCan = sStartMailboxOrder(eBSP_CAN_MBX_ORDER_ID);
+
+    sTransmitToMailbox(hCan, 0x600, 1, 1);
+    sTransmitToMailbox(hCan, 0x600, 0, 2);
+
+    TEST_ASSERT_EQUAL(2, s_iSubmittedCount);
+}
+
+/* ============================================================================
+ * Test Cases - RX FIFO Load Balancing
+ * ========================================================================== */
+
+/* FIFO programmed per filter bank */
+static uint32_t s_auBankFifo[BSP_CAN_MAX_FILTERS];
+
+static HAL_StatusTypeDef sStubConfigFilterFifo(CAN_HandleTypeDef* hcan, CAN_FilterTypeDef* pFilter, int cmock_num_calls)
+{
+    (void)hcan;
+    (void)cmock_num_calls;
+    s_auBankFifo[pFilter->FilterBank] = pFilter->FilterFIFOAssignment;
+    return HAL_OK;
+}
+
+/**
+ * @brief Add an exact-match standard ID filter.
+ */
+static void sAddBalancedFilter(BspCanHandle_t hCan, uint32_t uId, uint8_t byFifo, uint16_t wRate, bool bCritical)
+{
+    BspCanFilter_t tFilter = {.uFilterId        = uId,
+                              .uFilterMask      = 0x7FF,
+                              .eIdType          = eBSP_CAN_ID_STANDARD,
+                              .byFifoAssignment = byFifo,
+                              .wExpectedRate    = wRate,
+                              .bCritical        = bCritical};
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanAddFilter(hCan, &tFilter));
+}
+
+/**
+ * @brief Start CAN1 capturing the per-bank FIFO assignment.
+ */
+static void sStartBalanced(BspCanHandle_t hCan)
+{
+    HAL_CAN_ConfigFilter_StubWithCallback(sStubConfigFilterFifo);
+    HAL_CAN_Start_ExpectAndReturn(&hcan1, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanStart(hCan));
+}
+
+static uint8_t sFilterFifo(BspCanHandle_t hCan, uint8_t byIndex)
+{
+    uint8_t byFifo = 0xFFu;
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanGetFilterFifo(hCan, byIndex, &byFifo));
+    return byFifo;
+}
+
+void test_BspCanStart_FifoAuto_BalancesDeclaredRates(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    sAddBalancedFilter(hCan, 0x100, BSP_CAN_FIFO_AUTO, 300, false);
+    sAddBalancedFilter(hCan, 0x200, BSP_CAN_FIFO_AUTO, 1000, false);
+    sAddBalancedFilter(hCan, 0x300, BSP_CAN_FIFO_AUTO, 200, false);
+    sAddBalancedFilter(hCan, 0x400, BSP_CAN_FIFO_AUTO, 800, false);
+
+    HAL_NVIC_SetPriority_Expect(CAN1_RX0_IRQn, BSP_CAN_RX0_IRQ_PRIORITY, 0u);
+    HAL_NVIC_SetPriority_Expect(CAN1_RX1_IRQn, BSP_CAN_RX1_IRQ_PRIORITY, 0u);
+    sStartBalanced(hCan);
+
+    /* Heaviest first: 1000->F1, 800->F0, 300->F0, 200->F1 (1100 / 1200) */
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 0));
+    TEST_ASSERT_EQUAL_UINT8(1u, sFilterFifo(hCan, 1));
+    TEST_ASSERT_EQUAL_UINT8(1u, sFilterFifo(hCan, 2));
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 3));
+    TEST_ASSERT_EQUAL_UINT32(CAN_FILTER_FIFO0, s_auBankFifo[0]);
+    TEST_ASSERT_EQUAL_UINT32(CAN_FILTER_FIFO1, s_auBankFifo[1]);
+    TEST_ASSERT_EQUAL_UINT32(CAN_FILTER_FIFO1, s_auBankFifo[2]);
+    TEST_ASSERT_EQUAL_UINT32(CAN_FILTER_FIFO0, s_auBankFifo[3]);
+}
+
+void test_BspCanStart_FifoAuto_CriticalPinnedAndFixedCounted(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_2, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+
+    sAddBalancedFilter(hCan, 0x010, BSP_CAN_FIFO_AUTO, 100, true);
+    sAddBalancedFilter(hCan, 0x500, 1u, 900, false);
+    sAddBalancedFilter(hCan, 0x600, BSP_CAN_FIFO_AUTO, 300, false);
+    sAddBalancedFilter(hCan, 0x700, BSP_CAN_FIFO_AUTO, 600, false);
+
+    HAL_NVIC_SetPriority_Expect(CAN2_RX0_IRQn, BSP_CAN_RX0_IRQ_PRIORITY, 0u);
+    HAL_NVIC_SetPriority_Expect(CAN2_RX1_IRQn, BSP_CAN_RX1_IRQ_PRIORITY, 0u);
+    HAL_CAN_ConfigFilter_StubWithCallback(sStubConfigFilterFifo);
+    HAL_CAN_Start_ExpectAndReturn(&hcan2, HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NONE, BspCanStart(hCan));
+
+    /* FIFO0 starts at 100 (critical), FIFO1 at 900 (fixed): 600->F0, 300->F0 */
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 0));
+    TEST_ASSERT_EQUAL_UINT8(1u, sFilterFifo(hCan, 1));
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 2));
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 3));
+}
+
+void test_BspCanStart_FifoAuto_UsesMeasuredRates(void)
+{
+    BspCanHandle_t hCan = sSetupRateMonitor();
+
+    BspCanAddRateMonitor(hCan, 0x100, eBSP_CAN_ID_STANDARD, 0);
+    BspCanAddRateMonitor(hCan, 0x200, eBSP_CAN_ID_STANDARD, 0);
+    BspCanAddRateMonitor(hCan, 0x300, eBSP_CAN_ID_STANDARD, 0);
+
+    /* Calibration traffic: 0x100 every 10 ms, 0x200 every 2 ms, 0x300 every 5 ms */
+    for (uint32_t uTick = 1000u; uTick <= 1020u; uTick += 2u)
+    {
+        sReceiveStdAt(0x200, uTick);
+        if ((uTick % 10u) == 0u)
+        {
+            sReceiveStdAt(0x100, uTick);
+            sReceiveStdAt(0x300, uTick);
+        }
+        else if ((uTick % 5u) == 0u)
+        {
+            sReceiveStdAt(0x300, uTick);
+        }
+    }
+
+    sAddBalancedFilter(hCan, 0x100, BSP_CAN_FIFO_AUTO, 0, false);
+    sAddBalancedFilter(hCan, 0x200, BSP_CAN_FIFO_AUTO, 0, false);
+    sAddBalancedFilter(hCan, 0x300, BSP_CAN_FIFO_AUTO, 0, false);
+
+    HAL_NVIC_SetPriority_Ignore();
+    sStartBalanced(hCan);
+
+    /* 500/s -> F1, 200/s -> F0, 100/s -> F0 */
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 0));
+    TEST_ASSERT_EQUAL_UINT8(1u, sFilterFifo(hCan, 1));
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 2));
+}
+
+void test_BspCanStart_FixedFifos_NoBalancingOrNvic(void)
+{
+    BspCanConfig_t tConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bAutoRetransmit = true};
+    BspCanHandle_t hCan    = BspCanAllocate(&tConfig, NULL, NULL);
+    uint8_t        byFifo  = 0u;
+
+    sAddBalancedFilter(hCan, 0x100, 0u, 1000, false);
+    sAddBalancedFilter(hCan, 0x200, 0u, 1000, false);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_NOT_STARTED, BspCanGetFilterFifo(hCan, 0, &byFifo));
+
+    /* Strict mock: any HAL_NVIC_SetPriority call would fail the test */
+    sStartBalanced(hCan);
+
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 0));
+    TEST_ASSERT_EQUAL_UINT8(0u, sFilterFifo(hCan, 1));
+    TEST_ASSERT_EQUAL_UINT32(CAN_FILTER_FIFO0, s_auBankFifo[1]);
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanGetFilterFifo(hCan, 2, &byFifo));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_PARAM, BspCanGetFilterFifo(hCan, 0, NULL));
+    TEST_ASSERT_EQUAL(eBSP_CAN_ERR_INVALID_HANDLE, BspCanGetFilterFifo(BSP_CAN_INVALID_HANDLE, 0, &byFifo));
+}
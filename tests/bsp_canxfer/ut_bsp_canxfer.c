@@ -0,0 +1,700 @@
+/**
+ * @file ut_bsp_canxfer.c
+ * @brief Unit tests for BSP CAN block-transfer module
+ *
+ * The streaming tests run the node against a virtual 1 Mbit/s CAN bus and a
+ * flash timing model: every frame occupies the bus for SIM_FRAME_US, the
+ * sender reacts to replies only after they have crossed the bus, and the
+ * node's BspCanXferProcess() runs whenever the simulated flash is idle.
+ */
+
+#include "Mockstm32f4xx_hal_can.h"
+#include "Mockstm32f4xx_hal_cortex.h"
+#include "Mockstm32f4xx_hal_gpio.h"
+#include "Mockstm32f4xx_hal_rcc.h"
+#include "bsp_can.h"
+#include "bsp_canxfer.h"
+#include "gpio_struct.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================================================
+ * Test Stubs and Mocks
+ * ========================================================================== */
+
+/* Stub for HAL_GetTick - required by production code */
+uint32_t HAL_GetTick(void)
+{
+    return 0u;
+}
+
+/* Stub CAN handles - required by production code */
+CAN_HandleTypeDef hcan1;
+CAN_HandleTypeDef hcan2;
+
+/* Stub gpio_pins array - required by bsp_led/bsp_gpio dependencies */
+const gpio_t gpio_pins[eGPIO_COUNT] = {0};
+
+/* ============================================================================
+ * Virtual Bus and Flash Model
+ * ========================================================================== */
+
+/** Bus time of an 8-byte standard frame at 1 Mbit/s (111 bits + typical stuffing) */
+#define SIM_FRAME_US (125u)
+/** Simulated flash area */
+#define SIM_FLASH_BASE (0x08020000u)
+#define SIM_FLASH_SIZE (32u * 1024u)
+/** Protocol IDs */
+#define SIM_CTRL_ID  (0x7F0u)
+#define SIM_DATA_ID  (0x7F1u)
+#define SIM_REPLY_ID (0x7F8u)
+/** Maximum node replies waiting for the bus */
+#define SIM_MAX_REPLIES (16u)
+
+/**
+ * @brief Node reply waiting for the bus.
+ */
+typedef struct
+{
+    uint8_t  aData[8];
+    uint32_t uReadyUs;
+    bool     bPending;
+} SimReply_t;
+
+/**
+ * @brief Sender (update tool) state.
+ */
+typedef struct
+{
+    const uint8_t* pImage;
+    uint32_t       uSize;
+    uint32_t       uCrc;       /**< CRC sent with END */
+    uint32_t       uNext;      /**< Next offset to send */
+    uint32_t       uLimit;     /**< Window limit from the last reply */
+    uint32_t       uDropFrame; /**< Data frame number lost on the bus (0 = none) */
+    uint32_t       uDataFrames;
+    uint32_t       uNakReplies;
+    uint32_t       uAckReplies;
+    uint32_t       uReadyUs;
+    uint32_t       uDoneUs;
+    uint8_t        byStatus;
+    bool           bReady;
+    bool           bEndSent;
+    bool           bFinished;
+} SimSender_t;
+
+static uint8_t            s_abySimFlash[SIM_FLASH_SIZE];
+static uint8_t            s_abyImage[SIM_FLASH_SIZE];
+static uint32_t           s_uSimTimeUs;
+static uint32_t           s_uFlashFreeUs;
+static uint32_t           s_uProgramUsPerWord;
+static uint32_t           s_uEraseUs;
+static bool               s_bEraseOk;
+static bool               s_bInProcess;
+static uint32_t           s_uEraseCalls;
+static uint32_t           s_uEraseAddress;
+static uint32_t           s_uEraseLength;
+static SimReply_t         s_atReplies[SIM_MAX_REPLIES];
+static BspCanHandle_t     s_hCan;
+static BspCanXferHandle_t s_hXfer;
+
+static uint32_t sMax(uint32_t uA, uint32_t uB)
+{
+    return (uA > uB) ? uA : uB;
+}
+
+static bool sSimErase(uint32_t uAddress, uint32_t uLength)
+{
+    s_uEraseCalls++;
+    s_uEraseAddress = uAddress;
+    s_uEraseLength  = uLength;
+    memset(s_abySimFlash, 0xFF, sizeof(s_abySimFlash));
+    s_uFlashFreeUs = sMax(s_uSimTimeUs, s_uFlashFreeUs) + s_uEraseUs;
+    return s_bEraseOk;
+}
+
+static bool sSimProgram(uint32_t uAddress, const uint8_t* pData, uint32_t uLength)
+{
+    uint32_t uOffset = uAddress - SIM_FLASH_BASE;
+
+    if ((uOffset + uLength) > SIM_FLASH_SIZE)
+    {
+        return false;
+    }
+
+    /* Flash bits only go 1 -> 0: programming twice is an error */
+    for (uint32_t i = 0u; i < uLength; i++)
+    {
+        if (s_abySimFlash[uOffset + i] != 0xFFu)
+        {
+            return false;
+        }
+        s_abySimFlash[uOffset + i] = pData[i];
+    }
+
+    s_uFlashFreeUs = sMax(s_uSimTimeUs, s_uFlashFreeUs) + (((uLength + 3u) / 4u) * s_uProgramUsPerWord);
+    return true;
+}
+
+/**
+ * @brief HAL_CAN_AddTxMessage stub: node replies enter the virtual bus.
+ *
+ * Replies leave once the flash operation that preceded them in
+ * BspCanXferProcess() has finished.
+ */
+static HAL_StatusTypeDef sStubAddTxMessage(CAN_HandleTypeDef* hcan, CAN_TxHeaderTypeDef* pHeader, uint8_t aData[], uint32_t* pTxMailbox,
+                                           int cmock_num_calls)
+{
+    (void)hcan;
+    (void)cmock_num_calls;
+    TEST_ASSERT_EQUAL_HEX32(SIM_REPLY_ID, pHeader->StdId);
+
+    for (uint32_t i = 0u; i < SIM_MAX_REPLIES; i++)
+    {
+        if (!s_atReplies[i].bPending)
+        {
+            memcpy(s_atReplies[i].aData, aData, 8u);
+            s_atReplies[i].uReadyUs = s_bInProcess ? sMax(s_uSimTimeUs, s_uFlashFreeUs) : s_uSimTimeUs;
+            s_atReplies[i].bPending = true;
+            *pTxMailbox             = CAN_TX_MAILBOX0;
+            return HAL_OK;
+        }
+    }
+
+    TEST_FAIL_MESSAGE("Virtual bus reply queue overflow");
+    return HAL_ERROR;
+}
+
+/**
+ * @brief Index of the earliest reply ready at the current time, -1 if none.
+ */
+static int sSimNextReply(void)
+{
+    int iBest = -1;
+
+    for (uint32_t i = 0u; i < SIM_MAX_REPLIES; i++)
+    {
+        if (s_atReplies[i].bPending && (s_atReplies[i].uReadyUs <= s_uSimTimeUs) &&
+            ((iBest < 0) || (s_atReplies[i].uReadyUs < s_atReplies[iBest].uReadyUs)))
+        {
+            iBest = (int)i;
+        }
+    }
+
+    return iBest;
+}
+
+/**
+ * @brief Pop the next reply (any ready time). Returns false if none.
+ */
+static bool sPopReply(uint8_t* pData)
+{
+    for (uint32_t i = 0u; i < SIM_MAX_REPLIES; i++)
+    {
+        if (s_atReplies[i].bPending)
+        {
+            memcpy(pData, s_atReplies[i].aData, 8u);
+            s_atReplies[i].bPending = false;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static uint32_t sReplyField(const uint8_t* pData)
+{
+    return (uint32_t)pData[0] | ((uint32_t)pData[1] << 8u) | ((uint32_t)pData[2] << 16u);
+}
+
+/**
+ * @brief Put one sender frame on the bus and hand it to the node at end of frame.
+ */
+static void sSimSend(uint32_t uId, const uint8_t* pData, uint8_t byLen, bool bLost)
+{
+    BspCanMessage_t tMsg = {.uId = uId, .eIdType = eBSP_CAN_ID_STANDARD, .eFrameType = eBSP_CAN_FRAME_DATA, .byDataLen = byLen};
+
+    memcpy(tMsg.aData, pData, byLen);
+    s_uSimTimeUs += SIM_FRAME_US;
+    if (!bLost)
+    {
+        TEST_ASSERT_TRUE(BspCanXferOnRx(s_hXfer, &tMsg));
+    }
+}
+
+static void sSendControl(uint8_t byCmd, uint32_t uValue)
+{
+    uint8_t aData[5] = {byCmd, (uint8_t)uValue, (uint8_t)(uValue >> 8u), (uint8_t)(uValue >> 16u), (uint8_t)(uValue >> 24u)};
+    sSimSend(SIM_CTRL_ID, aData, 5u, false);
+}
+
+/**
+ * @brief Sender reaction to a reply that has crossed the bus.
+ */
+static void sSenderOnReply(SimSender_t* pSender, const uint8_t* pData)
+{
+    uint32_t uOffset = sReplyField(&pData[1]);
+
+    if (pData[0] == eBSP_CANXFER_REPLY_ACK)
+    {
+        pSender->uAckReplies++;
+        if (!pSender->bReady)
+        {
+            pSender->bReady   = true;
+            pSender->uReadyUs = s_uSimTimeUs;
+        }
+        pSender->uLimit = sReplyField(&pData[4]);
+    }
+    else if (pData[0] == eBSP_CANXFER_REPLY_NAK)
+    {
+        /* Go back to the first missing byte and resend END after it */
+        pSender->uNakReplies++;
+        pSender->uNext    = uOffset;
+        pSender->uLimit   = sReplyField(&pData[4]);
+        pSender->bEndSent = false;
+    }
+    else
+    {
+        pSender->byStatus  = pData[0];
+        pSender->bFinished = true;
+        pSender->uDoneUs   = s_uSimTimeUs;
+    }
+}
+
+/**
+ * @brief Run a complete update over the virtual bus.
+ */
+static void sSimRun(SimSender_t* pSender)
+{
+    sSendControl(BSP_CANXFER_CMD_START, pSender->uSize);
+
+    while (!pSender->bFinished)
+    {
+        TEST_ASSERT_TRUE_MESSAGE(s_uSimTimeUs < 60000000u, "Virtual transfer stalled");
+
+        /* Node main loop: runs whenever the flash is idle */
+        if (s_uSimTimeUs >= s_uFlashFreeUs)
+        {
+            s_bInProcess = true;
+            TEST_ASSERT_EQUAL(eBSP_CANXFER_ERR_NONE, BspCanXferProcess(s_hXfer));
+            s_bInProcess = false;
+        }
+
+        /* Node replies win arbitration (lower traffic, sent first when ready) */
+        int iReply = sSimNextReply();
+        if (iReply >= 0)
+        {
+            s_atReplies[iReply].bPending = false;
+            s_uSimTimeUs += SIM_FRAME_US;
+            sSenderOnReply(pSender, s_atReplies[iReply].aData);
+            continue;
+        }
+
+        if (pSender->bReady && (pSender->uNext < pSender->uLimit))
+        {
+            uint8_t  aData[8];
+            uint32_t uLen = pSender->uSize - pSender->uNext;
+
+            uLen     = (uLen > BSP_CANXFER_FRAME_PAYLOAD) ? BSP_CANXFER_FRAME_PAYLOAD : uLen;
+            aData[0] = (uint8_t)(pSender->uNext / BSP_CANXFER_FRAME_PAYLOAD);
+            memcpy(&aData[1], &pSender->pImage[pSender->uNext], uLen);
+            pSender->uNext += uLen;
+            pSender->uDataFrames++;
+            sSimSend(SIM_DATA_ID, aData, (uint8_t)(uLen + 1u), pSender->uDataFrames == pSender->uDropFrame);
+            continue;
+        }
+
+        if (pSender->bReady && (pSender->uNext == pSender->uSize) && !pSender->bEndSent)
+        {
+            pSender->bEndSent = true;
+            sSendControl(BSP_CANXFER_CMD_END, pSender->uCrc);
+            continue;
+        }
+
+        /* Bus idle: jump to the next reply or the end of the flash operation */
+        uint32_t uNextUs = s_uSimTimeUs + SIM_FRAME_US;
+        for (uint32_t i = 0u; i < SIM_MAX_REPLIES; i++)
+        {
+            if (s_atReplies[i].bPending && (s_atReplies[i].uReadyUs < uNextUs))
+            {
+                uNextUs = s_atReplies[i].uReadyUs;
+            }
+        }
+        if ((s_uFlashFreeUs > s_uSimTimeUs) && (s_uFlashFreeUs < uNextUs))
+        {
+            uNextUs = s_uFlashFreeUs;
+        }
+        s_uSimTimeUs = sMax(uNextUs, s_uSimTimeUs + 1u);
+    }
+}
+
+/**
+ * @brief Prepare a pseudo-random image and a sender for it.
+ */
+static void sSenderInit(SimSender_t* pSender, uint32_t uSize)
+{
+    uint32_t uSeed = 0x12345678u;
+
+    for (uint32_t i = 0u; i < uSize; i++)
+    {
+        uSeed         = (uSeed * 1103515245u) + 12345u;
+        s_abyImage[i] = (uint8_t)(uSeed >> 16u);
+    }
+
+    memset(pSender, 0, sizeof(SimSender_t));
+    pSender->pImage = s_abyImage;
+    pSender->uSize  = uSize;
+    pSender->uCrc   = BspCanXferCrc32(0u, s_abyImage, uSize);
+}
+
+/**
+ * @brief Image throughput of a finished transfer in bytes per second.
+ */
+static uint32_t sThroughput(const SimSender_t* pSender)
+{
+    return (uint32_t)(((uint64_t)pSender->uSize * 1000000u) / (pSender->uDoneUs - pSender->uReadyUs));
+}
+
+/* ============================================================================
+ * Test Fixtures
+ * ========================================================================== */
+
+static CAN_TypeDef s_tCan1Instance;
+
+static BspCanXferConfig_t sDefaultConfig(void)
+{
+    BspCanXferConfig_t tConfig = {.hCan          = s_hCan,
+                                  .uCtrlId       = SIM_CTRL_ID,
+                                  .uDataId       = SIM_DATA_ID,
+                                  .uReplyId      = SIM_REPLY_ID,
+                                  .eIdType       = eBSP_CAN_ID_STANDARD,
+                                  .byReplyPrio   = 0u,
+                                  .uFlashAddress = SIM_FLASH_BASE,
+                                  .uFlashSize    = SIM_FLASH_SIZE,
+                                  .tFlashOps     = {.pfnErase = sSimErase, .pfnProgram = sSimProgram}};
+    return tConfig;
+}
+
+void setUp(void)
+{
+    memset(&s_tCan1Instance, 0, sizeof(CAN_TypeDef));
+    hcan1.Instance = &s_tCan1Instance;
+
+    memset(s_atReplies, 0, sizeof(s_atReplies));
+    memset(s_abySimFlash, 0xFF, sizeof(s_abySimFlash));
+    s_uSimTimeUs        = 0u;
+    s_uFlashFreeUs      = 0u;
+    s_uProgramUsPerWord = 16u; /* x32 parallelism */
+    s_uEraseUs          = 20000u;
+    s_bEraseOk          = true;
+    s_bInProcess        = false;
+    s_uEraseCalls       = 0u;
+
+    /* Started bsp_can instance carrying the replies */
+    BspCanConfig_t tCanConfig = {.eInstance = eBSP_CAN_INSTANCE_1, .bAutoRetransmit = true};
+    s_hCan                    = BspCanAllocate(&tCanConfig, NULL, NULL);
+    HAL_CAN_Start_IgnoreAndReturn(HAL_OK);
+    HAL_CAN_ActivateNotification_IgnoreAndReturn(HAL_OK);
+    BspCanStart(s_hCan);
+    HAL_CAN_GetTxMailboxesFreeLevel_IgnoreAndReturn(3u);
+    HAL_CAN_AddTxMessage_StubWithCallback(sStubAddTxMessage);
+
+    BspCanXferConfig_t tConfig = sDefaultConfig();
+    s_hXfer                    = BspCanXferAllocate(&tConfig);
+}
+
+void tearDown(void)
+{
+    HAL_CAN_Stop_IgnoreAndReturn(HAL_OK);
+    HAL_CAN_DeactivateNotification_IgnoreAndReturn(HAL_OK);
+
+    uint8_t         aAbort[1] = {BSP_CANXFER_CMD_ABORT};
+    BspCanMessage_t tAbort    = {.uId = SIM_CTRL_ID, .eIdType = eBSP_CAN_ID_STANDARD, .eFrameType = eBSP_CAN_FRAME_DATA, .byDataLen = 1u};
+    memcpy(tAbort.aData, aAbort, sizeof(aAbort));
+    for (int8_t i = 0; i < (int8_t)BSP_CANXFER_MAX_INSTANCES; i++)
+    {
+        (void)BspCanXferOnRx((BspCanXferHandle_t)i, &tAbort);
+        (void)BspCanXferFree((BspCanXferHandle_t)i);
+    }
+
+    BspCanFree(s_hCan);
+}
+
+/* ============================================================================
+ * Test Cases - Allocation and CRC
+ * ========================================================================== */
+
+void test_BspCanXferAllocate_InvalidConfig_ReturnsInvalid(void)
+{
+    BspCanXferConfig_t tConfig = sDefaultConfig();
+
+    /* setUp took the only session */
+    TEST_ASSERT_NOT_EQUAL(BSP_CANXFER_INVALID_HANDLE, s_hXfer);
+    TEST_ASSERT_EQUAL(BSP_CANXFER_INVALID_HANDLE, BspCanXferAllocate(&tConfig));
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_ERR_NONE, BspCanXferFree(s_hXfer));
+
+    TEST_ASSERT_EQUAL(BSP_CANXFER_INVALID_HANDLE, BspCanXferAllocate(NULL));
+
+    tConfig.tFlashOps.pfnProgram = NULL;
+    TEST_ASSERT_EQUAL(BSP_CANXFER_INVALID_HANDLE, BspCanXferAllocate(&tConfig));
+
+    tConfig            = sDefaultConfig();
+    tConfig.uFlashSize = 0x01000000u;
+    TEST_ASSERT_EQUAL(BSP_CANXFER_INVALID_HANDLE, BspCanXferAllocate(&tConfig));
+
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_ERR_INVALID_HANDLE, BspCanXferFree(s_hXfer));
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_ERR_INVALID_HANDLE, BspCanXferProcess(BSP_CANXFER_INVALID_HANDLE));
+}
+
+void test_BspCanXferCrc32_MatchesReference(void)
+{
+    const uint8_t aCheck[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926u, BspCanXferCrc32(0u, aCheck, sizeof(aCheck)));
+
+    /* Incremental calculation gives the same result */
+    uint32_t uCrc = BspCanXferCrc32(0u, aCheck, 4u);
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926u, BspCanXferCrc32(uCrc, &aCheck[4], sizeof(aCheck) - 4u));
+}
+
+void test_BspCanXferOnRx_ForeignFrames_NotConsumed(void)
+{
+    BspCanMessage_t tMsg = {.uId = 0x123, .eIdType = eBSP_CAN_ID_STANDARD, .eFrameType = eBSP_CAN_FRAME_DATA, .byDataLen = 8u};
+
+    TEST_ASSERT_FALSE(BspCanXferOnRx(s_hXfer, &tMsg));
+    tMsg.uId     = SIM_DATA_ID;
+    tMsg.eIdType = eBSP_CAN_ID_EXTENDED;
+    TEST_ASSERT_FALSE(BspCanXferOnRx(s_hXfer, &tMsg));
+    TEST_ASSERT_FALSE(BspCanXferOnRx(s_hXfer, NULL));
+    TEST_ASSERT_FALSE(BspCanXferOnRx(BSP_CANXFER_INVALID_HANDLE, &tMsg));
+}
+
+/* ============================================================================
+ * Test Cases - Session Control
+ * ========================================================================== */
+
+void test_BspCanXfer_Start_ErasesThenOpensTwoBlockWindow(void)
+{
+    BspCanXferStatus_t tStatus;
+    uint8_t            aReply[8];
+
+    sSendControl(BSP_CANXFER_CMD_START, 4000u);
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_STATE_ERASING, tStatus.eState);
+    TEST_ASSERT_EQUAL(0u, s_uEraseCalls);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_ERR_BUSY, BspCanXferFree(s_hXfer));
+
+    BspCanXferProcess(s_hXfer);
+
+    TEST_ASSERT_EQUAL(1u, s_uEraseCalls);
+    TEST_ASSERT_EQUAL_HEX32(SIM_FLASH_BASE, s_uEraseAddress);
+    TEST_ASSERT_EQUAL(4000u, s_uEraseLength);
+    TEST_ASSERT_TRUE(sPopReply(aReply));
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_ACK, aReply[0]);
+    TEST_ASSERT_EQUAL(0u, sReplyField(&aReply[1]));
+    TEST_ASSERT_EQUAL(2u * BSP_CANXFER_BLOCK_SIZE, sReplyField(&aReply[4]));
+
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_STATE_RECEIVING, tStatus.eState);
+
+    /* A second START while receiving is rejected */
+    sSendControl(BSP_CANXFER_CMD_START, 4000u);
+    BspCanXferProcess(s_hXfer);
+    TEST_ASSERT_TRUE(sPopReply(aReply));
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_ERR_STATE, aReply[0]);
+}
+
+void test_BspCanXfer_Start_ImageTooLarge_RepliesErrSize(void)
+{
+    uint8_t aReply[8];
+
+    sSendControl(BSP_CANXFER_CMD_START, SIM_FLASH_SIZE + 1u);
+    BspCanXferProcess(s_hXfer);
+
+    TEST_ASSERT_TRUE(sPopReply(aReply));
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_ERR_SIZE, aReply[0]);
+    TEST_ASSERT_EQUAL(0u, s_uEraseCalls);
+}
+
+void test_BspCanXfer_EraseFails_RepliesErrFlash(void)
+{
+    BspCanXferStatus_t tStatus;
+    uint8_t            aReply[8];
+
+    s_bEraseOk = false;
+    sSendControl(BSP_CANXFER_CMD_START, 1000u);
+    BspCanXferProcess(s_hXfer);
+
+    TEST_ASSERT_TRUE(sPopReply(aReply));
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_ERR_FLASH, aReply[0]);
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_STATE_FAILED, tStatus.eState);
+}
+
+void test_BspCanXfer_FrameBeyondWindow_Nak(void)
+{
+    BspCanXferStatus_t tStatus;
+    uint8_t            aReply[8];
+    uint8_t            aData[8] = {0};
+
+    sSendControl(BSP_CANXFER_CMD_START, SIM_FLASH_SIZE);
+    BspCanXferProcess(s_hXfer);
+    TEST_ASSERT_TRUE(sPopReply(aReply));
+
+    /* Fill the whole window without letting the node program anything */
+    uint32_t uFrames = (2u * BSP_CANXFER_BLOCK_SIZE) / BSP_CANXFER_FRAME_PAYLOAD;
+    for (uint32_t i = 0u; i < uFrames; i++)
+    {
+        aData[0] = (uint8_t)i;
+        sSimSend(SIM_DATA_ID, aData, 8u, false);
+    }
+    TEST_ASSERT_FALSE(sPopReply(aReply));
+
+    /* The next frame would overwrite the block waiting for flash */
+    aData[0] = (uint8_t)uFrames;
+    sSimSend(SIM_DATA_ID, aData, 8u, false);
+    sSimSend(SIM_DATA_ID, aData, 8u, false);
+
+    /* The RX path never transmits; the NAK leaves from the main loop ahead of the block's ACK */
+    TEST_ASSERT_FALSE(sPopReply(aReply));
+    BspCanXferProcess(s_hXfer);
+
+    TEST_ASSERT_TRUE(sPopReply(aReply));
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_NAK, aReply[0]);
+    TEST_ASSERT_EQUAL(uFrames * BSP_CANXFER_FRAME_PAYLOAD, sReplyField(&aReply[1]));
+    TEST_ASSERT_TRUE(sPopReply(aReply));
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_ACK, aReply[0]);
+    TEST_ASSERT_FALSE(sPopReply(aReply)); /* One NAK per gap */
+
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(uFrames, tStatus.uFrames);
+    TEST_ASSERT_EQUAL(2u, tStatus.uNaks);
+}
+
+void test_BspCanXfer_Abort_ReturnsToIdle(void)
+{
+    BspCanXferStatus_t tStatus;
+
+    sSendControl(BSP_CANXFER_CMD_START, 1000u);
+    BspCanXferProcess(s_hXfer);
+    sSendControl(BSP_CANXFER_CMD_ABORT, 0u);
+
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_STATE_IDLE, tStatus.eState);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_ERR_INVALID_PARAM, BspCanXferGetStatus(s_hXfer, NULL));
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_ERR_NONE, BspCanXferFree(s_hXfer));
+}
+
+/**
+ * @brief Program callback during which the sender restarts the transfer.
+ */
+static bool sProgramThenRestart(uint32_t uAddress, const uint8_t* pData, uint32_t uLength)
+{
+    bool bOk = sSimProgram(uAddress, pData, uLength);
+
+    sSendControl(BSP_CANXFER_CMD_ABORT, 0u);
+    sSendControl(BSP_CANXFER_CMD_START, 1000u);
+    return bOk;
+}
+
+void test_BspCanXfer_RestartWhileProgramming_NewSessionKeepsItsCrc(void)
+{
+    BspCanXferStatus_t tStatus;
+    uint8_t            aData[8] = {0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u};
+
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_ERR_NONE, BspCanXferFree(s_hXfer));
+    BspCanXferConfig_t tConfig   = sDefaultConfig();
+    tConfig.tFlashOps.pfnProgram = sProgramThenRestart;
+    s_hXfer                      = BspCanXferAllocate(&tConfig);
+
+    sSendControl(BSP_CANXFER_CMD_START, BSP_CANXFER_FRAME_PAYLOAD);
+    BspCanXferProcess(s_hXfer);
+    sSimSend(SIM_DATA_ID, aData, 8u, false);
+    BspCanXferProcess(s_hXfer);
+
+    /* The old block's CRC and progress must not leak into the restarted session */
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_STATE_ERASING, tStatus.eState);
+    TEST_ASSERT_EQUAL_HEX32(0u, tStatus.uCrc);
+    TEST_ASSERT_EQUAL(0u, tStatus.uProgrammed);
+}
+
+/* ============================================================================
+ * Test Cases - Streaming over the Virtual Bus
+ * ========================================================================== */
+
+/**
+ * @brief Stream a 32 KiB image and check content, CRC and bus utilisation.
+ */
+static void sRunStreamTest(uint32_t uProgramUsPerWord, const char* pName)
+{
+    SimSender_t        tSender;
+    BspCanXferStatus_t tStatus;
+    char               acMsg[96];
+
+    s_uProgramUsPerWord = uProgramUsPerWord;
+    sSenderInit(&tSender, SIM_FLASH_SIZE - 3u);
+    sSimRun(&tSender);
+
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_DONE, tSender.byStatus);
+    TEST_ASSERT_EQUAL_MEMORY(s_abyImage, s_abySimFlash, tSender.uSize);
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_STATE_DONE, tStatus.eState);
+    TEST_ASSERT_EQUAL_HEX32(tSender.uCrc, tStatus.uCrc);
+    TEST_ASSERT_EQUAL(0u, tSender.uNakReplies);
+
+    /* One acknowledgement per block plus the ready reply */
+    TEST_ASSERT_EQUAL(1u + ((tSender.uSize + BSP_CANXFER_BLOCK_SIZE - 1u) / BSP_CANXFER_BLOCK_SIZE), tSender.uAckReplies);
+
+    /* Payload capacity of the bus: 7 bytes per frame time */
+    uint32_t uCapacity   = (BSP_CANXFER_FRAME_PAYLOAD * 1000000u) / SIM_FRAME_US;
+    uint32_t uThroughput = sThroughput(&tSender);
+    snprintf(acMsg, sizeof(acMsg), "%s: %lu B/s of %lu B/s bus payload capacity", pName, (unsigned long)uThroughput,
+             (unsigned long)uCapacity);
+    TEST_MESSAGE(acMsg);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32((uCapacity * 9u) / 10u, uThroughput);
+}
+
+void test_BspCanXfer_Stream_FastFlash_SaturatesBus(void)
+{
+    /* x32 programming: 16 us per word, ~2 ms per 512-byte block */
+    sRunStreamTest(16u, "x32 flash");
+}
+
+void test_BspCanXfer_Stream_SlowFlash_SaturatesBus(void)
+{
+    /* x8 programming (1.8 V supply): 64 us per word, a block takes almost as long as its bus time */
+    sRunStreamTest(64u, "x8 flash");
+}
+
+void test_BspCanXfer_Stream_LostFrame_ResendsFromGap(void)
+{
+    SimSender_t        tSender;
+    BspCanXferStatus_t tStatus;
+
+    sSenderInit(&tSender, 5000u);
+    tSender.uDropFrame = 100u;
+    sSimRun(&tSender);
+
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_DONE, tSender.byStatus);
+    TEST_ASSERT_EQUAL(1u, tSender.uNakReplies);
+    TEST_ASSERT_EQUAL_MEMORY(s_abyImage, s_abySimFlash, tSender.uSize);
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(1u, tStatus.uNaks);
+}
+
+void test_BspCanXfer_Stream_CrcMismatch_Fails(void)
+{
+    SimSender_t        tSender;
+    BspCanXferStatus_t tStatus;
+
+    sSenderInit(&tSender, 3000u);
+    tSender.uCrc ^= 1u;
+    sSimRun(&tSender);
+
+    TEST_ASSERT_EQUAL_UINT8(eBSP_CANXFER_REPLY_ERR_CRC, tSender.byStatus);
+    BspCanXferGetStatus(s_hXfer, &tStatus);
+    TEST_ASSERT_EQUAL(eBSP_CANXFER_STATE_FAILED, tStatus.eState);
+    TEST_ASSERT_EQUAL(3000u, tStatus.uProgrammed);
+}
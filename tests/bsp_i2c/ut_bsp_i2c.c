@@ -40,6 +40,14 @@ typedef struct
     BspI2cMemTxCpltCb_t pMemTxCpltCb;
     BspI2cMemRxCpltCb_t pMemRxCpltCb;
     BspI2cErrorCb_t     pErrorCb;
+    BspI2cXferCb_t      pXferCb;
+    void*               pXferContext;
+    BspXferToken_t*     pXferToken;
+    BspI2cXfer_t        aQueue[BSP_I2C_QUEUE_DEPTH];
+    uint8_t             byQueueHead;
+    uint8_t             byQueueCount;
+    bool                bQueueActive;
+    BspI2cQueueStats_t  tQueueStats;
 } BspI2cModule_t;
 
 extern BspI2cModule_t s_i2cModules[6];
@@ -112,6 +120,13 @@ void setUp(void)
     {
         BspI2cFree(i);
     }
+
+    // Initialised peripherals are ready (HAL_I2C_Init)
+    I2C_HandleTypeDef* halHandles[] = {&hi2c1, &hi2c2, &hi2c3, &hi2c4, &hi2c5, &hi2c6};
+    for (uint8_t i = 0u; i < 6u; i++)
+    {
+        halHandles[i]->State = HAL_I2C_STATE_READY;
+    }
 }
 
 void tearDown(void)
@@ -1102,3 +1117,442 @@ void test_Integration_MultipleInstances_IndependentOperation(void)
     TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cFree(handle2));
     TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cFree(handle3));
 }
+
+// ============================================================================
+// Test Cases: Per-Transfer Callbacks and Completion Tokens
+// ============================================================================
+
+static int           s_xferCallbackCount = 0;
+static void*         s_xferContext       = NULL;
+static BspI2cError_e s_xferError         = eBSP_I2C_ERR_NONE;
+
+static void TestXferCallback(BspI2cHandle_t handle, BspI2cError_e eError, void* pContext)
+{
+    s_lastCallbackHandle = handle;
+    s_xferError          = eError;
+    s_xferContext        = pContext;
+    s_xferCallbackCount++;
+}
+
+void test_BspI2cMemReadIT_PerTransferCallback_ReceivesContextAndCompletesToken(void)
+{
+    // Arrange - instance 4 in the first slot: handle and instance differ
+    s_xferCallbackCount   = 0;
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_4, eBSP_I2C_MODE_INTERRUPT, 0);
+    BspI2cRegisterMemRxCallback(handle, TestMemRxCallback);
+
+    uint8_t           rxData[6];
+    int               sensorContext = 42;
+    BspXferToken_t    token         = {.bDone = true, .iError = -1};
+    BspI2cMemConfig_t config        = {.devAddr     = 0xD0,
+                                       .memAddr     = 0x3B,
+                                       .memAddrSize = eBSP_I2C_MEM_ADDR_SIZE_8BIT,
+                                       .pData       = rxData,
+                                       .length      = 6,
+                                       .pCallback   = TestXferCallback,
+                                       .pContext    = &sensorContext,
+                                       .pToken      = &token};
+
+    HAL_I2C_Mem_Read_IT_ExpectAndReturn(&hi2c4, 0xD0, 0x3B, 1, rxData, 6, HAL_OK);
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cMemReadIT(handle, &config));
+    TEST_ASSERT_FALSE(BspXferIsDone(&token));
+    HAL_I2C_MemRxCpltCallback(&hi2c4);
+
+    // Assert - the per-transfer callback replaces the registered one
+    TEST_ASSERT_TRUE(BspXferIsDone(&token));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspXferGetError(&token));
+    TEST_ASSERT_EQUAL(1, s_xferCallbackCount);
+    TEST_ASSERT_EQUAL_PTR(&sensorContext, s_xferContext);
+    TEST_ASSERT_EQUAL(handle, s_lastCallbackHandle);
+    TEST_ASSERT_FALSE(s_memRxCallbackInvoked);
+
+    // The next transfer without a callback goes to the registered one again
+    config.pCallback = NULL;
+    HAL_I2C_Mem_Read_IT_ExpectAndReturn(&hi2c4, 0xD0, 0x3B, 1, rxData, 6, HAL_OK);
+    BspI2cMemReadIT(handle, &config);
+    HAL_I2C_MemRxCpltCallback(&hi2c4);
+    TEST_ASSERT_TRUE(s_memRxCallbackInvoked);
+    TEST_ASSERT_EQUAL(1, s_xferCallbackCount);
+}
+
+void test_BspI2cTransmitIT_PerTransferCallback_ErrorCompletesToken(void)
+{
+    // Arrange
+    s_xferCallbackCount   = 0;
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+    BspI2cRegisterErrorCallback(handle, TestErrorCallback);
+
+    uint8_t                txData[] = {0x01};
+    BspXferToken_t         token;
+    BspI2cTransferConfig_t config = {.devAddr = 0xA0, .pData = txData, .length = 1, .pCallback = TestXferCallback, .pToken = &token};
+
+    HAL_I2C_Master_Transmit_IT_ExpectAndReturn(&hi2c1, 0xA0, txData, 1, HAL_OK);
+
+    // Act
+    BspI2cTransmitIT(handle, &config);
+    HAL_I2C_ErrorCallback(&hi2c1);
+
+    // Assert
+    TEST_ASSERT_TRUE(BspXferIsDone(&token));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_TRANSFER, BspXferGetError(&token));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_TRANSFER, s_xferError);
+    TEST_ASSERT_EQUAL(1, s_xferCallbackCount);
+    TEST_ASSERT_FALSE(s_errorCallbackInvoked);
+}
+
+void test_BspI2cTransmitIT_TransferInFlight_KeepsItsCompletion(void)
+{
+    // Arrange - first transfer running
+    s_xferCallbackCount   = 0;
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+
+    uint8_t                txData[] = {0x01};
+    BspXferToken_t         first, second = {.bDone = true};
+    BspI2cTransferConfig_t config = {.devAddr = 0xA0, .pData = txData, .length = 1, .pCallback = TestXferCallback, .pToken = &first};
+
+    HAL_I2C_Master_Transmit_IT_ExpectAndReturn(&hi2c1, 0xA0, txData, 1, HAL_OK);
+    BspI2cTransmitIT(handle, &config);
+    hi2c1.State = HAL_I2C_STATE_BUSY_TX;
+
+    // Act - a second request is refused without reaching HAL
+    config.pToken = &second;
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_BUSY, BspI2cTransmitIT(handle, &config));
+    hi2c1.State = HAL_I2C_STATE_READY;
+    HAL_I2C_MasterTxCpltCallback(&hi2c1);
+
+    // Assert - the first transfer completes its own token, the second is untouched
+    TEST_ASSERT_TRUE(BspXferIsDone(&first));
+    TEST_ASSERT_TRUE(BspXferIsDone(&second));
+    TEST_ASSERT_EQUAL(1, s_xferCallbackCount);
+
+    // Unknown HAL handles are ignored
+    I2C_HandleTypeDef other = {0};
+    HAL_I2C_MasterTxCpltCallback(&other);
+    TEST_ASSERT_EQUAL(1, s_xferCallbackCount);
+}
+
+// ============================================================================
+// Test Cases: Interrupt Mode Transaction Queue
+// ============================================================================
+
+static char          s_queueLog[16];
+static uint8_t       s_queueLogLength = 0u;
+static BspI2cError_e s_queueError     = eBSP_I2C_ERR_NONE;
+
+static void QueueResetTrackers(void)
+{
+    memset(s_queueLog, 0, sizeof(s_queueLog));
+    s_queueLogLength = 0u;
+    s_queueError     = eBSP_I2C_ERR_NONE;
+}
+
+// Logs the context as a character: one per completed transaction, in completion order
+static void TestQueueCallback(BspI2cHandle_t handle, BspI2cError_e eError, void* pContext)
+{
+    s_lastCallbackHandle = handle;
+    s_queueError         = eError;
+    if (s_queueLogLength < (sizeof(s_queueLog) - 1u))
+    {
+        s_queueLog[s_queueLogLength++] = (char)(uintptr_t)pContext;
+    }
+}
+
+void test_BspI2cQueueTransfer_IdleBus_StartsImmediately(void)
+{
+    // Arrange
+    QueueResetTrackers();
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+
+    uint8_t        rxData[6];
+    BspXferToken_t token;
+    BspI2cXfer_t   xfer = {.eType       = eBSP_I2C_XFER_MEM_READ,
+                           .devAddr     = 0xD0,
+                           .memAddr     = 0x3B,
+                           .memAddrSize = eBSP_I2C_MEM_ADDR_SIZE_8BIT,
+                           .pData       = rxData,
+                           .length      = 6,
+                           .pCallback   = TestQueueCallback,
+                           .pContext    = (void*)'A',
+                           .pToken      = &token};
+
+    HAL_I2C_Mem_Read_IT_ExpectAndReturn(&hi2c1, 0xD0, 0x3B, 1, rxData, 6, HAL_OK);
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cQueueTransfer(handle, &xfer));
+    TEST_ASSERT_FALSE(BspXferIsDone(&token));
+    HAL_I2C_MemRxCpltCallback(&hi2c1);
+
+    // Assert
+    TEST_ASSERT_EQUAL_STRING("A", s_queueLog);
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, s_queueError);
+    TEST_ASSERT_TRUE(BspXferIsDone(&token));
+
+    BspI2cQueueStats_t stats;
+    BspI2cGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(0u, stats.byPending);
+    TEST_ASSERT_EQUAL_UINT8(1u, stats.byHighWater);
+    TEST_ASSERT_EQUAL(1u, stats.uCompleted);
+}
+
+void test_BspI2cQueueTransfer_ChainsFromCompletionIsr(void)
+{
+    // Arrange - three sensors on one bus
+    QueueResetTrackers();
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+    BspI2cRegisterMemRxCallback(handle, TestMemRxCallback);
+
+    uint8_t      accel[6], gyro[6], cmd[1] = {0xF4}, press[3];
+    BspI2cXfer_t xferAccel = {.eType       = eBSP_I2C_XFER_MEM_READ,
+                              .devAddr     = 0xD0,
+                              .memAddr     = 0x3B,
+                              .memAddrSize = eBSP_I2C_MEM_ADDR_SIZE_8BIT,
+                              .pData       = accel,
+                              .length      = 6,
+                              .pCallback   = TestQueueCallback,
+                              .pContext    = (void*)'a'};
+    BspI2cXfer_t xferGyro  = xferAccel;
+    BspI2cXfer_t xferCmd   = {.eType = eBSP_I2C_XFER_WRITE, .devAddr = 0xEC, .pData = cmd, .length = 1, .pCallback = TestQueueCallback};
+    BspI2cXfer_t xferPress = {.eType = eBSP_I2C_XFER_READ, .devAddr = 0xEC, .pData = press, .length = 3, .pCallback = TestQueueCallback};
+    xferGyro.memAddr       = 0x43;
+    xferGyro.pData         = gyro;
+    xferGyro.pContext      = (void*)'g';
+    xferCmd.pContext       = (void*)'c';
+    xferPress.pContext     = (void*)'p';
+
+    HAL_I2C_Mem_Read_IT_ExpectAndReturn(&hi2c1, 0xD0, 0x3B, 1, accel, 6, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cQueueTransfer(handle, &xferAccel));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cQueueTransfer(handle, &xferGyro));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cQueueTransfer(handle, &xferCmd));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cQueueTransfer(handle, &xferPress));
+
+    // Act - each completion starts the next transaction
+    HAL_I2C_Mem_Read_IT_ExpectAndReturn(&hi2c1, 0xD0, 0x43, 1, gyro, 6, HAL_OK);
+    HAL_I2C_MemRxCpltCallback(&hi2c1);
+    HAL_I2C_Master_Transmit_IT_ExpectAndReturn(&hi2c1, 0xEC, cmd, 1, HAL_OK);
+    HAL_I2C_MemRxCpltCallback(&hi2c1);
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c1, 0xEC, press, 3, HAL_OK);
+    HAL_I2C_MasterTxCpltCallback(&hi2c1);
+    HAL_I2C_MasterRxCpltCallback(&hi2c1);
+
+    // Assert - descriptor callbacks only, registered callback untouched
+    TEST_ASSERT_EQUAL_STRING("agcp", s_queueLog);
+    TEST_ASSERT_FALSE(s_memRxCallbackInvoked);
+
+    BspI2cQueueStats_t stats;
+    BspI2cGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(0u, stats.byPending);
+    TEST_ASSERT_EQUAL_UINT8(4u, stats.byHighWater);
+    TEST_ASSERT_EQUAL(4u, stats.uCompleted);
+}
+
+void test_BspI2cQueueTransfer_Priorities_HigherFirstInFlightKept(void)
+{
+    // Arrange - low priority transaction in flight
+    QueueResetTrackers();
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_2, eBSP_I2C_MODE_INTERRUPT, 0);
+
+    uint8_t                buf[5][2];
+    BspI2cXfer_t           xfer[5];
+    const char             names[] = "LlNHn";
+    const BspI2cPriority_e ePrio[] = {eBSP_I2C_PRIORITY_LOW, eBSP_I2C_PRIORITY_LOW, eBSP_I2C_PRIORITY_NORMAL, eBSP_I2C_PRIORITY_HIGH,
+                                      eBSP_I2C_PRIORITY_NORMAL};
+
+    for (uint8_t i = 0u; i < 5u; i++)
+    {
+        xfer[i] = (BspI2cXfer_t){.eType     = eBSP_I2C_XFER_READ,
+                                 .ePriority = ePrio[i],
+                                 .devAddr   = (uint8_t)(0x10u + (i * 2u)),
+                                 .pData     = buf[i],
+                                 .length    = 2,
+                                 .pCallback = TestQueueCallback,
+                                 .pContext  = (void*)(uintptr_t)names[i]};
+    }
+
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c2, 0x10, buf[0], 2, HAL_OK);
+    BspI2cQueueTransfer(handle, &xfer[0]);
+
+    // Act - queue the rest behind it
+    for (uint8_t i = 1u; i < 5u; i++)
+    {
+        BspI2cQueueTransfer(handle, &xfer[i]);
+    }
+
+    // Assert - H, then N in queue order, then the second L
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c2, 0x16, buf[3], 2, HAL_OK);
+    HAL_I2C_MasterRxCpltCallback(&hi2c2);
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c2, 0x14, buf[2], 2, HAL_OK);
+    HAL_I2C_MasterRxCpltCallback(&hi2c2);
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c2, 0x18, buf[4], 2, HAL_OK);
+    HAL_I2C_MasterRxCpltCallback(&hi2c2);
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c2, 0x12, buf[1], 2, HAL_OK);
+    HAL_I2C_MasterRxCpltCallback(&hi2c2);
+    HAL_I2C_MasterRxCpltCallback(&hi2c2);
+
+    TEST_ASSERT_EQUAL_STRING("LHNnl", s_queueLog);
+}
+
+void test_BspI2cQueueTransfer_QueueFull_ReturnsBusy(void)
+{
+    // Arrange
+    QueueResetTrackers();
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+
+    uint8_t      txData[1] = {0};
+    BspI2cXfer_t xfer      = {.eType = eBSP_I2C_XFER_WRITE, .devAddr = 0xA0, .pData = txData, .length = 1};
+
+    HAL_I2C_Master_Transmit_IT_ExpectAndReturn(&hi2c1, 0xA0, txData, 1, HAL_OK);
+    for (uint8_t i = 0u; i < BSP_I2C_QUEUE_DEPTH; i++)
+    {
+        TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cQueueTransfer(handle, &xfer));
+    }
+
+    // Act
+    BspI2cError_e result = BspI2cQueueTransfer(handle, &xfer);
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_BUSY, result);
+
+    BspI2cQueueStats_t stats;
+    BspI2cGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(BSP_I2C_QUEUE_DEPTH, stats.byPending);
+    TEST_ASSERT_EQUAL_UINT8(BSP_I2C_QUEUE_DEPTH, stats.byHighWater);
+    TEST_ASSERT_EQUAL(1u, stats.uRejected);
+
+    // Reset keeps the current depth as high-water mark
+    BspI2cResetQueueStats(handle);
+    BspI2cGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(BSP_I2C_QUEUE_DEPTH, stats.byHighWater);
+    TEST_ASSERT_EQUAL(0u, stats.uRejected);
+}
+
+void test_BspI2cQueueTransfer_Error_ReportsAndStartsNext(void)
+{
+    // Arrange - a sensor that does not acknowledge, then another one
+    QueueResetTrackers();
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+    BspI2cRegisterErrorCallback(handle, TestErrorCallback);
+
+    uint8_t        rxA[2], rxB[2];
+    BspXferToken_t tokenA;
+    BspI2cXfer_t   xferA = {.eType     = eBSP_I2C_XFER_READ,
+                            .devAddr   = 0x20,
+                            .pData     = rxA,
+                            .length    = 2,
+                            .pCallback = TestQueueCallback,
+                            .pContext  = (void*)'1',
+                            .pToken    = &tokenA};
+    BspI2cXfer_t   xferB = {.eType = eBSP_I2C_XFER_READ, .devAddr = 0x22, .pData = rxB, .length = 2, .pCallback = TestQueueCallback};
+
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c1, 0x20, rxA, 2, HAL_OK);
+    BspI2cQueueTransfer(handle, &xferA);
+    BspI2cQueueTransfer(handle, &xferB);
+
+    // Direct transfers wait for the queue
+    BspI2cTransferConfig_t config = {.devAddr = 0x30, .pData = rxA, .length = 2};
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_BUSY, BspI2cReceiveIT(handle, &config));
+
+    // Act
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c1, 0x22, rxB, 2, HAL_OK);
+    HAL_I2C_ErrorCallback(&hi2c1);
+
+    // Assert
+    TEST_ASSERT_EQUAL_STRING("1", s_queueLog);
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_TRANSFER, s_queueError);
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_TRANSFER, BspXferGetError(&tokenA));
+    TEST_ASSERT_FALSE(s_errorCallbackInvoked);
+
+    BspI2cQueueStats_t stats;
+    BspI2cGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(1u, stats.byPending);
+    TEST_ASSERT_EQUAL(1u, stats.uErrors);
+}
+
+void test_BspI2cQueueTransfer_StartFailure_CompletesWithError(void)
+{
+    // Arrange
+    QueueResetTrackers();
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+
+    uint8_t      txData[2] = {0};
+    BspI2cXfer_t xfer      = {.eType       = eBSP_I2C_XFER_MEM_WRITE,
+                              .devAddr     = 0xA0,
+                              .memAddr     = 0x0100,
+                              .memAddrSize = eBSP_I2C_MEM_ADDR_SIZE_16BIT,
+                              .pData       = txData,
+                              .length      = 2,
+                              .pCallback   = TestQueueCallback,
+                              .pContext    = (void*)'4'};
+
+    HAL_I2C_Mem_Write_IT_ExpectAndReturn(&hi2c1, 0xA0, 0x0100, 2, txData, 2, HAL_ERROR);
+
+    // Act
+    BspI2cError_e result = BspI2cQueueTransfer(handle, &xfer);
+
+    // Assert - accepted, then failed through the callback
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, result);
+    TEST_ASSERT_EQUAL_STRING("4", s_queueLog);
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_TRANSFER, s_queueError);
+
+    BspI2cQueueStats_t stats;
+    BspI2cGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(0u, stats.byPending);
+    TEST_ASSERT_EQUAL(1u, stats.uErrors);
+}
+
+void test_BspI2cQueueTransfer_DirectTransferInFlight_StartsAfterIt(void)
+{
+    // Arrange - direct transfer owns the bus
+    QueueResetTrackers();
+    BspI2cHandle_t handle = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+    BspI2cRegisterTxCallback(handle, TestTxCallback);
+
+    uint8_t                txData[1] = {0x55};
+    uint8_t                rxData[2];
+    BspI2cTransferConfig_t config    = {.devAddr = 0xA0, .pData = txData, .length = 1};
+    BspI2cXfer_t           xfer      = {
+        .eType = eBSP_I2C_XFER_READ, .devAddr = 0x40, .pData = rxData, .length = 2, .pCallback = TestQueueCallback, .pContext = (void*)'d'};
+
+    HAL_I2C_Master_Transmit_IT_ExpectAndReturn(&hi2c1, 0xA0, txData, 1, HAL_OK);
+    BspI2cTransmitIT(handle, &config);
+    hi2c1.State = HAL_I2C_STATE_BUSY_TX;
+
+    // Act - queued without reaching HAL, started from the direct completion
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_NONE, BspI2cQueueTransfer(handle, &xfer));
+    hi2c1.State = HAL_I2C_STATE_READY;
+    HAL_I2C_Master_Receive_IT_ExpectAndReturn(&hi2c1, 0x40, rxData, 2, HAL_OK);
+    HAL_I2C_MasterTxCpltCallback(&hi2c1);
+
+    // Assert
+    TEST_ASSERT_TRUE(s_txCallbackInvoked);
+    TEST_ASSERT_EQUAL_STRING("", s_queueLog);
+    HAL_I2C_MasterRxCpltCallback(&hi2c1);
+    TEST_ASSERT_EQUAL_STRING("d", s_queueLog);
+}
+
+void test_BspI2cQueueTransfer_InvalidParameters(void)
+{
+    // Arrange
+    BspI2cHandle_t handle   = BspI2cAllocate(eBSP_I2C_INSTANCE_1, eBSP_I2C_MODE_INTERRUPT, 0);
+    BspI2cHandle_t blocking = BspI2cAllocate(eBSP_I2C_INSTANCE_2, eBSP_I2C_MODE_BLOCKING, 0);
+
+    uint8_t      data[1];
+    BspI2cXfer_t xfer     = {.eType = eBSP_I2C_XFER_WRITE, .devAddr = 0xA0, .pData = data, .length = 1};
+    BspI2cXfer_t noBuffer = {.eType = eBSP_I2C_XFER_WRITE, .devAddr = 0xA0, .length = 1};
+    BspI2cXfer_t empty    = {.eType = eBSP_I2C_XFER_WRITE, .devAddr = 0xA0, .pData = data};
+    BspI2cXfer_t badType  = {.eType = eBSP_I2C_XFER_TYPE_COUNT, .pData = data, .length = 1};
+    BspI2cXfer_t badPrio  = {.ePriority = eBSP_I2C_PRIORITY_COUNT, .pData = data, .length = 1};
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_HANDLE, BspI2cQueueTransfer(-1, &xfer));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_PARAM, BspI2cQueueTransfer(handle, NULL));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_PARAM, BspI2cQueueTransfer(handle, &noBuffer));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_PARAM, BspI2cQueueTransfer(handle, &empty));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_PARAM, BspI2cQueueTransfer(handle, &badType));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_PARAM, BspI2cQueueTransfer(handle, &badPrio));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_PARAM, BspI2cQueueTransfer(blocking, &xfer));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_HANDLE, BspI2cGetQueueStats(-1, NULL));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_PARAM, BspI2cGetQueueStats(handle, NULL));
+    TEST_ASSERT_EQUAL(eBSP_I2C_ERR_INVALID_HANDLE, BspI2cResetQueueStats(-1));
+}
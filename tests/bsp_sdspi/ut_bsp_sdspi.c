@@ -0,0 +1,888 @@
+/**
+ * @file ut_bsp_sdspi.c
+ * @brief Unit tests for BSP SD card (SPI mode) module
+ *
+ * The driver runs on a real bsp_spi bus against an SD card model behind the
+ * mocked HAL. The model works byte by byte at the bus clock taken from CR1:
+ * commands with NCR delay and R1/R3/R7 responses, read data after an access
+ * time (NAC), data tokens, data responses, programming busy and the CMD12
+ * stuff byte. It flags MOSI not idling high, chip select released while the
+ * card still sends, commands while busy and identification above 400 kHz.
+ * Time is simulated; SysTick fires at every millisecond boundary.
+ */
+
+#include "Mockstm32f4xx_hal_gpio.h"
+#include "bsp_sdspi.h"
+#include "bsp_spi.h"
+#include "gpio_struct.h"
+#include "spi_sim.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================================================
+ * Test Stubs and Mocks
+ * ========================================================================== */
+
+extern void HAL_SYSTICK_Callback(void);
+
+/* Mock SPI peripherals and HAL handles - required by production code */
+static SPI_TypeDef mock_SPI1;
+static SPI_TypeDef mock_SPI2;
+static SPI_TypeDef mock_SPI3;
+static SPI_TypeDef mock_SPI4;
+static SPI_TypeDef mock_SPI5;
+static SPI_TypeDef mock_SPI6;
+
+SPI_HandleTypeDef hspi1 = {.Instance = &mock_SPI1};
+SPI_HandleTypeDef hspi2 = {.Instance = &mock_SPI2};
+SPI_HandleTypeDef hspi3 = {.Instance = &mock_SPI3};
+SPI_HandleTypeDef hspi4 = {.Instance = &mock_SPI4};
+SPI_HandleTypeDef hspi5 = {.Instance = &mock_SPI5};
+SPI_HandleTypeDef hspi6 = {.Instance = &mock_SPI6};
+
+/* Transmit DMA stream: fill transfers clear memory increment */
+static DMA_Stream_TypeDef mock_tx_stream;
+static DMA_HandleTypeDef  mock_hdmatx = {.Instance = &mock_tx_stream};
+
+/* Card chip select on the bsp_gpio pin table */
+static GPIO_TypeDef mock_GPIOB;
+
+const gpio_t gpio_pins[eGPIO_COUNT] = {
+    [eM_FLASH_NCS] = {&mock_GPIOB, GPIO_PIN_12},
+};
+
+/* ============================================================================
+ * SD Card Model
+ * ========================================================================== */
+
+/** Blocks backed by memory; block addresses wrap */
+#define SIM_BLOCKS (64u)
+/** 8 GB SDHC card: C_SIZE 15159 */
+#define SIM_SDHC_C_SIZE (15159u)
+#define SIM_SDHC_BLOCKS ((SIM_SDHC_C_SIZE + 1u) * 1024u)
+/** 128 MB version 1 card: C_SIZE 511, C_SIZE_MULT 7, READ_BL_LEN 9 */
+#define SIM_SDSC_BLOCKS (262144u)
+/** ACMD41 answers idle for this long after the first attempt */
+#define SIM_INIT_NS (20000000uLL)
+/** Read access time for the first block and between blocks of CMD18 */
+#define SIM_NAC_FIRST_NS (200000uLL)
+#define SIM_NAC_NEXT_NS  (20000uLL)
+/** Programming time after a multi-block write block and after the stop token */
+#define SIM_BUSY_MULTI_NS (300000uLL)
+#define SIM_BUSY_STOP_NS  (100000uLL)
+/** Interrupt and DMA restart per transfer */
+#define SIM_XFER_NS (1000uLL)
+/** Identification clock limit: one byte at 400 kHz */
+#define SIM_ID_BYTE_NS (20000uLL)
+#define SIM_NONE       (0xFFFFFFFFu)
+
+/**
+ * @brief What the card does between commands.
+ */
+typedef enum
+{
+    eSIM_MODE_NONE = 0,
+    eSIM_MODE_READ,  /**< Sending blocks after NAC */
+    eSIM_MODE_WRITE, /**< Waiting for data tokens */
+    eSIM_MODE_BUSY   /**< Programming, MISO low */
+} SimMode_e;
+
+/**
+ * @brief Card state.
+ */
+typedef struct
+{
+    bool      bPresent;
+    bool      bSdhc;     /**< SDHC version 2, otherwise SDSC version 1 */
+    bool      bSelected;
+    bool      bIdle;     /**< After CMD0 until ACMD41 completes */
+    bool      bApp;      /**< CMD55 received */
+    bool      bMulti;
+    bool      bCsd;      /**< Read sends the CSD */
+    bool      bToken;    /**< Write data token received */
+    uint8_t   abyCmd[6];
+    uint32_t  uCmdPos;
+    uint8_t   abyOut[600];
+    uint32_t  uOutPos;
+    uint32_t  uOutLen;
+    SimMode_e eMode;
+    SimMode_e eAfterBusy;
+    uint32_t  uBlock;
+    uint32_t  uDataPos;
+    uint8_t   abyLatch[512];
+    uint64_t  uReadyNs;  /**< Read: next token; busy: end of programming */
+    uint64_t  uInitDoneNs;
+    uint64_t  uBusyNs;   /**< Programming time per write block */
+    uint32_t  uErrorBlock;
+    uint32_t  uRejectBlock;
+    uint32_t  uPowerUpBytes; /**< Bytes clocked with chip select high */
+    uint32_t  auCmds[64];
+    uint32_t  uReadBlocks;
+    uint32_t  uWrittenBlocks;
+    uint32_t  uStopTokens;
+    uint32_t  uBusyDeselects;
+    uint32_t  uLastArg;
+    uint32_t  uViolations;
+} SimCard_t;
+
+static uint8_t   s_abyMem[SIM_BLOCKS * 512u];
+static SimCard_t s_tSim;
+
+/* Stub for HAL_GetTick - simulated time */
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(SpiSimNowNs() / SPI_SIM_NS_PER_MS);
+}
+
+static void sSimOut(const uint8_t* pBytes, uint32_t uLength)
+{
+    memcpy(&s_tSim.abyOut[s_tSim.uOutLen], pBytes, uLength);
+    s_tSim.uOutLen += uLength;
+}
+
+static void sSimCsd(uint8_t* pCsd)
+{
+    memset(pCsd, 0, 16u);
+    if (s_tSim.bSdhc)
+    {
+        pCsd[0] = 0x40u;
+        pCsd[5] = 0x59u;
+        pCsd[7] = (uint8_t)((SIM_SDHC_C_SIZE >> 16u) & 0x3Fu);
+        pCsd[8] = (uint8_t)(SIM_SDHC_C_SIZE >> 8u);
+        pCsd[9] = (uint8_t)SIM_SDHC_C_SIZE;
+    }
+    else
+    {
+        pCsd[5]  = 0x59u;
+        pCsd[7]  = 0x7Fu;
+        pCsd[8]  = 0xC0u;
+        pCsd[9]  = 0x03u;
+        pCsd[10] = 0x80u;
+    }
+}
+
+/**
+ * @brief Next read block: data token, data and CRC, or an error token.
+ */
+static void sSimQueueBlock(uint64_t uNs)
+{
+    static const uint8_t abyToken[1] = {0xFEu};
+    static const uint8_t abyCrc[2]   = {0x12u, 0x34u};
+    static const uint8_t abyError[1] = {0x08u};
+    uint32_t             uLength     = s_tSim.bCsd ? 16u : 512u;
+
+    s_tSim.uOutPos = 0u;
+    s_tSim.uOutLen = 0u;
+
+    if (s_tSim.uBlock == s_tSim.uErrorBlock)
+    {
+        /* Out of range: the card stops sending, CMD12 still required for CMD18 */
+        sSimOut(abyError, 1u);
+        s_tSim.eMode = eSIM_MODE_NONE;
+        return;
+    }
+
+    sSimOut(abyToken, 1u);
+    if (s_tSim.bCsd)
+    {
+        sSimCsd(&s_tSim.abyOut[s_tSim.uOutLen]);
+        s_tSim.uOutLen += 16u;
+    }
+    else
+    {
+        sSimOut(&s_abyMem[(s_tSim.uBlock % SIM_BLOCKS) * 512u], 512u);
+        s_tSim.uReadBlocks++;
+    }
+    sSimOut(abyCrc, 2u);
+
+    s_tSim.uBlock++;
+    s_tSim.uReadyNs = uNs + ((uLength + 3u) * SpiSimByteNs()) + SIM_NAC_NEXT_NS;
+
+    if (!s_tSim.bMulti)
+    {
+        s_tSim.eMode = eSIM_MODE_NONE;
+    }
+}
+
+/**
+ * @brief MISO for the next byte.
+ */
+static uint8_t sSimOutput(uint64_t uNs)
+{
+    if (s_tSim.uOutPos < s_tSim.uOutLen)
+    {
+        return s_tSim.abyOut[s_tSim.uOutPos++];
+    }
+
+    if ((s_tSim.eMode == eSIM_MODE_BUSY) && (uNs >= s_tSim.uReadyNs))
+    {
+        s_tSim.eMode = s_tSim.eAfterBusy;
+    }
+
+    if (s_tSim.eMode == eSIM_MODE_BUSY)
+    {
+        return 0x00u;
+    }
+
+    if ((s_tSim.eMode == eSIM_MODE_READ) && (uNs >= s_tSim.uReadyNs))
+    {
+        sSimQueueBlock(uNs);
+        return s_tSim.abyOut[s_tSim.uOutPos++];
+    }
+
+    return 0xFFu;
+}
+
+static uint32_t sSimBlockArg(uint32_t uArg)
+{
+    s_tSim.uLastArg = uArg;
+
+    if (s_tSim.bSdhc)
+    {
+        return uArg;
+    }
+
+    /* Byte addressing: must be block aligned */
+    if ((uArg % 512u) != 0u)
+    {
+        s_tSim.uViolations++;
+    }
+    return uArg / 512u;
+}
+
+/**
+ * @brief Execute a received command: R1 after one byte of NCR, plus payload.
+ */
+static void sSimCommand(uint64_t uNs)
+{
+    uint8_t  byCmd = s_tSim.abyCmd[0] & 0x3Fu;
+    uint32_t uArg  = ((uint32_t)s_tSim.abyCmd[1] << 24u) | ((uint32_t)s_tSim.abyCmd[2] << 16u) | ((uint32_t)s_tSim.abyCmd[3] << 8u) |
+                    s_tSim.abyCmd[4];
+    uint8_t  byCrc = s_tSim.abyCmd[5];
+    bool     bApp  = s_tSim.bApp;
+    uint8_t  abyR[6] = {0xFFu, 0x00u, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+    uint32_t uLength = 2u;
+
+    s_tSim.auCmds[byCmd]++;
+    s_tSim.bApp    = false;
+    s_tSim.uOutPos = 0u;
+    s_tSim.uOutLen = 0u;
+
+    if ((s_tSim.eMode == eSIM_MODE_READ) && (byCmd != 12u))
+    {
+        s_tSim.uViolations++;
+    }
+
+    switch (byCmd)
+    {
+        case 0u:
+            if (s_tSim.uPowerUpBytes < 10u)
+            {
+                s_tSim.uViolations++;
+            }
+            s_tSim.bIdle = (byCrc == 0x95u) || s_tSim.bIdle;
+            s_tSim.eMode = eSIM_MODE_NONE;
+            abyR[1]      = (byCrc == 0x95u) ? 0x01u : 0x09u;
+            break;
+        case 8u:
+            if (!s_tSim.bSdhc)
+            {
+                abyR[1] = 0x05u;
+            }
+            else
+            {
+                abyR[1] = (byCrc == 0x87u) ? 0x01u : 0x09u;
+                abyR[2] = 0x00u;
+                abyR[3] = 0x00u;
+                abyR[4] = s_tSim.abyCmd[3] & 0x0Fu;
+                abyR[5] = s_tSim.abyCmd[4];
+                uLength = 6u;
+            }
+            break;
+        case 55u:
+            abyR[1]     = s_tSim.bIdle ? 0x01u : 0x00u;
+            s_tSim.bApp = true;
+            break;
+        case 41u:
+            if (s_tSim.uInitDoneNs == 0u)
+            {
+                s_tSim.uInitDoneNs = uNs + SIM_INIT_NS;
+            }
+            /* A high capacity card stays idle unless the host supports it */
+            if (bApp && (uNs >= s_tSim.uInitDoneNs) && (!s_tSim.bSdhc || ((uArg & 0x40000000u) != 0u)))
+            {
+                s_tSim.bIdle = false;
+            }
+            abyR[1] = bApp ? (s_tSim.bIdle ? 0x01u : 0x00u) : 0x05u;
+            break;
+        case 58u:
+            abyR[1] = s_tSim.bIdle ? 0x01u : 0x00u;
+            abyR[2] = (uint8_t)(s_tSim.bIdle ? 0x00u : (0x80u | (s_tSim.bSdhc ? 0x40u : 0x00u)));
+            abyR[3] = 0xFFu;
+            abyR[4] = 0x80u;
+            abyR[5] = 0x00u;
+            uLength = 6u;
+            break;
+        case 16u:
+            abyR[1] = (uArg == 512u) ? 0x00u : 0x40u;
+            break;
+        case 9u:
+            s_tSim.bCsd     = true;
+            s_tSim.bMulti   = false;
+            s_tSim.eMode    = eSIM_MODE_READ;
+            s_tSim.uReadyNs = uNs + SIM_NAC_NEXT_NS;
+            break;
+        case 17u:
+        case 18u:
+            s_tSim.uBlock   = sSimBlockArg(uArg);
+            s_tSim.bCsd     = false;
+            s_tSim.bMulti   = (byCmd == 18u);
+            s_tSim.eMode    = eSIM_MODE_READ;
+            s_tSim.uReadyNs = uNs + SIM_NAC_FIRST_NS;
+            break;
+        case 12u:
+            /* Stuff byte (data of the interrupted block), NCR, R1, then a short busy */
+            abyR[0]           = 0x3Cu;
+            abyR[1]           = 0xFFu;
+            abyR[2]           = 0x00u;
+            uLength           = 3u;
+            s_tSim.eMode      = eSIM_MODE_BUSY;
+            s_tSim.eAfterBusy = eSIM_MODE_NONE;
+            s_tSim.uReadyNs   = uNs + (8u * SpiSimByteNs());
+            break;
+        case 24u:
+        case 25u:
+            s_tSim.uBlock = sSimBlockArg(uArg);
+            s_tSim.bMulti = (byCmd == 25u);
+            s_tSim.bToken = false;
+            s_tSim.eMode  = eSIM_MODE_WRITE;
+            break;
+        default:
+            abyR[1] = 0x04u;
+            break;
+    }
+
+    if (s_tSim.bIdle && (byCmd != 0u) && (byCmd != 8u) && (byCmd != 55u) && (byCmd != 41u) && (byCmd != 58u))
+    {
+        s_tSim.uViolations++;
+    }
+
+    sSimOut(abyR, uLength);
+}
+
+/**
+ * @brief Byte received while waiting for or receiving write data.
+ */
+static void sSimWriteByte(uint8_t byTx, uint64_t uNs)
+{
+    if (!s_tSim.bToken)
+    {
+        if (byTx == 0xFFu)
+        {
+            return;
+        }
+
+        if (byTx == (s_tSim.bMulti ? 0xFCu : 0xFEu))
+        {
+            s_tSim.bToken   = true;
+            s_tSim.uDataPos = 0u;
+        }
+        else if (s_tSim.bMulti && (byTx == 0xFDu))
+        {
+            /* Busy one byte after the stop token */
+            static const uint8_t abyStuff[1] = {0xFFu};
+            sSimOut(abyStuff, 1u);
+            s_tSim.uStopTokens++;
+            s_tSim.eMode      = eSIM_MODE_BUSY;
+            s_tSim.eAfterBusy = eSIM_MODE_NONE;
+            s_tSim.uReadyNs   = uNs + SIM_BUSY_STOP_NS;
+        }
+        else
+        {
+            s_tSim.uViolations++;
+        }
+        return;
+    }
+
+    if (s_tSim.uDataPos < 512u)
+    {
+        s_tSim.abyLatch[s_tSim.uDataPos] = byTx;
+    }
+
+    if (++s_tSim.uDataPos < 514u)
+    {
+        return;
+    }
+
+    /* Block and CRC received: data response, then programming */
+    uint8_t byResponse = 0xEBu;
+
+    if (s_tSim.uBlock != s_tSim.uRejectBlock)
+    {
+        memcpy(&s_abyMem[(s_tSim.uBlock % SIM_BLOCKS) * 512u], s_tSim.abyLatch, 512u);
+        s_tSim.uWrittenBlocks++;
+        byResponse = 0xE5u;
+    }
+
+    s_tSim.uOutPos = 0u;
+    s_tSim.uOutLen = 0u;
+    sSimOut(&byResponse, 1u);
+    s_tSim.uBlock++;
+    s_tSim.bToken     = false;
+    s_tSim.eMode      = eSIM_MODE_BUSY;
+    s_tSim.eAfterBusy = s_tSim.bMulti ? eSIM_MODE_WRITE : eSIM_MODE_NONE;
+    s_tSim.uReadyNs   = uNs + s_tSim.uBusyNs;
+}
+
+/**
+ * @brief Clock one byte through the card (full duplex: output before input).
+ */
+static uint8_t sSimByte(uint8_t byTx, uint64_t uNs)
+{
+    if (!s_tSim.bSelected)
+    {
+        s_tSim.uPowerUpBytes++;
+        return 0xFFu;
+    }
+
+    if (!s_tSim.bPresent)
+    {
+        return 0xFFu;
+    }
+
+    if (s_tSim.bIdle && (SpiSimByteNs() < SIM_ID_BYTE_NS))
+    {
+        s_tSim.uViolations++;
+    }
+
+    uint8_t byRx = sSimOutput(uNs);
+
+    if (s_tSim.eMode == eSIM_MODE_BUSY)
+    {
+        /* Commands and data are ignored while programming */
+        if (byTx != 0xFFu)
+        {
+            s_tSim.uViolations++;
+        }
+    }
+    else if ((s_tSim.eMode == eSIM_MODE_WRITE) && (s_tSim.uCmdPos == 0u))
+    {
+        sSimWriteByte(byTx, uNs);
+    }
+    else if ((s_tSim.uCmdPos > 0u) || ((byTx & 0xC0u) == 0x40u))
+    {
+        s_tSim.abyCmd[s_tSim.uCmdPos++] = byTx;
+        if (s_tSim.uCmdPos == sizeof(s_tSim.abyCmd))
+        {
+            s_tSim.uCmdPos = 0u;
+            sSimCommand(uNs);
+        }
+    }
+    else if (byTx != 0xFFu)
+    {
+        /* MOSI must stay high between commands and while reading */
+        s_tSim.uViolations++;
+    }
+    else
+    {
+        /* Idle clock */
+    }
+
+    return byRx;
+}
+
+static void stub_gpio_write_pin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState, int cmock_num_calls)
+{
+    (void)GPIOx;
+    (void)cmock_num_calls;
+
+    if (GPIO_Pin != GPIO_PIN_12)
+    {
+        return;
+    }
+
+    if (PinState == GPIO_PIN_RESET)
+    {
+        s_tSim.bSelected = true;
+        return;
+    }
+
+    if (!s_tSim.bSelected)
+    {
+        return;
+    }
+
+    /* Released while the card still sends: data, response or a block in preparation */
+    if ((s_tSim.uOutPos < s_tSim.uOutLen) || (s_tSim.eMode == eSIM_MODE_READ))
+    {
+        s_tSim.uViolations++;
+    }
+
+    if (s_tSim.eMode == eSIM_MODE_BUSY)
+    {
+        s_tSim.uBusyDeselects++;
+    }
+
+    s_tSim.bSelected = false;
+    s_tSim.uCmdPos   = 0u;
+    s_tSim.uOutPos   = 0u;
+    s_tSim.uOutLen   = 0u;
+}
+
+/**
+ * @brief Run DMA completions and SysTick until the operation ends.
+ *
+ * @return Simulated duration in nanoseconds
+ */
+static uint64_t sSimRun(BspSdSpiHandle_t handle, uint32_t uLimitMs)
+{
+    return SpiSimRun(BspSdSpiIsBusy, handle, uLimitMs);
+}
+
+/* ============================================================================
+ * Test Fixtures
+ * ========================================================================== */
+
+static BspSpiHandle_t   s_hBus  = -1;
+static BspSdSpiHandle_t s_hCard = -1;
+static BspSdSpiError_e  s_eResult;
+static uint32_t         s_uCallbacks;
+
+static void test_card_callback(BspSdSpiHandle_t handle, BspSdSpiError_e eError, void* pContext)
+{
+    TEST_ASSERT_EQUAL(s_hCard, handle);
+    TEST_ASSERT_EQUAL_PTR(&s_uCallbacks, pContext);
+    s_eResult = eError;
+    s_uCallbacks++;
+}
+
+static void sInitCard(void)
+{
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiInit(s_hCard, test_card_callback, &s_uCallbacks));
+    sSimRun(s_hCard, 1000u);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, s_eResult);
+    s_uCallbacks = 0u;
+}
+
+void setUp(void)
+{
+    for (int8_t i = 0; i < (int8_t)BSP_SDSPI_MAX_INSTANCES; i++)
+    {
+        BspSdSpiFree(i);
+    }
+    for (int8_t i = 0; i < 6; i++)
+    {
+        BspSpiFree(i);
+    }
+
+    SpiSimFillPattern(s_abyMem, sizeof(s_abyMem), 0u);
+    memset(&s_tSim, 0, sizeof(s_tSim));
+    s_tSim.bPresent     = true;
+    s_tSim.bSdhc        = true;
+    s_tSim.uBusyNs      = SIM_BUSY_MULTI_NS;
+    s_tSim.uErrorBlock  = SIM_NONE;
+    s_tSim.uRejectBlock = SIM_NONE;
+    s_eResult           = eBSP_SDSPI_ERR_NONE;
+    s_uCallbacks        = 0u;
+
+    mock_SPI1.CR1     = 0u;
+    mock_tx_stream.CR = DMA_SxCR_MINC;
+    hspi1.hdmatx      = &mock_hdmatx;
+
+    SpiSimConfig_t tSimConfig = {.pByte = sSimByte, .uByteNs = 0u, .uXferNs = SIM_XFER_NS, .pOnTick = HAL_SYSTICK_Callback};
+    SpiSimReset(&tSimConfig);
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+
+    BspSdSpiConfig_t tConfig = {.uCsPin = eM_FLASH_NCS, .eInitPrescaler = eBSP_SPI_PRESCALER_256, .ePrescaler = eBSP_SPI_PRESCALER_4};
+
+    s_hBus       = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    tConfig.hBus = s_hBus;
+    s_hCard      = BspSdSpiAllocate(&tConfig);
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_FALSE(BspSdSpiIsBusy(s_hCard));
+    BspSdSpiFree(s_hCard);
+    BspSpiFree(s_hBus);
+    hspi1.hdmatx = NULL;
+}
+
+/* ============================================================================
+ * Initialisation
+ * ========================================================================== */
+
+void test_BspSdSpiInit_Sdhc_ReadsCapacityAtIdentificationClock(void)
+{
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiInit(s_hCard, test_card_callback, &s_uCallbacks));
+    uint64_t uNs = sSimRun(s_hCard, 1000u);
+
+    // Assert - identification below 400 kHz, power-up clocks before CMD0, ACMD41 polled from the timer
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+    TEST_ASSERT_EQUAL(1u, s_tSim.auCmds[0]);
+    TEST_ASSERT_EQUAL(1u, s_tSim.auCmds[9]);
+    TEST_ASSERT_EQUAL(0u, s_tSim.auCmds[16]);
+    TEST_ASSERT_FALSE(s_tSim.bIdle);
+
+    BspSdSpiInfo_t tInfo;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetInfo(s_hCard, &tInfo));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_CARD_SDHC, tInfo.eType);
+    TEST_ASSERT_EQUAL(SIM_SDHC_BLOCKS, tInfo.uBlocks);
+
+    BspSdSpiStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetStats(s_hCard, &tStats));
+    TEST_ASSERT_GREATER_THAN(10u, tStats.uTimerWaits);
+    TEST_ASSERT_EQUAL(s_tSim.auCmds[41], s_tSim.auCmds[55]);
+
+    char acMsg[96];
+    snprintf(acMsg, sizeof(acMsg), "Init %lu ms, %lu ACMD41 attempts", (unsigned long)(uNs / SPI_SIM_NS_PER_MS),
+             (unsigned long)s_tSim.auCmds[41]);
+    TEST_MESSAGE(acMsg);
+}
+
+void test_BspSdSpiInit_VersionOneCard_UsesByteAddressing(void)
+{
+    // Arrange
+    static uint8_t abyData[512];
+    s_tSim.bSdhc = false;
+
+    // Act
+    sInitCard();
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiRead(s_hCard, 3u, abyData, 1u, test_card_callback, &s_uCallbacks));
+    sSimRun(s_hCard, 10u);
+
+    // Assert - CMD16 sets the block length, the address is in bytes
+    BspSdSpiInfo_t tInfo;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetInfo(s_hCard, &tInfo));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_CARD_SDSC_V1, tInfo.eType);
+    TEST_ASSERT_EQUAL(SIM_SDSC_BLOCKS, tInfo.uBlocks);
+    TEST_ASSERT_EQUAL(1u, s_tSim.auCmds[16]);
+    TEST_ASSERT_EQUAL(0u, s_tSim.auCmds[58]);
+
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(3u * 512u, s_tSim.uLastArg);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyMem[3u * 512u], abyData, sizeof(abyData));
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+}
+
+void test_BspSdSpiInit_NoCard_ReportsNoCard(void)
+{
+    // Arrange - MISO floating high
+    static uint8_t abyData[512];
+    s_tSim.bPresent = false;
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiInit(s_hCard, test_card_callback, &s_uCallbacks));
+    sSimRun(s_hCard, 1000u);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NO_CARD, s_eResult);
+
+    BspSdSpiInfo_t tInfo;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NO_CARD, BspSdSpiGetInfo(s_hCard, &tInfo));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NO_CARD, BspSdSpiRead(s_hCard, 0u, abyData, 1u, NULL, NULL));
+}
+
+/* ============================================================================
+ * Reads
+ * ========================================================================== */
+
+void test_BspSdSpiRead_MultiBlock_StreamsNearBusClock(void)
+{
+    // Arrange - 64 blocks (32 KiB) with CMD18
+    static uint8_t abyData[64u * 512u];
+    sInitCard();
+    memset(abyData, 0, sizeof(abyData));
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiRead(s_hCard, 1000u, abyData, 64u, test_card_callback, &s_uCallbacks));
+    uint64_t uNs = sSimRun(s_hCard, 100u);
+
+    // Assert - one command, data by DMA into the buffer, MOSI high and chip select held throughout
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(1u, s_tSim.auCmds[18]);
+    TEST_ASSERT_EQUAL(1u, s_tSim.auCmds[12]);
+    TEST_ASSERT_EQUAL(64u, s_tSim.uReadBlocks);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+    for (uint32_t i = 0u; i < 64u; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyMem[((1000u + i) % SIM_BLOCKS) * 512u], &abyData[i * 512u], 512u);
+    }
+
+    BspSdSpiStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetStats(s_hCard, &tStats));
+    TEST_ASSERT_EQUAL(64u, tStats.uReadBlocks);
+
+    /* Bus limit 21 MHz: 2.625 MB/s; NAC of 20 us per block is the card's share */
+    uint64_t uBusNs = (uint64_t)sizeof(abyData) * 381u;
+    uint32_t uKiBs  = (uint32_t)(((uint64_t)sizeof(abyData) * 1000000000uLL) / (uNs * 1024u));
+    TEST_ASSERT_LESS_THAN((uBusNs * 100u) / 80u, uNs);
+
+    char acMsg[128];
+    snprintf(acMsg, sizeof(acMsg), "Read 32 KiB in %lu us: %lu KiB/s, %lu%% of the bus clock, %lu token polls",
+             (unsigned long)(uNs / 1000u), (unsigned long)uKiBs, (unsigned long)((uBusNs * 100u) / uNs), (unsigned long)tStats.uTokenPolls);
+    TEST_MESSAGE(acMsg);
+}
+
+void test_BspSdSpiRead_ErrorToken_StopsTransmissionWithCardError(void)
+{
+    // Arrange - third block out of range
+    static uint8_t abyData[4u * 512u];
+    sInitCard();
+    s_tSim.uErrorBlock = 12u;
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiRead(s_hCard, 10u, abyData, 4u, test_card_callback, &s_uCallbacks));
+    sSimRun(s_hCard, 200u);
+
+    // Assert - CMD12 still ends the transmission
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_CARD, s_eResult);
+    TEST_ASSERT_EQUAL(1u, s_tSim.auCmds[12]);
+    TEST_ASSERT_EQUAL(2u, s_tSim.uReadBlocks);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+
+    BspSdSpiStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetStats(s_hCard, &tStats));
+    TEST_ASSERT_EQUAL(2u, tStats.uReadBlocks);
+    TEST_ASSERT_FALSE(BspSdSpiIsBusy(s_hCard));
+}
+
+/* ============================================================================
+ * Writes
+ * ========================================================================== */
+
+void test_BspSdSpiWrite_MultiBlock_PollsBusyWithinBurst(void)
+{
+    // Arrange - 8 blocks, 300 us programming each
+    static uint8_t abyData[8u * 512u];
+    SpiSimFillPattern(abyData, sizeof(abyData), 0x5Au);
+    sInitCard();
+    BspSdSpiStats_t tBefore;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetStats(s_hCard, &tBefore));
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiWrite(s_hCard, 20u, abyData, 8u, test_card_callback, &s_uCallbacks));
+    uint64_t uNs = sSimRun(s_hCard, 100u);
+
+    // Assert - CMD25, eight accepted blocks, stop token; no timer wait
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(1u, s_tSim.auCmds[25]);
+    TEST_ASSERT_EQUAL(8u, s_tSim.uWrittenBlocks);
+    TEST_ASSERT_EQUAL(1u, s_tSim.uStopTokens);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(abyData, &s_abyMem[20u * 512u], sizeof(abyData));
+
+    BspSdSpiStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetStats(s_hCard, &tStats));
+    TEST_ASSERT_EQUAL(8u, tStats.uWriteBlocks);
+    TEST_ASSERT_GREATER_THAN(8u, tStats.uBusyPolls);
+    TEST_ASSERT_EQUAL(tBefore.uTimerWaits, tStats.uTimerWaits);
+
+    char acMsg[96];
+    snprintf(acMsg, sizeof(acMsg), "Wrote 4 KiB in %lu us, %lu busy polls", (unsigned long)(uNs / 1000u), (unsigned long)tStats.uBusyPolls);
+    TEST_MESSAGE(acMsg);
+}
+
+void test_BspSdSpiWrite_LongBusy_DeselectsCardAndPollsFromTimer(void)
+{
+    // Arrange - 5 ms programming, longer than the busy burst
+    static uint8_t abyData[512];
+    SpiSimFillPattern(abyData, sizeof(abyData), 0xA5u);
+    sInitCard();
+    BspSdSpiStats_t tBefore;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetStats(s_hCard, &tBefore));
+    s_tSim.uBusyNs = 5u * SPI_SIM_NS_PER_MS;
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiWrite(s_hCard, 7u, abyData, 1u, test_card_callback, &s_uCallbacks));
+    uint64_t uNs = sSimRun(s_hCard, 100u);
+
+    // Assert - CMD24, chip select released while the card programs, done shortly after busy ends
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(1u, s_tSim.auCmds[24]);
+    TEST_ASSERT_GREATER_OR_EQUAL(1u, s_tSim.uBusyDeselects);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(abyData, &s_abyMem[7u * 512u], sizeof(abyData));
+    TEST_ASSERT_LESS_THAN(7u * SPI_SIM_NS_PER_MS, uNs);
+
+    BspSdSpiStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetStats(s_hCard, &tStats));
+    TEST_ASSERT_GREATER_OR_EQUAL(4u, tStats.uTimerWaits - tBefore.uTimerWaits);
+}
+
+void test_BspSdSpiWrite_RejectedBlock_SendsStopTokenWithCardError(void)
+{
+    // Arrange - second of four blocks rejected
+    static uint8_t abyData[4u * 512u];
+    SpiSimFillPattern(abyData, sizeof(abyData), 0x11u);
+    sInitCard();
+    s_tSim.uRejectBlock = 41u;
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiWrite(s_hCard, 40u, abyData, 4u, test_card_callback, &s_uCallbacks));
+    sSimRun(s_hCard, 100u);
+
+    // Assert - no blocks sent after the rejection, transmission ended with the stop token
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_CARD, s_eResult);
+    TEST_ASSERT_EQUAL(1u, s_tSim.uWrittenBlocks);
+    TEST_ASSERT_EQUAL(1u, s_tSim.uStopTokens);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+
+    BspSdSpiStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiGetStats(s_hCard, &tStats));
+    TEST_ASSERT_EQUAL(1u, tStats.uWriteBlocks);
+}
+
+/* ============================================================================
+ * Parameters
+ * ========================================================================== */
+
+void test_BspSdSpi_InvalidRequests_AreRejected(void)
+{
+    // Arrange
+    static uint8_t   abyData[512];
+    BspSdSpiConfig_t tBad = {.hBus = s_hBus, .uCsPin = eM_FLASH_NCS, .ePrescaler = eBSP_SPI_PRESCALER_COUNT};
+
+    // Act / Assert - allocation and handles
+    TEST_ASSERT_EQUAL(BSP_SDSPI_INVALID_HANDLE, BspSdSpiAllocate(NULL));
+    TEST_ASSERT_EQUAL(BSP_SDSPI_INVALID_HANDLE, BspSdSpiAllocate(&tBad));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_INVALID_HANDLE, BspSdSpiInit(-1, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_INVALID_HANDLE, BspSdSpiRead(BSP_SDSPI_MAX_INSTANCES, 0u, abyData, 1u, NULL, NULL));
+    TEST_ASSERT_FALSE(BspSdSpiIsBusy(-1));
+
+    // Before initialisation
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NO_CARD, BspSdSpiWrite(s_hCard, 0u, abyData, 1u, NULL, NULL));
+
+    // During initialisation
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiInit(s_hCard, test_card_callback, &s_uCallbacks));
+    TEST_ASSERT_TRUE(BspSdSpiIsBusy(s_hCard));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_BUSY, BspSdSpiInit(s_hCard, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_BUSY, BspSdSpiFree(s_hCard));
+    sSimRun(s_hCard, 1000u);
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, s_eResult);
+
+    // Block ranges and parameters
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_INVALID_PARAM, BspSdSpiRead(s_hCard, 0u, NULL, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_INVALID_PARAM, BspSdSpiRead(s_hCard, 0u, abyData, 0u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_INVALID_PARAM, BspSdSpiRead(s_hCard, SIM_SDHC_BLOCKS, abyData, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_INVALID_PARAM, BspSdSpiWrite(s_hCard, SIM_SDHC_BLOCKS - 1u, abyData, 2u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_INVALID_PARAM, BspSdSpiGetInfo(s_hCard, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_INVALID_PARAM, BspSdSpiGetStats(s_hCard, NULL));
+
+    // Second request while a read runs
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_NONE, BspSdSpiRead(s_hCard, 0u, abyData, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SDSPI_ERR_BUSY, BspSdSpiWrite(s_hCard, 0u, abyData, 1u, NULL, NULL));
+    sSimRun(s_hCard, 10u);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_abyMem, abyData, sizeof(abyData));
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+}
@@ -4,10 +4,15 @@
  * @note This test file mocks HAL layer functions to test BSP SPI functionality
  */
 
+#include "Mockstm32f4xx_hal_cortex.h"
+#include "Mockstm32f4xx_hal_gpio.h"
 #include "Mockstm32f4xx_hal_spi.h"
 #include "bsp_spi.h"
+#include "gpio_struct.h"
 #include "unity.h"
+#include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 // Forward declarations for HAL callbacks (implemented in production code)
 extern void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi);
@@ -31,6 +36,16 @@ SPI_HandleTypeDef hspi4 = {.Instance = &mock_SPI4};
 SPI_HandleTypeDef hspi5 = {.Instance = &mock_SPI5};
 SPI_HandleTypeDef hspi6 = {.Instance = &mock_SPI6};
 
+// Mock GPIO port for chip-select pins
+static GPIO_TypeDef mock_GPIOB;
+
+// Stub gpio_pins array - required by bsp_gpio dependency (device chip selects)
+const gpio_t gpio_pins[eGPIO_COUNT] = {
+    [eM_FLASH_NCS] = {&mock_GPIOB, GPIO_PIN_12},
+    [eM_WP]        = {&mock_GPIOB, GPIO_PIN_13},
+    /* Remaining pins default to {NULL, 0} */
+};
+
 // Test callback trackers
 static bool           tx_callback_invoked    = false;
 static bool           rx_callback_invoked    = false;
@@ -79,11 +94,20 @@ void setUp(void)
     callback_handle        = -1;
     callback_error         = eBSP_SPI_ERR_NONE;
 
+    // MX_SPIx_Init() leaves the HAL handle ready; mocked transfers never change it
+    hspi1.State = HAL_SPI_STATE_READY;
+    hspi2.State = HAL_SPI_STATE_READY;
+    hspi3.State = HAL_SPI_STATE_READY;
+
     // Free all SPI instances to ensure clean state between tests
     for (int8_t i = 0; i < 6; i++)
     {
         BspSpiFree(i);
     }
+    for (int8_t i = 0; i < (int8_t)BSP_SPI_MAX_DEVICES; i++)
+    {
+        BspSpiDeviceRemove(i);
+    }
 }
 
 void tearDown(void)
@@ -93,6 +117,10 @@ void tearDown(void)
     {
         BspSpiFree(i);
     }
+    for (int8_t i = 0; i < (int8_t)BSP_SPI_MAX_DEVICES; i++)
+    {
+        BspSpiDeviceRemove(i);
+    }
 }
 
 // ============================================================================
@@ -1467,3 +1495,2103 @@ void test_BspSpiTransmitReceiveDMA_NullRxPointer(void)
     // Cleanup
     BspSpiFree(handle);
 }
+
+// ============================================================================
+// DMA Transaction Queue Tests
+// ============================================================================
+
+// Event log shared by the queue stubs and callbacks: 'S' = DMA started, '0'..'9' = callback of that context
+static char          queue_log[32];
+static uint32_t      queue_log_len  = 0u;
+static uint32_t      queue_cb_count = 0u;
+static BspSpiError_e queue_cb_error = eBSP_SPI_ERR_NONE;
+
+static void queue_log_event(char event)
+{
+    if (queue_log_len < (sizeof(queue_log) - 1u))
+    {
+        queue_log[queue_log_len++] = event;
+        queue_log[queue_log_len]   = '\0';
+    }
+}
+
+static void test_queue_callback(BspSpiHandle_t handle, BspSpiError_e eError, void* pContext)
+{
+    (void)handle;
+    queue_cb_count++;
+    queue_cb_error = eError;
+    queue_log_event((char)('0' + (uintptr_t)pContext));
+}
+
+static HAL_StatusTypeDef stub_transmit_dma(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, int cmock_num_calls)
+{
+    (void)hspi;
+    (void)pData;
+    (void)Size;
+    (void)cmock_num_calls;
+    queue_log_event('S');
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef stub_receive_dma(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, int cmock_num_calls)
+{
+    (void)hspi;
+    (void)pData;
+    (void)Size;
+    (void)cmock_num_calls;
+    queue_log_event('S');
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef stub_transmit_receive_dma(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size,
+                                                   int cmock_num_calls)
+{
+    (void)hspi;
+    (void)pTxData;
+    (void)pRxData;
+    (void)Size;
+    (void)cmock_num_calls;
+    queue_log_event('S');
+    return HAL_OK;
+}
+
+static void queue_reset_trackers(void)
+{
+    queue_log[0]   = '\0';
+    queue_log_len  = 0u;
+    queue_cb_count = 0u;
+    queue_cb_error = eBSP_SPI_ERR_NONE;
+}
+
+void test_BspSpiQueueTransfer_IdleBus_StartsImmediately(void)
+{
+    // Arrange
+    queue_reset_trackers();
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, handle);
+
+    uint8_t      txData[] = {0x9F, 0x00, 0x00};
+    BspSpiXfer_t xfer     = {.pTxData = txData, .uLength = sizeof(txData), .pCallback = test_queue_callback, .pContext = (void*)1};
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, sizeof(txData), HAL_OK);
+
+    // Act
+    BspSpiError_e result = BspSpiQueueTransfer(handle, &xfer);
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+
+    BspSpiQueueStats_t stats;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiGetQueueStats(handle, &stats));
+    TEST_ASSERT_EQUAL_UINT8(1u, stats.byPending);
+    TEST_ASSERT_EQUAL_UINT8(1u, stats.byHighWater);
+
+    // Completion releases the slot and reports success
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(1u, queue_cb_count);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, queue_cb_error);
+    BspSpiGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(0u, stats.byPending);
+    TEST_ASSERT_EQUAL(1u, stats.uCompleted);
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+void test_BspSpiQueueTransfer_ChainsFromCompletionIsr(void)
+{
+    // Arrange - IMU read (full duplex), ADC read (receive only), flash write (transmit only)
+    queue_reset_trackers();
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, handle);
+    BspSpiRegisterTxCallback(handle, test_tx_callback);
+    BspSpiRegisterRxCallback(handle, test_rx_callback);
+    BspSpiRegisterTxRxCallback(handle, test_txrx_callback);
+
+    uint8_t      imuTx[7] = {0xBB}, imuRx[7], adcRx[4], flashTx[16] = {0x02};
+    BspSpiXfer_t imu      = {.pTxData = imuTx, .pRxData = imuRx, .uLength = 7u, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiXfer_t adc      = {.pRxData = adcRx, .uLength = 4u, .pCallback = test_queue_callback, .pContext = (void*)2};
+    BspSpiXfer_t flash    = {.pTxData = flashTx, .uLength = 16u, .pCallback = test_queue_callback, .pContext = (void*)3};
+
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+    HAL_SPI_Receive_DMA_StubWithCallback(stub_receive_dma);
+    HAL_SPI_TransmitReceive_DMA_StubWithCallback(stub_transmit_receive_dma);
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiQueueTransfer(handle, &imu));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiQueueTransfer(handle, &adc));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiQueueTransfer(handle, &flash));
+    TEST_ASSERT_EQUAL_STRING("S", queue_log);
+
+    HAL_SPI_TxRxCpltCallback(&hspi1);
+    HAL_SPI_RxCpltCallback(&hspi1);
+    HAL_SPI_TxCpltCallback(&hspi1);
+
+    // Assert - each next transfer is started before the previous callback runs
+    TEST_ASSERT_EQUAL_STRING("SS1S23", queue_log);
+    TEST_ASSERT_FALSE(tx_callback_invoked);
+    TEST_ASSERT_FALSE(rx_callback_invoked);
+    TEST_ASSERT_FALSE(txrx_callback_invoked);
+
+    BspSpiQueueStats_t stats;
+    BspSpiGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(0u, stats.byPending);
+    TEST_ASSERT_EQUAL_UINT8(3u, stats.byHighWater);
+    TEST_ASSERT_EQUAL(3u, stats.uCompleted);
+    TEST_ASSERT_EQUAL(0u, stats.uErrors);
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+void test_BspSpiQueueTransfer_QueueFull_ReturnsBusy(void)
+{
+    // Arrange
+    queue_reset_trackers();
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_2, eBSP_SPI_MODE_DMA, 0);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, handle);
+
+    uint8_t      txData[2] = {0};
+    BspSpiXfer_t xfer      = {.pTxData = txData, .uLength = sizeof(txData)};
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi2, txData, sizeof(txData), HAL_OK);
+    for (uint32_t i = 0u; i < BSP_SPI_QUEUE_DEPTH; i++)
+    {
+        TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiQueueTransfer(handle, &xfer));
+    }
+
+    // Act
+    BspSpiError_e result = BspSpiQueueTransfer(handle, &xfer);
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, result);
+
+    BspSpiQueueStats_t stats;
+    BspSpiGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(BSP_SPI_QUEUE_DEPTH, stats.byPending);
+    TEST_ASSERT_EQUAL_UINT8(BSP_SPI_QUEUE_DEPTH, stats.byHighWater);
+    TEST_ASSERT_EQUAL(1u, stats.uRejected);
+
+    // Reset keeps the current depth as high-water mark
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiResetQueueStats(handle));
+    BspSpiGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(BSP_SPI_QUEUE_DEPTH, stats.byHighWater);
+    TEST_ASSERT_EQUAL(0u, stats.uRejected);
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+void test_BspSpiQueueTransfer_InvalidParameters(void)
+{
+    // Arrange
+    BspSpiHandle_t handle   = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiHandle_t blocking = BspSpiAllocate(eBSP_SPI_INSTANCE_2, eBSP_SPI_MODE_BLOCKING, 0);
+    uint8_t        data[4]  = {0};
+    BspSpiXfer_t   xfer     = {.pTxData = data, .uLength = sizeof(data)};
+    BspSpiXfer_t   noBuffer = {.uLength = sizeof(data)};
+    BspSpiXfer_t   empty    = {.pTxData = data, .uLength = 0u};
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiQueueTransfer(-1, &xfer));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiQueueTransfer(handle, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiQueueTransfer(handle, &noBuffer));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiQueueTransfer(handle, &empty));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiQueueTransfer(blocking, &xfer));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiGetQueueStats(handle, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiGetQueueStats(-1, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiResetQueueStats(-1));
+
+    // Cleanup
+    BspSpiFree(handle);
+    BspSpiFree(blocking);
+}
+
+void test_BspSpiQueueTransfer_DmaError_ReportsAndStartsNext(void)
+{
+    // Arrange
+    queue_reset_trackers();
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterErrorCallback(handle, test_error_callback);
+
+    uint8_t      rxA[2], rxB[2];
+    BspSpiXfer_t xferA = {.pRxData = rxA, .uLength = 2u, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiXfer_t xferB = {.pRxData = rxB, .uLength = 2u, .pCallback = test_queue_callback, .pContext = (void*)2};
+
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, rxA, 2u, HAL_OK);
+    BspSpiQueueTransfer(handle, &xferA);
+    BspSpiQueueTransfer(handle, &xferB);
+
+    // Act
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, rxB, 2u, HAL_OK);
+    HAL_SPI_ErrorCallback(&hspi1);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, queue_cb_count);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, queue_cb_error);
+    TEST_ASSERT_FALSE(error_callback_invoked);
+
+    BspSpiQueueStats_t stats;
+    BspSpiGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(1u, stats.byPending);
+    TEST_ASSERT_EQUAL(1u, stats.uErrors);
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+void test_BspSpiQueueTransfer_Token_CompletedBeforeCallback(void)
+{
+    // Arrange - SPI3 in the first slot, one transfer with a token only
+    queue_reset_trackers();
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_3, eBSP_SPI_MODE_DMA, 0);
+
+    uint8_t        rxA[2], rxB[2];
+    BspXferToken_t tokenA = {.bDone = true, .iError = -1};
+    BspXferToken_t tokenB;
+    BspSpiXfer_t   xferA = {.pRxData = rxA, .uLength = 2u, .pToken = &tokenA};
+    BspSpiXfer_t   xferB = {.pRxData = rxB, .uLength = 2u, .pCallback = test_queue_callback, .pToken = &tokenB};
+
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi3, rxA, 2u, HAL_OK);
+    BspSpiQueueTransfer(handle, &xferA);
+    BspSpiQueueTransfer(handle, &xferB);
+    TEST_ASSERT_FALSE(BspXferIsDone(&tokenA));
+
+    // Act
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi3, rxB, 2u, HAL_OK);
+    HAL_SPI_RxCpltCallback(&hspi3);
+    HAL_SPI_ErrorCallback(&hspi3);
+
+    // Assert
+    TEST_ASSERT_TRUE(BspXferIsDone(&tokenA));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspXferGetError(&tokenA));
+    TEST_ASSERT_TRUE(BspXferIsDone(&tokenB));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, BspXferGetError(&tokenB));
+    TEST_ASSERT_EQUAL(1u, queue_cb_count);
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+void test_BspSpiQueueTransfer_StartFailure_CompletesWithError(void)
+{
+    // Arrange
+    queue_reset_trackers();
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    uint8_t      txData[2] = {0};
+    BspSpiXfer_t xfer      = {.pTxData = txData, .uLength = 2u, .pCallback = test_queue_callback, .pContext = (void*)4};
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, 2u, HAL_ERROR);
+
+    // Act
+    BspSpiError_e result = BspSpiQueueTransfer(handle, &xfer);
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+    TEST_ASSERT_EQUAL_STRING("4", queue_log);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, queue_cb_error);
+
+    BspSpiQueueStats_t stats;
+    BspSpiGetQueueStats(handle, &stats);
+    TEST_ASSERT_EQUAL_UINT8(0u, stats.byPending);
+    TEST_ASSERT_EQUAL(1u, stats.uErrors);
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+void test_BspSpiQueueTransfer_DirectTransferInFlight_StartsAfterIt(void)
+{
+    // Arrange - direct DMA transfer owns the bus, HAL reports busy
+    queue_reset_trackers();
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterTxCallback(handle, test_tx_callback);
+
+    uint8_t      txData[2] = {0};
+    BspSpiXfer_t xfer      = {.pTxData = txData, .uLength = 2u, .pCallback = test_queue_callback, .pContext = (void*)1};
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, 2u, HAL_BUSY);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiQueueTransfer(handle, &xfer));
+    TEST_ASSERT_EQUAL(0u, queue_cb_count);
+
+    // Direct functions are refused while queued work is pending
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiTransmitDMA(handle, txData, 2u));
+
+    // Act - direct transfer completes
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, 2u, HAL_OK);
+    HAL_SPI_TxCpltCallback(&hspi1);
+
+    // Assert - direct callback delivered, queued transfer now in flight
+    TEST_ASSERT_TRUE(tx_callback_invoked);
+    TEST_ASSERT_EQUAL(0u, queue_cb_count);
+
+    tx_callback_invoked = false;
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_FALSE(tx_callback_invoked);
+    TEST_ASSERT_EQUAL(1u, queue_cb_count);
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+// ============================================================================
+// Shared Bus Device Tests
+// ============================================================================
+
+// Chip-select events: 'a'/'A' = flash CS low/high, 'b'/'B' = sensor CS low/high
+static void stub_gpio_write_pin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState, int cmock_num_calls)
+{
+    (void)GPIOx;
+    (void)cmock_num_calls;
+    char event = (GPIO_Pin == GPIO_PIN_12) ? 'a' : 'b';
+    queue_log_event((PinState == GPIO_PIN_SET) ? (char)(event - 'a' + 'A') : event);
+}
+
+static BspSpiDeviceHandle_t add_device(BspSpiHandle_t bus, uint32_t csPin, BspSpiClockMode_e mode, BspSpiPrescaler_e prescaler)
+{
+    BspSpiDeviceConfig_t config = {.hBus = bus, .uCsPin = csPin, .eClockMode = mode, .ePrescaler = prescaler};
+    return BspSpiDeviceAdd(&config);
+}
+
+void test_BspSpiDeviceAdd_ReleasesChipSelect(void)
+{
+    // Arrange
+    BspSpiHandle_t bus      = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiHandle_t blocking = BspSpiAllocate(eBSP_SPI_INSTANCE_2, eBSP_SPI_MODE_BLOCKING, 0);
+
+    HAL_GPIO_WritePin_Expect(&mock_GPIOB, GPIO_PIN_12, GPIO_PIN_SET);
+
+    // Act
+    BspSpiDeviceHandle_t device = add_device(bus, eM_FLASH_NCS, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+
+    // Assert
+    TEST_ASSERT_GREATER_OR_EQUAL(0, device);
+    TEST_ASSERT_EQUAL(-1, add_device(blocking, eM_WP, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2));
+    TEST_ASSERT_EQUAL(-1, add_device(-1, eM_WP, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2));
+    TEST_ASSERT_EQUAL(-1, add_device(bus, eM_WP, eBSP_SPI_CLOCK_MODE_COUNT, eBSP_SPI_PRESCALER_2));
+    TEST_ASSERT_EQUAL(-1, add_device(bus, eM_WP, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_COUNT));
+    TEST_ASSERT_EQUAL(-1, BspSpiDeviceAdd(NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiDeviceRemove(-1));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiDeviceQueueTransfer(-1, NULL));
+}
+
+void test_BspSpiDeviceQueueTransfer_BackToBackAcrossDevices(void)
+{
+    // Arrange - flash (mode 0, fPCLK/2) and sensor (mode 3, fPCLK/16) on SPI1
+    queue_reset_trackers();
+    mock_SPI1.CR1 = SPI_CR1_SPE;
+    BspSpiHandle_t bus = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+    HAL_SPI_TransmitReceive_DMA_StubWithCallback(stub_transmit_receive_dma);
+
+    BspSpiDeviceHandle_t flash  = add_device(bus, eM_FLASH_NCS, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+    BspSpiDeviceHandle_t sensor = add_device(bus, eM_WP, eBSP_SPI_CLOCK_MODE_3, eBSP_SPI_PRESCALER_16);
+    queue_reset_trackers();
+
+    uint8_t      cmd[4] = {0x03}, page[8] = {0}, sensorTx[3] = {0x8F}, sensorRx[3];
+    BspSpiXfer_t read1  = {.pTxData = cmd, .uLength = 4u, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiXfer_t read2  = {.pTxData = page, .uLength = 8u, .pCallback = test_queue_callback, .pContext = (void*)2};
+    BspSpiXfer_t sample = {.pTxData = sensorTx, .pRxData = sensorRx, .uLength = 3u, .pCallback = test_queue_callback, .pContext = (void*)3};
+
+    // Act
+    BspSpiDeviceQueueTransfer(flash, &read1);
+    BspSpiDeviceQueueTransfer(flash, &read2);
+    BspSpiDeviceQueueTransfer(sensor, &sample);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiDeviceRemove(sensor));
+
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_TxRxCpltCallback(&hspi1);
+
+    // Assert - CS released and next CS asserted in the completion path, before each callback
+    TEST_ASSERT_EQUAL_STRING("aSAaS1AbS2B3", queue_log);
+
+    // Only the switch to the sensor touched CR1
+    BspSpiQueueStats_t stats;
+    BspSpiGetQueueStats(bus, &stats);
+    TEST_ASSERT_EQUAL(1u, stats.uReconfigs);
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_CPOL | SPI_CR1_CPHA | (3u << SPI_CR1_BR_Pos), mock_SPI1.CR1);
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_CPOL, hspi1.Init.CLKPolarity);
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_CPHA, hspi1.Init.CLKPhase);
+    TEST_ASSERT_EQUAL_HEX32(3u << SPI_CR1_BR_Pos, hspi1.Init.BaudRatePrescaler);
+
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(sensor));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(flash));
+}
+
+void test_BspSpiDeviceQueueTransfer_StartFailure_ReleasesChipSelect(void)
+{
+    // Arrange
+    queue_reset_trackers();
+    BspSpiHandle_t bus = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    BspSpiDeviceHandle_t flash = add_device(bus, eM_FLASH_NCS, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+    queue_reset_trackers();
+
+    uint8_t      cmd[1] = {0x06};
+    BspSpiXfer_t xfer   = {.pTxData = cmd, .uLength = 1u, .pCallback = test_queue_callback, .pContext = (void*)4};
+    BspSpiXfer_t empty  = {.pTxData = cmd, .uLength = 0u};
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, cmd, 1u, HAL_ERROR);
+
+    // Act
+    BspSpiError_e result = BspSpiDeviceQueueTransfer(flash, &xfer);
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+    TEST_ASSERT_EQUAL_STRING("aA4", queue_log);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, queue_cb_error);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiDeviceQueueTransfer(flash, &empty));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(flash));
+}
+
+void test_BspSpiDeviceQueueTransfer_DirectDmaInFlight_DefersSelect(void)
+{
+    // Arrange - direct DMA transfer running in mode 3, flash device in mode 0
+    queue_reset_trackers();
+    mock_SPI1.CR1      = SPI_CR1_SPE | SPI_CR1_CPOL | SPI_CR1_CPHA;
+    BspSpiHandle_t bus = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterTxCallback(bus, test_tx_callback);
+
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    BspSpiDeviceHandle_t flash = add_device(bus, eM_FLASH_NCS, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+    queue_reset_trackers();
+
+    uint8_t      direct[4] = {0}, cmd[1] = {0x06};
+    BspSpiXfer_t xfer      = {.pTxData = cmd, .uLength = 1u, .pCallback = test_queue_callback, .pContext = (void*)1};
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, direct, sizeof(direct), HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmitDMA(bus, direct, sizeof(direct)));
+    hspi1.State     = HAL_SPI_STATE_BUSY_TX;
+    uint32_t runCr1 = mock_SPI1.CR1;
+
+    // Act - strict mock: starting the queued transfer now would fail the test
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(flash, &xfer));
+
+    // Assert - neither chip select nor the running transfer's format touched
+    TEST_ASSERT_EQUAL_STRING("", queue_log);
+    TEST_ASSERT_EQUAL_HEX32(runCr1, mock_SPI1.CR1);
+
+    // Direct transfer done: the device is selected and started from its completion
+    hspi1.State = HAL_SPI_STATE_READY;
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, cmd, 1u, HAL_OK);
+    HAL_SPI_TxCpltCallback(&hspi1);
+
+    TEST_ASSERT_TRUE(tx_callback_invoked);
+    TEST_ASSERT_EQUAL_STRING("a", queue_log);
+    TEST_ASSERT_EQUAL_HEX32(0u, mock_SPI1.CR1 & (SPI_CR1_CPOL | SPI_CR1_CPHA));
+
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_STRING("aA1", queue_log);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(flash));
+}
+
+// ============================================================================
+// Short Transfer Fast Path Tests
+// ============================================================================
+
+// Polled path on SPI1: HAL idle, RXNE always set (host DR reads back the byte written)
+static BspSpiHandle_t fast_path_allocate(BspSpiMode_e mode)
+{
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, mode, 1000);
+    hspi1.State           = HAL_SPI_STATE_READY;
+    mock_SPI1.CR1         = 0u;
+    mock_SPI1.SR          = SPI_SR_RXNE | SPI_SR_TXE;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSetFastPath(handle, 4u));
+    return handle;
+}
+
+static void fast_path_cleanup(void)
+{
+    hspi1.State   = HAL_SPI_STATE_RESET;
+    mock_SPI1.SR  = 0u;
+    mock_SPI1.CR1 = 0u;
+}
+
+void test_BspSpiSetFastPath_InvalidParameters(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_BLOCKING, 0);
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiSetFastPath(-1, 4u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSetFastPath(handle, BSP_SPI_FAST_PATH_MAX + 1u));
+
+    hspi1.Init.DataSize = 0x800u; // 16-bit frames
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSetFastPath(handle, 2u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSetFastPath(handle, 0u));
+    hspi1.Init.DataSize = SPI_DATASIZE_8BIT;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSetFastPath(handle, BSP_SPI_FAST_PATH_MAX));
+}
+
+void test_BspSpiTransmitReceive_FastPath_BypassesHal(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = fast_path_allocate(eBSP_SPI_MODE_BLOCKING);
+    uint8_t        txData[] = {0x9F, 0x12, 0x34};
+    uint8_t        rxData[3] = {0};
+
+    // Act - no HAL expectations: any HAL call fails the test
+    BspSpiError_e result = BspSpiTransmitReceive(handle, txData, rxData, sizeof(txData));
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(txData, rxData, sizeof(txData));
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_SPE, mock_SPI1.CR1 & SPI_CR1_SPE);
+
+    // Above the threshold HAL is used again
+    uint8_t longData[5] = {0};
+    HAL_SPI_Transmit_ExpectAndReturn(&hspi1, longData, sizeof(longData), 1000, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmit(handle, longData, sizeof(longData)));
+
+    // Cleanup
+    fast_path_cleanup();
+}
+
+void test_BspSpiReceiveDMA_FastPath_CompletesBeforeReturn(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = fast_path_allocate(eBSP_SPI_MODE_DMA);
+    BspSpiRegisterRxCallback(handle, test_rx_callback);
+    uint8_t rxData[2] = {0};
+
+    // Act
+    BspSpiError_e result = BspSpiReceiveDMA(handle, rxData, sizeof(rxData));
+
+    // Assert - 0xFF clocked out and looped back, callback already done
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+    TEST_ASSERT_TRUE(rx_callback_invoked);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, rxData[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, rxData[1]);
+
+    // A HAL transfer in flight keeps short transfers on the DMA path
+    hspi1.State = HAL_SPI_STATE_BUSY_TX;
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, rxData, sizeof(rxData), HAL_BUSY);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiReceiveDMA(handle, rxData, sizeof(rxData)));
+
+    // Cleanup
+    fast_path_cleanup();
+}
+
+void test_BspSpiTransmit_FastPath_NoClock_ReportsTimeout(void)
+{
+    // Arrange
+    BspSpiHandle_t handle   = fast_path_allocate(eBSP_SPI_MODE_BLOCKING);
+    uint8_t        txData[] = {0x06};
+    mock_SPI1.SR            = SPI_SR_TXE;
+
+    // Act
+    BspSpiError_e result = BspSpiTransmit(handle, txData, sizeof(txData));
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TIMEOUT, result);
+
+    // Cleanup
+    fast_path_cleanup();
+}
+
+void test_BspSpiTransmitReceive_FastPath_HostCallOverhead(void)
+{
+    // Arrange - 2-byte register read, as issued by the control loop
+    BspSpiHandle_t handle   = fast_path_allocate(eBSP_SPI_MODE_BLOCKING);
+    uint8_t        txData[] = {0x80 | 0x0F, 0x00};
+    uint8_t        rxData[2];
+    const uint32_t calls    = 1000000u;
+    uint32_t       failures = 0u;
+
+    // Act
+    clock_t start = clock();
+    for (uint32_t i = 0u; i < calls; i++)
+    {
+        failures += (BspSpiTransmitReceive(handle, txData, rxData, sizeof(txData)) != eBSP_SPI_ERR_NONE) ? 1u : 0u;
+    }
+    clock_t elapsed = clock() - start;
+
+    // Assert - timing is reported only, it depends on the host
+    char message[96];
+    snprintf(message, sizeof(message), "fast path: %.1f ns per 2-byte call (host)",
+             ((double)elapsed * 1e9) / ((double)CLOCKS_PER_SEC * (double)calls));
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL_UINT32(0u, failures);
+
+    // Cleanup
+    fast_path_cleanup();
+}
+
+// ============================================================================
+// Chunked Transfer Tests
+// ============================================================================
+
+// Larger than three HAL-sized chunks (65535 bytes each)
+static uint8_t chunk_buffer[200000];
+
+void test_BspSpiTransmit_LongTransfer_SplitsIntoChunks(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_BLOCKING, 100);
+
+    HAL_SPI_Transmit_ExpectAndReturn(&hspi1, chunk_buffer, 65535u, 100, HAL_OK);
+    HAL_SPI_Transmit_ExpectAndReturn(&hspi1, &chunk_buffer[65535], 4465u, 100, HAL_OK);
+
+    // Act
+    BspSpiError_e result = BspSpiTransmit(handle, chunk_buffer, 70000u);
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+}
+
+void test_BspSpiTransmitReceive_LongTransfer_StopsAtFailingChunk(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_BLOCKING, 100);
+
+    HAL_SPI_TransmitReceive_ExpectAndReturn(&hspi1, chunk_buffer, chunk_buffer, 65535u, 100, HAL_OK);
+    HAL_SPI_TransmitReceive_ExpectAndReturn(&hspi1, &chunk_buffer[65535], &chunk_buffer[65535], 65535u, 100, HAL_TIMEOUT);
+
+    // Act
+    BspSpiError_e result = BspSpiTransmitReceive(handle, chunk_buffer, chunk_buffer, 140000u);
+
+    // Assert - the third chunk is never started
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TIMEOUT, result);
+}
+
+void test_BspSpiTransmitDMA_LongTransfer_RearmsFromIsr(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterTxCallback(handle, test_tx_callback);
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, chunk_buffer, 65535u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmitDMA(handle, chunk_buffer, sizeof(chunk_buffer)));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiTransmitDMA(handle, chunk_buffer, 1u));
+
+    // Act & Assert - each chunk is started from the previous completion, one callback at the end
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, &chunk_buffer[65535], 65535u, HAL_OK);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, &chunk_buffer[131070], 65535u, HAL_OK);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, &chunk_buffer[196605], 3395u, HAL_OK);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_FALSE(tx_callback_invoked);
+
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_TRUE(tx_callback_invoked);
+    TEST_ASSERT_EQUAL(handle, callback_handle);
+}
+
+void test_BspSpiReceiveDMA_LongTransfer_ChunkStartFailure_ReportsError(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterRxCallback(handle, test_rx_callback);
+    BspSpiRegisterErrorCallback(handle, test_error_callback);
+
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, chunk_buffer, 65535u, HAL_OK);
+    BspSpiReceiveDMA(handle, chunk_buffer, 70000u);
+
+    // Act
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, &chunk_buffer[65535], 4465u, HAL_ERROR);
+    HAL_SPI_RxCpltCallback(&hspi1);
+
+    // Assert - reported once as an error, and the bus is free again
+    TEST_ASSERT_FALSE(rx_callback_invoked);
+    TEST_ASSERT_TRUE(error_callback_invoked);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, callback_error);
+
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, chunk_buffer, 1u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiReceiveDMA(handle, chunk_buffer, 1u));
+}
+
+void test_BspSpiDeviceQueueTransfer_LongTransfer_KeepsChipSelect(void)
+{
+    // Arrange
+    queue_reset_trackers();
+    BspSpiHandle_t bus = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    HAL_SPI_Receive_DMA_StubWithCallback(stub_receive_dma);
+    BspSpiDeviceHandle_t flash = add_device(bus, eM_FLASH_NCS, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+    queue_reset_trackers();
+
+    BspSpiXfer_t xfer = {.pRxData = chunk_buffer, .uLength = 70000u, .pCallback = test_queue_callback, .pContext = (void*)5};
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(flash, &xfer));
+    HAL_SPI_RxCpltCallback(&hspi1);
+    HAL_SPI_RxCpltCallback(&hspi1);
+
+    // Assert - CS stays low across both chunks, one completion
+    TEST_ASSERT_EQUAL_STRING("aSSA5", queue_log);
+    TEST_ASSERT_EQUAL(1u, queue_cb_count);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, queue_cb_error);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(flash));
+}
+
+// ============================================================================
+// Scatter-Gather Transfer Tests
+// ============================================================================
+
+void test_BspSpiTransferV_MixedSegments_RearmsPerSegment(void)
+{
+    // Arrange - header (TX only), status (RX only), exchange (full duplex)
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterTxCallback(handle, test_tx_callback);
+    BspSpiRegisterRxCallback(handle, test_rx_callback);
+    BspSpiRegisterTxRxCallback(handle, test_txrx_callback);
+
+    uint8_t               header[4] = {0x02, 0x00, 0x10, 0x00};
+    uint8_t               status[2] = {0};
+    uint8_t               txData[3] = {0x01, 0x02, 0x03};
+    uint8_t               rxData[3] = {0};
+    const BspSpiSegment_t segments[] = {
+        {.pTxData = header, .uLength = sizeof(header)},
+        {.pRxData = status, .uLength = sizeof(status)},
+        {.pTxData = txData, .pRxData = rxData, .uLength = sizeof(txData)},
+    };
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, header, sizeof(header), HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransferV(handle, segments, 3u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiTransmitDMA(handle, header, 1u));
+
+    // Act & Assert - each segment is started from the previous completion
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, status, sizeof(status), HAL_OK);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_TransmitReceive_DMA_ExpectAndReturn(&hspi1, txData, rxData, sizeof(txData), HAL_OK);
+    HAL_SPI_RxCpltCallback(&hspi1);
+    TEST_ASSERT_FALSE(txrx_callback_invoked);
+
+    HAL_SPI_TxRxCpltCallback(&hspi1);
+    TEST_ASSERT_TRUE(txrx_callback_invoked);
+    TEST_ASSERT_FALSE(tx_callback_invoked);
+    TEST_ASSERT_FALSE(rx_callback_invoked);
+
+    // A segment list ending in a TX-only segment still completes as full duplex
+    txrx_callback_invoked = false;
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, header, sizeof(header), HAL_OK);
+    BspSpiTransferV(handle, segments, 1u);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_TRUE(txrx_callback_invoked);
+    TEST_ASSERT_FALSE(tx_callback_invoked);
+}
+
+void test_BspSpiTransferV_InvalidParameters(void)
+{
+    // Arrange
+    BspSpiHandle_t        handle     = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiHandle_t        blocking   = BspSpiAllocate(eBSP_SPI_INSTANCE_2, eBSP_SPI_MODE_BLOCKING, 0);
+    uint8_t               data[4]    = {0};
+    const BspSpiSegment_t valid[]    = {{.pTxData = data, .uLength = sizeof(data)}};
+    const BspSpiSegment_t empty[]    = {{.pTxData = data, .uLength = sizeof(data)}, {.pTxData = data, .uLength = 0u}};
+    const BspSpiSegment_t noBuffer[] = {{.uLength = sizeof(data)}};
+    BspSpiXfer_t          xfer       = {.pSegments = empty, .uSegments = 2u};
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiTransferV(-1, valid, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiTransferV(handle, NULL, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiTransferV(handle, valid, 0u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiTransferV(handle, empty, 2u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiTransferV(handle, noBuffer, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiTransferV(blocking, valid, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiQueueTransfer(handle, &xfer));
+}
+
+void test_BspSpiTransferV_SegmentStartFailure_ReportsError(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterTxRxCallback(handle, test_txrx_callback);
+    BspSpiRegisterErrorCallback(handle, test_error_callback);
+
+    uint8_t               header[1]  = {0x0B};
+    uint8_t               rxData[8]  = {0};
+    const BspSpiSegment_t segments[] = {{.pTxData = header, .uLength = 1u}, {.pRxData = rxData, .uLength = sizeof(rxData)}};
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, header, 1u, HAL_OK);
+    BspSpiTransferV(handle, segments, 2u);
+
+    // Act
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, rxData, sizeof(rxData), HAL_ERROR);
+    HAL_SPI_TxCpltCallback(&hspi1);
+
+    // Assert - reported once as an error, and the bus is free again
+    TEST_ASSERT_FALSE(txrx_callback_invoked);
+    TEST_ASSERT_TRUE(error_callback_invoked);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, callback_error);
+
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, header, 1u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmitDMA(handle, header, 1u));
+}
+
+void test_BspSpiDeviceQueueTransfer_Segments_KeepChipSelect(void)
+{
+    // Arrange - flash page program: command header and 4 KiB payload, no staging copy
+    queue_reset_trackers();
+    BspSpiHandle_t bus = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+    BspSpiDeviceHandle_t flash = add_device(bus, eM_FLASH_NCS, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+    queue_reset_trackers();
+
+    uint8_t               header[4]  = {0x02, 0x00, 0x10, 0x00};
+    const BspSpiSegment_t segments[] = {{.pTxData = header, .uLength = sizeof(header)}, {.pTxData = chunk_buffer, .uLength = 4096u}};
+    BspSpiXfer_t          xfer       = {.pSegments = segments, .uSegments = 2u, .pCallback = test_queue_callback, .pContext = (void*)6};
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(flash, &xfer));
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_TxCpltCallback(&hspi1);
+
+    // Assert - CS stays low across both segments, one completion
+    TEST_ASSERT_EQUAL_STRING("aSSA6", queue_log);
+    TEST_ASSERT_EQUAL(1u, queue_cb_count);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, queue_cb_error);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(flash));
+}
+
+// ============================================================================
+// Streaming Reception Tests
+// ============================================================================
+
+extern void HAL_SPI_RxHalfCpltCallback(SPI_HandleTypeDef* hspi);
+extern void HAL_SPI_TxRxHalfCpltCallback(SPI_HandleTypeDef* hspi);
+
+static const uint8_t* stream_data     = NULL;
+static uint32_t       stream_length   = 0u;
+static uint32_t       stream_events   = 0u;
+static bool           stream_consumed = true;
+
+static bool test_stream_callback(BspSpiHandle_t handle, const uint8_t* pData, uint32_t uLength)
+{
+    (void)handle;
+    stream_data   = pData;
+    stream_length = uLength;
+    stream_events++;
+    return stream_consumed;
+}
+
+static void stream_reset_trackers(void)
+{
+    stream_data     = NULL;
+    stream_length   = 0u;
+    stream_events   = 0u;
+    stream_consumed = true;
+}
+
+void test_BspSpiStartStream_DeliversAlternatingHalves(void)
+{
+    // Arrange
+    stream_reset_trackers();
+    static uint8_t buffer[64];
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterRxCallback(handle, test_rx_callback);
+
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, buffer, sizeof(buffer), HAL_OK);
+
+    // Act
+    BspSpiError_e result = BspSpiStartStream(handle, buffer, sizeof(buffer), test_stream_callback);
+
+    // Assert - half-transfer delivers the first half, transfer-complete the second
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+
+    HAL_SPI_RxHalfCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_PTR(&buffer[0], stream_data);
+    TEST_ASSERT_EQUAL(32u, stream_length);
+
+    HAL_SPI_RxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_PTR(&buffer[32], stream_data);
+    TEST_ASSERT_FALSE(rx_callback_invoked);
+
+    // Master full-duplex receive reports through the TxRx callbacks
+    HAL_SPI_TxRxHalfCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_PTR(&buffer[0], stream_data);
+    HAL_SPI_TxRxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_PTR(&buffer[32], stream_data);
+
+    BspSpiStreamStats_t stats;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiGetStreamStats(handle, &stats));
+    TEST_ASSERT_EQUAL(4u, stats.uBlocks);
+    TEST_ASSERT_EQUAL(0u, stats.uOverruns);
+
+    // Cleanup
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiStopStream(handle));
+    BspSpiFree(handle);
+}
+
+void test_BspSpiStream_LateConsumer_CountsOverrun(void)
+{
+    // Arrange - consumer keeps each half for deferred processing
+    stream_reset_trackers();
+    stream_consumed = false;
+    static uint8_t buffer[16];
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, buffer, sizeof(buffer), HAL_OK);
+    BspSpiStartStream(handle, buffer, sizeof(buffer), test_stream_callback);
+
+    // Act - released in time, then late
+    HAL_SPI_RxHalfCpltCallback(&hspi1);
+    BspSpiStreamRelease(handle);
+    HAL_SPI_RxCpltCallback(&hspi1);
+    HAL_SPI_RxHalfCpltCallback(&hspi1);
+
+    // Assert
+    BspSpiStreamStats_t stats;
+    BspSpiGetStreamStats(handle, &stats);
+    TEST_ASSERT_EQUAL(3u, stats.uBlocks);
+    TEST_ASSERT_EQUAL(1u, stats.uOverruns);
+
+    // Cleanup
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    BspSpiStopStream(handle);
+    BspSpiFree(handle);
+}
+
+void test_BspSpiStartStream_InvalidParameters(void)
+{
+    // Arrange
+    static uint8_t buffer[16];
+    BspSpiHandle_t handle   = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiHandle_t blocking = BspSpiAllocate(eBSP_SPI_INSTANCE_2, eBSP_SPI_MODE_BLOCKING, 0);
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiStartStream(-1, buffer, 16u, test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStartStream(handle, NULL, 16u, test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStartStream(handle, buffer, 16u, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStartStream(handle, buffer, 15u, test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStartStream(handle, buffer, 0u, test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStartStream(handle, buffer, 65536u, test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStartStream(blocking, buffer, 16u, test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStopStream(handle));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiGetStreamStats(handle, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiStreamRelease(-1));
+
+    // HAL start failure leaves the bus idle
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, buffer, 16u, HAL_ERROR);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, BspSpiStartStream(handle, buffer, 16u, test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStopStream(handle));
+
+    // Cleanup
+    BspSpiFree(handle);
+    BspSpiFree(blocking);
+}
+
+void test_BspSpiStream_OwnsBusUntilStopped(void)
+{
+    // Arrange
+    stream_reset_trackers();
+    queue_reset_trackers();
+    static uint8_t buffer[16];
+    uint8_t        txData[2] = {0};
+    BspSpiHandle_t handle    = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiXfer_t   xfer      = {.pTxData = txData, .uLength = 2u, .pCallback = test_queue_callback, .pContext = (void*)1};
+
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, buffer, sizeof(buffer), HAL_OK);
+    BspSpiStartStream(handle, buffer, sizeof(buffer), test_stream_callback);
+
+    // Act & Assert - direct transfers refused, queued transfers wait for the stop
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiTransmitDMA(handle, txData, 2u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiStartStream(handle, buffer, sizeof(buffer), test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiQueueTransfer(handle, &xfer));
+
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, 2u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiStopStream(handle));
+
+    // Stream events after the stop are ignored
+    HAL_SPI_RxHalfCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(0u, stream_events);
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+void test_BspSpiStream_DmaError_EndsStream(void)
+{
+    // Arrange
+    stream_reset_trackers();
+    static uint8_t buffer[16];
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterErrorCallback(handle, test_error_callback);
+
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, buffer, sizeof(buffer), HAL_OK);
+    BspSpiStartStream(handle, buffer, sizeof(buffer), test_stream_callback);
+
+    // Act
+    HAL_SPI_ErrorCallback(&hspi1);
+
+    // Assert
+    TEST_ASSERT_TRUE(error_callback_invoked);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStopStream(handle));
+
+    // Cleanup
+    BspSpiFree(handle);
+}
+
+void test_BspSpiFree_RunningStream_StopsDma(void)
+{
+    // Arrange
+    stream_reset_trackers();
+    static uint8_t buffer[16];
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, buffer, sizeof(buffer), HAL_OK);
+    BspSpiStartStream(handle, buffer, sizeof(buffer), test_stream_callback);
+
+    // Act - the stream is stopped before the module is released
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiFree(handle));
+
+    // Assert - late DMA events reach no callback
+    HAL_SPI_RxHalfCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(0u, stream_events);
+}
+
+void test_BspSpiStream_CircularOnlyWhileStreaming(void)
+{
+    // Arrange - DMA streams in normal mode, as set up by the MSP
+    static DMA_Stream_TypeDef txStream;
+    static DMA_Stream_TypeDef rxStream;
+    static DMA_HandleTypeDef  hdmatx = {.Instance = &txStream};
+    static DMA_HandleTypeDef  hdmarx = {.Instance = &rxStream};
+    static uint8_t            buffer[16];
+    uint8_t                   txData[2] = {0x5A, 0xA5};
+    stream_reset_trackers();
+    txStream.CR           = 0u;
+    rxStream.CR           = 0u;
+    hspi1.hdmatx          = &hdmatx;
+    hspi1.hdmarx          = &hdmarx;
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiRegisterTxCallback(handle, test_tx_callback);
+
+    // Act & Assert - circular while the stream runs
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, buffer, sizeof(buffer), HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiStartStream(handle, buffer, sizeof(buffer), test_stream_callback));
+    TEST_ASSERT_EQUAL_HEX32(DMA_SxCR_CIRC, rxStream.CR & DMA_SxCR_CIRC);
+    TEST_ASSERT_EQUAL_HEX32(DMA_SxCR_CIRC, txStream.CR & DMA_SxCR_CIRC);
+
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiStopStream(handle));
+    TEST_ASSERT_EQUAL_HEX32(0u, rxStream.CR & DMA_SxCR_CIRC);
+    TEST_ASSERT_EQUAL_HEX32(0u, txStream.CR & DMA_SxCR_CIRC);
+
+    // A one-shot transfer on the same streams completes normally
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, sizeof(txData), HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmitDMA(handle, txData, sizeof(txData)));
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_TRUE(tx_callback_invoked);
+
+    // A stream ended by a DMA error leaves normal mode too
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, buffer, sizeof(buffer), HAL_OK);
+    BspSpiStartStream(handle, buffer, sizeof(buffer), test_stream_callback);
+    HAL_SPI_ErrorCallback(&hspi1);
+    TEST_ASSERT_EQUAL_HEX32(0u, rxStream.CR & DMA_SxCR_CIRC);
+
+    // Cleanup
+    BspSpiFree(handle);
+    hspi1.hdmatx = NULL;
+    hspi1.hdmarx = NULL;
+}
+
+// ============================================================================
+// Slave Mode Tests
+// ============================================================================
+
+extern void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+// Host side of the bus: clocks bytes through the circular DMA rings
+static DMA_Stream_TypeDef  slave_rx_stream;
+static DMA_HandleTypeDef   slave_hdmarx = {.Instance = &slave_rx_stream};
+static uint8_t             slave_rx_ring[16];
+static uint8_t             slave_tx_ring[16];
+static uint32_t            slave_pos      = 0u;
+static uint8_t             slave_dr       = 0u;
+static uint32_t            slave_messages = 0u;
+static BspSpiSlaveConfig_t slave_config;
+
+static void test_slave_msg_callback(BspSpiHandle_t handle)
+{
+    (void)handle;
+    slave_messages++;
+}
+
+static BspSpiHandle_t slave_start(uint32_t ringLength)
+{
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    memset(slave_rx_ring, 0, sizeof(slave_rx_ring));
+    slave_pos             = 0u;
+    slave_messages        = 0u;
+    slave_rx_stream.NDTR  = ringLength;
+    slave_rx_stream.CR    = 0u;
+    hspi1.hdmarx          = &slave_hdmarx;
+    hspi1.Init.Mode       = SPI_MODE_MASTER;
+    hspi1.Init.NSS        = SPI_NSS_SOFT;
+    slave_config          = (BspSpiSlaveConfig_t){.pRxRing     = slave_rx_ring,
+                                                  .pTxRing     = slave_tx_ring,
+                                                  .uRingLength = ringLength,
+                                                  .uCsPin      = eM_WP,
+                                                  .eClockMode  = eBSP_SPI_CLOCK_MODE_3,
+                                                  .pOnMessage  = test_slave_msg_callback};
+
+    HAL_SPI_Init_ExpectAndReturn(&hspi1, HAL_OK);
+    HAL_NVIC_EnableIRQ_Expect(EXTI15_10_IRQn);
+    HAL_SPI_TransmitReceive_DMA_ExpectAndReturn(&hspi1, slave_tx_ring, slave_rx_ring, (uint16_t)ringLength, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveStart(handle, &slave_config));
+
+    // The DMA loads the first transmit byte into the data register when started
+    slave_dr = slave_tx_ring[0];
+    return handle;
+}
+
+static void slave_stop(BspSpiHandle_t handle)
+{
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    HAL_SPI_Init_ExpectAndReturn(&hspi1, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveStop(handle));
+    hspi1.hdmarx = NULL;
+}
+
+// One frame: chip select low, uLength bytes clocked, chip select high (EXTI)
+static void slave_host_frame(const uint8_t* pMosi, uint8_t* pMiso, uint32_t uLength)
+{
+    uint32_t ring = slave_config.uRingLength;
+
+    for (uint32_t i = 0u; i < uLength; i++)
+    {
+        uint8_t out = slave_dr;
+
+        // Shifting out a byte lets the DMA load the next one into the data register
+        slave_dr                 = slave_tx_ring[(slave_pos + 1u) % ring];
+        slave_rx_ring[slave_pos] = (pMosi != NULL) ? pMosi[i] : (uint8_t)i;
+        if (pMiso != NULL)
+        {
+            pMiso[i] = out;
+        }
+
+        slave_pos            = (slave_pos + 1u) % ring;
+        slave_rx_stream.NDTR = ring - slave_pos;
+
+        if (slave_pos == (ring / 2u))
+        {
+            HAL_SPI_TxRxHalfCpltCallback(&hspi1);
+        }
+        else if (slave_pos == 0u)
+        {
+            HAL_SPI_TxRxCpltCallback(&hspi1);
+        }
+    }
+
+    HAL_GPIO_EXTI_Callback(GPIO_PIN_13);
+}
+
+void test_BspSpiSlaveStart_FramesMessagesOnChipSelect(void)
+{
+    // Arrange
+    const uint8_t cmd1[5] = {0x01, 0x02, 0x03, 0x04, 0x05};
+    const uint8_t cmd2[3] = {0x10, 0x20, 0x30};
+    BspSpiHandle_t handle  = slave_start(16u);
+
+    // Assert - slave with hardware NSS, host clock mode 3
+    TEST_ASSERT_EQUAL_HEX32(SPI_MODE_SLAVE, hspi1.Init.Mode);
+    TEST_ASSERT_EQUAL_HEX32(SPI_NSS_HARD_INPUT, hspi1.Init.NSS);
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_CPOL, hspi1.Init.CLKPolarity);
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_CPHA, hspi1.Init.CLKPhase);
+    TEST_ASSERT_EQUAL_HEX32(DMA_SxCR_CIRC, slave_rx_stream.CR & DMA_SxCR_CIRC);
+
+    // Act - two frames and a chip-select glitch without clocks
+    slave_host_frame(cmd1, NULL, sizeof(cmd1));
+    slave_host_frame(cmd2, NULL, sizeof(cmd2));
+    slave_host_frame(NULL, NULL, 0u);
+
+    // Assert - messages in order, read in place
+    BspSpiSlaveMsg_t msg;
+    TEST_ASSERT_EQUAL(2u, slave_messages);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveGetMessage(handle, &msg));
+    TEST_ASSERT_EQUAL_PTR(&slave_rx_ring[0], msg.pData);
+    TEST_ASSERT_EQUAL(5u, msg.uLength);
+    TEST_ASSERT_NULL(msg.pWrapData);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(cmd1, msg.pData, sizeof(cmd1));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveReleaseMessage(handle));
+
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveGetMessage(handle, &msg));
+    TEST_ASSERT_EQUAL_PTR(&slave_rx_ring[5], msg.pData);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(cmd2, msg.pData, sizeof(cmd2));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveReleaseMessage(handle));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NO_DATA, BspSpiSlaveGetMessage(handle, &msg));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveReleaseMessage(handle));
+
+    BspSpiSlaveStats_t stats;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveGetStats(handle, &stats));
+    TEST_ASSERT_EQUAL(2u, stats.uMessages);
+    TEST_ASSERT_EQUAL(8u, stats.uRxBytes);
+    TEST_ASSERT_EQUAL(0u, stats.uOverruns + stats.uUnderruns);
+
+    // Stop restores the master configuration and normal-mode DMA
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    HAL_SPI_Init_ExpectAndReturn(&hspi1, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveStop(handle));
+    TEST_ASSERT_EQUAL_HEX32(0u, slave_rx_stream.CR & DMA_SxCR_CIRC);
+    TEST_ASSERT_EQUAL_HEX32(SPI_MODE_MASTER, hspi1.Init.Mode);
+    TEST_ASSERT_EQUAL_HEX32(SPI_NSS_SOFT, hspi1.Init.NSS);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveGetMessage(handle, &msg));
+
+    // A master transfer on the same streams completes normally
+    uint8_t txData[2] = {0x01, 0x02};
+    BspSpiRegisterTxCallback(handle, test_tx_callback);
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, sizeof(txData), HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmitDMA(handle, txData, sizeof(txData)));
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_TRUE(tx_callback_invoked);
+    hspi1.hdmarx = NULL;
+    BspSpiFree(handle);
+}
+
+void test_BspSpiSlave_MessageAcrossRingEnd_ReturnsTwoParts(void)
+{
+    // Arrange
+    uint8_t        data[10];
+    BspSpiHandle_t handle = slave_start(16u);
+    for (uint32_t i = 0u; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(0xC0u + i);
+    }
+
+    // Act - first message consumed before the second one writes over it
+    BspSpiSlaveMsg_t msg;
+    slave_host_frame(NULL, NULL, 10u);
+    BspSpiSlaveGetMessage(handle, &msg);
+    BspSpiSlaveReleaseMessage(handle);
+    slave_host_frame(data, NULL, 10u);
+
+    // Assert - second message is bytes 10..15 and 0..3 of the ring
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveGetMessage(handle, &msg));
+    TEST_ASSERT_EQUAL_PTR(&slave_rx_ring[10], msg.pData);
+    TEST_ASSERT_EQUAL(6u, msg.uLength);
+    TEST_ASSERT_EQUAL_PTR(&slave_rx_ring[0], msg.pWrapData);
+    TEST_ASSERT_EQUAL(4u, msg.uWrapLength);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&data[0], msg.pData, 6u);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&data[6], msg.pWrapData, 4u);
+
+    // Cleanup
+    slave_stop(handle);
+    BspSpiFree(handle);
+}
+
+void test_BspSpiFree_SlaveSession_StopsSlaveMode(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = slave_start(16u);
+
+    // Act - slave mode is stopped and the master configuration restored first
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    HAL_SPI_Init_ExpectAndReturn(&hspi1, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiFree(handle));
+
+    // Assert - a late chip-select edge reaches no session
+    TEST_ASSERT_EQUAL_HEX32(SPI_MODE_MASTER, hspi1.Init.Mode);
+    TEST_ASSERT_EQUAL_HEX32(0u, slave_rx_stream.CR & DMA_SxCR_CIRC);
+    slave_host_frame(NULL, NULL, 4u);
+    TEST_ASSERT_EQUAL(0u, slave_messages);
+    hspi1.hdmarx = NULL;
+}
+
+void test_BspSpiSlave_FrameOfRingLength_IsComplete(void)
+{
+    // Arrange
+    uint8_t            data[16];
+    BspSpiSlaveMsg_t   msg;
+    BspSpiSlaveStats_t stats;
+    BspSpiHandle_t     handle = slave_start(16u);
+    for (uint32_t i = 0u; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(0x80u + i);
+    }
+
+    // Act - a frame from mid-ring that fills the ring exactly and ends where it started
+    slave_host_frame(NULL, NULL, 5u);
+    BspSpiSlaveGetMessage(handle, &msg);
+    BspSpiSlaveReleaseMessage(handle);
+    slave_host_frame(data, NULL, sizeof(data));
+
+    // Assert - one whole message, no overrun
+    BspSpiSlaveGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(0u, stats.uOverruns);
+    TEST_ASSERT_EQUAL(21u, stats.uRxBytes);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveGetMessage(handle, &msg));
+    TEST_ASSERT_EQUAL_PTR(&slave_rx_ring[5], msg.pData);
+    TEST_ASSERT_EQUAL(11u, msg.uLength);
+    TEST_ASSERT_EQUAL_PTR(&slave_rx_ring[0], msg.pWrapData);
+    TEST_ASSERT_EQUAL(5u, msg.uWrapLength);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&data[0], msg.pData, 11u);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&data[11], msg.pWrapData, 5u);
+
+    // Cleanup
+    slave_stop(handle);
+    BspSpiFree(handle);
+}
+
+void test_BspSpiSlave_Write_HostReadsResponseAndUnderrunsAreCounted(void)
+{
+    // Arrange
+    const uint8_t response[3] = {0xA1, 0xA2, 0xA3};
+    uint8_t       miso[6];
+    BspSpiHandle_t handle = slave_start(16u);
+
+    // Act - command frame, response queued between frames, host reads it
+    slave_host_frame(NULL, NULL, 3u);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveWrite(handle, response, sizeof(response)));
+    slave_host_frame(NULL, miso, 4u);
+
+    // Assert - the first byte was already in the data register
+    TEST_ASSERT_EQUAL_HEX8(BSP_SPI_SLAVE_FILL, miso[0]);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(response, &miso[1], sizeof(response));
+
+    // Nothing queued: fill bytes, not the old response, and no underrun
+    slave_host_frame(NULL, miso, 6u);
+    for (uint32_t i = 0u; i < 6u; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8(BSP_SPI_SLAVE_FILL, miso[i]);
+    }
+
+    // Host reads past a short response
+    BspSpiSlaveWrite(handle, response, 2u);
+    slave_host_frame(NULL, miso, 5u);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(response, &miso[1], 2u);
+    TEST_ASSERT_EQUAL_HEX8(BSP_SPI_SLAVE_FILL, miso[3]);
+
+    BspSpiSlaveStats_t stats;
+    BspSpiSlaveGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(1u, stats.uUnderruns);
+
+    // Response larger than the ring
+    uint8_t big[16] = {0};
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NO_RESOURCE, BspSpiSlaveWrite(handle, big, 16u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveWrite(handle, big, 15u));
+
+    // Cleanup
+    slave_stop(handle);
+    BspSpiFree(handle);
+}
+
+void test_BspSpiSlave_SlowConsumer_CountsOverruns(void)
+{
+    // Arrange
+    BspSpiSlaveMsg_t   msg;
+    BspSpiSlaveStats_t stats;
+    BspSpiHandle_t     handle = slave_start(16u);
+
+    // Act - first message held while the host sends more than the ring holds
+    slave_host_frame(NULL, NULL, 6u);
+    BspSpiSlaveGetMessage(handle, &msg);
+    slave_host_frame(NULL, NULL, 6u);
+    slave_host_frame(NULL, NULL, 6u);
+
+    // Assert - the overwritten message is gone; releasing it keeps the next one
+    BspSpiSlaveGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(1u, stats.uOverruns);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveReleaseMessage(handle));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveGetMessage(handle, &msg));
+    TEST_ASSERT_EQUAL_PTR(&slave_rx_ring[6], msg.pData);
+    BspSpiSlaveReleaseMessage(handle);
+    BspSpiSlaveGetMessage(handle, &msg);
+    BspSpiSlaveReleaseMessage(handle);
+
+    // Message queue full
+    for (uint32_t i = 0u; i < (BSP_SPI_SLAVE_MSG_DEPTH + 1u); i++)
+    {
+        slave_host_frame(NULL, NULL, 1u);
+    }
+    BspSpiSlaveGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(2u, stats.uOverruns);
+
+    // A frame longer than the ring overwrites itself and everything held
+    slave_host_frame(NULL, NULL, 40u);
+    BspSpiSlaveGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(2u + BSP_SPI_SLAVE_MSG_DEPTH + 1u, stats.uOverruns);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NO_DATA, BspSpiSlaveGetMessage(handle, &msg));
+
+    // Cleanup
+    slave_stop(handle);
+    BspSpiFree(handle);
+}
+
+void test_BspSpiSlave_OwnsBusUntilStopped(void)
+{
+    // Arrange
+    queue_reset_trackers();
+    uint8_t        txData[2] = {0};
+    BspSpiXfer_t   xfer      = {.pTxData = txData, .uLength = 2u, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiHandle_t other     = BspSpiAllocate(eBSP_SPI_INSTANCE_2, eBSP_SPI_MODE_DMA, 0);
+    BspSpiHandle_t blocking  = BspSpiAllocate(eBSP_SPI_INSTANCE_3, eBSP_SPI_MODE_BLOCKING, 0);
+    BspSpiHandle_t handle    = slave_start(16u);
+
+    // Act & Assert - master transfers refused or held back, one slave bus only
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiTransmitDMA(handle, txData, 2u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiStartStream(handle, slave_rx_ring, 16u, test_stream_callback));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiSlaveStart(handle, &slave_config));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NO_RESOURCE, BspSpiSlaveStart(other, &slave_config));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiQueueTransfer(handle, &xfer));
+
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    HAL_SPI_Init_ExpectAndReturn(&hspi1, HAL_OK);
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, 2u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSlaveStop(handle));
+    hspi1.hdmarx = NULL;
+
+    // Chip-select edges after the stop are ignored
+    HAL_GPIO_EXTI_Callback(GPIO_PIN_13);
+    TEST_ASSERT_EQUAL(0u, slave_messages);
+
+    // Invalid parameters
+    BspSpiSlaveConfig_t config = slave_config;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiSlaveStart(-1, &config));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveStart(other, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveStart(blocking, &config));
+    config.uRingLength = 1u;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveStart(other, &config));
+    config.uRingLength = 65536u;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveStart(other, &config));
+    config.uRingLength = 16u;
+    config.pTxRing     = NULL;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveStart(other, &config));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveStop(other));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveWrite(other, txData, 2u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiSlaveGetStats(-1, NULL));
+
+    // HAL start failure restores the master configuration
+    HAL_SPI_Init_ExpectAndReturn(&hspi2, HAL_OK);
+    HAL_NVIC_EnableIRQ_Expect(EXTI15_10_IRQn);
+    HAL_SPI_TransmitReceive_DMA_ExpectAndReturn(&hspi2, slave_tx_ring, slave_rx_ring, 16u, HAL_ERROR);
+    HAL_SPI_Init_ExpectAndReturn(&hspi2, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, BspSpiSlaveStart(other, &slave_config));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSlaveStop(other));
+
+    // Cleanup
+    BspSpiFree(handle);
+    BspSpiFree(other);
+    BspSpiFree(blocking);
+}
+
+// ============================================================================
+// Frame Format Tests
+// ============================================================================
+
+// TX and RX DMA streams of SPI1, to check the transfer width
+static DMA_Stream_TypeDef format_tx_stream;
+static DMA_Stream_TypeDef format_rx_stream;
+static DMA_HandleTypeDef  format_hdmatx = {.Instance = &format_tx_stream};
+static DMA_HandleTypeDef  format_hdmarx = {.Instance = &format_rx_stream};
+static uint16_t           format_words[70000];
+
+#define FORMAT_DMA_HALFWORD (DMA_SxCR_PSIZE_0 | DMA_SxCR_MSIZE_0)
+
+static BspSpiHandle_t format_allocate(BspSpiMode_e mode)
+{
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, mode, 100);
+    hspi1.State           = HAL_SPI_STATE_READY;
+    hspi1.ErrorCode       = HAL_SPI_ERROR_NONE;
+    hspi1.hdmatx          = &format_hdmatx;
+    hspi1.hdmarx          = &format_hdmarx;
+    mock_SPI1.CR1         = 0u;
+    format_tx_stream.CR   = 0u;
+    format_rx_stream.CR   = 0u;
+    return handle;
+}
+
+static void format_cleanup(void)
+{
+    hspi1.State               = HAL_SPI_STATE_RESET;
+    hspi1.ErrorCode           = HAL_SPI_ERROR_NONE;
+    hspi1.hdmatx              = NULL;
+    hspi1.hdmarx              = NULL;
+    hspi1.Init.DataSize       = SPI_DATASIZE_8BIT;
+    hspi1.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+    mock_SPI1.CR1             = 0u;
+    mock_SPI1.CRCPR           = 0u;
+}
+
+static BspSpiDeviceHandle_t add_format_device(BspSpiHandle_t bus, uint32_t csPin, BspSpiDataSize_e size, uint16_t crcPolynomial)
+{
+    BspSpiDeviceConfig_t config = {.hBus           = bus,
+                                   .uCsPin         = csPin,
+                                   .eClockMode     = eBSP_SPI_CLOCK_MODE_0,
+                                   .ePrescaler     = eBSP_SPI_PRESCALER_4,
+                                   .eDataSize      = size,
+                                   .uCrcPolynomial = crcPolynomial};
+    return BspSpiDeviceAdd(&config);
+}
+
+void test_BspSpiDeviceQueueTransfer_16BitDevice_SwitchesFrameAndDmaWidth(void)
+{
+    // Arrange - 16-bit DAC and 8-bit flash on SPI1
+    queue_reset_trackers();
+    BspSpiHandle_t bus = format_allocate(eBSP_SPI_MODE_DMA);
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+
+    BspSpiDeviceHandle_t dac   = add_format_device(bus, eM_WP, eBSP_SPI_DATA_SIZE_16BIT, 0u);
+    BspSpiDeviceHandle_t flash = add_format_device(bus, eM_FLASH_NCS, eBSP_SPI_DATA_SIZE_8BIT, 0u);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, dac);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, flash);
+
+    uint8_t      cmd[3]  = {0x05};
+    BspSpiXfer_t samples = {.pTxData = (uint8_t*)format_words, .uLength = 8u, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiXfer_t status  = {.pTxData = cmd, .uLength = 3u, .pCallback = test_queue_callback, .pContext = (void*)2};
+
+    // Act & Assert - four halfword frames, one DMA request each
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, (uint8_t*)format_words, 4u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(dac, &samples));
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_DFF, mock_SPI1.CR1 & (SPI_CR1_DFF | SPI_CR1_CRCEN));
+    TEST_ASSERT_EQUAL_HEX32(SPI_DATASIZE_16BIT, hspi1.Init.DataSize);
+    TEST_ASSERT_EQUAL_HEX32(FORMAT_DMA_HALFWORD, format_tx_stream.CR);
+    TEST_ASSERT_EQUAL_HEX32(FORMAT_DMA_HALFWORD, format_rx_stream.CR);
+
+    // Switching to the flash restores byte frames before its transfer starts
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, cmd, 3u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(flash, &status));
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_HEX32(0u, mock_SPI1.CR1 & SPI_CR1_DFF);
+    TEST_ASSERT_EQUAL_HEX32(SPI_DATASIZE_8BIT, hspi1.Init.DataSize);
+    TEST_ASSERT_EQUAL_HEX32(0u, format_tx_stream.CR);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(2u, queue_cb_count);
+
+    BspSpiQueueStats_t stats;
+    BspSpiGetQueueStats(bus, &stats);
+    TEST_ASSERT_EQUAL(2u, stats.uReconfigs);
+
+    // Odd lengths and unaligned buffers are not whole frames
+    samples.uLength = 7u;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiDeviceQueueTransfer(dac, &samples));
+    samples.uLength = 8u;
+    samples.pTxData = &((uint8_t*)format_words)[1];
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiDeviceQueueTransfer(dac, &samples));
+
+    // Invalid formats
+    TEST_ASSERT_EQUAL(-1, add_format_device(bus, eM_SPARE1, eBSP_SPI_DATA_SIZE_COUNT, 0u));
+    TEST_ASSERT_EQUAL(-1, add_format_device(bus, eM_SPARE1, eBSP_SPI_DATA_SIZE_8BIT, 0x1020u));
+
+    // Cleanup
+    format_cleanup();
+}
+
+void test_BspSpiDeviceQueueTransfer_CrcMismatch_ReportsCrcError(void)
+{
+    // Arrange - two links with 8-bit hardware CRC and different polynomials
+    queue_reset_trackers();
+    BspSpiHandle_t bus = format_allocate(eBSP_SPI_MODE_DMA);
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+
+    BspSpiDeviceHandle_t linkA = add_format_device(bus, eM_FLASH_NCS, eBSP_SPI_DATA_SIZE_8BIT, 0x07u);
+    BspSpiDeviceHandle_t linkB = add_format_device(bus, eM_WP, eBSP_SPI_DATA_SIZE_8BIT, 0x31u);
+    queue_reset_trackers();
+
+    uint8_t      tx[4] = {0x01, 0x02, 0x03, 0x04}, rx[4];
+    BspSpiXfer_t xferA = {.pTxData = tx, .pRxData = rx, .uLength = 4u, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiXfer_t xferB = {.pTxData = tx, .pRxData = rx, .uLength = 4u, .pCallback = test_queue_callback, .pContext = (void*)2};
+
+    HAL_SPI_TransmitReceive_DMA_ExpectAndReturn(&hspi1, tx, rx, 4u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(linkA, &xferA));
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_CRCEN, mock_SPI1.CR1 & (SPI_CR1_DFF | SPI_CR1_CRCEN));
+    TEST_ASSERT_EQUAL_HEX32(0x07u, mock_SPI1.CRCPR);
+    TEST_ASSERT_EQUAL_HEX32(SPI_CRCCALCULATION_ENABLE, hspi1.Init.CRCCalculation);
+    TEST_ASSERT_EQUAL_HEX32(0x07u, hspi1.Init.CRCPolynomial);
+
+    // Act - HAL finds the received CRC wrong at the end of the transfer
+    hspi1.ErrorCode = HAL_SPI_ERROR_CRC;
+    HAL_SPI_TransmitReceive_DMA_ExpectAndReturn(&hspi1, tx, rx, 4u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(linkB, &xferB));
+    HAL_SPI_ErrorCallback(&hspi1);
+
+    // Assert - reported to the transfer; the next link only differs in the polynomial
+    TEST_ASSERT_EQUAL_STRING("aAb1", queue_log);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_CRC, queue_cb_error);
+    TEST_ASSERT_EQUAL_HEX32(0x31u, mock_SPI1.CRCPR);
+
+    hspi1.ErrorCode = HAL_SPI_ERROR_NONE;
+    HAL_SPI_TxRxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, queue_cb_error);
+
+    BspSpiQueueStats_t stats;
+    BspSpiGetQueueStats(bus, &stats);
+    TEST_ASSERT_EQUAL(2u, stats.uReconfigs);
+    TEST_ASSERT_EQUAL(1u, stats.uErrors);
+    TEST_ASSERT_EQUAL(1u, stats.uCompleted);
+
+    // Cleanup
+    format_cleanup();
+}
+
+void test_BspSpiSetFrameFormat_16BitDirectDma_ChunksInFramesAndReportsCrc(void)
+{
+    // Arrange
+    BspSpiHandle_t handle = format_allocate(eBSP_SPI_MODE_DMA);
+    BspSpiRegisterTxCallback(handle, test_tx_callback);
+    BspSpiRegisterErrorCallback(handle, test_error_callback);
+
+    // Act
+    BspSpiError_e result = BspSpiSetFrameFormat(handle, eBSP_SPI_DATA_SIZE_16BIT, 0x1021u);
+
+    // Assert - format and DMA width switched
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+    TEST_ASSERT_EQUAL_HEX32(SPI_CR1_DFF | SPI_CR1_CRCEN, mock_SPI1.CR1);
+    TEST_ASSERT_EQUAL_HEX32(0x1021u, mock_SPI1.CRCPR);
+    TEST_ASSERT_EQUAL_HEX32(FORMAT_DMA_HALFWORD, format_tx_stream.CR);
+    TEST_ASSERT_EQUAL_HEX32(FORMAT_DMA_HALFWORD, format_rx_stream.CR);
+
+    // 70000 frames: a full 65535-frame chunk, then the rest from the completion interrupt
+    uint8_t* pBytes = (uint8_t*)format_words;
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, pBytes, 65535u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmitDMA(handle, pBytes, sizeof(format_words)));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiSetFrameFormat(handle, eBSP_SPI_DATA_SIZE_8BIT, 0u));
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, &pBytes[131070], 4465u, HAL_OK);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_TRUE(tx_callback_invoked);
+
+    // CRC mismatch on a direct receive goes to the error callback
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, pBytes, 2u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiReceiveDMA(handle, pBytes, 4u));
+    hspi1.ErrorCode = HAL_SPI_ERROR_CRC;
+    HAL_SPI_ErrorCallback(&hspi1);
+    TEST_ASSERT_TRUE(error_callback_invoked);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_CRC, callback_error);
+
+    // Streams count halfwords too; each half must hold whole frames
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiStartStream(handle, pBytes, 6u, test_stream_callback));
+    HAL_SPI_Receive_DMA_ExpectAndReturn(&hspi1, pBytes, 4u, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiStartStream(handle, pBytes, 8u, test_stream_callback));
+    HAL_SPI_DMAStop_ExpectAndReturn(&hspi1, HAL_OK);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiStopStream(handle));
+
+    // Invalid parameters
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiTransmitDMA(handle, pBytes, 3u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiReceiveDMA(handle, &pBytes[1], 2u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiSetFrameFormat(-1, eBSP_SPI_DATA_SIZE_8BIT, 0u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSetFrameFormat(handle, eBSP_SPI_DATA_SIZE_COUNT, 0u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiSetFrameFormat(handle, eBSP_SPI_DATA_SIZE_16BIT, 0x1020u));
+
+    // Back to byte frames without CRC
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSetFrameFormat(handle, eBSP_SPI_DATA_SIZE_8BIT, 0u));
+    TEST_ASSERT_EQUAL_HEX32(0u, mock_SPI1.CR1);
+    TEST_ASSERT_EQUAL_HEX32(0u, format_rx_stream.CR);
+
+    // Cleanup
+    format_cleanup();
+}
+
+void test_BspSpiTransmitReceive_16BitCrc_BlockingReportsCrcAndSkipsFastPath(void)
+{
+    // Arrange - fast path enabled, then 16-bit frames with CRC
+    BspSpiHandle_t handle = format_allocate(eBSP_SPI_MODE_BLOCKING);
+    uint16_t       tx[2]  = {0x1234u, 0x5678u};
+    uint16_t       rx[2]  = {0u};
+
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSetFastPath(handle, 4u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSetFrameFormat(handle, eBSP_SPI_DATA_SIZE_16BIT, 0x8005u));
+
+    // HAL gets the transfer in frames and fails the CRC check
+    hspi1.ErrorCode = HAL_SPI_ERROR_CRC;
+    HAL_SPI_TransmitReceive_ExpectAndReturn(&hspi1, (uint8_t*)tx, (uint8_t*)rx, 2u, 100, HAL_ERROR);
+
+    // Act
+    BspSpiError_e result = BspSpiTransmitReceive(handle, (uint8_t*)tx, (uint8_t*)rx, sizeof(tx));
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_CRC, result);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiTransmit(handle, (uint8_t*)tx, 3u));
+
+    // Cleanup
+    format_cleanup();
+}
+
+// ============================================================================
+// Constant Fill Tests
+// ============================================================================
+
+// Source word, length and TX stream memory increment seen by HAL at each start
+static const uint8_t* fill_tx_source[4];
+static uint16_t       fill_frames[4];
+static bool           fill_mem_inc[4];
+static uint8_t        fill_starts = 0u;
+
+static void fill_record(const uint8_t* pTxData, uint16_t Size)
+{
+    if (fill_starts < 4u)
+    {
+        fill_tx_source[fill_starts] = pTxData;
+        fill_frames[fill_starts]    = Size;
+        fill_mem_inc[fill_starts]   = (format_tx_stream.CR & DMA_SxCR_MINC) != 0u;
+    }
+    fill_starts++;
+}
+
+static HAL_StatusTypeDef stub_fill_transmit_dma(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, int cmock_num_calls)
+{
+    (void)hspi;
+    (void)cmock_num_calls;
+    fill_record(pData, Size);
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef stub_fill_transmit_receive_dma(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size,
+                                                        int cmock_num_calls)
+{
+    (void)hspi;
+    (void)pRxData;
+    (void)cmock_num_calls;
+    fill_record(pTxData, Size);
+    return HAL_OK;
+}
+
+static BspSpiHandle_t fill_allocate(void)
+{
+    BspSpiHandle_t handle = format_allocate(eBSP_SPI_MODE_DMA);
+    format_tx_stream.CR   = DMA_SxCR_MINC;
+    fill_starts           = 0u;
+    return handle;
+}
+
+void test_BspSpiTransmitFillDMA_LongFill_ChunksFromOneWordAndRestoresMemInc(void)
+{
+    // Arrange - 70000 clocks of 0xFF, two DMA chunks without a source buffer
+    BspSpiHandle_t handle = fill_allocate();
+    BspSpiRegisterTxCallback(handle, test_tx_callback);
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_fill_transmit_dma);
+
+    // Act
+    BspSpiError_e result = BspSpiTransmitFillDMA(handle, 0xFFu, 70000u);
+
+    // Assert - first chunk reads the pattern from a fixed word
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+    TEST_ASSERT_EQUAL(1u, fill_starts);
+    TEST_ASSERT_EQUAL(65535u, fill_frames[0]);
+    TEST_ASSERT_FALSE(fill_mem_inc[0]);
+    TEST_ASSERT_NOT_NULL(fill_tx_source[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xFFu, fill_tx_source[0][0]);
+
+    // Second chunk from the same word, callback only at the end
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(2u, fill_starts);
+    TEST_ASSERT_EQUAL(70000u - 65535u, fill_frames[1]);
+    TEST_ASSERT_EQUAL_PTR(fill_tx_source[0], fill_tx_source[1]);
+    TEST_ASSERT_FALSE(fill_mem_inc[1]);
+    TEST_ASSERT_FALSE(tx_callback_invoked);
+    TEST_ASSERT_EQUAL_HEX32(0u, format_tx_stream.CR & DMA_SxCR_MINC);
+
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_TRUE(tx_callback_invoked);
+    TEST_ASSERT_EQUAL_HEX32(DMA_SxCR_MINC, format_tx_stream.CR);
+
+    // Invalid parameters
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiTransmitFillDMA(-1, 0xFFu, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiTransmitFillDMA(handle, 0xFFu, 0u));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiReceiveFillDMA(handle, 0xFFu, NULL, 4u));
+
+    // Cleanup
+    format_cleanup();
+}
+
+void test_BspSpiReceiveFillDMA_16BitFrames_SendsPatternAndRestoresMemIncOnError(void)
+{
+    // Arrange - 16-bit frames, dummy TX of 0xFFFF while reading 8 frames
+    BspSpiHandle_t handle = fill_allocate();
+    uint16_t       rx[8]  = {0u};
+    BspSpiRegisterTxRxCallback(handle, test_txrx_callback);
+    BspSpiRegisterErrorCallback(handle, test_error_callback);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiSetFrameFormat(handle, eBSP_SPI_DATA_SIZE_16BIT, 0u));
+    HAL_SPI_TransmitReceive_DMA_StubWithCallback(stub_fill_transmit_receive_dma);
+
+    // Act
+    BspSpiError_e result = BspSpiReceiveFillDMA(handle, 0xFFFFu, (uint8_t*)rx, sizeof(rx));
+
+    // Assert - halfword pattern, frames counted by HAL
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, result);
+    TEST_ASSERT_EQUAL(8u, fill_frames[0]);
+    TEST_ASSERT_FALSE(fill_mem_inc[0]);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFFu, *(const uint16_t*)fill_tx_source[0]);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiReceiveFillDMA(handle, 0xFFFFu, (uint8_t*)rx, 3u));
+
+    // A DMA error ends the fill and restores memory increment
+    HAL_SPI_ErrorCallback(&hspi1);
+    TEST_ASSERT_TRUE(error_callback_invoked);
+    TEST_ASSERT_FALSE(txrx_callback_invoked);
+    TEST_ASSERT_EQUAL_HEX32(DMA_SxCR_MINC, format_tx_stream.CR & DMA_SxCR_MINC);
+
+    // Cleanup
+    format_cleanup();
+}
+
+void test_BspSpiDeviceQueueTransfer_Fill_DummyClocksThenNormalTransfer(void)
+{
+    // Arrange - SD-style dummy clocks with CS, then an ordinary command
+    queue_reset_trackers();
+    BspSpiHandle_t bus = fill_allocate();
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    BspSpiDeviceHandle_t card = add_format_device(bus, eM_FLASH_NCS, eBSP_SPI_DATA_SIZE_8BIT, 0u);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, card);
+
+    uint8_t      cmd[6]  = {0x40};
+    uint8_t      reply[4];
+    BspSpiXfer_t clocks  = {.uLength = 10u, .bFill = true, .uFillPattern = 0xFFu, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiXfer_t read    = {.pRxData      = reply,
+                            .uLength      = 4u,
+                            .bFill        = true,
+                            .uFillPattern = 0xFFu,
+                            .pCallback    = test_queue_callback,
+                            .pContext     = (void*)2};
+    BspSpiXfer_t command = {.pTxData = cmd, .uLength = 6u, .pCallback = test_queue_callback, .pContext = (void*)3};
+    BspSpiXfer_t invalid = {.pTxData = cmd, .uLength = 6u, .bFill = true};
+
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_fill_transmit_dma);
+    HAL_SPI_TransmitReceive_DMA_StubWithCallback(stub_fill_transmit_receive_dma);
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiDeviceQueueTransfer(card, &invalid));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(card, &clocks));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(card, &read));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(card, &command));
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_TxRxCpltCallback(&hspi1);
+
+    // Assert - both fills from the pattern word, the command from its buffer with memory increment
+    TEST_ASSERT_EQUAL(3u, fill_starts);
+    TEST_ASSERT_EQUAL(10u, fill_frames[0]);
+    TEST_ASSERT_FALSE(fill_mem_inc[0]);
+    TEST_ASSERT_EQUAL(4u, fill_frames[1]);
+    TEST_ASSERT_FALSE(fill_mem_inc[1]);
+    TEST_ASSERT_EQUAL_HEX8(0xFFu, fill_tx_source[1][0]);
+    TEST_ASSERT_EQUAL_PTR(cmd, fill_tx_source[2]);
+    TEST_ASSERT_TRUE(fill_mem_inc[2]);
+
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(3u, queue_cb_count);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, queue_cb_error);
+
+    // Cleanup
+    format_cleanup();
+}
+
+// ============================================================================
+// Chip Select Hold Tests
+// ============================================================================
+
+void test_BspSpiDeviceQueueTransfer_HoldCs_ReservesBusUntilTransactionEnds(void)
+{
+    // Arrange - SD-style card (held CS, deselect clock) and a sensor on SPI1
+    queue_reset_trackers();
+    BspSpiHandle_t bus = fill_allocate();
+
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+
+    BspSpiDeviceConfig_t cardConfig = {.hBus = bus, .uCsPin = eM_FLASH_NCS, .ePrescaler = eBSP_SPI_PRESCALER_2, .bDeselectClock = true};
+    BspSpiDeviceHandle_t card       = BspSpiDeviceAdd(&cardConfig);
+    BspSpiDeviceHandle_t sensor     = add_device(bus, eM_WP, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+    queue_reset_trackers();
+
+    uint8_t      cmd[6] = {0x52}, data[4] = {0}, sensorTx[2] = {0x8F};
+    BspSpiXfer_t first  = {.pTxData = cmd, .uLength = 6u, .bHoldCs = true, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiXfer_t last   = {.pTxData = data, .uLength = 4u, .pCallback = test_queue_callback, .pContext = (void*)2};
+    BspSpiXfer_t sample = {.pTxData = sensorTx, .uLength = 2u, .pCallback = test_queue_callback, .pContext = (void*)3};
+
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiQueueTransfer(bus, &first));
+
+    // Act - command with CS held, sensor transfer queued behind it
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(card, &first));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(sensor, &sample));
+    HAL_SPI_TxCpltCallback(&hspi1);
+
+    // Assert - CS stays low, the idle bus is reserved for the card
+    TEST_ASSERT_EQUAL_STRING("aS1", queue_log);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiTransmitDMA(bus, data, 4u));
+
+    // The card's next transfer overtakes the sensor, then one clock frame with CS high
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceQueueTransfer(card, &last));
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_STRING("aS1aSAS2", queue_log);
+    TEST_ASSERT_EQUAL_HEX32(0u, format_tx_stream.CR & DMA_SxCR_MINC);
+
+    HAL_SPI_TxCpltCallback(&hspi1);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_STRING("aS1aSAS2bSB3", queue_log);
+    TEST_ASSERT_EQUAL_HEX32(DMA_SxCR_MINC, format_tx_stream.CR & DMA_SxCR_MINC);
+
+    BspSpiQueueStats_t stats;
+    BspSpiGetQueueStats(bus, &stats);
+    TEST_ASSERT_EQUAL(3u, stats.uCompleted);
+
+    // Cleanup
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(card));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(sensor));
+    format_cleanup();
+}
+
+void test_BspSpiDeviceQueueTransfer_HoldCs_ErrorOrRemoveReleasesChipSelect(void)
+{
+    // Arrange
+    queue_reset_trackers();
+    BspSpiHandle_t bus = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+
+    BspSpiDeviceHandle_t card   = add_device(bus, eM_FLASH_NCS, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+    BspSpiDeviceHandle_t sensor = add_device(bus, eM_WP, eBSP_SPI_CLOCK_MODE_0, eBSP_SPI_PRESCALER_2);
+    queue_reset_trackers();
+
+    uint8_t      cmd[6] = {0x52}, sensorTx[2] = {0x8F};
+    BspSpiXfer_t held   = {.pTxData = cmd, .uLength = 6u, .bHoldCs = true, .pCallback = test_queue_callback, .pContext = (void*)1};
+    BspSpiXfer_t sample = {.pTxData = sensorTx, .uLength = 2u, .pCallback = test_queue_callback, .pContext = (void*)3};
+
+    // Act - a failed held transfer ends the transaction
+    BspSpiDeviceQueueTransfer(card, &held);
+    HAL_SPI_ErrorCallback(&hspi1);
+
+    // Assert - CS released without a deselect clock, bus free again
+    TEST_ASSERT_EQUAL_STRING("aSA1", queue_log);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_TRANSFER, queue_cb_error);
+
+    // Removing the holding device releases CS and starts the waiting sensor
+    queue_reset_trackers();
+    BspSpiDeviceQueueTransfer(card, &held);
+    BspSpiDeviceQueueTransfer(sensor, &sample);
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(card));
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL_STRING("aS1AbSB3", queue_log);
+
+    // Cleanup
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiDeviceRemove(sensor));
+}
+
+// ============================================================================
+// Transfer Statistics Tests
+// ============================================================================
+
+static uint32_t stats_now_us = 0u;
+
+static uint32_t stub_micros(void)
+{
+    return stats_now_us;
+}
+
+void test_BspSpiStats_QueuedTransfers_LatencyIncludesQueueWait(void)
+{
+    // Arrange - two queued transfers requested at t = 0
+    queue_reset_trackers();
+    stats_now_us          = 0u;
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiSetTimebase(stub_micros);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiEnableStats(handle, true));
+
+    uint8_t      cmd[3] = {0x9F}, page[16] = {0};
+    BspSpiXfer_t first  = {.pTxData = cmd, .uLength = sizeof(cmd), .pCallback = test_queue_callback};
+    BspSpiXfer_t second = {.pTxData = page, .uLength = sizeof(page), .pCallback = test_queue_callback};
+
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+    BspSpiQueueTransfer(handle, &first);
+    BspSpiQueueTransfer(handle, &second);
+
+    // Act - first done at 20 us, second (started then) at 120 us
+    stats_now_us = 20u;
+    HAL_SPI_TxCpltCallback(&hspi1);
+    stats_now_us = 120u;
+    HAL_SPI_TxCpltCallback(&hspi1);
+
+    // Assert
+    BspSpiStats_t stats;
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiGetStats(handle, &stats));
+    TEST_ASSERT_EQUAL(2u, stats.uTransfers);
+    TEST_ASSERT_EQUAL(19u, stats.uBytes);
+    TEST_ASSERT_EQUAL(120u, stats.uBusyUs);
+    TEST_ASSERT_EQUAL(120u, stats.uLatencyMaxUs);
+    TEST_ASSERT_EQUAL(1u, stats.auLatency[1]); // 16-31 us
+    TEST_ASSERT_EQUAL(1u, stats.auLatency[3]); // 64-127 us
+    TEST_ASSERT_EQUAL(0u, stats.uErrors);
+
+    // Cleanup
+    BspSpiSetTimebase(NULL);
+    BspSpiFree(handle);
+}
+
+void test_BspSpiStats_DirectTransfers_CountRejectionsAndErrors(void)
+{
+    // Arrange
+    stats_now_us          = 0u;
+    BspSpiHandle_t handle = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiSetTimebase(stub_micros);
+    BspSpiEnableStats(handle, true);
+    hspi1.ErrorCode = HAL_SPI_ERROR_NONE;
+
+    uint8_t txData[8] = {0};
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, sizeof(txData), HAL_OK);
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, sizeof(txData), HAL_BUSY);
+    HAL_SPI_Transmit_DMA_ExpectAndReturn(&hspi1, txData, sizeof(txData), HAL_OK);
+
+    // Act - second request while the first is in flight, third ends with a DMA error
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmitDMA(handle, txData, sizeof(txData)));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_BUSY, BspSpiTransmitDMA(handle, txData, sizeof(txData)));
+    stats_now_us = 5000u;
+    HAL_SPI_TxCpltCallback(&hspi1);
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiTransmitDMA(handle, txData, sizeof(txData)));
+    stats_now_us = 5010u;
+    HAL_SPI_ErrorCallback(&hspi1);
+
+    // Assert - the rejected request does not disturb the timing of the first
+    BspSpiStats_t stats;
+    BspSpiGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(1u, stats.uTransfers);
+    TEST_ASSERT_EQUAL(8u, stats.uBytes);
+    TEST_ASSERT_EQUAL(1u, stats.uBusyRejections);
+    TEST_ASSERT_EQUAL(1u, stats.uErrors);
+    TEST_ASSERT_EQUAL(5010u, stats.uBusyUs);
+    TEST_ASSERT_EQUAL(1u, stats.auLatency[9]); // 4096-8191 us
+    TEST_ASSERT_EQUAL(1u, stats.auLatency[0]); // < 16 us
+
+    // Reset clears the counters
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_NONE, BspSpiResetStats(handle));
+    BspSpiGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(0u, stats.uErrors);
+    TEST_ASSERT_EQUAL(0u, stats.uBusyUs);
+
+    // Cleanup
+    BspSpiSetTimebase(NULL);
+    BspSpiFree(handle);
+}
+
+void test_BspSpiStats_DisabledByDefault_AndWithoutTimebase(void)
+{
+    // Arrange
+    BspSpiHandle_t handle    = BspSpiAllocate(eBSP_SPI_INSTANCE_2, eBSP_SPI_MODE_BLOCKING, 100);
+    uint8_t        txData[4] = {0};
+    BspSpiStats_t  stats;
+
+    HAL_SPI_Transmit_ExpectAndReturn(&hspi2, txData, sizeof(txData), 100, HAL_OK);
+    HAL_SPI_Transmit_ExpectAndReturn(&hspi2, txData, sizeof(txData), 100, HAL_OK);
+
+    // Act & Assert - nothing counted until enabled
+    BspSpiTransmit(handle, txData, sizeof(txData));
+    BspSpiGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(0u, stats.uTransfers);
+
+    // Without a timebase transfers are counted, times are not
+    BspSpiEnableStats(handle, true);
+    BspSpiTransmit(handle, txData, sizeof(txData));
+    BspSpiGetStats(handle, &stats);
+    TEST_ASSERT_EQUAL(1u, stats.uTransfers);
+    TEST_ASSERT_EQUAL(4u, stats.uBytes);
+    TEST_ASSERT_EQUAL(0u, stats.auLatency[0]);
+
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiEnableStats(-1, true));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiGetStats(-1, &stats));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_PARAM, BspSpiGetStats(handle, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPI_ERR_INVALID_HANDLE, BspSpiResetStats(-1));
+
+    // Cleanup
+    BspSpiFree(handle);
+}
@@ -0,0 +1,508 @@
+/**
+ * @file ut_bsp_spiacq.c
+ * @brief Unit tests for BSP SPI acquisition engine
+ *
+ * An IMU (1 kHz, 14-byte burst) and a pressure sensor (100 Hz, 6 bytes)
+ * share SPI1. The engine runs on the real bsp_spi device queue; DMA
+ * transfers complete after their bus time and SysTick fires every simulated
+ * millisecond. Each sensor answers a read with consecutive byte values
+ * starting at a per-read base, so a torn sample is detectable.
+ */
+
+#include "Mockstm32f4xx_hal_gpio.h"
+#include "Mockstm32f4xx_hal_spi.h"
+#include "bsp_spi.h"
+#include "bsp_spiacq.h"
+#include "gpio_struct.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================================================
+ * Test Stubs and Mocks
+ * ========================================================================== */
+
+extern void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi);
+extern void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi);
+extern void HAL_SYSTICK_Callback(void);
+
+/* Mock SPI peripherals and HAL handles - required by production code */
+static SPI_TypeDef mock_SPI1;
+static SPI_TypeDef mock_SPI2;
+static SPI_TypeDef mock_SPI3;
+static SPI_TypeDef mock_SPI4;
+static SPI_TypeDef mock_SPI5;
+static SPI_TypeDef mock_SPI6;
+
+SPI_HandleTypeDef hspi1 = {.Instance = &mock_SPI1};
+SPI_HandleTypeDef hspi2 = {.Instance = &mock_SPI2};
+SPI_HandleTypeDef hspi3 = {.Instance = &mock_SPI3};
+SPI_HandleTypeDef hspi4 = {.Instance = &mock_SPI4};
+SPI_HandleTypeDef hspi5 = {.Instance = &mock_SPI5};
+SPI_HandleTypeDef hspi6 = {.Instance = &mock_SPI6};
+
+/* Sensor chip selects: IMU on PB12, pressure sensor on PB13 */
+static GPIO_TypeDef mock_GPIOB;
+
+const gpio_t gpio_pins[eGPIO_COUNT] = {
+    [eM_FLASH_NCS] = {&mock_GPIOB, GPIO_PIN_12},
+    [eM_WP]        = {&mock_GPIOB, GPIO_PIN_13},
+};
+
+/* ============================================================================
+ * Bus and Sensor Model
+ * ========================================================================== */
+
+#define SIM_NS_PER_MS (1000000uLL)
+/** One byte at 10.5 MHz (fPCLK2 84 MHz / 8) */
+#define SIM_BYTE_NS (762u)
+
+#define SIM_IMU_CMD  (0xBBu) /* read | ACCEL_XOUT_H */
+#define SIM_BARO_CMD (0xF7u) /* PRESS_MSB */
+
+/**
+ * @brief Sensor state.
+ */
+typedef struct
+{
+    uint8_t  byCmd;     /**< Expected read command */
+    uint32_t uReads;    /**< Chip select assertions */
+    uint32_t uBadCmds;  /**< Reads with an unexpected command */
+    uint32_t uPos;      /**< Bytes clocked since chip select */
+} SimSensor_t;
+
+static SimSensor_t s_atSensor[2];
+static int         s_iSelected = -1;
+static uint64_t    s_uNowNs;
+static uint64_t    s_uByteNs;
+static bool        s_bDmaPending;
+static bool        s_bDmaIsRx;
+static uint64_t    s_uDmaDoneNs;
+static bool        s_bFailDma;
+
+/* Stub for HAL_GetTick - simulated time */
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(s_uNowNs / SIM_NS_PER_MS);
+}
+
+/* Microsecond timebase for the engine */
+static uint32_t test_micros(void)
+{
+    return (uint32_t)(s_uNowNs / 1000u);
+}
+
+static void stub_gpio_write_pin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState, int cmock_num_calls)
+{
+    (void)GPIOx;
+    (void)cmock_num_calls;
+    int iSensor = (GPIO_Pin == GPIO_PIN_12) ? 0 : 1;
+
+    if (PinState == GPIO_PIN_RESET)
+    {
+        TEST_ASSERT_EQUAL(-1, s_iSelected);
+        s_iSelected                = iSensor;
+        s_atSensor[iSensor].uPos   = 0u;
+        s_atSensor[iSensor].uReads++;
+    }
+    else if (s_iSelected == iSensor)
+    {
+        s_iSelected = -1;
+    }
+}
+
+static uint8_t sSimByte(uint8_t byTx)
+{
+    SimSensor_t* pSensor = &s_atSensor[s_iSelected];
+    uint32_t     uPos    = pSensor->uPos++;
+
+    if (uPos == 0u)
+    {
+        pSensor->uBadCmds += (byTx != pSensor->byCmd) ? 1u : 0u;
+        return 0xFFu;
+    }
+
+    /* Consecutive values from a base that changes with every read */
+    return (uint8_t)((pSensor->uReads * 16u) + (uPos - 1u));
+}
+
+static HAL_StatusTypeDef sSimStartDma(const uint8_t* pTx, uint8_t* pRx, uint16_t uSize)
+{
+    TEST_ASSERT_NOT_EQUAL(-1, s_iSelected);
+    TEST_ASSERT_FALSE(s_bDmaPending);
+
+    if (s_bFailDma)
+    {
+        return HAL_ERROR;
+    }
+
+    for (uint16_t i = 0u; i < uSize; i++)
+    {
+        uint8_t byRx = sSimByte((pTx != NULL) ? pTx[i] : 0xFFu);
+        if (pRx != NULL)
+        {
+            pRx[i] = byRx;
+        }
+    }
+
+    s_bDmaPending = true;
+    s_bDmaIsRx    = (pRx != NULL);
+    s_uDmaDoneNs  = s_uNowNs + ((uint64_t)uSize * s_uByteNs);
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef stub_transmit_dma(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, int cmock_num_calls)
+{
+    (void)hspi;
+    (void)cmock_num_calls;
+    return sSimStartDma(pData, NULL, Size);
+}
+
+static HAL_StatusTypeDef stub_receive_dma(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, int cmock_num_calls)
+{
+    (void)hspi;
+    (void)cmock_num_calls;
+    return sSimStartDma(NULL, pData, Size);
+}
+
+/**
+ * @brief Advance simulated time, running DMA completions and SysTick.
+ */
+static void sSimRunMs(uint32_t uMs)
+{
+    uint64_t uEndNs = s_uNowNs + ((uint64_t)uMs * SIM_NS_PER_MS);
+
+    while (s_uNowNs < uEndNs)
+    {
+        uint64_t uNextTickNs = ((s_uNowNs / SIM_NS_PER_MS) + 1u) * SIM_NS_PER_MS;
+
+        if (s_bDmaPending && (s_uDmaDoneNs <= uNextTickNs) && (s_uDmaDoneNs <= uEndNs))
+        {
+            s_uNowNs      = s_uDmaDoneNs;
+            s_bDmaPending = false;
+
+            if (s_bDmaIsRx)
+            {
+                HAL_SPI_RxCpltCallback(&hspi1);
+            }
+            else
+            {
+                HAL_SPI_TxCpltCallback(&hspi1);
+            }
+        }
+        else if (uNextTickNs <= uEndNs)
+        {
+            s_uNowNs = uNextTickNs;
+            HAL_SYSTICK_Callback();
+        }
+        else
+        {
+            s_uNowNs = uEndNs;
+        }
+    }
+}
+
+/**
+ * @brief Complete the transfers in flight without advancing to the next tick.
+ */
+static void sSimFlushDma(void)
+{
+    while (s_bDmaPending)
+    {
+        s_uNowNs      = s_uDmaDoneNs;
+        s_bDmaPending = false;
+
+        if (s_bDmaIsRx)
+        {
+            HAL_SPI_RxCpltCallback(&hspi1);
+        }
+        else
+        {
+            HAL_SPI_TxCpltCallback(&hspi1);
+        }
+    }
+}
+
+/* ============================================================================
+ * Test Fixtures
+ * ========================================================================== */
+
+static BspSpiHandle_t       s_hBus = -1;
+static BspSpiDeviceHandle_t s_hImuDev;
+static BspSpiDeviceHandle_t s_hBaroDev;
+static uint32_t             s_uNotifications;
+
+static void test_sample_callback(BspSpiAcqHandle_t handle)
+{
+    (void)handle;
+    s_uNotifications++;
+}
+
+static BspSpiAcqHandle_t sAddImu(void)
+{
+    BspSpiAcqConfig_t tConfig = {.hDevice         = s_hImuDev,
+                                 .abyCommand      = {SIM_IMU_CMD},
+                                 .byCommandLength = 1u,
+                                 .byResultLength  = 14u,
+                                 .uPeriodMs       = 1u,
+                                 .pOnSample       = test_sample_callback};
+    return BspSpiAcqAdd(&tConfig);
+}
+
+static BspSpiAcqHandle_t sAddBaro(void)
+{
+    BspSpiAcqConfig_t tConfig = {
+        .hDevice = s_hBaroDev, .abyCommand = {SIM_BARO_CMD}, .byCommandLength = 1u, .byResultLength = 6u, .uPeriodMs = 10u};
+    return BspSpiAcqAdd(&tConfig);
+}
+
+/* Sample bytes must come from a single read: consecutive values */
+static void sAssertNotTorn(const BspSpiAcqSample_t* pSample)
+{
+    for (uint32_t i = 1u; i < pSample->uLength; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8((uint8_t)(pSample->pData[0] + i), pSample->pData[i]);
+    }
+}
+
+void setUp(void)
+{
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+    HAL_SPI_Receive_DMA_StubWithCallback(stub_receive_dma);
+
+    for (int8_t i = 0; i < (int8_t)BSP_SPIACQ_MAX_CHANNELS; i++)
+    {
+        BspSpiAcqStop(i);
+    }
+    sSimRunMs(2u);
+    for (int8_t i = 0; i < (int8_t)BSP_SPIACQ_MAX_CHANNELS; i++)
+    {
+        BspSpiAcqRemove(i);
+    }
+    for (int8_t i = 0; i < (int8_t)BSP_SPI_MAX_DEVICES; i++)
+    {
+        BspSpiDeviceRemove(i);
+    }
+    for (int8_t i = 0; i < 6; i++)
+    {
+        BspSpiFree(i);
+    }
+
+    memset(s_atSensor, 0, sizeof(s_atSensor));
+    s_atSensor[0].byCmd = SIM_IMU_CMD;
+    s_atSensor[1].byCmd = SIM_BARO_CMD;
+    s_iSelected         = -1;
+    s_uByteNs           = SIM_BYTE_NS;
+    s_bDmaPending       = false;
+    s_bFailDma          = false;
+    s_uNotifications    = 0u;
+    hspi1.State         = HAL_SPI_STATE_READY;
+
+    s_hBus = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+
+    BspSpiDeviceConfig_t tImu  = {.hBus = s_hBus, .uCsPin = eM_FLASH_NCS, .eClockMode = eBSP_SPI_CLOCK_MODE_3, .ePrescaler = eBSP_SPI_PRESCALER_8};
+    BspSpiDeviceConfig_t tBaro = {.hBus = s_hBus, .uCsPin = eM_WP, .eClockMode = eBSP_SPI_CLOCK_MODE_0, .ePrescaler = eBSP_SPI_PRESCALER_8};
+    s_hImuDev                  = BspSpiDeviceAdd(&tImu);
+    s_hBaroDev                 = BspSpiDeviceAdd(&tBaro);
+
+    BspSpiAcqSetTimebase(test_micros);
+}
+
+void tearDown(void)
+{
+}
+
+/* ============================================================================
+ * Scheduling
+ * ========================================================================== */
+
+void test_BspSpiAcq_SchedulesSensorsOnSharedBus(void)
+{
+    // Arrange
+    char              acMsg[160];
+    BspSpiAcqHandle_t hImu  = sAddImu();
+    BspSpiAcqHandle_t hBaro = sAddBaro();
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqStart(hImu));
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqStart(hBaro));
+    sSimRunMs(100u);
+
+    // Assert - one read per period, nothing missed
+    BspSpiAcqStats_t tImu, tBaro;
+    BspSpiAcqGetStats(hImu, &tImu);
+    BspSpiAcqGetStats(hBaro, &tBaro);
+    TEST_ASSERT_UINT32_WITHIN(1u, 100u, tImu.uSamples);
+    TEST_ASSERT_UINT32_WITHIN(1u, 10u, tBaro.uSamples);
+    TEST_ASSERT_EQUAL(0u, tImu.uMissed + tBaro.uMissed);
+    TEST_ASSERT_EQUAL(0u, tImu.uErrors + tBaro.uErrors);
+    TEST_ASSERT_EQUAL(tImu.uSamples, s_uNotifications);
+    TEST_ASSERT_EQUAL(0u, s_atSensor[0].uBadCmds + s_atSensor[1].uBadCmds);
+
+    // The pressure read shares its tick with an IMU read and waits behind it
+    TEST_ASSERT_LESS_OR_EQUAL(20u, tImu.uJitterMaxUs);
+    TEST_ASSERT_GREATER_THAN(15u * SIM_BYTE_NS / 1000u, tBaro.uLatencyMaxUs);
+
+    // Latest sample
+    BspSpiAcqSample_t tSample;
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqGetLatest(hImu, &tSample));
+    TEST_ASSERT_TRUE(tSample.bFresh);
+    TEST_ASSERT_EQUAL(tImu.uSamples, tSample.uSequence);
+    TEST_ASSERT_EQUAL(14u, tSample.uLength);
+    sAssertNotTorn(&tSample);
+
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqGetLatest(hImu, &tSample));
+    TEST_ASSERT_FALSE(tSample.bFresh);
+    TEST_ASSERT_EQUAL(tImu.uSamples, tSample.uSequence);
+
+    snprintf(acMsg, sizeof(acMsg), "IMU: %lu samples, jitter max %lu us, latency max %lu us; pressure: latency max %lu us",
+             (unsigned long)tImu.uSamples, (unsigned long)tImu.uJitterMaxUs, (unsigned long)tImu.uLatencyMaxUs,
+             (unsigned long)tBaro.uLatencyMaxUs);
+    TEST_MESSAGE(acMsg);
+}
+
+void test_BspSpiAcq_SlowRead_CountsMissedDeadlines(void)
+{
+    // Arrange - 15 bytes at 100 us each: a read takes 1.5 periods
+    BspSpiAcqHandle_t hImu = sAddImu();
+    s_uByteNs              = 100000u;
+
+    // Act
+    BspSpiAcqStart(hImu);
+    sSimRunMs(100u);
+    BspSpiAcqStop(hImu);
+    sSimRunMs(2u);
+
+    // Assert - every other deadline skipped, never two reads in flight
+    BspSpiAcqStats_t tStats;
+    BspSpiAcqGetStats(hImu, &tStats);
+    TEST_ASSERT_UINT32_WITHIN(2u, 50u, tStats.uSamples);
+    TEST_ASSERT_UINT32_WITHIN(2u, 50u, tStats.uMissed);
+    TEST_ASSERT_EQUAL(tStats.uSamples, s_atSensor[0].uReads);
+
+    // Reset clears the counters
+    BspSpiAcqResetStats(hImu);
+    BspSpiAcqGetStats(hImu, &tStats);
+    TEST_ASSERT_EQUAL(0u, tStats.uSamples + tStats.uMissed);
+}
+
+void test_BspSpiAcq_TransferError_CountsErrorsAndKeepsLastSample(void)
+{
+    // Arrange
+    BspSpiAcqHandle_t hImu = sAddImu();
+    BspSpiAcqSample_t tSample;
+    BspSpiAcqStart(hImu);
+    sSimRunMs(3u);
+    sSimFlushDma();
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqGetLatest(hImu, &tSample));
+    uint32_t uLastSequence = tSample.uSequence;
+
+    // Act
+    s_bFailDma = true;
+    sSimRunMs(5u);
+
+    // Assert
+    BspSpiAcqStats_t tStats;
+    BspSpiAcqGetStats(hImu, &tStats);
+    TEST_ASSERT_EQUAL(5u, tStats.uErrors);
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqGetLatest(hImu, &tSample));
+    TEST_ASSERT_FALSE(tSample.bFresh);
+    TEST_ASSERT_EQUAL(uLastSequence, tSample.uSequence);
+}
+
+/* ============================================================================
+ * Triple Buffer
+ * ========================================================================== */
+
+void test_BspSpiAcq_TripleBuffer_ReaderSlotNeverWritten(void)
+{
+    // Arrange
+    BspSpiAcqHandle_t hImu = sAddImu();
+    BspSpiAcqSample_t tHeld, tSample;
+    uint8_t           abyCopy[14];
+    BspSpiAcqStart(hImu);
+    sSimRunMs(5u);
+
+    // Act - hold a sample while the writer publishes many more
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqGetLatest(hImu, &tHeld));
+    memcpy(abyCopy, tHeld.pData, sizeof(abyCopy));
+
+    for (uint32_t i = 0u; i < 50u; i++)
+    {
+        sSimRunMs(1u);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(abyCopy, tHeld.pData, sizeof(abyCopy));
+    }
+
+    // Assert - the next read gets the newest sample, consistent
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqGetLatest(hImu, &tSample));
+    TEST_ASSERT_TRUE(tSample.bFresh);
+    TEST_ASSERT_EQUAL(tHeld.uSequence + 50u, tSample.uSequence);
+    TEST_ASSERT_UINT32_WITHIN(1000u, (uint32_t)(s_uNowNs / 1000u), tSample.uTimestampUs);
+    sAssertNotTorn(&tSample);
+
+    // Every publish interleaved with a read: always the latest, never torn
+    for (uint32_t i = 0u; i < 20u; i++)
+    {
+        sSimRunMs(1u);
+        TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqGetLatest(hImu, &tSample));
+        TEST_ASSERT_TRUE(tSample.bFresh);
+        sAssertNotTorn(&tSample);
+    }
+}
+
+/* ============================================================================
+ * Parameter Validation
+ * ========================================================================== */
+
+void test_BspSpiAcq_InvalidParameters(void)
+{
+    BspSpiAcqConfig_t tConfig = {.hDevice = s_hImuDev, .abyCommand = {SIM_IMU_CMD}, .byCommandLength = 1u, .byResultLength = 14u, .uPeriodMs = 1u};
+    BspSpiAcqSample_t tSample;
+
+    // Configuration
+    TEST_ASSERT_EQUAL(BSP_SPIACQ_INVALID_HANDLE, BspSpiAcqAdd(NULL));
+    tConfig.uPeriodMs = 0u;
+    TEST_ASSERT_EQUAL(BSP_SPIACQ_INVALID_HANDLE, BspSpiAcqAdd(&tConfig));
+    tConfig.uPeriodMs      = 1u;
+    tConfig.byResultLength = BSP_SPIACQ_MAX_RESULT + 1u;
+    TEST_ASSERT_EQUAL(BSP_SPIACQ_INVALID_HANDLE, BspSpiAcqAdd(&tConfig));
+    tConfig.byResultLength  = 14u;
+    tConfig.byCommandLength = 0u;
+    TEST_ASSERT_EQUAL(BSP_SPIACQ_INVALID_HANDLE, BspSpiAcqAdd(&tConfig));
+    tConfig.byCommandLength = 1u;
+    tConfig.hDevice         = -1;
+    TEST_ASSERT_EQUAL(BSP_SPIACQ_INVALID_HANDLE, BspSpiAcqAdd(&tConfig));
+
+    // Handles
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_INVALID_HANDLE, BspSpiAcqStart(-1));
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_INVALID_HANDLE, BspSpiAcqStop(BSP_SPIACQ_MAX_CHANNELS));
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_INVALID_HANDLE, BspSpiAcqRemove(0));
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_INVALID_HANDLE, BspSpiAcqGetLatest(0, &tSample));
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_INVALID_HANDLE, BspSpiAcqGetStats(0, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_INVALID_HANDLE, BspSpiAcqResetStats(0));
+
+    // Channel table full
+    for (uint32_t i = 0u; i < BSP_SPIACQ_MAX_CHANNELS; i++)
+    {
+        TEST_ASSERT_NOT_EQUAL(BSP_SPIACQ_INVALID_HANDLE, sAddImu());
+    }
+    TEST_ASSERT_EQUAL(BSP_SPIACQ_INVALID_HANDLE, sAddImu());
+
+    // No sample before the first read, default timebase in milliseconds
+    BspSpiAcqSetTimebase(NULL);
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NO_DATA, BspSpiAcqGetLatest(0, &tSample));
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_INVALID_PARAM, BspSpiAcqGetLatest(0, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_INVALID_PARAM, BspSpiAcqGetStats(0, NULL));
+
+    BspSpiAcqStart(0);
+    sSimRunMs(2u);
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqGetLatest(0, &tSample));
+    TEST_ASSERT_EQUAL(0u, tSample.uTimestampUs % 1000u);
+
+    // Running channels cannot be removed
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_BUSY, BspSpiAcqRemove(0));
+    BspSpiAcqStop(0);
+    sSimRunMs(1u);
+    TEST_ASSERT_EQUAL(eBSP_SPIACQ_ERR_NONE, BspSpiAcqRemove(0));
+}
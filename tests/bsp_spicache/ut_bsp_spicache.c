@@ -0,0 +1,589 @@
+/**
+ * @file ut_bsp_spicache.c
+ * @brief Unit tests for BSP SPI memory cache module
+ *
+ * The cache runs on a real bsp_spi bus against a PSRAM/FRAM model behind the
+ * mocked HAL. The model decodes commands byte by byte (fast read with dummy
+ * byte, read, write, write enable) with 2 or 3 address bytes, and flags
+ * unknown commands and FRAM writes without write enable. Time is simulated:
+ * a DMA transfer ends after its bytes at the bus clock from CR1, and the
+ * HAL_GetTick stub the cache spins on delivers the completion interrupts.
+ * Application work between accesses is simulated with SpiSimCpu().
+ */
+
+#include "Mockstm32f4xx_hal_gpio.h"
+#include "bsp_spi.h"
+#include "bsp_spicache.h"
+#include "gpio_struct.h"
+#include "spi_sim.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================================================
+ * Test Stubs and Mocks
+ * ========================================================================== */
+
+/* Mock SPI peripherals and HAL handles - required by production code */
+static SPI_TypeDef mock_SPI1;
+static SPI_TypeDef mock_SPI2;
+static SPI_TypeDef mock_SPI3;
+static SPI_TypeDef mock_SPI4;
+static SPI_TypeDef mock_SPI5;
+static SPI_TypeDef mock_SPI6;
+
+SPI_HandleTypeDef hspi1 = {.Instance = &mock_SPI1};
+SPI_HandleTypeDef hspi2 = {.Instance = &mock_SPI2};
+SPI_HandleTypeDef hspi3 = {.Instance = &mock_SPI3};
+SPI_HandleTypeDef hspi4 = {.Instance = &mock_SPI4};
+SPI_HandleTypeDef hspi5 = {.Instance = &mock_SPI5};
+SPI_HandleTypeDef hspi6 = {.Instance = &mock_SPI6};
+
+/* Memory chip select on the bsp_gpio pin table */
+static GPIO_TypeDef mock_GPIOB;
+
+const gpio_t gpio_pins[eGPIO_COUNT] = {
+    [eM_FLASH_NCS] = {&mock_GPIOB, GPIO_PIN_12},
+};
+
+/* ============================================================================
+ * Memory Model
+ * ========================================================================== */
+
+/** 64 KiB: FRAM takes 2 address bytes, PSRAM always 3 */
+#define SIM_MEM_SIZE (65536u)
+/** Interrupt and DMA restart per transfer */
+#define SIM_XFER_NS (1000uLL)
+
+/**
+ * @brief Memory state.
+ */
+typedef struct
+{
+    bool     bFram;
+    bool     bSelected;
+    bool     bWel;        /**< FRAM write enable latch */
+    uint8_t  byCmd;
+    uint32_t uPos;        /**< Bytes received since chip select */
+    uint32_t uAddress;
+    uint32_t uAddrBytes;
+    uint32_t uReads;      /**< Read commands */
+    uint32_t uWrites;     /**< Write commands */
+    uint32_t uBusBytes;   /**< Bytes clocked with chip select low */
+    uint32_t uViolations;
+} SimMem_t;
+
+static uint8_t  s_abyMem[SIM_MEM_SIZE];
+static SimMem_t s_tSim;
+
+/* Stub for HAL_GetTick - the cache spins on it: jump to the next DMA completion */
+uint32_t HAL_GetTick(void)
+{
+    /* Nothing on the bus: one pass of the spin loop instead, so that a timeout expires */
+    SpiSimCpu(SpiSimDmaPending() ? SpiSimDmaDueNs() : 1000uLL);
+
+    return (uint32_t)(SpiSimNowNs() / SPI_SIM_NS_PER_MS);
+}
+
+/**
+ * @brief One byte on the bus, return MISO.
+ */
+static uint8_t sSimByte(uint8_t byTx, uint64_t uAtNs)
+{
+    uint32_t uPos    = s_tSim.uPos++;
+    uint32_t uHeader = 1u + s_tSim.uAddrBytes;
+
+    (void)uAtNs;
+
+    if (!s_tSim.bSelected)
+    {
+        return 0xFFu;
+    }
+
+    s_tSim.uBusBytes++;
+
+    if (uPos == 0u)
+    {
+        s_tSim.byCmd    = byTx;
+        s_tSim.uAddress = 0u;
+
+        if (byTx == 0x06u)
+        {
+            s_tSim.bWel = s_tSim.bFram;
+            s_tSim.uViolations += s_tSim.bFram ? 0u : 1u;
+        }
+        else if ((byTx == 0x02u) || (byTx == (s_tSim.bFram ? 0x03u : 0x0Bu)))
+        {
+            if (byTx == 0x02u)
+            {
+                s_tSim.uWrites++;
+                s_tSim.uViolations += (s_tSim.bFram && !s_tSim.bWel) ? 1u : 0u;
+            }
+            else
+            {
+                s_tSim.uReads++;
+            }
+        }
+        else
+        {
+            s_tSim.uViolations++;
+        }
+        return 0xFFu;
+    }
+
+    if (uPos < uHeader)
+    {
+        s_tSim.uAddress = (s_tSim.uAddress << 8u) | byTx;
+        return 0xFFu;
+    }
+
+    if (s_tSim.byCmd == 0x0Bu)
+    {
+        /* Dummy byte */
+        uHeader++;
+        if (uPos < uHeader)
+        {
+            return 0xFFu;
+        }
+    }
+
+    uint32_t uAddress = (s_tSim.uAddress + (uPos - uHeader)) % SIM_MEM_SIZE;
+
+    if (s_tSim.byCmd == 0x02u)
+    {
+        if (!s_tSim.bFram || s_tSim.bWel)
+        {
+            s_abyMem[uAddress] = byTx;
+        }
+        return 0xFFu;
+    }
+
+    if ((s_tSim.byCmd == 0x03u) || (s_tSim.byCmd == 0x0Bu))
+    {
+        return s_abyMem[uAddress];
+    }
+
+    return 0xFFu;
+}
+
+static void stub_gpio_write_pin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState, int cmock_num_calls)
+{
+    (void)GPIOx;
+    (void)cmock_num_calls;
+
+    if (GPIO_Pin != GPIO_PIN_12)
+    {
+        return;
+    }
+
+    if (PinState == GPIO_PIN_RESET)
+    {
+        s_tSim.bSelected = true;
+        s_tSim.uPos      = 0u;
+        return;
+    }
+
+    /* The write enable latch is cleared by a completed write */
+    if (s_tSim.bSelected && (s_tSim.byCmd == 0x02u) && (s_tSim.uPos > 0u))
+    {
+        s_tSim.bWel = false;
+    }
+    s_tSim.bSelected = false;
+}
+
+/* ============================================================================
+ * Test Fixtures
+ * ========================================================================== */
+
+#define TEST_LINE_SIZE  (64u)
+#define TEST_LINE_COUNT (16u)
+
+static BspSpiHandle_t      s_hBus   = -1;
+static BspSpiCacheHandle_t s_hCache = -1;
+static uint8_t             s_abyLines[TEST_LINE_SIZE * TEST_LINE_COUNT];
+static uint8_t             s_abyRef[SIM_MEM_SIZE];
+
+static BspSpiCacheConfig_t sConfig(BspSpiCacheMem_e eMemory, uint16_t uLineSize, uint16_t uLineCount, BspSpiCachePolicy_e ePolicy,
+                                   bool bPrefetch)
+{
+    BspSpiCacheConfig_t tConfig = {.hBus       = s_hBus,
+                                   .uCsPin     = eM_FLASH_NCS,
+                                   .ePrescaler = eBSP_SPI_PRESCALER_4,
+                                   .eMemory    = eMemory,
+                                   .uSize      = SIM_MEM_SIZE,
+                                   .pLines     = s_abyLines,
+                                   .uLineSize  = uLineSize,
+                                   .uLineCount = uLineCount,
+                                   .ePolicy    = ePolicy,
+                                   .bPrefetch  = bPrefetch};
+    return tConfig;
+}
+
+/**
+ * @brief Replace the fixture cache.
+ */
+static void sReallocate(BspSpiCacheMem_e eMemory, uint16_t uLineSize, uint16_t uLineCount, BspSpiCachePolicy_e ePolicy, bool bPrefetch)
+{
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheFree(s_hCache));
+    s_tSim.bFram      = (eMemory == eBSP_SPICACHE_MEM_FRAM);
+    s_tSim.uAddrBytes = s_tSim.bFram ? 2u : 3u;
+
+    BspSpiCacheConfig_t tConfig = sConfig(eMemory, uLineSize, uLineCount, ePolicy, bPrefetch);
+    s_hCache                    = BspSpiCacheAllocate(&tConfig);
+    TEST_ASSERT_NOT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, s_hCache);
+}
+
+static BspSpiCacheStats_t sStats(void)
+{
+    BspSpiCacheStats_t tStats;
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheGetStats(s_hCache, &tStats));
+    return tStats;
+}
+
+/** @brief A cache access must not return with its fill still on the bus */
+static void sAssertBusIdle(void)
+{
+    TEST_ASSERT_FALSE(SpiSimDmaPending());
+}
+
+void setUp(void)
+{
+    for (int8_t i = 0; i < (int8_t)BSP_SPICACHE_MAX_INSTANCES; i++)
+    {
+        BspSpiCacheFree(i);
+    }
+    for (int8_t i = 0; i < 6; i++)
+    {
+        BspSpiFree(i);
+    }
+
+    SpiSimFillPattern(s_abyMem, sizeof(s_abyMem), 0u);
+    memcpy(s_abyRef, s_abyMem, sizeof(s_abyRef));
+    memset(&s_tSim, 0, sizeof(s_tSim));
+    s_tSim.uAddrBytes = 3u;
+    mock_SPI1.CR1     = 0u;
+
+    SpiSimConfig_t tSimConfig = {.pByte = sSimByte, .uByteNs = 0u, .uXferNs = SIM_XFER_NS, .pOnTick = NULL};
+    SpiSimReset(&tSimConfig);
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+
+    s_hBus                      = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    BspSpiCacheConfig_t tConfig = sConfig(eBSP_SPICACHE_MEM_PSRAM, TEST_LINE_SIZE, TEST_LINE_COUNT, eBSP_SPICACHE_POLICY_LRU, false);
+    s_hCache                    = BspSpiCacheAllocate(&tConfig);
+}
+
+void tearDown(void)
+{
+    SpiSimCpu(SPI_SIM_NS_PER_MS);
+    BspSpiCacheFree(s_hCache);
+    BspSpiFree(s_hBus);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+}
+
+/* ============================================================================
+ * Tests
+ * ========================================================================== */
+
+void test_BspSpiCache_Allocate_InvalidConfig(void)
+{
+    BspSpiCacheConfig_t tConfig;
+    uint8_t             abyData[4];
+
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(NULL));
+
+    /* Line size not a power of two, too small, too large */
+    tConfig = sConfig(eBSP_SPICACHE_MEM_PSRAM, 48u, 4u, eBSP_SPICACHE_POLICY_LRU, false);
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+    tConfig.uLineSize = 8u;
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+    tConfig.uLineSize = 2048u;
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+
+    /* Line count, storage, memory size */
+    tConfig = sConfig(eBSP_SPICACHE_MEM_PSRAM, 64u, BSP_SPICACHE_MAX_LINES + 1u, eBSP_SPICACHE_POLICY_LRU, false);
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+    tConfig.uLineCount = 0u;
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+    tConfig        = sConfig(eBSP_SPICACHE_MEM_PSRAM, 64u, 4u, eBSP_SPICACHE_POLICY_LRU, false);
+    tConfig.pLines = NULL;
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+    tConfig       = sConfig(eBSP_SPICACHE_MEM_PSRAM, 64u, 4u, eBSP_SPICACHE_POLICY_LRU, false);
+    tConfig.uSize = 1000u;
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+    tConfig.uSize = 0x2000000u;
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+
+    /* Only one instance configured */
+    tConfig = sConfig(eBSP_SPICACHE_MEM_PSRAM, 64u, 4u, eBSP_SPICACHE_POLICY_LRU, false);
+    TEST_ASSERT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, BspSpiCacheAllocate(&tConfig));
+
+    /* Access ranges and handles */
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_INVALID_PARAM, BspSpiCacheRead(s_hCache, SIM_MEM_SIZE - 2u, abyData, 4u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_INVALID_PARAM, BspSpiCacheRead(s_hCache, SIM_MEM_SIZE, abyData, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_INVALID_PARAM, BspSpiCacheRead(s_hCache, 0u, abyData, 0u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_INVALID_PARAM, BspSpiCacheWrite(s_hCache, 0u, NULL, 4u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_INVALID_HANDLE, BspSpiCacheRead(BSP_SPICACHE_MAX_INSTANCES, 0u, abyData, 4u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_INVALID_HANDLE, BspSpiCacheFlush(BSP_SPICACHE_INVALID_HANDLE));
+    TEST_ASSERT_EQUAL(0u, s_tSim.uBusBytes);
+}
+
+void test_BspSpiCache_Read_MissThenHit(void)
+{
+    uint8_t abyData[60];
+
+    /* Crosses a line boundary: two misses, one fast read per line */
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 1000u, abyData, sizeof(abyData)));
+    sAssertBusIdle();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyRef[1000], abyData, sizeof(abyData));
+    TEST_ASSERT_EQUAL(2u, s_tSim.uReads);
+
+    memset(abyData, 0, sizeof(abyData));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 1010u, abyData, 50u));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyRef[1010], abyData, 50u);
+    TEST_ASSERT_EQUAL(2u, s_tSim.uReads);
+
+    BspSpiCacheStats_t tStats = sStats();
+    TEST_ASSERT_EQUAL(2u, tStats.uReadMisses);
+    TEST_ASSERT_EQUAL(2u, tStats.uReadHits);
+    TEST_ASSERT_EQUAL(s_tSim.uBusBytes, tStats.uBusBytes);
+    TEST_ASSERT_EQUAL(2u * (5u + TEST_LINE_SIZE), tStats.uBusBytes);
+
+    /* Memory changed behind the cache: stale until invalidated */
+    s_abyMem[1010] ^= 0xFFu;
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 1010u, abyData, 1u));
+    TEST_ASSERT_EQUAL_HEX8(s_abyRef[1010], abyData[0]);
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheInvalidate(s_hCache));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 1010u, abyData, 1u));
+    TEST_ASSERT_EQUAL_HEX8(s_abyRef[1010] ^ 0xFFu, abyData[0]);
+
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheResetStats(s_hCache));
+    TEST_ASSERT_EQUAL(0u, sStats().uReadMisses);
+}
+
+void test_BspSpiCache_Write_BackOnFlushAndEviction_Fram(void)
+{
+    uint8_t abyData[TEST_LINE_SIZE];
+
+    sReallocate(eBSP_SPICACHE_MEM_FRAM, TEST_LINE_SIZE, 4u, eBSP_SPICACHE_POLICY_LRU, false);
+
+    /* Partial line: read for ownership; whole line: no read */
+    SpiSimFillPattern(abyData, sizeof(abyData), 0x55u);
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheWrite(s_hCache, 70u, abyData, 10u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheWrite(s_hCache, 256u, abyData, TEST_LINE_SIZE));
+    TEST_ASSERT_EQUAL(1u, s_tSim.uReads);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uWrites);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyRef[70], &s_abyMem[70], 10u);
+
+    /* Reads see the cached data */
+    uint8_t abyCheck[10];
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 70u, abyCheck, 10u));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(abyData, abyCheck, 10u);
+
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheFlush(s_hCache));
+    memcpy(&s_abyRef[70], abyData, 10u);
+    memcpy(&s_abyRef[256], abyData, TEST_LINE_SIZE);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_abyRef, s_abyMem, 512u);
+    TEST_ASSERT_EQUAL(2u, s_tSim.uWrites);
+
+    /* Clean lines are not written again */
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheFlush(s_hCache));
+    TEST_ASSERT_EQUAL(2u, s_tSim.uWrites);
+
+    /* Dirty victim: write-back queued ahead of the fill reusing its buffer */
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheWrite(s_hCache, 1024u, abyData, 1u));
+    for (uint32_t i = 1u; i <= 4u; i++)
+    {
+        TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 1024u + (i * 4096u), abyCheck, 1u));
+        TEST_ASSERT_EQUAL_HEX8(s_abyRef[1024u + (i * 4096u)], abyCheck[0]);
+    }
+    TEST_ASSERT_EQUAL(3u, s_tSim.uWrites);
+    TEST_ASSERT_EQUAL_HEX8(abyData[0], s_abyMem[1024]);
+
+    BspSpiCacheStats_t tStats = sStats();
+    TEST_ASSERT_EQUAL(3u, tStats.uWriteBacks);
+    TEST_ASSERT_EQUAL(3u, tStats.uWriteMisses);
+    TEST_ASSERT_EQUAL(s_tSim.uBusBytes, tStats.uBusBytes);
+
+    /* Invalidate drops a dirty line */
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheWrite(s_hCache, 2048u, abyData, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheInvalidate(s_hCache));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheFlush(s_hCache));
+    TEST_ASSERT_EQUAL_HEX8(s_abyRef[2048], s_abyMem[2048]);
+}
+
+void test_BspSpiCache_Free_FlushesDirtyLines(void)
+{
+    uint8_t byValue = 0xA5u;
+
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheWrite(s_hCache, 4242u, &byValue, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheFree(s_hCache));
+    TEST_ASSERT_EQUAL_HEX8(0xA5u, s_abyMem[4242]);
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_INVALID_HANDLE, BspSpiCacheFree(s_hCache));
+}
+
+void test_BspSpiCache_Replacement_LruVersusClock(void)
+{
+    /* Lines A..G 1 KiB apart; A to D fill the four lines */
+    static const uint8_t abyTrace[] = {0u, 1u, 2u, 3u, 4u, 2u, 1u, 5u, 2u, 6u};
+    uint8_t              byData;
+
+    for (uint32_t uPolicy = 0u; uPolicy < 2u; uPolicy++)
+    {
+        sReallocate(eBSP_SPICACHE_MEM_PSRAM, TEST_LINE_SIZE, 4u, (BspSpiCachePolicy_e)uPolicy, false);
+
+        for (uint32_t i = 0u; i < sizeof(abyTrace); i++)
+        {
+            TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, abyTrace[i] * 1024u, &byData, 1u));
+        }
+
+        /* E evicts A and F evicts D under both policies. For G, LRU takes E
+         * (oldest use); the clock hand has cleared B's bit while passing it
+         * for F, and B was not used since, so clock takes B */
+        TEST_ASSERT_EQUAL(7u, sStats().uReadMisses);
+        TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 1u * 1024u, &byData, 1u));
+        TEST_ASSERT_EQUAL((uPolicy == 0u) ? 7u : 8u, sStats().uReadMisses);
+    }
+}
+
+void test_BspSpiCache_Prefetch_SequentialScan(void)
+{
+    uint8_t abyData[16];
+
+    sReallocate(eBSP_SPICACHE_MEM_PSRAM, TEST_LINE_SIZE, 4u, eBSP_SPICACHE_POLICY_LRU, true);
+
+    /* The first two lines miss, the second starts the sequence; the last prefetch is not used */
+    for (uint32_t uAddress = 0u; uAddress < (8u * TEST_LINE_SIZE); uAddress += sizeof(abyData))
+    {
+        TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, uAddress, abyData, sizeof(abyData)));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyRef[uAddress], abyData, sizeof(abyData));
+        SpiSimCpu(2000u);
+    }
+
+    BspSpiCacheStats_t tStats = sStats();
+    TEST_ASSERT_EQUAL(2u, tStats.uReadMisses);
+    TEST_ASSERT_EQUAL(7u, tStats.uPrefetches);
+    TEST_ASSERT_EQUAL(6u, tStats.uPrefetchHits);
+    TEST_ASSERT_EQUAL(9u, s_tSim.uReads);
+
+    /* Random access does not prefetch; the end of the memory is not passed */
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 40000u, abyData, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, SIM_MEM_SIZE - (2u * TEST_LINE_SIZE), abyData, 1u));
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, SIM_MEM_SIZE - TEST_LINE_SIZE, abyData, 1u));
+    TEST_ASSERT_EQUAL(7u, sStats().uPrefetches);
+}
+
+void test_BspSpiCache_FillError_ReportsSpi(void)
+{
+    uint8_t abyData[4];
+
+    SpiSimFailNext();
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_SPI, BspSpiCacheRead(s_hCache, 128u, abyData, sizeof(abyData)));
+
+    /* The failed line is filled again on the next access */
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, 128u, abyData, sizeof(abyData)));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyRef[128], abyData, sizeof(abyData));
+}
+
+/**
+ * @brief Look-up table trace: a hot set of 8 small tables (128 bytes each)
+ * read at random, with 1 in 32 accesses anywhere in the memory and 1 in 16
+ * updating a table entry. Compared with going to the bus for every access.
+ */
+void test_BspSpiCache_Benchmark_LookupTrace(void)
+{
+    static uint8_t abyBig[TEST_LINE_SIZE * BSP_SPICACHE_MAX_LINES];
+    uint32_t       uSeed      = 12345u;
+    uint32_t       uAccesses  = 4000u;
+    uint64_t       uUncachedNs = 0u;
+    uint64_t       uStartNs;
+    uint64_t       uCachedNs;
+    char           acMsg[160];
+
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheFree(s_hCache));
+    BspSpiCacheConfig_t tConfig = sConfig(eBSP_SPICACHE_MEM_PSRAM, TEST_LINE_SIZE, BSP_SPICACHE_MAX_LINES, eBSP_SPICACHE_POLICY_LRU, false);
+    tConfig.pLines              = abyBig;
+    s_hCache                    = BspSpiCacheAllocate(&tConfig);
+    TEST_ASSERT_NOT_EQUAL(BSP_SPICACHE_INVALID_HANDLE, s_hCache);
+
+    uStartNs = SpiSimNowNs();
+    for (uint32_t i = 0u; i < uAccesses; i++)
+    {
+        uint32_t uAddress;
+        uint8_t  abyEntry[4];
+
+        uSeed = (uSeed * 1103515245u) + 12345u;
+        if (((uSeed >> 16u) & 31u) == 0u)
+        {
+            uAddress = ((uSeed >> 8u) % (SIM_MEM_SIZE / 4u)) * 4u;
+        }
+        else
+        {
+            uAddress = 8192u + (((uSeed >> 13u) & 7u) * 1024u) + (((uSeed >> 20u) & 31u) * 4u);
+        }
+
+        if (((uSeed >> 24u) & 15u) == 0u)
+        {
+            abyEntry[0] = (uint8_t)i;
+            TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheWrite(s_hCache, uAddress, abyEntry, 1u));
+            s_abyRef[uAddress] = (uint8_t)i;
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, uAddress, abyEntry, sizeof(abyEntry)));
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyRef[uAddress], abyEntry, sizeof(abyEntry));
+        }
+
+        /* Without the cache: fast read (5 + 4 bytes) or write (4 + 1 bytes) per access */
+        uUncachedNs += (((((uSeed >> 24u) & 15u) == 0u) ? 5u : 9u) * SpiSimByteNs()) + SIM_XFER_NS;
+    }
+    TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheFlush(s_hCache));
+    uCachedNs = SpiSimNowNs() - uStartNs;
+
+    BspSpiCacheStats_t tStats = sStats();
+    uint32_t           uHits  = tStats.uReadHits + tStats.uWriteHits;
+    uint32_t           uTotal = uHits + tStats.uReadMisses + tStats.uWriteMisses;
+
+    (void)snprintf(acMsg, sizeof(acMsg), "LUT trace, %u accesses: %u%% hits, %u write-backs, cached %u us vs uncached %u us (bus time)",
+                   (unsigned)uAccesses, (unsigned)((uHits * 100u) / uTotal), (unsigned)tStats.uWriteBacks, (unsigned)(uCachedNs / 1000u),
+                   (unsigned)(uUncachedNs / 1000u));
+    TEST_MESSAGE(acMsg);
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(s_abyRef, s_abyMem, SIM_MEM_SIZE);
+    TEST_ASSERT_GREATER_OR_EQUAL(80u, (uHits * 100u) / uTotal);
+    TEST_ASSERT_LESS_THAN(uUncachedNs / 2u, uCachedNs);
+}
+
+/**
+ * @brief Sequential scan of 16 KiB in 32-byte records with 10 µs of work per
+ * record, with and without prefetch.
+ */
+void test_BspSpiCache_Benchmark_SequentialPrefetch(void)
+{
+    uint64_t auNs[2];
+    char     acMsg[160];
+
+    for (uint32_t uPrefetch = 0u; uPrefetch < 2u; uPrefetch++)
+    {
+        uint64_t uStartNs;
+
+        sReallocate(eBSP_SPICACHE_MEM_PSRAM, TEST_LINE_SIZE, 4u, eBSP_SPICACHE_POLICY_LRU, uPrefetch != 0u);
+
+        uStartNs = SpiSimNowNs();
+        for (uint32_t uAddress = 0u; uAddress < 16384u; uAddress += 32u)
+        {
+            uint8_t abyRecord[32];
+
+            TEST_ASSERT_EQUAL(eBSP_SPICACHE_ERR_NONE, BspSpiCacheRead(s_hCache, uAddress, abyRecord, sizeof(abyRecord)));
+            SpiSimCpu(10000u);
+        }
+        auNs[uPrefetch] = SpiSimNowNs() - uStartNs;
+    }
+
+    BspSpiCacheStats_t tStats = sStats();
+    (void)snprintf(acMsg, sizeof(acMsg), "Sequential 16 KiB, 64-byte lines: %u us without prefetch, %u us with (%u prefetches, %u used)",
+                   (unsigned)(auNs[0] / 1000u), (unsigned)(auNs[1] / 1000u), (unsigned)tStats.uPrefetches, (unsigned)tStats.uPrefetchHits);
+    TEST_MESSAGE(acMsg);
+
+    TEST_ASSERT_EQUAL(tStats.uPrefetches - 1u, tStats.uPrefetchHits);
+    TEST_ASSERT_LESS_THAN((auNs[0] * 80u) / 100u, auNs[1]);
+}
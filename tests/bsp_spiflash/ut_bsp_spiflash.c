@@ -0,0 +1,583 @@
+/**
+ * @file ut_bsp_spiflash.c
+ * @brief Unit tests for BSP SPI NOR flash module
+ *
+ * The driver runs on a real bsp_spi bus against a W25Q16JV model behind the
+ * mocked HAL: DMA transfers feed the model byte by byte and complete after
+ * their bus time at 21 MHz, chip select executes the command, and program and
+ * erase keep the busy flag set for typical datasheet times. Time is simulated;
+ * SysTick fires at every millisecond boundary.
+ */
+
+#include "Mockstm32f4xx_hal_gpio.h"
+#include "bsp_spi.h"
+#include "bsp_spiflash.h"
+#include "gpio_struct.h"
+#include "spi_sim.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================================================
+ * Test Stubs and Mocks
+ * ========================================================================== */
+
+extern void HAL_SYSTICK_Callback(void);
+
+/* Mock SPI peripherals and HAL handles - required by production code */
+static SPI_TypeDef mock_SPI1;
+static SPI_TypeDef mock_SPI2;
+static SPI_TypeDef mock_SPI3;
+static SPI_TypeDef mock_SPI4;
+static SPI_TypeDef mock_SPI5;
+static SPI_TypeDef mock_SPI6;
+
+SPI_HandleTypeDef hspi1 = {.Instance = &mock_SPI1};
+SPI_HandleTypeDef hspi2 = {.Instance = &mock_SPI2};
+SPI_HandleTypeDef hspi3 = {.Instance = &mock_SPI3};
+SPI_HandleTypeDef hspi4 = {.Instance = &mock_SPI4};
+SPI_HandleTypeDef hspi5 = {.Instance = &mock_SPI5};
+SPI_HandleTypeDef hspi6 = {.Instance = &mock_SPI6};
+
+/* Flash chip select on the bsp_gpio pin table */
+static GPIO_TypeDef mock_GPIOB;
+
+const gpio_t gpio_pins[eGPIO_COUNT] = {
+    [eM_FLASH_NCS] = {&mock_GPIOB, GPIO_PIN_12},
+};
+
+/* ============================================================================
+ * Flash Model
+ * ========================================================================== */
+
+/** W25Q16JV: 2 MiB, JEDEC ID EF 40 15 */
+#define SIM_FLASH_SIZE (2u * 1024u * 1024u)
+/** One byte at 21 MHz (fPCLK2 84 MHz / 4) */
+#define SIM_BYTE_NS (381u)
+/** Typical page program, 4 KiB sector erase and 64 KiB block erase times */
+#define SIM_PAGE_PROG_NS    (400000uLL)
+#define SIM_SECTOR_ERASE_NS (45000000uLL)
+#define SIM_BLOCK_ERASE_NS  (150000000uLL)
+
+/**
+ * @brief Flash chip state.
+ */
+typedef struct
+{
+    uint8_t  abyId[3];
+    bool     bStuck;      /**< Busy flag never clears */
+    bool     bSelected;
+    uint8_t  byCmd;
+    uint32_t uPos;        /**< Bytes clocked since chip select */
+    uint32_t uAddress;
+    bool     bWel;        /**< Write enable latch */
+    uint64_t uBusyUntilNs;
+    uint8_t  abyLatch[256]; /**< Page program buffer, wraps inside the page */
+    uint32_t uPrograms;
+    uint32_t uSectorErases;
+    uint32_t uBlockErases;
+    uint32_t uFastReads;
+    uint32_t uViolations; /**< Commands while busy, program/erase without WREN, bad lengths */
+} SimFlash_t;
+
+static uint8_t    s_abyMem[SIM_FLASH_SIZE];
+static SimFlash_t s_tSim;
+
+/* Stub for HAL_GetTick - simulated time */
+uint32_t HAL_GetTick(void)
+{
+    return (uint32_t)(SpiSimNowNs() / SPI_SIM_NS_PER_MS);
+}
+
+static bool sSimBusy(void)
+{
+    return s_tSim.bStuck || (SpiSimNowNs() < s_tSim.uBusyUntilNs);
+}
+
+static void sSimAddressByte(uint8_t byTx)
+{
+    s_tSim.uAddress = (s_tSim.uAddress << 8u) | byTx;
+}
+
+/**
+ * @brief Clock one byte through the chip.
+ */
+static uint8_t sSimByte(uint8_t byTx, uint64_t uAtNs)
+{
+    uint32_t uPos = s_tSim.uPos++;
+    uint8_t  byRx = 0xFFu;
+
+    (void)uAtNs;
+    TEST_ASSERT_TRUE(s_tSim.bSelected);
+
+    if (uPos == 0u)
+    {
+        s_tSim.byCmd    = byTx;
+        s_tSim.uAddress = 0u;
+        if (sSimBusy() && (byTx != 0x05u))
+        {
+            s_tSim.uViolations++;
+        }
+        if (byTx == 0x02u)
+        {
+            memset(s_tSim.abyLatch, 0xFF, sizeof(s_tSim.abyLatch));
+        }
+        return byRx;
+    }
+
+    switch (s_tSim.byCmd)
+    {
+        case 0x9Fu: /* RDID */
+            byRx = (uPos <= 3u) ? s_tSim.abyId[uPos - 1u] : 0xFFu;
+            break;
+        case 0x05u: /* RDSR */
+            byRx = (uint8_t)((sSimBusy() ? 0x01u : 0x00u) | (s_tSim.bWel ? 0x02u : 0x00u));
+            break;
+        case 0x0Bu: /* FAST READ */
+            if (uPos <= 3u)
+            {
+                sSimAddressByte(byTx);
+            }
+            else if (uPos >= 5u)
+            {
+                byRx            = s_abyMem[s_tSim.uAddress % SIM_FLASH_SIZE];
+                s_tSim.uAddress = s_tSim.uAddress + 1u;
+            }
+            break;
+        case 0x02u: /* PAGE PROGRAM */
+            if (uPos <= 3u)
+            {
+                sSimAddressByte(byTx);
+            }
+            else
+            {
+                s_tSim.abyLatch[(s_tSim.uAddress + (uPos - 4u)) & 0xFFu] &= byTx;
+            }
+            break;
+        case 0x20u: /* SECTOR ERASE */
+        case 0xD8u: /* BLOCK ERASE */
+            if (uPos <= 3u)
+            {
+                sSimAddressByte(byTx);
+            }
+            break;
+        default:
+            break;
+    }
+
+    return byRx;
+}
+
+/**
+ * @brief Chip select released: execute write enable, program and erase.
+ */
+static void sSimExecute(void)
+{
+    uint8_t byCmd = s_tSim.byCmd;
+
+    if ((byCmd == 0x06u) && !sSimBusy())
+    {
+        s_tSim.bWel = true;
+        return;
+    }
+
+    if ((byCmd != 0x02u) && (byCmd != 0x20u) && (byCmd != 0xD8u))
+    {
+        return;
+    }
+
+    bool bLengthOk = (byCmd == 0x02u) ? (s_tSim.uPos > 4u) : (s_tSim.uPos == 4u);
+
+    if (!s_tSim.bWel || sSimBusy() || !bLengthOk)
+    {
+        s_tSim.uViolations++;
+        return;
+    }
+
+    uint32_t uAddress = s_tSim.uAddress % SIM_FLASH_SIZE;
+    s_tSim.bWel       = false;
+
+    if (byCmd == 0x02u)
+    {
+        uint32_t uPage  = uAddress & ~0xFFu;
+        uint32_t uBytes = (s_tSim.uPos - 4u < 256u) ? (s_tSim.uPos - 4u) : 256u;
+
+        for (uint32_t i = 0u; i < uBytes; i++)
+        {
+            uint32_t uOffset = (uAddress + i) & 0xFFu;
+            s_abyMem[uPage + uOffset] &= s_tSim.abyLatch[uOffset];
+        }
+        s_tSim.uPrograms++;
+        s_tSim.uBusyUntilNs = SpiSimNowNs() + SIM_PAGE_PROG_NS;
+    }
+    else if (byCmd == 0x20u)
+    {
+        memset(&s_abyMem[uAddress & ~0xFFFu], 0xFF, 0x1000u);
+        s_tSim.uSectorErases++;
+        s_tSim.uBusyUntilNs = SpiSimNowNs() + SIM_SECTOR_ERASE_NS;
+    }
+    else
+    {
+        memset(&s_abyMem[uAddress & ~0xFFFFu], 0xFF, 0x10000u);
+        s_tSim.uBlockErases++;
+        s_tSim.uBusyUntilNs = SpiSimNowNs() + SIM_BLOCK_ERASE_NS;
+    }
+}
+
+static void stub_gpio_write_pin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState, int cmock_num_calls)
+{
+    (void)GPIOx;
+    (void)cmock_num_calls;
+
+    if (GPIO_Pin != GPIO_PIN_12)
+    {
+        return;
+    }
+
+    if (PinState == GPIO_PIN_RESET)
+    {
+        s_tSim.bSelected = true;
+        s_tSim.uPos      = 0u;
+    }
+    else if (s_tSim.bSelected)
+    {
+        s_tSim.bSelected = false;
+        if (s_tSim.byCmd == 0x0Bu)
+        {
+            s_tSim.uFastReads++;
+        }
+        sSimExecute();
+    }
+}
+
+/**
+ * @brief Run DMA completions and SysTick until the operation ends.
+ *
+ * @return Simulated duration in milliseconds
+ */
+static uint32_t sSimRun(BspSpiFlashHandle_t handle, uint32_t uLimitMs)
+{
+    return (uint32_t)(SpiSimRun(BspSpiFlashIsBusy, handle, uLimitMs) / SPI_SIM_NS_PER_MS);
+}
+
+/* ============================================================================
+ * Test Fixtures
+ * ========================================================================== */
+
+static BspSpiHandle_t      s_hBus   = -1;
+static BspSpiFlashHandle_t s_hFlash = -1;
+static BspSpiFlashError_e  s_eResult;
+static uint32_t            s_uCallbacks;
+
+static void test_flash_callback(BspSpiFlashHandle_t handle, BspSpiFlashError_e eError, void* pContext)
+{
+    TEST_ASSERT_EQUAL(s_hFlash, handle);
+    TEST_ASSERT_EQUAL_PTR(&s_uCallbacks, pContext);
+    s_eResult = eError;
+    s_uCallbacks++;
+}
+
+static BspSpiFlashHandle_t sAllocateFlash(bool bReadAhead)
+{
+    BspSpiFlashConfig_t tConfig = {.hBus = s_hBus, .uCsPin = eM_FLASH_NCS, .ePrescaler = eBSP_SPI_PRESCALER_4, .bReadAhead = bReadAhead};
+    return BspSpiFlashAllocate(&tConfig);
+}
+
+static void sProbe(void)
+{
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashProbe(s_hFlash, test_flash_callback, &s_uCallbacks));
+    sSimRun(s_hFlash, 10u);
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, s_eResult);
+    s_uCallbacks = 0u;
+}
+
+void setUp(void)
+{
+    for (int8_t i = 0; i < (int8_t)BSP_SPIFLASH_MAX_INSTANCES; i++)
+    {
+        BspSpiFlashFree(i);
+    }
+    for (int8_t i = 0; i < 6; i++)
+    {
+        BspSpiFree(i);
+    }
+
+    memset(s_abyMem, 0xFF, sizeof(s_abyMem));
+    memset(&s_tSim, 0, sizeof(s_tSim));
+    s_tSim.abyId[0] = 0xEFu;
+    s_tSim.abyId[1] = 0x40u;
+    s_tSim.abyId[2] = 0x15u;
+    s_eResult       = eBSP_SPIFLASH_ERR_NONE;
+    s_uCallbacks    = 0u;
+
+    SpiSimConfig_t tSimConfig = {.pByte = sSimByte, .uByteNs = SIM_BYTE_NS, .uXferNs = 0u, .pOnTick = HAL_SYSTICK_Callback};
+    SpiSimReset(&tSimConfig);
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+
+    s_hBus   = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    s_hFlash = sAllocateFlash(false);
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_FALSE(BspSpiFlashIsBusy(s_hFlash));
+    BspSpiFlashFree(s_hFlash);
+    BspSpiFree(s_hBus);
+}
+
+/* ============================================================================
+ * Identification
+ * ========================================================================== */
+
+void test_BspSpiFlashProbe_IdentifiesChip(void)
+{
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashProbe(s_hFlash, test_flash_callback, &s_uCallbacks));
+    sSimRun(s_hFlash, 10u);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, s_eResult);
+
+    BspSpiFlashInfo_t tInfo;
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashGetInfo(s_hFlash, &tInfo));
+    TEST_ASSERT_EQUAL_HEX32(0xEF4015u, tInfo.uJedecId);
+    TEST_ASSERT_EQUAL(SIM_FLASH_SIZE, tInfo.uSize);
+}
+
+void test_BspSpiFlashProbe_NoChip_ReportsUnknownChip(void)
+{
+    // Arrange - MISO floating high
+    uint8_t abyData[4];
+    memset(s_tSim.abyId, 0xFF, sizeof(s_tSim.abyId));
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashProbe(s_hFlash, test_flash_callback, &s_uCallbacks));
+    sSimRun(s_hFlash, 10u);
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_UNKNOWN_CHIP, s_eResult);
+
+    BspSpiFlashInfo_t tInfo;
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_UNKNOWN_CHIP, BspSpiFlashGetInfo(s_hFlash, &tInfo));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_UNKNOWN_CHIP, BspSpiFlashRead(s_hFlash, 0u, abyData, 4u, NULL, NULL));
+}
+
+/* ============================================================================
+ * Program and Erase
+ * ========================================================================== */
+
+void test_BspSpiFlashWrite_SplitsAtPageBoundaries(void)
+{
+    // Arrange - 600 bytes from 0x1F0: 16 + 256 + 256 + 72
+    static uint8_t abyData[600];
+    for (uint32_t i = 0u; i < sizeof(abyData); i++)
+    {
+        abyData[i] = (uint8_t)(i * 7u + 3u);
+    }
+    sProbe();
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashWrite(s_hFlash, 0x1F0u, abyData, sizeof(abyData), test_flash_callback, &s_uCallbacks));
+    sSimRun(s_hFlash, 100u);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(4u, s_tSim.uPrograms);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(abyData, &s_abyMem[0x1F0u], sizeof(abyData));
+    TEST_ASSERT_EQUAL_HEX8(0xFFu, s_abyMem[0x1EFu]);
+    TEST_ASSERT_EQUAL_HEX8(0xFFu, s_abyMem[0x1F0u + sizeof(abyData)]);
+
+    BspSpiFlashStats_t tStats;
+    BspSpiFlashGetStats(s_hFlash, &tStats);
+    TEST_ASSERT_EQUAL(4u, tStats.uPages);
+}
+
+void test_BspSpiFlashWrite_PollsFromTimer_Throughput(void)
+{
+    // Arrange - 64 KiB, 256 pages of 0.4 ms each
+    static uint8_t abyData[65536];
+    char           acMsg[128];
+    for (uint32_t i = 0u; i < sizeof(abyData); i++)
+    {
+        abyData[i] = (uint8_t)(i ^ (i >> 8u));
+    }
+    sProbe();
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashWrite(s_hFlash, 0u, abyData, sizeof(abyData), test_flash_callback, &s_uCallbacks));
+    uint32_t uElapsedMs = sSimRun(s_hFlash, 2000u);
+
+    // Assert - one page per SysTick, a status read or two per page instead of a busy loop
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(abyData, s_abyMem, sizeof(abyData));
+
+    BspSpiFlashStats_t tStats;
+    BspSpiFlashGetStats(s_hFlash, &tStats);
+    TEST_ASSERT_EQUAL(256u, tStats.uPages);
+    TEST_ASSERT_LESS_OR_EQUAL(2u * 256u, tStats.uPolls);
+    TEST_ASSERT_LESS_OR_EQUAL(2u * 256u, uElapsedMs);
+
+    snprintf(acMsg, sizeof(acMsg), "64 KiB programmed in %lu ms (%lu KiB/s), %lu status reads", (unsigned long)uElapsedMs,
+             (unsigned long)((64u * 1000u) / uElapsedMs), (unsigned long)tStats.uPolls);
+    TEST_MESSAGE(acMsg);
+}
+
+void test_BspSpiFlashErase_UsesBlockAndSectorErase(void)
+{
+    // Arrange - 0xF000..0x21000: sector, block, sector
+    memset(&s_abyMem[0xE000u], 0x00, 0x14000u);
+    sProbe();
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashErase(s_hFlash, 0xF000u, 0x12000u, test_flash_callback, &s_uCallbacks));
+    uint32_t uElapsedMs = sSimRun(s_hFlash, 1000u);
+
+    // Assert
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(2u, s_tSim.uSectorErases);
+    TEST_ASSERT_EQUAL(1u, s_tSim.uBlockErases);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+    TEST_ASSERT_GREATER_OR_EQUAL(45u + 150u + 45u, uElapsedMs);
+    uint32_t uErased = 0u;
+    for (uint32_t i = 0xF000u; i < 0x21000u; i++)
+    {
+        uErased += (s_abyMem[i] == 0xFFu) ? 1u : 0u;
+    }
+    TEST_ASSERT_EQUAL(0x12000u, uErased);
+    TEST_ASSERT_EQUAL_HEX8(0x00u, s_abyMem[0xEFFFu]);
+    TEST_ASSERT_EQUAL_HEX8(0x00u, s_abyMem[0x21000u]);
+}
+
+void test_BspSpiFlashErase_StuckBusy_TimesOut(void)
+{
+    // Arrange
+    sProbe();
+    s_tSim.bStuck = true;
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashErase(s_hFlash, 0u, BSP_SPIFLASH_SECTOR_SIZE, test_flash_callback, &s_uCallbacks));
+    uint32_t uElapsedMs = sSimRun(s_hFlash, 2u * BSP_SPIFLASH_ERASE_TIMEOUT_MS);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_TIMEOUT, s_eResult);
+    TEST_ASSERT_GREATER_OR_EQUAL(BSP_SPIFLASH_ERASE_TIMEOUT_MS - 1u, uElapsedMs);
+    TEST_ASSERT_LESS_OR_EQUAL(BSP_SPIFLASH_ERASE_TIMEOUT_MS + 2u, uElapsedMs);
+}
+
+/* ============================================================================
+ * Read
+ * ========================================================================== */
+
+void test_BspSpiFlashRead_FastReadByDma(void)
+{
+    // Arrange
+    uint8_t abyData[1000];
+    for (uint32_t i = 0u; i < 0x1000u; i++)
+    {
+        s_abyMem[0x12000u + i] = (uint8_t)(i * 13u);
+    }
+    sProbe();
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashRead(s_hFlash, 0x12345u, abyData, sizeof(abyData), test_flash_callback, &s_uCallbacks));
+    sSimRun(s_hFlash, 10u);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL(1u, s_tSim.uFastReads);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyMem[0x12345u], abyData, sizeof(abyData));
+}
+
+void test_BspSpiFlashRead_ReadAhead_ServesSequentialReads(void)
+{
+    // Arrange
+    uint8_t abyData[16];
+    for (uint32_t i = 0u; i < 0x1000u; i++)
+    {
+        s_abyMem[0x1000u + i] = (uint8_t)(i + 1u);
+    }
+    BspSpiFlashFree(s_hFlash);
+    s_hFlash = sAllocateFlash(true);
+    sProbe();
+
+    // Act - 16 sequential 16-byte records
+    for (uint32_t i = 0u; i < 16u; i++)
+    {
+        TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE,
+                          BspSpiFlashRead(s_hFlash, 0x1000u + (i * 16u), abyData, sizeof(abyData), test_flash_callback, &s_uCallbacks));
+        sSimRun(s_hFlash, 10u);
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyMem[0x1000u + (i * 16u)], abyData, sizeof(abyData));
+    }
+
+    // Assert - one bus read, the rest from the cache
+    BspSpiFlashStats_t tStats;
+    BspSpiFlashGetStats(s_hFlash, &tStats);
+    TEST_ASSERT_EQUAL(16u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(1u, s_tSim.uFastReads);
+    TEST_ASSERT_EQUAL(15u, tStats.uCacheHits);
+
+    // Programming invalidates the cache
+    static const uint8_t abyZero[1] = {0x00u};
+    BspSpiFlashWrite(s_hFlash, 0x1000u, abyZero, 1u, test_flash_callback, &s_uCallbacks);
+    sSimRun(s_hFlash, 10u);
+    BspSpiFlashRead(s_hFlash, 0x1000u, abyData, 1u, test_flash_callback, &s_uCallbacks);
+    sSimRun(s_hFlash, 10u);
+    TEST_ASSERT_EQUAL(2u, s_tSim.uFastReads);
+    TEST_ASSERT_EQUAL_HEX8(0x00u, abyData[0]);
+
+    // The fill is clamped to the end of the chip
+    BspSpiFlashRead(s_hFlash, SIM_FLASH_SIZE - 4u, abyData, 4u, test_flash_callback, &s_uCallbacks);
+    sSimRun(s_hFlash, 10u);
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&s_abyMem[SIM_FLASH_SIZE - 4u], abyData, 4u);
+}
+
+/* ============================================================================
+ * Parameter Validation
+ * ========================================================================== */
+
+void test_BspSpiFlash_InvalidParameters(void)
+{
+    uint8_t abyData[4] = {0};
+
+    // Allocation
+    TEST_ASSERT_EQUAL(BSP_SPIFLASH_INVALID_HANDLE, BspSpiFlashAllocate(NULL));
+    TEST_ASSERT_EQUAL(BSP_SPIFLASH_INVALID_HANDLE, sAllocateFlash(false));
+
+    // Handles
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_HANDLE, BspSpiFlashFree(-1));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_HANDLE, BspSpiFlashProbe(-1, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_HANDLE, BspSpiFlashRead(-1, 0u, abyData, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_HANDLE, BspSpiFlashWrite(-1, 0u, abyData, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_HANDLE, BspSpiFlashErase(-1, 0u, 4096u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_HANDLE, BspSpiFlashGetStats(-1, NULL));
+    TEST_ASSERT_FALSE(BspSpiFlashIsBusy(-1));
+
+    // Not probed
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_UNKNOWN_CHIP, BspSpiFlashWrite(s_hFlash, 0u, abyData, 1u, NULL, NULL));
+    sProbe();
+
+    // Range, length and alignment
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_PARAM, BspSpiFlashRead(s_hFlash, 0u, NULL, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_PARAM, BspSpiFlashRead(s_hFlash, 0u, abyData, 0u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_PARAM, BspSpiFlashRead(s_hFlash, SIM_FLASH_SIZE - 2u, abyData, 4u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_PARAM, BspSpiFlashWrite(s_hFlash, SIM_FLASH_SIZE, abyData, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_PARAM, BspSpiFlashErase(s_hFlash, 0x800u, 4096u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_PARAM, BspSpiFlashErase(s_hFlash, 0u, 100u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_INVALID_PARAM, BspSpiFlashGetInfo(s_hFlash, NULL));
+
+    // One operation at a time
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, BspSpiFlashErase(s_hFlash, 0u, 4096u, test_flash_callback, &s_uCallbacks));
+    TEST_ASSERT_TRUE(BspSpiFlashIsBusy(s_hFlash));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_BUSY, BspSpiFlashRead(s_hFlash, 0u, abyData, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_BUSY, BspSpiFlashProbe(s_hFlash, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_BUSY, BspSpiFlashFree(s_hFlash));
+    sSimRun(s_hFlash, 100u);
+    TEST_ASSERT_EQUAL(eBSP_SPIFLASH_ERR_NONE, s_eResult);
+}
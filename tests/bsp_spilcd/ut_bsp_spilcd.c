@@ -0,0 +1,674 @@
+/**
+ * @file ut_bsp_spilcd.c
+ * @brief Unit tests for BSP SPI display module
+ *
+ * The driver runs on a real bsp_spi bus against a MIPI DCS controller model
+ * behind the mocked HAL: DMA transfers feed the model byte by byte with the
+ * D/C level of the moment, CASET/RASET set the window and RAMWR writes pixels
+ * into the model's panel memory row by row inside the window. DMA completions
+ * are delivered one at a time until the display is idle.
+ */
+
+#include "Mockstm32f4xx_hal_gpio.h"
+#include "Mockstm32f4xx_hal_spi.h"
+#include "bsp_spi.h"
+#include "bsp_spilcd.h"
+#include "gpio_struct.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================================================
+ * Test Stubs and Mocks
+ * ========================================================================== */
+
+extern void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi);
+
+/* Mock SPI peripherals and HAL handles - required by production code */
+static SPI_TypeDef mock_SPI1;
+static SPI_TypeDef mock_SPI2;
+static SPI_TypeDef mock_SPI3;
+static SPI_TypeDef mock_SPI4;
+static SPI_TypeDef mock_SPI5;
+static SPI_TypeDef mock_SPI6;
+
+SPI_HandleTypeDef hspi1 = {.Instance = &mock_SPI1};
+SPI_HandleTypeDef hspi2 = {.Instance = &mock_SPI2};
+SPI_HandleTypeDef hspi3 = {.Instance = &mock_SPI3};
+SPI_HandleTypeDef hspi4 = {.Instance = &mock_SPI4};
+SPI_HandleTypeDef hspi5 = {.Instance = &mock_SPI5};
+SPI_HandleTypeDef hspi6 = {.Instance = &mock_SPI6};
+
+/* Display chip select and D/C on the bsp_gpio pin table */
+static GPIO_TypeDef mock_GPIOB;
+
+const gpio_t gpio_pins[eGPIO_COUNT] = {
+    [eM_FLASH_NCS] = {&mock_GPIOB, GPIO_PIN_12},
+    [eM_WP]        = {&mock_GPIOB, GPIO_PIN_13},
+};
+
+/* ============================================================================
+ * Display Controller Model
+ * ========================================================================== */
+
+#define SIM_WIDTH  (320u)
+#define SIM_HEIGHT (240u)
+/** SCK 42 MHz (fPCLK2 84 MHz / 2) and interrupt plus DMA restart per transfer */
+#define SIM_SCK_HZ         (42000000uLL)
+#define SIM_XFER_OVERHEAD_NS (2000uLL)
+
+/**
+ * @brief Controller state.
+ */
+typedef struct
+{
+    bool     bSelected;
+    bool     bData;          /**< D/C level */
+    uint8_t  byCmd;          /**< Last command */
+    uint32_t uParam;         /**< Parameter bytes since the command */
+    uint8_t  abyParams[8];   /**< First parameters of the last command */
+    uint16_t uXs, uXe, uYs, uYe;
+    uint16_t uX, uY;         /**< Memory write position */
+    uint8_t  byPixelLow;     /**< First byte of a pixel */
+    uint32_t uCommands;
+    uint32_t uWindows;       /**< CASET commands */
+    uint32_t uPixelBytes;
+    uint32_t uTotalBytes;
+    uint32_t uSelects;       /**< Chip-select cycles (one per transfer) */
+    uint32_t uDmaStarts;
+    uint32_t uViolations;    /**< Bytes outside chip select, pixels outside the window */
+} SimLcd_t;
+
+static uint16_t s_auPanel[SIM_WIDTH * SIM_HEIGHT];
+static uint16_t s_auFrameA[SIM_WIDTH * SIM_HEIGHT];
+static uint16_t s_auFrameB[SIM_WIDTH * SIM_HEIGHT];
+static SimLcd_t s_tSim;
+static bool     s_bDmaPending;
+static uint32_t s_uFailDmaAt; /**< DMA start number that fails, 0 = none */
+
+static void sSimByte(uint8_t byTx)
+{
+    s_tSim.uTotalBytes++;
+
+    if (!s_tSim.bSelected)
+    {
+        s_tSim.uViolations++;
+        return;
+    }
+
+    if (!s_tSim.bData)
+    {
+        s_tSim.byCmd  = byTx;
+        s_tSim.uParam = 0u;
+        s_tSim.uCommands++;
+        if (byTx == 0x2Au)
+        {
+            s_tSim.uWindows++;
+        }
+        if (byTx == 0x2Cu)
+        {
+            s_tSim.uX = s_tSim.uXs;
+            s_tSim.uY = s_tSim.uYs;
+        }
+        return;
+    }
+
+    uint32_t uParam = s_tSim.uParam++;
+
+    if (uParam < sizeof(s_tSim.abyParams))
+    {
+        s_tSim.abyParams[uParam] = byTx;
+    }
+
+    if ((s_tSim.byCmd == 0x2Au) || (s_tSim.byCmd == 0x2Bu))
+    {
+        if (uParam == 3u)
+        {
+            uint16_t uStart = (uint16_t)((s_tSim.abyParams[0] << 8u) | s_tSim.abyParams[1]);
+            uint16_t uEnd   = (uint16_t)((s_tSim.abyParams[2] << 8u) | s_tSim.abyParams[3]);
+
+            if (s_tSim.byCmd == 0x2Au)
+            {
+                s_tSim.uXs = uStart;
+                s_tSim.uXe = uEnd;
+            }
+            else
+            {
+                s_tSim.uYs = uStart;
+                s_tSim.uYe = uEnd;
+            }
+        }
+        return;
+    }
+
+    if (s_tSim.byCmd != 0x2Cu)
+    {
+        return;
+    }
+
+    s_tSim.uPixelBytes++;
+
+    if ((uParam & 1u) == 0u)
+    {
+        s_tSim.byPixelLow = byTx;
+        return;
+    }
+
+    if ((s_tSim.uX >= SIM_WIDTH) || (s_tSim.uY > s_tSim.uYe) || (s_tSim.uY >= SIM_HEIGHT))
+    {
+        s_tSim.uViolations++;
+        return;
+    }
+
+    /* Stored like the framebuffer: first byte on the bus at the lower address */
+    s_auPanel[(s_tSim.uY * SIM_WIDTH) + s_tSim.uX] = (uint16_t)(s_tSim.byPixelLow | ((uint16_t)byTx << 8u));
+
+    if (s_tSim.uX == s_tSim.uXe)
+    {
+        s_tSim.uX = s_tSim.uXs;
+        s_tSim.uY++;
+    }
+    else
+    {
+        s_tSim.uX++;
+    }
+}
+
+static void stub_gpio_write_pin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState, int cmock_num_calls)
+{
+    (void)GPIOx;
+    (void)cmock_num_calls;
+
+    if (GPIO_Pin == GPIO_PIN_13)
+    {
+        s_tSim.bData = (PinState == GPIO_PIN_SET);
+    }
+    else if (GPIO_Pin == GPIO_PIN_12)
+    {
+        if ((PinState == GPIO_PIN_RESET) && !s_tSim.bSelected)
+        {
+            s_tSim.uSelects++;
+        }
+        s_tSim.bSelected = (PinState == GPIO_PIN_RESET);
+    }
+}
+
+static HAL_StatusTypeDef stub_transmit_dma(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, int cmock_num_calls)
+{
+    (void)hspi;
+    (void)cmock_num_calls;
+
+    TEST_ASSERT_FALSE(s_bDmaPending);
+    s_tSim.uDmaStarts++;
+
+    if (s_tSim.uDmaStarts == s_uFailDmaAt)
+    {
+        return HAL_ERROR;
+    }
+
+    for (uint16_t i = 0u; i < Size; i++)
+    {
+        sSimByte(pData[i]);
+    }
+
+    s_bDmaPending = true;
+    return HAL_OK;
+}
+
+/**
+ * @brief Deliver DMA completions until the display is idle.
+ */
+static void sSimRun(BspSpiLcdHandle_t handle)
+{
+    uint32_t uGuard = 0u;
+
+    while (s_bDmaPending && (uGuard++ < 100000u))
+    {
+        s_bDmaPending = false;
+        HAL_SPI_TxCpltCallback(&hspi1);
+    }
+
+    TEST_ASSERT_FALSE(BspSpiLcdIsBusy(handle));
+}
+
+/**
+ * @brief Estimated bus time of everything sent since the last reset of the model.
+ */
+static uint32_t sSimBusTimeUs(void)
+{
+    uint64_t uNs = (((uint64_t)s_tSim.uTotalBytes * 8u * 1000000000uLL) / SIM_SCK_HZ) + ((uint64_t)s_tSim.uDmaStarts * SIM_XFER_OVERHEAD_NS);
+    return (uint32_t)(uNs / 1000u);
+}
+
+static void sSimResetCounters(void)
+{
+    s_tSim.uCommands   = 0u;
+    s_tSim.uWindows    = 0u;
+    s_tSim.uPixelBytes = 0u;
+    s_tSim.uTotalBytes = 0u;
+    s_tSim.uSelects    = 0u;
+    s_tSim.uDmaStarts  = 0u;
+}
+
+/* ============================================================================
+ * Test Fixtures
+ * ========================================================================== */
+
+static BspSpiHandle_t    s_hBus = -1;
+static BspSpiLcdHandle_t s_hLcd = -1;
+static BspSpiLcdError_e  s_eResult;
+static uint32_t          s_uCallbacks;
+
+static void test_lcd_callback(BspSpiLcdHandle_t handle, BspSpiLcdError_e eError, void* pContext)
+{
+    TEST_ASSERT_EQUAL(s_hLcd, handle);
+    TEST_ASSERT_EQUAL_PTR(&s_uCallbacks, pContext);
+    s_eResult = eError;
+    s_uCallbacks++;
+}
+
+static BspSpiLcdConfig_t sConfig(bool bDouble)
+{
+    BspSpiLcdConfig_t tConfig = {.hBus       = s_hBus,
+                                 .uCsPin     = eM_FLASH_NCS,
+                                 .uDcPin     = eM_WP,
+                                 .eClockMode = eBSP_SPI_CLOCK_MODE_0,
+                                 .ePrescaler = eBSP_SPI_PRESCALER_2,
+                                 .uWidth     = SIM_WIDTH,
+                                 .uHeight    = SIM_HEIGHT,
+                                 .apFrame    = {s_auFrameA, bDouble ? s_auFrameB : NULL}};
+    return tConfig;
+}
+
+static void sAllocate(bool bDouble)
+{
+    BspSpiLcdConfig_t tConfig = sConfig(bDouble);
+    s_hLcd                    = BspSpiLcdAllocate(&tConfig);
+    TEST_ASSERT_NOT_EQUAL(BSP_SPILCD_INVALID_HANDLE, s_hLcd);
+}
+
+/**
+ * @brief Fill a rectangle of the draw buffer and mark it dirty.
+ */
+static void sDraw(uint16_t uX, uint16_t uY, uint16_t uWidth, uint16_t uHeight, uint16_t uColour)
+{
+    uint16_t*       pFrame = BspSpiLcdGetDrawBuffer(s_hLcd);
+    BspSpiLcdRect_t tRect  = {uX, uY, uWidth, uHeight};
+
+    for (uint32_t y = uY; y < (uint32_t)(uY + uHeight); y++)
+    {
+        for (uint32_t x = uX; x < (uint32_t)(uX + uWidth); x++)
+        {
+            pFrame[(y * SIM_WIDTH) + x] = uColour;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdInvalidate(s_hLcd, &tRect));
+}
+
+static void sPresent(void)
+{
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdPresent(s_hLcd, test_lcd_callback, &s_uCallbacks));
+    sSimRun(s_hLcd);
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, s_eResult);
+}
+
+void setUp(void)
+{
+    BspSpiLcdFree(s_hLcd);
+    for (int8_t i = 0; i < 6; i++)
+    {
+        BspSpiFree(i);
+    }
+
+    memset(s_auPanel, 0, sizeof(s_auPanel));
+    memset(s_auFrameA, 0, sizeof(s_auFrameA));
+    memset(s_auFrameB, 0, sizeof(s_auFrameB));
+    memset(&s_tSim, 0, sizeof(s_tSim));
+    s_bDmaPending = false;
+    s_uFailDmaAt  = 0u;
+    s_eResult     = eBSP_SPILCD_ERR_NONE;
+    s_uCallbacks  = 0u;
+    hspi1.State   = HAL_SPI_STATE_READY;
+
+    HAL_GPIO_WritePin_StubWithCallback(stub_gpio_write_pin);
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+
+    s_hBus = BspSpiAllocate(eBSP_SPI_INSTANCE_1, eBSP_SPI_MODE_DMA, 0);
+    s_hLcd = BSP_SPILCD_INVALID_HANDLE;
+}
+
+void tearDown(void)
+{
+    TEST_ASSERT_FALSE(BspSpiLcdIsBusy(s_hLcd));
+    TEST_ASSERT_EQUAL(0u, s_tSim.uViolations);
+    BspSpiLcdFree(s_hLcd);
+    BspSpiFree(s_hBus);
+}
+
+/* ============================================================================
+ * Allocation and Commands
+ * ========================================================================== */
+
+void test_BspSpiLcdAllocate_InvalidConfig_Fails(void)
+{
+    // Arrange
+    BspSpiLcdConfig_t tConfig = sConfig(true);
+    BspSpiLcdRect_t   tRect   = {0u, 0u, 1u, 1u};
+    BspSpiLcdStats_t  tStats;
+
+    // Act & Assert
+    TEST_ASSERT_EQUAL(BSP_SPILCD_INVALID_HANDLE, BspSpiLcdAllocate(NULL));
+    tConfig.apFrame[0] = NULL;
+    TEST_ASSERT_EQUAL(BSP_SPILCD_INVALID_HANDLE, BspSpiLcdAllocate(&tConfig));
+    tConfig.apFrame[0] = s_auFrameB;
+    TEST_ASSERT_EQUAL(BSP_SPILCD_INVALID_HANDLE, BspSpiLcdAllocate(&tConfig));
+    tConfig            = sConfig(true);
+    tConfig.uWidth     = 0u;
+    TEST_ASSERT_EQUAL(BSP_SPILCD_INVALID_HANDLE, BspSpiLcdAllocate(&tConfig));
+    tConfig            = sConfig(true);
+    tConfig.hBus       = -1;
+    TEST_ASSERT_EQUAL(BSP_SPILCD_INVALID_HANDLE, BspSpiLcdAllocate(&tConfig));
+
+    sAllocate(true);
+    tConfig = sConfig(true);
+    TEST_ASSERT_EQUAL(BSP_SPILCD_INVALID_HANDLE, BspSpiLcdAllocate(&tConfig));
+
+    // Invalid handles
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_HANDLE, BspSpiLcdFree(-1));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_HANDLE, BspSpiLcdCommand(-1, 0x29u, NULL, 0u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_HANDLE, BspSpiLcdInvalidate(-1, &tRect));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_HANDLE, BspSpiLcdPresent((BspSpiLcdHandle_t)BSP_SPILCD_MAX_INSTANCES, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_HANDLE, BspSpiLcdGetStats(-1, &tStats));
+    TEST_ASSERT_NULL(BspSpiLcdGetDrawBuffer(-1));
+    TEST_ASSERT_FALSE(BspSpiLcdIsBusy(-1));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_PARAM, BspSpiLcdGetStats(s_hLcd, NULL));
+
+    // D/C rests high, chip select released
+    TEST_ASSERT_TRUE(s_tSim.bData);
+    TEST_ASSERT_FALSE(s_tSim.bSelected);
+}
+
+void test_BspSpiLcdCommand_SendsCommandWithDcLowAndParametersWithDcHigh(void)
+{
+    // Arrange - COLMOD 16 bit/pixel, then MADCTL landscape
+    static const uint8_t byColmod  = 0x55u;
+    static const uint8_t abyMadctl = 0x28u;
+    sAllocate(false);
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdCommand(s_hLcd, 0x3Au, &byColmod, 1u, test_lcd_callback, &s_uCallbacks));
+    TEST_ASSERT_TRUE(BspSpiLcdIsBusy(s_hLcd));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_BUSY, BspSpiLcdCommand(s_hLcd, 0x36u, &abyMadctl, 1u, NULL, NULL));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_BUSY, BspSpiLcdFree(s_hLcd));
+    sSimRun(s_hLcd);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, s_eResult);
+    TEST_ASSERT_EQUAL_HEX8(0x3Au, s_tSim.byCmd);
+    TEST_ASSERT_EQUAL(1u, s_tSim.uParam);
+    TEST_ASSERT_EQUAL_HEX8(0x55u, s_tSim.abyParams[0]);
+    TEST_ASSERT_EQUAL(2u, s_tSim.uSelects);
+
+    // Command without parameters (display on)
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdCommand(s_hLcd, 0x29u, NULL, 0u, test_lcd_callback, &s_uCallbacks));
+    sSimRun(s_hLcd);
+    TEST_ASSERT_EQUAL(2u, s_uCallbacks);
+    TEST_ASSERT_EQUAL_HEX8(0x29u, s_tSim.byCmd);
+    TEST_ASSERT_EQUAL(0u, s_tSim.uParam);
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_PARAM, BspSpiLcdCommand(s_hLcd, 0x36u, NULL, 1u, NULL, NULL));
+
+    BspSpiLcdStats_t tStats;
+    BspSpiLcdGetStats(s_hLcd, &tStats);
+    TEST_ASSERT_EQUAL(3u, tStats.uCommandBytes);
+    TEST_ASSERT_EQUAL(0u, tStats.uFrames);
+}
+
+/* ============================================================================
+ * Dirty Rectangles
+ * ========================================================================== */
+
+void test_BspSpiLcdInvalidate_MergesOverlappingAndNearbyRects(void)
+{
+    // Arrange
+    BspSpiLcdStats_t tStats;
+    sAllocate(false);
+
+    // Act - contained, touching and overlapping rectangles become one window
+    sDraw(10u, 10u, 50u, 20u, 0x1111u);
+    sDraw(20u, 15u, 5u, 5u, 0x2222u);
+    sDraw(60u, 10u, 10u, 20u, 0x3333u);
+    sDraw(65u, 12u, 10u, 18u, 0x4444u);
+    sPresent();
+
+    // Assert - bounding box 65 x 20, 10 pixels more than the rectangles
+    TEST_ASSERT_EQUAL(1u, s_tSim.uWindows);
+    TEST_ASSERT_EQUAL(65u * 20u * 2u, s_tSim.uPixelBytes);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(s_auFrameA, s_auPanel, SIM_WIDTH * SIM_HEIGHT);
+
+    // Distant rectangles stay separate
+    sSimResetCounters();
+    sDraw(0u, 0u, 4u, 4u, 0x5555u);
+    sDraw(300u, 200u, 4u, 4u, 0x6666u);
+    sPresent();
+    TEST_ASSERT_EQUAL(2u, s_tSim.uWindows);
+    TEST_ASSERT_EQUAL(2u * 16u * 2u, s_tSim.uPixelBytes);
+
+    // A full list merges the cheapest pair
+    sSimResetCounters();
+    for (uint16_t i = 0u; i <= BSP_SPILCD_MAX_RECTS; i++)
+    {
+        sDraw((uint16_t)(i * 30u), (uint16_t)(i * 20u), 2u, 2u, 0x7777u);
+    }
+    sPresent();
+    TEST_ASSERT_EQUAL(BSP_SPILCD_MAX_RECTS, s_tSim.uWindows);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(s_auFrameA, s_auPanel, SIM_WIDTH * SIM_HEIGHT);
+
+    BspSpiLcdGetStats(s_hLcd, &tStats);
+    TEST_ASSERT_EQUAL(3u, tStats.uFrames);
+    TEST_ASSERT_EQUAL(1u + 2u + BSP_SPILCD_MAX_RECTS, tStats.uWindows);
+}
+
+void test_BspSpiLcdInvalidate_ClipsToDisplay(void)
+{
+    // Arrange
+    BspSpiLcdRect_t tRect = {300u, 230u, 100u, 100u};
+    sAllocate(false);
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdInvalidate(s_hLcd, &tRect));
+    sPresent();
+
+    // Assert
+    TEST_ASSERT_EQUAL(20u * 10u * 2u, s_tSim.uPixelBytes);
+    TEST_ASSERT_EQUAL(319u, s_tSim.uXe);
+    TEST_ASSERT_EQUAL(239u, s_tSim.uYe);
+
+    tRect = (BspSpiLcdRect_t){320u, 0u, 1u, 1u};
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_PARAM, BspSpiLcdInvalidate(s_hLcd, &tRect));
+    tRect = (BspSpiLcdRect_t){0u, 240u, 1u, 1u};
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_PARAM, BspSpiLcdInvalidate(s_hLcd, &tRect));
+    tRect = (BspSpiLcdRect_t){0u, 0u, 0u, 1u};
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_PARAM, BspSpiLcdInvalidate(s_hLcd, &tRect));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_INVALID_PARAM, BspSpiLcdInvalidate(s_hLcd, NULL));
+}
+
+/* ============================================================================
+ * Frames
+ * ========================================================================== */
+
+void test_BspSpiLcdPresent_NarrowWindow_SendsRowBursts(void)
+{
+    // Arrange - 50 x 40 window, rows of 100 bytes
+    sAllocate(false);
+    for (uint32_t i = 0u; i < (SIM_WIDTH * SIM_HEIGHT); i++)
+    {
+        s_auFrameA[i] = (uint16_t)(i * 2654435761u);
+    }
+    BspSpiLcdRect_t tRect = {100u, 50u, 50u, 40u};
+    BspSpiLcdInvalidate(s_hLcd, &tRect);
+
+    // Act
+    sPresent();
+
+    // Assert - 5 command transfers and ceil(40 / BSP_SPILCD_ROWS_PER_BURST) bursts, one DMA per row
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(5u + ((40u + BSP_SPILCD_ROWS_PER_BURST - 1u) / BSP_SPILCD_ROWS_PER_BURST), s_tSim.uSelects);
+    TEST_ASSERT_EQUAL(5u + 40u, s_tSim.uDmaStarts);
+    TEST_ASSERT_EQUAL(50u * 40u * 2u, s_tSim.uPixelBytes);
+
+    for (uint32_t y = 0u; y < SIM_HEIGHT; y++)
+    {
+        if ((y >= 50u) && (y < 90u))
+        {
+            TEST_ASSERT_EQUAL_HEX16_ARRAY(&s_auFrameA[(y * SIM_WIDTH) + 100u], &s_auPanel[(y * SIM_WIDTH) + 100u], 50u);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_HEX16(0u, s_auPanel[(y * SIM_WIDTH) + 100u]);
+        }
+        TEST_ASSERT_EQUAL_HEX16(0u, s_auPanel[(y * SIM_WIDTH) + 99u]);
+        TEST_ASSERT_EQUAL_HEX16(0u, s_auPanel[(y * SIM_WIDTH) + 150u]);
+    }
+}
+
+void test_BspSpiLcdPresent_DoubleBuffer_SwapsAndKeepsBuffersInStep(void)
+{
+    // Arrange
+    BspSpiLcdStats_t tStats;
+    sAllocate(true);
+    TEST_ASSERT_EQUAL_PTR(s_auFrameA, BspSpiLcdGetDrawBuffer(s_hLcd));
+    sDraw(0u, 0u, SIM_WIDTH, SIM_HEIGHT, BSP_SPILCD_RGB565(0u, 0u, 255u));
+
+    // Act - frame 1 on the bus, the next frame is drawn meanwhile
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdPresent(s_hLcd, test_lcd_callback, &s_uCallbacks));
+
+    // Assert - the draw buffer switched and already holds frame 1
+    TEST_ASSERT_EQUAL_PTR(s_auFrameB, BspSpiLcdGetDrawBuffer(s_hLcd));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(s_auFrameA, s_auFrameB, SIM_WIDTH * SIM_HEIGHT);
+    sDraw(10u, 10u, 30u, 30u, BSP_SPILCD_RGB565(255u, 0u, 0u));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_BUSY, BspSpiLcdPresent(s_hLcd, test_lcd_callback, &s_uCallbacks));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_BUSY, BspSpiLcdFree(s_hLcd));
+    TEST_ASSERT_EQUAL_HEX16(0x1F00u, s_auFrameA[(20u * SIM_WIDTH) + 20u]);
+    sSimRun(s_hLcd);
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(s_auFrameA, s_auPanel, SIM_WIDTH * SIM_HEIGHT);
+
+    // Frame 2 from buffer B, buffer A catches up
+    sSimResetCounters();
+    sPresent();
+    TEST_ASSERT_EQUAL(2u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(30u * 30u * 2u, s_tSim.uPixelBytes);
+    TEST_ASSERT_EQUAL_PTR(s_auFrameA, BspSpiLcdGetDrawBuffer(s_hLcd));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(s_auFrameB, s_auPanel, SIM_WIDTH * SIM_HEIGHT);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(s_auFrameB, s_auFrameA, SIM_WIDTH * SIM_HEIGHT);
+    TEST_ASSERT_EQUAL_HEX16(0x00F8u, s_auPanel[(20u * SIM_WIDTH) + 20u]);
+
+    BspSpiLcdGetStats(s_hLcd, &tStats);
+    TEST_ASSERT_EQUAL(2u, tStats.uFrames);
+    TEST_ASSERT_EQUAL((SIM_WIDTH * SIM_HEIGHT * 2u) + (30u * 30u * 2u), tStats.uPixelBytes);
+    TEST_ASSERT_EQUAL(tStats.uPixelBytes, tStats.uCopiedBytes);
+    TEST_ASSERT_EQUAL(2u * 11u, tStats.uCommandBytes);
+}
+
+void test_BspSpiLcdPresent_NothingDirty_CompletesImmediately(void)
+{
+    // Arrange
+    sAllocate(true);
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdPresent(s_hLcd, test_lcd_callback, &s_uCallbacks));
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_FALSE(BspSpiLcdIsBusy(s_hLcd));
+    TEST_ASSERT_EQUAL(0u, s_tSim.uTotalBytes);
+    TEST_ASSERT_EQUAL_PTR(s_auFrameA, BspSpiLcdGetDrawBuffer(s_hLcd));
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdPresent(s_hLcd, NULL, NULL));
+}
+
+void test_BspSpiLcdPresent_TransferError_EndsFrameWithSpiError(void)
+{
+    // Arrange - the pixel burst fails to start
+    sAllocate(false);
+    sDraw(0u, 0u, 8u, 8u, 0xFFFFu);
+    s_uFailDmaAt = 6u;
+
+    // Act
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_NONE, BspSpiLcdPresent(s_hLcd, test_lcd_callback, &s_uCallbacks));
+    sSimRun(s_hLcd);
+
+    // Assert
+    TEST_ASSERT_EQUAL(1u, s_uCallbacks);
+    TEST_ASSERT_EQUAL(eBSP_SPILCD_ERR_SPI, s_eResult);
+
+    BspSpiLcdStats_t tStats;
+    BspSpiLcdGetStats(s_hLcd, &tStats);
+    TEST_ASSERT_EQUAL(0u, tStats.uFrames);
+
+    // The next frame goes through
+    s_uFailDmaAt = 0u;
+    sDraw(0u, 0u, 8u, 8u, 0xFFFFu);
+    sPresent();
+    TEST_ASSERT_EQUAL_HEX16(0xFFFFu, s_auPanel[7u * SIM_WIDTH + 7u]);
+}
+
+/* ============================================================================
+ * Typical UI Updates
+ * ========================================================================== */
+
+static void sReportPattern(const char* pName, uint32_t uExpectedPixelBytes, uint32_t uExpectedWindows)
+{
+    char     acMsg[160];
+    uint32_t uFullUs = (uint32_t)((((uint64_t)SIM_WIDTH * SIM_HEIGHT * 2u * 8u) * 1000000uLL) / SIM_SCK_HZ);
+    uint32_t uBusUs  = sSimBusTimeUs();
+
+    TEST_ASSERT_EQUAL(uExpectedPixelBytes, s_tSim.uPixelBytes);
+    TEST_ASSERT_EQUAL(uExpectedWindows, s_tSim.uWindows);
+    TEST_ASSERT_EQUAL(11u * uExpectedWindows, s_tSim.uTotalBytes - s_tSim.uPixelBytes);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(BspSpiLcdGetDrawBuffer(s_hLcd), s_auPanel, SIM_WIDTH * SIM_HEIGHT);
+
+    snprintf(acMsg, sizeof(acMsg), "%s: %lu bytes in %lu window(s), %lu.%lu%% of a full frame, ~%lu us on the bus (full frame %lu us)", pName,
+             (unsigned long)s_tSim.uTotalBytes, (unsigned long)s_tSim.uWindows,
+             (unsigned long)((s_tSim.uTotalBytes * 100u) / (SIM_WIDTH * SIM_HEIGHT * 2u)),
+             (unsigned long)(((s_tSim.uTotalBytes * 1000u) / (SIM_WIDTH * SIM_HEIGHT * 2u)) % 10u), (unsigned long)uBusUs,
+             (unsigned long)uFullUs);
+    TEST_MESSAGE(acMsg);
+    sSimResetCounters();
+}
+
+void test_BspSpiLcdPresent_UiUpdatePatterns_ByteCounts(void)
+{
+    // Arrange - 320 x 240 dashboard, double buffered
+    sAllocate(true);
+    sDraw(0u, 0u, SIM_WIDTH, SIM_HEIGHT, BSP_SPILCD_RGB565(16u, 16u, 16u));
+    sPresent();
+    sReportPattern("Full screen", SIM_WIDTH * SIM_HEIGHT * 2u, 1u);
+
+    // Clock in the status bar: five 8 x 16 glyphs side by side
+    for (uint16_t i = 0u; i < 5u; i++)
+    {
+        sDraw((uint16_t)(260u + (i * 8u)), 4u, 8u, 16u, (uint16_t)(0x0100u * (i + 1u)));
+    }
+    sPresent();
+    sReportPattern("Clock text", 40u * 16u * 2u, 1u);
+
+    // Cursor blink, progress bar step and clock seconds in one frame
+    sDraw(100u, 120u, 2u, 16u, 0xFFFFu);
+    sDraw(160u, 200u, 2u, 10u, BSP_SPILCD_RGB565(0u, 255u, 0u));
+    sDraw(292u, 4u, 8u, 16u, 0x0700u);
+    sPresent();
+    sReportPattern("Cursor + progress + seconds", (32u + 20u + 128u) * 2u, 3u);
+
+    // Pressed button and its shadow
+    sDraw(22u, 62u, 100u, 40u, 0x0841u);
+    sDraw(20u, 60u, 100u, 40u, BSP_SPILCD_RGB565(200u, 200u, 200u));
+    sPresent();
+    sReportPattern("Button press", 102u * 42u * 2u, 1u);
+
+    // List scroll: the content area below the status bar
+    sDraw(0u, 30u, SIM_WIDTH, 180u, BSP_SPILCD_RGB565(255u, 255u, 255u));
+    sPresent();
+    sReportPattern("List scroll", SIM_WIDTH * 180u * 2u, 1u);
+}
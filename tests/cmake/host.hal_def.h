@@ -63,8 +63,12 @@ typedef enum
     EXTI2_IRQn     = 8,
     EXTI3_IRQn     = 9,
     EXTI4_IRQn     = 10,
+    CAN1_RX0_IRQn  = 20,
+    CAN1_RX1_IRQn  = 21,
     EXTI9_5_IRQn   = 23,
-    EXTI15_10_IRQn = 40
+    EXTI15_10_IRQn = 40,
+    CAN2_RX0_IRQn  = 64,
+    CAN2_RX1_IRQn  = 65
 } IRQn_Type;
 
 /* MPU region initialization structure */
@@ -94,7 +98,8 @@ typedef struct
 /* DMA Stream structure stub */
 typedef struct
 {
-    volatile uint32_t dummy; /* Placeholder for host testing */
+    volatile uint32_t CR;   /* Configuration register */
+    volatile uint32_t NDTR; /* Number of data items left to transfer */
 } DMA_Stream_TypeDef;
 
 /* SPI peripheral structure stub */
@@ -242,10 +247,51 @@ typedef struct
 #endif
 
 /* CAN register bit definitions */
-#define CAN_ESR_BOFF ((uint32_t)0x00000004) /* Bus-off flag */
-#define CAN_ESR_EPVF ((uint32_t)0x00000002) /* Error passive flag */
-#define CAN_ESR_TEC  ((uint32_t)0x00FF0000) /* Transmit error counter */
-#define CAN_ESR_REC  ((uint32_t)0xFF000000) /* Receive error counter */
+#define CAN_ESR_BOFF     ((uint32_t)0x00000004) /* Bus-off flag */
+#define CAN_ESR_EPVF     ((uint32_t)0x00000002) /* Error passive flag */
+#define CAN_ESR_TEC      ((uint32_t)0x00FF0000) /* Transmit error counter */
+#define CAN_ESR_REC      ((uint32_t)0xFF000000) /* Receive error counter */
+#define CAN_ESR_LEC      ((uint32_t)0x00000070) /* Last error code */
+#define CAN_ESR_LEC_Pos  (4U)
+#define CAN_RF0R_FMP0    ((uint32_t)0x00000003) /* FIFO 0 message pending */
+#define CAN_RF0R_RFOM0   ((uint32_t)0x00000020) /* Release FIFO 0 output mailbox */
+#define CAN_RF1R_FMP1    ((uint32_t)0x00000003) /* FIFO 1 message pending */
+#define CAN_RF1R_RFOM1   ((uint32_t)0x00000020) /* Release FIFO 1 output mailbox */
+#define CAN_BTR_BRP      ((uint32_t)0x000003FF) /* Baud rate prescaler */
+#define CAN_BTR_TS1      ((uint32_t)0x000F0000) /* Time segment 1 */
+#define CAN_BTR_TS1_Pos  (16U)
+#define CAN_BTR_TS2      ((uint32_t)0x00700000) /* Time segment 2 */
+#define CAN_BTR_TS2_Pos  (20U)
+#define CAN_BTR_SJW      ((uint32_t)0x03000000) /* Resynchronization jump width */
+#define CAN_BTR_SJW_Pos  (24U)
+#define CAN_BTR_LBKM     ((uint32_t)0x40000000) /* Loop back mode */
+#define CAN_BTR_SILM     ((uint32_t)0x80000000) /* Silent mode */
+#define CAN_MCR_TXFP     ((uint32_t)0x00000004) /* Transmit FIFO priority */
+#define CAN_TSR_CODE     ((uint32_t)0x03000000) /* Next free mailbox code */
+#define CAN_TSR_CODE_Pos (24U)
+#define CAN_TSR_TME0     ((uint32_t)0x04000000) /* Transmit mailbox 0 empty */
+#define CAN_TSR_TME1     ((uint32_t)0x08000000) /* Transmit mailbox 1 empty */
+#define CAN_TSR_TME2     ((uint32_t)0x10000000) /* Transmit mailbox 2 empty */
+
+/* SPI register bit definitions */
+#define SPI_CR1_CPHA   ((uint32_t)0x00000001) /* Clock phase */
+#define SPI_CR1_CPOL   ((uint32_t)0x00000002) /* Clock polarity */
+#define SPI_CR1_BR     ((uint32_t)0x00000038) /* Baud rate control */
+#define SPI_CR1_BR_Pos (3U)
+#define SPI_CR1_SPE    ((uint32_t)0x00000040) /* SPI enable */
+#define SPI_CR1_DFF    ((uint32_t)0x00000800) /* Data frame format (16-bit) */
+#define SPI_CR1_CRCEN  ((uint32_t)0x00002000) /* Hardware CRC enable */
+#define SPI_SR_RXNE    ((uint32_t)0x00000001) /* Receive buffer not empty */
+#define SPI_SR_TXE     ((uint32_t)0x00000002) /* Transmit buffer empty */
+#define SPI_SR_BSY     ((uint32_t)0x00000080) /* Busy flag */
+
+/* DMA stream register bit definitions */
+#define DMA_SxCR_CIRC    ((uint32_t)0x00000100) /* Circular mode */
+#define DMA_SxCR_MINC    ((uint32_t)0x00000400) /* Memory increment */
+#define DMA_SxCR_PSIZE   ((uint32_t)0x00001800) /* Peripheral data size */
+#define DMA_SxCR_PSIZE_0 ((uint32_t)0x00000800) /* Peripheral data size: halfword */
+#define DMA_SxCR_MSIZE   ((uint32_t)0x00006000) /* Memory data size */
+#define DMA_SxCR_MSIZE_0 ((uint32_t)0x00002000) /* Memory data size: halfword */
 
 /* CAN mailbox definitions */
 #ifndef CAN_TX_MAILBOX0
@@ -385,6 +431,12 @@ typedef struct
 #ifndef HAL_CAN_ERROR_CRC
     #define HAL_CAN_ERROR_CRC ((uint32_t)0x00000100)
 #endif
+#ifndef HAL_CAN_ERROR_RX_FOV0
+    #define HAL_CAN_ERROR_RX_FOV0 ((uint32_t)0x00000200)
+#endif
+#ifndef HAL_CAN_ERROR_RX_FOV1
+    #define HAL_CAN_ERROR_RX_FOV1 ((uint32_t)0x00000400)
+#endif
 
 /* CMSIS intrinsics (for IRQ disable/enable) */
 #ifndef __disable_irq
@@ -649,6 +701,9 @@ struct __DMA_HandleTypeDef
 #define HAL_IS_BIT_SET(REG, BIT) (((REG) & (BIT)) == (BIT))
 #define HAL_IS_BIT_CLR(REG, BIT) (((REG) & (BIT)) == 0U)
 
+/* Remaining transfer count; Instance points to a DMA_Stream_TypeDef as on the target */
+#define __HAL_DMA_GET_COUNTER(__HANDLE__) (((DMA_Stream_TypeDef*)((__HANDLE__)->Instance))->NDTR)
+
 #define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__)                                                                       \
     do                                                                                                                                     \
     {                                                                                                                                      \
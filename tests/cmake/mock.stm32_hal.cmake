@@ -170,6 +170,10 @@ foreach(element IN LISTS ${libName}_HEADERS)
         string(REGEX REPLACE "void[\r\n\t ]+HAL_SPI_TxRxCpltCallback[\r\n\t ]*\\([^)]*\\)[\r\n\t ]*;" "" FILE_CONTENTS "${FILE_CONTENTS}")
         # Remove HAL_SPI_ErrorCallback declaration (implemented by user code, not mocked)
         string(REGEX REPLACE "void[\r\n\t ]+HAL_SPI_ErrorCallback[\r\n\t ]*\\([^)]*\\)[\r\n\t ]*;" "" FILE_CONTENTS "${FILE_CONTENTS}")
+        # Remove HAL_SPI_RxHalfCpltCallback declaration (implemented by user code, not mocked)
+        string(REGEX REPLACE "void[\r\n\t ]+HAL_SPI_RxHalfCpltCallback[\r\n\t ]*\\([^)]*\\)[\r\n\t ]*;" "" FILE_CONTENTS "${FILE_CONTENTS}")
+        # Remove HAL_SPI_TxRxHalfCpltCallback declaration (implemented by user code, not mocked)
+        string(REGEX REPLACE "void[\r\n\t ]+HAL_SPI_TxRxHalfCpltCallback[\r\n\t ]*\\([^)]*\\)[\r\n\t ]*;" "" FILE_CONTENTS "${FILE_CONTENTS}")
         # Remove HAL_SPI_RegisterCallback and HAL_SPI_UnRegisterCallback (not needed for tests)
         string(REGEX REPLACE "HAL_StatusTypeDef[\r\n\t ]+HAL_SPI_RegisterCallback[\r\n\t ]*\\([^)]*\\)[\r\n\t ]*;" "" FILE_CONTENTS "${FILE_CONTENTS}")
         string(REGEX REPLACE "HAL_StatusTypeDef[\r\n\t ]+HAL_SPI_UnRegisterCallback[\r\n\t ]*\\([^)]*\\)[\r\n\t ]*;" "" FILE_CONTENTS "${FILE_CONTENTS}")
@@ -25,6 +25,7 @@ HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef* hcan, CAN_TxHeaderType
 HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef* hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef* pHeader, uint8_t aData[]);
 uint32_t          HAL_CAN_GetTxMailboxesFreeLevel(CAN_HandleTypeDef* hcan);
 uint32_t          HAL_CAN_GetError(CAN_HandleTypeDef* hcan);
+HAL_StatusTypeDef HAL_CAN_ResetError(CAN_HandleTypeDef* hcan);
 
 /* Weak callback prototypes (to be overridden by user) */
 void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef* hcan);
@@ -14,8 +14,45 @@ extern "C"
 {
 #endif
 
-/* No LL SPI functions are used directly in BSP code */
-/* All SPI operations go through HAL */
+#include "stm32f4xx_hal_def.h"
+
+/* Register accessors used by the polled short-transfer path, same semantics as the real LL API.
+ * On the host, DR is plain memory: a byte written is read back (loopback). */
+
+static inline void LL_SPI_Enable(SPI_TypeDef* SPIx)
+{
+    SPIx->CR1 |= SPI_CR1_SPE;
+}
+
+static inline uint32_t LL_SPI_IsEnabled(SPI_TypeDef* SPIx)
+{
+    return ((SPIx->CR1 & SPI_CR1_SPE) == SPI_CR1_SPE) ? 1u : 0u;
+}
+
+static inline uint32_t LL_SPI_IsActiveFlag_RXNE(SPI_TypeDef* SPIx)
+{
+    return ((SPIx->SR & SPI_SR_RXNE) == SPI_SR_RXNE) ? 1u : 0u;
+}
+
+static inline uint32_t LL_SPI_IsActiveFlag_TXE(SPI_TypeDef* SPIx)
+{
+    return ((SPIx->SR & SPI_SR_TXE) == SPI_SR_TXE) ? 1u : 0u;
+}
+
+static inline uint32_t LL_SPI_IsActiveFlag_BSY(SPI_TypeDef* SPIx)
+{
+    return ((SPIx->SR & SPI_SR_BSY) == SPI_SR_BSY) ? 1u : 0u;
+}
+
+static inline uint8_t LL_SPI_ReceiveData8(SPI_TypeDef* SPIx)
+{
+    return (uint8_t)(SPIx->DR);
+}
+
+static inline void LL_SPI_TransmitData8(SPI_TypeDef* SPIx, uint8_t TxData)
+{
+    SPIx->DR = TxData;
+}
 
 #ifdef __cplusplus
 }
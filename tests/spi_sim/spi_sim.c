@@ -0,0 +1,198 @@
+/**
+ * @file spi_sim.c
+ * @brief Simulated SPI1 DMA bus for the bsp_spi driver tests
+ */
+
+#include "spi_sim.h"
+#include "Mockstm32f4xx_hal_spi.h"
+#include "unity.h"
+
+extern SPI_HandleTypeDef hspi1;
+
+extern void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi);
+extern void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi);
+extern void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi);
+
+/**
+ * @brief DMA transfer in flight.
+ */
+typedef enum
+{
+    eSIM_DMA_NONE = 0,
+    eSIM_DMA_TX,
+    eSIM_DMA_RX,
+    eSIM_DMA_TXRX
+} SimDma_e;
+
+static SpiSimConfig_t s_tConfig;
+static uint64_t       s_uNowNs;
+static SimDma_e       s_eDma;
+static uint64_t       s_uDmaDoneNs;
+static bool           s_bFailNext;
+
+/**
+ * @brief Deliver the DMA completion interrupt if it is due.
+ */
+static void sSimDeliver(void)
+{
+    while ((s_eDma != eSIM_DMA_NONE) && (s_uDmaDoneNs <= s_uNowNs))
+    {
+        SimDma_e eDone = s_eDma;
+        s_eDma         = eSIM_DMA_NONE;
+
+        if (eDone == eSIM_DMA_TX)
+        {
+            HAL_SPI_TxCpltCallback(&hspi1);
+        }
+        else if (eDone == eSIM_DMA_RX)
+        {
+            HAL_SPI_RxCpltCallback(&hspi1);
+        }
+        else
+        {
+            HAL_SPI_TxRxCpltCallback(&hspi1);
+        }
+    }
+}
+
+static HAL_StatusTypeDef sSimStartDma(SimDma_e eType, const uint8_t* pTx, uint8_t* pRx, uint16_t uSize)
+{
+    /* Fill transfers clear memory increment on the transmit stream */
+    bool     bIncrement = (hspi1.hdmatx == NULL) || ((((DMA_Stream_TypeDef*)hspi1.hdmatx->Instance)->CR & DMA_SxCR_MINC) != 0u);
+    uint64_t uByteNs    = SpiSimByteNs();
+
+    TEST_ASSERT_EQUAL(eSIM_DMA_NONE, s_eDma);
+
+    if (s_bFailNext)
+    {
+        s_bFailNext = false;
+        return HAL_ERROR;
+    }
+
+    for (uint16_t i = 0u; i < uSize; i++)
+    {
+        uint8_t byTx = (pTx != NULL) ? pTx[bIncrement ? i : 0u] : 0xFFu;
+        uint8_t byRx = s_tConfig.pByte(byTx, s_uNowNs + (i * uByteNs));
+        if (pRx != NULL)
+        {
+            pRx[i] = byRx;
+        }
+    }
+
+    s_eDma       = eType;
+    s_uDmaDoneNs = s_uNowNs + ((uint64_t)uSize * uByteNs) + s_tConfig.uXferNs;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef stub_transmit_dma(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, int cmock_num_calls)
+{
+    (void)hspi;
+    (void)cmock_num_calls;
+    return sSimStartDma(eSIM_DMA_TX, pData, NULL, Size);
+}
+
+static HAL_StatusTypeDef stub_receive_dma(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size, int cmock_num_calls)
+{
+    (void)hspi;
+    (void)cmock_num_calls;
+    return sSimStartDma(eSIM_DMA_RX, NULL, pData, Size);
+}
+
+static HAL_StatusTypeDef stub_transmit_receive_dma(SPI_HandleTypeDef* hspi, uint8_t* pTxData, uint8_t* pRxData, uint16_t Size,
+                                                   int cmock_num_calls)
+{
+    (void)hspi;
+    (void)cmock_num_calls;
+    return sSimStartDma(eSIM_DMA_TXRX, pTxData, pRxData, Size);
+}
+
+void SpiSimReset(const SpiSimConfig_t* pConfig)
+{
+    s_tConfig    = *pConfig;
+    s_uNowNs     = 0u;
+    s_eDma       = eSIM_DMA_NONE;
+    s_uDmaDoneNs = 0u;
+    s_bFailNext  = false;
+    hspi1.State  = HAL_SPI_STATE_READY;
+
+    HAL_SPI_Transmit_DMA_StubWithCallback(stub_transmit_dma);
+    HAL_SPI_Receive_DMA_StubWithCallback(stub_receive_dma);
+    HAL_SPI_TransmitReceive_DMA_StubWithCallback(stub_transmit_receive_dma);
+}
+
+uint64_t SpiSimNowNs(void)
+{
+    return s_uNowNs;
+}
+
+uint64_t SpiSimByteNs(void)
+{
+    if (s_tConfig.uByteNs != 0u)
+    {
+        return s_tConfig.uByteNs;
+    }
+
+    uint32_t uPrescaler = 2u << ((hspi1.Instance->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos);
+    return (8000uLL * uPrescaler) / 84u;
+}
+
+bool SpiSimDmaPending(void)
+{
+    return s_eDma != eSIM_DMA_NONE;
+}
+
+uint64_t SpiSimDmaDueNs(void)
+{
+    return ((s_eDma != eSIM_DMA_NONE) && (s_uDmaDoneNs > s_uNowNs)) ? (s_uDmaDoneNs - s_uNowNs) : 0u;
+}
+
+void SpiSimFailNext(void)
+{
+    s_bFailNext = true;
+}
+
+void SpiSimCpu(uint64_t uNs)
+{
+    uint64_t uEndNs = s_uNowNs + uNs;
+
+    while ((s_eDma != eSIM_DMA_NONE) && (s_uDmaDoneNs <= uEndNs))
+    {
+        s_uNowNs = (s_uDmaDoneNs > s_uNowNs) ? s_uDmaDoneNs : s_uNowNs;
+        sSimDeliver();
+    }
+    s_uNowNs = uEndNs;
+}
+
+uint64_t SpiSimRun(SpiSimIsBusy_t pIsBusy, int8_t handle, uint32_t uLimitMs)
+{
+    uint64_t uStartNs = s_uNowNs;
+
+    while (pIsBusy(handle) && ((s_uNowNs - uStartNs) < ((uint64_t)uLimitMs * SPI_SIM_NS_PER_MS)))
+    {
+        uint64_t uNextTickNs = ((s_uNowNs / SPI_SIM_NS_PER_MS) + 1u) * SPI_SIM_NS_PER_MS;
+
+        if ((s_eDma != eSIM_DMA_NONE) && (s_uDmaDoneNs <= uNextTickNs))
+        {
+            s_uNowNs = s_uDmaDoneNs;
+            sSimDeliver();
+        }
+        else
+        {
+            s_uNowNs = uNextTickNs;
+            if (s_tConfig.pOnTick != NULL)
+            {
+                s_tConfig.pOnTick();
+            }
+        }
+    }
+
+    return s_uNowNs - uStartNs;
+}
+
+void SpiSimFillPattern(uint8_t* pData, uint32_t uLength, uint8_t bySeed)
+{
+    for (uint32_t i = 0u; i < uLength; i++)
+    {
+        pData[i] = (uint8_t)((i * 13u) + (i >> 9u) + bySeed);
+    }
+}
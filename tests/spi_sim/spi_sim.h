@@ -0,0 +1,91 @@
+/**
+ * @file spi_sim.h
+ * @brief Simulated SPI1 DMA bus for the bsp_spi driver tests
+ *
+ * Shared by the suites that run a driver on a real bsp_spi bus against a
+ * device model behind the mocked HAL. The DMA stubs clock every byte of a
+ * transfer through the model when it starts and complete it after its bus
+ * time; simulated time only moves when the suite runs it. The device model
+ * and its chip select stay in the suite.
+ */
+
+#pragma once
+
+#include "stm32f4xx_hal.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SPI_SIM_NS_PER_MS (1000000uLL)
+
+/**
+ * @brief Device model: one byte on the bus at uAtNs, return MISO.
+ */
+typedef uint8_t (*SpiSimByte_t)(uint8_t byTx, uint64_t uAtNs);
+
+/**
+ * @brief Driver busy check, e.g. BspSpiFlashIsBusy.
+ */
+typedef bool (*SpiSimIsBusy_t)(int8_t handle);
+
+/**
+ * @brief SysTick handler, e.g. HAL_SYSTICK_Callback.
+ */
+typedef void (*SpiSimTick_t)(void);
+
+/**
+ * @brief Simulator configuration.
+ */
+typedef struct
+{
+    SpiSimByte_t pByte;   /**< Device model */
+    uint64_t     uByteNs; /**< Fixed byte time, 0: from the SPI1 CR1 prescaler at fPCLK2 84 MHz */
+    uint64_t     uXferNs; /**< Interrupt and DMA restart per transfer */
+    SpiSimTick_t pOnTick; /**< Called by SpiSimRun at every millisecond boundary, may be NULL */
+} SpiSimConfig_t;
+
+/**
+ * @brief Reset time and the bus, install the HAL SPI DMA stubs and mark hspi1 ready.
+ */
+void SpiSimReset(const SpiSimConfig_t* pConfig);
+
+/**
+ * @brief Simulated time.
+ */
+uint64_t SpiSimNowNs(void);
+
+/**
+ * @brief Byte time at the current bus clock.
+ */
+uint64_t SpiSimByteNs(void);
+
+/**
+ * @brief A DMA transfer is in flight.
+ */
+bool SpiSimDmaPending(void);
+
+/**
+ * @brief Time until the transfer in flight completes, 0 if it is due or the bus is idle.
+ */
+uint64_t SpiSimDmaDueNs(void);
+
+/**
+ * @brief Fail the next DMA start with HAL_ERROR.
+ */
+void SpiSimFailNext(void);
+
+/**
+ * @brief Application work: advance time, taking the DMA completions that fall in it.
+ */
+void SpiSimCpu(uint64_t uNs);
+
+/**
+ * @brief Run DMA completions and SysTick until the operation ends.
+ *
+ * @return Simulated duration in nanoseconds
+ */
+uint64_t SpiSimRun(SpiSimIsBusy_t pIsBusy, int8_t handle, uint32_t uLimitMs);
+
+/**
+ * @brief Test data that differs between neighbouring bytes and between 512-byte blocks.
+ */
+void SpiSimFillPattern(uint8_t* pData, uint32_t uLength, uint8_t bySeed);